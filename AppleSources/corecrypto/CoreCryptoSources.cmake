@@ -42,6 +42,7 @@ set (CORECRYPTO_PUBLIC_HDRS
     "ccec448/corecrypto/ccec448.h"
     "ccec/corecrypto/ccec.h"
     "cc/corecrypto/cc_error.h"
+    "cc/corecrypto/cc_executor.h"
     "ccscrypt/corecrypto/ccscrypt.h"
     "cchmac/corecrypto/cchmac.h"
     "ccmd2/corecrypto/ccmd2.h"
@@ -133,6 +134,8 @@ set (CORECRYPTO_PROJECT_HDRS
     "cche/corecrypto/cche_param_ctx.h"
     "ccpolyzp_po2cyc/corecrypto/ccpolyzp_po2cyc_internal.h"
     "cckyber/corecrypto/cckyber_mult.h"
+    "cckyber/corecrypto/cckyber_avx2.h"
+    "ccchacha20poly1305/corecrypto/ccchacha20poly1305_intel.h"
     "ccckg/corecrypto/ccckg_internal.h"
     "ccec/crypto_test/crypto_test_ec_import_export.h"
     "ccdes/corecrypto/ccdes_internal.h"
@@ -165,6 +168,7 @@ set (CORECRYPTO_PROJECT_HDRS
     "cc/corecrypto/cc_debug.h"
     "cckyber/corecrypto/cckyber_internal.h"
     "ccpolyzp_po2cyc/corecrypto/ccpolyzp_po2cyc_ntt.h"
+    "ccpolyzp_po2cyc/corecrypto/ccpolyzp_po2cyc_ntt_avx512ifma.h"
     "cc/corecrypto/cc_absolute_time.h"
     "ccrng/corecrypto/ccrng_rdrand.h"
     "ccrc2/corecrypto/ccrc2_internal.h"
@@ -338,6 +342,7 @@ set (CORECRYPTO_SRCS
     "ccmode/src/ccmode_siv_hmac_init.c"
     "ccder/src/ccder_blob_reserve.c"
     "ccder/src/ccder_blob_reserve_tl.c"
+    "ccder/src/ccder_cursor.c"
     "ccder/src/ccder_blob_encode_implicit_integer.c"
     "ccder/src/ccder_blob_encode_implicit_octet_string.c"
     "ccder/src/ccder_blob_encode_implicit_raw_octet_string.c"
@@ -354,6 +359,7 @@ set (CORECRYPTO_SRCS
     "cche/src/cche_debug.c"
     "ccder/src/ccder_blob_encode_tag.c"
     "ccmode/src/ccxts.c"
+    "ccmode/src/ccmode_sectors.c"
     "ccder/src/ccder_blob_encode_tl.c"
     "ccaes/src/arm/ccm-decrypt-armv7.s"
     "ccder/src/ccder_blob_encode_uint64.c"
@@ -416,6 +422,8 @@ set (CORECRYPTO_SRCS
     "ccdh/src/ccdh_export_pub.c"
     "ccdh/src/ccdh_generate_key.c"
     "cckeccak/src/cckeccak.c"
+    "cckeccak/src/cckeccak_x4.c"
+    "cckeccak/src/intel/cckeccak_f1600_x4_avx2.c"
     "ccaes/src/intel/ccm-encrypt.s"
     "ccec/src/ccec_cp256_small.c"
     "ccec/src/ccec_cp_x25519_opt.c"
@@ -503,6 +511,8 @@ set (CORECRYPTO_SRCS
     "ccsha3/src/ccsha3_384_di.c"
     "ccrsa/src/ccrsa_verify_pkcs1v15_internal.c"
     "ccec/src/ccec_mult.c"
+    "ccec/src/ccec_multi_mult.c"
+    "ccec/src/ccec_mult_base.c"
     "ccn/src/arm/ccn_addmul1-arm64.s"
     "ccec/src/ccec_pairwise_consistency_check.c"
     "ccec/src/ccec_projectify.c"
@@ -533,6 +543,7 @@ set (CORECRYPTO_SRCS
     "cchmac/src/cchmac_update.c"
     "ccn/src/ccn_neg.c"
     "cczp/src/cczp_inv.c"
+    "cczp/src/cczp_inv_batch.c"
     "ccmd2/src/ccmd2_ltc.c"
     "cczp/src/cczp_common.c"
     "ccmd4/src/ccmd4_initial_state.c"
@@ -545,6 +556,7 @@ set (CORECRYPTO_SRCS
     "ccmd5/src/ccmd5_ltc.c"
     "ccpolyzp_po2cyc/src/ccpolyzp_po2cyc_scalar.c"
     "ccprime/src/ccprime_rabin_miller.c"
+    "ccprime/src/ccprime_sieve.c"
     "ccrsa/src/ccmgf.c"
     "ccmode/src/ccmode_cbc_decrypt.c"
     "ccaes/src/intel/ccaes_intel_xts_encrypt_mode.c"
@@ -576,6 +588,7 @@ set (CORECRYPTO_SRCS
     "ccn/src/intel/ccn_shift_right.s"
     "ccmode/src/ccmode_gcm_aad.c"
     "cckyber/src/cckyber_ntt.c"
+    "cckyber/src/intel/cckyber_avx2.c"
     "ccmode/src/ccmode_gcm_init.c"
     "ccn/src/intel/ccn_cmp-x86_64.s"
     "ccmode/src/ccmode_gcm_mult_h.c"
@@ -608,6 +621,7 @@ set (CORECRYPTO_SRCS
     "ccmode/src/ccmode_omac_init.c"
     "ccmode/src/ccmode_siv_reset.c"
     "ccpolyzp_po2cyc/src/ccpolyzp_po2cyc_ntt.c"
+    "ccpolyzp_po2cyc/src/intel/ccpolyzp_po2cyc_ntt_avx512ifma.c"
     "ccn/src/ccn_recode_jsf.c"
     "ccmode/src/ccmode_xts_crypt.c"
     "cczp/src/cczp_power.c"
@@ -787,6 +801,8 @@ set (CORECRYPTO_SRCS
     "ccrsa/src/ccrsa_init_pub.c"
     "ccn/src/ccn_subn.c"
     "ccaes/src/vng/ccaes_vng_gcm_encrypt.c"
+    "ccaes/src/intel/ccaes_aesni_gcm.c"
+    "ccaes/src/intel/ccaes_aesni_modes.c"
     "cc/src/cc_fault_canary.c"
     "ccdh/src/ccdh_compute_shared_secret.c"
     "ccrsa/src/ccrsa_oaep_decode.c"
@@ -798,6 +814,7 @@ set (CORECRYPTO_SRCS
     "ccsrp/src/ccsrp.c"
     "ccpolyzp_po2cyc/src/ccpolyzp_po2cyc_base_convert.c"
     "cckprng/src/cckprng_initgen.c"
+    "cckprng/src/cckprng_rekeygens.c"
     "cchkdf/src/cchkdf.c"
     "ccrsa/src/ccrsa_pairwise_consistency_check.c"
     "ccmode/src/ccmode_siv_hmac_decrypt.c"
@@ -851,6 +868,9 @@ set (CORECRYPTO_SRCS
     "ccsha2/src/ccsha256_initial_state.c"
     "ccec/src/ccec_cp384_small.c"
     "ccsha2/src/ccsha256_ltc_compress.c"
+    "ccsha2/src/ccsha256_mb_compress.c"
+    "ccsha2/src/ccsha512_mb_compress.c"
+    "ccsha2/src/ccsha2_mb.c"
     "cczp/src/cczp_mm_redc.c"
     "ccsha2/src/ccsha256_trng_di.c"
     "ccdh/src/ccdh_lookup_gp.c"
@@ -1058,6 +1078,8 @@ set (CORECRYPTO_SRCS
     "ccrng/src/ccrng_ecfips_test.c"
     "ccmode/src/ccmode_ccm_init.c"
     "ccchacha20poly1305/src/ccchacha20poly1305.c"
+    "ccchacha20poly1305/src/intel/ccchacha20poly1305_avx2.c"
+    "ccchacha20poly1305/src/intel/ccchacha20poly1305_avx512.c"
     "ccaes/src/arm/ccm-encrypt-armv7.s"
     "ccmode/src/ccctr.c"
     "ccmode/src/ccmode_ccm_set_iv.c"
@@ -1087,6 +1109,7 @@ set (CORECRYPTO_SRCS
     "ccsrp/src/ccsrp_client.c"
     "ccecies/src/ccecies_decrypt_gcm_plaintext_size.c"
     "cc/src/cc_dit.c"
+    "cc/src/cc_executor.c"
     "ccsrp/src/ccsrp_generate_salt_and_verification.c"
     "ccsrp/src/ccsrp_server.c"
     "ccwrap/src/ccwrap_auth_decrypt.c"
@@ -1390,6 +1413,7 @@ set (CORECRYPTO_TEST_DYLIB_SRCS
     "ccaes/src/intel/aesxts_asm.s"
     "ccsigma/src/ccsigma.c"
     "ccder/src/ccder_blob_reserve_tl.c"
+    "ccder/src/ccder_cursor.c"
     "acceleratecrypto/Source/sha512/arm64/sha512_compress_arm64.s"
     "ccec25519/src/cced25519_sign.c"
     "cczp/src/cczp_to.c"
@@ -1404,6 +1428,7 @@ set (CORECRYPTO_TEST_DYLIB_SRCS
     "ccrng/src/ccrng_zero.c"
     "acceleratecrypto/Source/sha3/arm64/sha3_keccak_arm64hw.s"
     "ccpolyzp_po2cyc/src/ccpolyzp_po2cyc_ntt.c"
+    "ccpolyzp_po2cyc/src/intel/ccpolyzp_po2cyc_ntt_avx512ifma.c"
     "acceleratecrypto/Source/sha512/arm/sha512_compress_armv7neon.s"
     "ccec/src/ccec_diversify_pub.c"
     "ccn/src/ccn_shift_right.c"
@@ -1509,6 +1534,8 @@ set (CORECRYPTO_TEST_DYLIB_SRCS
     "ccsae/src/ccsae_verify_commitment.c"
     "ccn/src/ccn_random_bits.c"
     "ccchacha20poly1305/src/ccchacha20poly1305.c"
+    "ccchacha20poly1305/src/intel/ccchacha20poly1305_avx2.c"
+    "ccchacha20poly1305/src/intel/ccchacha20poly1305_avx512.c"
     "ccvrf/src/ccvrf_keygen.c"
     "ccn/src/arm/ccn_add1-arm64.s"
     "ccsae/src/ccsae_generate_confirmation.c"
@@ -1568,6 +1595,7 @@ set (CORECRYPTO_TEST_DYLIB_SRCS
     "ccdigest/src/ccdigest_final_64be.c"
     "ccn/src/ccn_bitlen.c"
     "cczp/src/cczp_inv.c"
+    "cczp/src/cczp_inv_batch.c"
     "ccsha2/src/ccsha512_256_vng_arm_di.c"
     "ccmode/src/ccecb.c"
     "ccdh/src/ccdh_import_priv.c"
@@ -1622,6 +1650,7 @@ set (CORECRYPTO_TEST_DYLIB_SRCS
     "cc_fips/src/fipspost_post_drbg_ctr.c"
     "ccz/src/ccz_bitlen.c"
     "cckprng/src/cckprng_initgen.c"
+    "cckprng/src/cckprng_rekeygens.c"
     "ccn/src/ccn_add.c"
     "cckprng/src/cckprng_reseed.c"
     "ccn/src/ccn_cond_clear.c"
@@ -1680,9 +1709,13 @@ set (CORECRYPTO_TEST_DYLIB_SRCS
     "cccast/src/c_enc.c"
     "ccz/src/ccz_muli.c"
     "ccaes/src/vng/ccaes_vng_gcm_encrypt.c"
+    "ccaes/src/intel/ccaes_aesni_gcm.c"
+    "ccaes/src/intel/ccaes_aesni_modes.c"
     "ccrsa/src/ccrsa_generate_key_deterministic.c"
     "ccrng/src/ccrng_fortuna.c"
     "cckeccak/src/cckeccak.c"
+    "cckeccak/src/cckeccak_x4.c"
+    "cckeccak/src/intel/cckeccak_f1600_x4_avx2.c"
     "ccec25519/src/shared25519.c"
     "ccbfv/src/ccbfv_secret_key.c"
     "ccec/src/ccec_pairwise_consistency_check.c"
@@ -1717,6 +1750,7 @@ set (CORECRYPTO_TEST_DYLIB_SRCS
     "ccrng/crypto_test/ccrng_test.c"
     "ccec/src/ccec_compact_export_pub.c"
     "ccprime/src/ccprime_rabin_miller.c"
+    "ccprime/src/ccprime_sieve.c"
     "ccsha2/src/ccsha224_initial_state.c"
     "ccmode/src/ccmode_siv_hmac_nonce.c"
     "ccmode/src/ccmode_factory_ccm_decrypt.c"
@@ -1775,6 +1809,8 @@ set (CORECRYPTO_TEST_DYLIB_SRCS
     "ccmode/src/ccmode_xts_init.c"
     "ccaes/src/arm/ccm-decrypt-armv7.s"
     "ccec/src/ccec_mult.c"
+    "ccec/src/ccec_multi_mult.c"
+    "ccec/src/ccec_mult_base.c"
     "ccn/src/arm/ccn_shift_left_arm64.s"
     "cc_fips/src/fipspost_trace.c"
     "ccmode/src/ccmode_factory_siv_hmac_decrypt.c"
@@ -1796,6 +1832,7 @@ set (CORECRYPTO_TEST_DYLIB_SRCS
     "ccsha2/src/ccsha512_256_ltc_di.c"
     "ccrsa/src/ccrsa_num_mr_iterations.c"
     "cckyber/src/cckyber_ntt.c"
+    "cckyber/src/intel/cckyber_avx2.c"
     "ccrsa/src/ccrsa_import_pub.c"
     "ccder/src/ccder_blob_reserve.c"
     "acceleratecrypto/Source/aes/intel/crypt_aesni.s"
@@ -1890,6 +1927,7 @@ set (CORECRYPTO_TEST_DYLIB_SRCS
     "ccsha1/src/ccsha1_ltc.c"
     "ccaes/src/ltc/ccaes_ltc_ecb_decrypt_mode.c"
     "cc/src/cc_dit.c"
+    "cc/src/cc_executor.c"
     "ccaes/src/arm/ccaes_arm_xts_decrypt.s"
     "acceleratecrypto/Source/sha512/sha512_K.c"
     "cccmac/src/cccmac_update.c"
@@ -1917,6 +1955,7 @@ set (CORECRYPTO_TEST_DYLIB_SRCS
     "ccec/src/ccec_cp_x448_opt.c"
     "ccpolyzp_po2cyc/src/ccpolyzp_po2cyc_base_convert.c"
     "ccmode/src/ccxts.c"
+    "ccmode/src/ccmode_sectors.c"
     "ccec/src/ccec_der_import_priv.c"
     "cc_fips/src/fipspost_post_kdf_ctr_cmac.c"
     "ccvrf/src/ccvrf_proof_to_hash.c"
@@ -1993,6 +2032,9 @@ set (CORECRYPTO_TEST_DYLIB_SRCS
     "ccaes/src/intel/ctr-SupplementalSSE3.s"
     "ccec25519/src/cced25519_eddsa.c"
     "ccsha2/src/ccsha256_ltc_compress.c"
+    "ccsha2/src/ccsha256_mb_compress.c"
+    "ccsha2/src/ccsha512_mb_compress.c"
+    "ccsha2/src/ccsha2_mb.c"
     "ccec/src/ccec_der_import_diversified_pub.c"
     "ccn/src/ccn_addn.c"
     "ccdes/src/ccdes3_ltc_ecb_encrypt.c"
@@ -2037,6 +2079,7 @@ set (CORECRYPTO_TEST_HDRS
     "corecrypto_test/include/yajl/yajl_tree.h"
     "corecrypto_test/lib/yajl/yajl_parser.h"
     "corecrypto_test/include/testenv.h"
+    "corecrypto_test/include/cctest_executor.h"
     "ccrng/crypto_test/crypto_test_rng.h"
     "corecrypto_test/include/cc_generated_test_vectors.h"
     "ccdh/crypto_test/crypto_test_dh.h"
@@ -2108,6 +2151,7 @@ set (CORECRYPTO_TEST_SRCS
     "ccsigma/crypto_test/crypto_test_sigma.c"
     "ccrng/crypto_test/crypto_test_rng_process.c"
     "corecrypto_test/lib/testenv.c"
+    "corecrypto_test/lib/cctest_executor.c"
     "cclr/crypto_test/crypto_test_lr.c"
     "ccmode/crypto_test/ccmode_test.c"
     "ccsha2/crypto_test/crypto_test_sha256.c"
@@ -2125,6 +2169,7 @@ set (CORECRYPTO_TEST_SRCS
     "cche/crypto_test/crypto_test_cche_serialization.c"
     "ccmode/crypto_test/crypto_test_ctr.c"
     "ccmode/crypto_test/crypto_test_xts.c"
+    "ccmode/crypto_test/crypto_test_sectors.c"
     "ccrsa/crypto_test/crypto_test_rsa.c"
     "ccnistkdf/crypto_test/crypto_test_nistkdf_cmac.c"
     "ccdh/src/ccdh_pairwise_consistency_check.c"
@@ -2245,10 +2290,13 @@ set (CORECRYPTO_PERF_SRCS
     "corecrypto_perf/src/ccperf_ccec25519.c"
     "corecrypto_perf/src/ccperf_ccmode_ecb.c"
     "corecrypto_perf/src/ccperf_stats.c"
+    "corecrypto_perf/src/ccperf_report.c"
+    "corecrypto_perf/src/ccperf_executor.c"
     "corecrypto_perf/src/ccperf_ccmode_siv.c"
     "corecrypto_perf/src/ccperf_ccmode_gcm.c"
     "corecrypto_perf/src/ccperf_ccchacha.c"
     "corecrypto_perf/src/ccperf_ccscrypt.c"
+    "corecrypto_perf/src/ccperf_ccder.c"
     "corecrypto_perf/src/ccperf_cche.c"
     "corecrypto_perf/src/ccperf_ccmode_ofb.c"
     "corecrypto_test/lib/ccstats.c"
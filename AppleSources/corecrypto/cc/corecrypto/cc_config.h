@@ -411,6 +411,16 @@
  #endif
 #endif
 
+// Serve top-level workspaces of hot entry points from a per-thread arena,
+// instead of allocating and freeing heap memory on every call.
+#ifndef CC_USE_WORKSPACE_ARENA
+ #if CC_USE_HEAP_FOR_WORKSPACE && !CC_KERNEL && !CC_EXTERN_MALLOC && !CC_MALLOC_ABORT && (CC_LINUX || CC_DARWIN)
+  #define CC_USE_WORKSPACE_ARENA 1
+ #else
+  #define CC_USE_WORKSPACE_ARENA 0
+ #endif
+#endif
+
 #define CC_CACHE_DESCRIPTORS CC_KERNEL
 
 //-(1) ARM V7
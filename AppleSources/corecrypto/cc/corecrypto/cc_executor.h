@@ -0,0 +1,33 @@
+/* Copyright (c) (2023) Apple Inc. All rights reserved.
+ *
+ * corecrypto is licensed under Apple Inc.’s Internal Use License Agreement (which
+ * is contained in the License.txt file distributed with corecrypto) and only to
+ * people who accept that license. IMPORTANT:  Any license rights granted to you by
+ * Apple Inc. (if any) are limited to internal use within your organization only on
+ * devices and computers you own or control, for the sole purpose of verifying the
+ * security characteristics and correct functioning of the Apple Software.  You may
+ * not, directly or indirectly, redistribute the Apple Software or any portions thereof.
+ */
+
+#ifndef _CORECRYPTO_CC_EXECUTOR_H_
+#define _CORECRYPTO_CC_EXECUTOR_H_
+
+#include <corecrypto/cc.h>
+
+/*! @struct cc_executor
+ @abstract Runs independent work items of a corecrypto operation, typically on
+           a thread pool. corecrypto has no threads of its own, callers that
+           want parallelism provide them through an executor.
+
+ @field apply Call work(work_ctx, i) for every i in [0, n). The calls may run
+              concurrently and in any order; apply must only return once all of
+              them have completed.
+ @field ctx   Executor-specific context, e.g. a thread pool.
+ */
+struct cc_executor {
+    void (*apply)(const struct cc_executor *executor, size_t n,
+                  void *work_ctx, void (*work)(void *work_ctx, size_t i));
+    void *ctx;
+};
+
+#endif // _CORECRYPTO_CC_EXECUTOR_H_
@@ -97,6 +97,21 @@ void cc_disable_dit(volatile bool *cc_unsafe_indexable dit_was_enabled);
 
 #endif // CC_DIT_MAYBE_SUPPORTED
 
+struct cc_executor;
+
+/*!
+  @function cc_executor_apply
+  @abstract Calls work(work_ctx, i) for every i in [0, n), on executor or, if
+  executor is NULL, one after the other on the calling thread.
+
+  @discussion Every work item runs with DIT enabled, including the ones
+  running on the executor's threads.
+ */
+void cc_executor_apply(const struct cc_executor *executor,
+                       size_t n,
+                       void *work_ctx,
+                       void (*work)(void *work_ctx, size_t i));
+
 /*!
   @function cc_is_vmm_present
   @abstract Determine if corecrypto is running in a VM
@@ -55,6 +55,12 @@ void cc_free(void *p, size_t size);
 cc_unit *cc_counted_by(n) cc_ws_alloc(cc_ws_t ws, cc_size n);
 void cc_ws_free(cc_ws_t ws);
 
+/* Number of units that can still be allocated from a workspace. */
+CC_INLINE cc_size cc_ws_available(cc_ws_t ws)
+{
+    return ws->nunits - ws->offset;
+}
+
 /* Stack-based workspace functions. */
 void cc_ws_free_stack(cc_ws_t ws);
 
@@ -106,6 +112,50 @@ void cc_ws_free_null(cc_ws_t ws);
 
 #endif // !CC_USE_HEAP_FOR_WORKSPACE
 
+#if CC_USE_WORKSPACE_ARENA
+
+/* Thread-local workspace arena functions. */
+
+struct cc_ws_arena_stats {
+    // Size of the largest workspace served by the arena, in units.
+    cc_size peak_nunits;
+    // Number of workspaces served from the arena without allocating.
+    uint64_t nreused;
+    // Number of workspaces that required an allocation, either
+    // because the arena had to grow or could not be used.
+    uint64_t nallocated;
+};
+
+// Largest workspace served from the arena, bigger ones use the heap.
+#define CC_WS_ARENA_MAX_NUNITS ccn_nof_size(64 * 1024)
+
+int cc_ws_arena_acquire(cc_ws_t ws, cc_size n);
+cc_unit *cc_counted_by(n) cc_ws_alloc_arena(cc_ws_t ws, cc_size n);
+void cc_ws_free_arena(cc_ws_t ws);
+
+// Returns statistics of the calling thread's arena.
+void cc_ws_arena_stats(struct cc_ws_arena_stats *stats);
+
+// Frees the calling thread's arena. Arenas are freed on thread exit too.
+void cc_ws_arena_release(void);
+
+// Declare workspace with memory from the calling thread's arena. The arena
+// grows to the largest size requested so far, and only the part used by
+// the caller is cleared on CC_FREE_WORKSPACE(). Nested workspaces, and
+// workspaces larger than CC_WS_ARENA_MAX_NUNITS, fall back to the heap.
+#define CC_DECL_WORKSPACE_ARENA_RV(ws, n, rv) \
+    cc_ws ws##_ctx;                           \
+    cc_ws_t ws = &ws##_ctx;                   \
+    rv = cc_ws_arena_acquire(ws, n);          \
+    if (rv == CCERR_OK)                       \
+        cc_ws_alloc_debug(&ws, __FILE__, __LINE__, __func__);
+
+#else // !CC_USE_WORKSPACE_ARENA
+
+#define CC_DECL_WORKSPACE_ARENA_RV(ws, n, rv) CC_DECL_WORKSPACE_RV(ws, n, rv)
+
+#endif // !CC_USE_WORKSPACE_ARENA
+
 // =============================================================================
 //   Common
 // =============================================================================
@@ -116,6 +166,12 @@ void cc_ws_free_null(cc_ws_t ws);
     if (ws##_rv != CCERR_OK)              \
         return ws##_rv;
 
+#define CC_DECL_WORKSPACE_ARENA_OR_FAIL(ws, n)  \
+    int ws##_rv;                                \
+    CC_DECL_WORKSPACE_ARENA_RV(ws, n, ws##_rv); \
+    if (ws##_rv != CCERR_OK)                    \
+        return ws##_rv;
+
 #define CC_FREE_WORKSPACE(ws) \
     cc_ws_free_debug(&ws);    \
     ws->free(ws);
@@ -23,10 +23,13 @@
     #include <i386/cpuid.h>
     #define CC_HAS_RDRAND() ((cpuid_features() & CPUID_FEATURE_RDRAND) != 0)
     #define CC_HAS_AESNI() ((cpuid_features() & CPUID_FEATURE_AES) != 0)
+    #define CC_HAS_PCLMULQDQ() ((cpuid_features() & CPUID_FEATURE_PCLMULQDQ) != 0)
     #define CC_HAS_SupplementalSSE3() ((cpuid_features() & CPUID_FEATURE_SSSE3) != 0)
     #define CC_HAS_AVX1() ((cpuid_features() & CPUID_FEATURE_AVX1_0) != 0)
     #define CC_HAS_AVX2() ((cpuid_info()->cpuid_leaf7_features & CPUID_LEAF7_FEATURE_AVX2) != 0)
     #define CC_HAS_AVX512_AND_IN_KERNEL()    ((cpuid_info()->cpuid_leaf7_features & CPUID_LEAF7_FEATURE_AVX512F) !=0)
+    #define CC_HAS_AVX512F() ((cpuid_info()->cpuid_leaf7_features & CPUID_LEAF7_FEATURE_AVX512F) != 0)
+    #define CC_HAS_AVX512IFMA() ((cpuid_info()->cpuid_leaf7_features & CPUID_LEAF7_FEATURE_AVX512IFMA) != 0)
     #define CC_HAS_BMI2() ((cpuid_info()->cpuid_leaf7_features & CPUID_LEAF7_FEATURE_BMI2) != 0)
     #define CC_HAS_ADX() ((cpuid_info()->cpuid_leaf7_features & CPUID_LEAF7_FEATURE_ADX) != 0)
 
@@ -34,19 +37,26 @@
     #include <System/i386/cpu_capabilities.h>
     #define CC_HAS_RDRAND() (_get_cpu_capabilities() & kHasRDRAND)
     #define CC_HAS_AESNI() (_get_cpu_capabilities() & kHasAES)
+    // Every Intel Mac with AES-NI also has PCLMULQDQ.
+    #define CC_HAS_PCLMULQDQ() CC_HAS_AESNI()
     #define CC_HAS_SupplementalSSE3() (_get_cpu_capabilities() & kHasSupplementalSSE3)
     #define CC_HAS_AVX1() (_get_cpu_capabilities() & kHasAVX1_0)
     #define CC_HAS_AVX2() (_get_cpu_capabilities() & kHasAVX2_0)
     #define CC_HAS_AVX512_AND_IN_KERNEL() 0
+    #define CC_HAS_AVX512F() (_get_cpu_capabilities() & kHasAVX512F)
+    #define CC_HAS_AVX512IFMA() (_get_cpu_capabilities() & kHasAVX512IFMA)
     #define CC_HAS_BMI2() (_get_cpu_capabilities() & kHasBMI2)
     #define CC_HAS_ADX() (_get_cpu_capabilities() & kHasADX)
 
 #else
     #define CC_HAS_AESNI() __builtin_cpu_supports("aes")
+    #define CC_HAS_PCLMULQDQ() __builtin_cpu_supports("pclmul")
     #define CC_HAS_SupplementalSSE3() __builtin_cpu_supports("ssse3")
     #define CC_HAS_AVX1() __builtin_cpu_supports("avx")
     #define CC_HAS_AVX2() __builtin_cpu_supports("avx2")
     #define CC_HAS_AVX512_AND_IN_KERNEL() 0
+    #define CC_HAS_AVX512F() __builtin_cpu_supports("avx512f")
+    #define CC_HAS_AVX512IFMA() __builtin_cpu_supports("avx512ifma")
     #define CC_HAS_BMI2() __builtin_cpu_supports("bmi2")
 #if CC_LINUX || !CC_INTERNAL_SDK
     #include <cpuid.h>
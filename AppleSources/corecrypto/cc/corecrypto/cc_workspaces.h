@@ -176,12 +176,20 @@ CC_PURE cc_size CCDH_POWER_BLINDED_WORKSPACE_N(cc_size n);
 
 CC_PURE cc_size CCEC_AFFINIFY_POINTS_WORKSPACE_N(cc_size n, cc_size npoints);
 
+CC_PURE cc_size CCEC_MULTI_MULT_WORKSPACE_N(cc_size n, cc_size npoints);
+
+CC_PURE cc_size CCZP_INV_BATCH_WORKSPACE_N(cc_size n, cc_size k);
+
+CC_PURE cc_size CCEC_MULT_BASE_WORKSPACE_N(cc_size n);
+
 CC_PURE cc_size CCN_P224_INV_ASM_WORKSPACE_N(cc_size n);
 
 CC_PURE cc_size CCN_P256_INV_ASM_WORKSPACE_N(cc_size n);
 
 CC_PURE cc_size CCN_P384_INV_ASM_WORKSPACE_N(cc_size n);
 
+CC_PURE cc_size CCN_MUL_KARATSUBA_WORKSPACE_N(cc_size n);
+
 CC_PURE cc_size CCN_SQR_WORKSPACE_N(cc_size n);
 
 CC_PURE cc_size CCPOLYZP_PO2CYC_BASE_CONVERT_DIVIDE_AND_ROUND_WORKSPACE_N(cc_size degree, cc_size nmoduli);
@@ -214,6 +222,14 @@ CC_PURE cc_size CCPOLYZP_PO2CYC_WORKSPACE_N(cc_size degree, cc_size nmoduli);
 
 CC_PURE cc_size CCRSA_CRT_POWER_BLINDED_WORKSPACE_N(cc_size n);
 
+CC_PURE cc_size CCRSA_CRT_POWER_HALF_WORKSPACE_N(cc_size n);
+
+CC_PURE cc_size CCRSA_GENERATE_PRIME_SIEVE_WORKSPACE_N(cc_size n);
+
+CC_PURE cc_size CCRSA_GENERATE_KEY_EXECUTOR_WORKSPACE_N(cc_size n);
+
+CC_PURE cc_size CCRSA_PRIV_CRYPT_BLINDED_EXECUTOR_WORKSPACE_N(cc_size n);
+
 #include "cc_workspaces_generated.h"
 
 #endif // _CORECRYPTO_CC_WORKSPACES_H_
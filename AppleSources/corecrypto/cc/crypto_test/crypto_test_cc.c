@@ -10,6 +10,7 @@
  */
 
 #include "cc_internal.h"
+#include "cc_memory.h"
 #include "testmore.h"
 #include "testbyteBuffer.h"
 #include <stdbool.h>
@@ -568,6 +569,82 @@ memcmp_secure_securityTests(void) {
 }
 #endif // CC_SECURITY_TEST
 
+#if CC_USE_WORKSPACE_ARENA
+#define kPlan_ccWsArenaTestNb 12
+
+static int
+ws_arena_Tests(void)
+{
+    struct cc_ws_arena_stats before, after;
+    const cc_size n = 64;
+    cc_unit *buf;
+
+    cc_ws_arena_release();
+    cc_ws_arena_stats(&before);
+
+    // First use allocates.
+    {
+        CC_DECL_WORKSPACE_ARENA_OR_FAIL(ws, n);
+        buf = ws->ctx;
+        CC_DECL_BP_WS(ws, bp);
+        cc_unit *x = CC_ALLOC_WS(ws, n);
+        ccn_seti(n, x, 0x55);
+        CC_FREE_BP_WS(ws, bp);
+        CC_FREE_WORKSPACE(ws);
+    }
+
+    cc_ws_arena_stats(&after);
+    is(after.nallocated, before.nallocated + 1, "Arena allocates on first use");
+    is(after.nreused, before.nreused, "Arena not reused on first use");
+    ok(after.peak_nunits >= n, "Arena peak size");
+
+    // Second use reuses the same, cleared memory.
+    {
+        CC_DECL_WORKSPACE_ARENA_OR_FAIL(ws, n / 2);
+        ok(ws->ctx == buf, "Arena memory reused");
+        ok(ccn_is_zero(n, ws->ctx), "Arena memory cleared");
+
+        // Nested workspaces use the heap.
+        CC_DECL_WORKSPACE_ARENA_OR_FAIL(ws2, n);
+        ok(ws2->ctx != buf, "Nested workspace not served from the arena");
+        CC_FREE_WORKSPACE(ws2);
+
+        CC_FREE_WORKSPACE(ws);
+    }
+
+    cc_ws_arena_stats(&after);
+    is(after.nallocated, before.nallocated + 2, "Nested workspace allocates");
+    is(after.nreused, before.nreused + 1, "Arena reused");
+
+    // Larger workspaces grow the arena, up to a limit.
+    {
+        CC_DECL_WORKSPACE_ARENA_OR_FAIL(ws, 2 * n);
+        CC_FREE_WORKSPACE(ws);
+    }
+    {
+        CC_DECL_WORKSPACE_ARENA_OR_FAIL(ws, CC_WS_ARENA_MAX_NUNITS + 1);
+        CC_FREE_WORKSPACE(ws);
+    }
+
+    cc_ws_arena_stats(&after);
+    is(after.nallocated, before.nallocated + 4, "Arena grows");
+    is(after.peak_nunits, CC_MAX(before.peak_nunits, 2 * n), "Large workspace not served from the arena");
+
+    {
+        CC_DECL_WORKSPACE_ARENA_OR_FAIL(ws, 2 * n);
+        CC_FREE_WORKSPACE(ws);
+    }
+
+    cc_ws_arena_stats(&after);
+    is(after.nreused, before.nreused + 2, "Grown arena reused");
+
+    cc_ws_arena_release();
+    return CCERR_OK;
+}
+#else
+#define kPlan_ccWsArenaTestNb 0
+#endif // CC_USE_WORKSPACE_ARENA
+
 #ifdef CC_SECURITY_TEST
 #define kPlan_ccSecurityTestNb 5
 #else
@@ -576,7 +653,7 @@ memcmp_secure_securityTests(void) {
 
 int cc_tests(TM_UNUSED int argc, TM_UNUSED char *const *argv)
 {
-    int num_tests = 36 + kPlan_ccSecurityTestNb;
+    int num_tests = 36 + kPlan_ccSecurityTestNb + kPlan_ccWsArenaTestNb;
     num_tests += 292 + 2 * CLZ_RANDOM_TESTS; // clz_tests
     num_tests += 292 + 2 * CTZ_RANDOM_TESTS; // ctz_tests
     num_tests += 294 + 2 * FFS_RANDOM_TESTS; // ffs_tests
@@ -623,6 +700,11 @@ int cc_tests(TM_UNUSED int argc, TM_UNUSED char *const *argv)
     }
 #endif // CC_SECURITY_TEST
 
+#if CC_USE_WORKSPACE_ARENA
+    if(verbose) diag("Workspace arena test");
+    is(ws_arena_Tests(), CCERR_OK, "Workspace arena allocation");
+#endif
+
     // Silence code coverage
     const char *label = "corecrypto";
     const uint8_t *buffer = (const uint8_t *)label;
@@ -0,0 +1,43 @@
+/* Copyright (c) (2023) Apple Inc. All rights reserved.
+ *
+ * corecrypto is licensed under Apple Inc.’s Internal Use License Agreement (which
+ * is contained in the License.txt file distributed with corecrypto) and only to
+ * people who accept that license. IMPORTANT:  Any license rights granted to you by
+ * Apple Inc. (if any) are limited to internal use within your organization only on
+ * devices and computers you own or control, for the sole purpose of verifying the
+ * security characteristics and correct functioning of the Apple Software.  You may
+ * not, directly or indirectly, redistribute the Apple Software or any portions thereof.
+ */
+
+#include "cc_internal.h"
+#include <corecrypto/cc_executor.h>
+
+struct cc_executor_work {
+    void *work_ctx;
+    void (*work)(void *work_ctx, size_t i);
+};
+
+static void cc_executor_work_dit(void *work_ctx, size_t i)
+{
+    // DIT is per thread, and this may run on one of the executor's threads.
+    CC_ENSURE_DIT_ENABLED
+
+    const struct cc_executor_work *w = work_ctx;
+    w->work(w->work_ctx, i);
+}
+
+void cc_executor_apply(const struct cc_executor *executor,
+                       size_t n,
+                       void *work_ctx,
+                       void (*work)(void *work_ctx, size_t i))
+{
+    if (executor == NULL) {
+        for (size_t i = 0; i < n; i++) {
+            work(work_ctx, i);
+        }
+        return;
+    }
+
+    struct cc_executor_work w = { .work_ctx = work_ctx, .work = work };
+    executor->apply(executor, n, &w, cc_executor_work_dit);
+}
@@ -192,3 +192,119 @@ void cc_ws_free_null(CC_UNUSED cc_ws_t ws)
 {
 
 }
+
+/* Thread-local workspace arena functions. */
+
+#if CC_USE_WORKSPACE_ARENA
+
+#include <pthread.h>
+
+struct cc_ws_arena {
+    cc_unit *buf;
+    cc_size nunits;
+    // Highest offset handed out by the current workspace.
+    cc_size used;
+    bool in_use;
+    bool registered;
+    struct cc_ws_arena_stats stats;
+};
+
+static __thread struct cc_ws_arena cc_ws_arena_tls;
+
+static pthread_key_t cc_ws_arena_key;
+static pthread_once_t cc_ws_arena_once = PTHREAD_ONCE_INIT;
+static bool cc_ws_arena_key_valid;
+
+static void cc_ws_arena_destroy(void *ctx)
+{
+    struct cc_ws_arena *arena = ctx;
+
+    // The arena is all zeros whenever it's not in use.
+    cc_free(arena->buf, ccn_sizeof_n(arena->nunits));
+    arena->buf = NULL;
+    arena->nunits = 0;
+}
+
+static void cc_ws_arena_init_key(void)
+{
+    cc_ws_arena_key_valid = pthread_key_create(&cc_ws_arena_key, cc_ws_arena_destroy) == 0;
+}
+
+int cc_ws_arena_acquire(cc_ws_t ws, cc_size n)
+{
+    struct cc_ws_arena *arena = &cc_ws_arena_tls;
+
+    if (!arena->registered) {
+        // Without a key, the arena couldn't be freed on thread exit.
+        pthread_once(&cc_ws_arena_once, cc_ws_arena_init_key);
+        arena->registered = cc_ws_arena_key_valid && pthread_setspecific(cc_ws_arena_key, arena) == 0;
+    }
+
+    if (!arena->registered || arena->in_use || n > CC_WS_ARENA_MAX_NUNITS) {
+        arena->stats.nallocated += 1;
+        *ws = (cc_ws){ cc_malloc_clear(ccn_sizeof_n(n)), n, 0, cc_ws_alloc, cc_ws_free };
+        return ws->ctx ? CCERR_OK : CCERR_MEMORY_ALLOC_FAIL;
+    }
+
+    if (n > arena->nunits) {
+        cc_unit *buf = cc_malloc_clear(ccn_sizeof_n(n));
+        if (buf == NULL) {
+            return CCERR_MEMORY_ALLOC_FAIL;
+        }
+
+        cc_free(arena->buf, ccn_sizeof_n(arena->nunits));
+        arena->buf = buf;
+        arena->nunits = n;
+        arena->stats.nallocated += 1;
+    } else {
+        arena->stats.nreused += 1;
+    }
+
+    arena->stats.peak_nunits = CC_MAX(arena->stats.peak_nunits, n);
+    arena->in_use = true;
+    arena->used = 0;
+
+    // Bounds are checked against n, not the size of the arena.
+    *ws = (cc_ws){ arena->buf, n, 0, cc_ws_alloc_arena, cc_ws_free_arena };
+    return CCERR_OK;
+}
+
+cc_unit *cc_ws_alloc_arena(cc_ws_t ws, cc_size n)
+{
+    struct cc_ws_arena *arena = &cc_ws_arena_tls;
+
+    cc_unit *mem = cc_ws_alloc(ws, n);
+    arena->used = CC_MAX(arena->used, ws->offset);
+    return mem;
+}
+
+void cc_ws_free_arena(cc_ws_t ws)
+{
+    struct cc_ws_arena *arena = &cc_ws_arena_tls;
+
+    cc_try_abort_if(ws->offset > ws->nunits, "free ws");
+    cc_try_abort_if(!arena->in_use || ws->ctx != arena->buf, "free ws");
+
+    // Only clear what was handed out, the rest is still all zeros.
+    ccn_clear(arena->used, arena->buf);
+    arena->used = 0;
+    arena->in_use = false;
+
+    ws->nunits = ws->offset = 0;
+    ws->ctx = NULL;
+}
+
+void cc_ws_arena_stats(struct cc_ws_arena_stats *stats)
+{
+    *stats = cc_ws_arena_tls.stats;
+}
+
+void cc_ws_arena_release(void)
+{
+    struct cc_ws_arena *arena = &cc_ws_arena_tls;
+
+    cc_try_abort_if(arena->in_use, "release ws arena");
+    cc_ws_arena_destroy(arena);
+}
+
+#endif // CC_USE_WORKSPACE_ARENA
@@ -0,0 +1,106 @@
+/* Copyright (c) (2023) Apple Inc. All rights reserved.
+ *
+ * corecrypto is licensed under Apple Inc.’s Internal Use License Agreement (which
+ * is contained in the License.txt file distributed with corecrypto) and only to
+ * people who accept that license. IMPORTANT:  Any license rights granted to you by
+ * Apple Inc. (if any) are limited to internal use within your organization only on
+ * devices and computers you own or control, for the sole purpose of verifying the
+ * security characteristics and correct functioning of the Apple Software.  You may
+ * not, directly or indirectly, redistribute the Apple Software or any portions thereof.
+ */
+
+#ifndef _CORECRYPTO_CCAES_AESNI_GCM_H_
+#define _CORECRYPTO_CCAES_AESNI_GCM_H_
+
+#include <corecrypto/ccaes.h>
+#include "ccaes_vng_gcm.h"
+
+// AES-GCM written with AES-NI and PCLMULQDQ intrinsics, for x86_64 builds
+// that do not have the VNG assembly.
+#if !CCMODE_GCM_VNG_SPEEDUP && defined(__x86_64__) && \
+    (defined(__GNUC__) || defined(__clang__)) && !CC_KERNEL
+#define CCMODE_GCM_AESNI_SPEEDUP 1
+#else
+#define CCMODE_GCM_AESNI_SPEEDUP 0
+#endif
+
+#include "ccmode_internal.h"
+
+#if CCMODE_GCM_AESNI_SPEEDUP
+
+// Number of blocks encrypted and hashed per iteration of the bulk loop.
+#define CCAES_AESNI_GCM_NBLOCKS 8
+
+struct _ccaes_aesni_gcm_tables {
+    unsigned char rk[15][16];                          /* AES encryption round keys */
+    unsigned char Htable[CCAES_AESNI_GCM_NBLOCKS][16]; /* H^1..H^8, byte-reversed */
+    uint32_t nrounds;
+};
+
+// The tables follow the ECB key, GCM_TABLE_SIZE is zero for this build.
+#define CCAES_AESNI_GCM_TABLE_SIZE ccn_sizeof_size(sizeof(struct _ccaes_aesni_gcm_tables))
+#define CCAES_AESNI_GCM_KEY_TABLES(K)                                    \
+    ((struct _ccaes_aesni_gcm_tables *)((unsigned char *)CCMODE_GCM_KEY_ECB_KEY(K) + \
+                                        GCM_ECB_KEY_SIZE(CCMODE_GCM_KEY_ECB(K))))
+
+int ccaes_aesni_gcm_init(const struct ccmode_gcm *gcm, ccgcm_ctx *key,
+                         size_t rawkey_nbytes, const void *rawkey);
+
+int ccaes_aesni_gcm_decrypt(ccgcm_ctx *key, size_t nbytes,
+                            const void *in, void *out);
+
+int ccaes_aesni_gcm_encrypt(ccgcm_ctx *key, size_t nbytes,
+                            const void *in, void *out);
+
+/* Use this to statically initialize a ccmode_gcm object for encryption. */
+#define CCAES_AESNI_GCM_ENCRYPT(ECB_ENCRYPT) { \
+.size = ccn_sizeof_size(sizeof(struct _ccmode_gcm_key))  \
++ GCM_ECB_KEY_SIZE(ECB_ENCRYPT)  \
++ CCAES_AESNI_GCM_TABLE_SIZE, \
+.block_size = 1, \
+.init = ccaes_aesni_gcm_init, \
+.set_iv = ccmode_gcm_set_iv, \
+.gmac = ccmode_gcm_aad, \
+.gcm = ccaes_aesni_gcm_encrypt, \
+.finalize = ccmode_gcm_finalize, \
+.reset = ccmode_gcm_reset, \
+.custom = (ECB_ENCRYPT), \
+.encdec = CCMODE_GCM_ENCRYPTOR\
+}
+
+/* Use these function to runtime initialize a ccmode_gcm encrypt object (for
+ example if it's part of a larger structure). The caller is responsible for
+ checking that the CPU supports AES-NI and PCLMULQDQ. */
+CC_INLINE
+void ccaes_aesni_factory_gcm_encrypt(struct ccmode_gcm *gcm) {
+    struct ccmode_gcm gcm_encrypt = CCAES_AESNI_GCM_ENCRYPT(ccaes_ecb_encrypt_mode());
+    *gcm = gcm_encrypt;
+}
+
+/* Use this to statically initialize a ccmode_gcm object for decryption. */
+#define CCAES_AESNI_GCM_DECRYPT(ECB_ENCRYPT) { \
+.size = ccn_sizeof_size(sizeof(struct _ccmode_gcm_key))  \
++ GCM_ECB_KEY_SIZE(ECB_ENCRYPT)  \
++ CCAES_AESNI_GCM_TABLE_SIZE, \
+.block_size = 1, \
+.init = ccaes_aesni_gcm_init, \
+.set_iv = ccmode_gcm_set_iv, \
+.gmac = ccmode_gcm_aad, \
+.gcm = ccaes_aesni_gcm_decrypt, \
+.finalize = ccmode_gcm_finalize, \
+.reset = ccmode_gcm_reset, \
+.custom = (ECB_ENCRYPT), \
+.encdec = CCMODE_GCM_DECRYPTOR\
+}
+
+/* Use these function to runtime initialize a ccmode_gcm decrypt object (for
+ example if it's part of a larger structure). The caller is responsible for
+ checking that the CPU supports AES-NI and PCLMULQDQ. */
+CC_INLINE
+void ccaes_aesni_factory_gcm_decrypt(struct ccmode_gcm *gcm) {
+    struct ccmode_gcm gcm_decrypt = CCAES_AESNI_GCM_DECRYPT(ccaes_ecb_encrypt_mode());
+    *gcm = gcm_decrypt;
+}
+#endif /* CCMODE_GCM_AESNI_SPEEDUP */
+
+#endif /* _CORECRYPTO_CCAES_AESNI_GCM_H_ */
@@ -0,0 +1,58 @@
+/* Copyright (c) (2023) Apple Inc. All rights reserved.
+ *
+ * corecrypto is licensed under Apple Inc.’s Internal Use License Agreement (which
+ * is contained in the License.txt file distributed with corecrypto) and only to
+ * people who accept that license. IMPORTANT:  Any license rights granted to you by
+ * Apple Inc. (if any) are limited to internal use within your organization only on
+ * devices and computers you own or control, for the sole purpose of verifying the
+ * security characteristics and correct functioning of the Apple Software.  You may
+ * not, directly or indirectly, redistribute the Apple Software or any portions thereof.
+ */
+
+#ifndef _CORECRYPTO_CCAES_AESNI_MODES_H_
+#define _CORECRYPTO_CCAES_AESNI_MODES_H_
+
+#include <corecrypto/ccaes.h>
+#include "ccmode_internal.h"
+
+// AES-XTS, AES-CBC decryption and AES-CTR written with AES-NI intrinsics, for x86_64
+// builds that do not have the Intel assembly. They operate on the LTC ECB
+// keys held by the generic ccmode factory contexts.
+#if !CCAES_INTEL_ASM && !CCAES_ARM_ASM && defined(__x86_64__) && \
+    (defined(__GNUC__) || defined(__clang__)) && !CC_KERNEL
+#define CCAES_AESNI_MODES 1
+#else
+#define CCAES_AESNI_MODES 0
+#endif
+
+#if CCAES_AESNI_MODES
+
+// Number of independent blocks in flight in the bulk loops.
+#define CCAES_AESNI_MODES_NBLOCKS 8
+
+/* Drop-in replacements for the xts field of a ccmode_xts built by
+ ccmode_factory_xts_encrypt/decrypt on top of the AES ECB modes. The caller is
+ responsible for checking that the CPU supports AES-NI. */
+void *ccaes_aesni_xts_encrypt(const ccxts_ctx *ctx, ccxts_tweak *tweak,
+                              size_t nblocks, const void *in, void *out);
+
+void *ccaes_aesni_xts_decrypt(const ccxts_ctx *ctx, ccxts_tweak *tweak,
+                              size_t nblocks, const void *in, void *out);
+
+/* Drop-in replacement for the cbc field of a ccmode_cbc built by
+ ccmode_factory_cbc_decrypt on top of the AES ECB decrypt mode. */
+int ccaes_aesni_cbc_decrypt(const cccbc_ctx *ctx, cccbc_iv *iv,
+                            size_t nblocks, const void *in, void *out);
+
+/* Drop-in replacement for the ctr field of a ccmode_ctr built by
+ ccmode_factory_ctr_crypt on top of the AES ECB encrypt mode. */
+int ccaes_aesni_ctr_crypt(ccctr_ctx *ctx, size_t nbytes, const void *in, void *out);
+
+/* Replacement for the init field of the same ccmode_ctr, the expanded key
+ it produces can only be used by ccaes_aesni_ctr_crypt. */
+int ccaes_aesni_ctr_init(const struct ccmode_ctr *ctr, ccctr_ctx *key,
+                         size_t rawkey_len, const void *rawkey, const void *iv);
+
+#endif /* CCAES_AESNI_MODES */
+
+#endif /* _CORECRYPTO_CCAES_AESNI_MODES_H_ */
@@ -33,6 +33,27 @@
 */
 int ccaes_unwind_with_ecb(const struct ccmode_ecb *aesecb, size_t key_nbytes, const void *key, void *out);
 
+/*!
+  @function ccaes_ltc_ecb_roundkeys
+  @abstract Returns the expanded key of an AES key initialized by the LTC ECB modes.
+  @param ctx The ECB key
+  @param decrypt Whether to return the decryption (equivalent inverse cipher) schedule
+  @param nrounds The number of rounds
+  @result nrounds + 1 round keys of CCAES_ROUNDKEY_SIZE bytes, in the order they are applied.
+  @discussion On little-endian targets, the round keys are laid out as expected by AESENC and AESDEC.
+*/
+const uint8_t *ccaes_ltc_ecb_roundkeys(const ccecb_ctx *ctx, bool decrypt, unsigned *nrounds);
+
+/*!
+  @function ccaes_ltc_ecb_set_encrypt_roundkeys
+  @abstract Sets the encryption schedule of an LTC ECB key expanded elsewhere.
+  @param ctx The ECB key
+  @param nrounds The number of rounds
+  @param roundkeys nrounds + 1 round keys, laid out as returned by ccaes_ltc_ecb_roundkeys()
+  @discussion The decryption schedule is cleared, the key can only be used to encrypt.
+*/
+void ccaes_ltc_ecb_set_encrypt_roundkeys(ccecb_ctx *ctx, unsigned nrounds, const uint8_t *roundkeys);
+
 /// Function to ensure that the key past has a length that corresponds to a correct AES key length in bits or bytes.
 /// @param key_nbytes_or_bits Number representing the AES key length in either bits or bytes.
 /// @result CCERR_OK if key length corresponds to legitimate length in bits or bytes, and CCERR_PARAMETER otherwise
@@ -17,15 +17,16 @@
 #include "cc_runtime_config.h"
 #include "crypto_test_aes_modes.h"
 #include "ccaes_vng_gcm.h"
+#include "ccaes_aesni_gcm.h"
 
 #if (CCAES_MODES == 0)
 entryPoint(ccaes_modes_tests,"ccaes mode")
 #else
 #include "crypto_test_modes.h"
 
-static int kTestTestCount = 118679 /* base */
+static int kTestTestCount = 118908 /* base */
 #if     CCAES_INTEL_ASM
-        + 50993;
+        + 51057;
 #else
         + 0;
 #endif
@@ -69,6 +70,13 @@ int ccaes_modes_tests(TM_UNUSED int argc, TM_UNUSED char *const *argv)
     struct ccmode_gcm ccaes_vng_ltc_gcm_decrypt_mode = CCAES_VNG_GCM_DECRYPT(&ccaes_ltc_ecb_encrypt_mode);
 #endif
 
+#if CCMODE_GCM_AESNI_SPEEDUP
+    struct ccmode_gcm ccaes_aesni_ltc_gcm_encrypt_mode = CCAES_AESNI_GCM_ENCRYPT(&ccaes_ltc_ecb_encrypt_mode);
+    struct ccmode_gcm ccaes_aesni_ltc_gcm_decrypt_mode = CCAES_AESNI_GCM_DECRYPT(&ccaes_ltc_ecb_encrypt_mode);
+    bool has_aesni_gcm = CC_HAS_AESNI() && CC_HAS_PCLMULQDQ() && CC_HAS_SupplementalSSE3();
+    if (has_aesni_gcm) kTestTestCount += 1283;
+#endif
+
 #if CCAES_INTEL_ASM
     if(CC_HAS_AESNI()) kTestTestCount+=69;
 #endif
@@ -78,6 +86,7 @@ int ccaes_modes_tests(TM_UNUSED int argc, TM_UNUSED char *const *argv)
 
     test_ctr("Default AES-CTR",ccaes_ctr_crypt_mode(), ccaes_ctr_crypt_mode(), aes_ctr_vectors);
     test_ctr("Generic AES-CTR",&ccaes_generic_ctr_crypt_mode, &ccaes_generic_ctr_crypt_mode, aes_ctr_vectors);
+    ok(test_ctr_stream(ccaes_ctr_crypt_mode(), &ccaes_generic_ctr_crypt_mode), "Default AES-CTR stream");
 
     ok(test_hmac_mode((ciphermode_t)ccaes_siv_hmac_sha256_encrypt_mode(), (ciphermode_t)ccaes_siv_hmac_sha256_decrypt_mode(), cc_cipherAES, cc_ModeSIV_HMAC, cc_digestSHA256) == 1, "Generic AES-SIV-HMAC");
     ok(test_mode((ciphermode_t)ccaes_siv_encrypt_mode(), (ciphermode_t)ccaes_siv_decrypt_mode(), cc_cipherAES, cc_ModeSIV) == 1, "Generic AES-SIV");
@@ -119,10 +128,21 @@ int ccaes_modes_tests(TM_UNUSED int argc, TM_UNUSED char *const *argv)
     ok(test_ccm(&ccaes_generic_ltc_ccm_encrypt_mode, &ccaes_generic_ltc_ccm_decrypt_mode), "Generic AES-CCM Extended testing");
     ok(test_xts(ccaes_xts_encrypt_mode(), ccaes_xts_decrypt_mode()), "Default AES-XTS Extended testing");
     ok(test_xts(&ccaes_generic_ltc_xts_encrypt_mode, &ccaes_generic_ltc_xts_decrypt_mode), "Generic AES-XTS Extended testing");
+    ok(test_xts_sectors(ccaes_xts_encrypt_mode(), ccaes_xts_decrypt_mode(), &ccaes_generic_ltc_xts_encrypt_mode), "Default AES-XTS sectors");
+    ok(test_xts_sectors(&ccaes_generic_ltc_xts_encrypt_mode, &ccaes_generic_ltc_xts_decrypt_mode, &ccaes_generic_ltc_xts_encrypt_mode), "Generic AES-XTS sectors");
+    ok(test_cbc_sectors(ccaes_cbc_encrypt_mode(), ccaes_cbc_decrypt_mode()), "Default AES-CBC sectors");
+    ok(test_cbc_sectors(&ccaes_gladman_cbc_encrypt_mode, &ccaes_gladman_cbc_decrypt_mode), "Standard AES-CBC sectors");
 #if CCMODE_GCM_VNG_SPEEDUP && !defined(WORKAROUND_42544245)
     ok(test_mode((ciphermode_t) (const struct ccmode_gcm *) &ccaes_vng_ltc_gcm_encrypt_mode,
                   (ciphermode_t) (const struct ccmode_gcm *) &ccaes_vng_ltc_gcm_decrypt_mode, cc_cipherAES, cc_ModeGCM) == 1, "VNG/LTC AES-GCM");
     ok(test_gcm(&ccaes_vng_ltc_gcm_encrypt_mode, &ccaes_vng_ltc_gcm_decrypt_mode), "VNG/LTC AES-GCM Extended testing");
+#endif
+#if CCMODE_GCM_AESNI_SPEEDUP
+    if (has_aesni_gcm) {
+        ok(test_mode((ciphermode_t) (const struct ccmode_gcm *) &ccaes_aesni_ltc_gcm_encrypt_mode,
+                     (ciphermode_t) (const struct ccmode_gcm *) &ccaes_aesni_ltc_gcm_decrypt_mode, cc_cipherAES, cc_ModeGCM) == 1, "AES-NI/LTC AES-GCM");
+        ok(test_gcm(&ccaes_aesni_ltc_gcm_encrypt_mode, &ccaes_aesni_ltc_gcm_decrypt_mode), "AES-NI/LTC AES-GCM Extended testing");
+    }
 #endif
     return 0;
 }
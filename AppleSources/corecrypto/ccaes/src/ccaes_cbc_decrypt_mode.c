@@ -12,6 +12,7 @@
 #include <corecrypto/ccaes.h>
 #include "ccmode_internal.h"
 #include "cc_runtime_config.h"
+#include "ccaes_aesni_modes.h"
 
 #if CC_KERNEL && CC_SMALL_CODE
  #error "Must use CC_READ_ONLY_LATE with CC_KERNEL=1"
@@ -28,6 +29,16 @@ const struct ccmode_cbc *ccaes_cbc_decrypt_mode(void)
     ccmode_factory_cbc_decrypt(&cbc, ccaes_ecb_decrypt_mode());
     return &cbc;
 #else
+#if CCAES_AESNI_MODES
+    if (CC_HAS_AESNI()) {
+        static CC_READ_ONLY_LATE(struct ccmode_cbc) cbc_aesni;
+        if (!CC_CACHE_DESCRIPTORS || NULL == cbc_aesni.init) {
+            ccmode_factory_cbc_decrypt(&cbc_aesni, ccaes_ecb_decrypt_mode());
+            cbc_aesni.cbc = ccaes_aesni_cbc_decrypt;
+        }
+        return &cbc_aesni;
+    }
+#endif
     return &ccaes_gladman_cbc_decrypt_mode;
 #endif
 }
@@ -12,11 +12,25 @@
 #include <corecrypto/ccaes.h>
 #include "ccmode_internal.h"
 #include "ccaes_vng_ctr.h"
+#include "cc_runtime_config.h"
+#include "ccaes_aesni_modes.h"
 
 static CC_READ_ONLY_LATE(struct ccmode_ctr) ctr_crypt;
 
 const struct ccmode_ctr *ccaes_ctr_crypt_mode(void)
 {
+#if CCAES_AESNI_MODES
+    if (CC_HAS_AESNI()) {
+        static CC_READ_ONLY_LATE(struct ccmode_ctr) ctr_aesni;
+        if (!CC_CACHE_DESCRIPTORS || NULL == ctr_aesni.init) {
+            ccmode_factory_ctr_crypt(&ctr_aesni, ccaes_ecb_encrypt_mode());
+            ctr_aesni.init = ccaes_aesni_ctr_init;
+            ctr_aesni.ctr = ccaes_aesni_ctr_crypt;
+        }
+        return &ctr_aesni;
+    }
+#endif
+
     if (!CC_CACHE_DESCRIPTORS || NULL == ctr_crypt.init) {
 #if CCMODE_CTR_VNG_SPEEDUP
         ccaes_vng_ctr_crypt_mode_setup(&ctr_crypt);
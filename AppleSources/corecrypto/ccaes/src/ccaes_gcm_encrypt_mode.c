@@ -11,6 +11,8 @@
 
 #include <corecrypto/ccaes.h>
 #include "ccaes_vng_gcm.h"
+#include "ccaes_aesni_gcm.h"
+#include "cc_runtime_config.h"
 #include "ccmode_internal.h"
 
 static CC_READ_ONLY_LATE(struct ccmode_gcm) gcm_encrypt;
@@ -20,6 +22,12 @@ const struct ccmode_gcm *ccaes_gcm_encrypt_mode(void)
     if (!CC_CACHE_DESCRIPTORS || NULL == gcm_encrypt.init) {
 #if CCMODE_GCM_VNG_SPEEDUP
         ccaes_vng_factory_gcm_encrypt(&gcm_encrypt);
+#elif CCMODE_GCM_AESNI_SPEEDUP
+        if (CC_HAS_AESNI() && CC_HAS_PCLMULQDQ() && CC_HAS_SupplementalSSE3()) {
+            ccaes_aesni_factory_gcm_encrypt(&gcm_encrypt);
+        } else {
+            ccmode_factory_gcm_encrypt(&gcm_encrypt, ccaes_ecb_encrypt_mode());
+        }
 #else
         ccmode_factory_gcm_encrypt(&gcm_encrypt, ccaes_ecb_encrypt_mode());
 #endif
@@ -12,6 +12,7 @@
 #include <corecrypto/ccaes.h>
 #include "ccmode_internal.h"
 #include "cc_runtime_config.h"
+#include "ccaes_aesni_modes.h"
 
 #include "fipspost_trace.h"
 
@@ -32,6 +33,11 @@ const struct ccmode_xts *ccaes_xts_encrypt_mode(void)
         const struct ccmode_ecb *ecb_base_mode = ccaes_ecb_encrypt_mode();
         const struct ccmode_ecb *ecb_base_encrypt_mode = ccaes_ecb_encrypt_mode();
         ccmode_factory_xts_encrypt(&xts_encrypt, ecb_base_mode, ecb_base_encrypt_mode);
+#if CCAES_AESNI_MODES
+        if (CC_HAS_AESNI()) {
+            xts_encrypt.xts = ccaes_aesni_xts_encrypt;
+        }
+#endif
     }
     return &xts_encrypt;
 #endif
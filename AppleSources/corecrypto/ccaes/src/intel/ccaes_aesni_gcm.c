@@ -0,0 +1,363 @@
+/* Copyright (c) (2023) Apple Inc. All rights reserved.
+ *
+ * corecrypto is licensed under Apple Inc.’s Internal Use License Agreement (which
+ * is contained in the License.txt file distributed with corecrypto) and only to
+ * people who accept that license. IMPORTANT:  Any license rights granted to you by
+ * Apple Inc. (if any) are limited to internal use within your organization only on
+ * devices and computers you own or control, for the sole purpose of verifying the
+ * security characteristics and correct functioning of the Apple Software.  You may
+ * not, directly or indirectly, redistribute the Apple Software or any portions thereof.
+ */
+
+#include "cc_internal.h"
+#include "cc_macros.h"
+#include "ccaes_internal.h"
+#include "ccaes_aesni_gcm.h"
+
+#if CCMODE_GCM_AESNI_SPEEDUP
+
+#include <immintrin.h>
+
+#define CCAES_AESNI_GCM_TARGET __attribute__((target("aes,pclmul,ssse3")))
+
+/*
+ GHASH operates on byte-reversed blocks so that PCLMULQDQ sees the bits of
+ each 128-bit polynomial in the order it expects. Products are accumulated
+ unreduced (as lo, mid, hi 128-bit words) and reduced once per group of
+ blocks; the final shift and reduction follow "Intel Carry-Less Multiplication
+ Instruction and its Usage for Computing the GCM Mode", Gueron and Kounavis.
+ */
+
+CCAES_AESNI_GCM_TARGET
+static inline __m128i ghash_bswap(__m128i x)
+{
+    return _mm_shuffle_epi8(x, _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+}
+
+CCAES_AESNI_GCM_TARGET
+static inline void ghash_mul_acc(__m128i a, __m128i h, __m128i *lo, __m128i *mid, __m128i *hi)
+{
+    *lo = _mm_xor_si128(*lo, _mm_clmulepi64_si128(a, h, 0x00));
+    *hi = _mm_xor_si128(*hi, _mm_clmulepi64_si128(a, h, 0x11));
+    *mid = _mm_xor_si128(*mid, _mm_clmulepi64_si128(a, h, 0x01));
+    *mid = _mm_xor_si128(*mid, _mm_clmulepi64_si128(a, h, 0x10));
+}
+
+CCAES_AESNI_GCM_TARGET
+static inline __m128i ghash_reduce(__m128i lo, __m128i mid, __m128i hi)
+{
+    __m128i t0, t1, t2;
+
+    lo = _mm_xor_si128(lo, _mm_slli_si128(mid, 8));
+    hi = _mm_xor_si128(hi, _mm_srli_si128(mid, 8));
+
+    // Shift the 256-bit product left by one bit.
+    t0 = _mm_srli_epi32(lo, 31);
+    t1 = _mm_srli_epi32(hi, 31);
+    lo = _mm_slli_epi32(lo, 1);
+    hi = _mm_slli_epi32(hi, 1);
+    t2 = _mm_srli_si128(t0, 12);
+    t1 = _mm_slli_si128(t1, 4);
+    t0 = _mm_slli_si128(t0, 4);
+    lo = _mm_or_si128(lo, t0);
+    hi = _mm_or_si128(hi, t1);
+    hi = _mm_or_si128(hi, t2);
+
+    // Reduce modulo x^128 + x^7 + x^2 + x + 1.
+    t0 = _mm_xor_si128(_mm_slli_epi32(lo, 31), _mm_slli_epi32(lo, 30));
+    t0 = _mm_xor_si128(t0, _mm_slli_epi32(lo, 25));
+    t1 = _mm_srli_si128(t0, 4);
+    t0 = _mm_slli_si128(t0, 12);
+    lo = _mm_xor_si128(lo, t0);
+
+    t2 = _mm_xor_si128(_mm_srli_epi32(lo, 1), _mm_srli_epi32(lo, 2));
+    t2 = _mm_xor_si128(t2, _mm_srli_epi32(lo, 7));
+    t2 = _mm_xor_si128(t2, t1);
+    lo = _mm_xor_si128(lo, t2);
+
+    return _mm_xor_si128(hi, lo);
+}
+
+CCAES_AESNI_GCM_TARGET
+static inline __m128i ghash_mul(__m128i a, __m128i h)
+{
+    __m128i lo = _mm_setzero_si128(), mid = _mm_setzero_si128(), hi = _mm_setzero_si128();
+    ghash_mul_acc(a, h, &lo, &mid, &hi);
+    return ghash_reduce(lo, mid, hi);
+}
+
+CCAES_AESNI_GCM_TARGET
+static uint32_t aesni_subword(uint32_t w)
+{
+    // AESKEYGENASSIST returns SubWord() of its second word in the first one.
+    return (uint32_t)_mm_cvtsi128_si32(_mm_aeskeygenassist_si128(_mm_set1_epi32((int)w), 0));
+}
+
+// FIPS 197 key expansion, with the S-box applied by AESKEYGENASSIST.
+static void aesni_expand_key(struct _ccaes_aesni_gcm_tables *tables, size_t key_nbytes, const uint8_t *key)
+{
+    uint32_t w[4 * 15];
+    size_t nk = key_nbytes / 4;
+    size_t nw = 4 * (nk + 7);
+    uint32_t rcon = 1;
+
+    for (size_t i = 0; i < nk; i++) {
+        w[i] = cc_load32_le(key + 4 * i);
+    }
+
+    for (size_t i = nk; i < nw; i++) {
+        uint32_t t = w[i - 1];
+        if (i % nk == 0) {
+            t = aesni_subword(CC_RORc(t, 8)) ^ rcon;
+            rcon = (rcon << 1) ^ (0x11b & (0U - (rcon >> 7)));
+        } else if (nk > 6 && i % nk == 4) {
+            t = aesni_subword(t);
+        }
+        w[i] = w[i - nk] ^ t;
+    }
+
+    for (size_t i = 0; i < nw; i++) {
+        cc_store32_le(w[i], &tables->rk[i / 4][4 * (i % 4)]);
+    }
+    tables->nrounds = (uint32_t)(nk + 6);
+
+    cc_clear(sizeof(w), w);
+}
+
+CCAES_AESNI_GCM_TARGET
+static void aesni_gcm_init_htable(struct _ccaes_aesni_gcm_tables *tables, const uint8_t *H)
+{
+    __m128i h = ghash_bswap(_mm_loadu_si128((const __m128i *)H));
+    __m128i hn = h;
+
+    _mm_storeu_si128((__m128i *)tables->Htable[0], h);
+    for (size_t i = 1; i < CCAES_AESNI_GCM_NBLOCKS; i++) {
+        hn = ghash_mul(hn, h);
+        _mm_storeu_si128((__m128i *)tables->Htable[i], hn);
+    }
+}
+
+int ccaes_aesni_gcm_init(const struct ccmode_gcm *gcm, ccgcm_ctx *key,
+                         size_t rawkey_nbytes, const void *rawkey)
+{
+    int rc = ccaes_key_length_validation(rawkey_nbytes);
+    cc_require_or_return(rc == CCERR_OK, rc);
+
+    rc = ccmode_gcm_init(gcm, key, rawkey_nbytes, rawkey);
+    cc_require_or_return(rc == CCERR_OK, rc);
+
+    struct _ccaes_aesni_gcm_tables *tables = CCAES_AESNI_GCM_KEY_TABLES(key);
+    aesni_expand_key(tables, ccaes_key_length_to_nbytes(rawkey_nbytes), rawkey);
+    aesni_gcm_init_htable(tables, CCMODE_GCM_KEY_H(key));
+
+    return CCERR_OK;
+}
+
+/*
+ Encrypt or decrypt full blocks, starting with the counter in Y, and update
+ the counter and the GHASH accumulator X.
+
+ Eight counter blocks go through the AES rounds together. The GHASH of eight
+ ciphertext blocks is interleaved with the rounds and reduced only once: when
+ decrypting these are the input blocks of the same iteration, when encrypting
+ they are the output blocks of the previous iteration.
+ */
+CCAES_AESNI_GCM_TARGET
+static void aesni_gcm_blocks(ccgcm_ctx *key, size_t nblocks, const uint8_t *in, uint8_t *out, bool encrypt)
+{
+    const struct _ccaes_aesni_gcm_tables *tables = CCAES_AESNI_GCM_KEY_TABLES(key);
+    const __m128i *rk = (const __m128i *)tables->rk;
+    const __m128i *Htable = (const __m128i *)tables->Htable;
+    const size_t nrounds = tables->nrounds;
+
+    __m128i X = ghash_bswap(_mm_loadu_si128((const __m128i *)CCMODE_GCM_KEY_X(key)));
+    // Byte-reversed, the 32-bit big-endian counter becomes the first lane.
+    __m128i ctr = ghash_bswap(_mm_loadu_si128((const __m128i *)CCMODE_GCM_KEY_Y(key)));
+
+    __m128i b[CCAES_AESNI_GCM_NBLOCKS], c[CCAES_AESNI_GCM_NBLOCKS];
+    bool pending = false;
+
+    for (; nblocks >= CCAES_AESNI_GCM_NBLOCKS; nblocks -= CCAES_AESNI_GCM_NBLOCKS) {
+        __m128i lo = _mm_setzero_si128(), mid = _mm_setzero_si128(), hi = _mm_setzero_si128();
+        __m128i k = _mm_loadu_si128(&rk[0]);
+
+        for (size_t i = 0; i < CCAES_AESNI_GCM_NBLOCKS; i++) {
+            b[i] = ghash_bswap(_mm_add_epi32(ctr, _mm_set_epi32(0, 0, 0, (int)i)));
+            b[i] = _mm_xor_si128(b[i], k);
+        }
+        ctr = _mm_add_epi32(ctr, _mm_set_epi32(0, 0, 0, CCAES_AESNI_GCM_NBLOCKS));
+
+        if (!encrypt) {
+            for (size_t i = 0; i < CCAES_AESNI_GCM_NBLOCKS; i++) {
+                c[i] = ghash_bswap(_mm_loadu_si128((const __m128i *)in + i));
+            }
+            pending = true;
+        }
+
+        if (pending) {
+            c[0] = _mm_xor_si128(c[0], X);
+        }
+
+        // Rounds 1..8 each absorb one block into the GHASH accumulator.
+        for (size_t r = 1; r <= CCAES_AESNI_GCM_NBLOCKS; r++) {
+            k = _mm_loadu_si128(&rk[r]);
+            for (size_t i = 0; i < CCAES_AESNI_GCM_NBLOCKS; i++) {
+                b[i] = _mm_aesenc_si128(b[i], k);
+            }
+            if (pending) {
+                ghash_mul_acc(c[r - 1], _mm_loadu_si128(&Htable[CCAES_AESNI_GCM_NBLOCKS - r]), &lo, &mid, &hi);
+            }
+        }
+
+        for (size_t r = CCAES_AESNI_GCM_NBLOCKS + 1; r < nrounds; r++) {
+            k = _mm_loadu_si128(&rk[r]);
+            for (size_t i = 0; i < CCAES_AESNI_GCM_NBLOCKS; i++) {
+                b[i] = _mm_aesenc_si128(b[i], k);
+            }
+        }
+
+        if (pending) {
+            X = ghash_reduce(lo, mid, hi);
+        }
+
+        k = _mm_loadu_si128(&rk[nrounds]);
+        for (size_t i = 0; i < CCAES_AESNI_GCM_NBLOCKS; i++) {
+            b[i] = _mm_aesenclast_si128(b[i], k);
+            b[i] = _mm_xor_si128(b[i], _mm_loadu_si128((const __m128i *)in + i));
+            _mm_storeu_si128((__m128i *)out + i, b[i]);
+        }
+
+        if (encrypt) {
+            for (size_t i = 0; i < CCAES_AESNI_GCM_NBLOCKS; i++) {
+                c[i] = ghash_bswap(b[i]);
+            }
+        }
+        pending = encrypt;
+
+        in += CCAES_AESNI_GCM_NBLOCKS * CCGCM_BLOCK_NBYTES;
+        out += CCAES_AESNI_GCM_NBLOCKS * CCGCM_BLOCK_NBYTES;
+    }
+
+    // Hash the ciphertext of the last encrypted group.
+    if (pending) {
+        __m128i lo = _mm_setzero_si128(), mid = _mm_setzero_si128(), hi = _mm_setzero_si128();
+        c[0] = _mm_xor_si128(c[0], X);
+        for (size_t i = 0; i < CCAES_AESNI_GCM_NBLOCKS; i++) {
+            ghash_mul_acc(c[i], _mm_loadu_si128(&Htable[CCAES_AESNI_GCM_NBLOCKS - 1 - i]), &lo, &mid, &hi);
+        }
+        X = ghash_reduce(lo, mid, hi);
+    }
+
+    for (; nblocks > 0; nblocks--) {
+        __m128i m = _mm_loadu_si128((const __m128i *)in);
+        __m128i s = _mm_xor_si128(ghash_bswap(ctr), _mm_loadu_si128(&rk[0]));
+        for (size_t r = 1; r < nrounds; r++) {
+            s = _mm_aesenc_si128(s, _mm_loadu_si128(&rk[r]));
+        }
+        s = _mm_aesenclast_si128(s, _mm_loadu_si128(&rk[nrounds]));
+        s = _mm_xor_si128(s, m);
+        _mm_storeu_si128((__m128i *)out, s);
+
+        X = ghash_mul(_mm_xor_si128(X, ghash_bswap(encrypt ? s : m)), _mm_loadu_si128(&Htable[0]));
+        ctr = _mm_add_epi32(ctr, _mm_set_epi32(0, 0, 0, 1));
+
+        in += CCGCM_BLOCK_NBYTES;
+        out += CCGCM_BLOCK_NBYTES;
+    }
+
+    _mm_storeu_si128((__m128i *)CCMODE_GCM_KEY_X(key), ghash_bswap(X));
+    _mm_storeu_si128((__m128i *)CCMODE_GCM_KEY_Y(key), ghash_bswap(ctr));
+
+    cc_clear(sizeof(b), b);
+    cc_clear(sizeof(c), c);
+}
+
+static int ccaes_aesni_gcm_crypt(ccgcm_ctx *key, size_t nbytes, const void *in, void *out, bool encrypt)
+{
+    const uint8_t *input = in;
+    uint8_t *output = out;
+
+    uint8_t *X = CCMODE_GCM_KEY_X(key);
+    uint8_t *pad = CCMODE_GCM_KEY_PAD(key);
+
+    // The ciphertext is the output when encrypting, the input when decrypting.
+    const uint8_t *ctext = encrypt ? output : input;
+
+    // X and the pad are always in sync with regards to offsets
+    uint32_t Xpad_nbytes = _CCMODE_GCM_KEY(key)->text_nbytes % CCGCM_BLOCK_NBYTES;
+    uint32_t Xpad_nbytes_needed = CCGCM_BLOCK_NBYTES - Xpad_nbytes;
+
+    ccmode_gcm_aad_finalize(key);
+    cc_require(_CCMODE_GCM_KEY(key)->state == CCMODE_GCM_STATE_TEXT, callseq_out);
+    cc_require(UINT64_MAX - _CCMODE_GCM_KEY(key)->text_nbytes >= nbytes, input_out);
+    cc_require(_CCMODE_GCM_KEY(key)->text_nbytes + nbytes <= CCGCM_TEXT_MAX_NBYTES, input_out);
+
+    // finish a partial block, if possible
+    if (Xpad_nbytes > 0 && nbytes >= Xpad_nbytes_needed) {
+        if (encrypt) {
+            cc_xor(Xpad_nbytes_needed, output, input, pad + Xpad_nbytes);
+            cc_xor(Xpad_nbytes_needed, X + Xpad_nbytes, X + Xpad_nbytes, ctext);
+        } else {
+            cc_xor(Xpad_nbytes_needed, X + Xpad_nbytes, X + Xpad_nbytes, ctext);
+            cc_xor(Xpad_nbytes_needed, output, input, pad + Xpad_nbytes);
+        }
+        ccmode_gcm_mult_h(key, X);
+
+        nbytes -= Xpad_nbytes_needed;
+        input += Xpad_nbytes_needed;
+        output += Xpad_nbytes_needed;
+        ctext += Xpad_nbytes_needed;
+        _CCMODE_GCM_KEY(key)->text_nbytes += Xpad_nbytes_needed;
+        Xpad_nbytes = 0;
+
+        ccmode_gcm_update_pad(key);
+    }
+
+    // process full blocks, if any
+    if (Xpad_nbytes == 0 && nbytes >= CCGCM_BLOCK_NBYTES) {
+        size_t nblocks = nbytes / CCGCM_BLOCK_NBYTES;
+        aesni_gcm_blocks(key, nblocks, input, output, encrypt);
+
+        nbytes -= nblocks * CCGCM_BLOCK_NBYTES;
+        input += nblocks * CCGCM_BLOCK_NBYTES;
+        output += nblocks * CCGCM_BLOCK_NBYTES;
+        ctext += nblocks * CCGCM_BLOCK_NBYTES;
+        _CCMODE_GCM_KEY(key)->text_nbytes += nblocks * CCGCM_BLOCK_NBYTES;
+
+        // Y now holds the counter of the next block.
+        CCMODE_GCM_KEY_ECB(key)->ecb(CCMODE_GCM_KEY_ECB_KEY(key), 1, CCMODE_GCM_KEY_Y(key), pad);
+    }
+
+    // process the remainder
+    if (nbytes > 0) {
+        if (encrypt) {
+            cc_xor(nbytes, output, input, pad + Xpad_nbytes);
+            cc_xor(nbytes, X + Xpad_nbytes, X + Xpad_nbytes, ctext);
+        } else {
+            cc_xor(nbytes, X + Xpad_nbytes, X + Xpad_nbytes, ctext);
+            cc_xor(nbytes, output, input, pad + Xpad_nbytes);
+        }
+
+        _CCMODE_GCM_KEY(key)->text_nbytes += nbytes;
+    }
+
+    return 0;
+
+ callseq_out:
+    return CCMODE_INVALID_CALL_SEQUENCE;
+
+ input_out:
+    return CCMODE_INVALID_INPUT;
+}
+
+int ccaes_aesni_gcm_encrypt(ccgcm_ctx *key, size_t nbytes, const void *in, void *out)
+{
+    return ccaes_aesni_gcm_crypt(key, nbytes, in, out, true);
+}
+
+int ccaes_aesni_gcm_decrypt(ccgcm_ctx *key, size_t nbytes, const void *in, void *out)
+{
+    return ccaes_aesni_gcm_crypt(key, nbytes, in, out, false);
+}
+
+#endif /* CCMODE_GCM_AESNI_SPEEDUP */
@@ -0,0 +1,334 @@
+/* Copyright (c) (2023) Apple Inc. All rights reserved.
+ *
+ * corecrypto is licensed under Apple Inc.’s Internal Use License Agreement (which
+ * is contained in the License.txt file distributed with corecrypto) and only to
+ * people who accept that license. IMPORTANT:  Any license rights granted to you by
+ * Apple Inc. (if any) are limited to internal use within your organization only on
+ * devices and computers you own or control, for the sole purpose of verifying the
+ * security characteristics and correct functioning of the Apple Software.  You may
+ * not, directly or indirectly, redistribute the Apple Software or any portions thereof.
+ */
+
+#include "cc_internal.h"
+#include "ccaes_internal.h"
+#include "ccaes_aesni_modes.h"
+
+#if CCAES_AESNI_MODES
+
+#include <immintrin.h>
+
+#define CCAES_AESNI_MODES_TARGET __attribute__((target("aes")))
+
+#define NBLOCKS CCAES_AESNI_MODES_NBLOCKS
+
+CCAES_AESNI_MODES_TARGET
+static inline unsigned aesni_load_roundkeys(__m128i rk[15], const ccecb_ctx *key, bool decrypt)
+{
+    unsigned nrounds;
+    const uint8_t *keys = ccaes_ltc_ecb_roundkeys(key, decrypt, &nrounds);
+
+    for (unsigned i = 0; i <= nrounds; i++) {
+        rk[i] = _mm_loadu_si128((const __m128i *)(keys + CCAES_ROUNDKEY_SIZE * i));
+    }
+
+    return nrounds;
+}
+
+/* Runs rounds 1..nrounds on n blocks already xored with the first round key,
+ interleaving the blocks so that several AESENC/AESDEC are in flight. */
+CCAES_AESNI_MODES_TARGET
+static inline __attribute__((always_inline)) void
+aesni_rounds(size_t n, __m128i *x, const __m128i rk[15], unsigned nrounds, bool decrypt)
+{
+    for (unsigned r = 1; r < nrounds; r++) {
+        for (size_t j = 0; j < n; j++) {
+            x[j] = decrypt ? _mm_aesdec_si128(x[j], rk[r]) : _mm_aesenc_si128(x[j], rk[r]);
+        }
+    }
+    for (size_t j = 0; j < n; j++) {
+        x[j] = decrypt ? _mm_aesdeclast_si128(x[j], rk[nrounds]) : _mm_aesenclast_si128(x[j], rk[nrounds]);
+    }
+}
+
+/* Multiply the tweak by alpha, cf. ccmode_xts_mult_alpha(). Each 32-bit lane
+ is shifted left by one, its top bit moves to the next lane and the top bit of
+ the last lane is reduced into the first one. */
+CCAES_AESNI_MODES_TARGET
+static inline __m128i aesni_xts_mult_alpha(__m128i t)
+{
+    __m128i carry = _mm_shuffle_epi32(_mm_srai_epi32(t, 31), _MM_SHUFFLE(2, 1, 0, 3));
+    carry = _mm_and_si128(carry, _mm_set_epi32(1, 1, 1, 0x87));
+    return _mm_xor_si128(_mm_slli_epi32(t, 1), carry);
+}
+
+CCAES_AESNI_MODES_TARGET
+static inline __attribute__((always_inline)) void *
+aesni_xts(const ccxts_ctx *ctx, ccxts_tweak *tweak, size_t nblocks, const void *in, void *out, bool decrypt)
+{
+    size_t numBlocks = CCMODE_XTS_TWEAK_BLOCK_PROCESSED(tweak) + nblocks;
+    if (numBlocks > (1 << 20)) {
+        return NULL;
+    }
+    CCMODE_XTS_TWEAK_BLOCK_PROCESSED(tweak) = numBlocks;
+
+    __m128i rk[15];
+    unsigned nrounds = aesni_load_roundkeys(rk, ccmode_xts_key_data_key(ctx), decrypt);
+
+    cc_unit *tv = CCMODE_XTS_TWEAK_VALUE(tweak);
+    __m128i t = _mm_loadu_si128((const __m128i *)tv);
+    const uint8_t *ip = in;
+    uint8_t *op = out;
+
+    for (; nblocks >= NBLOCKS; nblocks -= NBLOCKS) {
+        __m128i tw[NBLOCKS], x[NBLOCKS];
+
+        for (size_t j = 0; j < NBLOCKS; j++) {
+            tw[j] = t;
+            t = aesni_xts_mult_alpha(t);
+            x[j] = _mm_xor_si128(_mm_loadu_si128((const __m128i *)(ip + 16 * j)), _mm_xor_si128(tw[j], rk[0]));
+        }
+
+        aesni_rounds(NBLOCKS, x, rk, nrounds, decrypt);
+
+        for (size_t j = 0; j < NBLOCKS; j++) {
+            _mm_storeu_si128((__m128i *)(op + 16 * j), _mm_xor_si128(x[j], tw[j]));
+        }
+
+        ip += 16 * NBLOCKS;
+        op += 16 * NBLOCKS;
+    }
+
+    for (; nblocks > 0; nblocks--) {
+        __m128i x = _mm_xor_si128(_mm_loadu_si128((const __m128i *)ip), _mm_xor_si128(t, rk[0]));
+        aesni_rounds(1, &x, rk, nrounds, decrypt);
+        _mm_storeu_si128((__m128i *)op, _mm_xor_si128(x, t));
+        t = aesni_xts_mult_alpha(t);
+
+        ip += 16;
+        op += 16;
+    }
+
+    _mm_storeu_si128((__m128i *)tv, t);
+    return tv;
+}
+
+CCAES_AESNI_MODES_TARGET
+void *ccaes_aesni_xts_encrypt(const ccxts_ctx *ctx, ccxts_tweak *tweak,
+                              size_t nblocks, const void *in, void *out)
+{
+    return aesni_xts(ctx, tweak, nblocks, in, out, false);
+}
+
+CCAES_AESNI_MODES_TARGET
+void *ccaes_aesni_xts_decrypt(const ccxts_ctx *ctx, ccxts_tweak *tweak,
+                              size_t nblocks, const void *in, void *out)
+{
+    return aesni_xts(ctx, tweak, nblocks, in, out, true);
+}
+
+/* Unlike encryption, CBC decryption of consecutive blocks is independent: all
+ ciphertext blocks of a group are loaded before any plaintext is stored so
+ that in and out may alias. */
+CCAES_AESNI_MODES_TARGET
+int ccaes_aesni_cbc_decrypt(const cccbc_ctx *ctx, cccbc_iv *iv,
+                            size_t nblocks, const void *in, void *out)
+{
+    __m128i rk[15];
+    unsigned nrounds = aesni_load_roundkeys(rk, ccmode_cbc_key_ecb_key(ctx), true);
+
+    __m128i prev = _mm_loadu_si128((const __m128i *)iv);
+    const uint8_t *ip = in;
+    uint8_t *op = out;
+
+    for (; nblocks >= NBLOCKS; nblocks -= NBLOCKS) {
+        __m128i c[NBLOCKS], x[NBLOCKS];
+
+        for (size_t j = 0; j < NBLOCKS; j++) {
+            c[j] = _mm_loadu_si128((const __m128i *)(ip + 16 * j));
+            x[j] = _mm_xor_si128(c[j], rk[0]);
+        }
+
+        aesni_rounds(NBLOCKS, x, rk, nrounds, true);
+
+        _mm_storeu_si128((__m128i *)op, _mm_xor_si128(x[0], prev));
+        for (size_t j = 1; j < NBLOCKS; j++) {
+            _mm_storeu_si128((__m128i *)(op + 16 * j), _mm_xor_si128(x[j], c[j - 1]));
+        }
+        prev = c[NBLOCKS - 1];
+
+        ip += 16 * NBLOCKS;
+        op += 16 * NBLOCKS;
+    }
+
+    for (; nblocks > 0; nblocks--) {
+        __m128i c = _mm_loadu_si128((const __m128i *)ip);
+        __m128i x = _mm_xor_si128(c, rk[0]);
+        aesni_rounds(1, &x, rk, nrounds, true);
+        _mm_storeu_si128((__m128i *)op, _mm_xor_si128(x, prev));
+        prev = c;
+
+        ip += 16;
+        op += 16;
+    }
+
+    _mm_storeu_si128((__m128i *)iv, prev);
+    return CCERR_OK;
+}
+
+/* One step of the key expansion: t holds SubWord(RotWord(w)) ^ Rcon (or
+ SubWord(w) for the odd AES-256 round keys) broadcast to all lanes. */
+CCAES_AESNI_MODES_TARGET
+static inline __m128i aesni_expand_step(__m128i k, __m128i t)
+{
+    k = _mm_xor_si128(k, _mm_slli_si128(k, 4));
+    k = _mm_xor_si128(k, _mm_slli_si128(k, 4));
+    k = _mm_xor_si128(k, _mm_slli_si128(k, 4));
+    return _mm_xor_si128(k, t);
+}
+
+#define AESNI_EXPAND128(rk, i, rcon) \
+    rk[i] = aesni_expand_step(rk[i - 1], _mm_shuffle_epi32(_mm_aeskeygenassist_si128(rk[i - 1], rcon), 0xff))
+
+#define AESNI_EXPAND256(rk, i, rcon)                                                                          \
+    rk[i] = aesni_expand_step(rk[i - 2], _mm_shuffle_epi32(_mm_aeskeygenassist_si128(rk[i - 1], rcon), 0xff)); \
+    if (i + 1 < 15) {                                                                                         \
+        rk[i + 1] = aesni_expand_step(rk[i - 1], _mm_shuffle_epi32(_mm_aeskeygenassist_si128(rk[i], 0), 0xaa)); \
+    }
+
+/* Encryption key schedule only: CTR never decrypts, and the inverse schedule
+ is most of the cost of ccaes_ltc_init(). 192-bit keys go through the LTC
+ code. */
+CCAES_AESNI_MODES_TARGET
+int ccaes_aesni_ctr_init(const struct ccmode_ctr *ctr, ccctr_ctx *key,
+                         size_t rawkey_len, const void *rawkey, const void *iv)
+{
+    __m128i rk[15];
+    unsigned nrounds;
+
+    if (rawkey_len == CCAES_KEY_SIZE_128) {
+        nrounds = 10;
+        rk[0] = _mm_loadu_si128((const __m128i *)rawkey);
+        AESNI_EXPAND128(rk, 1, 0x01);
+        AESNI_EXPAND128(rk, 2, 0x02);
+        AESNI_EXPAND128(rk, 3, 0x04);
+        AESNI_EXPAND128(rk, 4, 0x08);
+        AESNI_EXPAND128(rk, 5, 0x10);
+        AESNI_EXPAND128(rk, 6, 0x20);
+        AESNI_EXPAND128(rk, 7, 0x40);
+        AESNI_EXPAND128(rk, 8, 0x80);
+        AESNI_EXPAND128(rk, 9, 0x1b);
+        AESNI_EXPAND128(rk, 10, 0x36);
+    } else if (rawkey_len == CCAES_KEY_SIZE_256) {
+        nrounds = 14;
+        rk[0] = _mm_loadu_si128((const __m128i *)rawkey);
+        rk[1] = _mm_loadu_si128((const __m128i *)rawkey + 1);
+        AESNI_EXPAND256(rk, 2, 0x01);
+        AESNI_EXPAND256(rk, 4, 0x02);
+        AESNI_EXPAND256(rk, 6, 0x04);
+        AESNI_EXPAND256(rk, 8, 0x08);
+        AESNI_EXPAND256(rk, 10, 0x10);
+        AESNI_EXPAND256(rk, 12, 0x20);
+        AESNI_EXPAND256(rk, 14, 0x40);
+    } else {
+        return ccmode_ctr_init(ctr, key, rawkey_len, rawkey, iv);
+    }
+
+    uint8_t roundkeys[15 * CCAES_ROUNDKEY_SIZE];
+    for (unsigned i = 0; i <= nrounds; i++) {
+        _mm_storeu_si128((__m128i *)(roundkeys + CCAES_ROUNDKEY_SIZE * i), rk[i]);
+    }
+
+    CCMODE_CTR_KEY_ECB(key) = ctr->custom;
+    ccaes_ltc_ecb_set_encrypt_roundkeys(CCMODE_CTR_KEY_ECB_KEY(key), nrounds, roundkeys);
+    cc_clear(sizeof(roundkeys), roundkeys);
+    cc_clear(sizeof(rk), rk);
+
+    return ccmode_ctr_setctr(ctr, key, iv);
+}
+
+/* The counter is the last 64 bits of the block, big-endian, and wraps
+ without carrying into the first 64 bits, cf. ccmode_ctr_crypt(). */
+CCAES_AESNI_MODES_TARGET
+static inline __m128i aesni_ctr_block(uint64_t nonce, uint64_t ctr)
+{
+    return _mm_set_epi64x((long long)CC_BSWAP64(ctr), (long long)nonce);
+}
+
+CCAES_AESNI_MODES_TARGET
+int ccaes_aesni_ctr_crypt(ccctr_ctx *ctx, size_t nbytes, const void *in, void *out)
+{
+    uint8_t *ctrp = (uint8_t *)CCMODE_CTR_KEY_CTR(ctx);
+    uint8_t *pad = (uint8_t *)CCMODE_CTR_KEY_PAD(ctx);
+    size_t pad_offset = CCMODE_CTR_KEY_PAD_OFFSET(ctx);
+    const uint8_t *ip = in;
+    uint8_t *op = out;
+
+    // Use up the keystream left over by the previous call.
+    size_t n = CC_MIN(nbytes, CCAES_BLOCK_SIZE - pad_offset);
+    cc_xor(n, op, ip, pad + pad_offset);
+    pad_offset += n;
+    nbytes -= n;
+    ip += n;
+    op += n;
+
+    if (nbytes == 0) {
+        CCMODE_CTR_KEY_PAD_OFFSET(ctx) = pad_offset;
+        return 0;
+    }
+
+    __m128i rk[15];
+    unsigned nrounds = aesni_load_roundkeys(rk, CCMODE_CTR_KEY_ECB_KEY(ctx), false);
+
+    uint64_t nonce, ctr;
+    cc_memcpy(&nonce, ctrp, sizeof(nonce));
+    ctr = cc_load64_be(ctrp + sizeof(nonce));
+
+    for (; nbytes >= CCAES_BLOCK_SIZE * NBLOCKS; nbytes -= CCAES_BLOCK_SIZE * NBLOCKS) {
+        __m128i x[NBLOCKS];
+
+        for (size_t j = 0; j < NBLOCKS; j++) {
+            x[j] = _mm_xor_si128(aesni_ctr_block(nonce, ctr + j), rk[0]);
+        }
+        ctr += NBLOCKS;
+
+        aesni_rounds(NBLOCKS, x, rk, nrounds, false);
+
+        for (size_t j = 0; j < NBLOCKS; j++) {
+            __m128i p = _mm_loadu_si128((const __m128i *)(ip + 16 * j));
+            _mm_storeu_si128((__m128i *)(op + 16 * j), _mm_xor_si128(x[j], p));
+        }
+
+        ip += CCAES_BLOCK_SIZE * NBLOCKS;
+        op += CCAES_BLOCK_SIZE * NBLOCKS;
+    }
+
+    // Remaining blocks, the last one possibly partial, in one batch.
+    if (nbytes > 0) {
+        size_t nblocks = cc_ceiling(nbytes, CCAES_BLOCK_SIZE);
+        __m128i x[NBLOCKS];
+
+        for (size_t j = 0; j < nblocks; j++) {
+            x[j] = _mm_xor_si128(aesni_ctr_block(nonce, ctr + j), rk[0]);
+        }
+        ctr += nblocks;
+
+        aesni_rounds(nblocks, x, rk, nrounds, false);
+
+        for (size_t j = 0; j + 1 < nblocks; j++) {
+            __m128i p = _mm_loadu_si128((const __m128i *)(ip + 16 * j));
+            _mm_storeu_si128((__m128i *)(op + 16 * j), _mm_xor_si128(x[j], p));
+        }
+
+        // The last keystream block is kept for the next call.
+        size_t last = 16 * (nblocks - 1);
+        _mm_storeu_si128((__m128i *)pad, x[nblocks - 1]);
+        pad_offset = nbytes - last;
+        cc_xor(pad_offset, op + last, ip + last, pad);
+    }
+
+    cc_store64_be(ctr, ctrp + sizeof(nonce));
+    CCMODE_CTR_KEY_PAD_OFFSET(ctx) = pad_offset;
+    return 0;
+}
+
+#endif /* CCAES_AESNI_MODES */
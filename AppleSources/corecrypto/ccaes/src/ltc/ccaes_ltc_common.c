@@ -182,3 +182,18 @@ void ccaes_ecb_encrypt_roundkey(const ccecb_ctx *ctx, unsigned i, void *roundkey
     const ltc_rijndael_keysched *skey = (const ltc_rijndael_keysched *)ctx;
     cc_memcpy(roundkey, &skey->enc.ks[i * 4], CCAES_ROUNDKEY_SIZE);
 }
+
+const uint8_t *ccaes_ltc_ecb_roundkeys(const ccecb_ctx *ctx, bool decrypt, unsigned *nrounds)
+{
+    const ltc_rijndael_keysched *skey = (const ltc_rijndael_keysched *)ctx;
+    *nrounds = skey->enc.rn / 16;
+    return (const uint8_t *)(decrypt ? skey->dec.ks : skey->enc.ks);
+}
+
+void ccaes_ltc_ecb_set_encrypt_roundkeys(ccecb_ctx *ctx, unsigned nrounds, const uint8_t *roundkeys)
+{
+    ltc_rijndael_keysched *skey = (ltc_rijndael_keysched *)ctx;
+    cc_memcpy(skey->enc.ks, roundkeys, CCAES_ROUNDKEY_SIZE * (nrounds + 1));
+    cc_clear(sizeof(skey->dec.ks), skey->dec.ks);
+    skey->enc.rn = skey->dec.rn = nrounds * 16;
+}
@@ -19,10 +19,16 @@
 #include <corecrypto/ccrng.h>
 #include "ccbfv_util.h"
 
+// On CPUs with AVX-512 IFMA, each context also stores 52-bit Shoup factors (2 * N cc_units).
+// Reserve room for up to 8 such contexts with the largest tested degree, N = 4096.
+#define CCBFV_TEST_WORKSPACE_N                                                                       \
+    (ccn_nof_size(2 * 1024 * 1024) +                                                                 \
+     (ccpolyzp_po2cyc_ctx_has_shoup52() ? 8 * 2 * 4096 * CCPOLYZP_PO2CYC_NUNITS_PER_COEFF : 0))
+
 #undef CC_DECL_WORKSPACE_TEST
 #define CC_DECL_WORKSPACE_TEST(ws)                                    \
     int ws##_rv;                                                      \
-    CC_DECL_WORKSPACE_RV(ws, ccn_nof_size(2 * 1024 * 1024), ws##_rv); \
+    CC_DECL_WORKSPACE_RV(ws, CCBFV_TEST_WORKSPACE_N, ws##_rv);        \
     cc_try_abort_if(ws##_rv != CCERR_OK, "alloc ws");
 
 static void verify_poly_ctx(ccpolyzp_po2cyc_ctx_const_t ctx, uint32_t nmoduli, const ccrns_int *cc_counted_by(nmoduli) moduli)
@@ -458,6 +458,7 @@ int ccbfv_ciphertext_galois_key_switch_ws(cc_ws_t ws,
         ccpolyzp_po2cyc_init_zero(buffer, buffer_ctx);
 
         ccn_clear(2 * CCPOLYZP_PO2CYC_NUNITS_PER_COEFF * degree * ctext_npolys, poly_lazy_128);
+        bool overflow = false;
 
         // Iterate over RNS components of target and key-switching key (i.e., P_{Q_i}(s_A))
         for (uint32_t j = 0; j < ctext_nmoduli; ++j) {
@@ -477,7 +478,7 @@ int ccbfv_ciphertext_galois_key_switch_ws(cc_ws_t ws,
                 }
             }
             // Put the digits of r in NTT form
-            cc_require(rv = ccpolyzp_po2cyc_fwd_ntt((ccpolyzp_po2cyc_coeff_t)buffer) == CCERR_OK, errOut);
+            cc_require((rv = ccpolyzp_po2cyc_fwd_ntt((ccpolyzp_po2cyc_coeff_t)buffer)) == CCERR_OK, errOut);
 
             // Perform the product with the key-switching key, delaying modular reduction during accumulation
             for (uint32_t k = 0; k < ctext_npolys; ++k) {
@@ -488,13 +489,15 @@ int ccbfv_ciphertext_galois_key_switch_ws(cc_ws_t ws,
                     const cc_unit *buffer_data = CCPOLYZP_PO2CYC_DATA_CONST(buffer, 0, coeff_idx);
 
                     cc_unit *lazy_128_rns = &poly_lazy_128[2 * CCPOLYZP_PO2CYC_NUNITS_PER_COEFF * (k * degree + coeff_idx)];
-                    cc_unit prod[2 * CCPOLYZP_PO2CYC_NUNITS_PER_COEFF] = { 0 };
-                    ccn_mul(CCPOLYZP_PO2CYC_NUNITS_PER_COEFF, prod, gk_data, buffer_data);
-
-                    cc_unit carry = ccn_add_ws(ws, 2 * CCPOLYZP_PO2CYC_NUNITS_PER_COEFF, lazy_128_rns, lazy_128_rns, prod);
-                    cc_require_or_return(carry == 0, CCERR_INTERNAL);
+                    ccrns_int lazy_128[2] = { ccpolyzp_po2cyc_units_to_rns_int(lazy_128_rns),
+                                              ccpolyzp_po2cyc_units_to_rns_int(&lazy_128_rns[CCPOLYZP_PO2CYC_NUNITS_PER_COEFF]) };
+                    overflow |= ccpolyzp_po2cyc_scalar_mul_add(
+                        lazy_128, ccpolyzp_po2cyc_units_to_rns_int(gk_data), ccpolyzp_po2cyc_units_to_rns_int(buffer_data));
+                    ccpolyzp_po2cyc_rns_int_to_units(lazy_128_rns, lazy_128[0]);
+                    ccpolyzp_po2cyc_rns_int_to_units(&lazy_128_rns[CCPOLYZP_PO2CYC_NUNITS_PER_COEFF], lazy_128[1]);
                 }
             }
+            cc_require_action(!overflow, errOut, rv = CCERR_INTERNAL);
         }
         // Reduce the 128-bit product mod q_ks
         for (uint32_t k = 0; k < ctext_npolys; ++k) {
@@ -0,0 +1,75 @@
+/* Copyright (c) (2023) Apple Inc. All rights reserved.
+ *
+ * corecrypto is licensed under Apple Inc.’s Internal Use License Agreement (which
+ * is contained in the License.txt file distributed with corecrypto) and only to
+ * people who accept that license. IMPORTANT:  Any license rights granted to you by
+ * Apple Inc. (if any) are limited to internal use within your organization only on
+ * devices and computers you own or control, for the sole purpose of verifying the
+ * security characteristics and correct functioning of the Apple Software.  You may
+ * not, directly or indirectly, redistribute the Apple Software or any portions thereof.
+ */
+
+#ifndef _CORECRYPTO_CCCHACHA20POLY1305_INTEL_H_
+#define _CORECRYPTO_CCCHACHA20POLY1305_INTEL_H_
+
+#include "cc_internal.h"
+#include "cc_runtime_config.h"
+#include <corecrypto/ccchacha20poly1305.h>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) && !CC_KERNEL
+#define CCCHACHA20POLY1305_INTEL 1
+#else
+#define CCCHACHA20POLY1305_INTEL 0
+#endif
+
+#if CCCHACHA20POLY1305_INTEL
+
+/*
+ Multi-block ChaCha20 and Poly1305 kernels. Every lane of a vector register
+ holds the same word of a different block, so that no shuffling is needed
+ between rounds. Callers must check CC_HAS_AVX2() or CC_HAS_AVX512F() first.
+ */
+
+/*! @function ccchacha20_xor_avx2
+ @abstract Encrypts as many blocks as possible, 8 or 4 blocks at a time.
+
+ @param state   ChaCha20 state, the block counter is advanced.
+ @param nblocks Number of full 64-byte blocks in `in`.
+ @param out     Output.
+ @param in      Input.
+
+ @return The number of blocks processed, nblocks rounded down to a multiple of 4.
+ */
+CC_NONNULL_ALL CC_WARN_RESULT
+size_t ccchacha20_xor_avx2(uint32_t state[16], size_t nblocks, uint8_t *out, const uint8_t *in);
+
+/*! @function ccchacha20_xor_avx512
+ @abstract Encrypts as many blocks as possible, 16 blocks at a time.
+
+ @param state   ChaCha20 state, the block counter is advanced.
+ @param nblocks Number of full 64-byte blocks in `in`.
+ @param out     Output.
+ @param in      Input.
+
+ @return The number of blocks processed, nblocks rounded down to a multiple of 16.
+ */
+CC_NONNULL_ALL CC_WARN_RESULT
+size_t ccchacha20_xor_avx512(uint32_t state[16], size_t nblocks, uint8_t *out, const uint8_t *in);
+
+/*! @function ccpoly1305_update_avx2
+ @abstract Absorbs as many full blocks as possible into four interleaved
+           Poly1305 accumulators, multiplying by r^4 per step. The
+           accumulators are combined back into ctx at the end.
+
+ @param ctx     Poly1305 context.
+ @param nblocks Number of full 16-byte blocks in `in`.
+ @param in      Input.
+
+ @return The number of blocks processed, nblocks rounded down to a multiple of 4.
+ */
+CC_NONNULL_ALL CC_WARN_RESULT
+size_t ccpoly1305_update_avx2(ccpoly1305_ctx *ctx, size_t nblocks, const uint8_t *in);
+
+#endif // CCCHACHA20POLY1305_INTEL
+
+#endif /* _CORECRYPTO_CCCHACHA20POLY1305_INTEL_H_ */
@@ -18,6 +18,7 @@ entryPoint(ccchacha_test,"ccchacha test")
 #else
 #include <corecrypto/ccchacha20poly1305.h>
 #include <corecrypto/ccchacha20poly1305_priv.h>
+#include <corecrypto/ccrng.h>
 #include "cc_priv.h"
 
 static int verbose = 0;
@@ -296,14 +297,83 @@ static int test_chacha20poly1305_counter_wrap(void)
     return 1;
 }
 
+static const size_t chacha20poly1305_long_nbytes[] = { 0, 15, 64, 255, 256, 511, 1023, 1024, 1025, 2047, 4160, 9001 };
+
+// Compare the multi-block paths against processing one block at a time.
+static void test_chacha20poly1305_long(void)
+{
+    const struct ccchacha20poly1305_info *info = ccchacha20poly1305_info();
+    uint8_t key[CCCHACHA20POLY1305_KEY_NBYTES], nonce[CCCHACHA20POLY1305_NONCE_NBYTES], aad[17];
+    uint8_t tag[CCPOLY1305_TAG_NBYTES], tag_ref[CCPOLY1305_TAG_NBYTES];
+    ccchacha20poly1305_ctx ctx;
+    ccchacha20_ctx chacha_ctx;
+    ccpoly1305_ctx poly_ctx;
+
+    for (size_t i = 0; i < CC_ARRAY_LEN(chacha20poly1305_long_nbytes); i++) {
+        size_t nbytes = chacha20poly1305_long_nbytes[i];
+        uint8_t *pt = malloc(nbytes + 1);
+        uint8_t *ct = malloc(nbytes + 1);
+        uint8_t *ct_ref = malloc(nbytes + 1);
+
+        ccrng_generate(global_test_rng, sizeof(key), key);
+        ccrng_generate(global_test_rng, sizeof(nonce), nonce);
+        ccrng_generate(global_test_rng, sizeof(aad), aad);
+        ccrng_generate(global_test_rng, nbytes + 1, pt);
+
+        // ChaCha20
+        ccchacha20(key, nonce, 0xfffffff0, nbytes, pt, ct);
+
+        ccchacha20_init(&chacha_ctx, key);
+        ccchacha20_setnonce(&chacha_ctx, nonce);
+        ccchacha20_setcounter(&chacha_ctx, 0xfffffff0);
+        for (size_t j = 0; j < nbytes; j += CCCHACHA20_BLOCK_NBYTES) {
+            ccchacha20_update(&chacha_ctx, CC_MIN(nbytes - j, CCCHACHA20_BLOCK_NBYTES), pt + j, ct_ref + j);
+        }
+        ccchacha20_final(&chacha_ctx);
+        ok_memcmp(ct, ct_ref, nbytes, "Check chacha20 multi-block, %zu bytes", nbytes);
+
+        // Poly1305
+        ccpoly1305(key, nbytes, pt, tag);
+
+        ccpoly1305_init(&poly_ctx, key);
+        for (size_t j = 0; j < nbytes; j += 16) {
+            ccpoly1305_update(&poly_ctx, CC_MIN(nbytes - j, 16), pt + j);
+        }
+        ccpoly1305_final(&poly_ctx, tag_ref);
+        ok_memcmp(tag, tag_ref, sizeof(tag), "Check poly1305 multi-block, %zu bytes", nbytes);
+
+        // ChaCha20-Poly1305
+        ccchacha20poly1305_encrypt_oneshot(info, key, nonce, sizeof(aad), aad, nbytes, pt, ct, tag);
+
+        ccchacha20poly1305_init(info, &ctx, key);
+        ccchacha20poly1305_setnonce(info, &ctx, nonce);
+        ccchacha20poly1305_aad(info, &ctx, sizeof(aad), aad);
+        for (size_t j = 0; j < nbytes; j += CCCHACHA20_BLOCK_NBYTES) {
+            ccchacha20poly1305_encrypt(info, &ctx, CC_MIN(nbytes - j, CCCHACHA20_BLOCK_NBYTES), pt + j, ct_ref + j);
+        }
+        ccchacha20poly1305_finalize(info, &ctx, tag_ref);
+        ok_memcmp(ct, ct_ref, nbytes, "Check chacha20-poly1305 one-shot ciphertext, %zu bytes", nbytes);
+        ok_memcmp(tag, tag_ref, sizeof(tag), "Check chacha20-poly1305 one-shot tag, %zu bytes", nbytes);
+
+        is(ccchacha20poly1305_decrypt_oneshot(info, key, nonce, sizeof(aad), aad, nbytes, ct, ct_ref, tag), 0,
+           "Check chacha20-poly1305 one-shot decrypt, %zu bytes", nbytes);
+        ok_memcmp(ct_ref, pt, nbytes, "Check chacha20-poly1305 one-shot plaintext, %zu bytes", nbytes);
+
+        free(pt);
+        free(ct);
+        free(ct_ref);
+    }
+}
+
 int ccchacha_tests(TM_UNUSED int argc, TM_UNUSED char *const *argv) {
-	plan_tests(2197);
+	plan_tests(2197 + CC_ARRAY_LEN(chacha20poly1305_long_nbytes) * 6);
 
 	if(verbose) diag("Starting chacha tests\n");
 	test_chacha20();
 	test_poly1305();
 	test_chacha20_poly1305();
     test_chacha20poly1305_counter_wrap();
+    test_chacha20poly1305_long();
 	return 0;
 }
 
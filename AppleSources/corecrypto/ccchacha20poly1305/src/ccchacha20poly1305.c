@@ -15,6 +15,7 @@
 #include <corecrypto/cc_priv.h>
 #include <corecrypto/ccchacha20poly1305.h>
 #include <corecrypto/ccchacha20poly1305_priv.h>
+#include "ccchacha20poly1305_intel.h"
 
 // COMPILER_CLANG
 
@@ -452,6 +453,24 @@ static void	_ccchacha20_xor(ccchacha20_ctx *ctx, size_t nbytes, uint8_t *out, co
 	const unsigned *np = (const unsigned*) (const unsigned char *) &ctx->state[13];
 #endif
 	uint32x4_t s0, s1, s2, s3;
+
+#if CCCHACHA20POLY1305_INTEL
+	// Wide kernels first, the loops below take care of the remaining blocks.
+	size_t nblocks = nbytes / CCCHACHA20_BLOCK_NBYTES, nprocessed = 0;
+
+	if (nblocks >= 16 && CC_HAS_AVX512F()) {
+		nprocessed = ccchacha20_xor_avx512(ctx->state, nblocks, out, in);
+	}
+	if (nblocks - nprocessed >= 4 && CC_HAS_AVX2()) {
+		size_t off = nprocessed * CCCHACHA20_BLOCK_NBYTES;
+		nprocessed += ccchacha20_xor_avx2(ctx->state, nblocks - nprocessed, out + off, in + off);
+	}
+
+	nbytes -= nprocessed * CCCHACHA20_BLOCK_NBYTES;
+	op += nprocessed * 16;
+	ip += nprocessed * 16;
+#endif
+
 	kp = &ctx->state[4];
 	s0 = LOAD(kChaCha20Constants);
 	s1 = LOAD(&((const uint32x4_t*)kp)[0]);
@@ -603,6 +622,9 @@ static void	_ccchacha20_xor(ccchacha20_ctx *ctx, size_t nbytes, uint8_t *out, co
 
 static void _ccpoly1305_update(ccpoly1305_ctx *ctx, size_t nbytes, const uint8_t *in);
 
+// Below this, computing r^2..r^4 and combining the lanes costs more than it saves.
+#define CCPOLY1305_AVX2_MIN_NBYTES 128
+
 int ccpoly1305_init(ccpoly1305_ctx *ctx, const uint8_t *key)
 {
     CC_ENSURE_DIT_ENABLED
@@ -733,6 +755,14 @@ static void _ccpoly1305_update(ccpoly1305_ctx *ctx, size_t nbytes, const uint8_t
 	size_t j;
 	uint8_t mp[16];
 
+#if CCCHACHA20POLY1305_INTEL
+	if (nbytes >= CCPOLY1305_AVX2_MIN_NBYTES && CC_HAS_AVX2()) {
+		size_t n = ccpoly1305_update_avx2(ctx, nbytes / 16, in) * 16;
+		in += n;
+		nbytes -= n;
+	}
+#endif
+
 	if (nbytes < 16)
 		goto poly1305_donna_atmost15bytes;
 
@@ -1005,6 +1035,11 @@ err:
     return 1;
 }
 
+// The one-shot functions alternate between ChaCha20 and Poly1305 on chunks
+// small enough to stay in L1, instead of making two passes over the whole
+// message. Chunks are a multiple of the block sizes of both.
+#define CCCHACHA20POLY1305_ONESHOT_CHUNK_NBYTES 1024
+
 int ccchacha20poly1305_encrypt_oneshot(const struct ccchacha20poly1305_info *info, const uint8_t *key, const uint8_t *nonce, size_t aad_nbytes, const void *aad, size_t ptext_nbytes, const void *ptext, void *ctext, uint8_t *tag)
 {
     CC_ENSURE_DIT_ENABLED
@@ -1014,7 +1049,17 @@ int ccchacha20poly1305_encrypt_oneshot(const struct ccchacha20poly1305_info *inf
 	ccchacha20poly1305_init(info, &ctx, key);
     ccchacha20poly1305_setnonce(info, &ctx, nonce);
     ccchacha20poly1305_aad(info, &ctx, aad_nbytes, aad);
-    ccchacha20poly1305_encrypt(info, &ctx, ptext_nbytes, ptext, ctext);
+
+    const uint8_t *in = ptext;
+    uint8_t *out = ctext;
+    while (ptext_nbytes > 0) {
+        size_t n = CC_MIN(ptext_nbytes, CCCHACHA20POLY1305_ONESHOT_CHUNK_NBYTES);
+        ccchacha20poly1305_encrypt(info, &ctx, n, in, out);
+        ptext_nbytes -= n;
+        in += n;
+        out += n;
+    }
+
     ccchacha20poly1305_finalize(info, &ctx, tag);
     ccchacha20_final(&ctx.chacha20_ctx);
     return 0;
@@ -1029,7 +1074,17 @@ int ccchacha20poly1305_decrypt_oneshot(const struct ccchacha20poly1305_info *inf
     ccchacha20poly1305_init(info, &ctx, key);
     ccchacha20poly1305_setnonce(info, &ctx, nonce);
     ccchacha20poly1305_aad(info, &ctx, aad_nbytes, aad);
-    ccchacha20poly1305_decrypt(info, &ctx, ctext_nbytes, ctext, ptext);
+
+    const uint8_t *in = ctext;
+    uint8_t *out = ptext;
+    while (ctext_nbytes > 0) {
+        size_t n = CC_MIN(ctext_nbytes, CCCHACHA20POLY1305_ONESHOT_CHUNK_NBYTES);
+        ccchacha20poly1305_decrypt(info, &ctx, n, in, out);
+        ctext_nbytes -= n;
+        in += n;
+        out += n;
+    }
+
     int rv = ccchacha20poly1305_verify(info, &ctx, tag);
     ccchacha20_final(&ctx.chacha20_ctx);
     return rv;
@@ -0,0 +1,379 @@
+/* Copyright (c) (2023) Apple Inc. All rights reserved.
+ *
+ * corecrypto is licensed under Apple Inc.’s Internal Use License Agreement (which
+ * is contained in the License.txt file distributed with corecrypto) and only to
+ * people who accept that license. IMPORTANT:  Any license rights granted to you by
+ * Apple Inc. (if any) are limited to internal use within your organization only on
+ * devices and computers you own or control, for the sole purpose of verifying the
+ * security characteristics and correct functioning of the Apple Software.  You may
+ * not, directly or indirectly, redistribute the Apple Software or any portions thereof.
+ */
+
+#include "cc_internal.h"
+#include "ccchacha20poly1305_intel.h"
+
+#if CCCHACHA20POLY1305_INTEL
+
+#include <immintrin.h>
+
+#define CCCHACHA20POLY1305_AVX2_TARGET __attribute__((target("avx2")))
+
+//===========================================================================================================================
+//	ChaCha20, 8 and 4 blocks at a time
+//===========================================================================================================================
+
+#define CCCHACHA20_AVX2_ROTL(x, n) _mm256_or_si256(_mm256_slli_epi32(x, n), _mm256_srli_epi32(x, 32 - (n)))
+
+#define CCCHACHA20_AVX2_QUARTERROUND(a, b, c, d)                                              \
+    a = _mm256_add_epi32(a, b); d = _mm256_shuffle_epi8(_mm256_xor_si256(d, a), rot16);      \
+    c = _mm256_add_epi32(c, d); b = _mm256_xor_si256(b, c); b = CCCHACHA20_AVX2_ROTL(b, 12); \
+    a = _mm256_add_epi32(a, b); d = _mm256_shuffle_epi8(_mm256_xor_si256(d, a), rot8);       \
+    c = _mm256_add_epi32(c, d); b = _mm256_xor_si256(b, c); b = CCCHACHA20_AVX2_ROTL(b, 7);
+
+#define CCCHACHA20_SSE_ROTL(x, n) _mm_or_si128(_mm_slli_epi32(x, n), _mm_srli_epi32(x, 32 - (n)))
+
+#define CCCHACHA20_SSE_QUARTERROUND(a, b, c, d)                                         \
+    a = _mm_add_epi32(a, b); d = _mm_shuffle_epi8(_mm_xor_si128(d, a), rot16);         \
+    c = _mm_add_epi32(c, d); b = _mm_xor_si128(b, c); b = CCCHACHA20_SSE_ROTL(b, 12); \
+    a = _mm_add_epi32(a, b); d = _mm_shuffle_epi8(_mm_xor_si128(d, a), rot8);          \
+    c = _mm_add_epi32(c, d); b = _mm_xor_si128(b, c); b = CCCHACHA20_SSE_ROTL(b, 7);
+
+#define CCCHACHA20_DOUBLEROUND(QR, x)   \
+    QR(x[0], x[4], x[8], x[12])         \
+    QR(x[1], x[5], x[9], x[13])         \
+    QR(x[2], x[6], x[10], x[14])        \
+    QR(x[3], x[7], x[11], x[15])        \
+    QR(x[0], x[5], x[10], x[15])        \
+    QR(x[1], x[6], x[11], x[12])        \
+    QR(x[2], x[7], x[8], x[13])         \
+    QR(x[3], x[4], x[9], x[14])
+
+/*! @function ccchacha20_avx2_transpose
+ @abstract Transposes an 8x8 matrix of 32-bit words, turning words 0..7 of
+           eight blocks into eight consecutive 32-byte block halves.
+
+ @param x Rows, transposed in place.
+ */
+CCCHACHA20POLY1305_AVX2_TARGET
+static inline void ccchacha20_avx2_transpose(__m256i x[8])
+{
+    __m256i t0 = _mm256_unpacklo_epi32(x[0], x[1]);
+    __m256i t1 = _mm256_unpackhi_epi32(x[0], x[1]);
+    __m256i t2 = _mm256_unpacklo_epi32(x[2], x[3]);
+    __m256i t3 = _mm256_unpackhi_epi32(x[2], x[3]);
+    __m256i t4 = _mm256_unpacklo_epi32(x[4], x[5]);
+    __m256i t5 = _mm256_unpackhi_epi32(x[4], x[5]);
+    __m256i t6 = _mm256_unpacklo_epi32(x[6], x[7]);
+    __m256i t7 = _mm256_unpackhi_epi32(x[6], x[7]);
+
+    __m256i u0 = _mm256_unpacklo_epi64(t0, t2);
+    __m256i u1 = _mm256_unpackhi_epi64(t0, t2);
+    __m256i u2 = _mm256_unpacklo_epi64(t1, t3);
+    __m256i u3 = _mm256_unpackhi_epi64(t1, t3);
+    __m256i u4 = _mm256_unpacklo_epi64(t4, t6);
+    __m256i u5 = _mm256_unpackhi_epi64(t4, t6);
+    __m256i u6 = _mm256_unpacklo_epi64(t5, t7);
+    __m256i u7 = _mm256_unpackhi_epi64(t5, t7);
+
+    x[0] = _mm256_permute2x128_si256(u0, u4, 0x20);
+    x[1] = _mm256_permute2x128_si256(u1, u5, 0x20);
+    x[2] = _mm256_permute2x128_si256(u2, u6, 0x20);
+    x[3] = _mm256_permute2x128_si256(u3, u7, 0x20);
+    x[4] = _mm256_permute2x128_si256(u0, u4, 0x31);
+    x[5] = _mm256_permute2x128_si256(u1, u5, 0x31);
+    x[6] = _mm256_permute2x128_si256(u2, u6, 0x31);
+    x[7] = _mm256_permute2x128_si256(u3, u7, 0x31);
+}
+
+CCCHACHA20POLY1305_AVX2_TARGET
+static void ccchacha20_avx2_8x(uint32_t state[16], uint8_t *out, const uint8_t *in)
+{
+    const __m256i rot16 = _mm256_setr_epi8(2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13,
+                                           2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13);
+    const __m256i rot8 = _mm256_setr_epi8(3, 0, 1, 2, 7, 4, 5, 6, 11, 8, 9, 10, 15, 12, 13, 14,
+                                          3, 0, 1, 2, 7, 4, 5, 6, 11, 8, 9, 10, 15, 12, 13, 14);
+    __m256i x[16], ctr;
+
+    for (unsigned i = 0; i < 16; i++) {
+        x[i] = _mm256_set1_epi32((int)state[i]);
+    }
+
+    ctr = _mm256_add_epi32(x[12], _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+    x[12] = ctr;
+
+    for (unsigned i = 0; i < 10; i++) {
+        CCCHACHA20_DOUBLEROUND(CCCHACHA20_AVX2_QUARTERROUND, x)
+    }
+
+    for (unsigned i = 0; i < 16; i++) {
+        x[i] = _mm256_add_epi32(x[i], i == 12 ? ctr : _mm256_set1_epi32((int)state[i]));
+    }
+
+    ccchacha20_avx2_transpose(&x[0]);
+    ccchacha20_avx2_transpose(&x[8]);
+
+    for (unsigned i = 0; i < 8; i++) {
+        __m256i lo = _mm256_loadu_si256((const __m256i *)(in + 64 * i));
+        __m256i hi = _mm256_loadu_si256((const __m256i *)(in + 64 * i + 32));
+        _mm256_storeu_si256((__m256i *)(out + 64 * i), _mm256_xor_si256(lo, x[i]));
+        _mm256_storeu_si256((__m256i *)(out + 64 * i + 32), _mm256_xor_si256(hi, x[8 + i]));
+    }
+
+    state[12] += 8;
+}
+
+CCCHACHA20POLY1305_AVX2_TARGET
+static void ccchacha20_avx2_4x(uint32_t state[16], uint8_t *out, const uint8_t *in)
+{
+    const __m128i rot16 = _mm_setr_epi8(2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13);
+    const __m128i rot8 = _mm_setr_epi8(3, 0, 1, 2, 7, 4, 5, 6, 11, 8, 9, 10, 15, 12, 13, 14);
+    __m128i x[16], ctr;
+
+    for (unsigned i = 0; i < 16; i++) {
+        x[i] = _mm_set1_epi32((int)state[i]);
+    }
+
+    ctr = _mm_add_epi32(x[12], _mm_setr_epi32(0, 1, 2, 3));
+    x[12] = ctr;
+
+    for (unsigned i = 0; i < 10; i++) {
+        CCCHACHA20_DOUBLEROUND(CCCHACHA20_SSE_QUARTERROUND, x)
+    }
+
+    for (unsigned i = 0; i < 16; i++) {
+        x[i] = _mm_add_epi32(x[i], i == 12 ? ctr : _mm_set1_epi32((int)state[i]));
+    }
+
+    // Transpose every group of four words, one 16-byte quarter of each block.
+    for (unsigned g = 0; g < 16; g += 4) {
+        __m128i t0 = _mm_unpacklo_epi32(x[g + 0], x[g + 1]);
+        __m128i t1 = _mm_unpacklo_epi32(x[g + 2], x[g + 3]);
+        __m128i t2 = _mm_unpackhi_epi32(x[g + 0], x[g + 1]);
+        __m128i t3 = _mm_unpackhi_epi32(x[g + 2], x[g + 3]);
+
+        __m128i b[4] = {
+            _mm_unpacklo_epi64(t0, t1),
+            _mm_unpackhi_epi64(t0, t1),
+            _mm_unpacklo_epi64(t2, t3),
+            _mm_unpackhi_epi64(t2, t3),
+        };
+
+        for (unsigned i = 0; i < 4; i++) {
+            __m128i m = _mm_loadu_si128((const __m128i *)(in + 64 * i + 4 * g));
+            _mm_storeu_si128((__m128i *)(out + 64 * i + 4 * g), _mm_xor_si128(m, b[i]));
+        }
+    }
+
+    state[12] += 4;
+}
+
+size_t ccchacha20_xor_avx2(uint32_t state[16], size_t nblocks, uint8_t *out, const uint8_t *in)
+{
+    size_t n = 0;
+
+    for (; nblocks - n >= 8; n += 8) {
+        ccchacha20_avx2_8x(state, out + 64 * n, in + 64 * n);
+    }
+
+    if (nblocks - n >= 4) {
+        ccchacha20_avx2_4x(state, out + 64 * n, in + 64 * n);
+        n += 4;
+    }
+
+    return n;
+}
+
+//===========================================================================================================================
+//	Poly1305, four blocks at a time
+//
+//	Lane j accumulates blocks j, j+4, j+8, ... multiplied by r^4 at each step.
+//	A final multiplication by (r^4, r^3, r^2, r) and a horizontal sum yield the
+//	same value as absorbing all blocks one after the other. Limbs are 26 bits
+//	wide and stored in 64-bit lanes, so that partial products never overflow.
+//===========================================================================================================================
+
+#define CCPOLY1305_MASK26 0x3ffffff
+
+/*! @function ccpoly1305_mul_r
+ @abstract Computes h = h * r mod 2^130 - 5, in radix 2^26.
+
+ @param h Multiplicand, limbs < 2^27. Replaced by the partially reduced
+          product, limbs < 2^26 + 2^10.
+ @param r Multiplier, limbs < 2^26 + 2^10.
+ */
+static void ccpoly1305_mul_r(uint32_t h[5], const uint32_t r[5])
+{
+    uint64_t s1 = r[1] * 5ULL, s2 = r[2] * 5ULL, s3 = r[3] * 5ULL, s4 = r[4] * 5ULL;
+    uint64_t t[5], c;
+
+    t[0] = h[0] * (uint64_t)r[0] + h[1] * s4 + h[2] * s3 + h[3] * s2 + h[4] * s1;
+    t[1] = h[0] * (uint64_t)r[1] + h[1] * (uint64_t)r[0] + h[2] * s4 + h[3] * s3 + h[4] * s2;
+    t[2] = h[0] * (uint64_t)r[2] + h[1] * (uint64_t)r[1] + h[2] * (uint64_t)r[0] + h[3] * s4 + h[4] * s3;
+    t[3] = h[0] * (uint64_t)r[3] + h[1] * (uint64_t)r[2] + h[2] * (uint64_t)r[1] + h[3] * (uint64_t)r[0] + h[4] * s4;
+    t[4] = h[0] * (uint64_t)r[4] + h[1] * (uint64_t)r[3] + h[2] * (uint64_t)r[2] + h[3] * (uint64_t)r[1] + h[4] * (uint64_t)r[0];
+
+               c = t[0] >> 26; t[0] &= CCPOLY1305_MASK26;
+    t[1] += c; c = t[1] >> 26; t[1] &= CCPOLY1305_MASK26;
+    t[2] += c; c = t[2] >> 26; t[2] &= CCPOLY1305_MASK26;
+    t[3] += c; c = t[3] >> 26; t[3] &= CCPOLY1305_MASK26;
+    t[4] += c; c = t[4] >> 26; t[4] &= CCPOLY1305_MASK26;
+    t[0] += c * 5; c = t[0] >> 26; t[0] &= CCPOLY1305_MASK26;
+    t[1] += c;
+
+    for (unsigned i = 0; i < 5; i++) {
+        h[i] = (uint32_t)t[i];
+    }
+}
+
+/*! @function ccpoly1305_avx2_load
+ @abstract Loads four consecutive 16-byte blocks, one per lane, split into
+           26-bit limbs and with the 2^128 bit set.
+
+ @param m  Limbs.
+ @param in Input.
+ */
+CCCHACHA20POLY1305_AVX2_TARGET
+static inline void ccpoly1305_avx2_load(__m256i m[5], const uint8_t *in)
+{
+    const __m256i mask = _mm256_set1_epi64x(CCPOLY1305_MASK26);
+
+    __m256i a = _mm256_loadu_si256((const __m256i *)in);
+    __m256i b = _mm256_loadu_si256((const __m256i *)(in + 32));
+
+    // unpack{lo,hi} yield blocks in order 0, 2, 1, 3.
+    __m256i lo = _mm256_permute4x64_epi64(_mm256_unpacklo_epi64(a, b), _MM_SHUFFLE(3, 1, 2, 0));
+    __m256i hi = _mm256_permute4x64_epi64(_mm256_unpackhi_epi64(a, b), _MM_SHUFFLE(3, 1, 2, 0));
+
+    m[0] = _mm256_and_si256(lo, mask);
+    m[1] = _mm256_and_si256(_mm256_srli_epi64(lo, 26), mask);
+    m[2] = _mm256_and_si256(_mm256_or_si256(_mm256_srli_epi64(lo, 52), _mm256_slli_epi64(hi, 12)), mask);
+    m[3] = _mm256_and_si256(_mm256_srli_epi64(hi, 14), mask);
+    m[4] = _mm256_or_si256(_mm256_srli_epi64(hi, 40), _mm256_set1_epi64x(1 << 24));
+}
+
+/*! @function ccpoly1305_avx2_mul
+ @abstract Computes the unreduced product t = h * r, lane by lane.
+
+ @param t Product, limbs < 2^59.
+ @param h Multiplicand, limbs < 2^27.
+ @param r Multiplier, limbs < 2^26 + 2^10.
+ @param s 5 * r.
+ */
+CCCHACHA20POLY1305_AVX2_TARGET
+static inline void ccpoly1305_avx2_mul(__m256i t[5], const __m256i h[5], const __m256i r[5], const __m256i s[5])
+{
+#define MUL(a, b) _mm256_mul_epu32(a, b)
+#define ADD(a, b) _mm256_add_epi64(a, b)
+    t[0] = ADD(ADD(ADD(ADD(MUL(h[0], r[0]), MUL(h[1], s[4])), MUL(h[2], s[3])), MUL(h[3], s[2])), MUL(h[4], s[1]));
+    t[1] = ADD(ADD(ADD(ADD(MUL(h[0], r[1]), MUL(h[1], r[0])), MUL(h[2], s[4])), MUL(h[3], s[3])), MUL(h[4], s[2]));
+    t[2] = ADD(ADD(ADD(ADD(MUL(h[0], r[2]), MUL(h[1], r[1])), MUL(h[2], r[0])), MUL(h[3], s[4])), MUL(h[4], s[3]));
+    t[3] = ADD(ADD(ADD(ADD(MUL(h[0], r[3]), MUL(h[1], r[2])), MUL(h[2], r[1])), MUL(h[3], r[0])), MUL(h[4], s[4]));
+    t[4] = ADD(ADD(ADD(ADD(MUL(h[0], r[4]), MUL(h[1], r[3])), MUL(h[2], r[2])), MUL(h[3], r[1])), MUL(h[4], r[0]));
+#undef MUL
+#undef ADD
+}
+
+/*! @function ccpoly1305_avx2_carry
+ @abstract Partially reduces a product, lane by lane.
+
+ @param h Result, limbs < 2^26 + 2^10.
+ @param t Product, limbs < 2^59.
+ */
+CCCHACHA20POLY1305_AVX2_TARGET
+static inline void ccpoly1305_avx2_carry(__m256i h[5], __m256i t[5])
+{
+    const __m256i mask = _mm256_set1_epi64x(CCPOLY1305_MASK26);
+    __m256i c;
+
+    c = _mm256_srli_epi64(t[0], 26); t[0] = _mm256_and_si256(t[0], mask);
+    t[1] = _mm256_add_epi64(t[1], c); c = _mm256_srli_epi64(t[1], 26); h[1] = _mm256_and_si256(t[1], mask);
+    t[2] = _mm256_add_epi64(t[2], c); c = _mm256_srli_epi64(t[2], 26); h[2] = _mm256_and_si256(t[2], mask);
+    t[3] = _mm256_add_epi64(t[3], c); c = _mm256_srli_epi64(t[3], 26); h[3] = _mm256_and_si256(t[3], mask);
+    t[4] = _mm256_add_epi64(t[4], c); c = _mm256_srli_epi64(t[4], 26); h[4] = _mm256_and_si256(t[4], mask);
+
+    // t[0] + 5c, with c < 2^33.
+    t[0] = _mm256_add_epi64(t[0], _mm256_add_epi64(c, _mm256_slli_epi64(c, 2)));
+    c = _mm256_srli_epi64(t[0], 26); h[0] = _mm256_and_si256(t[0], mask);
+    h[1] = _mm256_add_epi64(h[1], c);
+}
+
+/*! @function ccpoly1305_avx2_broadcast
+ @abstract Loads multiplier pj into lane j, and the multiples by 5 used for
+           the reduction mod 2^130 - 5.
+ */
+CCCHACHA20POLY1305_AVX2_TARGET
+static inline void ccpoly1305_avx2_broadcast(__m256i r[5], __m256i s[5], const uint32_t p0[5], const uint32_t p1[5], const uint32_t p2[5], const uint32_t p3[5])
+{
+    for (unsigned i = 0; i < 5; i++) {
+        r[i] = _mm256_setr_epi64x(p0[i], p1[i], p2[i], p3[i]);
+        s[i] = _mm256_add_epi64(r[i], _mm256_slli_epi64(r[i], 2));
+    }
+}
+
+CCCHACHA20POLY1305_AVX2_TARGET
+size_t ccpoly1305_update_avx2(ccpoly1305_ctx *ctx, size_t nblocks, const uint8_t *in)
+{
+    uint32_t r1[5] = { ctx->r0, ctx->r1, ctx->r2, ctx->r3, ctx->r4 };
+    uint32_t r2[5], r3[5], r4[5];
+    __m256i h[5], m[5], t[5], r[5], s[5];
+    uint64_t sum[5], c;
+
+    nblocks &= ~(size_t)3;
+    if (nblocks == 0) {
+        return 0;
+    }
+
+    cc_memcpy(r2, r1, sizeof(r2));
+    ccpoly1305_mul_r(r2, r1);
+    cc_memcpy(r3, r2, sizeof(r3));
+    ccpoly1305_mul_r(r3, r1);
+    cc_memcpy(r4, r3, sizeof(r4));
+    ccpoly1305_mul_r(r4, r1);
+
+    // Lane 0 continues from the current accumulator.
+    ccpoly1305_avx2_load(h, in);
+    h[0] = _mm256_add_epi64(h[0], _mm256_setr_epi64x(ctx->h0, 0, 0, 0));
+    h[1] = _mm256_add_epi64(h[1], _mm256_setr_epi64x(ctx->h1, 0, 0, 0));
+    h[2] = _mm256_add_epi64(h[2], _mm256_setr_epi64x(ctx->h2, 0, 0, 0));
+    h[3] = _mm256_add_epi64(h[3], _mm256_setr_epi64x(ctx->h3, 0, 0, 0));
+    h[4] = _mm256_add_epi64(h[4], _mm256_setr_epi64x(ctx->h4, 0, 0, 0));
+
+    ccpoly1305_avx2_broadcast(r, s, r4, r4, r4, r4);
+
+    for (size_t i = 4; i < nblocks; i += 4) {
+        ccpoly1305_avx2_mul(t, h, r, s);
+        ccpoly1305_avx2_carry(h, t);
+        ccpoly1305_avx2_load(m, in + 16 * i);
+
+        for (unsigned k = 0; k < 5; k++) {
+            h[k] = _mm256_add_epi64(h[k], m[k]);
+        }
+    }
+
+    // Multiply lane j by r^(4-j) and sum up all lanes, limbs stay < 2^61.
+    ccpoly1305_avx2_broadcast(r, s, r4, r3, r2, r1);
+    ccpoly1305_avx2_mul(t, h, r, s);
+
+    for (unsigned k = 0; k < 5; k++) {
+        __m128i v = _mm_add_epi64(_mm256_castsi256_si128(t[k]), _mm256_extracti128_si256(t[k], 1));
+        sum[k] = (uint64_t)_mm_cvtsi128_si64(v) + (uint64_t)_mm_extract_epi64(v, 1);
+    }
+
+                  c = sum[0] >> 26; sum[0] &= CCPOLY1305_MASK26;
+    sum[1] += c;  c = sum[1] >> 26; sum[1] &= CCPOLY1305_MASK26;
+    sum[2] += c;  c = sum[2] >> 26; sum[2] &= CCPOLY1305_MASK26;
+    sum[3] += c;  c = sum[3] >> 26; sum[3] &= CCPOLY1305_MASK26;
+    sum[4] += c;  c = sum[4] >> 26; sum[4] &= CCPOLY1305_MASK26;
+    sum[0] += c * 5; c = sum[0] >> 26; sum[0] &= CCPOLY1305_MASK26;
+    sum[1] += c;
+
+    ctx->h0 = (uint32_t)sum[0];
+    ctx->h1 = (uint32_t)sum[1];
+    ctx->h2 = (uint32_t)sum[2];
+    ctx->h3 = (uint32_t)sum[3];
+    ctx->h4 = (uint32_t)sum[4];
+
+    return nblocks;
+}
+
+#endif // CCCHACHA20POLY1305_INTEL
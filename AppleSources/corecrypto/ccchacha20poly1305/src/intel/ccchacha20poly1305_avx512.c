@@ -0,0 +1,113 @@
+/* Copyright (c) (2023) Apple Inc. All rights reserved.
+ *
+ * corecrypto is licensed under Apple Inc.’s Internal Use License Agreement (which
+ * is contained in the License.txt file distributed with corecrypto) and only to
+ * people who accept that license. IMPORTANT:  Any license rights granted to you by
+ * Apple Inc. (if any) are limited to internal use within your organization only on
+ * devices and computers you own or control, for the sole purpose of verifying the
+ * security characteristics and correct functioning of the Apple Software.  You may
+ * not, directly or indirectly, redistribute the Apple Software or any portions thereof.
+ */
+
+#include "cc_internal.h"
+#include "ccchacha20poly1305_intel.h"
+
+#if CCCHACHA20POLY1305_INTEL
+
+#include <immintrin.h>
+
+#define CCCHACHA20POLY1305_AVX512_TARGET __attribute__((target("avx512f")))
+
+#define CCCHACHA20_AVX512_QUARTERROUND(a, b, c, d)                                          \
+    a = _mm512_add_epi32(a, b); d = _mm512_rol_epi32(_mm512_xor_si512(d, a), 16);          \
+    c = _mm512_add_epi32(c, d); b = _mm512_rol_epi32(_mm512_xor_si512(b, c), 12);          \
+    a = _mm512_add_epi32(a, b); d = _mm512_rol_epi32(_mm512_xor_si512(d, a), 8);           \
+    c = _mm512_add_epi32(c, d); b = _mm512_rol_epi32(_mm512_xor_si512(b, c), 7);
+
+/*! @function ccchacha20_avx512_transpose
+ @abstract Transposes a 16x16 matrix of 32-bit words, turning words 0..15 of
+           sixteen blocks into sixteen consecutive 64-byte blocks.
+
+ @param x Rows, transposed in place.
+ */
+CCCHACHA20POLY1305_AVX512_TARGET
+static inline void ccchacha20_avx512_transpose(__m512i x[16])
+{
+    __m512i u[16];
+
+    // Within every 128-bit lane k, u[4g + j] holds word 4g..4g+3 of block 4k + j.
+    for (unsigned g = 0; g < 16; g += 4) {
+        __m512i t0 = _mm512_unpacklo_epi32(x[g + 0], x[g + 1]);
+        __m512i t1 = _mm512_unpackhi_epi32(x[g + 0], x[g + 1]);
+        __m512i t2 = _mm512_unpacklo_epi32(x[g + 2], x[g + 3]);
+        __m512i t3 = _mm512_unpackhi_epi32(x[g + 2], x[g + 3]);
+
+        u[g + 0] = _mm512_unpacklo_epi64(t0, t2);
+        u[g + 1] = _mm512_unpackhi_epi64(t0, t2);
+        u[g + 2] = _mm512_unpacklo_epi64(t1, t3);
+        u[g + 3] = _mm512_unpackhi_epi64(t1, t3);
+    }
+
+    // Transpose the 4x4 matrix of 128-bit lanes, for every j.
+    for (unsigned j = 0; j < 4; j++) {
+        __m512i v0 = _mm512_shuffle_i32x4(u[j], u[4 + j], _MM_SHUFFLE(1, 0, 1, 0));
+        __m512i v1 = _mm512_shuffle_i32x4(u[j], u[4 + j], _MM_SHUFFLE(3, 2, 3, 2));
+        __m512i v2 = _mm512_shuffle_i32x4(u[8 + j], u[12 + j], _MM_SHUFFLE(1, 0, 1, 0));
+        __m512i v3 = _mm512_shuffle_i32x4(u[8 + j], u[12 + j], _MM_SHUFFLE(3, 2, 3, 2));
+
+        x[0 + j] = _mm512_shuffle_i32x4(v0, v2, _MM_SHUFFLE(2, 0, 2, 0));
+        x[4 + j] = _mm512_shuffle_i32x4(v0, v2, _MM_SHUFFLE(3, 1, 3, 1));
+        x[8 + j] = _mm512_shuffle_i32x4(v1, v3, _MM_SHUFFLE(2, 0, 2, 0));
+        x[12 + j] = _mm512_shuffle_i32x4(v1, v3, _MM_SHUFFLE(3, 1, 3, 1));
+    }
+}
+
+CCCHACHA20POLY1305_AVX512_TARGET
+static void ccchacha20_avx512_16x(uint32_t state[16], uint8_t *out, const uint8_t *in)
+{
+    __m512i x[16], ctr;
+
+    for (unsigned i = 0; i < 16; i++) {
+        x[i] = _mm512_set1_epi32((int)state[i]);
+    }
+
+    ctr = _mm512_add_epi32(x[12], _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+    x[12] = ctr;
+
+    for (unsigned i = 0; i < 10; i++) {
+        CCCHACHA20_AVX512_QUARTERROUND(x[0], x[4], x[8], x[12])
+        CCCHACHA20_AVX512_QUARTERROUND(x[1], x[5], x[9], x[13])
+        CCCHACHA20_AVX512_QUARTERROUND(x[2], x[6], x[10], x[14])
+        CCCHACHA20_AVX512_QUARTERROUND(x[3], x[7], x[11], x[15])
+        CCCHACHA20_AVX512_QUARTERROUND(x[0], x[5], x[10], x[15])
+        CCCHACHA20_AVX512_QUARTERROUND(x[1], x[6], x[11], x[12])
+        CCCHACHA20_AVX512_QUARTERROUND(x[2], x[7], x[8], x[13])
+        CCCHACHA20_AVX512_QUARTERROUND(x[3], x[4], x[9], x[14])
+    }
+
+    for (unsigned i = 0; i < 16; i++) {
+        x[i] = _mm512_add_epi32(x[i], i == 12 ? ctr : _mm512_set1_epi32((int)state[i]));
+    }
+
+    ccchacha20_avx512_transpose(x);
+
+    for (unsigned i = 0; i < 16; i++) {
+        __m512i m = _mm512_loadu_si512((const void *)(in + 64 * i));
+        _mm512_storeu_si512((void *)(out + 64 * i), _mm512_xor_si512(m, x[i]));
+    }
+
+    state[12] += 16;
+}
+
+size_t ccchacha20_xor_avx512(uint32_t state[16], size_t nblocks, uint8_t *out, const uint8_t *in)
+{
+    size_t n = 0;
+
+    for (; nblocks - n >= 16; n += 16) {
+        ccchacha20_avx512_16x(state, out + 64 * n, in + 64 * n);
+    }
+
+    return n;
+}
+
+#endif // CCCHACHA20POLY1305_INTEL
@@ -0,0 +1,165 @@
+/* Copyright (c) (2023) Apple Inc. All rights reserved.
+ *
+ * corecrypto is licensed under Apple Inc.’s Internal Use License Agreement (which
+ * is contained in the License.txt file distributed with corecrypto) and only to
+ * people who accept that license. IMPORTANT:  Any license rights granted to you by
+ * Apple Inc. (if any) are limited to internal use within your organization only on
+ * devices and computers you own or control, for the sole purpose of verifying the
+ * security characteristics and correct functioning of the Apple Software.  You may
+ * not, directly or indirectly, redistribute the Apple Software or any portions thereof.
+ */
+
+#ifndef _CORECRYPTO_CCDER_CURSOR_H_
+#define _CORECRYPTO_CCDER_CURSOR_H_
+
+#include <corecrypto/ccder.h>
+
+/*
+ Cursor over DER encoded data.
+
+ The cursor walks TLV headers only: bodies are neither copied nor decoded
+ until the caller asks for them, and skipping an element skips its whole
+ subtree without looking at it. Positions are kept as offsets from the start
+ of the input, so that a cursor can be resumed once more input is available
+ (possibly at a different address, cf. ccder_cursor_feed()).
+
+ Bodies returned by the cursor can be handed to the ccder_blob_decode_
+ functions to decode the few fields the caller needs.
+ */
+
+#define CCDER_CURSOR_MAX_DEPTH 32
+
+typedef enum {
+    CCDER_CURSOR_OK = 0,
+    // No more elements at the current level.
+    CCDER_CURSOR_END,
+    // The input is incomplete, retry after ccder_cursor_feed().
+    CCDER_CURSOR_NEED_MORE,
+    CCDER_CURSOR_ERROR,
+} ccder_cursor_status;
+
+/*! @struct ccder_tlv
+ @abstract Location of a DER element in the input.
+
+ @field tag         Decoded tag.
+ @field offset      Offset of the identifier octets from the start of the input.
+ @field header_size Size of the identifier and length octets.
+ @field body_size   Size of the contents octets.
+ */
+typedef struct ccder_tlv {
+    ccder_tag tag;
+    size_t offset;
+    size_t header_size;
+    size_t body_size;
+} ccder_tlv;
+
+typedef struct ccder_cursor {
+    const uint8_t *cc_sized_by(der_size) der;
+    size_t der_size;
+    bool complete;
+    // Offset of the next element of the current level, when there is no current element.
+    size_t pos;
+    size_t depth;
+    // End offset of each level, SIZE_MAX for the top level of an incomplete input.
+    size_t ends[CCDER_CURSOR_MAX_DEPTH + 1];
+    bool has_current;
+    ccder_tlv current;
+} ccder_cursor;
+
+/*! @function ccder_cursor_init
+ @abstract Start walking the top level elements of `der`.
+
+ @param cursor   Cursor to initialize.
+ @param der_size Number of bytes available.
+ @param der      DER encoded data.
+ @param complete false if more data may follow, the top level then ends with the stream.
+ */
+CC_NONNULL((1))
+void ccder_cursor_init(ccder_cursor *cursor, size_t der_size, const uint8_t *cc_sized_by(der_size) der, bool complete);
+
+/*! @function ccder_cursor_feed
+ @abstract Resume a cursor that returned CCDER_CURSOR_NEED_MORE.
+
+ @discussion `der` must start with the `cursor->der_size` bytes previously
+ given to the cursor, it may be at a different address.
+ */
+CC_NONNULL((1))
+void ccder_cursor_feed(ccder_cursor *cursor, size_t der_size, const uint8_t *cc_sized_by(der_size) der, bool complete);
+
+/*! @function ccder_cursor_next
+ @abstract Move to the next element of the current level, skipping the subtree of the current element.
+
+ @param cursor Cursor.
+ @param tlv    Location of the element, may be NULL.
+
+ @return CCDER_CURSOR_OK if there is a next element; its body does not have
+ to be available yet. The cursor is left unchanged unless CCDER_CURSOR_OK is
+ returned.
+ */
+CC_NONNULL((1)) CC_NODISCARD
+ccder_cursor_status ccder_cursor_next(ccder_cursor *cursor, ccder_tlv *tlv);
+
+/*! @function ccder_cursor_enter
+ @abstract Descend into the current element, which must be constructed.
+
+ @discussion ccder_cursor_next() then returns its first child.
+ */
+CC_NONNULL((1)) CC_NODISCARD
+ccder_cursor_status ccder_cursor_enter(ccder_cursor *cursor);
+
+/*! @function ccder_cursor_leave
+ @abstract Skip the remaining children of the current level and go back to its parent.
+
+ @discussion ccder_cursor_next() then returns the element following the parent.
+ */
+CC_NONNULL((1)) CC_NODISCARD
+ccder_cursor_status ccder_cursor_leave(ccder_cursor *cursor);
+
+/*! @function ccder_cursor_body
+ @abstract Contents octets of the current element.
+
+ @return CCDER_CURSOR_NEED_MORE if the body is not entirely available yet.
+ */
+CC_NONNULL((1, 2)) CC_NODISCARD
+ccder_cursor_status ccder_cursor_body(const ccder_cursor *cursor, ccder_read_blob *body);
+
+/*! @function ccder_cursor_element
+ @abstract Encoding of the current element, header included, e.g. for ccder_blob_decode_uint().
+
+ @return CCDER_CURSOR_NEED_MORE if the element is not entirely available yet.
+ */
+CC_NONNULL((1, 2)) CC_NODISCARD
+ccder_cursor_status ccder_cursor_element(const ccder_cursor *cursor, ccder_read_blob *element);
+
+/*! @struct ccder_index_entry
+ @abstract Element of the index built by ccder_index().
+
+ @field tlv   Location of the element.
+ @field depth Nesting depth, 0 for top level elements.
+ @field next  Index of the entry following the subtree of this element.
+ */
+typedef struct ccder_index_entry {
+    ccder_tlv tlv;
+    size_t depth;
+    size_t next;
+} ccder_index_entry;
+
+/*! @function ccder_index
+ @abstract Locate every element of `der`, in one pass and without copying.
+
+ @discussion Entries are in document order. Constructed elements are followed
+ by their children; the subtree of entries[i] is entries[i + 1 .. entries[i].next).
+
+ @param der_size Size of the input.
+ @param der      DER encoded data.
+ @param nentries In: capacity of `entries`, out: number of elements.
+ @param entries  Index.
+
+ @return CCERR_OK on success, CCERR_BUFFER_TOO_SMALL if there are more than
+ `*nentries` elements and CCERR_PARAMETER if the input is malformed or nested
+ deeper than CCDER_CURSOR_MAX_DEPTH.
+ */
+CC_NONNULL((3, 4)) CC_NODISCARD
+int ccder_index(size_t der_size, const uint8_t *cc_sized_by(der_size) der, size_t *nentries, ccder_index_entry *cc_counted_by(*nentries) entries);
+
+#endif /* _CORECRYPTO_CCDER_CURSOR_H_ */
@@ -14,6 +14,7 @@
 #endif // CCDER_MULTIBYTE_TAGS
 
 #include <corecrypto/ccder.h>
+#include <corecrypto/ccder_cursor.h>
 
 #include "testmore.h"
 #include "testbyteBuffer.h"
@@ -627,6 +628,127 @@ static void testSizeofTag(void)
     }
 }
 
+//============================= ccder_cursor ===================================
+
+// SEQUENCE { INTEGER 5, SEQUENCE { OID 1.2, NULL }, [0] { OCTET STRING "abc" }, BIT STRING }, INTEGER 7
+static const uint8_t cursor_der[] = {
+    0x30, 0x15,
+          0x02, 0x01, 0x05,
+          0x30, 0x05, 0x06, 0x01, 0x2a, 0x05, 0x00,
+          0xa0, 0x05, 0x04, 0x03, 0x61, 0x62, 0x63,
+          0x03, 0x02, 0x00, 0xff,
+    0x02, 0x01, 0x07,
+};
+
+static void testIndex(void)
+{
+    ccder_index_entry entries[16];
+    size_t n = CC_ARRAY_LEN(entries);
+
+    is(ccder_index(sizeof(cursor_der), cursor_der, &n, entries), CCERR_OK, "ccder_index");
+    is(n, (size_t)9, "ccder_index number of elements");
+    is(entries[0].next, (size_t)8, "ccder_index subtree of the top level sequence");
+    is(entries[2].next, (size_t)5, "ccder_index subtree of the inner sequence");
+    is(entries[5].next, (size_t)7, "ccder_index subtree of [0]");
+    is(entries[6].depth, (size_t)2, "ccder_index depth");
+    ok(entries[8].tlv.tag == CCDER_INTEGER && entries[8].tlv.offset == 23 && entries[8].tlv.body_size == 1, "ccder_index last element");
+
+    n = 8;
+    is(ccder_index(sizeof(cursor_der), cursor_der, &n, entries), CCERR_BUFFER_TOO_SMALL, "ccder_index too many elements");
+    n = CC_ARRAY_LEN(entries);
+    is(ccder_index(sizeof(cursor_der) - 1, cursor_der, &n, entries), CCERR_PARAMETER, "ccder_index truncated");
+
+    uint8_t bad[sizeof(cursor_der)];
+    memcpy(bad, cursor_der, sizeof(bad));
+    bad[6] = 0x06; // The inner sequence overflows its parent.
+    n = CC_ARRAY_LEN(entries);
+    is(ccder_index(sizeof(bad), bad, &n, entries), CCERR_PARAMETER, "ccder_index element larger than its parent");
+}
+
+static void testCursor(void)
+{
+    ccder_cursor cursor;
+    ccder_tlv tlv;
+    ccder_read_blob blob;
+    uint64_t v;
+
+    // Top level only, subtrees are skipped.
+    ccder_cursor_init(&cursor, sizeof(cursor_der), cursor_der, true);
+    is(ccder_cursor_next(&cursor, &tlv), CCDER_CURSOR_OK, "ccder_cursor_next sequence");
+    is(ccder_cursor_next(&cursor, &tlv), CCDER_CURSOR_OK, "ccder_cursor_next skip sequence");
+    is(tlv.offset, (size_t)23, "ccder_cursor_next integer offset");
+    is(ccder_cursor_next(&cursor, &tlv), CCDER_CURSOR_END, "ccder_cursor_next end");
+
+    // Lazy field access.
+    ccder_cursor_init(&cursor, sizeof(cursor_der), cursor_der, true);
+    is(ccder_cursor_next(&cursor, NULL), CCDER_CURSOR_OK, "ccder_cursor_next sequence");
+    is(ccder_cursor_enter(&cursor), CCDER_CURSOR_OK, "ccder_cursor_enter");
+    is(ccder_cursor_next(&cursor, NULL), CCDER_CURSOR_OK, "ccder_cursor_next integer");
+    is(ccder_cursor_enter(&cursor), CCDER_CURSOR_ERROR, "ccder_cursor_enter primitive");
+    ok(ccder_cursor_element(&cursor, &blob) == CCDER_CURSOR_OK && ccder_blob_decode_uint64(&blob, &v) && v == 5,
+       "ccder_cursor_element integer");
+    is(ccder_cursor_next(&cursor, NULL), CCDER_CURSOR_OK, "ccder_cursor_next inner sequence");
+    is(ccder_cursor_next(&cursor, &tlv), CCDER_CURSOR_OK, "ccder_cursor_next [0]");
+    is(tlv.tag, CCDER_CONSTRUCTED | CCDER_CONTEXT_SPECIFIC | 0, "ccder_cursor_next [0] tag");
+    is(ccder_cursor_enter(&cursor), CCDER_CURSOR_OK, "ccder_cursor_enter [0]");
+    is(ccder_cursor_next(&cursor, NULL), CCDER_CURSOR_OK, "ccder_cursor_next octet string");
+    ok(ccder_cursor_body(&cursor, &blob) == CCDER_CURSOR_OK && ccder_blob_size(blob) == 3 && memcmp(blob.der, "abc", 3) == 0,
+       "ccder_cursor_body octet string");
+    is(ccder_cursor_leave(&cursor), CCDER_CURSOR_OK, "ccder_cursor_leave [0]");
+    is(ccder_cursor_leave(&cursor), CCDER_CURSOR_OK, "ccder_cursor_leave sequence");
+    is(ccder_cursor_next(&cursor, &tlv), CCDER_CURSOR_OK, "ccder_cursor_next after leave");
+    is(tlv.offset, (size_t)23, "ccder_cursor_next after leave offset");
+    is(ccder_cursor_leave(&cursor), CCDER_CURSOR_ERROR, "ccder_cursor_leave top level");
+}
+
+// Feed the input one byte at a time, from alternating buffers.
+static void testCursorStream(void)
+{
+    uint8_t bufs[2][sizeof(cursor_der)];
+    ccder_cursor cursor;
+    ccder_tlv tlv;
+    ccder_read_blob body;
+    size_t avail = 0, nelements = 0, nneed_more = 0;
+    bool partial_body = false;
+    ccder_cursor_status status;
+
+    ccder_cursor_init(&cursor, 0, bufs[0], false);
+    for (;;) {
+        status = ccder_cursor_next(&cursor, &tlv);
+
+        if (status == CCDER_CURSOR_NEED_MORE && avail < sizeof(cursor_der)) {
+            avail++;
+            memcpy(bufs[avail & 1], cursor_der, avail);
+            ccder_cursor_feed(&cursor, avail, bufs[avail & 1], avail == sizeof(cursor_der));
+            nneed_more++;
+            continue;
+        }
+        if (status == CCDER_CURSOR_END && cursor.depth > 0) {
+            status = ccder_cursor_leave(&cursor);
+            if (status != CCDER_CURSOR_OK) {
+                break;
+            }
+            continue;
+        }
+        if (status != CCDER_CURSOR_OK) {
+            break;
+        }
+
+        if (nelements == 0) {
+            partial_body = ccder_cursor_body(&cursor, &body) == CCDER_CURSOR_NEED_MORE;
+        }
+        nelements++;
+        if ((tlv.tag & CCDER_CONSTRUCTED) && ccder_cursor_enter(&cursor) != CCDER_CURSOR_OK) {
+            break;
+        }
+    }
+
+    is(status, CCDER_CURSOR_END, "ccder_cursor stream end");
+    is(nelements, (size_t)9, "ccder_cursor stream number of elements");
+    ok(partial_body, "ccder_cursor stream body not available yet");
+    ok(nneed_more >= sizeof(cursor_der) - 9, "ccder_cursor stream resumed");
+}
+
 ccder_sig_test_vector sig_test_vectors[] = {
 #include "ccder_signature_strict_vectors.inc"
     {.signature = NULL}
@@ -780,6 +902,9 @@ int ccder_tests(TM_UNUSED int argc, TM_UNUSED char *const *argv)
         {&test_ccder_decode_seqii_strict,
             (1 /* NULL der */) +
             ((ONE_PAST_THE_END(sig_test_vectors) - sig_test_vectors - 1) * 3 /* test vectors */)},
+        {&testIndex, 10},
+        {&testCursor, 20},
+        {&testCursorStream, 4},
         {&testEncodeEckeyRoundtrip,
             (1 * 4 /* vectors without a private key */) +
             (4 * 4 /* vectors with a private key */) +
@@ -0,0 +1,222 @@
+/* Copyright (c) (2023) Apple Inc. All rights reserved.
+ *
+ * corecrypto is licensed under Apple Inc.’s Internal Use License Agreement (which
+ * is contained in the License.txt file distributed with corecrypto) and only to
+ * people who accept that license. IMPORTANT:  Any license rights granted to you by
+ * Apple Inc. (if any) are limited to internal use within your organization only on
+ * devices and computers you own or control, for the sole purpose of verifying the
+ * security characteristics and correct functioning of the Apple Software.  You may
+ * not, directly or indirectly, redistribute the Apple Software or any portions thereof.
+ */
+
+#include "cc_internal.h"
+#include <corecrypto/ccder.h>
+#include <corecrypto/ccder_cursor.h>
+
+void ccder_cursor_init(ccder_cursor *cursor, size_t der_size, const uint8_t *der, bool complete)
+{
+    cc_clear(sizeof(*cursor), cursor);
+    cursor->der = der;
+    cursor->der_size = der_size;
+    cursor->complete = complete;
+    cursor->ends[0] = complete ? der_size : SIZE_MAX;
+}
+
+void ccder_cursor_feed(ccder_cursor *cursor, size_t der_size, const uint8_t *der, bool complete)
+{
+    cc_assert(der_size >= cursor->der_size);
+
+    cursor->der = der;
+    cursor->der_size = der_size;
+    cursor->complete = complete;
+    if (complete) {
+        cursor->ends[0] = der_size;
+    }
+}
+
+static size_t ccder_tlv_end(const ccder_tlv *tlv)
+{
+    return tlv->offset + tlv->header_size + tlv->body_size;
+}
+
+/* Same encodings as ccder_blob_decode_len(), except that the body does not
+ have to be available. */
+static ccder_cursor_status ccder_cursor_decode_len(const uint8_t *der, size_t avail, bool truncated,
+                                                   size_t *len, size_t *len_size)
+{
+    if (avail < 1) {
+        return truncated ? CCDER_CURSOR_NEED_MORE : CCDER_CURSOR_ERROR;
+    }
+
+    size_t first = der[0];
+    if (first < 0x80) {
+        *len = first;
+        *len_size = 1;
+        return CCDER_CURSOR_OK;
+    }
+
+    size_t n = first & 0x7f;
+    if (n < 1 || n > 4) {
+        return CCDER_CURSOR_ERROR;
+    }
+    if (avail < 1 + n) {
+        return truncated ? CCDER_CURSOR_NEED_MORE : CCDER_CURSOR_ERROR;
+    }
+
+    size_t l = 0;
+    for (size_t i = 1; i <= n; i++) {
+        l = (l << 8) | der[i];
+    }
+
+    *len = l;
+    *len_size = 1 + n;
+    return CCDER_CURSOR_OK;
+}
+
+CC_INLINE ccder_cursor_status ccder_cursor_next_internal(ccder_cursor *cursor)
+{
+    size_t start = cursor->has_current ? ccder_tlv_end(&cursor->current) : cursor->pos;
+    size_t end = cursor->ends[cursor->depth];
+
+    if (start == end) {
+        return CCDER_CURSOR_END;
+    }
+    if (start >= cursor->der_size) {
+        return cursor->complete ? CCDER_CURSOR_ERROR : CCDER_CURSOR_NEED_MORE;
+    }
+
+    // The header may be cut by the end of the input, but not by the end of its level.
+    size_t avail_end = CC_MIN(end, cursor->der_size);
+    bool truncated = avail_end < end;
+
+    ccder_read_blob blob = { cursor->der + start, cursor->der + avail_end };
+    ccder_tag tag;
+    uint8_t tag0 = cursor->der[start];
+    if ((tag0 & 0x1f) != 0x1f) {
+        // Low tag number form, cf. ccder_blob_decode_tag().
+        tag = ((ccder_tag)(tag0 & 0xe0) << ((sizeof(ccder_tag) - 1) * 8)) | (tag0 & 0x1f);
+        blob.der++;
+    } else if (!ccder_blob_decode_tag(&blob, &tag)) {
+        return truncated ? CCDER_CURSOR_NEED_MORE : CCDER_CURSOR_ERROR;
+    }
+
+    size_t tag_size = ccder_size(cursor->der + start, blob.der);
+    size_t len, len_size;
+    ccder_cursor_status status = ccder_cursor_decode_len(blob.der, ccder_blob_size(blob), truncated, &len, &len_size);
+    if (status != CCDER_CURSOR_OK) {
+        return status;
+    }
+
+    size_t header_size = tag_size + len_size;
+    if (len > end - start - header_size) {
+        return CCDER_CURSOR_ERROR;
+    }
+
+    cursor->current.tag = tag;
+    cursor->current.offset = start;
+    cursor->current.header_size = header_size;
+    cursor->current.body_size = len;
+    cursor->has_current = true;
+    return CCDER_CURSOR_OK;
+}
+
+ccder_cursor_status ccder_cursor_next(ccder_cursor *cursor, ccder_tlv *tlv)
+{
+    ccder_cursor_status status = ccder_cursor_next_internal(cursor);
+
+    if (status == CCDER_CURSOR_OK && tlv) {
+        *tlv = cursor->current;
+    }
+    return status;
+}
+
+ccder_cursor_status ccder_cursor_enter(ccder_cursor *cursor)
+{
+    if (!cursor->has_current || !(cursor->current.tag & CCDER_CONSTRUCTED) || cursor->depth == CCDER_CURSOR_MAX_DEPTH) {
+        return CCDER_CURSOR_ERROR;
+    }
+
+    cursor->depth++;
+    cursor->ends[cursor->depth] = ccder_tlv_end(&cursor->current);
+    cursor->pos = cursor->current.offset + cursor->current.header_size;
+    cursor->has_current = false;
+    return CCDER_CURSOR_OK;
+}
+
+ccder_cursor_status ccder_cursor_leave(ccder_cursor *cursor)
+{
+    if (cursor->depth == 0) {
+        return CCDER_CURSOR_ERROR;
+    }
+
+    cursor->pos = cursor->ends[cursor->depth];
+    cursor->depth--;
+    cursor->has_current = false;
+    return CCDER_CURSOR_OK;
+}
+
+static ccder_cursor_status ccder_cursor_range(const ccder_cursor *cursor, size_t start, ccder_read_blob *range)
+{
+    if (!cursor->has_current) {
+        return CCDER_CURSOR_ERROR;
+    }
+
+    size_t end = ccder_tlv_end(&cursor->current);
+    if (end > cursor->der_size) {
+        return CCDER_CURSOR_NEED_MORE;
+    }
+
+    range->der = cursor->der + start;
+    range->der_end = cursor->der + end;
+    return CCDER_CURSOR_OK;
+}
+
+ccder_cursor_status ccder_cursor_body(const ccder_cursor *cursor, ccder_read_blob *body)
+{
+    return ccder_cursor_range(cursor, cursor->current.offset + cursor->current.header_size, body);
+}
+
+ccder_cursor_status ccder_cursor_element(const ccder_cursor *cursor, ccder_read_blob *element)
+{
+    return ccder_cursor_range(cursor, cursor->current.offset, element);
+}
+
+int ccder_index(size_t der_size, const uint8_t *der, size_t *nentries, ccder_index_entry *entries)
+{
+    ccder_cursor cursor;
+    size_t parents[CCDER_CURSOR_MAX_DEPTH];
+    size_t capacity = *nentries;
+    size_t n = 0;
+
+    ccder_cursor_init(&cursor, der_size, der, true);
+    *nentries = 0;
+
+    for (;;) {
+        ccder_cursor_status status = ccder_cursor_next_internal(&cursor);
+
+        if (status == CCDER_CURSOR_END) {
+            if (cursor.depth == 0) {
+                break;
+            }
+            entries[parents[cursor.depth - 1]].next = n;
+            cc_require_or_return(ccder_cursor_leave(&cursor) == CCDER_CURSOR_OK, CCERR_PARAMETER);
+            continue;
+        }
+
+        cc_require_or_return(status == CCDER_CURSOR_OK, CCERR_PARAMETER);
+        cc_require_or_return(n < capacity, CCERR_BUFFER_TOO_SMALL);
+
+        entries[n].tlv = cursor.current;
+        entries[n].depth = cursor.depth;
+        entries[n].next = n + 1;
+
+        if (cursor.current.tag & CCDER_CONSTRUCTED) {
+            cc_require_or_return(ccder_cursor_enter(&cursor) == CCDER_CURSOR_OK, CCERR_PARAMETER);
+            parents[cursor.depth - 1] = n;
+        }
+        n++;
+    }
+
+    *nentries = n;
+    return CCERR_OK;
+}
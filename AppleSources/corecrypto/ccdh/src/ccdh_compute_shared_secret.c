@@ -67,7 +67,7 @@ int ccdh_compute_shared_secret(ccdh_full_ctx_t private_key,
     CC_ENSURE_DIT_ENABLED
 
     ccdh_const_gp_t gp = ccdh_ctx_gp(private_key);
-    CC_DECL_WORKSPACE_OR_FAIL(ws, CCDH_COMPUTE_SHARED_SECRET_WORKSPACE_N(ccdh_gp_n(gp)));
+    CC_DECL_WORKSPACE_ARENA_OR_FAIL(ws, CCDH_COMPUTE_SHARED_SECRET_WORKSPACE_N(ccdh_gp_n(gp)));
     int rv = ccdh_compute_shared_secret_ws(ws, private_key, public_key,
                                            computed_shared_secret_len,
                                            computed_shared_secret,
@@ -32,6 +32,7 @@ entryPoint(ccdigest,"ccdigest test")
 #include <corecrypto/ccsha3.h>
 #include <corecrypto/ccripemd.h>
 #include <corecrypto/ccrng.h>
+#include "ccsha2_internal.h"
 #include "ccsha3_internal.h"
 #include "cc_internal.h"
 
@@ -446,6 +447,38 @@ static void test_compare(const struct ccdigest_info *di, ...)
     va_end(argp);
 }
 
+#define MB_NMESSAGES 64
+#define MB_MAX_MESSAGE_SIZE 300
+
+static void test_multi_buffer(const struct ccdigest_info *di)
+{
+    uint8_t data[MB_NMESSAGES][MB_MAX_MESSAGE_SIZE];
+    uint8_t digests[MB_NMESSAGES][MAX_DIGEST_OUTPUT_SIZE];
+    uint8_t digest[MAX_DIGEST_OUTPUT_SIZE];
+    size_t lens[MB_NMESSAGES];
+    const void *ptrs[MB_NMESSAGES];
+    void *outs[MB_NMESSAGES];
+
+    ccrng_generate(global_test_rng, sizeof(data), data);
+
+    // Mix empty, partial and multi-block messages so that lanes finish at
+    // different times and get refilled.
+    for (size_t i = 0; i < MB_NMESSAGES; i++) {
+        lens[i] = (i * 5) % 257;
+        ptrs[i] = data[i];
+        outs[i] = digests[i];
+    }
+
+    is(ccsha2_mb(di, MB_NMESSAGES, lens, ptrs, outs), CCERR_OK, "ccsha2_mb");
+
+    bool match = true;
+    for (size_t i = 0; i < MB_NMESSAGES; i++) {
+        ccdigest(di, lens[i], data[i], digest);
+        match &= memcmp(digest, digests[i], di->output_size) == 0;
+    }
+    ok(match, "multi-buffer digests match ccdigest");
+}
+
 struct ccdigest_test_entry {
     const struct ccdigest_info* di;
     int test_count;
@@ -494,6 +527,7 @@ int ccdigest_tests(TM_UNUSED int argc, TM_UNUSED char *const *argv)
     ntests += 1;        // sha256_kat
     ntests += 2 * 11;   // test_compare
     ntests += 18;       // test_huge_input
+    ntests += 2 * 5 + 1; // test_multi_buffer
     plan_tests(ntests);
     
     // Test all the digests
@@ -516,6 +550,14 @@ int ccdigest_tests(TM_UNUSED int argc, TM_UNUSED char *const *argv)
     test_compare(ccsha3_384_di(), &ccsha3_384_c_di, NULL);
     test_compare(ccsha3_512_di(), &ccsha3_512_c_di, NULL);
     
+    // Compare multi-buffer against one message at a time.
+    test_multi_buffer(ccsha224_di());
+    test_multi_buffer(ccsha256_di());
+    test_multi_buffer(ccsha384_di());
+    test_multi_buffer(ccsha512_di());
+    test_multi_buffer(ccsha512_256_di());
+    is(ccsha2_mb(ccsha1_di(), 0, NULL, NULL, NULL), CCERR_PARAMETER, "ccsha2_mb rejects non SHA-2 digests");
+
     // Test with custom di
     test_huge_input(&custom1_di);
     test_huge_input(&custom2_di);
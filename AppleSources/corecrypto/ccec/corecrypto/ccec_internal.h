@@ -41,6 +41,7 @@
 
 /* Declare storage for a projected or affine point respectively. */
 #define ccec_point_ws(_n_)                 (3 * (_n_))
+#define ccec_affine_point_ws(_n_)          (2 * (_n_))
 #define ccec_point_size_n(_cp_)            (3 * ccec_cp_n(_cp_))
 #define ccec_point_sizeof(_cp_)            ccn_sizeof_n(ccec_point_size_n(_cp_))
 #define ccec_point_decl_cp(_cp_, _name_)   cc_ctx_decl(struct ccec_projective_point, ccec_point_sizeof(_cp_), _name_)
@@ -133,6 +134,7 @@ void ccec_full_add_default_ws(cc_ws_t ws, ccec_const_cp_t cp, ccec_projective_po
 #define CCEC_ALLOC_PUB_WS(ws, n) (ccec_pub_ctx_t)CC_ALLOC_WS(ws, ccec_pub_ctx_ws(n))
 #define CCEC_ALLOC_FULL_WS(ws, n) (ccec_full_ctx_t)CC_ALLOC_WS(ws, ccec_full_ctx_ws(n))
 #define CCEC_ALLOC_POINT_WS(ws, n) (ccec_projective_point *)CC_ALLOC_WS(ws, ccec_point_ws(n))
+#define CCEC_ALLOC_AFFINE_POINT_WS(ws, n) (ccec_affine_point *)CC_ALLOC_WS(ws, ccec_affine_point_ws(n))
 
 // P-224 cczp function pointers.
 CC_WARN_RESULT CC_NONNULL_ALL
@@ -445,6 +447,72 @@ int ccec_twin_mult_ws(cc_ws_t ws,
                       const cc_unit *d1,
                       ccec_const_projective_point_t t);
 
+/*!
+ @function   ccec_mult_base_ws
+ @abstract   Fixed-base scalar multiplication, r := d * G.
+
+ @discussion For P-256 and P-384, uses tables of precomputed multiples of G
+             and signed, odd 4-bit windows. Each window costs one constant-time
+             table scan and one complete addition, and no doublings.
+
+             For all other curves, or if tables are compiled out, falls back
+             to ccec_mult_blinded_ws() with the given G. The workspace never
+             needs to be larger than for ccec_mult_blinded_ws().
+
+             Runs in constant time.
+
+ @param      ws          Workspace of size CCEC_MULT_BASE_WORKSPACE_N(n)
+ @param      cp          Curve parameter
+ @param      r           Output point d * G
+ @param      d           Scalar d, 0 < d < q
+ @param      G           Generator of cp, in projective coordinates
+ @param      rng         RNG for projective coordinate randomization
+
+ @return     CCERR_OK on success, an error code otherwise.
+ */
+CC_NONNULL_ALL CC_WARN_RESULT
+int ccec_mult_base_ws(cc_ws_t ws,
+                      ccec_const_cp_t cp,
+                      ccec_projective_point_t r,
+                      const cc_unit *d,
+                      ccec_const_projective_point_t G,
+                      struct ccrng_state *rng);
+
+/*!
+ @function   ccec_multi_mult_ws
+ @abstract   Multi-scalar multiplication, r := d[0] * S[0] + ... + d[npoints-1] * S[npoints-1].
+
+ @discussion Uses Pippenger's bucket method with signed digits. The input
+             points are normalized with a single batched inversion, so that
+             buckets can be filled with mixed additions.
+
+             Does NOT run in constant time, only use with public scalars
+             (e.g. for batch signature verification).
+
+ @param      ws          Workspace of size CCEC_MULTI_MULT_WORKSPACE_N(n, npoints)
+ @param      cp          Curve parameter
+ @param      r           Output point
+ @param      npoints     Number of points
+ @param      d           npoints scalars of n units each (each < q)
+ @param      s           npoints input points in Jacobian projective representation
+
+ @return     CCERR_OK on success, an error code otherwise.
+ */
+CC_NONNULL_ALL CC_WARN_RESULT
+int ccec_multi_mult_ws(cc_ws_t ws,
+                       ccec_const_cp_t cp,
+                       ccec_projective_point_t r,
+                       cc_size npoints,
+                       const cc_unit *d,
+                       ccec_projective_point_t const *s);
+
+CC_NONNULL_ALL CC_WARN_RESULT
+int ccec_multi_mult(ccec_const_cp_t cp,
+                    ccec_projective_point_t r,
+                    cc_size npoints,
+                    const cc_unit *d,
+                    ccec_projective_point_t const *s);
+
 /* Debugging */
 void ccec_alprint(ccec_const_cp_t cp, const char *label, ccec_const_affine_point_t s);
 void ccec_plprint(ccec_const_cp_t cp, const char *label, ccec_const_projective_point_t s);
@@ -832,6 +900,8 @@ int ccec_sign_internal_ws(cc_ws_t ws,
  @param      x    Private signing key x.
  @param      k    Ephemeral key k.
  @param      G    Base point G.
+ @param      G_is_generator True if G is the generator of cp. Enables
+                  precomputed multiples of G, see ccec_mult_base_ws().
  @param      m    Multiplicative mask m.
  @param      r    Pointer to output buffer for r.
  @param      s    Pointer to output buffer for s.
@@ -840,13 +910,14 @@ int ccec_sign_internal_ws(cc_ws_t ws,
  @returns    0 if no error, an error code otherwise.
  */
 CC_WARN_RESULT
-CC_NONNULL_ALL
+CC_NONNULL((1, 2, 3, 4, 5, 6, 8, 9, 10, 11))
 int ccec_sign_internal_inner_ws(cc_ws_t ws,
                                 ccec_const_cp_t cp,
                                 const cc_unit *e,
                                 const cc_unit *x,
                                 const cc_unit *k,
                                 ccec_const_projective_point_t G,
+                                bool G_is_generator,
                                 const cc_unit *m,
                                 cc_unit *r,
                                 cc_unit *s,
@@ -1537,6 +1537,129 @@ static int ccec_mult_edge_case_tests(void)
     return 0;
 }
 
+static void ccec_multi_mult_tests(void)
+{
+    ccec_const_cp_t curves[] = { ccec_cp_256(), ccec_cp_384(), ccec_cp_521() };
+    const cc_size sizes[] = { 1, 5, 40 };
+
+    for (size_t i = 0; i < CC_ARRAY_LEN(curves); i++) {
+        ccec_const_cp_t cp = curves[i];
+        cczp_const_decl(zp, ccec_cp_zp(cp));
+        cc_size n = ccec_cp_n(cp);
+
+        for (size_t j = 0; j < CC_ARRAY_LEN(sizes); j++) {
+            cc_size npoints = sizes[j];
+            ccec_projective_point_t s[npoints];
+
+            CC_DECL_WORKSPACE_TEST(ws);
+            ccec_full_ctx_t key = (ccec_full_ctx_t)CC_ALLOC_WS(ws, ccec_full_ctx_size(n));
+            cc_unit *d = CC_ALLOC_WS(ws, npoints * n);
+            ccec_projective_point *r = CCEC_ALLOC_POINT_WS(ws, n);
+            ccec_projective_point *t = CCEC_ALLOC_POINT_WS(ws, n);
+            ccec_projective_point *expected = CCEC_ALLOC_POINT_WS(ws, n);
+
+            int rv = CCERR_OK;
+            for (size_t k = 0; k < npoints; k++) {
+                s[k] = CCEC_ALLOC_POINT_WS(ws, n);
+                rv |= ccec_generate_key_internal_fips_ws(ws, cp, global_test_rng, key);
+                rv |= ccec_projectify_ws(ws, cp, s[k], (ccec_affine_point_t)ccec_ctx_point(key), global_test_rng);
+                rv |= ccec_generate_scalar_fips_retry_ws(ws, cp, global_test_rng, &d[k * n]);
+            }
+
+            // Add a duplicate point, a negated point, the point at infinity, and a zero scalar.
+            if (npoints > 4) {
+                ccn_set(3 * n, (cc_unit *)s[1], (cc_unit *)s[0]);
+                ccn_set(3 * n, (cc_unit *)s[2], (cc_unit *)s[0]);
+                cczp_negate(zp, ccec_point_y(s[2], cp), ccec_point_y(s[2], cp));
+                ccn_clear(n, ccec_point_z(s[3], cp));
+                ccn_clear(n, &d[4 * n]);
+            }
+
+            // expected := d[0] * s[0] + ... + d[npoints-1] * s[npoints-1]
+            ccn_seti(n, ccec_point_x(expected, cp), 1);
+            ccn_seti(n, ccec_point_y(expected, cp), 1);
+            ccn_clear(n, ccec_point_z(expected, cp));
+
+            for (size_t k = 0; k < npoints; k++) {
+                if (ccec_is_point_at_infinity(cp, s[k]) || ccn_is_zero(n, &d[k * n])) {
+                    continue;
+                }
+
+                rv |= ccec_mult_ws(ws, cp, t, &d[k * n], ccec_cp_order_bitlen(cp), s[k]);
+                ccec_full_add_ws(ws, cp, expected, expected, t);
+            }
+
+            rv |= ccec_affinify_ws(ws, cp, (ccec_affine_point_t)expected, expected);
+            is(rv, CCERR_OK, "Computing the reference failed");
+
+            rv = ccec_multi_mult_ws(ws, cp, r, npoints, d, s);
+            rv |= ccec_affinify_ws(ws, cp, (ccec_affine_point_t)r, r);
+            is(rv, CCERR_OK, "ccec_multi_mult_ws() failed");
+
+            ok_ccn_cmp(n, ccec_point_x(r, cp), ccec_point_x(expected, cp), "x coordinates don't match");
+            ok_ccn_cmp(n, ccec_point_y(r, cp), ccec_point_y(expected, cp), "y coordinates don't match");
+
+            // Zero scalars only.
+            if (j == CC_ARRAY_LEN(sizes) - 1) {
+                ccn_clear(npoints * n, d);
+                is(ccec_multi_mult_ws(ws, cp, r, npoints, d, s), CCERR_OK, "ccec_multi_mult_ws() failed");
+                ok(ccec_is_point_at_infinity(cp, r), "Expected the point at infinity");
+            }
+
+            CC_FREE_WORKSPACE(ws);
+        }
+    }
+}
+
+static void ccec_mult_base_tests(void)
+{
+    // P-256 and P-384 use precomputed tables, the others fall back.
+    ccec_const_cp_t curves[] = { ccec_cp_224(), ccec_cp_256(), ccec_cp_384(), ccec_cp_521() };
+
+    for (size_t i = 0; i < CC_ARRAY_LEN(curves); i++) {
+        ccec_const_cp_t cp = curves[i];
+        cc_size n = ccec_cp_n(cp);
+        const cc_unit *q = cczp_prime(ccec_cp_zq(cp));
+
+        CC_DECL_WORKSPACE_TEST(ws);
+        cc_unit *d = CC_ALLOC_WS(ws, n);
+        ccec_projective_point *G = CCEC_ALLOC_POINT_WS(ws, n);
+        ccec_projective_point *r = CCEC_ALLOC_POINT_WS(ws, n);
+        ccec_projective_point *expected = CCEC_ALLOC_POINT_WS(ws, n);
+
+        int rv = ccec_projectify_ws(ws, cp, G, ccec_cp_g(cp), global_test_rng);
+
+        // d = 1, 2, q - 1, q - 2, and random scalars.
+        for (size_t j = 0; j < 12; j++) {
+            if (j < 2) {
+                ccn_seti(n, d, (cc_unit)(j + 1));
+            } else if (j < 4) {
+                ccn_sub1(n, d, q, (cc_unit)(j - 1));
+            } else {
+                rv |= ccec_generate_scalar_fips_retry_ws(ws, cp, global_test_rng, d);
+            }
+
+            rv |= ccec_mult_ws(ws, cp, expected, d, ccec_cp_order_bitlen(cp), G);
+            rv |= ccec_affinify_ws(ws, cp, (ccec_affine_point_t)expected, expected);
+
+            rv |= ccec_mult_base_ws(ws, cp, r, d, G, global_test_rng);
+            rv |= ccec_affinify_ws(ws, cp, (ccec_affine_point_t)r, r);
+            is(rv, CCERR_OK, "ccec_mult_base_ws() failed");
+
+            ok_ccn_cmp(n, ccec_point_x(r, cp), ccec_point_x(expected, cp), "x coordinates don't match");
+            ok_ccn_cmp(n, ccec_point_y(r, cp), ccec_point_y(expected, cp), "y coordinates don't match");
+        }
+
+        // d = 0 and d = q are rejected.
+        ccn_clear(n, d);
+        isnt(ccec_mult_base_ws(ws, cp, r, d, G, global_test_rng), CCERR_OK, "ccec_mult_base_ws() should fail for d = 0");
+        ccn_set(n, d, q);
+        isnt(ccec_mult_base_ws(ws, cp, r, d, G, global_test_rng), CCERR_OK, "ccec_mult_base_ws() should fail for d = q");
+
+        CC_FREE_WORKSPACE(ws);
+    }
+}
+
 static void ccec_sign_error_tests(void)
 {
     ccec_const_cp_t cp = ccec_cp_256();
@@ -1615,21 +1738,21 @@ static void ccec_sign_edge_cases_tests(void)
     is(rv, CCERR_OK, "ccec_projectify() failed");
 
     // Check that r = 0, because x(k * G) = 0, is rejected.
-    rv = ccec_sign_internal_inner_ws(ws, cp, e, x, k, G, m, r, s, global_test_rng);
+    rv = ccec_sign_internal_inner_ws(ws, cp, e, x, k, G, false, m, r, s, global_test_rng);
     is(rv, CCERR_RETRY, "ccec_sign_internal_inner_ws() should request retry");
 
     rv = ccec_projectify_ws(ws, cp, G, (ccec_const_affine_point_t)gxy2, global_test_rng);
     is(rv, CCERR_OK, "ccec_projectify() failed");
 
     // Check that r = 0, because x(k * G) = 0 (mod q), is rejected.
-    rv = ccec_sign_internal_inner_ws(ws, cp, e, x, k, G, m, r, s, global_test_rng);
+    rv = ccec_sign_internal_inner_ws(ws, cp, e, x, k, G, false, m, r, s, global_test_rng);
     is(rv, CCERR_RETRY, "ccec_sign_internal_inner_ws() should request retry");
 
     rv = ccec_projectify_ws(ws, cp, G, (ccec_const_affine_point_t)gxy3, global_test_rng);
     is(rv, CCERR_OK, "ccec_projectify() failed");
 
     // Check that s = 0, because e + xr = q, is rejected.
-    rv = ccec_sign_internal_inner_ws(ws, cp, e, x, k, G, m, r, s, global_test_rng);
+    rv = ccec_sign_internal_inner_ws(ws, cp, e, x, k, G, false, m, r, s, global_test_rng);
     is(rv, CCERR_RETRY, "ccec_sign_internal_inner_ws() should request retry");
 
     CC_FREE_WORKSPACE(ws);
@@ -1685,7 +1808,7 @@ static void ccec_verify_edge_cases_tests(void)
     ccn_random(n, k, global_test_rng);
     ccn_seti(n, m, 1); // Set mask := 1.
 
-    rv = ccec_sign_internal_inner_ws(ws, cp, e, d, k, G_prj, m, r, s, global_test_rng);
+    rv = ccec_sign_internal_inner_ws(ws, cp, e, d, k, G_prj, false, m, r, s, global_test_rng);
     is(rv, CCERR_OK, "ccec_sign_internal_inner() failed");
 
     cc_fault_canary_t unused_fault_canary;
@@ -1784,6 +1907,8 @@ int ccec_tests(TM_UNUSED int argc, TM_UNUSED char *const *argv)
     ntests += 6;     // ccec_verify_edge_cases_tests
     ntests += ccec_mult_edge_case_test_vectors_num * 5; // ccec_mult_edge_case_tests
     ntests += 9;     // ccec_pairwise_consistency_tests
+    ntests += 14 * 3; // ccec_multi_mult_tests
+    ntests += 38 * 4; // ccec_mult_base_tests
     plan_tests(ntests);
 
     if (verbose)
@@ -1837,6 +1962,8 @@ int ccec_tests(TM_UNUSED int argc, TM_UNUSED char *const *argv)
     ccec_test_xcoord_zero();
     ccec_scalar_tests();
     ccec_mult_edge_case_tests();
+    ccec_multi_mult_tests();
+    ccec_mult_base_tests();
     ccec_sign_error_tests();
     ccec_sign_edge_cases_tests();
     ccec_verify_edge_cases_tests();
@@ -53,9 +53,12 @@ void ccec_add_normalized_ws(cc_ws_t ws,
         cczp_sub_ws(ws, zp, t5, Y1, t5);   // t5 = SyTz^3 - TySz^3
     }
 
-    // If S == T, double and return.
+    // If S == T (or S == -T when subtracting), double and return.
     if (ccn_is_zero(n, t4) && ccn_is_zero(n, t5)) {
         ccec_double_ws(ws, cp, r, t);
+        if (negate_t) {
+            cczp_negate(zp, t2, t2);
+        }
         CC_FREE_BP_WS(ws, bp);
         return;
     }
@@ -44,11 +44,14 @@ int ccec_make_pub_from_priv_ws(cc_ws_t ws,
     //==========================================================================
     if (generator) {
         cc_require((result = ccec_validate_point_and_projectify_ws(ws, cp, base, generator, masking_rng)) == CCERR_OK, errOut);
+        cc_require_action(ccec_mult_blinded_ws(ws, cp, ccec_ctx_point(key), k, base, masking_rng) == CCERR_OK, errOut,
+                          result = CCEC_GENERATE_KEY_MULT_FAIL);
     } else {
         cc_require((result = ccec_projectify_ws(ws, cp, base, ccec_cp_g(cp), masking_rng)) == CCERR_OK, errOut);
+        // Use precomputed multiples of G, if available.
+        cc_require_action(ccec_mult_base_ws(ws, cp, ccec_ctx_point(key), k, base, masking_rng) == CCERR_OK, errOut,
+                          result = CCEC_GENERATE_KEY_MULT_FAIL);
     }
-    cc_require_action(ccec_mult_blinded_ws(ws, cp, ccec_ctx_point(key), k, base, masking_rng) == CCERR_OK, errOut,
-                      result = CCEC_GENERATE_KEY_MULT_FAIL);
     cc_require_action(ccec_is_point_projective_ws(ws, cp, ccec_ctx_point(key)),errOut,
                       result = CCEC_GENERATE_NOT_ON_CURVE);
     cc_require_action(ccec_affinify_ws(ws, cp, (ccec_affine_point_t)ccec_ctx_point(key), ccec_ctx_point(key)) == 0,errOut,
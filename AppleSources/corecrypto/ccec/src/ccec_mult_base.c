@@ -0,0 +1,199 @@
+/* Copyright (c) (2023) Apple Inc. All rights reserved.
+ *
+ * corecrypto is licensed under Apple Inc.’s Internal Use License Agreement (which
+ * is contained in the License.txt file distributed with corecrypto) and only to
+ * people who accept that license. IMPORTANT:  Any license rights granted to you by
+ * Apple Inc. (if any) are limited to internal use within your organization only on
+ * devices and computers you own or control, for the sole purpose of verifying the
+ * security characteristics and correct functioning of the Apple Software.  You may
+ * not, directly or indirectly, redistribute the Apple Software or any portions thereof.
+ */
+
+#include "cc_internal.h"
+#include "ccec_internal.h"
+#include "cczp_internal.h"
+#include "ccn_internal.h"
+#include "cc_unit_internal.h"
+#include "cc_workspaces.h"
+#include "cc_macros.h"
+
+#if !CCEC_VERIFY_ONLY
+
+// Width of the signed, odd digits in {±1, ±3, ..., ±15}.
+#define CCEC_MULT_BASE_W 4
+
+// Number of precomputed points per window.
+#define CCEC_MULT_BASE_NPOINTS (1 << (CCEC_MULT_BASE_W - 1))
+
+// Small code builds fall back to the generic scalar multiplication.
+#define CCEC_MULT_BASE_TABLES !CC_SMALL_CODE
+
+#if CCEC_MULT_BASE_TABLES
+#include "ccec_mult_base_p256.inc"
+#include "ccec_mult_base_p384.inc"
+
+static const struct ccec_mult_base_table {
+    size_t bitlen;
+    const cc_unit *points;
+} ccec_mult_base_tables[] = {
+    { 256, ccec_mult_base_p256_table },
+    { 384, ccec_mult_base_p384_table },
+};
+#endif
+
+CC_PURE cc_size CCEC_MULT_BASE_WORKSPACE_N(cc_size n)
+{
+    return CC_MAX_EVAL(CCEC_MULT_BLINDED_WORKSPACE_N(n),
+                       (n) + ccec_affine_point_ws(n) + (3 * n) +
+                       CC_MAX_EVAL(CCEC_PROJECTIFY_WORKSPACE_N(n), CCEC_FULL_ADD_WORKSPACE_N(n)));
+}
+
+/*
+ @function   ccec_mult_base_table
+ @abstract   Returns the table of precomputed multiples of the generator of cp,
+             or NULL if there is none.
+ */
+CC_NONNULL_ALL
+static const cc_unit *ccec_mult_base_table(ccec_const_cp_t cp)
+{
+#if CCEC_MULT_BASE_TABLES
+    cc_size n = ccec_cp_n(cp);
+    ccec_const_affine_point_t g = ccec_cp_g(cp);
+
+    for (size_t i = 0; i < CC_ARRAY_LEN(ccec_mult_base_tables); i++) {
+        const struct ccec_mult_base_table *table = &ccec_mult_base_tables[i];
+
+        // The first entry is the generator itself.
+        if (ccec_cp_prime_bitlen(cp) == table->bitlen &&
+            ccn_cmp(n, ccec_const_point_x(g, cp), &table->points[0]) == 0 &&
+            ccn_cmp(n, ccec_const_point_y(g, cp), &table->points[n]) == 0) {
+            return table->points;
+        }
+    }
+#else
+    (void)cp;
+#endif
+
+    return NULL;
+}
+
+/*
+ @function   ccec_mult_base_window
+ @abstract   Returns ((k >> (w * i)) mod 2^(w+1)) | 1.
+
+ @discussion For odd k, this is 2^w plus the i-th digit of the signed, odd
+             recoding of k. The final digit is the returned value itself.
+ */
+CC_NONNULL_ALL
+static cc_unit ccec_mult_base_window(cc_size n, const cc_unit *k, size_t i)
+{
+    size_t bit = CCEC_MULT_BASE_W * i;
+    size_t unit = bit / CCN_UNIT_BITS;
+    size_t shift = bit % CCN_UNIT_BITS;
+
+    cc_unit w = k[unit] >> shift;
+    if (shift + CCEC_MULT_BASE_W + 1 > CCN_UNIT_BITS && unit + 1 < n) {
+        w |= k[unit + 1] << (CCN_UNIT_BITS - shift);
+    }
+
+    return (w & ((CC_UNIT_C(1) << (CCEC_MULT_BASE_W + 1)) - 1)) | 1;
+}
+
+/*
+ @function   ccec_mult_base_lookup
+ @abstract   Sets a := (-1)^neg * (2j + 1) * 16^i * G, in constant time.
+
+ @discussion Coordinates of a are in standard representation.
+ */
+CC_NONNULL_ALL
+static void ccec_mult_base_lookup(ccec_const_cp_t cp,
+                                  ccec_affine_point_t a,
+                                  const cc_unit *table,
+                                  size_t i,
+                                  cc_unit j,
+                                  cc_unit neg)
+{
+    cczp_const_decl(zp, ccec_cp_zp(cp));
+    cc_size n = ccec_cp_n(cp);
+    const cc_unit *row = &table[i * CCEC_MULT_BASE_NPOINTS * 2 * n];
+
+    // Scan all entries, select the j-th.
+    ccn_set(2 * n, ccec_point_x(a, cp), row);
+    for (cc_unit k = 1; k < CCEC_MULT_BASE_NPOINTS; k++) {
+        cc_unit sel = cc_unit_eq(k, j) & 1;
+        ccn_mux(2 * n, sel, ccec_point_x(a, cp), &row[k * 2 * n], ccec_point_x(a, cp));
+    }
+
+    cczp_cond_negate(zp, neg, ccec_point_y(a, cp), ccec_point_y(a, cp));
+}
+
+int ccec_mult_base_ws(cc_ws_t ws,
+                      ccec_const_cp_t cp,
+                      ccec_projective_point_t r,
+                      const cc_unit *d,
+                      ccec_const_projective_point_t G,
+                      struct ccrng_state *rng)
+{
+    cc_size n = ccec_cp_n(cp);
+
+    // Callers size the workspace for ccec_mult_blinded_ws().
+    cc_assert(CCEC_MULT_BASE_WORKSPACE_N(n) == CCEC_MULT_BLINDED_WORKSPACE_N(n));
+
+    int rv = ccec_validate_scalar(cp, d);
+    cc_require_or_return(rv == CCERR_OK, rv);
+
+    const cc_unit *table = ccec_mult_base_table(cp);
+    if (table == NULL) {
+        return ccec_mult_blinded_ws(ws, cp, r, d, G, rng);
+    }
+
+    CC_DECL_BP_WS(ws, bp);
+
+    cczp_const_decl(zp, ccec_cp_zp(cp));
+    cc_unit *k = CC_ALLOC_WS(ws, n);
+    ccec_affine_point *a = CCEC_ALLOC_AFFINE_POINT_WS(ws, n);
+    ccec_projective_point *t = CCEC_ALLOC_POINT_WS(ws, n);
+
+    // The recoding needs an odd scalar. For even d, compute (q - d) * G
+    // and negate the result. q - d is odd, and 0 < q - d < q.
+    cc_unit even = (d[0] & 1) ^ 1;
+    ccn_sub(n, k, cczp_prime(ccec_cp_zq(cp)), d);
+    ccn_mux(n, even, k, k, d);
+
+    // k = sum_i k_i * 16^i, with k_i in {±1, ±3, ..., ±15}.
+    size_t nwindows = ccec_cp_prime_bitlen(cp) / CCEC_MULT_BASE_W;
+
+    for (size_t i = 0; i < nwindows; i++) {
+        cc_unit w = ccec_mult_base_window(n, k, i);
+        cc_unit neg = 0;
+
+        // All but the last digit are k_i = w - 16.
+        if (i < nwindows - 1) {
+            neg = ((w >> CCEC_MULT_BASE_W) & 1) ^ 1;
+        }
+
+        // j = (|k_i| - 1) / 2
+        cc_unit j = ((w ^ ((0 - neg) & 0xf)) & 0xf) >> 1;
+        ccec_mult_base_lookup(cp, a, table, i, j, neg);
+
+        if (i == 0) {
+            // Randomize the projective coordinates of the first point.
+            rv = ccec_projectify_ws(ws, cp, r, a, rng);
+            cc_require(rv == CCERR_OK, errOut);
+        } else {
+            // |sum_{l<=i} k_l * 16^l| is in [1, q), so the partial sums are
+            // never the point at infinity.
+            rv = ccec_projectify_ws(ws, cp, t, a, NULL);
+            cc_require(rv == CCERR_OK, errOut);
+            ccec_full_add_ws(ws, cp, r, r, t);
+        }
+    }
+
+    cczp_cond_negate(zp, even, ccec_point_y(r, cp), ccec_point_y(r, cp));
+
+errOut:
+    CC_FREE_BP_WS(ws, bp);
+    return rv;
+}
+
+#endif // !CCEC_VERIFY_ONLY
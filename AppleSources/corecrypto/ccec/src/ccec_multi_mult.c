@@ -0,0 +1,228 @@
+/* Copyright (c) (2023) Apple Inc. All rights reserved.
+ *
+ * corecrypto is licensed under Apple Inc.’s Internal Use License Agreement (which
+ * is contained in the License.txt file distributed with corecrypto) and only to
+ * people who accept that license. IMPORTANT:  Any license rights granted to you by
+ * Apple Inc. (if any) are limited to internal use within your organization only on
+ * devices and computers you own or control, for the sole purpose of verifying the
+ * security characteristics and correct functioning of the Apple Software.  You may
+ * not, directly or indirectly, redistribute the Apple Software or any portions thereof.
+ */
+
+#include "cc_internal.h"
+#include "cczp_internal.h"
+#include "ccn_internal.h"
+#include "ccec_internal.h"
+#include "cc_workspaces.h"
+#include "cc_macros.h"
+
+// Widest window supported by the bucket method.
+#define CCEC_MULTI_MULT_MAX_WINDOW 10
+
+/*
+ @function   ccec_multi_mult_window
+ @abstract   Returns the window width c for npoints points.
+
+ @discussion Each of the (bitlen(q)+1)/c windows costs one mixed addition per
+             point, and two full additions for each of the 2^(c-1) buckets,
+             which are each about 1.3 times as expensive. Pick the c that
+             minimizes (1/c) * (npoints + 0.75 * 2^c).
+ */
+CC_CONST static size_t ccec_multi_mult_window(size_t nbits, cc_size npoints)
+{
+    size_t best = 2;
+    size_t best_cost = SIZE_MAX;
+
+    for (size_t c = 2; c <= CCEC_MULTI_MULT_MAX_WINDOW; c++) {
+        size_t cost = cc_ceiling(nbits + 1, c) * (npoints + ((size_t)3 << (c - 2)));
+        if (cost < best_cost) {
+            best_cost = cost;
+            best = c;
+        }
+    }
+
+    return best;
+}
+
+CC_PURE cc_size CCEC_MULTI_MULT_WORKSPACE_N(cc_size n, cc_size npoints)
+{
+    size_t c = ccec_multi_mult_window(ccn_bitsof_n(n), npoints);
+    size_t ndigits = cc_ceiling(ccn_bitsof_n(n) + 1, c);
+    size_t nbuckets = (size_t)1 << (c - 1);
+
+    return 2 * ccn_nof_size(npoints * sizeof(void *)) +
+           ccn_nof_size(npoints * ndigits * sizeof(int16_t)) +
+           npoints * ccec_point_ws(n) + nbuckets * ccec_point_ws(n) + ccec_point_ws(n) + n +
+           CC_MAX_EVAL(CC_MAX_EVAL(CCEC_AFFINIFY_POINTS_WORKSPACE_N(n, npoints), CCEC_FULL_ADD_WORKSPACE_N(n)),
+                       CC_MAX_EVAL(CC_MAX_EVAL(CCEC_FULL_ADD_NORMALIZED_WORKSPACE_N(n), CCEC_FULL_SUB_NORMALIZED_WORKSPACE_N(n)),
+                                   CC_MAX_EVAL(CCEC_DOUBLE_WORKSPACE_N(n), CCZP_TO_WORKSPACE_N(n))));
+}
+
+/*
+ @function   ccec_multi_mult_recode
+ @abstract   Recodes d into signed c-bit digits in (-2^(c-1), 2^(c-1)],
+             least significant first.
+
+ @discussion With ndigits * c > bitlen(d), the last digit never carries.
+ */
+CC_NONNULL_ALL
+static void ccec_multi_mult_recode(cc_size n, const cc_unit *d, size_t c, size_t ndigits, int16_t *digits)
+{
+    int carry = 0;
+
+    for (size_t w = 0; w < ndigits; w++) {
+        int digit = carry;
+
+        for (size_t j = 0; j < c && w * c + j < ccn_bitsof_n(n); j++) {
+            digit += (int)ccn_bit(d, w * c + j) << j;
+        }
+
+        carry = digit > (1 << (c - 1));
+        digits[w] = (int16_t)(digit - (carry << c));
+    }
+}
+
+// Set r := (1 : 1 : 0), the point at infinity.
+CC_NONNULL_ALL
+static void ccec_multi_mult_set_infinity(ccec_const_cp_t cp, ccec_projective_point_t r, const cc_unit *one)
+{
+    cc_size n = ccec_cp_n(cp);
+
+    ccn_set(n, ccec_point_x(r, cp), one);
+    ccn_set(n, ccec_point_y(r, cp), one);
+    ccn_clear(n, ccec_point_z(r, cp));
+}
+
+/*
+ @function   ccec_multi_mult_add_ws
+ @abstract   Computes R := R + S.
+
+ @discussion The complete addition formulas can return the point at infinity
+             with a y-coordinate of zero, (0 : 0 : 0) in Jacobian coordinates.
+             That is not a valid input to later additions, so map it back
+             to (1 : 1 : 0).
+ */
+CC_NONNULL_ALL
+static void ccec_multi_mult_add_ws(cc_ws_t ws,
+                                   ccec_const_cp_t cp,
+                                   ccec_projective_point_t r,
+                                   ccec_const_projective_point_t s,
+                                   const cc_unit *one)
+{
+    ccec_full_add_ws(ws, cp, r, r, s);
+
+    if (ccec_is_point_at_infinity(cp, r)) {
+        ccec_multi_mult_set_infinity(cp, r, one);
+    }
+}
+
+int ccec_multi_mult_ws(cc_ws_t ws,
+                       ccec_const_cp_t cp,
+                       ccec_projective_point_t r,
+                       cc_size npoints,
+                       const cc_unit *d,
+                       ccec_projective_point_t const *s)
+{
+    cczp_const_decl(zp, ccec_cp_zp(cp));
+    cc_size n = ccec_cp_n(cp);
+    int rv = CCERR_OK;
+
+    size_t c = ccec_multi_mult_window(ccn_bitsof_n(n), npoints);
+    size_t ndigits = cc_ceiling(ccec_cp_order_bitlen(cp) + 1, c);
+    size_t nbuckets = (size_t)1 << (c - 1);
+
+    CC_DECL_BP_WS(ws, bp);
+    ccec_projective_point_t *in = (ccec_projective_point_t *)CC_ALLOC_WS(ws, ccn_nof_size(npoints * sizeof(void *)));
+    ccec_affine_point_t *out = (ccec_affine_point_t *)CC_ALLOC_WS(ws, ccn_nof_size(npoints * sizeof(void *)));
+    int16_t *digits = (int16_t *)CC_ALLOC_WS(ws, ccn_nof_size(npoints * ndigits * sizeof(int16_t)));
+    cc_unit *points = CC_ALLOC_WS(ws, npoints * ccec_point_ws(n));
+    cc_unit *buckets = CC_ALLOC_WS(ws, nbuckets * ccec_point_ws(n));
+    ccec_projective_point *sum = CCEC_ALLOC_POINT_WS(ws, n);
+    cc_unit *one = CC_ALLOC_WS(ws, n);
+
+    ccn_seti(n, one, 1);
+    cczp_to_ws(ws, zp, one, one);
+
+    ccec_multi_mult_set_infinity(cp, r, one);
+
+    // Points at infinity and zero scalars don't contribute to the sum.
+    cc_size m = 0;
+    for (cc_size i = 0; i < npoints; i++) {
+        if (ccec_is_point_at_infinity(cp, s[i]) || ccn_is_zero(n, &d[i * n])) {
+            continue;
+        }
+
+        in[m] = s[i];
+        out[m] = (ccec_affine_point_t)&points[m * ccec_point_ws(n)];
+        ccec_multi_mult_recode(n, &d[i * n], c, ndigits, &digits[m * ndigits]);
+        m += 1;
+    }
+
+    cc_require(m > 0, errOut);
+
+    // Normalize all points with a single inversion, for mixed additions.
+    rv = ccec_affinify_points_ws(ws, cp, m, out, in);
+    cc_require(rv == CCERR_OK, errOut);
+
+    for (cc_size i = 0; i < m; i++) {
+        ccec_projective_point_t p = (ccec_projective_point_t)out[i];
+        cczp_to_ws(ws, zp, ccec_point_x(p, cp), ccec_point_x(p, cp));
+        cczp_to_ws(ws, zp, ccec_point_y(p, cp), ccec_point_y(p, cp));
+        ccn_set(n, ccec_point_z(p, cp), one);
+    }
+
+    for (size_t w = ndigits; w > 0; w -= 1) {
+        // r := 2^c * r
+        for (size_t j = 0; j < c && w < ndigits; j++) {
+            ccec_double_ws(ws, cp, r, r);
+        }
+
+        for (size_t b = 0; b < nbuckets; b++) {
+            ccec_multi_mult_set_infinity(cp, (ccec_projective_point_t)&buckets[b * ccec_point_ws(n)], one);
+        }
+
+        // Sort the points into buckets by the absolute value of their digit.
+        for (cc_size i = 0; i < m; i++) {
+            int digit = digits[i * ndigits + (w - 1)];
+            ccec_const_projective_point_t p = (ccec_const_projective_point_t)out[i];
+
+            if (digit > 0) {
+                ccec_projective_point_t bucket = (ccec_projective_point_t)&buckets[(size_t)(digit - 1) * ccec_point_ws(n)];
+                ccec_full_add_normalized_ws(ws, cp, bucket, bucket, p);
+            } else if (digit < 0) {
+                ccec_projective_point_t bucket = (ccec_projective_point_t)&buckets[(size_t)(-digit - 1) * ccec_point_ws(n)];
+                ccec_full_sub_normalized_ws(ws, cp, bucket, bucket, p);
+            }
+        }
+
+        // r += sum_{b} b * bucket[b], using running sums from the top bucket down.
+        ccec_multi_mult_set_infinity(cp, sum, one);
+
+        for (size_t b = nbuckets; b > 0; b -= 1) {
+            ccec_projective_point_t bucket = (ccec_projective_point_t)&buckets[(b - 1) * ccec_point_ws(n)];
+
+            if (!ccec_is_point_at_infinity(cp, bucket)) {
+                ccec_multi_mult_add_ws(ws, cp, sum, bucket, one);
+            }
+            if (!ccec_is_point_at_infinity(cp, sum)) {
+                ccec_multi_mult_add_ws(ws, cp, r, sum, one);
+            }
+        }
+    }
+
+errOut:
+    CC_FREE_BP_WS(ws, bp);
+    return rv;
+}
+
+int ccec_multi_mult(ccec_const_cp_t cp,
+                    ccec_projective_point_t r,
+                    cc_size npoints,
+                    const cc_unit *d,
+                    ccec_projective_point_t const *s)
+{
+    CC_DECL_WORKSPACE_OR_FAIL(ws, CCEC_MULTI_MULT_WORKSPACE_N(ccec_cp_n(cp), npoints));
+    int rv = ccec_multi_mult_ws(ws, cp, r, npoints, d, s);
+    CC_FREE_WORKSPACE(ws);
+    return rv;
+}
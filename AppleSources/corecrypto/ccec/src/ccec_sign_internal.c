@@ -21,6 +21,7 @@ int ccec_sign_internal_inner_ws(cc_ws_t ws,
                                 const cc_unit *x,
                                 const cc_unit *k,
                                 ccec_const_projective_point_t G,
+                                bool G_is_generator,
                                 const cc_unit *m,
                                 cc_unit *r,
                                 cc_unit *s,
@@ -34,7 +35,12 @@ int ccec_sign_internal_inner_ws(cc_ws_t ws,
     ccec_projective_point *Q = CCEC_ALLOC_POINT_WS(ws, n);
 
     // Compute Q = k * G.
-    int rv = ccec_mult_blinded_ws(ws, cp, Q, k, G, rng);
+    int rv;
+    if (G_is_generator) {
+        rv = ccec_mult_base_ws(ws, cp, Q, k, G, rng);
+    } else {
+        rv = ccec_mult_blinded_ws(ws, cp, Q, k, G, rng);
+    }
     cc_require(rv == CCERR_OK, errOut);
 
     rv = ccec_affinify_x_only_ws(ws, cp, ccec_point_x(Q, cp), Q);
@@ -137,7 +143,7 @@ int ccec_sign_internal_ws(cc_ws_t ws,
         cc_require(result == CCERR_OK, errOut);
 
         // Compute (r,s). Retry if either r=0 or s=0.
-        result = ccec_sign_internal_inner_ws(ws, cp, e, x, k, G, m, r, s, rng);
+        result = ccec_sign_internal_inner_ws(ws, cp, e, x, k, G, true, m, r, s, rng);
         if (result == CCERR_OK) {
             break;
         }
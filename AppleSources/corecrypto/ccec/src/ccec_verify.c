@@ -115,7 +115,7 @@ int ccec_verify_digest(ccec_pub_ctx_t key,
 {
     CC_ENSURE_DIT_ENABLED
 
-    CC_DECL_WORKSPACE_OR_FAIL(ws, CCEC_VERIFY_DIGEST_WORKSPACE_N(ccec_ctx_n(key)));
+    CC_DECL_WORKSPACE_ARENA_OR_FAIL(ws, CCEC_VERIFY_DIGEST_WORKSPACE_N(ccec_ctx_n(key)));
     int rv = ccec_verify_digest_ws(ws, key, digest_len, digest, sig_len, sig, fault_canary_out);
     CC_FREE_WORKSPACE(ws);
     return rv;
@@ -147,7 +147,7 @@ int ccec_verify_msg(ccec_pub_ctx_t key,
     CC_ENSURE_DIT_ENABLED
 
     ccec_const_cp_t cp = ccec_ctx_cp(key);
-    CC_DECL_WORKSPACE_OR_FAIL(ws, CCEC_VERIFY_MSG_WORKSPACE_N(ccec_cp_n(cp)));
+    CC_DECL_WORKSPACE_ARENA_OR_FAIL(ws, CCEC_VERIFY_MSG_WORKSPACE_N(ccec_cp_n(cp)));
     int rv = ccec_verify_msg_ws(ws, key, di, msg_len, msg, sig_len, sig, fault_canary_out);
     CC_FREE_WORKSPACE(ws);
     return rv;
@@ -223,7 +223,7 @@ int ccec_verify_strict(ccec_pub_ctx_t key,
                        const uint8_t *sig,
                        bool *valid)
 {
-    CC_DECL_WORKSPACE_OR_FAIL(ws, CCEC_VERIFY_STRICT_WORKSPACE_N(ccec_ctx_n(key)));
+    CC_DECL_WORKSPACE_ARENA_OR_FAIL(ws, CCEC_VERIFY_STRICT_WORKSPACE_N(ccec_ctx_n(key)));
     int rv = ccec_verify_strict_ws(ws, key, digest_len, digest, sig_len, sig, valid);
     CC_FREE_WORKSPACE(ws);
     return rv;
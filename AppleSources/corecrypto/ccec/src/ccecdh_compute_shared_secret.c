@@ -92,7 +92,7 @@ int ccecdh_compute_shared_secret(ccec_full_ctx_t private_key,
     CC_ENSURE_DIT_ENABLED
 
     ccec_const_cp_t cp = ccec_ctx_cp(private_key);
-    CC_DECL_WORKSPACE_OR_FAIL(ws, CCECDH_COMPUTE_SHARED_SECRET_WORKSPACE_N(ccec_cp_n(cp)));
+    CC_DECL_WORKSPACE_ARENA_OR_FAIL(ws, CCECDH_COMPUTE_SHARED_SECRET_WORKSPACE_N(ccec_cp_n(cp)));
     int rv = ccecdh_compute_shared_secret_ws(ws, private_key, public_key,
         computed_shared_secret_len, computed_shared_secret, masking_rng);
     CC_FREE_WORKSPACE(ws);
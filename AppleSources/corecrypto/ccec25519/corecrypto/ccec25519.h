@@ -173,4 +173,40 @@ int cced25519_verify(const struct ccdigest_info *di,
                      const ccec25519signature sig,
                      const ccec25519pubkey pk);
 
+/*!
+    @function   cced25519_verify_batch
+    @abstract   Verifies a batch of signed messages, each with its own public key.
+
+    @param      di          A valid descriptor for a 512 bit hash function for the platform
+    @param      rng         RNG for the random coefficients of the batch equation.
+    @param      nsigs       Number of signatures to verify.
+    @param      msg_nbytes  Number of bytes of each message.
+    @param      msgs        Messages to verify.
+    @param      sigs        64-byte signatures to verify the messages against.
+    @param      pks         32-byte public keys.
+    @param      results     Receives 0 for each valid signature, non-zero otherwise.
+
+    @result     0=All signed messages are valid.
+                CCERR_INVALID_SIGNATURE=At least one signature is invalid, see results.
+                Other non-zero=Failure.
+
+    @discussion The signatures are checked together with a random linear
+                combination of the verification equations, and a single
+                multi-scalar multiplication. If the batch does not verify, every
+                signature is checked with cced25519_verify() to find the bad ones.
+
+                The results match those of cced25519_verify(), including for
+                signatures whose R or public key has a small-order component.
+                Small batches are verified one signature at a time.
+*/
+CC_NONNULL_ALL
+int cced25519_verify_batch(const struct ccdigest_info *di,
+                           struct ccrng_state *rng,
+                           size_t nsigs,
+                           const size_t *cc_counted_by(nsigs) msg_nbytes,
+                           const void *const *cc_counted_by(nsigs) msgs,
+                           const ccec25519signature *cc_counted_by(nsigs) sigs,
+                           const ccec25519pubkey *cc_counted_by(nsigs) pks,
+                           int *cc_counted_by(nsigs) results);
+
 #endif /* _CORECRYPTO_CCEC25519_H_ */
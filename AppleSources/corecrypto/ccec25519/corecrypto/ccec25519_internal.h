@@ -319,6 +319,85 @@ void cced25519_double_scalar_mult_ws(cc_ws_t ws,
                                      const cc_unit *t,
                                      ccec_const_projective_point_t Q);
 
+/*! @function cced25519_multi_scalar_mult_window
+ @abstract Returns the window width, in bits, that the bucket method of
+           cced25519_multi_scalar_mult_ws() uses for `npoints` points.
+
+ @discussion With signed digits, each of the 256/c windows costs one addition
+             per point plus two per each of the 2^(c-1) buckets, so pick c
+             minimizing (256/c) * (npoints + 2^c).
+
+ @param npoints Number of points.
+*/
+CC_INLINE size_t cced25519_multi_scalar_mult_window(size_t npoints)
+{
+    size_t best = 2;
+    size_t best_cost = SIZE_MAX;
+
+    for (size_t c = 2; c <= 8; c++) {
+        size_t cost = cc_ceiling(256, c) * (npoints + ((size_t)1 << c));
+        if (cost < best_cost) {
+            best_cost = cost;
+            best = c;
+        }
+    }
+
+    return best;
+}
+
+CC_INLINE cc_size CCED25519_MULTI_SCALAR_MULT_WORKSPACE_N(cc_size n, size_t npoints)
+{
+    size_t c = cced25519_multi_scalar_mult_window(npoints);
+    size_t nbuckets = (size_t)1 << (c - 1);
+    return (nbuckets * (4 * n)) + (4 * n) + ccn_nof_size(npoints * cc_ceiling(256, c)) +
+           CCED25519_ADD_POINTS_UNIFIED_CACHED_WORKSPACE_N(n);
+}
+
+/*! @function cced25519_multi_scalar_mult_ws
+ @abstract Performs a multi-scalar multiplication,
+           computing R = s_1 * P_1 + ... + s_k * P_k.
+
+ @discussion This function is variable-time. It uses Pippenger's bucket
+             method with signed digits, see cced25519_multi_scalar_mult_window().
+             The scalars must be reduced mod q. The input points are
+             converted to cached form (T := 2d * T) in place.
+
+ @param ws      Workspace, see CCED25519_MULTI_SCALAR_MULT_WORKSPACE_N().
+ @param cp      Curve parameters.
+ @param R       The resulting point R (ext. twisted Edwards coordinates).
+ @param npoints Number of points k.
+ @param scalars The k scalars, n units each.
+ @param points  The k points (ext. twisted Edwards coordinates), 4n units each.
+*/
+CC_NONNULL_ALL
+void cced25519_multi_scalar_mult_ws(cc_ws_t ws,
+                                    ccec_const_cp_t cp,
+                                    cced25519_point R,
+                                    size_t npoints,
+                                    const cc_unit *scalars,
+                                    cced25519_point points);
+
+CC_INLINE cc_size CCED25519_IN_PRIME_ORDER_SUBGROUP_WORKSPACE_N(cc_size n)
+{
+    cc_size ws_n = CC_MAX_EVAL(CCED25519_DBL_POINT_WORKSPACE_N(n), CCED25519_ADD_POINTS_UNIFIED_WORKSPACE_N(n));
+    ws_n = CC_MAX_EVAL(ws_n, CCZP_FROM_WORKSPACE_N(n));
+    return (4 * n) + n + n + ws_n;
+}
+
+/*! @function cced25519_in_prime_order_subgroup_ws
+ @abstract Returns true if [q]P = O, i.e. P has no small-order component.
+
+ @discussion This function is variable-time.
+
+ @param ws Workspace, see CCED25519_IN_PRIME_ORDER_SUBGROUP_WORKSPACE_N().
+ @param cp Curve parameters.
+ @param P  A projective (ext. twisted Edwards coordinate) point P.
+*/
+CC_NONNULL_ALL CC_WARN_RESULT
+bool cced25519_in_prime_order_subgroup_ws(cc_ws_t ws,
+                                          ccec_const_cp_t cp,
+                                          cced25519_const_point P);
+
 /*! @function cced25519_to_ed25519_point_ws
  @abstract Convert a point represented by standard projective
            coordinates (X,Y,Z) to ext. twisted Edwards coordinates (X,Y,T,Z).
@@ -349,6 +428,21 @@ void cced25519_from_ed25519_point_ws(cc_ws_t ws,
                                      ccec_projective_point_t R,
                                      cced25519_const_point P);
 
+/*! @function cced25519_decode_public_and_negate_key_ws
+ @abstract Decodes and negates a given 32-byte encoded point.
+           See <https://www.rfc-editor.org/rfc/rfc8032#section-5.1.3>.
+
+ @param ws Workspace.
+ @param cp Curve parameters.
+ @param R  The resulting projective point.
+ @param pk 32-byte encoded point to decode.
+*/
+CC_NONNULL_ALL CC_WARN_RESULT
+int cced25519_decode_public_and_negate_key_ws(cc_ws_t ws,
+                                              ccec_const_cp_t cp,
+                                              ccec_projective_point_t R,
+                                              const ccec25519pubkey pk);
+
 /*! @function cced25519_verify_internal
  @abstract Verifies an Ed25519 signature.
 
@@ -367,4 +461,32 @@ int cced25519_verify_internal(ccec_const_cp_t cp,
                               const ccec25519signature sig,
                               const ccec25519pubkey pk);
 
+// Smaller batches are cheaper to verify one signature at a time. The fixed
+// cost is dominated by the checks for small-order components.
+#define CCED25519_VERIFY_BATCH_MIN_NSIGS 256
+
+/*! @function cced25519_verify_batch_internal
+ @abstract Verifies a batch of Ed25519 signatures, see cced25519_verify_batch().
+
+ @param cp         Curve parameters.
+ @param di         512-bit hash descriptor.
+ @param rng        RNG for the random batch coefficients.
+ @param nsigs      Number of signatures.
+ @param msg_nbytes Lengths of the messages in bytes.
+ @param msgs       Signed messages.
+ @param sigs       The 64-byte signatures.
+ @param pks        32-byte public keys.
+ @param results    Receives the result of each verification.
+*/
+CC_NONNULL_ALL CC_WARN_RESULT
+int cced25519_verify_batch_internal(ccec_const_cp_t cp,
+                                    const struct ccdigest_info *di,
+                                    struct ccrng_state *rng,
+                                    size_t nsigs,
+                                    const size_t *cc_counted_by(nsigs) msg_nbytes,
+                                    const void *const *cc_counted_by(nsigs) msgs,
+                                    const ccec25519signature *cc_counted_by(nsigs) sigs,
+                                    const ccec25519pubkey *cc_counted_by(nsigs) pks,
+                                    int *cc_counted_by(nsigs) results);
+
 #endif /* _CORECRYPTO_CCEC25519_INTERNAL_H_ */
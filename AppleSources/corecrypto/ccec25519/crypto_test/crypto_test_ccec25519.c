@@ -282,9 +282,170 @@ static void test_ed25519_bogus_pk(void)
     isnt(rv, CCERR_OK, "Verifying must fail with an invalid public key");
 }
 
+// Large enough to take the batch equation path.
+#define ED25519_BATCH_MAX_NSIGS CCED25519_VERIFY_BATCH_MIN_NSIGS
+
+struct ed25519_batch {
+    size_t nsigs;
+    uint8_t msgs[ED25519_BATCH_MAX_NSIGS][32];
+    size_t msg_nbytes[ED25519_BATCH_MAX_NSIGS];
+    const void *msg_ptrs[ED25519_BATCH_MAX_NSIGS];
+    ccec25519signature sigs[ED25519_BATCH_MAX_NSIGS];
+    ccec25519pubkey pks[ED25519_BATCH_MAX_NSIGS];
+    int results[ED25519_BATCH_MAX_NSIGS];
+};
+
+static void ed25519_batch_init(struct ed25519_batch *batch, size_t nsigs)
+{
+    struct ccrng_state *rng = global_test_rng;
+    const struct ccdigest_info *di = ccsha512_di();
+
+    batch->nsigs = nsigs;
+
+    for (size_t i = 0; i < nsigs; i++) {
+        ccec25519secretkey sk;
+        int rv = cced25519_make_key_pair(di, rng, batch->pks[i], sk);
+        rv |= ccrng_generate(rng, sizeof(batch->msgs[i]), batch->msgs[i]);
+        batch->msg_nbytes[i] = batch->msgs[i][0] % sizeof(batch->msgs[i]);
+        batch->msg_ptrs[i] = batch->msgs[i];
+        rv |= cced25519_sign_with_rng(di, rng, batch->sigs[i], batch->msg_nbytes[i], batch->msgs[i], batch->pks[i], sk);
+        cc_try_abort_if(rv != CCERR_OK, "ed25519 batch setup");
+    }
+}
+
+static int ed25519_batch_verify(ccec_const_cp_t cp, struct ed25519_batch *batch)
+{
+    return cced25519_verify_batch_internal(cp, ccsha512_di(), global_test_rng, batch->nsigs, batch->msg_nbytes,
+                                           batch->msg_ptrs, batch->sigs, batch->pks, batch->results);
+}
+
+// Returns true if exactly the signatures flagged in `bad` were rejected.
+static bool ed25519_batch_results_match(const struct ed25519_batch *batch, const bool *bad)
+{
+    for (size_t i = 0; i < batch->nsigs; i++) {
+        if ((batch->results[i] != CCERR_OK) != bad[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void test_ed25519_batch(ccec_const_cp_t cp)
+{
+    const size_t nsigs[] = { 1, 5, ED25519_BATCH_MAX_NSIGS };
+    struct ed25519_batch batch;
+    bool bad[ED25519_BATCH_MAX_NSIGS] = { false };
+    int rv;
+
+    for (size_t i = 0; i < CC_ARRAY_LEN(nsigs); i++) {
+        ed25519_batch_init(&batch, nsigs[i]);
+        rv = ed25519_batch_verify(cp, &batch);
+        is(rv, CCERR_OK, "Batch of %zu valid signatures", nsigs[i]);
+        ok(ed25519_batch_results_match(&batch, bad), "All %zu signatures valid", nsigs[i]);
+    }
+
+    // A single altered message.
+    size_t j = cc_rand(ED25519_BATCH_MAX_NSIGS);
+    batch.msgs[j][batch.msg_nbytes[j] / 2] ^= 0x01;
+    batch.msg_nbytes[j] += batch.msg_nbytes[j] == 0;
+    bad[j] = true;
+    rv = ed25519_batch_verify(cp, &batch);
+    is(rv, CCERR_INVALID_SIGNATURE, "Batch with an altered message");
+    ok(ed25519_batch_results_match(&batch, bad), "Altered message found");
+
+    // An altered R on top of it.
+    size_t k = (j + 1 + cc_rand(ED25519_BATCH_MAX_NSIGS - 1)) % ED25519_BATCH_MAX_NSIGS;
+    batch.sigs[k][0] ^= 0x04;
+    bad[k] = true;
+    rv = ed25519_batch_verify(cp, &batch);
+    is(rv, CCERR_INVALID_SIGNATURE, "Batch with an altered R");
+    ok(ed25519_batch_results_match(&batch, bad), "Altered R found");
+
+    // S >= q must be rejected.
+    ed25519_batch_init(&batch, ED25519_BATCH_MAX_NSIGS);
+    cc_clear(sizeof(bad), bad);
+    j = cc_rand(ED25519_BATCH_MAX_NSIGS);
+    batch.sigs[j][63] |= 0xf0;
+    bad[j] = true;
+    rv = ed25519_batch_verify(cp, &batch);
+    is(rv, CCERR_INVALID_SIGNATURE, "Batch with S >= q");
+    ok(ed25519_batch_results_match(&batch, bad), "S >= q found");
+}
+
+// Signs with pk + T, where T = (0, -1) has order two. The result verifies
+// with the cofactored equation but, for odd k, not with cced25519_verify().
+static void ed25519_batch_sign_with_torsion(struct ed25519_batch *batch, size_t j)
+{
+    struct ccrng_state *rng = global_test_rng;
+    const struct ccdigest_info *di = ccsha512_di();
+    ccec25519secretkey sk;
+    int rv;
+
+    rv = cced25519_make_key_pair(di, rng, batch->pks[j], sk);
+    cc_try_abort_if(rv != CCERR_OK, "ed25519 torsion key");
+
+    // (x, y) + T = (-x, -y). Negate y mod p = 2^255 - 19 and flip the sign of x.
+    const uint8_t sign = batch->pks[j][31] & 0x80;
+    uint8_t borrow = 0;
+    batch->pks[j][31] &= 0x7f;
+    for (size_t i = 0; i < sizeof(ccec25519pubkey); i++) {
+        uint8_t pi = (i == 0) ? 0xed : (i == 31) ? 0x7f : 0xff;
+        uint16_t d = (uint16_t)pi - batch->pks[j][i] - borrow;
+        batch->pks[j][i] = (uint8_t)d;
+        borrow = (uint8_t)(d >> 15);
+    }
+    batch->pks[j][31] |= sign ^ 0x80;
+    batch->msg_nbytes[j] = sizeof(batch->msgs[j]);
+
+    do {
+        rv = ccrng_generate(rng, sizeof(batch->msgs[j]), batch->msgs[j]);
+        rv |= cced25519_sign_deterministic(di, rng, batch->sigs[j], batch->msg_nbytes[j], batch->msgs[j], batch->pks[j], sk);
+        cc_try_abort_if(rv != CCERR_OK, "ed25519 torsion signature");
+    } while (cced25519_verify(di, batch->msg_nbytes[j], batch->msgs[j], batch->sigs[j], batch->pks[j]) == CCERR_OK);
+}
+
+static void test_ed25519_batch_torsion(ccec_const_cp_t cp)
+{
+    struct ed25519_batch batch;
+    bool bad[ED25519_BATCH_MAX_NSIGS] = { false };
+    int rv;
+
+    // A signature rejected by cced25519_verify() must not pass in a batch.
+    ed25519_batch_init(&batch, ED25519_BATCH_MAX_NSIGS);
+    size_t j = cc_rand(ED25519_BATCH_MAX_NSIGS);
+    ed25519_batch_sign_with_torsion(&batch, j);
+    bad[j] = true;
+    rv = ed25519_batch_verify(cp, &batch);
+    is(rv, CCERR_INVALID_SIGNATURE, "Batch with a small-order component");
+    ok(ed25519_batch_results_match(&batch, bad), "Small-order component found");
+
+    // Two of them would cancel in a plain sum.
+    size_t k = (j + 1 + cc_rand(ED25519_BATCH_MAX_NSIGS - 1)) % ED25519_BATCH_MAX_NSIGS;
+    ed25519_batch_sign_with_torsion(&batch, k);
+    bad[k] = true;
+    rv = ed25519_batch_verify(cp, &batch);
+    is(rv, CCERR_INVALID_SIGNATURE, "Batch with two small-order components");
+    ok(ed25519_batch_results_match(&batch, bad), "Both small-order components found");
+}
+
+static void test_ed25519_batch_public(void)
+{
+    struct ed25519_batch batch;
+    ed25519_batch_init(&batch, ED25519_BATCH_MAX_NSIGS);
+
+    int rv = cced25519_verify_batch(ccsha512_di(), global_test_rng, batch.nsigs, batch.msg_nbytes,
+                                    batch.msg_ptrs, batch.sigs, batch.pks, batch.results);
+    is(rv, CCERR_OK, "cced25519_verify_batch() of valid signatures");
+
+    batch.sigs[0][32] ^= 0x01;
+    rv = cced25519_verify_batch(ccsha512_di(), global_test_rng, batch.nsigs, batch.msg_nbytes,
+                                batch.msg_ptrs, batch.sigs, batch.pks, batch.results);
+    ok(rv == CCERR_INVALID_SIGNATURE && batch.results[0] != CCERR_OK, "cced25519_verify_batch() with an altered S");
+}
+
 int ccec25519_tests(TM_UNUSED int argc, TM_UNUSED char *const *argv)
 {
-    plan_tests(12910);
+    plan_tests(12910 + 2 + 16 * CC_ARRAY_LEN(ccec_cp_ed25519_impls));
 
     if (verbose) {
         diag("Starting Curve25519 tests");
@@ -302,11 +463,14 @@ int ccec25519_tests(TM_UNUSED int argc, TM_UNUSED char *const *argv)
     test_ed25519_roundtrip();
     test_ed25519_mismatched_pk();
     test_ed25519_bogus_pk();
+    test_ed25519_batch_public();
 
     for (unsigned i = 0; i < CC_ARRAY_LEN(ccec_cp_ed25519_impls); i++) {
         ccec_const_cp_t cp = ccec_cp_ed25519_impls[i]();
 
         test_ed25519_kat(cp);
+        test_ed25519_batch(cp);
+        test_ed25519_batch_torsion(cp);
     }
 
     return 0;
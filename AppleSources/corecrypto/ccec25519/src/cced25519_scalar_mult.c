@@ -317,3 +317,146 @@ void cced25519_double_scalar_mult_ws(cc_ws_t ws,
     cced25519_from_ed25519_point_ws(ws, cp, R, RR);
     CC_FREE_BP_WS(ws, bp);
 }
+
+/*! @function cced25519_msm_recode
+ @abstract Recodes scalar `s` < 2^253 into signed `c`-bit digits
+           in [-2^(c-1), 2^(c-1)), least significant first.
+
+ @param n       Length of s in units.
+ @param s       The scalar s.
+ @param c       Width of the digits in bits, 2 <= c <= 8.
+ @param ndigits Number of digits, ndigits * c >= 256.
+ @param digits  The resulting digits.
+*/
+CC_NONNULL_ALL
+static void cced25519_msm_recode(cc_size n, const cc_unit *s, size_t c, size_t ndigits, int8_t *digits)
+{
+    int carry = 0;
+
+    for (size_t w = 0; w < ndigits; w++) {
+        int digit = carry;
+
+        for (size_t j = 0; j < c && w * c + j < ccn_bitsof_n(n); j++) {
+            digit += (int)ccn_bit(s, w * c + j) << j;
+        }
+
+        // Move the upper half of the range to the next digit.
+        carry = digit >= (1 << (c - 1));
+        digits[w] = (int8_t)(digit - (carry << c));
+    }
+}
+
+/*! @function cced25519_set_neutral
+ @abstract Sets R to the neutral element (0,1,0,1).
+
+ @param cp Curve parameters.
+ @param R  The point to set.
+*/
+CC_NONNULL_ALL
+static void cced25519_set_neutral(ccec_const_cp_t cp, cced25519_point R)
+{
+    cczp_const_t zp = ccec_cp_zp(cp);
+    cc_size n = cczp_n(zp);
+
+    ccn_clear(n, &R[0 * n]);
+    ccn_seti(n, &R[1 * n], 1);
+    ccn_clear(n, &R[2 * n]);
+    ccn_seti(n, &R[3 * n], 1);
+}
+
+void cced25519_multi_scalar_mult_ws(cc_ws_t ws,
+                                    ccec_const_cp_t cp,
+                                    cced25519_point R,
+                                    size_t npoints,
+                                    const cc_unit *scalars,
+                                    cced25519_point points)
+{
+    cczp_const_t zp = ccec_cp_zp(cp);
+    cc_size n = cczp_n(zp);
+
+    size_t c = cced25519_multi_scalar_mult_window(npoints);
+    size_t ndigits = cc_ceiling(256, c);
+    size_t nbuckets = (size_t)1 << (c - 1);
+
+    CC_DECL_BP_WS(ws, bp);
+    cced25519_point buckets = CC_ALLOC_WS(ws, nbuckets * (4 * n));
+    cced25519_point sum = CC_ALLOC_WS(ws, 4 * n);
+    int8_t *digits = (int8_t *)CC_ALLOC_WS(ws, ccn_nof_size(npoints * ndigits));
+
+    for (size_t i = 0; i < npoints; i++) {
+        cced25519_msm_recode(n, &scalars[i * n], c, ndigits, &digits[i * ndigits]);
+        cced25519_point_to_cached_ws(ws, cp, &points[i * (4 * n)]);
+    }
+
+    cced25519_set_neutral(cp, R);
+
+    for (size_t w = ndigits; w > 0; w -= 1) {
+        // R = 2^c * R
+        for (size_t j = 0; j < c && w < ndigits; j++) {
+            cced25519_dbl_point_ws(ws, cp, R, R);
+        }
+
+        for (size_t b = 0; b < nbuckets; b++) {
+            cced25519_set_neutral(cp, &buckets[b * (4 * n)]);
+        }
+
+        // Sort the points into buckets by the absolute value of their digit.
+        for (size_t i = 0; i < npoints; i++) {
+            int digit = digits[i * ndigits + (w - 1)];
+
+            if (digit != 0) {
+                cced25519_add_points_flags_t flags = digit < 0 ? CCED25519_ADD_POINTS_FLAG_NEGATE_Q : 0;
+                cced25519_point bucket = &buckets[(size_t)(CC_MAX_EVAL(digit, -digit) - 1) * (4 * n)];
+                cced25519_add_points_unified_cached_ws(ws, cp, bucket, bucket, &points[i * (4 * n)], flags);
+            }
+        }
+
+        // R += sum_{b} b * bucket[b], using running sums from the top bucket down.
+        cced25519_set_neutral(cp, sum);
+
+        for (size_t b = nbuckets; b > 0; b -= 1) {
+            cced25519_point bucket = &buckets[(b - 1) * (4 * n)];
+            cced25519_point_to_cached_ws(ws, cp, bucket);
+            cced25519_add_points_unified_cached_ws(ws, cp, sum, sum, bucket, 0);
+            cced25519_add_points_unified_ws(ws, cp, R, sum, R, 0);
+        }
+    }
+
+    CC_FREE_BP_WS(ws, bp);
+}
+
+bool cced25519_in_prime_order_subgroup_ws(cc_ws_t ws,
+                                          ccec_const_cp_t cp,
+                                          cced25519_const_point P)
+{
+    cczp_const_t zp = ccec_cp_zp(cp);
+    cczp_const_t zq = ccec_cp_zq(cp);
+    cc_size n = cczp_n(zp);
+    const cc_unit *q = cczp_prime(zq);
+
+    CC_DECL_BP_WS(ws, bp);
+    cced25519_point R = CC_ALLOC_WS(ws, 4 * n);
+    cc_unit *x = CC_ALLOC_WS(ws, n);
+    cc_unit *t = CC_ALLOC_WS(ws, n);
+
+    // R = [q]P, double-and-add from the top bit of q.
+    ccn_set(4 * n, R, P);
+
+    for (size_t i = ccn_bitlen(n, q) - 1; i > 0; i -= 1) {
+        cced25519_dbl_point_ws(ws, cp, R, R);
+
+        if (ccn_bit(q, i - 1)) {
+            cced25519_add_points_unified_ws(ws, cp, R, P, R, 0);
+        }
+    }
+
+    // R = O iff X = 0 and Y = Z.
+    cczp_from_ws(ws, zp, x, &R[0 * n]);
+    cczp_sub_ws(ws, zp, t, &R[1 * n], &R[3 * n]);
+    cczp_from_ws(ws, zp, t, t);
+
+    bool in_subgroup = ccn_is_zero(n, x) && ccn_is_zero(n, t);
+
+    CC_FREE_BP_WS(ws, bp);
+    return in_subgroup;
+}
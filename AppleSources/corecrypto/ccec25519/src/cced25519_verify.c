@@ -22,20 +22,10 @@ static const cc_unit k2toPsub1div4[] = {
     CCN256_C(2b,83,24,80,4f,c1,df,0b,2b,4d,00,99,3d,fb,d7,a7,2f,43,18,06,ad,2f,e4,78,c4,ee,1b,27,4a,0e,a0,b0)
 };
 
-/*! @function cced25519_decode_public_and_negate_key_ws
- @abstract Decodes and negates a given 32-byte public key.
-           See <https://www.rfc-editor.org/rfc/rfc8032#section-5.1.3>.
-
- @param ws Workspace.
- @param cp Curve parameters.
- @param R  The resulting projective point.
- @param pk 32-byte public key to decode.
-*/
-CC_NONNULL_ALL CC_WARN_RESULT
-static int cced25519_decode_public_and_negate_key_ws(cc_ws_t ws,
-                                                     ccec_const_cp_t cp,
-                                                     ccec_projective_point_t R,
-                                                     const ccec25519pubkey pk)
+int cced25519_decode_public_and_negate_key_ws(cc_ws_t ws,
+                                              ccec_const_cp_t cp,
+                                              ccec_projective_point_t R,
+                                              const ccec25519pubkey pk)
 {
     cczp_const_t zp = ccec_cp_zp(cp);
     cc_size n = cczp_n(zp);
@@ -223,3 +213,339 @@ int cced25519_verify(const struct ccdigest_info *di,
     ccec_const_cp_t cp = ccec_cp_ed25519();
     return cced25519_verify_internal(cp, di, msg_nbytes, msg, sig, pk);
 }
+
+// Maximum number of signatures checked by a single batch equation.
+#define CCED25519_VERIFY_BATCH_MAX_NSIGS 1024
+
+// Number of random subset sums cced25519_verify_batch_torsion_ws() checks.
+// Each misses a small-order component with probability at most 1/2.
+#define CCED25519_VERIFY_BATCH_TORSION_TESTS 128
+
+#if !(CCN_UNIT_SIZE == 4 || CC_DUNIT_SUPPORTED == 0)
+
+static cc_size CCED25519_VERIFY_BATCH_TORSION_WORKSPACE_N(cc_size n)
+{
+    cc_size ws_n = CC_MAX_EVAL(CCED25519_ADD_POINTS_UNIFIED_WORKSPACE_N(n), CCED25519_IN_PRIME_ORDER_SUBGROUP_WORKSPACE_N(n));
+    return (CCED25519_VERIFY_BATCH_TORSION_TESTS + 16) * (4 * n) + ccn_nof_size(CCED25519_VERIFY_BATCH_TORSION_TESTS / 2) + ws_n;
+}
+
+static cc_size CCED25519_VERIFY_BATCH_WORKSPACE_N(cc_size n, size_t nsigs)
+{
+    size_t npoints = 2 * nsigs + 1;
+
+    cc_size ws_n = CCED25519_MULTI_SCALAR_MULT_WORKSPACE_N(n, npoints);
+    ws_n = CC_MAX_EVAL(ws_n, CCED25519_DECODE_PUBLIC_AND_NEGATE_KEY_WORKSPACE_N(n));
+    ws_n = CC_MAX_EVAL(ws_n, CCED25519_HASH_TO_SCALAR_WORKSPACE_N(n));
+    ws_n = CC_MAX_EVAL(ws_n, CCED25519_ADD_POINTS_UNIFIED_WORKSPACE_N(n));
+    ws_n = CC_MAX_EVAL(ws_n, CCZP_MODN_WORKSPACE_N(n));
+    ws_n = CC_MAX_EVAL(ws_n, CCZP_FROM_WORKSPACE_N(n));
+
+    ws_n = CC_MAX_EVAL(ws_n, CCED25519_VERIFY_BATCH_TORSION_WORKSPACE_N(n));
+
+    return npoints * (4 * n + n) + nsigs * (4 * n) + (4 * n) + (4 * n) + (5 * n) + ccec_point_ws(n) + ws_n;
+}
+
+/*! @function cced25519_verify_batch_torsion_ws
+ @abstract Checks that every U_i has no small-order component, by testing
+           CCED25519_VERIFY_BATCH_TORSION_TESTS random subset sums of the U_i.
+
+ @discussion If some U_i has a small-order component, a random subset sum
+             has one too with probability at least 1/2.
+
+             The U_i are taken four at a time. All 16 subset sums of a group
+             are computed once, each test then adds the one its 4-bit mask
+             selects. That is about 33 point additions per signature, instead
+             of 64 when every test sums the U_i on its own.
+
+ @param ws    Workspace.
+ @param cp    Curve parameters.
+ @param rng   RNG for the random subsets.
+ @param nsigs Number of points U_i.
+ @param U     The points U_i (ext. twisted Edwards coordinates), 4n units each.
+
+ @return CCERR_OK if all tests pass, CCERR_INVALID_SIGNATURE if one fails,
+         another error otherwise.
+*/
+CC_NONNULL_ALL CC_WARN_RESULT
+static int cced25519_verify_batch_torsion_ws(cc_ws_t ws,
+                                             ccec_const_cp_t cp,
+                                             struct ccrng_state *rng,
+                                             size_t nsigs,
+                                             cced25519_const_point U)
+{
+    cczp_const_t zp = ccec_cp_zp(cp);
+    cc_size n = cczp_n(zp);
+
+    int rv = CCERR_OK;
+
+    CC_DECL_BP_WS(ws, bp);
+    cced25519_point V = CC_ALLOC_WS(ws, CCED25519_VERIFY_BATCH_TORSION_TESTS * (4 * n));
+    cced25519_point W = CC_ALLOC_WS(ws, 16 * (4 * n));
+    uint8_t *masks = (uint8_t *)CC_ALLOC_WS(ws, ccn_nof_size(CCED25519_VERIFY_BATCH_TORSION_TESTS / 2));
+
+    // V_j = O
+    ccn_clear(CCED25519_VERIFY_BATCH_TORSION_TESTS * (4 * n), V);
+    for (size_t j = 0; j < CCED25519_VERIFY_BATCH_TORSION_TESTS; j++) {
+        ccn_seti(n, &V[j * (4 * n) + 1 * n], 1);
+        ccn_seti(n, &V[j * (4 * n) + 3 * n], 1);
+    }
+
+    for (size_t i = 0; i < nsigs; i += 4) {
+        size_t m = CC_MIN(nsigs - i, 4);
+
+        // W_s = sum of U_(i+b) for every bit b set in s.
+        for (uint32_t s = 1; s < (1u << m); s++) {
+            cced25519_const_point Ub = &U[(i + cc_ctz32(s)) * (4 * n)];
+            uint32_t rest = s & (s - 1);
+
+            if (rest == 0) {
+                ccn_set(4 * n, &W[s * (4 * n)], Ub);
+            } else {
+                cced25519_add_points_unified_ws(ws, cp, &W[s * (4 * n)], Ub, &W[rest * (4 * n)], 0);
+            }
+        }
+
+        rv = ccrng_generate(rng, CCED25519_VERIFY_BATCH_TORSION_TESTS / 2, masks);
+        cc_require(rv == CCERR_OK, errOut);
+
+        for (size_t j = 0; j < CCED25519_VERIFY_BATCH_TORSION_TESTS; j++) {
+            uint32_t s = (masks[j / 2] >> (4 * (j % 2))) & ((1u << m) - 1);
+
+            if (s != 0) {
+                cced25519_point Vj = &V[j * (4 * n)];
+                cced25519_add_points_unified_ws(ws, cp, Vj, &W[s * (4 * n)], Vj, 0);
+            }
+        }
+    }
+
+    for (size_t j = 0; j < CCED25519_VERIFY_BATCH_TORSION_TESTS; j++) {
+        cc_require_action(cced25519_in_prime_order_subgroup_ws(ws, cp, &V[j * (4 * n)]), errOut, rv = CCERR_INVALID_SIGNATURE);
+    }
+
+errOut:
+    CC_FREE_BP_WS(ws, bp);
+    return rv;
+}
+
+/*! @function cced25519_verify_batch_ws
+ @abstract Checks that R_i = [S_i]B - [k_i]A_i for all signatures, as
+           cced25519_verify() does.
+
+ @discussion Let D_i = [S_i]B - [k_i]A_i - R_i. The cofactored batch equation
+             [8]([sum z_i * S_i]B - sum [z_i]R_i - sum [z_i * k_i]A_i) = O
+             for random 128-bit coefficients z_i shows that every D_i is a
+             small-order point. D_i is then the small-order component of
+             -(R_i + [k_i mod 8]A_i), which cced25519_verify_batch_torsion_ws()
+             checks is zero. Without that second step, signatures that
+             cced25519_verify() rejects because of a small-order component
+             in R_i or A_i would pass.
+
+ @param ws         Workspace.
+ @param cp         Curve parameters.
+ @param di         512-bit hash descriptor.
+ @param rng        RNG for the coefficients z_i.
+ @param nsigs      Number of signatures.
+ @param msg_nbytes Lengths of the messages in bytes.
+ @param msgs       Signed messages.
+ @param sigs       The 64-byte signatures.
+ @param pks        32-byte public keys.
+
+ @return CCERR_OK if the batch equation holds, CCERR_INVALID_SIGNATURE if it
+         does not or if any signature or key is malformed, another error otherwise.
+*/
+CC_NONNULL_ALL CC_WARN_RESULT
+static int cced25519_verify_batch_ws(cc_ws_t ws,
+                                     ccec_const_cp_t cp,
+                                     const struct ccdigest_info *di,
+                                     struct ccrng_state *rng,
+                                     size_t nsigs,
+                                     const size_t *msg_nbytes,
+                                     const void *const *msgs,
+                                     const ccec25519signature *sigs,
+                                     const ccec25519pubkey *pks)
+{
+    int rv = CCERR_INVALID_SIGNATURE;
+
+    cczp_const_t zp = ccec_cp_zp(cp);
+    cczp_const_t zq = ccec_cp_zq(cp);
+    cc_size n = cczp_n(zp);
+
+    size_t npoints = 2 * nsigs + 1;
+
+    CC_DECL_BP_WS(ws, bp);
+    cced25519_point points = CC_ALLOC_WS(ws, npoints * (4 * n));
+    cc_unit *scalars = CC_ALLOC_WS(ws, npoints * n);
+    cced25519_point P = CC_ALLOC_WS(ws, 4 * n);
+    cced25519_point T = CC_ALLOC_WS(ws, 4 * n);
+    cc_unit *k = CC_ALLOC_WS(ws, n);
+    cc_unit *s = CC_ALLOC_WS(ws, n);
+    cc_unit *z = CC_ALLOC_WS(ws, n);
+    cc_unit *t = CC_ALLOC_WS(ws, 2 * n);
+    cced25519_point U = CC_ALLOC_WS(ws, nsigs * (4 * n));
+
+    ccec_projective_point *Q = CCEC_ALLOC_POINT_WS(ws, n);
+
+    // The base point B comes first, its scalar accumulates sum z_i * S_i (mod q).
+    cc_unit *zs = &scalars[0];
+    ccn_clear(n, zs);
+
+    ccn_set(n, ccec_point_x(Q, cp), ccec_const_point_x(ccec_cp_g(cp), cp));
+    ccn_set(n, ccec_point_y(Q, cp), ccec_const_point_y(ccec_cp_g(cp), cp));
+    ccn_seti(n, ccec_point_z(Q, cp), 1);
+    cced25519_to_ed25519_point_ws(ws, cp, &points[0], Q);
+
+    for (size_t i = 0; i < nsigs; i++) {
+        cced25519_point R = &points[(2 * i + 1) * (4 * n)];
+        cced25519_point A = &points[(2 * i + 2) * (4 * n)];
+
+        // Ensure 0 <= S < q.
+        ccn_read_le_bytes(n, &sigs[i][32], s);
+        cc_require_action(ccn_cmp(n, s, cczp_prime(zq)) < 0, errOut, rv = CCERR_INVALID_SIGNATURE);
+
+        // Decode and negate R and the public key.
+        rv = cced25519_decode_public_and_negate_key_ws(ws, cp, Q, sigs[i]);
+        cc_require_action(rv == CCERR_OK, errOut, rv = CCERR_INVALID_SIGNATURE);
+        cced25519_to_ed25519_point_ws(ws, cp, R, Q);
+
+        rv = cced25519_decode_public_and_negate_key_ws(ws, cp, Q, pks[i]);
+        cc_require_action(rv == CCERR_OK, errOut, rv = CCERR_INVALID_SIGNATURE);
+        cced25519_to_ed25519_point_ws(ws, cp, A, Q);
+
+        // SHA-512(R || A || M)
+        cced25519_hash_to_scalar_ws(ws, cp, di, k, 32, sigs[i], 32, pks[i], msg_nbytes[i], msgs[i]);
+
+        // U_i = -R_i - [k_i mod 8]A_i, before the points are converted to cached form.
+        cced25519_point Ui = &U[i * (4 * n)];
+        ccn_set(4 * n, Ui, R);
+        for (cc_unit j = 0; j < (k[0] & 7); j++) {
+            cced25519_add_points_unified_ws(ws, cp, Ui, A, Ui, 0);
+        }
+
+        uint8_t zbytes[32] = { 0 };
+        rv = ccrng_generate(rng, 16, zbytes);
+        cc_require(rv == CCERR_OK, errOut);
+        ccn_read_le_bytes(n, zbytes, z);
+
+        // -R_i is multiplied by z_i, -A_i by z_i * k_i (mod q).
+        ccn_set(n, &scalars[(2 * i + 1) * n], z);
+
+        ccn_mul_ws(ws, n, t, z, k);
+        cczp_modn_ws(ws, zq, &scalars[(2 * i + 2) * n], 2 * n, t);
+
+        ccn_mul_ws(ws, n, t, z, s);
+        cczp_modn_ws(ws, zq, k, 2 * n, t);
+        cczp_add_ws(ws, zq, zs, zs, k);
+    }
+
+    cced25519_multi_scalar_mult_ws(ws, cp, P, npoints, scalars, points);
+
+    // Clear the small-order component: P = [8]P.
+    cced25519_add_points_unified_ws(ws, cp, T, P, P, 0);
+    cced25519_add_points_unified_ws(ws, cp, P, T, T, 0);
+    cced25519_add_points_unified_ws(ws, cp, T, P, P, 0);
+
+    // P = O iff X = 0 and Y = Z.
+    cczp_from_ws(ws, zp, s, &T[0 * n]);
+    cczp_sub_ws(ws, zp, t, &T[1 * n], &T[3 * n]);
+    cczp_from_ws(ws, zp, k, t);
+
+    cc_require_action(ccn_is_zero(n, s) && ccn_is_zero(n, k), errOut, rv = CCERR_INVALID_SIGNATURE);
+
+    rv = cced25519_verify_batch_torsion_ws(ws, cp, rng, nsigs, U);
+
+errOut:
+    CC_FREE_BP_WS(ws, bp);
+    return rv;
+}
+
+#endif // !(CCN_UNIT_SIZE == 4 || CC_DUNIT_SUPPORTED == 0)
+
+/*! @function cced25519_verify_batch_chunk
+ @abstract Verifies up to CCED25519_VERIFY_BATCH_MAX_NSIGS signatures with
+           a single batch equation, falling back to individual verification
+           to find the invalid ones if the equation does not hold.
+*/
+CC_NONNULL_ALL CC_WARN_RESULT
+static int cced25519_verify_batch_chunk(ccec_const_cp_t cp,
+                                        const struct ccdigest_info *di,
+                                        struct ccrng_state *rng,
+                                        size_t nsigs,
+                                        const size_t *msg_nbytes,
+                                        const void *const *msgs,
+                                        const ccec25519signature *sigs,
+                                        const ccec25519pubkey *pks,
+                                        int *results)
+{
+    int rv;
+
+#if !(CCN_UNIT_SIZE == 4 || CC_DUNIT_SUPPORTED == 0)
+    if (nsigs >= CCED25519_VERIFY_BATCH_MIN_NSIGS) {
+        CC_DECL_WORKSPACE_OR_FAIL(ws, CCED25519_VERIFY_BATCH_WORKSPACE_N(CCN256_N, nsigs));
+        rv = cced25519_verify_batch_ws(ws, cp, di, rng, nsigs, msg_nbytes, msgs, sigs, pks);
+        CC_FREE_WORKSPACE(ws);
+
+        if (rv == CCERR_OK) {
+            for (size_t i = 0; i < nsigs; i++) {
+                results[i] = CCERR_OK;
+            }
+            return CCERR_OK;
+        }
+
+        cc_require_or_return(rv == CCERR_INVALID_SIGNATURE, rv);
+    }
+#else
+    (void)rng;
+#endif
+
+    rv = CCERR_OK;
+
+    for (size_t i = 0; i < nsigs; i++) {
+        results[i] = cced25519_verify_internal(cp, di, msg_nbytes[i], msgs[i], sigs[i], pks[i]);
+        if (results[i] != CCERR_OK) {
+            rv = CCERR_INVALID_SIGNATURE;
+        }
+    }
+
+    return rv;
+}
+
+int cced25519_verify_batch_internal(ccec_const_cp_t cp,
+                                    const struct ccdigest_info *di,
+                                    struct ccrng_state *rng,
+                                    size_t nsigs,
+                                    const size_t *cc_counted_by(nsigs) msg_nbytes,
+                                    const void *const *cc_counted_by(nsigs) msgs,
+                                    const ccec25519signature *cc_counted_by(nsigs) sigs,
+                                    const ccec25519pubkey *cc_counted_by(nsigs) pks,
+                                    int *cc_counted_by(nsigs) results)
+{
+    int rv = CCERR_OK;
+
+    for (size_t i = 0; i < nsigs; i += CCED25519_VERIFY_BATCH_MAX_NSIGS) {
+        size_t m = CC_MIN(nsigs - i, CCED25519_VERIFY_BATCH_MAX_NSIGS);
+
+        int chunk_rv = cced25519_verify_batch_chunk(cp, di, rng, m, &msg_nbytes[i], &msgs[i], &sigs[i], &pks[i], &results[i]);
+        if (chunk_rv == CCERR_INVALID_SIGNATURE) {
+            rv = chunk_rv;
+        } else if (chunk_rv != CCERR_OK) {
+            return chunk_rv;
+        }
+    }
+
+    return rv;
+}
+
+int cced25519_verify_batch(const struct ccdigest_info *di,
+                           struct ccrng_state *rng,
+                           size_t nsigs,
+                           const size_t *cc_counted_by(nsigs) msg_nbytes,
+                           const void *const *cc_counted_by(nsigs) msgs,
+                           const ccec25519signature *cc_counted_by(nsigs) sigs,
+                           const ccec25519pubkey *cc_counted_by(nsigs) pks,
+                           int *cc_counted_by(nsigs) results)
+{
+    CC_ENSURE_DIT_ENABLED
+
+    ccec_const_cp_t cp = ccec_cp_ed25519();
+    return cced25519_verify_batch_internal(cp, di, rng, nsigs, msg_nbytes, msgs, sigs, pks, results);
+}
@@ -109,4 +109,80 @@ void cckeccak_absorb_and_pad(cckeccak_state_t state,
 ///          i.e., must be one of 168, 144, 136, 104, or 72.
 void cckeccak_squeeze(cckeccak_state_t state, size_t rate, size_t out_nbytes, uint8_t *cc_sized_by(out_nbytes) out, cckeccak_permutation permutation);
 
+/*
+ * The following API runs four independent Keccak[c] instances in parallel, for
+ * callers that need several unrelated sponges with same-length inputs, such as
+ * Kyber expanding its matrix. The four states are interleaved such that SIMD
+ * implementations of the permutation can operate on all of them at once.
+ *
+ * The functions follow the single-state API above, except that
+ * `cckeccak_squeeze_x4` may be called multiple times as long as every call but
+ * the last one squeezes a multiple of `rate` bytes.
+ */
+
+#define CCKECCAK_X4_NSTATES 4
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) && !CC_KERNEL
+#define CCKECCAK_AVX2 1
+#else
+#define CCKECCAK_AVX2 0
+#endif
+
+// Four Keccak[c] states. Lane i of the j-th state is stored at lanes[4 * i + j].
+struct cckeccak_state_x4 {
+    uint64_t lanes[CCKECCAK_STATE_NUINT64 * CCKECCAK_X4_NSTATES];
+} CC_ALIGNED(32);
+typedef struct cckeccak_state_x4 *cckeccak_state_x4_t;
+
+typedef void (* cckeccak_permutation_x4)(cckeccak_state_x4_t state);
+
+/// @function cckeccak_f1600_x4_serial
+/// @abstract Apply a single-state Keccak-f[1600] permutation to each of the four states, one after the other.
+/// @param state         A pointer to four Keccak states.
+/// @param permutation   The single-state permutation.
+void cckeccak_f1600_x4_serial(cckeccak_state_x4_t state, cckeccak_permutation permutation);
+
+// C-implementation of the Keccak-f[1600] permutation, applied to four states
+void cckeccak_f1600_x4_c(cckeccak_state_x4_t state);
+
+#if CCKECCAK_AVX2
+// AVX2-implementation of the Keccak-f[1600] permutation, applied to four states. Requires CC_HAS_AVX2().
+void cckeccak_f1600_x4_avx2(cckeccak_state_x4_t state);
+#endif
+
+/// @function cckeccak_init_state_x4
+/// @abstract Initialize four states for Keccak[c].
+/// @param state a pointer to the Keccak states.
+void cckeccak_init_state_x4(cckeccak_state_x4_t state);
+
+/// @function cckeccak_absorb_and_pad_x4
+/// @abstract Absorb four byte-aligned messages of the same length into four Keccak[c] states, padded using the padding_lsb byte.
+/// @param state         A pointer to four initialized Keccak states.
+/// @param rate          The rate of Keccak[c] in bytes, i.e., rate = (1600 - c)/8.
+/// @param m_nbytes      The number of bytes of each message to absorb.
+/// @param m             Pointers to the four messages that contain `m_nbytes` bytes each.
+/// @param padding_lsb   The padding to use.
+///
+/// @warning Same restrictions on `rate` and `padding_lsb` as for `cckeccak_absorb_and_pad`.
+void cckeccak_absorb_and_pad_x4(cckeccak_state_x4_t state,
+                                size_t rate,
+                                size_t m_nbytes,
+                                const uint8_t *const m[CCKECCAK_X4_NSTATES],
+                                uint8_t padding_lsb,
+                                cckeccak_permutation_x4 permutation);
+
+/// @function cckeccak_squeeze_x4
+/// @abstract Squeeze `out_nbytes` out of each of four Keccak[c] states.
+/// @param state         A pointer to four Keccak states in which padded messages have been absorbed.
+/// @param rate          The rate of Keccak[c] in bytes, i.e., rate = (1600 - c)/8.
+/// @param out_nbytes    The number of bytes to squeeze out of each state.
+/// @param out           Pointers to the four output buffers.
+///
+/// @warning Same restrictions on `rate` as for `cckeccak_squeeze`.
+void cckeccak_squeeze_x4(cckeccak_state_x4_t state,
+                         size_t rate,
+                         size_t out_nbytes,
+                         uint8_t *const out[CCKECCAK_X4_NSTATES],
+                         cckeccak_permutation_x4 permutation);
+
 #endif /* _CORECRYPTO_CCKECCAK_INTERNAL_H_ */
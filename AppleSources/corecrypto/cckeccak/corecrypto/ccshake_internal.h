@@ -58,4 +58,37 @@ void ccshake256(size_t in_nbytes,
 /// @param state The XOF state.
 void ccshake_init(const struct ccxof_info *xi, ccxof_state_t state);
 
+/// @function ccshake128_x4_absorb
+/// @abstract Initializes four SHAKE128 instances and absorbs one input of `in_nbytes` bytes into each
+/// @param state The four Keccak states
+/// @param in_nbytes The byte length of each of the input buffers `in`
+/// @param in The four input buffers
+CC_NONNULL_ALL
+void ccshake128_x4_absorb(cckeccak_state_x4_t state,
+                          size_t in_nbytes,
+                          const uint8_t *const in[CCKECCAK_X4_NSTATES]);
+
+/// @function ccshake128_x4_squeeze
+/// @abstract Squeezes `out_nbytes` bytes out of each of four SHAKE128 instances
+/// @param state The four Keccak states, initialized by `ccshake128_x4_absorb`
+/// @param out_nbytes The byte length of each of the output buffers `out`
+/// @param out The four output buffers
+/// @discussion Can be called multiple times, as long as all calls but the last squeeze a multiple of `CCSHAKE128_RATE` bytes.
+CC_NONNULL_ALL
+void ccshake128_x4_squeeze(cckeccak_state_x4_t state,
+                           size_t out_nbytes,
+                           uint8_t *const out[CCKECCAK_X4_NSTATES]);
+
+/// @function ccshake256_x4
+/// @abstract Perform four `shake256` operations on four input buffers of the same length
+/// @param in_nbytes The byte length of each of the input buffers `in`
+/// @param in The four input buffers
+/// @param out_nbytes The byte length of each of the output buffers `out`
+/// @param out The four output buffers
+CC_NONNULL_ALL
+void ccshake256_x4(size_t in_nbytes,
+                   const uint8_t *const in[CCKECCAK_X4_NSTATES],
+                   size_t out_nbytes,
+                   uint8_t *const out[CCKECCAK_X4_NSTATES]);
+
 #endif /* _CORECRYPTO_CCSHAKE_INTERNAL_H_ */
@@ -51,6 +51,24 @@ cckeccak_permutation permutations[] = {
 #endif
 };
 
+#if CCKECCAK_AVX2
+static void cckeccak_f1600_x4_avx2_wrapper(cckeccak_state_x4_t state)
+{
+    if (CC_HAS_AVX2()) {
+        cckeccak_f1600_x4_avx2(state);
+    } else {
+        cckeccak_f1600_x4_c(state);
+    }
+}
+#endif
+
+cckeccak_permutation_x4 permutations_x4[] = {
+    cckeccak_f1600_x4_c,
+#if CCKECCAK_AVX2
+    cckeccak_f1600_x4_avx2_wrapper,
+#endif
+};
+
 // Test vectors from the `KeccakSpongeIntermediateValues_*.txt` files, available in the archives of https://keccak.team/ .
 struct keccak_kat {
     size_t rate;
@@ -115,6 +133,32 @@ static void test_keccak(const struct keccak_kat *kat, cckeccak_permutation permu
     free(out);
 }
 
+static void test_keccak_x4(const struct keccak_kat *kat, cckeccak_permutation_x4 permutation)
+{
+    struct cckeccak_state_x4 state;
+    cckeccak_init_state_x4(&state);
+
+    byteBuffer m_buf = hexStringToBytes(kat->m);
+    byteBuffer out_buf = hexStringToBytes(kat->out);
+
+    uint8_t *out = (uint8_t *)cc_malloc_clear(CCKECCAK_X4_NSTATES * kat->out_nbytes);
+    const uint8_t *const m[CCKECCAK_X4_NSTATES] = { m_buf->bytes, m_buf->bytes, m_buf->bytes, m_buf->bytes };
+    uint8_t *const outs[CCKECCAK_X4_NSTATES] = {
+        out, out + kat->out_nbytes, out + 2 * kat->out_nbytes, out + 3 * kat->out_nbytes
+    };
+
+    cckeccak_absorb_and_pad_x4(&state, kat->rate, kat->m_nbytes, m, kat->padding_lsb, permutation);
+    cckeccak_squeeze_x4(&state, kat->rate, kat->out_nbytes, outs, permutation);
+
+    int rv = 0;
+    for (unsigned j = 0; j < CCKECCAK_X4_NSTATES; j++) {
+        rv |= memcmp(outs[j], out_buf->bytes, kat->out_nbytes);
+    }
+    is(rv, 0, "Output of the x4 permutation does not match");
+
+    free(out);
+}
+
 static void test_absorb_pad_different_length(cckeccak_permutation permutation)
 {
     // Absorb messages of different length: multiple of `rate`, `rate - 1` and `rate - sizeof(uint64_t)`
@@ -221,7 +265,8 @@ int cckeccak_tests(TM_UNUSED int argc, TM_UNUSED char *const *argv)
     ntests += 3;                                               // test_absorb_pad_different_length
     ntests += 5 * 2;                                           // test_all_fips202_rates
     ntests += 3 * 2;                                           // test_all_paddings
-    plan_tests((int) (npermutations * (size_t)ntests));
+    size_t npermutations_x4 = CC_ARRAY_LEN(permutations_x4);
+    plan_tests((int) (npermutations * (size_t)ntests + npermutations_x4 * (size_t)nkeccak_kats));
 
     for (size_t i = 0; i < npermutations; i++)
     {
@@ -232,5 +277,11 @@ int cckeccak_tests(TM_UNUSED int argc, TM_UNUSED char *const *argv)
         test_all_fips202_rates(permutations[i]);
         test_all_paddings(permutations[i]);
     }
+
+    for (size_t i = 0; i < npermutations_x4; i++) {
+        for (int j = 0; j < nkeccak_kats; j++) {
+            test_keccak_x4(&keccak_kats[j], permutations_x4[i]);
+        }
+    }
     return 0;
 }
@@ -99,11 +99,66 @@ static void test_shake(void)
     ok_memcmp(out + 480, SHAKE256_1600_BIT, sizeof(SHAKE256_1600_BIT), "SHAKE256, 1600-bit message failed");
 }
 
+// Input lengths for the multi-stream tests: empty, Kyber's matrix seeds,
+// and around block boundaries.
+static const size_t shake_x4_nbytes[] = { 0, 33, 34, 135, 136, 137, 167, 168, 169, 400 };
+
+static void test_shake_x4(void)
+{
+    uint8_t in[CCKECCAK_X4_NSTATES][400];
+    uint8_t out[CCKECCAK_X4_NSTATES][3 * CCSHAKE128_RATE + 100];
+    uint8_t expected[sizeof(out[0])];
+
+    const uint8_t *const inp[CCKECCAK_X4_NSTATES] = { in[0], in[1], in[2], in[3] };
+    uint8_t *const outp[CCKECCAK_X4_NSTATES] = { out[0], out[1], out[2], out[3] };
+
+    for (unsigned j = 0; j < CCKECCAK_X4_NSTATES; j++) {
+        for (size_t i = 0; i < sizeof(in[j]); i++) {
+            in[j][i] = (uint8_t)(i * 7 + j);
+        }
+    }
+
+    for (size_t k = 0; k < CC_ARRAY_LEN(shake_x4_nbytes); k++) {
+        size_t nbytes = shake_x4_nbytes[k];
+        int rv = 0;
+
+        // Squeeze three full blocks, then some more.
+        struct cckeccak_state_x4 state;
+        ccshake128_x4_absorb(&state, nbytes, inp);
+        ccshake128_x4_squeeze(&state, 3 * CCSHAKE128_RATE, outp);
+
+        uint8_t *const tailp[CCKECCAK_X4_NSTATES] = {
+            out[0] + 3 * CCSHAKE128_RATE, out[1] + 3 * CCSHAKE128_RATE,
+            out[2] + 3 * CCSHAKE128_RATE, out[3] + 3 * CCSHAKE128_RATE
+        };
+        ccshake128_x4_squeeze(&state, sizeof(out[0]) - 3 * CCSHAKE128_RATE, tailp);
+
+        for (unsigned j = 0; j < CCKECCAK_X4_NSTATES; j++) {
+            ccshake128(nbytes, in[j], sizeof(expected), expected);
+            rv |= memcmp(out[j], expected, sizeof(expected));
+        }
+        is(rv, 0, "SHAKE128 x4, %zu-byte messages failed", nbytes);
+
+        rv = 0;
+        ccshake256_x4(nbytes, inp, sizeof(out[0]), outp);
+
+        for (unsigned j = 0; j < CCKECCAK_X4_NSTATES; j++) {
+            ccshake256(nbytes, in[j], sizeof(expected), expected);
+            rv |= memcmp(out[j], expected, sizeof(expected));
+        }
+        is(rv, 0, "SHAKE256 x4, %zu-byte messages failed", nbytes);
+    }
+}
+
 int ccshake_tests(TM_UNUSED int argc, TM_UNUSED char *const *argv)
 {
-    plan_tests(6);
+    int ntests = 0;
+    ntests += 6;                                      // test_shake
+    ntests += 2 * CC_ARRAY_LEN(shake_x4_nbytes);      // test_shake_x4
+    plan_tests(ntests);
 
     test_shake();
+    test_shake_x4();
 
     return 0;
 }
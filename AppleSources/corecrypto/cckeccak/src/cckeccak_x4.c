@@ -0,0 +1,127 @@
+/* Copyright (c) (2023) Apple Inc. All rights reserved.
+ *
+ * corecrypto is licensed under Apple Inc.’s Internal Use License Agreement (which
+ * is contained in the License.txt file distributed with corecrypto) and only to
+ * people who accept that license. IMPORTANT:  Any license rights granted to you by
+ * Apple Inc. (if any) are limited to internal use within your organization only on
+ * devices and computers you own or control, for the sole purpose of verifying the
+ * security characteristics and correct functioning of the Apple Software.  You may
+ * not, directly or indirectly, redistribute the Apple Software or any portions thereof.
+ */
+
+#include "cckeccak_internal.h"
+#include "cc_internal.h"
+
+void cckeccak_f1600_x4_serial(cckeccak_state_x4_t state, cckeccak_permutation permutation)
+{
+    struct cckeccak_state tmp;
+
+    for (unsigned j = 0; j < CCKECCAK_X4_NSTATES; j++) {
+        for (unsigned i = 0; i < CCKECCAK_STATE_NUINT64; i++) {
+            tmp.lanes[i] = state->lanes[CCKECCAK_X4_NSTATES * i + j];
+        }
+
+        permutation(&tmp);
+
+        for (unsigned i = 0; i < CCKECCAK_STATE_NUINT64; i++) {
+            state->lanes[CCKECCAK_X4_NSTATES * i + j] = tmp.lanes[i];
+        }
+    }
+
+    cc_clear(sizeof(tmp), &tmp);
+}
+
+void cckeccak_f1600_x4_c(cckeccak_state_x4_t state)
+{
+    cckeccak_f1600_x4_serial(state, cckeccak_f1600_c);
+}
+
+void cckeccak_init_state_x4(cckeccak_state_x4_t state)
+{
+    cc_clear(sizeof(state->lanes), state->lanes);
+}
+
+// Absorb the messages, and add padding (FIPS-202 Sec. 4 steps #1 and #6, and Sec 5.1/6.1/6.2).
+void cckeccak_absorb_and_pad_x4(cckeccak_state_x4_t state,
+                                const size_t rate,
+                                const size_t m_nbytes,
+                                const uint8_t *const m[CCKECCAK_X4_NSTATES],
+                                const uint8_t padding_lsb,
+                                cckeccak_permutation_x4 permutation)
+{
+    cc_assert(rate < CCKECCAK_STATE_NBYTES && (rate % sizeof(uint64_t)) == 0);
+
+    uint64_t *lanes = state->lanes;
+    size_t offset = 0;
+
+    // Absorb all the blocks first.
+    for (; m_nbytes - offset >= rate; offset += rate) {
+        for (size_t i = 0; i < rate / sizeof(uint64_t); i++) {
+            for (unsigned j = 0; j < CCKECCAK_X4_NSTATES; j++) {
+                lanes[CCKECCAK_X4_NSTATES * i + j] ^= cc_load64_le(m[j] + offset + sizeof(uint64_t) * i);
+            }
+        }
+        permutation(state);
+    }
+
+    // Absorb the rest of the messages by words of 64 bits.
+    const size_t remaining_nbytes = m_nbytes - offset;
+
+    size_t i;
+    for (i = 0; i < remaining_nbytes / sizeof(uint64_t); i++) {
+        for (unsigned j = 0; j < CCKECCAK_X4_NSTATES; j++) {
+            lanes[CCKECCAK_X4_NSTATES * i + j] ^= cc_load64_le(m[j] + offset + sizeof(uint64_t) * i);
+        }
+    }
+
+    // Absorb the last bytes, if any.
+    if (remaining_nbytes & 0x07) {
+        for (unsigned j = 0; j < CCKECCAK_X4_NSTATES; j++) {
+            uint8_t tmp[sizeof(uint64_t)] = { 0 };
+            cc_memcpy(tmp, m[j] + offset + sizeof(uint64_t) * i, (remaining_nbytes & 0x07));
+            lanes[CCKECCAK_X4_NSTATES * i + j] ^= cc_load64_le(tmp);
+            cc_clear(sizeof(tmp), tmp);
+        }
+    }
+
+    // Add padding, as per FIPS-202 Sec 5.1/6.1/6.2.
+    for (unsigned j = 0; j < CCKECCAK_X4_NSTATES; j++) {
+        lanes[CCKECCAK_X4_NSTATES * (remaining_nbytes >> 3) + j] ^= (uint64_t)padding_lsb << (8 * (remaining_nbytes & 0x07));
+        lanes[CCKECCAK_X4_NSTATES * ((rate - 1) >> 3) + j] ^= (uint64_t)128 << (8 * ((rate - 1) & 0x07));
+    }
+}
+
+// Squeeze to produce the output (FIPS-202 Sec. 4 steps #7-10).
+void cckeccak_squeeze_x4(cckeccak_state_x4_t state,
+                         const size_t rate,
+                         const size_t out_nbytes,
+                         uint8_t *const out[CCKECCAK_X4_NSTATES],
+                         cckeccak_permutation_x4 permutation)
+{
+    cc_assert(rate < CCKECCAK_STATE_NBYTES && (rate % sizeof(uint64_t)) == 0);
+
+    const uint64_t *lanes = state->lanes;
+
+    for (size_t offset = 0; offset < out_nbytes; offset += rate) {
+        size_t nbytes = CC_MIN(rate, out_nbytes - offset);
+        permutation(state);
+
+        // Extract as many 64-bit words as possible.
+        size_t i;
+        for (i = 0; i < nbytes / sizeof(uint64_t); i++) {
+            for (unsigned j = 0; j < CCKECCAK_X4_NSTATES; j++) {
+                cc_store64_le(lanes[CCKECCAK_X4_NSTATES * i + j], out[j] + offset + sizeof(uint64_t) * i);
+            }
+        }
+
+        // Extract the remaining < sizeof(uint64_t) bytes, if any.
+        if (nbytes & 0x07) {
+            for (unsigned j = 0; j < CCKECCAK_X4_NSTATES; j++) {
+                uint8_t tmp[sizeof(uint64_t)];
+                cc_store64_le(lanes[CCKECCAK_X4_NSTATES * i + j], tmp);
+                cc_memcpy(out[j] + offset + sizeof(uint64_t) * i, tmp, (nbytes & 0x07));
+                cc_clear(sizeof(tmp), tmp);
+            }
+        }
+    }
+}
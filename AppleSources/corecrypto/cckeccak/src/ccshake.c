@@ -11,6 +11,7 @@
 
 #include "ccshake_internal.h"
 #include "ccxof_internal.h"
+#include "AccelerateCrypto.h"
 
 void ccshake_init(const struct ccxof_info *xi, ccxof_state_t state)
 {
@@ -38,3 +39,69 @@ void ccshake256(size_t in_nbytes, const uint8_t *in, size_t out_nbytes, uint8_t
     ccxof_squeeze(xi, ctx, out_nbytes, out);
     ccshake256_ctx_clear(ctx);
 }
+
+#if (defined(__arm64__) && CCSHA3_VNG_ARM) || (defined(__x86_64__) && CCSHA3_VNG_INTEL)
+static void ccshake_vng_f1600_x4(cckeccak_state_x4_t state)
+{
+    cckeccak_f1600_x4_serial(state, (cckeccak_permutation)AccelerateCrypto_SHA3_keccak);
+}
+#endif
+
+#if defined(__arm64__) && CCSHA3_VNG_ARM
+static void ccshake_vng_arm64_hwassist_f1600_x4(cckeccak_state_x4_t state)
+{
+    cckeccak_f1600_x4_serial(state, (cckeccak_permutation)AccelerateCrypto_SHA3_keccak_hwassist);
+}
+#endif
+
+// Without a SIMD implementation, fall back to the same single-state
+// permutation that ccshake128_xi() and ccshake256_xi() would pick.
+static cckeccak_permutation_x4 ccshake_f1600_x4(void)
+{
+#if CCKECCAK_AVX2
+    if (CC_HAS_AVX2()) {
+        return cckeccak_f1600_x4_avx2;
+    }
+#endif
+
+#if defined(__arm64__) && CCSHA3_VNG_ARM
+    if (CC_HAS_SHA3()) {
+        return ccshake_vng_arm64_hwassist_f1600_x4;
+    }
+
+    return ccshake_vng_f1600_x4;
+#else
+ #if defined(__x86_64__) && CCSHA3_VNG_INTEL
+    if (CC_HAS_BMI2()) {
+        return ccshake_vng_f1600_x4;
+    }
+ #endif
+
+    return cckeccak_f1600_x4_c;
+#endif
+}
+
+void ccshake128_x4_absorb(cckeccak_state_x4_t state, size_t in_nbytes, const uint8_t *const in[CCKECCAK_X4_NSTATES])
+{
+    cckeccak_init_state_x4(state);
+    cckeccak_absorb_and_pad_x4(state, CCSHAKE128_RATE, in_nbytes, in, 0x1f, ccshake_f1600_x4());
+}
+
+void ccshake128_x4_squeeze(cckeccak_state_x4_t state, size_t out_nbytes, uint8_t *const out[CCKECCAK_X4_NSTATES])
+{
+    cckeccak_squeeze_x4(state, CCSHAKE128_RATE, out_nbytes, out, ccshake_f1600_x4());
+}
+
+void ccshake256_x4(size_t in_nbytes,
+                   const uint8_t *const in[CCKECCAK_X4_NSTATES],
+                   size_t out_nbytes,
+                   uint8_t *const out[CCKECCAK_X4_NSTATES])
+{
+    cckeccak_permutation_x4 permutation = ccshake_f1600_x4();
+    struct cckeccak_state_x4 state;
+
+    cckeccak_init_state_x4(&state);
+    cckeccak_absorb_and_pad_x4(&state, CCSHAKE256_RATE, in_nbytes, in, 0x1f, permutation);
+    cckeccak_squeeze_x4(&state, CCSHAKE256_RATE, out_nbytes, out, permutation);
+    cc_clear(sizeof(state), &state);
+}
@@ -0,0 +1,170 @@
+/* Copyright (c) (2023) Apple Inc. All rights reserved.
+ *
+ * corecrypto is licensed under Apple Inc.’s Internal Use License Agreement (which
+ * is contained in the License.txt file distributed with corecrypto) and only to
+ * people who accept that license. IMPORTANT:  Any license rights granted to you by
+ * Apple Inc. (if any) are limited to internal use within your organization only on
+ * devices and computers you own or control, for the sole purpose of verifying the
+ * security characteristics and correct functioning of the Apple Software.  You may
+ * not, directly or indirectly, redistribute the Apple Software or any portions thereof.
+ */
+
+#include "cckeccak_internal.h"
+#include "cc_internal.h"
+
+#if CCKECCAK_AVX2
+
+#include <immintrin.h>
+
+#define CCKECCAK_AVX2_TARGET __attribute__((target("avx2")))
+
+#define CCKECCAK_F1600_NROUNDS 24
+
+// Rotate each of the four 64-bit lanes left by n bits.
+CCKECCAK_AVX2_TARGET
+static inline __m256i cckeccak_avx2_rol(__m256i x, int n)
+{
+    return _mm256_or_si256(_mm256_slli_epi64(x, n), _mm256_srli_epi64(x, 64 - n));
+}
+
+// Rotations by multiples of 8 bits are byte shuffles.
+CCKECCAK_AVX2_TARGET
+static inline __m256i cckeccak_avx2_rol8(__m256i x)
+{
+    const __m256i idx = _mm256_setr_epi8(7, 0, 1, 2, 3, 4, 5, 6, 15, 8, 9, 10, 11, 12, 13, 14,
+                                         7, 0, 1, 2, 3, 4, 5, 6, 15, 8, 9, 10, 11, 12, 13, 14);
+    return _mm256_shuffle_epi8(x, idx);
+}
+
+CCKECCAK_AVX2_TARGET
+static inline __m256i cckeccak_avx2_rol56(__m256i x)
+{
+    const __m256i idx = _mm256_setr_epi8(1, 2, 3, 4, 5, 6, 7, 0, 9, 10, 11, 12, 13, 14, 15, 8,
+                                         1, 2, 3, 4, 5, 6, 7, 0, 9, 10, 11, 12, 13, 14, 15, 8);
+    return _mm256_shuffle_epi8(x, idx);
+}
+
+// ~a & b
+#define ANDN(a, b) _mm256_andnot_si256(a, b)
+#define XOR(a, b) _mm256_xor_si256(a, b)
+
+/*
+ One round of Keccak-f[1600] on four states, see cckeccak_f1600_round(). Each
+ of the 25 vectors holds the same lane of all four states.
+ */
+CCKECCAK_AVX2_TARGET
+static inline void cckeccak_avx2_round(__m256i s[CCKECCAK_STATE_NUINT64], __m256i rc)
+{
+    __m256i t0, t1, t2, t3, t4, tmp;
+
+    // Function theta, as per FIPS-202 3.2.1.
+    t0 = XOR(XOR(XOR(s[0], s[5]), XOR(s[10], s[15])), s[20]);
+    t1 = XOR(XOR(XOR(s[1], s[6]), XOR(s[11], s[16])), s[21]);
+    t2 = XOR(XOR(XOR(s[2], s[7]), XOR(s[12], s[17])), s[22]);
+    t3 = XOR(XOR(XOR(s[3], s[8]), XOR(s[13], s[18])), s[23]);
+    t4 = XOR(XOR(XOR(s[4], s[9]), XOR(s[14], s[19])), s[24]);
+
+    tmp = XOR(t4, cckeccak_avx2_rol(t1, 1));
+    s[0] = XOR(s[0], tmp);
+    s[5] = XOR(s[5], tmp);
+    s[10] = XOR(s[10], tmp);
+    s[15] = XOR(s[15], tmp);
+    s[20] = XOR(s[20], tmp);
+    tmp = XOR(t0, cckeccak_avx2_rol(t2, 1));
+    s[1] = XOR(s[1], tmp);
+    s[6] = XOR(s[6], tmp);
+    s[11] = XOR(s[11], tmp);
+    s[16] = XOR(s[16], tmp);
+    s[21] = XOR(s[21], tmp);
+    tmp = XOR(t1, cckeccak_avx2_rol(t3, 1));
+    s[2] = XOR(s[2], tmp);
+    s[7] = XOR(s[7], tmp);
+    s[12] = XOR(s[12], tmp);
+    s[17] = XOR(s[17], tmp);
+    s[22] = XOR(s[22], tmp);
+    tmp = XOR(t2, cckeccak_avx2_rol(t4, 1));
+    s[3] = XOR(s[3], tmp);
+    s[8] = XOR(s[8], tmp);
+    s[13] = XOR(s[13], tmp);
+    s[18] = XOR(s[18], tmp);
+    s[23] = XOR(s[23], tmp);
+    tmp = XOR(t3, cckeccak_avx2_rol(t0, 1));
+    s[4] = XOR(s[4], tmp);
+    s[9] = XOR(s[9], tmp);
+    s[14] = XOR(s[14], tmp);
+    s[19] = XOR(s[19], tmp);
+    s[24] = XOR(s[24], tmp);
+
+    // Function rho & pi, as per FIPS-202 3.2.2 & 3.2.3
+    tmp = cckeccak_avx2_rol(s[1], 1);
+    s[1] = cckeccak_avx2_rol(s[6], 44);
+    s[6] = cckeccak_avx2_rol(s[9], 20);
+    s[9] = cckeccak_avx2_rol(s[22], 61);
+    s[22] = cckeccak_avx2_rol(s[14], 39);
+    s[14] = cckeccak_avx2_rol(s[20], 18);
+    s[20] = cckeccak_avx2_rol(s[2], 62);
+    s[2] = cckeccak_avx2_rol(s[12], 43);
+    s[12] = cckeccak_avx2_rol(s[13], 25);
+    s[13] = cckeccak_avx2_rol8(s[19]);
+    s[19] = cckeccak_avx2_rol56(s[23]);
+    s[23] = cckeccak_avx2_rol(s[15], 41);
+    s[15] = cckeccak_avx2_rol(s[4], 27);
+    s[4] = cckeccak_avx2_rol(s[24], 14);
+    s[24] = cckeccak_avx2_rol(s[21], 2);
+    s[21] = cckeccak_avx2_rol(s[8], 55);
+    s[8] = cckeccak_avx2_rol(s[16], 45);
+    s[16] = cckeccak_avx2_rol(s[5], 36);
+    s[5] = cckeccak_avx2_rol(s[3], 28);
+    s[3] = cckeccak_avx2_rol(s[18], 21);
+    s[18] = cckeccak_avx2_rol(s[17], 15);
+    s[17] = cckeccak_avx2_rol(s[11], 10);
+    s[11] = cckeccak_avx2_rol(s[7], 6);
+    s[7] = cckeccak_avx2_rol(s[10], 3);
+    s[10] = tmp;
+
+    // Function chi, as per FIPS-202 3.2.4
+    for (unsigned y = 0; y < 25; y += 5) {
+        t0 = ANDN(s[y + 4], s[y + 0]);
+        t1 = ANDN(s[y + 0], s[y + 1]);
+        s[y + 0] = XOR(s[y + 0], ANDN(s[y + 1], s[y + 2]));
+        s[y + 1] = XOR(s[y + 1], ANDN(s[y + 2], s[y + 3]));
+        s[y + 2] = XOR(s[y + 2], ANDN(s[y + 3], s[y + 4]));
+        s[y + 3] = XOR(s[y + 3], t0);
+        s[y + 4] = XOR(s[y + 4], t1);
+    }
+
+    // Function iota, as per FIPS-202 3.2.5
+    s[0] = XOR(s[0], rc);
+}
+
+#undef ANDN
+#undef XOR
+
+CCKECCAK_AVX2_TARGET
+void cckeccak_f1600_x4_avx2(cckeccak_state_x4_t state)
+{
+    // Round constants for Keccak (FIPS-202, Sec. 3.2.5).
+    static const uint64_t keccak_round_constants[CCKECCAK_F1600_NROUNDS] = {
+        0x0000000000000001, 0x0000000000008082, 0x800000000000808a, 0x8000000080008000, 0x000000000000808b, 0x0000000080000001,
+        0x8000000080008081, 0x8000000000008009, 0x000000000000008a, 0x0000000000000088, 0x0000000080008009, 0x000000008000000a,
+        0x000000008000808b, 0x800000000000008b, 0x8000000000008089, 0x8000000000008003, 0x8000000000008002, 0x8000000000000080,
+        0x000000000000800a, 0x800000008000000a, 0x8000000080008081, 0x8000000000008080, 0x0000000080000001, 0x8000000080008008,
+    };
+
+    __m256i *p = (__m256i *)state->lanes;
+    __m256i s[CCKECCAK_STATE_NUINT64];
+
+    for (unsigned i = 0; i < CCKECCAK_STATE_NUINT64; i++) {
+        s[i] = _mm256_load_si256(&p[i]);
+    }
+
+    for (unsigned ell = 0; ell < CCKECCAK_F1600_NROUNDS; ell++) {
+        cckeccak_avx2_round(s, _mm256_set1_epi64x((long long)keccak_round_constants[ell]));
+    }
+
+    for (unsigned i = 0; i < CCKECCAK_STATE_NUINT64; i++) {
+        _mm256_store_si256(&p[i], s[i]);
+    }
+}
+
+#endif // CCKECCAK_AVX2
@@ -72,6 +72,14 @@
 // This PRNG supports reseeds concurrent with output generation,
 // i.e. it is safe to call cckprng_reseed or cckprng_refresh while
 // another thread is calling cckprng_generate.
+//
+// Each output generator has its own DRBG and output cache, seeded
+// from the central generator (itself fed by Fortuna). A generator
+// reseeds from the central generator whenever the latter reseeds
+// (i.e. on user reseeds and on Fortuna reseeds) and in any case after
+// at most CCKPRNG_GEN_RESEED_INTERVAL requests. Only the first
+// CCKPRNG_MAX_NGENS generators have dedicated state; requests on
+// other generators are served by the central generator.
 
 #define CCKPRNG_SEED_NBYTES 32
 
@@ -92,6 +100,31 @@ typedef ccrng_fortuna_getentropy cckprng_getentropy;
 #define CCKPRNG_CACHED_BUF_SIZE ((size_t)256)
 #define CCKPRNG_MAX_REQUEST_SIZE ((size_t)4096)
 
+#define CCKPRNG_MAX_NGENS 32
+#define CCKPRNG_GEN_DRBG_STATE_MAX_SIZE ((size_t)160)
+#define CCKPRNG_GEN_RESEED_INTERVAL 1024
+
+struct cckprng_gen_ctx {
+    // Set every time the central generator reseeds
+    ccrng_schedule_atomic_flag_ctx_t rekey_schedule_ctx;
+
+    // Bounds the number of requests between two reseeds
+    ccrng_schedule_counter_ctx_t counter_schedule_ctx;
+
+    ccrng_schedule_tree_ctx_t schedule_ctx;
+
+    cc_lock_ctx_t lock_ctx;
+
+    uint8_t drbg_state[CCKPRNG_GEN_DRBG_STATE_MAX_SIZE];
+
+    uint8_t cache[CCKPRNG_CACHED_BUF_SIZE];
+
+    ccrng_crypto_ctx_t rng_ctx;
+
+    // Set once the generator is initialized by cckprng_initgen
+    _Atomic bool ready;
+};
+
 struct cckprng_ctx {
     // A flag set every time Fortuna reseeds itself
     ccrng_schedule_atomic_flag_ctx_t schedule_ctx;
@@ -118,6 +151,9 @@ struct cckprng_ctx {
 
     cc_lock_ctx_t lock_ctx;
 
+    // Referenced by drbg_info, which output generators instantiate
+    // after cckprng_init returns
+    struct ccdrbg_nistctr_custom drbg_custom;
     struct ccdrbg_info drbg_info;
     uint8_t drbg_state[CCKPRNG_DRBG_STATE_MAX_SIZE];
 
@@ -128,6 +164,13 @@ struct cckprng_ctx {
     ccrng_crypto_ctx_t rng_ctx;
 
     struct ccrng_fortuna_ctx fortuna_ctx;
+
+    unsigned max_ngens;
+
+    // Seeds the output generators from rng_ctx
+    ccentropy_rng_ctx_t gen_entropy_ctx;
+
+    struct cckprng_gen_ctx gens[CCKPRNG_MAX_NGENS];
 };
 
 // This collection of function pointers is just a convenience for
@@ -23,6 +23,8 @@ extern uint64_t (*cckprng_reseed_get_nonce_mock)(void);
  Internal Fortuna
  */
 
+// Make every output generator reseed from the central generator
+// before its next request.
 void cckprng_rekeygens(struct cckprng_ctx *ctx);
 
 #define CCKPRNG_LABEL(op) { 0x78, 0x6e, 0x75, 0x70, 0x72, 0x6e, 0x67, op }
@@ -33,6 +35,7 @@ enum CCKPRNG_OP {
     CCKPRNG_OP_SCHEDRESEED = 2,
     CCKPRNG_OP_ADDENTROPY = 3,
     CCKPRNG_OP_INIT_RNG = 4,
+    CCKPRNG_OP_INITGEN = 5,
 };
 
 #define CCKPRNG_REFRESH_MIN_NSAMPLES 32
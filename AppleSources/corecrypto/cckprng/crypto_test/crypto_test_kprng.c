@@ -18,6 +18,7 @@
 #include <corecrypto/cckprng.h>
 #include <corecrypto/ccrng_schedule.h>
 #include "cckprng_internal.h"
+#include "ccdrbg_internal.h"
 #include <corecrypto/ccaes.h>
 #include "testbyteBuffer.h"
 #include "cc_priv.h"
@@ -28,6 +29,15 @@
 #define CC_PRNG_SEEDTESTS 1
 #endif
 
+// The KAT vectors are generated by ccrng/tools/cckprng_gentest.sh
+#define CC_PRNG_KATTESTS 0
+#if defined(__has_include)
+#if __has_include("cckprng_kat.inc")
+#undef CC_PRNG_KATTESTS
+#define CC_PRNG_KATTESTS 1
+#endif
+#endif
+
 #include "ccshadow.h"
 
 #if CC_PRNG_SEEDTESTS
@@ -356,6 +366,8 @@ static int cckprng_test_storeseed(void)
 
 #endif /* CC_PRNG_SEEDTESTS */
 
+#if CC_PRNG_KATTESTS
+
 /*
  
  Test Structures
@@ -574,6 +586,90 @@ static int cckprng_test_runner(void) {
     return 0;
 }
 
+#endif /* CC_PRNG_KATTESTS */
+
+static int32_t cckprng_gens_get_entropy(size_t *nbytes, void *entropy, void *arg)
+{
+    (void)arg;
+    memset(entropy, 0x5a, *nbytes);
+    return 2048;
+}
+
+// Returns the number of requests served by a CTR-DRBG since it was last (re)seeded, plus one
+static uint64_t cckprng_test_drbg_reseed_counter(const uint8_t *drbg_state)
+{
+    struct ccdrbg_nistctr_state drbg;
+    memcpy(&drbg, drbg_state, sizeof(drbg));
+    return drbg.reseed_counter;
+}
+
+static void cckprng_test_gens(void)
+{
+    static struct cckprng_ctx ctx;
+    uint8_t seed[64] = { 0 };
+    uint8_t nonce[32] = { 0 };
+    uint8_t rand0[64], rand1[64], rand_central[64];
+    uint64_t central_counter;
+
+    diag("Start KPRNG generator tests");
+
+    cckprng_init_with_getentropy(&ctx, CCKPRNG_MAX_NGENS + 1, sizeof(seed), seed, sizeof(nonce), nonce, cckprng_gens_get_entropy, NULL);
+    is(ctx.max_ngens, CCKPRNG_MAX_NGENS + 1, "cckprng_init_with_getentropy max_ngens");
+
+    // Generators not initialized yet are served by the central generator.
+    ok(!ctx.gens[0].ready, "generator 0 not ready");
+    cckprng_generate(&ctx, 0, sizeof(rand_central), rand_central);
+
+    cckprng_initgen(&ctx, 0);
+    cckprng_initgen(&ctx, 1);
+    ok(ctx.gens[0].ready, "generator 0 ready");
+    ok(ctx.gens[1].ready, "generator 1 ready");
+
+    // Requests are served by the generator's own DRBG, the central DRBG is not used.
+    central_counter = cckprng_test_drbg_reseed_counter(ctx.drbg_state);
+    cckprng_generate(&ctx, 0, sizeof(rand0), rand0);
+    cckprng_generate(&ctx, 1, sizeof(rand1), rand1);
+    is(cckprng_test_drbg_reseed_counter(ctx.gens[0].drbg_state), 2, "generator 0 DRBG request count");
+    is(cckprng_test_drbg_reseed_counter(ctx.gens[1].drbg_state), 2, "generator 1 DRBG request count");
+    is(cckprng_test_drbg_reseed_counter(ctx.drbg_state), central_counter, "central DRBG unused by generators");
+    is(ctx.gens[0].counter_schedule_ctx.nreads, 1, "generator 0 request count");
+
+    // The reseed interval bounds the number of requests between two reseeds.
+    for (unsigned i = 1; i < CCKPRNG_GEN_RESEED_INTERVAL; i += 1) {
+        cckprng_generate(&ctx, 0, sizeof(rand0), rand0);
+    }
+    is(ctx.gens[0].counter_schedule_ctx.nreads, CCKPRNG_GEN_RESEED_INTERVAL, "generator 0 at reseed interval");
+    cckprng_generate(&ctx, 0, sizeof(rand0), rand0);
+    is(ctx.gens[0].counter_schedule_ctx.nreads, 0, "generator 0 reseeded after reseed interval");
+    is(cckprng_test_drbg_reseed_counter(ctx.gens[0].drbg_state), 2, "generator 0 DRBG reseeded after reseed interval");
+
+    // Reseeding the central generator rekeys all generators.
+    cckprng_generate(&ctx, 1, sizeof(rand1), rand1);
+    cckprng_reseed(&ctx, sizeof(seed), seed);
+    is(ctx.gens[1].rekey_schedule_ctx.flag, CCRNG_SCHEDULE_MUST_RESEED, "generator 1 rekey pending");
+    cckprng_generate(&ctx, 1, sizeof(rand1), rand1);
+    is(ctx.gens[1].rekey_schedule_ctx.flag, CCRNG_SCHEDULE_CONTINUE, "generator 1 rekeyed");
+    is(ctx.gens[1].counter_schedule_ctx.nreads, 0, "generator 1 request count reset");
+
+    // Generators past CCKPRNG_MAX_NGENS have no state of their own, and share the central generator.
+    cckprng_initgen(&ctx, CCKPRNG_MAX_NGENS);
+    cckprng_generate(&ctx, CCKPRNG_MAX_NGENS, sizeof(rand0), rand0);
+
+    // cckprng_rekeygens() makes every generator rekey from the central generator before its next request.
+    cckprng_generate(&ctx, 1, sizeof(rand0), rand0);
+    is(cckprng_test_drbg_reseed_counter(ctx.gens[1].drbg_state), 3, "generator 1 DRBG request count before cckprng_rekeygens");
+    cckprng_rekeygens(&ctx);
+    is(ctx.gens[1].rekey_schedule_ctx.flag, CCRNG_SCHEDULE_MUST_RESEED, "generator 1 rekey pending after cckprng_rekeygens");
+    is(cckprng_test_drbg_reseed_counter(ctx.gens[1].drbg_state), 3, "generator 1 rekeys on its next request");
+    central_counter = cckprng_test_drbg_reseed_counter(ctx.drbg_state);
+    cckprng_generate(&ctx, 1, sizeof(rand1), rand1);
+    is(ctx.gens[1].rekey_schedule_ctx.flag, CCRNG_SCHEDULE_CONTINUE, "generator 1 rekeyed after cckprng_rekeygens");
+    is(cckprng_test_drbg_reseed_counter(ctx.gens[1].drbg_state), 2, "generator 1 DRBG reseeded after cckprng_rekeygens");
+    is(cckprng_test_drbg_reseed_counter(ctx.drbg_state), central_counter + 1, "generator 1 seeded from the central DRBG");
+
+    diag("End KPRNG generator tests");
+}
+
 #if CC_TSAN
 #include <pthread.h>
 static struct cckprng_ctx tsan_kprng;
@@ -595,6 +691,15 @@ static void *cckprng_tsan_thread_generate(void *arg) {
     return NULL;
 }
 
+static void *cckprng_tsan_thread_generate_gen(void *arg) {
+    unsigned gen_idx = *(const unsigned *)arg;
+    uint8_t generate[32] = {0};
+    for (int i = 0; i < 10000; i++) {
+        cckprng_generate(&tsan_kprng, gen_idx, sizeof(generate), generate);
+    }
+    return NULL;
+}
+
 static void *cckprng_tsan_thread_reseed(void *arg) {
     (void) arg;
     uint8_t reseed[32] = {1,2,3,4,5};
@@ -609,26 +714,42 @@ static void cckprng_tsan_test() {
     uint8_t nonce[32] = {0};
     cckprng_init(&tsan_kprng, sizeof(seed), seed, sizeof(nonce), nonce, cckprng_tsan_get_entropy, NULL);
     
-    pthread_t t_generate, t_reseed;
+    static const unsigned gens[] = { 1, 2 };
+    cckprng_initgen(&tsan_kprng, gens[0]);
+    cckprng_initgen(&tsan_kprng, gens[1]);
+
+    pthread_t t_generate, t_reseed, t_generate_gens[2];
     
     pthread_create(&t_generate, NULL, cckprng_tsan_thread_generate, NULL);
     pthread_create(&t_reseed, NULL, cckprng_tsan_thread_reseed, NULL);
+    pthread_create(&t_generate_gens[0], NULL, cckprng_tsan_thread_generate_gen, (void *)&gens[0]);
+    pthread_create(&t_generate_gens[1], NULL, cckprng_tsan_thread_generate_gen, (void *)&gens[1]);
     
     pthread_join(t_generate, NULL);
     pthread_join(t_reseed, NULL);
+    pthread_join(t_generate_gens[0], NULL);
+    pthread_join(t_generate_gens[1], NULL);
 }
 #endif
 
 int cckprng_tests(TM_UNUSED int argc, TM_UNUSED char *const *argv)
 {
-    plan_tests(3980);
+    plan_tests(
+#if CC_PRNG_KATTESTS
+               3980 +
+#endif
+               20);
 
 #if CC_PRNG_SEEDTESTS
     ok(cckprng_test_loadseed(), "cckprng_test_loadseed");
     ok(cckprng_test_storeseed(), "cckprng_test_storeseed");
 #endif /* CC_PRNG_SEEDTESTS */
     
+#if CC_PRNG_KATTESTS
     cckprng_test_runner();
+#endif
+
+    cckprng_test_gens();
     
 #if CC_TSAN
     diag("Start KPRNG TSAN Tests");
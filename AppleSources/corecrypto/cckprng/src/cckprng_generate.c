@@ -19,8 +19,16 @@
 
 #include <stdatomic.h>
 
-void cckprng_generate(struct cckprng_ctx *ctx, CC_UNUSED unsigned gen_idx, size_t nbytes, void *out)
+void cckprng_generate(struct cckprng_ctx *ctx, unsigned gen_idx, size_t nbytes, void *out)
 {
-    int err = ccrng_generate(&ctx->rng_ctx, nbytes, out);
+    ccrng_crypto_ctx_t *rng_ctx = &ctx->rng_ctx;
+
+    // Generators not set up by cckprng_initgen share the central generator.
+    if (gen_idx < CCKPRNG_MAX_NGENS &&
+        atomic_load_explicit(&ctx->gens[gen_idx].ready, memory_order_acquire)) {
+        rng_ctx = &ctx->gens[gen_idx].rng_ctx;
+    }
+
+    int err = ccrng_crypto_generate(rng_ctx, nbytes, out);
     cc_abort_if(err != CCERR_OK, "cckprng_generate");
 }
@@ -120,13 +120,13 @@ void cckprng_init(struct cckprng_ctx *ctx,
                             32);
     cc_abort_if(err != CCERR_OK, "ccdrbg_df_bc_init");
 
-    struct ccdrbg_nistctr_custom drbg_custom = {
+    ctx->drbg_custom = (struct ccdrbg_nistctr_custom){
         .ctr_info = ccaes_ctr_crypt_mode(),
         .keylen = 32,
         .strictFIPS = 1,
         .df_ctx = &ctx->drbg_df_ctx.df_ctx,
     };
-    ccdrbg_factory_nistctr(&ctx->drbg_info, &drbg_custom);
+    ccdrbg_factory_nistctr(&ctx->drbg_info, &ctx->drbg_custom);
 
     struct ccdrbg_state *drbg_ctx = (struct ccdrbg_state *)&ctx->drbg_state;
 
@@ -152,10 +152,18 @@ void cckprng_init(struct cckprng_ctx *ctx,
                             sizeof(ctx->cache),
                             (uint8_t *)&ctx->cache);
     cc_abort_if(err != CCERR_OK, "Failure to initialize ccrng_crypto");
+
+    // Output generators are seeded from the central generator, see
+    // cckprng_initgen.
+    err = ccentropy_rng_init(&ctx->gen_entropy_ctx,
+                             (struct ccrng_state *)&ctx->rng_ctx);
+    cc_abort_if(err != CCERR_OK, "ccentropy_rng_init");
+
+    ctx->max_ngens = CCKPRNG_MAX_NGENS;
 }
 
 void cckprng_init_with_getentropy(struct cckprng_ctx *ctx,
-                                  CC_UNUSED unsigned max_ngens,
+                                  unsigned max_ngens,
                                   size_t seed_nbytes,
                                   const void *seed,
                                   size_t nonce_nbytes,
@@ -165,4 +173,5 @@ void cckprng_init_with_getentropy(struct cckprng_ctx *ctx,
 
 {
     cckprng_init(ctx, seed_nbytes, seed, nonce_nbytes, nonce, getentropy, getentropy_arg);
+    ctx->max_ngens = max_ngens;
 }
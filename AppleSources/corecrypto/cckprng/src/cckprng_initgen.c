@@ -11,15 +11,64 @@
 
 #include <stdatomic.h>
 
-#include <corecrypto/cc_priv.h>
-#include "cckprng_internal.h"
 #include <corecrypto/cc_priv.h>
 #include "cc_macros.h"
-#include <corecrypto/ccaes.h>
-#include <corecrypto/ccmode.h>
-#include "ccmode_internal.h"
+#include "cc_memory.h"
+#include "cckprng_internal.h"
+#include "ccrng_crypto.h"
 
-void cckprng_initgen(CC_UNUSED struct cckprng_ctx *ctx, CC_UNUSED unsigned gen_idx)
+void cckprng_initgen(struct cckprng_ctx *ctx, unsigned gen_idx)
 {
+    cc_abort_if(gen_idx >= ctx->max_ngens, "cckprng_initgen: invalid generator");
+
+    // Generators past CCKPRNG_MAX_NGENS share the central generator.
+    if (gen_idx >= CCKPRNG_MAX_NGENS) {
+        return;
+    }
+
+    struct cckprng_gen_ctx *gen = &ctx->gens[gen_idx];
+    cc_abort_if(atomic_load_explicit(&gen->ready, memory_order_relaxed), "cckprng_initgen: generator already initialized");
+    cc_abort_if(ccdrbg_context_size(&ctx->drbg_info) > sizeof(gen->drbg_state), "cckprng_initgen: drbg state too large");
+
+    ccrng_schedule_atomic_flag_init(&gen->rekey_schedule_ctx);
+    ccrng_schedule_counter_init(&gen->counter_schedule_ctx, CCKPRNG_GEN_RESEED_INTERVAL);
+    ccrng_schedule_tree_init(&gen->schedule_ctx,
+                             &gen->rekey_schedule_ctx.schedule_ctx,
+                             &gen->counter_schedule_ctx.schedule_ctx);
+
+    int err = cc_lock_init(&gen->lock_ctx, "corecrypto kext rng generator");
+    cc_abort_if(err != CCERR_OK, "cc_lock_init");
+
+    uint8_t seed[CCKPRNG_ENTROPY_SIZE];
+    err = ccrng_crypto_generate(&ctx->rng_ctx, sizeof(seed), seed);
+    cc_abort_if(err != CCERR_OK, "Failure to seed generator");
+
+    // The generator index makes the nonce unique within the context.
+    uint32_t nonce = gen_idx;
+    const uint8_t ps[] = CCKPRNG_LABEL(CCKPRNG_OP_INITGEN);
+    struct ccdrbg_state *drbg_ctx = (struct ccdrbg_state *)&gen->drbg_state;
+    err = ccdrbg_init(&ctx->drbg_info,
+                      drbg_ctx,
+                      sizeof(seed),
+                      seed,
+                      sizeof(nonce),
+                      &nonce,
+                      sizeof(ps),
+                      ps);
+    cc_clear(sizeof(seed), seed);
+    cc_abort_if(err != CCERR_OK, "Failure to instantiate drbg");
+
+    err = ccrng_crypto_init(&gen->rng_ctx,
+                            &ctx->gen_entropy_ctx.entropy_ctx,
+                            &gen->schedule_ctx.schedule_ctx,
+                            &gen->lock_ctx,
+                            &ctx->drbg_info,
+                            drbg_ctx,
+                            CCKPRNG_MAX_REQUEST_SIZE,
+                            CCKPRNG_ENTROPY_SIZE,
+                            sizeof(gen->cache),
+                            (uint8_t *)&gen->cache);
+    cc_abort_if(err != CCERR_OK, "Failure to initialize ccrng_crypto");
 
+    atomic_store_explicit(&gen->ready, true, memory_order_release);
 }
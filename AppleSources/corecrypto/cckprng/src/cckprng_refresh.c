@@ -22,5 +22,6 @@ void cckprng_refresh(struct cckprng_ctx *ctx)
 {
     if (ccrng_fortuna_refresh(&ctx->fortuna_ctx)) {
         ccrng_schedule_atomic_flag_set(&ctx->schedule_ctx);
+        cckprng_rekeygens(ctx);
     }
 }
@@ -0,0 +1,19 @@
+/* Copyright (c) (2023) Apple Inc. All rights reserved.
+ *
+ * corecrypto is licensed under Apple Inc.’s Internal Use License Agreement (which
+ * is contained in the License.txt file distributed with corecrypto) and only to
+ * people who accept that license. IMPORTANT:  Any license rights granted to you by
+ * Apple Inc. (if any) are limited to internal use within your organization only on
+ * devices and computers you own or control, for the sole purpose of verifying the
+ * security characteristics and correct functioning of the Apple Software.  You may
+ * not, directly or indirectly, redistribute the Apple Software or any portions thereof.
+ */
+
+#include "cckprng_internal.h"
+
+void cckprng_rekeygens(struct cckprng_ctx *ctx)
+{
+    for (unsigned i = 0; i < CCKPRNG_MAX_NGENS; i += 1) {
+        ccrng_schedule_atomic_flag_set(&ctx->gens[i].rekey_schedule_ctx);
+    }
+}
@@ -39,4 +39,6 @@ void cckprng_reseed(struct cckprng_ctx *ctx, size_t nbytes, const void *seed)
     int err = ccrng_crypto_reseed(&ctx->rng_ctx, nbytes, seed, sizeof(nonce), &nonce);
 
     cc_abort_if(err != CCERR_OK, "Error reseeding kernel rng");
+
+    cckprng_rekeygens(ctx);
 }
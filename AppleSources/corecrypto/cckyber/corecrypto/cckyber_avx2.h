@@ -0,0 +1,142 @@
+/* Copyright (c) (2023) Apple Inc. All rights reserved.
+ *
+ * corecrypto is licensed under Apple Inc.’s Internal Use License Agreement (which
+ * is contained in the License.txt file distributed with corecrypto) and only to
+ * people who accept that license. IMPORTANT:  Any license rights granted to you by
+ * Apple Inc. (if any) are limited to internal use within your organization only on
+ * devices and computers you own or control, for the sole purpose of verifying the
+ * security characteristics and correct functioning of the Apple Software.  You may
+ * not, directly or indirectly, redistribute the Apple Software or any portions thereof.
+ */
+
+#ifndef _CORECRYPTO_CCKYBER_AVX2_H_
+#define _CORECRYPTO_CCKYBER_AVX2_H_
+
+#include "cc_internal.h"
+#include "cc_runtime_config.h"
+
+// Build with -DCCKYBER_AVX2=0 to get the portable baseline for
+// the cckem perf tests.
+#ifndef CCKYBER_AVX2
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) && !CC_KERNEL
+#define CCKYBER_AVX2 1
+#else
+#define CCKYBER_AVX2 0
+#endif
+#endif
+
+/*
+ Portable implementations that the functions below are dispatched to when
+ AVX2 is not available. Exposed to test that both agree.
+ */
+
+/*! @function cckyber_ntt_forward_c
+ @abstract Portable variant of cckyber_ntt_forward().
+
+ @param coeffs Coefficients.
+ */
+CC_NONNULL_ALL
+void cckyber_ntt_forward_c(int16_t coeffs[256]);
+
+/*! @function cckyber_ntt_inverse_c
+ @abstract Portable variant of cckyber_ntt_inverse().
+
+ @param coeffs Coefficients.
+ */
+CC_NONNULL_ALL
+void cckyber_ntt_inverse_c(int16_t coeffs[256]);
+
+/*! @function cckyber_ntt_basemul_c
+ @abstract Portable variant of cckyber_ntt_basemul().
+
+ @param coeffs Coefficients of the resulting degree-1 polynomials.
+ @param a      Coefficients of the first polynomial.
+ @param b      Coefficients of the second polynomial.
+ */
+CC_NONNULL_ALL
+void cckyber_ntt_basemul_c(int16_t coeffs[256], const int16_t a[256], const int16_t b[256]);
+
+/*! @function cckyber_compress_c
+ @abstract Compresses all 256 coefficients down to `d` bits each.
+
+ @param u      Output array of compressed coefficients.
+ @param coeffs Coefficients to compress.
+ @param d      Parameter d.
+ */
+CC_NONNULL_ALL
+void cckyber_compress_c(int16_t u[256], const int16_t coeffs[256], unsigned d);
+
+/*! @function cckyber_sample_uniform_c
+ @abstract Portable variant of cckyber_sample_uniform().
+
+ @param buf     Uniform random bytes to sample from.
+ @param ncoeffs Max. number of coefficients to sample.
+ @param coeffs  Output coefficients.
+
+ @return The number of sampled coefficients.
+ */
+CC_NONNULL_ALL CC_WARN_RESULT
+size_t cckyber_sample_uniform_c(const uint8_t buf[168], size_t ncoeffs, int16_t *coeffs);
+
+#if CCKYBER_AVX2
+
+/*
+ AVX2 variants of the Kyber polynomial arithmetic. Callers must check
+ CC_HAS_AVX2() first. All functions produce the exact same output as
+ their portable counterparts.
+ */
+
+/*! @function cckyber_ntt_forward_avx2
+ @abstract AVX2 variant of cckyber_ntt_forward().
+
+ @param coeffs Coefficients.
+ */
+CC_NONNULL_ALL
+void cckyber_ntt_forward_avx2(int16_t coeffs[256]);
+
+/*! @function cckyber_ntt_inverse_avx2
+ @abstract AVX2 variant of cckyber_ntt_inverse().
+
+ @param coeffs Coefficients.
+ */
+CC_NONNULL_ALL
+void cckyber_ntt_inverse_avx2(int16_t coeffs[256]);
+
+/*! @function cckyber_ntt_basemul_avx2
+ @abstract AVX2 variant of cckyber_ntt_basemul().
+
+ @param coeffs Coefficients of the resulting degree-1 polynomials.
+ @param a      Coefficients of the first polynomial.
+ @param b      Coefficients of the second polynomial.
+ */
+CC_NONNULL_ALL
+void cckyber_ntt_basemul_avx2(int16_t coeffs[256], const int16_t a[256], const int16_t b[256]);
+
+/*! @function cckyber_compress_avx2
+ @abstract Compresses all 256 coefficients down to `d` bits each.
+
+ @param u      Output array of compressed coefficients.
+ @param coeffs Coefficients to compress.
+ @param d      Parameter d.
+ */
+CC_NONNULL_ALL
+void cckyber_compress_avx2(int16_t u[256], const int16_t coeffs[256], unsigned d);
+
+/*! @function cckyber_sample_uniform_avx2
+ @abstract Runs rejection sampling on a prefix of the given uniform random
+           bytes, 16 candidates at a time, for as long as at least 16
+           coefficients are still wanted.
+
+ @param buf     Uniform random bytes to sample from.
+ @param ncoeffs Max. number of coefficients to sample.
+ @param coeffs  Output coefficients.
+ @param ctr     Number of sampled coefficients.
+
+ @return The number of 3-byte groups of `buf` consumed.
+ */
+CC_NONNULL_ALL CC_WARN_RESULT
+unsigned cckyber_sample_uniform_avx2(const uint8_t buf[168], size_t ncoeffs, int16_t *coeffs, size_t *ctr);
+
+#endif // CCKYBER_AVX2
+
+#endif /* _CORECRYPTO_CCKYBER_AVX2_H_ */
@@ -20,6 +20,9 @@
 #define CCKYBER_N 256
 #define CCKYBER_Q 3329
 
+// Largest dimension k of the supported parameter sets (Kyber1024).
+#define CCKYBER_K_MAX 4
+
 #define CCKYBER_SYM_NBYTES 32 // size in bytes of hashes, and seeds
 #define CCKYBER_SK_NBYTES  32 // size in bytes of shared key
 #define CCKYBER_MSG_NBYTES CCKYBER_SK_NBYTES
@@ -114,6 +117,19 @@ typedef struct cckyber_params {
 extern const cckyber_params_t cckyber768_params;
 extern const cckyber_params_t cckyber1024_params;
 
+/*! @function cckyber_sample_uniform
+ @abstract Runs rejection sampling on uniform random bytes to generate uniform
+           random integers mod q.
+
+ @param buf     Uniform random bytes to sample from.
+ @param ncoeffs Max. number of coefficients to sample.
+ @param coeffs  Output coefficients.
+
+ @return The number of sampled coefficients.
+ */
+CC_NONNULL_ALL CC_WARN_RESULT
+size_t cckyber_sample_uniform(const uint8_t buf[168], size_t ncoeffs, int16_t *coeffs);
+
 /*! @function cckyber_sample_ntt
  @abstract Deterministically generate (the transpose of) matrix A from a given
            public seed. Polynomials of the vectors of matrix A are chosen via
@@ -153,6 +169,17 @@ void cckyber_sample_cbd_eta2(int16_t coeffs[CCKYBER_N], const uint8_t buf[128]);
 CC_NONNULL_ALL
 void cckyber_poly_getnoise(int16_t coeffs[CCKYBER_N], const uint8_t seed[CCKYBER_SYM_NBYTES], uint8_t nonce);
 
+/*! @function cckyber_poly_getnoise_x4
+ @abstract Same as cckyber_poly_getnoise(), for four polynomials at once with
+           consecutive nonces.
+
+ @param coeffs  Output coefficients of the four polynomials.
+ @param seed    Seed.
+ @param nonce   Nonce of the first polynomial.
+ */
+CC_NONNULL_ALL
+void cckyber_poly_getnoise_x4(int16_t *const coeffs[4], const uint8_t seed[CCKYBER_SYM_NBYTES], uint8_t nonce);
+
 /*! @function cckyber_poly_to_msg
  @abstract Serializes a given polynomial to a 256-bit message.
 
@@ -448,6 +475,10 @@ void cckyber_polyvec_basemul(const cckyber_params_t *params,
                              const int16_t *a,
                              const int16_t *b);
 
+// Powers of zeta, the 256-th primitive root of unity, in Plantard domain
+// and premultiplied by q^(-1) mod± 2^32. See cckyber_ntt.c.
+extern const uint32_t cckyber_zetas[128];
+
 /*! @function cckyber_ntt_forward
  @abstract In-place forward NTT.
 
@@ -521,6 +552,19 @@ void cckyber_prf(const uint8_t seed[CCKYBER_SYM_NBYTES],
                  uint8_t nonce,
                  uint8_t out[128]);
 
+/*! @function cckyber_prf_x4
+ @abstract Computes SHAKE256(seed || nonce + i, 128) for i = 0, ..., 3,
+           using four parallel SHAKE256 instances.
+
+ @param seed  Random seed.
+ @param nonce Single-byte nonce of the first output.
+ @param out   Output buffers.
+ */
+CC_NONNULL_ALL
+void cckyber_prf_x4(const uint8_t seed[CCKYBER_SYM_NBYTES],
+                    uint8_t nonce,
+                    uint8_t out[4][128]);
+
 /*! @function cckyber_rkprf
  @abstract Computes SHAKE256(z || ek, 32) to derive the implicit rejection key.
 
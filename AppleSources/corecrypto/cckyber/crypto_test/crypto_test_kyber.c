@@ -19,6 +19,7 @@
 #include "cckem_internal.h"
 
 #include "cckyber_internal.h"
+#include "cckyber_avx2.h"
 
 #include "testmore.h"
 #include "testbyteBuffer.h"
@@ -274,6 +275,105 @@ static void cckyber_kat_ref(const struct cckyber_suite *suite)
     }
 }
 
+#if CCKYBER_AVX2
+
+#define CCKYBER_AVX2_NRANDOM 200
+
+static const size_t cckyber_avx2_sample_ncoeffs[] = { CCKYBER_N, 100, 17, 16, 15, 1 };
+
+static bool cckyber_avx2_cmp(const int16_t *r, const int16_t *r_ref, size_t n, const char *name)
+{
+    if (memcmp(r, r_ref, n * sizeof(int16_t)) == 0) {
+        return true;
+    }
+
+    diag("AVX2 %s differs from the portable code", name);
+    return false;
+}
+
+// Runs the AVX2 kernels and their portable counterparts on the same inputs,
+// returns whether all results are identical.
+static bool cckyber_avx2_agrees(const int16_t a[CCKYBER_N], const int16_t b[CCKYBER_N], const uint8_t buf[168])
+{
+    int16_t r[CCKYBER_N], r_ref[CCKYBER_N];
+    int16_t c[CCKYBER_N];
+    bool rv = true;
+
+    memcpy(r, a, sizeof(r));
+    memcpy(r_ref, a, sizeof(r_ref));
+    cckyber_ntt_forward_avx2(r);
+    cckyber_ntt_forward_c(r_ref);
+    rv &= cckyber_avx2_cmp(r, r_ref, CCKYBER_N, "forward NTT");
+
+    memcpy(r, a, sizeof(r));
+    memcpy(r_ref, a, sizeof(r_ref));
+    cckyber_ntt_inverse_avx2(r);
+    cckyber_ntt_inverse_c(r_ref);
+    rv &= cckyber_avx2_cmp(r, r_ref, CCKYBER_N, "inverse NTT");
+
+    cckyber_ntt_basemul_avx2(r, a, b);
+    cckyber_ntt_basemul_c(r_ref, a, b);
+    rv &= cckyber_avx2_cmp(r, r_ref, CCKYBER_N, "basemul");
+
+    // Compression expects coefficients in [0, q).
+    for (size_t i = 0; i < CCKYBER_N; i++) {
+        c[i] = (int16_t)((uint16_t)a[i] % CCKYBER_Q);
+    }
+
+    for (unsigned d = 1; d <= 11; d++) {
+        cckyber_compress_avx2(r, c, d);
+        cckyber_compress_c(r_ref, c, d);
+        rv &= cckyber_avx2_cmp(r, r_ref, CCKYBER_N, "compression");
+    }
+
+    for (size_t i = 0; i < CC_ARRAY_LEN(cckyber_avx2_sample_ncoeffs); i++) {
+        size_t ncoeffs = cckyber_avx2_sample_ncoeffs[i];
+        size_t n = cckyber_sample_uniform(buf, ncoeffs, r);
+        size_t n_ref = cckyber_sample_uniform_c(buf, ncoeffs, r_ref);
+        rv &= n == n_ref && cckyber_avx2_cmp(r, r_ref, n, "rejection sampling");
+    }
+
+    return rv;
+}
+
+static void cckyber_avx2_random(void)
+{
+    int16_t a[CCKYBER_N], b[CCKYBER_N];
+    uint8_t buf[168];
+
+    for (size_t i = 0; i < CCKYBER_AVX2_NRANDOM; i++) {
+        ccrng_generate(global_test_rng, sizeof(a), a);
+        ccrng_generate(global_test_rng, sizeof(b), b);
+        ccrng_generate(global_test_rng, sizeof(buf), buf);
+        ok(cckyber_avx2_agrees(a, b, buf), "AVX2 and portable kernels agree on random inputs");
+    }
+}
+
+// Public keys hold k polynomials in NTT domain, followed by the seed of matrix A.
+// Run the kernels on pairs of those, and sample from their encoding.
+static void cckyber_avx2_kat(const struct cckyber_suite *suite)
+{
+    const cckyber_params_t *params = get_kyber_params(suite->info);
+    int16_t a[CCKYBER_N], b[CCKYBER_N];
+
+    for (size_t i = 0; i < suite->count; i++) {
+        byteBuffer pubkey_buf = hexStringToBytes(suite->tvs[i].pubkey);
+        bool rv = true;
+
+        for (unsigned j = 0; j < params->k; j++) {
+            const uint8_t *poly = &pubkey_buf->bytes[j * CCKYBER_POLY_NBYTES];
+            cckyber_poly_decode(a, poly);
+            cckyber_poly_decode(b, &pubkey_buf->bytes[((j + 1) % params->k) * CCKYBER_POLY_NBYTES]);
+            rv &= cckyber_avx2_agrees(a, b, poly);
+        }
+        ok(rv, "AVX2 and portable kernels agree on KAT public keys");
+
+        free(pubkey_buf);
+    }
+}
+
+#endif // CCKYBER_AVX2
+
 int cckyber_tests(TM_UNUSED int argc, TM_UNUSED char *const *argv)
 {
     const struct cckyber_suite kyber_suites[] = {
@@ -297,6 +397,14 @@ int cckyber_tests(TM_UNUSED int argc, TM_UNUSED char *const *argv)
     for (size_t i = 0; i < CC_ARRAY_LEN(kyber_suites_ref); i++) {
         ntests += 14 * kyber_suites_ref[i].count;
     }
+#if CCKYBER_AVX2
+    if (CC_HAS_AVX2()) {
+        ntests += CCKYBER_AVX2_NRANDOM;
+        for (size_t i = 0; i < CC_ARRAY_LEN(kyber_suites_ref); i++) {
+            ntests += kyber_suites_ref[i].count;
+        }
+    }
+#endif
     plan_tests(ntests);
 
     for (size_t i = 0; i < CC_ARRAY_LEN(kyber_suites); i++) {
@@ -307,5 +415,14 @@ int cckyber_tests(TM_UNUSED int argc, TM_UNUSED char *const *argv)
         cckyber_kat_ref(&kyber_suites_ref[i]);
     }
 
+#if CCKYBER_AVX2
+    if (CC_HAS_AVX2()) {
+        cckyber_avx2_random();
+        for (size_t i = 0; i < CC_ARRAY_LEN(kyber_suites_ref); i++) {
+            cckyber_avx2_kat(&kyber_suites_ref[i]);
+        }
+    }
+#endif
+
     return 0;
 }
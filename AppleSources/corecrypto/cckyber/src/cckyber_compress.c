@@ -11,6 +11,7 @@
 
 #include "cc_internal.h"
 #include "cckyber_internal.h"
+#include "cckyber_avx2.h"
 
 /*! @function cckyber_compress_coefficient
  @abstract Compress a given coefficient down to `d` bits.
@@ -36,38 +37,68 @@ int16_t cckyber_compress_coefficient(int16_t coeff, unsigned d)
     return (((((uint32_t)coeff << d) + (CCKYBER_Q >> 1)) * M) >> 32) & mask;
 }
 
+void cckyber_compress_c(int16_t u[CCKYBER_N], const int16_t coeffs[CCKYBER_N], unsigned d)
+{
+    for (unsigned i = 0; i < CCKYBER_N; i++) {
+        u[i] = cckyber_compress_coefficient(coeffs[i], d);
+    }
+}
+
+/*! @function cckyber_compress_coefficients
+ @abstract Compress all coefficients of a polynomial down to `d` bits each.
+
+ @param u      Output compressed coefficients.
+ @param coeffs Coefficients.
+ @param d      Parameter d.
+ */
+CC_NONNULL_ALL
+static void cckyber_compress_coefficients(int16_t u[CCKYBER_N], const int16_t coeffs[CCKYBER_N], unsigned d)
+{
+#if CCKYBER_AVX2
+    if (CC_HAS_AVX2()) {
+        cckyber_compress_avx2(u, coeffs, d);
+        return;
+    }
+#endif
+
+    cckyber_compress_c(u, coeffs, d);
+}
+
 void cckyber_poly_compress_d1(uint8_t out[32], const int16_t coeffs[CCKYBER_N])
 {
+    int16_t u[CCKYBER_N];
+    cckyber_compress_coefficients(u, coeffs, 1);
+
     for (unsigned i = 0; i < CCKYBER_N / 8; i++) {
         out[i] = 0;
 
         for (unsigned j = 0; j < 8; j++) {
-            out[i] |= cckyber_compress_coefficient(coeffs[8 * i + j], 1) << j;
+            out[i] |= u[8 * i + j] << j;
         }
     }
+
+    cc_clear(sizeof(u), u);
 }
 
 void cckyber_poly_compress_d4(uint8_t out[128], const int16_t coeffs[CCKYBER_N])
 {
-    int16_t u[2];
+    int16_t u[CCKYBER_N];
+    cckyber_compress_coefficients(u, coeffs, 4);
 
     for (unsigned i = 0; i < CCKYBER_N / 2; i++) {
-        for (unsigned j = 0; j < 2; j++) {
-            u[j] = cckyber_compress_coefficient(coeffs[2 * i + j], 4);
-        }
-
-        *(out++) = (uint8_t) (u[1] << 4) | (u[0] & 15);
+        *(out++) = (uint8_t) (u[2 * i + 1] << 4) | (u[2 * i + 0] & 15);
     }
+
+    cc_clear(sizeof(u), u);
 }
 
 void cckyber_poly_compress_d5(uint8_t out[160], const int16_t coeffs[CCKYBER_N])
 {
-    int16_t u[8];
+    int16_t v[CCKYBER_N];
+    cckyber_compress_coefficients(v, coeffs, 5);
 
     for (unsigned i = 0; i < CCKYBER_N / 8; i++) {
-        for (unsigned j = 0; j < 8; j++) {
-            u[j] = cckyber_compress_coefficient(coeffs[8 * i + j], 5);
-        }
+        const int16_t *u = &v[8 * i];
 
         *(out++) = (uint8_t) ((u[0] >> 0) | (u[1] << 5));
         *(out++) = (uint8_t) ((u[1] >> 3) | (u[2] << 2) | (u[3] << 7));
@@ -75,16 +106,17 @@ void cckyber_poly_compress_d5(uint8_t out[160], const int16_t coeffs[CCKYBER_N])
         *(out++) = (uint8_t) ((u[4] >> 4) | (u[5] << 1) | (u[6] << 6));
         *(out++) = (uint8_t) ((u[6] >> 2) | (u[7] << 3));
     }
+
+    cc_clear(sizeof(v), v);
 }
 
 void cckyber_poly_compress_d10(uint8_t out[320], const int16_t coeffs[CCKYBER_N])
 {
-    int16_t u[4];
+    int16_t v[CCKYBER_N];
+    cckyber_compress_coefficients(v, coeffs, 10);
 
     for (unsigned i = 0; i < (CCKYBER_N / 4); i++) {
-        for (unsigned j = 0; j < 4; j++) {
-            u[j] = cckyber_compress_coefficient(coeffs[4 * i + j], 10);
-        }
+        const int16_t *u = &v[4 * i];
 
         *(out++) = (uint8_t)  (u[0] >> 0);
         *(out++) = (uint8_t) ((u[0] >> 8) | (u[1] << 2));
@@ -92,16 +124,17 @@ void cckyber_poly_compress_d10(uint8_t out[320], const int16_t coeffs[CCKYBER_N]
         *(out++) = (uint8_t) ((u[2] >> 4) | (u[3] << 6));
         *(out++) = (uint8_t)  (u[3] >> 2);
     }
+
+    cc_clear(sizeof(v), v);
 }
 
 void cckyber_poly_compress_d11(uint8_t out[352], const int16_t coeffs[CCKYBER_N])
 {
-    int16_t u[8];
+    int16_t v[CCKYBER_N];
+    cckyber_compress_coefficients(v, coeffs, 11);
 
     for (unsigned i = 0; i < (CCKYBER_N / 8); i++) {
-        for (unsigned j = 0; j < 8; j++) {
-            u[j] = cckyber_compress_coefficient(coeffs[8 * i + j], 11);
-        }
+        const int16_t *u = &v[8 * i];
 
         *(out++) = (uint8_t)  (u[0] >>  0);
         *(out++) = (uint8_t) ((u[0] >>  8) | (u[1] << 3));
@@ -115,6 +148,8 @@ void cckyber_poly_compress_d11(uint8_t out[352], const int16_t coeffs[CCKYBER_N]
         *(out++) = (uint8_t) ((u[6] >>  6) | (u[7] << 5));
         *(out++) = (uint8_t)  (u[7] >>  3);
     }
+
+    cc_clear(sizeof(v), v);
 }
 
 /*! @function cckyber_decompress_coefficient
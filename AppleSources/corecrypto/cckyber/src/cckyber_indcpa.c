@@ -31,6 +31,29 @@ void cckyber_pack_pubkey(const cckyber_params_t *params,
     cc_memcpy(out + CCKYBER_POLYVEC_NBYTES(params), seed, CCKYBER_SYM_NBYTES);
 }
 
+/*! @function cckyber_getnoise
+ @abstract Samples noise polynomials with nonces 0, 1, ..., npolys - 1,
+           four at a time where possible.
+
+ @param npolys Number of polynomials.
+ @param polys  Output polynomials.
+ @param seed   Seed.
+ */
+CC_NONNULL_ALL
+static void cckyber_getnoise(unsigned npolys, int16_t *const *polys, const uint8_t seed[CCKYBER_SYM_NBYTES])
+{
+    cc_assert(npolys <= 2 * CCKYBER_K_MAX + 1);
+    unsigned i = 0;
+
+    for (; i + 4 <= npolys; i += 4) {
+        cckyber_poly_getnoise_x4(&polys[i], seed, (uint8_t)i);
+    }
+
+    for (; i < npolys; i++) {
+        cckyber_poly_getnoise(polys[i], seed, (uint8_t)i);
+    }
+}
+
 /*! @function cckyber_indcpa_keypair_ws
  @abstract Computes a public and private key as part of the CPA-secure
            public-key encryption scheme underlying Kyber.
@@ -63,13 +86,13 @@ static int cckyber_indcpa_keypair_ws(cc_ws_t ws,
     cckyber_hash_g(CCKYBER_SYM_NBYTES, coins, buf);
     cckyber_sample_ntt(params, publicseed, /* transposed = */ 0, a);
 
-    uint8_t nonce = 0;
-    for (unsigned k = 0; k < params->k; k++) {
-        cckyber_poly_getnoise(&s[k * CCKYBER_N], noiseseed, nonce++);
-    }
+    // s and e, with nonces 0..k-1 and k..2k-1.
+    int16_t *noise[2 * CCKYBER_K_MAX];
     for (unsigned k = 0; k < params->k; k++) {
-        cckyber_poly_getnoise(&e[k * CCKYBER_N], noiseseed, nonce++);
+        noise[k] = &s[k * CCKYBER_N];
+        noise[params->k + k] = &e[k * CCKYBER_N];
     }
+    cckyber_getnoise(2 * params->k, noise, noiseseed);
 
     // sˆ = NTT(s)
     cckyber_polyvec_ntt_forward(params, s);
@@ -147,16 +170,15 @@ int cckyber_indcpa_encrypt_ws(cc_ws_t ws,
 
     cckyber_sample_ntt(params, seed, /* transposed = */ 1, at);
 
-    uint8_t nonce = 0;
+    // r, e1, and e2 = SamplePolyCBDη2(PRFη2(r, N)),
+    // with nonces 0..k-1, k..2k-1, and 2k.
+    int16_t *noise[2 * CCKYBER_K_MAX + 1];
     for (unsigned k = 0; k < params->k; k++) {
-        cckyber_poly_getnoise(&r[k * CCKYBER_N], coins, nonce++);
+        noise[k] = &r[k * CCKYBER_N];
+        noise[params->k + k] = &e1[k * CCKYBER_N];
     }
-    for (unsigned k = 0; k < params->k; k++) {
-        cckyber_poly_getnoise(&e1[k * CCKYBER_N], coins, nonce++);
-    }
-
-    // e2 = SamplePolyCBDη2(PRFη2(r, N))
-    cckyber_poly_getnoise(e2, coins, nonce);
+    noise[2 * params->k] = e2;
+    cckyber_getnoise(2 * params->k + 1, noise, coins);
 
     // µ = Decompress_1(ByteDecode_1(m)))
     cckyber_poly_from_msg(m, msg);
@@ -11,6 +11,7 @@
 
 #include "cckyber_internal.h"
 #include "cckyber_mult.h"
+#include "cckyber_avx2.h"
 
 /*
 q = 3329
@@ -42,7 +43,7 @@ print([(to_ctr(tmp[t]) * qi) % 2^32 for t in tree])
 // Precomputed powers of zeta, the 256-th primitive root of unity. Each power
 // is converted to Plantard domain (z *= R, where R = -2^32 mod q) and then
 // multiplied by q^(-1) mod± 2^32 to save one multiplication.
-static const uint32_t cckyber_zetas[128] = {
+const uint32_t cckyber_zetas[128] = {
        1290167, 2230699446, 3328631909, 4243360600,
     3408622288,  812805466, 2447447570, 1094061961,
     1370157786, 2475831253,  249002309, 1028263423,
@@ -101,13 +102,25 @@ void cckyber_ntt_forward_layer(int16_t coeffs[256], unsigned layer)
     }
 }
 
-void cckyber_ntt_forward(int16_t coeffs[256])
+void cckyber_ntt_forward_c(int16_t coeffs[256])
 {
     for (unsigned l = 7; l >= 1; l -= 1) {
         cckyber_ntt_forward_layer(coeffs, l);
     }
 }
 
+void cckyber_ntt_forward(int16_t coeffs[256])
+{
+#if CCKYBER_AVX2
+    if (CC_HAS_AVX2()) {
+        cckyber_ntt_forward_avx2(coeffs);
+        return;
+    }
+#endif
+
+    cckyber_ntt_forward_c(coeffs);
+}
+
 /*! @function cckyber_ntt_inverse_layer
  @abstract In-place, single-layer inverse NTT.
 
@@ -160,7 +173,7 @@ void cckyber_ntt_inverse_layer_7th(int16_t coeffs[256])
     }
 }
 
-void cckyber_ntt_inverse(int16_t coeffs[256])
+void cckyber_ntt_inverse_c(int16_t coeffs[256])
 {
     // 6-layer inverse NTT (7th is computed seperately).
     for (unsigned l = 1; l <= 6; l += 1) {
@@ -171,6 +184,18 @@ void cckyber_ntt_inverse(int16_t coeffs[256])
     cckyber_ntt_inverse_layer_7th(coeffs);
 }
 
+void cckyber_ntt_inverse(int16_t coeffs[256])
+{
+#if CCKYBER_AVX2
+    if (CC_HAS_AVX2()) {
+        cckyber_ntt_inverse_avx2(coeffs);
+        return;
+    }
+#endif
+
+    cckyber_ntt_inverse_c(coeffs);
+}
+
 /*! @function cckyber_ntt_basemul_inner
  @abstract Base multiplication of two degree-1 polynomials.
 
@@ -195,7 +220,7 @@ void cckyber_ntt_basemul_inner(int16_t coeffs[2], const int16_t a[2], const int1
     coeffs[1] += cckyber_mult_partial(a1, b[0]);
 }
 
-void cckyber_ntt_basemul(int16_t coeffs[256], const int16_t a[256], const int16_t b[256])
+void cckyber_ntt_basemul_c(int16_t coeffs[256], const int16_t a[256], const int16_t b[256])
 {
     for (unsigned i = 0; i < 64; i++) {
         uint32_t zeta = cckyber_zetas[64 + i];
@@ -204,3 +229,15 @@ void cckyber_ntt_basemul(int16_t coeffs[256], const int16_t a[256], const int16_
         cckyber_ntt_basemul_inner(&coeffs[4 * i + 2], &a[4 * i + 2], &b[4 * i + 2], -zeta);
     }
 }
+
+void cckyber_ntt_basemul(int16_t coeffs[256], const int16_t a[256], const int16_t b[256])
+{
+#if CCKYBER_AVX2
+    if (CC_HAS_AVX2()) {
+        cckyber_ntt_basemul_avx2(coeffs, a, b);
+        return;
+    }
+#endif
+
+    cckyber_ntt_basemul_c(coeffs, a, b);
+}
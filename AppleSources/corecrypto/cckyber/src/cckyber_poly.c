@@ -22,6 +22,20 @@ void cckyber_poly_getnoise(int16_t coeffs[CCKYBER_N],
     cckyber_sample_cbd_eta2(coeffs, buf);
 }
 
+void cckyber_poly_getnoise_x4(int16_t *const coeffs[4],
+                              const uint8_t seed[CCKYBER_SYM_NBYTES],
+                              uint8_t nonce)
+{
+    uint8_t buf[4][128];
+    cckyber_prf_x4(seed, nonce, buf);
+
+    for (unsigned i = 0; i < 4; i++) {
+        cckyber_sample_cbd_eta2(coeffs[i], buf[i]);
+    }
+
+    cc_clear(sizeof(buf), buf);
+}
+
 void cckyber_poly_to_msg(uint8_t msg[CCKYBER_MSG_NBYTES], const int16_t coeffs[CCKYBER_N])
 {
     cckyber_poly_compress_d1(msg, coeffs);
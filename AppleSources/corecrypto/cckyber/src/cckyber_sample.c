@@ -12,25 +12,24 @@
 #include "cc_internal.h"
 #include "cckyber_internal.h"
 #include "ccshake_internal.h"
+#include "cckyber_avx2.h"
 
-/*! @function cckyber_sample_uniform
- @abstract Runs rejection sampling on uniform random bytes to generate uniform
-           random integers mod q.
+/*! @function cckyber_sample_uniform_from
+ @abstract Continues rejection sampling at the `i`-th 3-byte group of `buf`,
+           with `ctr` coefficients sampled so far.
 
  @param buf     Uniform random bytes to sample from.
+ @param i       Index of the first 3-byte group to look at.
  @param ncoeffs Max. number of coefficients to sample.
  @param coeffs  Output coefficients.
+ @param ctr     Number of coefficients sampled so far.
 
  @return The number of sampled coefficients.
  */
-CC_NONNULL_ALL CC_WARN_RESULT
-static size_t cckyber_sample_uniform(const uint8_t buf[168], size_t ncoeffs, int16_t *coeffs)
+CC_INLINE CC_NONNULL_ALL CC_WARN_RESULT
+size_t cckyber_sample_uniform_from(const uint8_t buf[168], unsigned i, size_t ncoeffs, int16_t *coeffs, size_t ctr)
 {
-    cc_assert(0 < ncoeffs);
-
-    size_t ctr = 0;
-
-    for (unsigned i = 0; i < (168 / 3) && ctr < ncoeffs; i += 1) {
+    for (; i < (168 / 3) && ctr < ncoeffs; i += 1) {
         uint16_t v0 = (((uint16_t)buf[3 * i + 1] << 8) |
                                  (buf[3 * i + 0] >> 0)) & 0xfff;
         uint16_t v1 = (((uint16_t)buf[3 * i + 2] << 4) |
@@ -48,33 +47,129 @@ static size_t cckyber_sample_uniform(const uint8_t buf[168], size_t ncoeffs, int
     return ctr;
 }
 
+size_t cckyber_sample_uniform_c(const uint8_t buf[168], size_t ncoeffs, int16_t *coeffs)
+{
+    cc_assert(0 < ncoeffs);
+
+    return cckyber_sample_uniform_from(buf, 0, ncoeffs, coeffs, 0);
+}
+
+size_t cckyber_sample_uniform(const uint8_t buf[168], size_t ncoeffs, int16_t *coeffs)
+{
+    cc_assert(0 < ncoeffs);
+
+#if CCKYBER_AVX2
+    if (CC_HAS_AVX2()) {
+        size_t ctr = 0;
+        unsigned i = cckyber_sample_uniform_avx2(buf, ncoeffs, coeffs, &ctr);
+        return cckyber_sample_uniform_from(buf, i, ncoeffs, coeffs, ctr);
+    }
+#endif
+
+    return cckyber_sample_uniform_c(buf, ncoeffs, coeffs);
+}
+
+/*! @function cckyber_sample_ntt_x4
+ @abstract Generates four polynomials of matrix A at once, using four parallel
+           SHAKE128 instances.
+
+ @param params     Kyber parameters.
+ @param seed       Public seed.
+ @param transposed Pass 0 to generate A. Pass 1 to generate AˆT.
+ @param idx        Index of the first polynomial, in row-major order.
+ @param a          Output matrix A.
+ */
+CC_NONNULL_ALL
+static void cckyber_sample_ntt_x4(const cckyber_params_t *params,
+                                  const uint8_t *seed,
+                                  int transposed,
+                                  unsigned idx,
+                                  int16_t *a)
+{
+    uint8_t in[CCKECCAK_X4_NSTATES][CCKYBER_SYM_NBYTES + 2];
+    uint8_t buf[CCKECCAK_X4_NSTATES][3 * CCSHAKE128_RATE];
+    size_t ctr[CCKECCAK_X4_NSTATES];
+
+    const uint8_t *const inp[CCKECCAK_X4_NSTATES] = { in[0], in[1], in[2], in[3] };
+    uint8_t *const bufp[CCKECCAK_X4_NSTATES] = { buf[0], buf[1], buf[2], buf[3] };
+
+    for (unsigned l = 0; l < CCKECCAK_X4_NSTATES; l++) {
+        uint8_t i = (uint8_t)((idx + l) / params->k);
+        uint8_t j = (uint8_t)((idx + l) % params->k);
+
+        // SHAKE128(p, j, i), or SHAKE128(p, i, j) for the transpose.
+        cc_memcpy(in[l], seed, CCKYBER_SYM_NBYTES);
+        in[l][CCKYBER_SYM_NBYTES + 0] = transposed ? i : j;
+        in[l][CCKYBER_SYM_NBYTES + 1] = transposed ? j : i;
+        ctr[l] = 0;
+    }
+
+    struct cckeccak_state_x4 state;
+    ccshake128_x4_absorb(&state, sizeof(in[0]), inp);
+
+    // Three blocks are enough for all four polynomials most of the time,
+    // see cckyber_sample_ntt().
+    size_t nbytes = sizeof(buf[0]);
+
+    for (;;) {
+        ccshake128_x4_squeeze(&state, nbytes, bufp);
+
+        bool done = true;
+        for (unsigned l = 0; l < CCKECCAK_X4_NSTATES; l++) {
+            int16_t *coeffs = &a[(idx + l) * CCKYBER_N];
+
+            for (size_t off = 0; off < nbytes && ctr[l] < CCKYBER_N; off += CCSHAKE128_RATE) {
+                ctr[l] += cckyber_sample_uniform(&buf[l][off], CCKYBER_N - ctr[l], coeffs + ctr[l]);
+            }
+
+            done &= (ctr[l] == CCKYBER_N);
+        }
+
+        if (done) {
+            break;
+        }
+
+        nbytes = CCSHAKE128_RATE;
+    }
+
+    cc_clear(sizeof(state), &state);
+}
+
 void cckyber_sample_ntt(const cckyber_params_t *params,
                         const uint8_t *seed,
                         int transposed,
                         int16_t *a)
 {
     uint8_t buf[CCSHAKE128_RATE];
+    unsigned npolys = params->k * params->k;
+    unsigned idx = 0;
+
+    // Four polynomials at a time, the remaining ones one by one.
+    for (; idx + CCKECCAK_X4_NSTATES <= npolys; idx += CCKECCAK_X4_NSTATES) {
+        cckyber_sample_ntt_x4(params, seed, transposed, idx, a);
+    }
 
     const struct ccxof_info *xi = ccshake128_xi();
     ccshake128_ctx_decl(ctx);
 
-    for (unsigned i = 0; i < params->k; i++) {
-        for (unsigned j = 0; j < params->k; j++) {
-            ccxof_init(xi, ctx);
-            ccxof_absorb(xi, ctx, CCKYBER_SYM_NBYTES, seed);
-
-            // Absorb j and i -- SHAKE128(p, j, i).
-            const uint8_t xy[] = { (uint8_t)j, (uint8_t)i, (uint8_t)j };
-            ccxof_absorb(xi, ctx, 2U, xy + (transposed & 1));
-
-            // We want 256 coefficients and per each 168-byte SHAKE128 block we
-            // can sample at most 112 12-bit numbers < q. So we need to squeeze
-            // three blocks or more.
-            size_t ctr = 0;
-            while (ctr < CCKYBER_N) {
-                ccxof_squeeze(xi, ctx, sizeof(buf), buf);
-                ctr += cckyber_sample_uniform(buf, CCKYBER_N - ctr, &a[(params->k * i + j) * CCKYBER_N] + ctr);
-            }
+    for (; idx < npolys; idx++) {
+        unsigned i = idx / params->k;
+        unsigned j = idx % params->k;
+
+        ccxof_init(xi, ctx);
+        ccxof_absorb(xi, ctx, CCKYBER_SYM_NBYTES, seed);
+
+        // Absorb j and i -- SHAKE128(p, j, i).
+        const uint8_t xy[] = { (uint8_t)j, (uint8_t)i, (uint8_t)j };
+        ccxof_absorb(xi, ctx, 2U, xy + (transposed & 1));
+
+        // We want 256 coefficients and per each 168-byte SHAKE128 block we
+        // can sample at most 112 12-bit numbers < q. So we need to squeeze
+        // three blocks or more.
+        size_t ctr = 0;
+        while (ctr < CCKYBER_N) {
+            ccxof_squeeze(xi, ctx, sizeof(buf), buf);
+            ctr += cckyber_sample_uniform(buf, CCKYBER_N - ctr, &a[idx * CCKYBER_N] + ctr);
         }
     }
 
@@ -37,6 +37,24 @@ void cckyber_prf(const uint8_t seed[CCKYBER_SYM_NBYTES],
     ccshake256_ctx_clear(ctx);
 }
 
+void cckyber_prf_x4(const uint8_t seed[CCKYBER_SYM_NBYTES],
+                    uint8_t nonce,
+                    uint8_t out[4][128])
+{
+    uint8_t in[CCKECCAK_X4_NSTATES][CCKYBER_SYM_NBYTES + 1];
+
+    for (unsigned i = 0; i < CCKECCAK_X4_NSTATES; i++) {
+        cc_memcpy(in[i], seed, CCKYBER_SYM_NBYTES);
+        in[i][CCKYBER_SYM_NBYTES] = (uint8_t)(nonce + i);
+    }
+
+    const uint8_t *const inp[CCKECCAK_X4_NSTATES] = { in[0], in[1], in[2], in[3] };
+    uint8_t *const outp[CCKECCAK_X4_NSTATES] = { out[0], out[1], out[2], out[3] };
+    ccshake256_x4(sizeof(in[0]), inp, 128, outp);
+
+    cc_clear(sizeof(in), in);
+}
+
 void cckyber_rkprf(const uint8_t z[CCKYBER_SYM_NBYTES],
                    size_t ek_nbytes,
                    const uint8_t *ek,
@@ -0,0 +1,670 @@
+/* Copyright (c) (2023) Apple Inc. All rights reserved.
+ *
+ * corecrypto is licensed under Apple Inc.’s Internal Use License Agreement (which
+ * is contained in the License.txt file distributed with corecrypto) and only to
+ * people who accept that license. IMPORTANT:  Any license rights granted to you by
+ * Apple Inc. (if any) are limited to internal use within your organization only on
+ * devices and computers you own or control, for the sole purpose of verifying the
+ * security characteristics and correct functioning of the Apple Software.  You may
+ * not, directly or indirectly, redistribute the Apple Software or any portions thereof.
+ */
+
+#include "cc_internal.h"
+#include "cckyber_internal.h"
+#include "cckyber_avx2.h"
+
+#if CCKYBER_AVX2
+
+#include <immintrin.h>
+
+#define CCKYBER_AVX2_TARGET __attribute__((target("avx2")))
+
+/*
+ Plantard multiplication on 16 lanes of 16 bits.
+
+ The precomputed 32-bit factor a*q' is split into a low half l and a high
+ half h, with h incremented when l is negative as a signed 16-bit number.
+ Then (a*b*q' mod 2^32) >> 16 = h*b + mulhi(l, b) (mod 2^16).
+
+ The final reduction ((t + 2^3) * q) >> 16 would overflow 16 bits when
+ computing t + 2^3. Instead, compute t*q and add the carry of the low half
+ of t*q + 2^3*q into its high half. That way, results match the portable
+ code in cckyber_mult.h exactly.
+ */
+
+/*! @function cckyber_avx2_split
+ @abstract Splits a precomputed factor a*q' mod 2^32 into 16-bit halves.
+
+ @param aqi Precomputed a*q' mod 2^32.
+ @param lo  Low half.
+ @param hi  High half, corrected for a negative low half.
+ */
+CC_INLINE CC_NONNULL_ALL
+void cckyber_avx2_split(uint32_t aqi, uint16_t *lo, uint16_t *hi)
+{
+    *lo = (uint16_t)aqi;
+    *hi = (uint16_t)((aqi >> 16) + ((aqi >> 15) & 1));
+}
+
+/*! @function cckyber_avx2_mult_partial
+ @abstract Vector variant of cckyber_mult_partial().
+
+ @param lo Low halves of the precomputed factors a*q', see cckyber_avx2_split().
+ @param hi High halves of the precomputed factors a*q'.
+ @param b  Factors b.
+
+ @return a * b / -2^32 (mod± q).
+ */
+CCKYBER_AVX2_TARGET
+static inline __m256i cckyber_avx2_mult_partial(__m256i lo, __m256i hi, __m256i b)
+{
+    const __m256i q = _mm256_set1_epi16(CCKYBER_Q);
+
+    // Carry iff the low half of t*q is >= 2^16 - 2^3*q (unsigned).
+    const __m256i bound = _mm256_set1_epi16(0x8000 - 8 * CCKYBER_Q - 1);
+    const __m256i sign = _mm256_set1_epi16((int16_t)0x8000);
+
+    __m256i t = _mm256_add_epi16(_mm256_mullo_epi16(hi, b), _mm256_mulhi_epi16(lo, b));
+
+    __m256i r = _mm256_mulhi_epi16(t, q);
+    __m256i c = _mm256_cmpgt_epi16(_mm256_xor_si256(_mm256_mullo_epi16(t, q), sign), bound);
+
+    return _mm256_sub_epi16(r, c);
+}
+
+/*! @function cckyber_avx2_mult_precomp
+ @abstract Vector variant of cckyber_mult_precomp().
+
+ @param a  Factors a.
+ @param lo Low halves of a*q' mod 2^32.
+ @param hi High halves of a*q' mod 2^32, see cckyber_avx2_split().
+ */
+CCKYBER_AVX2_TARGET
+static inline void cckyber_avx2_mult_precomp(__m256i a, __m256i *lo, __m256i *hi)
+{
+    // q^(-1) mod 2^32 = 0x6ba8f301.
+    const __m256i qi_lo = _mm256_set1_epi16((int16_t)0xf301);
+    const __m256i qi_hi = _mm256_set1_epi16(0x6ba8);
+
+    *lo = _mm256_mullo_epi16(a, qi_lo);
+
+    // The low half of q^(-1) is negative as a signed 16-bit number,
+    // mulhi() thus computes the high half of (qi_lo - 2^16) * a.
+    *hi = _mm256_add_epi16(_mm256_mullo_epi16(a, qi_hi), _mm256_mulhi_epi16(a, qi_lo));
+    *hi = _mm256_add_epi16(*hi, a);
+    *hi = _mm256_sub_epi16(*hi, _mm256_srai_epi16(*lo, 15));
+}
+
+/*! @function cckyber_avx2_broadcast
+ @abstract Broadcasts the halves of a precomputed factor to all lanes.
+
+ @param aqi Precomputed a*q' mod 2^32.
+ @param lo  Low halves.
+ @param hi  High halves.
+ */
+CCKYBER_AVX2_TARGET
+static inline void cckyber_avx2_broadcast(uint32_t aqi, __m256i *lo, __m256i *hi)
+{
+    uint16_t l, h;
+    cckyber_avx2_split(aqi, &l, &h);
+
+    *lo = _mm256_set1_epi16((int16_t)l);
+    *hi = _mm256_set1_epi16((int16_t)h);
+}
+
+/*
+ Per-lane zetas for the layers with butterflies of length 8, 4, and 2, split
+ by cckyber_avx2_split() into low and high halves. Entries are in the lane
+ order of cckyber_avx2_shuffle(), for each 32 coefficients and layer:
+
+   forward[i][3 - l] holds cckyber_zetas[(128 >> l) + (32 * i + c) / 2^(l+1)],
+   inverse[i][l - 1] holds cckyber_zetas[(256 >> l) - 1 - (32 * i + c) / 2^(l+1)],
+
+ where c is the offset of the coefficient in the top half of the butterfly.
+ basemul[i] holds zeta and -zeta for polynomials 16 * i + j, in the lane order
+ of cckyber_avx2_deinterleave(). This avoids building the vectors at runtime.
+ */
+static const uint16_t cckyber_avx2_zetas_forward[8][3][2][16] = {
+    { { { 0x2c10, 0x2c10, 0x2c10, 0x2c10, 0x2c10, 0x2c10, 0x2c10, 0x2c10, 0x9a1c, 0x9a1c, 0x9a1c, 0x9a1c, 0x9a1c, 0x9a1c, 0x9a1c, 0x9a1c },
+        { 0x16c3, 0x16c3, 0x16c3, 0x16c3, 0x16c3, 0x16c3, 0x16c3, 0x16c3, 0xbc2d, 0xbc2d, 0xbc2d, 0xbc2d, 0xbc2d, 0xbc2d, 0xbc2d, 0xbc2d } },
+      { { 0x5e0c, 0x5e0c, 0x5e0c, 0x5e0c, 0xd58d, 0xd58d, 0xd58d, 0xd58d, 0x3224, 0x3224, 0x3224, 0x3224, 0x4e0e, 0x4e0e, 0x4e0e, 0x4e0e },
+        { 0x1639, 0x1639, 0x1639, 0x1639, 0xfa28, 0xfa28, 0xfa28, 0xfa28, 0x1974, 0x1974, 0x1974, 0x1974, 0x8709, 0x8709, 0x8709, 0x8709 } },
+      { { 0xab2e, 0xab2e, 0x2111, 0x2111, 0x9fcc, 0x9fcc, 0x42fb, 0x42fb, 0x2aae, 0x2aae, 0x40d4, 0x40d4, 0x7732, 0x7732, 0x0813, 0x0813 },
+        { 0x014f, 0x014f, 0xd452, 0xd452, 0x7de3, 0x7de3, 0x3799, 0x3799, 0x2cd5, 0x2cd5, 0xcbb5, 0xcbb5, 0xaff2, 0xaff2, 0x5497, 0x5497 } } },
+    { { { 0x144d, 0x144d, 0x144d, 0x144d, 0x144d, 0x144d, 0x144d, 0x144d, 0x1d74, 0x1d74, 0x1d74, 0x1d74, 0x1d74, 0x1d74, 0x1d74, 0x1d74 },
+        { 0x66f8, 0x66f8, 0x66f8, 0x66f8, 0x66f8, 0x66f8, 0x66f8, 0x66f8, 0x7181, 0x7181, 0x7181, 0x7181, 0x7181, 0x7181, 0x7181, 0x7181 } },
+      { { 0x9c91, 0x9c91, 0x9c91, 0x9c91, 0xea50, 0xea50, 0xea50, 0xea50, 0x72a8, 0x72a8, 0x72a8, 0x72a8, 0x8944, 0x8944, 0x8944, 0x8944 },
+        { 0x5c0d, 0x5c0d, 0x5c0d, 0x5c0d, 0xaf1a, 0xaf1a, 0xaf1a, 0xaf1a, 0xb12d, 0xb12d, 0xb12d, 0xb12d, 0x9e08, 0x9e08, 0x9e08, 0x9e08 } },
+      { { 0x2074, 0x2074, 0x2d24, 0x2d24, 0xe99f, 0xe99f, 0xdca0, 0xdca0, 0x0d9c, 0x0d9c, 0xedee, 0xedee, 0x790a, 0x790a, 0x7f1e, 0x7f1e },
+        { 0x6c5a, 0x6c5a, 0xccb5, 0xccb5, 0x3a23, 0x3a23, 0xa5cc, 0xa5cc, 0xfc4f, 0xfc4f, 0x11eb, 0x11eb, 0xe7da, 0xe7da, 0xea8b, 0xea8b } } },
+    { { { 0xc040, 0xc040, 0xc040, 0xc040, 0xc040, 0xc040, 0xc040, 0xc040, 0x701f, 0x701f, 0x701f, 0x701f, 0x701f, 0x701f, 0x701f, 0x701f },
+        { 0xea3d, 0xea3d, 0xea3d, 0xea3d, 0xea3d, 0xea3d, 0xea3d, 0xea3d, 0x044e, 0x044e, 0x044e, 0x044e, 0x044e, 0x044e, 0x044e, 0x044e } },
+      { { 0x27ae, 0x27ae, 0x27ae, 0x27ae, 0xe764, 0xe764, 0xe764, 0xe764, 0xff63, 0xff63, 0xff63, 0xff63, 0xccc9, 0xccc9, 0xccc9, 0xccc9 },
+        { 0x31fc, 0x31fc, 0x31fc, 0x31fc, 0xc140, 0xc140, 0xc140, 0xc140, 0x9808, 0x9808, 0x9808, 0x9808, 0x309a, 0x309a, 0x309a, 0x309a } },
+      { { 0xed15, 0xed15, 0x3bd4, 0x3bd4, 0xc440, 0xc440, 0x720b, 0x720b, 0x5921, 0x5921, 0xf4b2, 0xf4b2, 0xd1b5, 0xd1b5, 0x560d, 0x560d },
+        { 0x82f6, 0x82f6, 0x7ef6, 0x7ef6, 0x8e09, 0x8e09, 0x4935, 0x4935, 0xd679, 0xd679, 0x8993, 0x8993, 0x705a, 0x705a, 0xcea1, 0xcea1 } } },
+    { { { 0x84ce, 0x84ce, 0x84ce, 0x84ce, 0x84ce, 0x84ce, 0x84ce, 0x84ce, 0xf601, 0xf601, 0xf601, 0xf601, 0xf601, 0xf601, 0xf601, 0xf601 },
+        { 0xac42, 0xac42, 0xac42, 0xac42, 0xac42, 0xac42, 0xac42, 0xac42, 0x6682, 0x6682, 0x6682, 0x6682, 0x6682, 0x6682, 0x6682, 0x6682 } },
+      { { 0x8393, 0x8393, 0x8393, 0x8393, 0x09b0, 0x09b0, 0x09b0, 0x09b0, 0xa6a4, 0xa6a4, 0xa6a4, 0xa6a4, 0x70f7, 0x70f7, 0x70f7, 0x70f7 },
+        { 0xdc52, 0xdc52, 0xdc52, 0xdc52, 0x6582, 0x6582, 0x6582, 0x6582, 0x028a, 0x028a, 0x028a, 0x028a, 0x9343, 0x9343, 0x9343, 0x9343 } },
+      { { 0x85bb, 0x85bb, 0x3186, 0x3186, 0x2025, 0x2025, 0x194d, 0x194d, 0xbcf1, 0xbcf1, 0x1ad7, 0x1ad7, 0xf401, 0xf401, 0xfa3c, 0xfa3c },
+        { 0x4836, 0x4836, 0xb17c, 0xb17c, 0x385e, 0x385e, 0xb3b7, 0xb3b7, 0xbb68, 0xbb68, 0xb7a3, 0xb7a3, 0x149c, 0x149c, 0x314b, 0x314b } } },
+    { { { 0xcba2, 0xcba2, 0xcba2, 0xcba2, 0xcba2, 0xcba2, 0xcba2, 0xcba2, 0x4e35, 0x4e35, 0x4e35, 0x4e35, 0x4e35, 0x4e35, 0x4e35, 0x4e35 },
+        { 0x6da9, 0x6da9, 0x6da9, 0x6da9, 0x6da9, 0x6da9, 0x6da9, 0x6da9, 0xa107, 0xa107, 0xa107, 0xa107, 0xa107, 0xa107, 0xa107, 0xa107 } },
+      { { 0xbe68, 0xbe68, 0xbe68, 0xbe68, 0xeb29, 0xeb29, 0xeb29, 0xeb29, 0xf914, 0xf914, 0xf914, 0xf914, 0x3fd4, 0x3fd4, 0x3fd4, 0x3fd4 },
+        { 0xb255, 0xb255, 0xb255, 0xb255, 0x3e0f, 0x3e0f, 0x3e0f, 0x3e0f, 0x6e5a, 0x6e5a, 0x6e5a, 0x6e5a, 0x22c2, 0x22c2, 0x22c2, 0x22c2 } },
+      { { 0x3ed4, 0x3ed4, 0x545c, 0x545c, 0x65a9, 0x65a9, 0x9d2f, 0x9d2f, 0x2e5f, 0x2e5f, 0x2ee9, 0x2ee9, 0x8f57, 0x8f57, 0x1d88, 0x1d88 },
+        { 0x79cf, 0x79cf, 0xb0b7, 0xb0b7, 0x1cd6, 0x1cd6, 0xc405, 0xc405, 0x9ca5, 0x9ca5, 0xf79e, 0xf79e, 0xa0b9, 0xa0b9, 0x7e80, 0x7e80 } } },
+    { { { 0x384a, 0x384a, 0x384a, 0x384a, 0x384a, 0x384a, 0x384a, 0x384a, 0x2ec1, 0x2ec1, 0x2ec1, 0x2ec1, 0x2ec1, 0x2ec1, 0x2ec1, 0x2ec1 },
+        { 0x2924, 0x2924, 0x2924, 0x2924, 0x2924, 0x2924, 0x2924, 0x2924, 0xdda0, 0xdda0, 0xdda0, 0xdda0, 0xdda0, 0xdda0, 0xdda0, 0xdda0 } },
+      { { 0x083a, 0x083a, 0x083a, 0x083a, 0xed01, 0xed01, 0xed01, 0xed01, 0x92ba, 0x92ba, 0x92ba, 0x92ba, 0xb6de, 0xb6de, 0xb6de, 0xb6de },
+        { 0x6e95, 0x6e95, 0x6e95, 0x6e95, 0x75f7, 0x75f7, 0x75f7, 0x75f7, 0xdc8d, 0xdc8d, 0xdc8d, 0xdc8d, 0xb8b7, 0xb8b7, 0xb8b7, 0xb8b7 } },
+      { { 0xa291, 0xa291, 0xf58b, 0xf58b, 0xbcca, 0xbcca, 0x10eb, 0x10eb, 0x5daa, 0x5daa, 0x9957, 0x9957, 0xa4b8, 0xa4b8, 0x806c, 0x806c },
+        { 0x51bf, 0x51bf, 0x1888, 0x1888, 0xa16a, 0xa16a, 0x2b24, 0x2b24, 0xd53e, 0xd53e, 0x3a37, 0x3a37, 0xbda3, 0xbda3, 0xc77b, 0xc77b } } },
+    { { { 0x896c, 0x896c, 0x896c, 0x896c, 0x896c, 0x896c, 0x896c, 0x896c, 0x1f9b, 0x1f9b, 0x1f9b, 0x1f9b, 0x1f9b, 0x1f9b, 0x1f9b, 0x1f9b },
+        { 0xb806, 0xb806, 0xb806, 0xb806, 0xb806, 0xb806, 0xb806, 0xb806, 0xdd65, 0xdd65, 0xdd65, 0xdd65, 0xdd65, 0xdd65, 0xdd65, 0xdd65 } },
+      { { 0xe165, 0xe165, 0xe165, 0xe165, 0x8c09, 0x8c09, 0x8c09, 0x8c09, 0x49e7, 0x49e7, 0x49e7, 0x49e7, 0xc83f, 0xc83f, 0xc83f, 0xc83f },
+        { 0xcb8e, 0xcb8e, 0xcb8e, 0xcb8e, 0x71e4, 0x71e4, 0x71e4, 0x71e4, 0xc93f, 0xc93f, 0xc93f, 0xc93f, 0x31d5, 0x31d5, 0x31d5, 0x31d5 } },
+      { { 0xa4e0, 0xa4e0, 0x8a58, 0x8a58, 0x8be2, 0x8be2, 0xbe54, 0xbe54, 0x9db9, 0x9db9, 0x3d0f, 0x3d0f, 0xbd19, 0xbd19, 0x24c2, 0x24c2 },
+        { 0xd7a1, 0xd7a1, 0x53fa, 0x53fa, 0x57e6, 0x57e6, 0xa556, 0xa556, 0x1efe, 0x1efe, 0x4ee6, 0x4ee6, 0xd566, 0xd566, 0x4422, 0x4422 } } },
+    { { { 0xf03c, 0xf03c, 0xf03c, 0xf03c, 0xf03c, 0xf03c, 0xf03c, 0xf03c, 0x8731, 0x8731, 0x8731, 0x8731, 0x8731, 0x8731, 0x8731, 0x8731 },
+        { 0x97cd, 0x97cd, 0x97cd, 0x97cd, 0x97cd, 0x97cd, 0x97cd, 0x97cd, 0x3f23, 0x3f23, 0x3f23, 0x3f23, 0x3f23, 0x3f23, 0x3f23, 0x3f23 } },
+      { { 0x2274, 0x2274, 0x2274, 0x2274, 0x3410, 0x3410, 0x3410, 0x3410, 0xae1a, 0xae1a, 0xae1a, 0xae1a, 0x9df4, 0x9df4, 0x9df4, 0x9df4 },
+        { 0xbe40, 0xbe40, 0xbe40, 0xbe40, 0x5e5b, 0x5e5b, 0x5e5b, 0x5e5b, 0xef29, 0xef29, 0xef29, 0xef29, 0x45fb, 0x45fb, 0x45fb, 0x45fb } },
+      { { 0xf7b2, 0xf7b2, 0xe851, 0xe851, 0x49ac, 0x49ac, 0x8fba, 0x8fba, 0x4c98, 0x4c98, 0x4c35, 0x4c35, 0x750b, 0x750b, 0x7d31, 0x7d31 },
+        { 0x846c, 0x846c, 0x5d34, 0x5d34, 0xa242, 0xa242, 0xe1b4, 0xe1b4, 0x901c, 0x901c, 0x4f21, 0x4f21, 0x440e, 0x440e, 0xa5a4, 0xa5a4 } } }
+};
+
+static const uint16_t cckyber_avx2_zetas_inverse[8][3][2][16] = {
+    { { { 0x7d31, 0x7d31, 0x750b, 0x750b, 0x4c35, 0x4c35, 0x4c98, 0x4c98, 0x8fba, 0x8fba, 0x49ac, 0x49ac, 0xe851, 0xe851, 0xf7b2, 0xf7b2 },
+        { 0xa5a4, 0xa5a4, 0x440e, 0x440e, 0x4f21, 0x4f21, 0x901c, 0x901c, 0xe1b4, 0xe1b4, 0xa242, 0xa242, 0x5d34, 0x5d34, 0x846c, 0x846c } },
+      { { 0x9df4, 0x9df4, 0x9df4, 0x9df4, 0xae1a, 0xae1a, 0xae1a, 0xae1a, 0x3410, 0x3410, 0x3410, 0x3410, 0x2274, 0x2274, 0x2274, 0x2274 },
+        { 0x45fb, 0x45fb, 0x45fb, 0x45fb, 0xef29, 0xef29, 0xef29, 0xef29, 0x5e5b, 0x5e5b, 0x5e5b, 0x5e5b, 0xbe40, 0xbe40, 0xbe40, 0xbe40 } },
+      { { 0x8731, 0x8731, 0x8731, 0x8731, 0x8731, 0x8731, 0x8731, 0x8731, 0xf03c, 0xf03c, 0xf03c, 0xf03c, 0xf03c, 0xf03c, 0xf03c, 0xf03c },
+        { 0x3f23, 0x3f23, 0x3f23, 0x3f23, 0x3f23, 0x3f23, 0x3f23, 0x3f23, 0x97cd, 0x97cd, 0x97cd, 0x97cd, 0x97cd, 0x97cd, 0x97cd, 0x97cd } } },
+    { { { 0x24c2, 0x24c2, 0xbd19, 0xbd19, 0x3d0f, 0x3d0f, 0x9db9, 0x9db9, 0xbe54, 0xbe54, 0x8be2, 0x8be2, 0x8a58, 0x8a58, 0xa4e0, 0xa4e0 },
+        { 0x4422, 0x4422, 0xd566, 0xd566, 0x4ee6, 0x4ee6, 0x1efe, 0x1efe, 0xa556, 0xa556, 0x57e6, 0x57e6, 0x53fa, 0x53fa, 0xd7a1, 0xd7a1 } },
+      { { 0xc83f, 0xc83f, 0xc83f, 0xc83f, 0x49e7, 0x49e7, 0x49e7, 0x49e7, 0x8c09, 0x8c09, 0x8c09, 0x8c09, 0xe165, 0xe165, 0xe165, 0xe165 },
+        { 0x31d5, 0x31d5, 0x31d5, 0x31d5, 0xc93f, 0xc93f, 0xc93f, 0xc93f, 0x71e4, 0x71e4, 0x71e4, 0x71e4, 0xcb8e, 0xcb8e, 0xcb8e, 0xcb8e } },
+      { { 0x1f9b, 0x1f9b, 0x1f9b, 0x1f9b, 0x1f9b, 0x1f9b, 0x1f9b, 0x1f9b, 0x896c, 0x896c, 0x896c, 0x896c, 0x896c, 0x896c, 0x896c, 0x896c },
+        { 0xdd65, 0xdd65, 0xdd65, 0xdd65, 0xdd65, 0xdd65, 0xdd65, 0xdd65, 0xb806, 0xb806, 0xb806, 0xb806, 0xb806, 0xb806, 0xb806, 0xb806 } } },
+    { { { 0x806c, 0x806c, 0xa4b8, 0xa4b8, 0x9957, 0x9957, 0x5daa, 0x5daa, 0x10eb, 0x10eb, 0xbcca, 0xbcca, 0xf58b, 0xf58b, 0xa291, 0xa291 },
+        { 0xc77b, 0xc77b, 0xbda3, 0xbda3, 0x3a37, 0x3a37, 0xd53e, 0xd53e, 0x2b24, 0x2b24, 0xa16a, 0xa16a, 0x1888, 0x1888, 0x51bf, 0x51bf } },
+      { { 0xb6de, 0xb6de, 0xb6de, 0xb6de, 0x92ba, 0x92ba, 0x92ba, 0x92ba, 0xed01, 0xed01, 0xed01, 0xed01, 0x083a, 0x083a, 0x083a, 0x083a },
+        { 0xb8b7, 0xb8b7, 0xb8b7, 0xb8b7, 0xdc8d, 0xdc8d, 0xdc8d, 0xdc8d, 0x75f7, 0x75f7, 0x75f7, 0x75f7, 0x6e95, 0x6e95, 0x6e95, 0x6e95 } },
+      { { 0x2ec1, 0x2ec1, 0x2ec1, 0x2ec1, 0x2ec1, 0x2ec1, 0x2ec1, 0x2ec1, 0x384a, 0x384a, 0x384a, 0x384a, 0x384a, 0x384a, 0x384a, 0x384a },
+        { 0xdda0, 0xdda0, 0xdda0, 0xdda0, 0xdda0, 0xdda0, 0xdda0, 0xdda0, 0x2924, 0x2924, 0x2924, 0x2924, 0x2924, 0x2924, 0x2924, 0x2924 } } },
+    { { { 0x1d88, 0x1d88, 0x8f57, 0x8f57, 0x2ee9, 0x2ee9, 0x2e5f, 0x2e5f, 0x9d2f, 0x9d2f, 0x65a9, 0x65a9, 0x545c, 0x545c, 0x3ed4, 0x3ed4 },
+        { 0x7e80, 0x7e80, 0xa0b9, 0xa0b9, 0xf79e, 0xf79e, 0x9ca5, 0x9ca5, 0xc405, 0xc405, 0x1cd6, 0x1cd6, 0xb0b7, 0xb0b7, 0x79cf, 0x79cf } },
+      { { 0x3fd4, 0x3fd4, 0x3fd4, 0x3fd4, 0xf914, 0xf914, 0xf914, 0xf914, 0xeb29, 0xeb29, 0xeb29, 0xeb29, 0xbe68, 0xbe68, 0xbe68, 0xbe68 },
+        { 0x22c2, 0x22c2, 0x22c2, 0x22c2, 0x6e5a, 0x6e5a, 0x6e5a, 0x6e5a, 0x3e0f, 0x3e0f, 0x3e0f, 0x3e0f, 0xb255, 0xb255, 0xb255, 0xb255 } },
+      { { 0x4e35, 0x4e35, 0x4e35, 0x4e35, 0x4e35, 0x4e35, 0x4e35, 0x4e35, 0xcba2, 0xcba2, 0xcba2, 0xcba2, 0xcba2, 0xcba2, 0xcba2, 0xcba2 },
+        { 0xa107, 0xa107, 0xa107, 0xa107, 0xa107, 0xa107, 0xa107, 0xa107, 0x6da9, 0x6da9, 0x6da9, 0x6da9, 0x6da9, 0x6da9, 0x6da9, 0x6da9 } } },
+    { { { 0xfa3c, 0xfa3c, 0xf401, 0xf401, 0x1ad7, 0x1ad7, 0xbcf1, 0xbcf1, 0x194d, 0x194d, 0x2025, 0x2025, 0x3186, 0x3186, 0x85bb, 0x85bb },
+        { 0x314b, 0x314b, 0x149c, 0x149c, 0xb7a3, 0xb7a3, 0xbb68, 0xbb68, 0xb3b7, 0xb3b7, 0x385e, 0x385e, 0xb17c, 0xb17c, 0x4836, 0x4836 } },
+      { { 0x70f7, 0x70f7, 0x70f7, 0x70f7, 0xa6a4, 0xa6a4, 0xa6a4, 0xa6a4, 0x09b0, 0x09b0, 0x09b0, 0x09b0, 0x8393, 0x8393, 0x8393, 0x8393 },
+        { 0x9343, 0x9343, 0x9343, 0x9343, 0x028a, 0x028a, 0x028a, 0x028a, 0x6582, 0x6582, 0x6582, 0x6582, 0xdc52, 0xdc52, 0xdc52, 0xdc52 } },
+      { { 0xf601, 0xf601, 0xf601, 0xf601, 0xf601, 0xf601, 0xf601, 0xf601, 0x84ce, 0x84ce, 0x84ce, 0x84ce, 0x84ce, 0x84ce, 0x84ce, 0x84ce },
+        { 0x6682, 0x6682, 0x6682, 0x6682, 0x6682, 0x6682, 0x6682, 0x6682, 0xac42, 0xac42, 0xac42, 0xac42, 0xac42, 0xac42, 0xac42, 0xac42 } } },
+    { { { 0x560d, 0x560d, 0xd1b5, 0xd1b5, 0xf4b2, 0xf4b2, 0x5921, 0x5921, 0x720b, 0x720b, 0xc440, 0xc440, 0x3bd4, 0x3bd4, 0xed15, 0xed15 },
+        { 0xcea1, 0xcea1, 0x705a, 0x705a, 0x8993, 0x8993, 0xd679, 0xd679, 0x4935, 0x4935, 0x8e09, 0x8e09, 0x7ef6, 0x7ef6, 0x82f6, 0x82f6 } },
+      { { 0xccc9, 0xccc9, 0xccc9, 0xccc9, 0xff63, 0xff63, 0xff63, 0xff63, 0xe764, 0xe764, 0xe764, 0xe764, 0x27ae, 0x27ae, 0x27ae, 0x27ae },
+        { 0x309a, 0x309a, 0x309a, 0x309a, 0x9808, 0x9808, 0x9808, 0x9808, 0xc140, 0xc140, 0xc140, 0xc140, 0x31fc, 0x31fc, 0x31fc, 0x31fc } },
+      { { 0x701f, 0x701f, 0x701f, 0x701f, 0x701f, 0x701f, 0x701f, 0x701f, 0xc040, 0xc040, 0xc040, 0xc040, 0xc040, 0xc040, 0xc040, 0xc040 },
+        { 0x044e, 0x044e, 0x044e, 0x044e, 0x044e, 0x044e, 0x044e, 0x044e, 0xea3d, 0xea3d, 0xea3d, 0xea3d, 0xea3d, 0xea3d, 0xea3d, 0xea3d } } },
+    { { { 0x7f1e, 0x7f1e, 0x790a, 0x790a, 0xedee, 0xedee, 0x0d9c, 0x0d9c, 0xdca0, 0xdca0, 0xe99f, 0xe99f, 0x2d24, 0x2d24, 0x2074, 0x2074 },
+        { 0xea8b, 0xea8b, 0xe7da, 0xe7da, 0x11eb, 0x11eb, 0xfc4f, 0xfc4f, 0xa5cc, 0xa5cc, 0x3a23, 0x3a23, 0xccb5, 0xccb5, 0x6c5a, 0x6c5a } },
+      { { 0x8944, 0x8944, 0x8944, 0x8944, 0x72a8, 0x72a8, 0x72a8, 0x72a8, 0xea50, 0xea50, 0xea50, 0xea50, 0x9c91, 0x9c91, 0x9c91, 0x9c91 },
+        { 0x9e08, 0x9e08, 0x9e08, 0x9e08, 0xb12d, 0xb12d, 0xb12d, 0xb12d, 0xaf1a, 0xaf1a, 0xaf1a, 0xaf1a, 0x5c0d, 0x5c0d, 0x5c0d, 0x5c0d } },
+      { { 0x1d74, 0x1d74, 0x1d74, 0x1d74, 0x1d74, 0x1d74, 0x1d74, 0x1d74, 0x144d, 0x144d, 0x144d, 0x144d, 0x144d, 0x144d, 0x144d, 0x144d },
+        { 0x7181, 0x7181, 0x7181, 0x7181, 0x7181, 0x7181, 0x7181, 0x7181, 0x66f8, 0x66f8, 0x66f8, 0x66f8, 0x66f8, 0x66f8, 0x66f8, 0x66f8 } } },
+    { { { 0x0813, 0x0813, 0x7732, 0x7732, 0x40d4, 0x40d4, 0x2aae, 0x2aae, 0x42fb, 0x42fb, 0x9fcc, 0x9fcc, 0x2111, 0x2111, 0xab2e, 0xab2e },
+        { 0x5497, 0x5497, 0xaff2, 0xaff2, 0xcbb5, 0xcbb5, 0x2cd5, 0x2cd5, 0x3799, 0x3799, 0x7de3, 0x7de3, 0xd452, 0xd452, 0x014f, 0x014f } },
+      { { 0x4e0e, 0x4e0e, 0x4e0e, 0x4e0e, 0x3224, 0x3224, 0x3224, 0x3224, 0xd58d, 0xd58d, 0xd58d, 0xd58d, 0x5e0c, 0x5e0c, 0x5e0c, 0x5e0c },
+        { 0x8709, 0x8709, 0x8709, 0x8709, 0x1974, 0x1974, 0x1974, 0x1974, 0xfa28, 0xfa28, 0xfa28, 0xfa28, 0x1639, 0x1639, 0x1639, 0x1639 } },
+      { { 0x9a1c, 0x9a1c, 0x9a1c, 0x9a1c, 0x9a1c, 0x9a1c, 0x9a1c, 0x9a1c, 0x2c10, 0x2c10, 0x2c10, 0x2c10, 0x2c10, 0x2c10, 0x2c10, 0x2c10 },
+        { 0xbc2d, 0xbc2d, 0xbc2d, 0xbc2d, 0xbc2d, 0xbc2d, 0xbc2d, 0xbc2d, 0x16c3, 0x16c3, 0x16c3, 0x16c3, 0x16c3, 0x16c3, 0x16c3, 0x16c3 } } }
+};
+
+static const uint16_t cckyber_avx2_zetas_basemul[8][2][16] = {
+    { { 0xab2e, 0x54d2, 0x2111, 0xdeef, 0x9fcc, 0x6034, 0x42fb, 0xbd05, 0x2aae, 0xd552, 0x40d4, 0xbf2c, 0x7732, 0x88ce, 0x0813, 0xf7ed },
+      { 0x014f, 0xfeb1, 0xd452, 0x2bae, 0x7de3, 0x821d, 0x3799, 0xc867, 0x2cd5, 0xd32b, 0xcbb5, 0x344b, 0xaff2, 0x500e, 0x5497, 0xab69 } },
+    { { 0x2074, 0xdf8c, 0x2d24, 0xd2dc, 0xe99f, 0x1661, 0xdca0, 0x2360, 0x0d9c, 0xf264, 0xedee, 0x1212, 0x790a, 0x86f6, 0x7f1e, 0x80e2 },
+      { 0x6c5a, 0x93a6, 0xccb5, 0x334b, 0x3a23, 0xc5dd, 0xa5cc, 0x5a34, 0xfc4f, 0x03b1, 0x11eb, 0xee15, 0xe7da, 0x1826, 0xea8b, 0x1575 } },
+    { { 0xed15, 0x12eb, 0x3bd4, 0xc42c, 0xc440, 0x3bc0, 0x720b, 0x8df5, 0x5921, 0xa6df, 0xf4b2, 0x0b4e, 0xd1b5, 0x2e4b, 0x560d, 0xa9f3 },
+      { 0x82f6, 0x7d0a, 0x7ef6, 0x810a, 0x8e09, 0x71f7, 0x4935, 0xb6cb, 0xd679, 0x2987, 0x8993, 0x766d, 0x705a, 0x8fa6, 0xcea1, 0x315f } },
+    { { 0x85bb, 0x7a45, 0x3186, 0xce7a, 0x2025, 0xdfdb, 0x194d, 0xe6b3, 0xbcf1, 0x430f, 0x1ad7, 0xe529, 0xf401, 0x0bff, 0xfa3c, 0x05c4 },
+      { 0x4836, 0xb7ca, 0xb17c, 0x4e84, 0x385e, 0xc7a2, 0xb3b7, 0x4c49, 0xbb68, 0x4498, 0xb7a3, 0x485d, 0x149c, 0xeb64, 0x314b, 0xceb5 } },
+    { { 0x3ed4, 0xc12c, 0x545c, 0xaba4, 0x65a9, 0x9a57, 0x9d2f, 0x62d1, 0x2e5f, 0xd1a1, 0x2ee9, 0xd117, 0x8f57, 0x70a9, 0x1d88, 0xe278 },
+      { 0x79cf, 0x8631, 0xb0b7, 0x4f49, 0x1cd6, 0xe32a, 0xc405, 0x3bfb, 0x9ca5, 0x635b, 0xf79e, 0x0862, 0xa0b9, 0x5f47, 0x7e80, 0x8180 } },
+    { { 0xa291, 0x5d6f, 0xf58b, 0x0a75, 0xbcca, 0x4336, 0x10eb, 0xef15, 0x5daa, 0xa256, 0x9957, 0x66a9, 0xa4b8, 0x5b48, 0x806c, 0x7f94 },
+      { 0x51bf, 0xae41, 0x1888, 0xe778, 0xa16a, 0x5e96, 0x2b24, 0xd4dc, 0xd53e, 0x2ac2, 0x3a37, 0xc5c9, 0xbda3, 0x425d, 0xc77b, 0x3885 } },
+    { { 0xa4e0, 0x5b20, 0x8a58, 0x75a8, 0x8be2, 0x741e, 0xbe54, 0x41ac, 0x9db9, 0x6247, 0x3d0f, 0xc2f1, 0xbd19, 0x42e7, 0x24c2, 0xdb3e },
+      { 0xd7a1, 0x285f, 0x53fa, 0xac06, 0x57e6, 0xa81a, 0xa556, 0x5aaa, 0x1efe, 0xe102, 0x4ee6, 0xb11a, 0xd566, 0x2a9a, 0x4422, 0xbbde } },
+    { { 0xf7b2, 0x084e, 0xe851, 0x17af, 0x49ac, 0xb654, 0x8fba, 0x7046, 0x4c98, 0xb368, 0x4c35, 0xb3cb, 0x750b, 0x8af5, 0x7d31, 0x82cf },
+      { 0x846c, 0x7b94, 0x5d34, 0xa2cc, 0xa242, 0x5dbe, 0xe1b4, 0x1e4c, 0x901c, 0x6fe4, 0x4f21, 0xb0df, 0x440e, 0xbbf2, 0xa5a4, 0x5a5c } }
+};
+
+/*! @function cckyber_avx2_zetas
+ @abstract Loads low and high halves of precomputed per-lane zetas.
+
+ @param z  Low and high halves.
+ @param lo Low halves.
+ @param hi High halves.
+ */
+CCKYBER_AVX2_TARGET
+static inline void cckyber_avx2_zetas(const uint16_t z[2][16], __m256i *lo, __m256i *hi)
+{
+    *lo = _mm256_loadu_si256((const __m256i *)z[0]);
+    *hi = _mm256_loadu_si256((const __m256i *)z[1]);
+}
+
+/*! @function cckyber_avx2_shuffle
+ @abstract Given 32 consecutive coefficients x || y, moves the top and bottom
+           halves of all butterflies of length 8, 4, or 2 to a and b.
+
+           The lane order is the one of cckyber_avx2_zetas_forward[].
+
+ @param len Length of the butterflies.
+ @param x   Coefficients 0-15.
+ @param y   Coefficients 16-31.
+ @param a   Top halves.
+ @param b   Bottom halves.
+ */
+CCKYBER_AVX2_TARGET
+static inline void cckyber_avx2_shuffle(unsigned len, __m256i x, __m256i y, __m256i *a, __m256i *b)
+{
+    if (len == 8) {
+        *a = _mm256_permute2x128_si256(x, y, 0x20);
+        *b = _mm256_permute2x128_si256(x, y, 0x31);
+    } else {
+        if (len == 2) {
+            x = _mm256_shuffle_epi32(x, 0xd8);
+            y = _mm256_shuffle_epi32(y, 0xd8);
+        }
+
+        *a = _mm256_unpacklo_epi64(x, y);
+        *b = _mm256_unpackhi_epi64(x, y);
+    }
+}
+
+/*! @function cckyber_avx2_unshuffle
+ @abstract Inverse of cckyber_avx2_shuffle().
+
+ @param len Length of the butterflies.
+ @param a   Top halves.
+ @param b   Bottom halves.
+ @param x   Coefficients 0-15.
+ @param y   Coefficients 16-31.
+ */
+CCKYBER_AVX2_TARGET
+static inline void cckyber_avx2_unshuffle(unsigned len, __m256i a, __m256i b, __m256i *x, __m256i *y)
+{
+    if (len == 8) {
+        *x = _mm256_permute2x128_si256(a, b, 0x20);
+        *y = _mm256_permute2x128_si256(a, b, 0x31);
+    } else {
+        *x = _mm256_unpacklo_epi64(a, b);
+        *y = _mm256_unpackhi_epi64(a, b);
+
+        if (len == 2) {
+            *x = _mm256_shuffle_epi32(*x, 0xd8);
+            *y = _mm256_shuffle_epi32(*y, 0xd8);
+        }
+    }
+}
+
+// CT butterfly, see cckyber_ntt_forward_layer().
+CCKYBER_AVX2_TARGET
+static inline void cckyber_avx2_ct(__m256i *a, __m256i *b, __m256i zlo, __m256i zhi)
+{
+    __m256i t = cckyber_avx2_mult_partial(zlo, zhi, *b);
+    *b = _mm256_sub_epi16(*a, t);
+    *a = _mm256_add_epi16(*a, t);
+}
+
+// GS butterfly, see cckyber_ntt_inverse_layer().
+CCKYBER_AVX2_TARGET
+static inline void cckyber_avx2_gs(__m256i *a, __m256i *b, __m256i zlo, __m256i zhi, __m256i flo, __m256i fhi)
+{
+    __m256i t = *a;
+    *a = cckyber_avx2_mult_partial(flo, fhi, _mm256_add_epi16(t, *b));
+    *b = _mm256_sub_epi16(*b, t);
+    *b = cckyber_avx2_mult_partial(zlo, zhi, *b);
+}
+
+CCKYBER_AVX2_TARGET
+void cckyber_ntt_forward_avx2(int16_t coeffs[256])
+{
+    __m256i zlo, zhi, a, b, x, y;
+    __m256i *p = (__m256i *)coeffs;
+
+    for (unsigned l = 7; l >= 4; l -= 1) {
+        unsigned len = 1 << l;
+        unsigned k = 128 >> l;
+
+        for (unsigned i = 0; i < 256; i += 2 * len) {
+            cckyber_avx2_broadcast(cckyber_zetas[k++], &zlo, &zhi);
+
+            for (unsigned j = i; j < i + len; j += 16) {
+                a = _mm256_loadu_si256(&p[j / 16]);
+                b = _mm256_loadu_si256(&p[(j + len) / 16]);
+                cckyber_avx2_ct(&a, &b, zlo, zhi);
+                _mm256_storeu_si256(&p[j / 16], a);
+                _mm256_storeu_si256(&p[(j + len) / 16], b);
+            }
+        }
+    }
+
+    // Butterflies of length 8, 4, and 2 on 32 coefficients at a time.
+    for (unsigned i = 0; i < 256; i += 32) {
+        x = _mm256_loadu_si256(&p[i / 16 + 0]);
+        y = _mm256_loadu_si256(&p[i / 16 + 1]);
+
+        for (unsigned l = 3; l >= 1; l -= 1) {
+            unsigned len = 1 << l;
+
+            cckyber_avx2_zetas(cckyber_avx2_zetas_forward[i / 32][3 - l], &zlo, &zhi);
+            cckyber_avx2_shuffle(len, x, y, &a, &b);
+            cckyber_avx2_ct(&a, &b, zlo, zhi);
+            cckyber_avx2_unshuffle(len, a, b, &x, &y);
+        }
+
+        _mm256_storeu_si256(&p[i / 16 + 0], x);
+        _mm256_storeu_si256(&p[i / 16 + 1], y);
+    }
+}
+
+CCKYBER_AVX2_TARGET
+void cckyber_ntt_inverse_avx2(int16_t coeffs[256])
+{
+    __m256i zlo, zhi, flo, fhi, a, b, x, y;
+    __m256i *p = (__m256i *)coeffs;
+
+    // See cckyber_mult_reduce().
+    cckyber_avx2_broadcast(1290168, &flo, &fhi);
+
+    // Butterflies of length 2, 4, and 8 on 32 coefficients at a time.
+    for (unsigned i = 0; i < 256; i += 32) {
+        x = _mm256_loadu_si256(&p[i / 16 + 0]);
+        y = _mm256_loadu_si256(&p[i / 16 + 1]);
+
+        for (unsigned l = 1; l <= 3; l += 1) {
+            unsigned len = 1 << l;
+
+            cckyber_avx2_zetas(cckyber_avx2_zetas_inverse[i / 32][l - 1], &zlo, &zhi);
+            cckyber_avx2_shuffle(len, x, y, &a, &b);
+            cckyber_avx2_gs(&a, &b, zlo, zhi, flo, fhi);
+            cckyber_avx2_unshuffle(len, a, b, &x, &y);
+        }
+
+        _mm256_storeu_si256(&p[i / 16 + 0], x);
+        _mm256_storeu_si256(&p[i / 16 + 1], y);
+    }
+
+    for (unsigned l = 4; l <= 6; l += 1) {
+        unsigned len = 1 << l;
+        unsigned k = (128 >> (l - 1)) - 1;
+
+        for (unsigned i = 0; i < 256; i += 2 * len) {
+            cckyber_avx2_broadcast(cckyber_zetas[k--], &zlo, &zhi);
+
+            for (unsigned j = i; j < i + len; j += 16) {
+                a = _mm256_loadu_si256(&p[j / 16]);
+                b = _mm256_loadu_si256(&p[(j + len) / 16]);
+                cckyber_avx2_gs(&a, &b, zlo, zhi, flo, fhi);
+                _mm256_storeu_si256(&p[j / 16], a);
+                _mm256_storeu_si256(&p[(j + len) / 16], b);
+            }
+        }
+    }
+
+    // 7th and last layer, see cckyber_ntt_inverse_layer_7th().
+    cckyber_avx2_broadcast(2492603429, &zlo, &zhi);
+    cckyber_avx2_broadcast(2435836063, &flo, &fhi);
+
+    for (unsigned j = 0; j < 128; j += 16) {
+        a = _mm256_loadu_si256(&p[j / 16]);
+        b = _mm256_loadu_si256(&p[(j + 128) / 16]);
+        cckyber_avx2_gs(&a, &b, zlo, zhi, flo, fhi);
+        _mm256_storeu_si256(&p[j / 16], a);
+        _mm256_storeu_si256(&p[(j + 128) / 16], b);
+    }
+}
+
+/*! @function cckyber_avx2_deinterleave
+ @abstract Splits 16 degree-1 polynomials into their constant and linear
+           coefficients.
+
+ @param x Coefficients 0-15.
+ @param y Coefficients 16-31.
+ @param e Constant coefficients.
+ @param o Linear coefficients.
+ */
+CCKYBER_AVX2_TARGET
+static inline void cckyber_avx2_deinterleave(__m256i x, __m256i y, __m256i *e, __m256i *o)
+{
+    const __m256i idx = _mm256_setr_epi8(0, 1, 4, 5, 8, 9, 12, 13, 2, 3, 6, 7, 10, 11, 14, 15,
+                                         0, 1, 4, 5, 8, 9, 12, 13, 2, 3, 6, 7, 10, 11, 14, 15);
+
+    x = _mm256_shuffle_epi8(x, idx);
+    y = _mm256_shuffle_epi8(y, idx);
+
+    *e = _mm256_unpacklo_epi64(x, y);
+    *o = _mm256_unpackhi_epi64(x, y);
+}
+
+/*! @function cckyber_avx2_interleave
+ @abstract Inverse of cckyber_avx2_deinterleave().
+
+ @param e Constant coefficients.
+ @param o Linear coefficients.
+ @param x Coefficients 0-15.
+ @param y Coefficients 16-31.
+ */
+CCKYBER_AVX2_TARGET
+static inline void cckyber_avx2_interleave(__m256i e, __m256i o, __m256i *x, __m256i *y)
+{
+    const __m256i idx = _mm256_setr_epi8(0, 1, 8, 9, 2, 3, 10, 11, 4, 5, 12, 13, 6, 7, 14, 15,
+                                         0, 1, 8, 9, 2, 3, 10, 11, 4, 5, 12, 13, 6, 7, 14, 15);
+
+    *x = _mm256_shuffle_epi8(_mm256_unpacklo_epi64(e, o), idx);
+    *y = _mm256_shuffle_epi8(_mm256_unpackhi_epi64(e, o), idx);
+}
+
+CCKYBER_AVX2_TARGET
+void cckyber_ntt_basemul_avx2(int16_t coeffs[256], const int16_t a[256], const int16_t b[256])
+{
+    const __m256i *pa = (const __m256i *)a;
+    const __m256i *pb = (const __m256i *)b;
+    __m256i *pc = (__m256i *)coeffs;
+
+    for (unsigned i = 0; i < 256; i += 32) {
+        __m256i a0, a1, b0, b1, c0, c1, x, y;
+        __m256i a0lo, a0hi, a1lo, a1hi;
+
+        cckyber_avx2_deinterleave(_mm256_loadu_si256(&pa[i / 16]), _mm256_loadu_si256(&pa[i / 16 + 1]), &a0, &a1);
+        cckyber_avx2_deinterleave(_mm256_loadu_si256(&pb[i / 16]), _mm256_loadu_si256(&pb[i / 16 + 1]), &b0, &b1);
+
+        // Polynomials 2j and 2j+1 use zeta and -zeta, respectively.
+        __m256i zlo, zhi;
+        cckyber_avx2_zetas(cckyber_avx2_zetas_basemul[i / 32], &zlo, &zhi);
+
+        cckyber_avx2_mult_precomp(a0, &a0lo, &a0hi);
+        cckyber_avx2_mult_precomp(a1, &a1lo, &a1hi);
+
+        // c[0] = (a[0] · b[0]) + ((a[1] · b[1]) · r) (mod q)
+        c0 = cckyber_avx2_mult_partial(a1lo, a1hi, b1);
+        c0 = cckyber_avx2_mult_partial(zlo, zhi, c0);
+        c0 = _mm256_add_epi16(c0, cckyber_avx2_mult_partial(a0lo, a0hi, b0));
+
+        // c[1] = (a[0] · b[1]) + (a[1] · b[0]) (mod q)
+        c1 = cckyber_avx2_mult_partial(a0lo, a0hi, b1);
+        c1 = _mm256_add_epi16(c1, cckyber_avx2_mult_partial(a1lo, a1hi, b0));
+
+        cckyber_avx2_interleave(c0, c1, &x, &y);
+        _mm256_storeu_si256(&pc[i / 16 + 0], x);
+        _mm256_storeu_si256(&pc[i / 16 + 1], y);
+    }
+}
+
+/*! @function cckyber_avx2_compress8
+ @abstract Compresses eight 32-bit coefficients, see cckyber_compress_coefficient().
+
+ @param x Coefficients.
+ @param d Parameter d.
+
+ @return The compressed d-bit coefficients.
+ */
+CCKYBER_AVX2_TARGET
+static inline __m256i cckyber_avx2_compress8(__m256i x, unsigned d)
+{
+    // Precompute M, for fast division by q.
+    const __m256i M = _mm256_set1_epi64x(0xffffffff / CCKYBER_Q + 1);
+    const __m256i q = _mm256_set1_epi32(CCKYBER_Q);
+    const __m256i mask = _mm256_set1_epi32((1 << d) - 1);
+
+    // To positive standard representative. If u < 0 then u += q.
+    x = _mm256_add_epi32(x, _mm256_and_si256(_mm256_srai_epi32(x, 31), q));
+
+    // (u << d) + q/2
+    x = _mm256_sll_epi32(x, _mm_cvtsi32_si128((int)d));
+    x = _mm256_add_epi32(x, _mm256_set1_epi32(CCKYBER_Q >> 1));
+
+    // (x * M) >> 32, in even and odd lanes.
+    __m256i e = _mm256_srli_epi64(_mm256_mul_epu32(x, M), 32);
+    __m256i o = _mm256_mul_epu32(_mm256_srli_epi64(x, 32), M);
+
+    return _mm256_and_si256(_mm256_blend_epi32(e, o, 0xaa), mask);
+}
+
+CCKYBER_AVX2_TARGET
+void cckyber_compress_avx2(int16_t u[256], const int16_t coeffs[256], unsigned d)
+{
+    const __m128i *in = (const __m128i *)coeffs;
+    __m256i *out = (__m256i *)u;
+
+    for (unsigned i = 0; i < 256 / 16; i++) {
+        __m256i lo = cckyber_avx2_compress8(_mm256_cvtepi16_epi32(_mm_loadu_si128(&in[2 * i + 0])), d);
+        __m256i hi = cckyber_avx2_compress8(_mm256_cvtepi16_epi32(_mm_loadu_si128(&in[2 * i + 1])), d);
+
+        // Pack to 16 bits, and undo the lane interleaving of packus().
+        __m256i r = _mm256_permute4x64_epi64(_mm256_packus_epi32(lo, hi), 0xd8);
+        _mm256_storeu_si256(&out[i], r);
+    }
+}
+
+// Indices of the set bits of each 8-bit mask, used to move accepted
+// coefficients to the front of a vector.
+static const uint8_t cckyber_avx2_compact[256][8] = {
+    { 0, 0, 0, 0, 0, 0, 0, 0 }, { 0, 0, 0, 0, 0, 0, 0, 0 }, { 1, 0, 0, 0, 0, 0, 0, 0 }, { 0, 1, 0, 0, 0, 0, 0, 0 },
+    { 2, 0, 0, 0, 0, 0, 0, 0 }, { 0, 2, 0, 0, 0, 0, 0, 0 }, { 1, 2, 0, 0, 0, 0, 0, 0 }, { 0, 1, 2, 0, 0, 0, 0, 0 },
+    { 3, 0, 0, 0, 0, 0, 0, 0 }, { 0, 3, 0, 0, 0, 0, 0, 0 }, { 1, 3, 0, 0, 0, 0, 0, 0 }, { 0, 1, 3, 0, 0, 0, 0, 0 },
+    { 2, 3, 0, 0, 0, 0, 0, 0 }, { 0, 2, 3, 0, 0, 0, 0, 0 }, { 1, 2, 3, 0, 0, 0, 0, 0 }, { 0, 1, 2, 3, 0, 0, 0, 0 },
+    { 4, 0, 0, 0, 0, 0, 0, 0 }, { 0, 4, 0, 0, 0, 0, 0, 0 }, { 1, 4, 0, 0, 0, 0, 0, 0 }, { 0, 1, 4, 0, 0, 0, 0, 0 },
+    { 2, 4, 0, 0, 0, 0, 0, 0 }, { 0, 2, 4, 0, 0, 0, 0, 0 }, { 1, 2, 4, 0, 0, 0, 0, 0 }, { 0, 1, 2, 4, 0, 0, 0, 0 },
+    { 3, 4, 0, 0, 0, 0, 0, 0 }, { 0, 3, 4, 0, 0, 0, 0, 0 }, { 1, 3, 4, 0, 0, 0, 0, 0 }, { 0, 1, 3, 4, 0, 0, 0, 0 },
+    { 2, 3, 4, 0, 0, 0, 0, 0 }, { 0, 2, 3, 4, 0, 0, 0, 0 }, { 1, 2, 3, 4, 0, 0, 0, 0 }, { 0, 1, 2, 3, 4, 0, 0, 0 },
+    { 5, 0, 0, 0, 0, 0, 0, 0 }, { 0, 5, 0, 0, 0, 0, 0, 0 }, { 1, 5, 0, 0, 0, 0, 0, 0 }, { 0, 1, 5, 0, 0, 0, 0, 0 },
+    { 2, 5, 0, 0, 0, 0, 0, 0 }, { 0, 2, 5, 0, 0, 0, 0, 0 }, { 1, 2, 5, 0, 0, 0, 0, 0 }, { 0, 1, 2, 5, 0, 0, 0, 0 },
+    { 3, 5, 0, 0, 0, 0, 0, 0 }, { 0, 3, 5, 0, 0, 0, 0, 0 }, { 1, 3, 5, 0, 0, 0, 0, 0 }, { 0, 1, 3, 5, 0, 0, 0, 0 },
+    { 2, 3, 5, 0, 0, 0, 0, 0 }, { 0, 2, 3, 5, 0, 0, 0, 0 }, { 1, 2, 3, 5, 0, 0, 0, 0 }, { 0, 1, 2, 3, 5, 0, 0, 0 },
+    { 4, 5, 0, 0, 0, 0, 0, 0 }, { 0, 4, 5, 0, 0, 0, 0, 0 }, { 1, 4, 5, 0, 0, 0, 0, 0 }, { 0, 1, 4, 5, 0, 0, 0, 0 },
+    { 2, 4, 5, 0, 0, 0, 0, 0 }, { 0, 2, 4, 5, 0, 0, 0, 0 }, { 1, 2, 4, 5, 0, 0, 0, 0 }, { 0, 1, 2, 4, 5, 0, 0, 0 },
+    { 3, 4, 5, 0, 0, 0, 0, 0 }, { 0, 3, 4, 5, 0, 0, 0, 0 }, { 1, 3, 4, 5, 0, 0, 0, 0 }, { 0, 1, 3, 4, 5, 0, 0, 0 },
+    { 2, 3, 4, 5, 0, 0, 0, 0 }, { 0, 2, 3, 4, 5, 0, 0, 0 }, { 1, 2, 3, 4, 5, 0, 0, 0 }, { 0, 1, 2, 3, 4, 5, 0, 0 },
+    { 6, 0, 0, 0, 0, 0, 0, 0 }, { 0, 6, 0, 0, 0, 0, 0, 0 }, { 1, 6, 0, 0, 0, 0, 0, 0 }, { 0, 1, 6, 0, 0, 0, 0, 0 },
+    { 2, 6, 0, 0, 0, 0, 0, 0 }, { 0, 2, 6, 0, 0, 0, 0, 0 }, { 1, 2, 6, 0, 0, 0, 0, 0 }, { 0, 1, 2, 6, 0, 0, 0, 0 },
+    { 3, 6, 0, 0, 0, 0, 0, 0 }, { 0, 3, 6, 0, 0, 0, 0, 0 }, { 1, 3, 6, 0, 0, 0, 0, 0 }, { 0, 1, 3, 6, 0, 0, 0, 0 },
+    { 2, 3, 6, 0, 0, 0, 0, 0 }, { 0, 2, 3, 6, 0, 0, 0, 0 }, { 1, 2, 3, 6, 0, 0, 0, 0 }, { 0, 1, 2, 3, 6, 0, 0, 0 },
+    { 4, 6, 0, 0, 0, 0, 0, 0 }, { 0, 4, 6, 0, 0, 0, 0, 0 }, { 1, 4, 6, 0, 0, 0, 0, 0 }, { 0, 1, 4, 6, 0, 0, 0, 0 },
+    { 2, 4, 6, 0, 0, 0, 0, 0 }, { 0, 2, 4, 6, 0, 0, 0, 0 }, { 1, 2, 4, 6, 0, 0, 0, 0 }, { 0, 1, 2, 4, 6, 0, 0, 0 },
+    { 3, 4, 6, 0, 0, 0, 0, 0 }, { 0, 3, 4, 6, 0, 0, 0, 0 }, { 1, 3, 4, 6, 0, 0, 0, 0 }, { 0, 1, 3, 4, 6, 0, 0, 0 },
+    { 2, 3, 4, 6, 0, 0, 0, 0 }, { 0, 2, 3, 4, 6, 0, 0, 0 }, { 1, 2, 3, 4, 6, 0, 0, 0 }, { 0, 1, 2, 3, 4, 6, 0, 0 },
+    { 5, 6, 0, 0, 0, 0, 0, 0 }, { 0, 5, 6, 0, 0, 0, 0, 0 }, { 1, 5, 6, 0, 0, 0, 0, 0 }, { 0, 1, 5, 6, 0, 0, 0, 0 },
+    { 2, 5, 6, 0, 0, 0, 0, 0 }, { 0, 2, 5, 6, 0, 0, 0, 0 }, { 1, 2, 5, 6, 0, 0, 0, 0 }, { 0, 1, 2, 5, 6, 0, 0, 0 },
+    { 3, 5, 6, 0, 0, 0, 0, 0 }, { 0, 3, 5, 6, 0, 0, 0, 0 }, { 1, 3, 5, 6, 0, 0, 0, 0 }, { 0, 1, 3, 5, 6, 0, 0, 0 },
+    { 2, 3, 5, 6, 0, 0, 0, 0 }, { 0, 2, 3, 5, 6, 0, 0, 0 }, { 1, 2, 3, 5, 6, 0, 0, 0 }, { 0, 1, 2, 3, 5, 6, 0, 0 },
+    { 4, 5, 6, 0, 0, 0, 0, 0 }, { 0, 4, 5, 6, 0, 0, 0, 0 }, { 1, 4, 5, 6, 0, 0, 0, 0 }, { 0, 1, 4, 5, 6, 0, 0, 0 },
+    { 2, 4, 5, 6, 0, 0, 0, 0 }, { 0, 2, 4, 5, 6, 0, 0, 0 }, { 1, 2, 4, 5, 6, 0, 0, 0 }, { 0, 1, 2, 4, 5, 6, 0, 0 },
+    { 3, 4, 5, 6, 0, 0, 0, 0 }, { 0, 3, 4, 5, 6, 0, 0, 0 }, { 1, 3, 4, 5, 6, 0, 0, 0 }, { 0, 1, 3, 4, 5, 6, 0, 0 },
+    { 2, 3, 4, 5, 6, 0, 0, 0 }, { 0, 2, 3, 4, 5, 6, 0, 0 }, { 1, 2, 3, 4, 5, 6, 0, 0 }, { 0, 1, 2, 3, 4, 5, 6, 0 },
+    { 7, 0, 0, 0, 0, 0, 0, 0 }, { 0, 7, 0, 0, 0, 0, 0, 0 }, { 1, 7, 0, 0, 0, 0, 0, 0 }, { 0, 1, 7, 0, 0, 0, 0, 0 },
+    { 2, 7, 0, 0, 0, 0, 0, 0 }, { 0, 2, 7, 0, 0, 0, 0, 0 }, { 1, 2, 7, 0, 0, 0, 0, 0 }, { 0, 1, 2, 7, 0, 0, 0, 0 },
+    { 3, 7, 0, 0, 0, 0, 0, 0 }, { 0, 3, 7, 0, 0, 0, 0, 0 }, { 1, 3, 7, 0, 0, 0, 0, 0 }, { 0, 1, 3, 7, 0, 0, 0, 0 },
+    { 2, 3, 7, 0, 0, 0, 0, 0 }, { 0, 2, 3, 7, 0, 0, 0, 0 }, { 1, 2, 3, 7, 0, 0, 0, 0 }, { 0, 1, 2, 3, 7, 0, 0, 0 },
+    { 4, 7, 0, 0, 0, 0, 0, 0 }, { 0, 4, 7, 0, 0, 0, 0, 0 }, { 1, 4, 7, 0, 0, 0, 0, 0 }, { 0, 1, 4, 7, 0, 0, 0, 0 },
+    { 2, 4, 7, 0, 0, 0, 0, 0 }, { 0, 2, 4, 7, 0, 0, 0, 0 }, { 1, 2, 4, 7, 0, 0, 0, 0 }, { 0, 1, 2, 4, 7, 0, 0, 0 },
+    { 3, 4, 7, 0, 0, 0, 0, 0 }, { 0, 3, 4, 7, 0, 0, 0, 0 }, { 1, 3, 4, 7, 0, 0, 0, 0 }, { 0, 1, 3, 4, 7, 0, 0, 0 },
+    { 2, 3, 4, 7, 0, 0, 0, 0 }, { 0, 2, 3, 4, 7, 0, 0, 0 }, { 1, 2, 3, 4, 7, 0, 0, 0 }, { 0, 1, 2, 3, 4, 7, 0, 0 },
+    { 5, 7, 0, 0, 0, 0, 0, 0 }, { 0, 5, 7, 0, 0, 0, 0, 0 }, { 1, 5, 7, 0, 0, 0, 0, 0 }, { 0, 1, 5, 7, 0, 0, 0, 0 },
+    { 2, 5, 7, 0, 0, 0, 0, 0 }, { 0, 2, 5, 7, 0, 0, 0, 0 }, { 1, 2, 5, 7, 0, 0, 0, 0 }, { 0, 1, 2, 5, 7, 0, 0, 0 },
+    { 3, 5, 7, 0, 0, 0, 0, 0 }, { 0, 3, 5, 7, 0, 0, 0, 0 }, { 1, 3, 5, 7, 0, 0, 0, 0 }, { 0, 1, 3, 5, 7, 0, 0, 0 },
+    { 2, 3, 5, 7, 0, 0, 0, 0 }, { 0, 2, 3, 5, 7, 0, 0, 0 }, { 1, 2, 3, 5, 7, 0, 0, 0 }, { 0, 1, 2, 3, 5, 7, 0, 0 },
+    { 4, 5, 7, 0, 0, 0, 0, 0 }, { 0, 4, 5, 7, 0, 0, 0, 0 }, { 1, 4, 5, 7, 0, 0, 0, 0 }, { 0, 1, 4, 5, 7, 0, 0, 0 },
+    { 2, 4, 5, 7, 0, 0, 0, 0 }, { 0, 2, 4, 5, 7, 0, 0, 0 }, { 1, 2, 4, 5, 7, 0, 0, 0 }, { 0, 1, 2, 4, 5, 7, 0, 0 },
+    { 3, 4, 5, 7, 0, 0, 0, 0 }, { 0, 3, 4, 5, 7, 0, 0, 0 }, { 1, 3, 4, 5, 7, 0, 0, 0 }, { 0, 1, 3, 4, 5, 7, 0, 0 },
+    { 2, 3, 4, 5, 7, 0, 0, 0 }, { 0, 2, 3, 4, 5, 7, 0, 0 }, { 1, 2, 3, 4, 5, 7, 0, 0 }, { 0, 1, 2, 3, 4, 5, 7, 0 },
+    { 6, 7, 0, 0, 0, 0, 0, 0 }, { 0, 6, 7, 0, 0, 0, 0, 0 }, { 1, 6, 7, 0, 0, 0, 0, 0 }, { 0, 1, 6, 7, 0, 0, 0, 0 },
+    { 2, 6, 7, 0, 0, 0, 0, 0 }, { 0, 2, 6, 7, 0, 0, 0, 0 }, { 1, 2, 6, 7, 0, 0, 0, 0 }, { 0, 1, 2, 6, 7, 0, 0, 0 },
+    { 3, 6, 7, 0, 0, 0, 0, 0 }, { 0, 3, 6, 7, 0, 0, 0, 0 }, { 1, 3, 6, 7, 0, 0, 0, 0 }, { 0, 1, 3, 6, 7, 0, 0, 0 },
+    { 2, 3, 6, 7, 0, 0, 0, 0 }, { 0, 2, 3, 6, 7, 0, 0, 0 }, { 1, 2, 3, 6, 7, 0, 0, 0 }, { 0, 1, 2, 3, 6, 7, 0, 0 },
+    { 4, 6, 7, 0, 0, 0, 0, 0 }, { 0, 4, 6, 7, 0, 0, 0, 0 }, { 1, 4, 6, 7, 0, 0, 0, 0 }, { 0, 1, 4, 6, 7, 0, 0, 0 },
+    { 2, 4, 6, 7, 0, 0, 0, 0 }, { 0, 2, 4, 6, 7, 0, 0, 0 }, { 1, 2, 4, 6, 7, 0, 0, 0 }, { 0, 1, 2, 4, 6, 7, 0, 0 },
+    { 3, 4, 6, 7, 0, 0, 0, 0 }, { 0, 3, 4, 6, 7, 0, 0, 0 }, { 1, 3, 4, 6, 7, 0, 0, 0 }, { 0, 1, 3, 4, 6, 7, 0, 0 },
+    { 2, 3, 4, 6, 7, 0, 0, 0 }, { 0, 2, 3, 4, 6, 7, 0, 0 }, { 1, 2, 3, 4, 6, 7, 0, 0 }, { 0, 1, 2, 3, 4, 6, 7, 0 },
+    { 5, 6, 7, 0, 0, 0, 0, 0 }, { 0, 5, 6, 7, 0, 0, 0, 0 }, { 1, 5, 6, 7, 0, 0, 0, 0 }, { 0, 1, 5, 6, 7, 0, 0, 0 },
+    { 2, 5, 6, 7, 0, 0, 0, 0 }, { 0, 2, 5, 6, 7, 0, 0, 0 }, { 1, 2, 5, 6, 7, 0, 0, 0 }, { 0, 1, 2, 5, 6, 7, 0, 0 },
+    { 3, 5, 6, 7, 0, 0, 0, 0 }, { 0, 3, 5, 6, 7, 0, 0, 0 }, { 1, 3, 5, 6, 7, 0, 0, 0 }, { 0, 1, 3, 5, 6, 7, 0, 0 },
+    { 2, 3, 5, 6, 7, 0, 0, 0 }, { 0, 2, 3, 5, 6, 7, 0, 0 }, { 1, 2, 3, 5, 6, 7, 0, 0 }, { 0, 1, 2, 3, 5, 6, 7, 0 },
+    { 4, 5, 6, 7, 0, 0, 0, 0 }, { 0, 4, 5, 6, 7, 0, 0, 0 }, { 1, 4, 5, 6, 7, 0, 0, 0 }, { 0, 1, 4, 5, 6, 7, 0, 0 },
+    { 2, 4, 5, 6, 7, 0, 0, 0 }, { 0, 2, 4, 5, 6, 7, 0, 0 }, { 1, 2, 4, 5, 6, 7, 0, 0 }, { 0, 1, 2, 4, 5, 6, 7, 0 },
+    { 3, 4, 5, 6, 7, 0, 0, 0 }, { 0, 3, 4, 5, 6, 7, 0, 0 }, { 1, 3, 4, 5, 6, 7, 0, 0 }, { 0, 1, 3, 4, 5, 6, 7, 0 },
+    { 2, 3, 4, 5, 6, 7, 0, 0 }, { 0, 2, 3, 4, 5, 6, 7, 0 }, { 1, 2, 3, 4, 5, 6, 7, 0 }, { 0, 1, 2, 3, 4, 5, 6, 7 },
+};
+
+CCKYBER_AVX2_TARGET
+unsigned cckyber_sample_uniform_avx2(const uint8_t buf[168], size_t ncoeffs, int16_t *coeffs, size_t *ctr)
+{
+    // Gather bytes {3i, 3i+1} and {3i+1, 3i+2} into 16-bit lanes. The
+    // second 128-bit lane starts at byte 4 of its input, see below.
+    const __m256i idx = _mm256_setr_epi8(0, 1, 1, 2, 3, 4, 4, 5, 6, 7, 7, 8, 9, 10, 10, 11,
+                                         4, 5, 5, 6, 7, 8, 8, 9, 10, 11, 11, 12, 13, 14, 14, 15);
+    const __m256i q = _mm256_set1_epi16(CCKYBER_Q);
+    const __m256i mask = _mm256_set1_epi16(0xfff);
+
+    unsigned i = 0;
+
+    // Each iteration consumes 24 bytes, but reads 32.
+    for (; 3 * i + 32 <= 168 && *ctr + 16 <= ncoeffs; i += 8) {
+        // Bytes 0-15 to the first 128-bit lane, bytes 8-23 to the second.
+        __m256i v = _mm256_loadu_si256((const __m256i *)&buf[3 * i]);
+        v = _mm256_permute4x64_epi64(v, 0x94);
+        v = _mm256_shuffle_epi8(v, idx);
+
+        // Odd lanes hold the upper 12 bits of their 16.
+        v = _mm256_blend_epi16(v, _mm256_srli_epi16(v, 4), 0xaa);
+        v = _mm256_and_si256(v, mask);
+
+        // Accept all v < q.
+        __m256i good = _mm256_cmpgt_epi16(q, v);
+        uint32_t bits = (uint32_t)_mm256_movemask_epi8(_mm256_packs_epi16(good, _mm256_setzero_si256()));
+
+        __m128i halves[2] = { _mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1) };
+
+        for (unsigned j = 0; j < 2; j++) {
+            uint8_t m = (uint8_t)(bits >> (16 * j));
+
+            // Shuffle indices for 16-bit lanes: (2k, 2k+1).
+            __m128i c = _mm_cvtepu8_epi16(_mm_loadl_epi64((const __m128i *)cckyber_avx2_compact[m]));
+            c = _mm_add_epi16(_mm_mullo_epi16(c, _mm_set1_epi16(0x0202)), _mm_set1_epi16(0x0100));
+
+            _mm_storeu_si128((__m128i *)&coeffs[*ctr], _mm_shuffle_epi8(halves[j], c));
+            *ctr += (size_t)__builtin_popcount(m);
+        }
+    }
+
+    return i;
+}
+
+#endif // CCKYBER_AVX2
@@ -14,6 +14,7 @@
 
 #include <corecrypto/cc_config.h>
 #include <corecrypto/cc_priv.h>
+#include <corecrypto/cc_executor.h>
 #include <corecrypto/ccmode_impl.h>
 #include <corecrypto/ccmode_siv.h>
 #include <corecrypto/ccmode_siv_hmac.h>
@@ -300,6 +301,107 @@ int ccxts_one_shot(const struct ccmode_xts *mode,
                    const void *cc_unsafe_indexable in,
                    void *cc_unsafe_indexable out);
 
+/* Batches of sectors. */
+
+/*!
+ @struct     ccmode_sector
+ @abstract   One independent data unit (e.g. a disk sector) of a batch.
+
+ @field      iv         Data used to generate the tweak (XTS) or the IV (CBC), one block
+ @field      nblocks    Length of the data in blocks
+ @field      in         Input data
+ @field      out        Output buffer, may be equal to in
+ */
+struct ccmode_sector {
+    const void *cc_unsafe_indexable iv;
+    size_t nblocks;
+    const void *cc_unsafe_indexable in;
+    void *cc_unsafe_indexable out;
+};
+
+/* Maximum number of shards a batch is split into. */
+#define CCMODE_SECTORS_MAX_NSHARDS 64
+
+/*!
+ @function   ccxts_update_sectors
+ @abstract   Encrypt or decrypt a batch of sectors, each with its own tweak.
+
+ @param      mode       Descriptor for the mode
+ @param      ctx        Context for this instance
+ @param      nsectors   Number of sectors
+ @param      sectors    Sectors to process
+
+ @result     0 iff successful.
+
+ @discussion Equivalent to calling ccxts_set_tweak() and ccxts_update() for
+ every sector. Sectors must not overlap each other.
+ */
+int ccxts_update_sectors(const struct ccmode_xts *mode,
+                         const ccxts_ctx *ctx,
+                         size_t nsectors,
+                         const struct ccmode_sector *cc_counted_by(nsectors) sectors);
+
+/*!
+ @function   ccxts_update_sectors_executor
+ @abstract   Same as ccxts_update_sectors(), splitting the batch into contiguous
+             shards that the executor may run concurrently.
+
+ @param      executor   Executor running the shards, or NULL to run them one after the other
+ @param      nshards    Number of shards, at most CCMODE_SECTORS_MAX_NSHARDS
+ @param      mode       Descriptor for the mode
+ @param      ctx        Context for this instance, shared read-only by all shards
+ @param      nsectors   Number of sectors
+ @param      sectors    Sectors to process
+
+ @result     0 iff successful.
+ */
+int ccxts_update_sectors_executor(const struct cc_executor *executor,
+                                  size_t nshards,
+                                  const struct ccmode_xts *mode,
+                                  const ccxts_ctx *ctx,
+                                  size_t nsectors,
+                                  const struct ccmode_sector *cc_counted_by(nsectors) sectors);
+
+/*!
+ @function   cccbc_update_sectors
+ @abstract   Encrypt or decrypt a batch of sectors, each with its own IV.
+
+ @param      mode       Descriptor for the mode
+ @param      ctx        Context for this instance
+ @param      nsectors   Number of sectors
+ @param      sectors    Sectors to process
+
+ @result     0 iff successful.
+
+ @discussion Equivalent to calling cccbc_set_iv() and cccbc_update() for
+ every sector. Sectors must not overlap each other.
+ */
+int cccbc_update_sectors(const struct ccmode_cbc *mode,
+                         const cccbc_ctx *ctx,
+                         size_t nsectors,
+                         const struct ccmode_sector *cc_counted_by(nsectors) sectors);
+
+/*!
+ @function   cccbc_update_sectors_executor
+ @abstract   Same as cccbc_update_sectors(), splitting the batch into contiguous
+             shards that the executor may run concurrently.
+
+ @param      executor   Executor running the shards, or NULL to run them one after the other
+ @param      nshards    Number of shards, at most CCMODE_SECTORS_MAX_NSHARDS
+ @param      mode       Descriptor for the mode
+ @param      ctx        Context for this instance, shared read-only by all shards
+ @param      nsectors   Number of sectors
+ @param      sectors    Sectors to process
+
+ @result     0 iff successful.
+ */
+int cccbc_update_sectors_executor(const struct cc_executor *executor,
+                                  size_t nshards,
+                                  const struct ccmode_cbc *mode,
+                                  const cccbc_ctx *ctx,
+                                  size_t nsectors,
+                                  const struct ccmode_sector *cc_counted_by(nsectors) sectors);
+
 /* Authenticated cipher modes. */
 
 /* GCM mode. */
@@ -173,3 +173,52 @@ int test_ctr(const char *name, const struct ccmode_ctr *encrypt_ciphermode, cons
 }
 
 
+
+#define TEST_CTR_STREAM_NBYTES (1024 + 13)
+
+/* Encrypt the same data with ctr and ref, feeding ctr chunks of varying
+ sizes so that bulk and partial block paths interleave, including a counter
+ wrap-around. */
+int test_ctr_stream(const struct ccmode_ctr *ctr, const struct ccmode_ctr *ref)
+{
+    static const size_t keylens[] = { 16, 24, 32 };
+    static const size_t chunks[] = { 1, 15, 16, 17, 127, 128, 129, 300 };
+    uint8_t key[32], pt[TEST_CTR_STREAM_NBYTES], ct[TEST_CTR_STREAM_NBYTES], out[TEST_CTR_STREAM_NBYTES];
+    uint8_t ivs[2][16];
+
+    for (size_t i = 0; i < sizeof(key); i++) {
+        key[i] = (uint8_t)(i * 7 + 1);
+    }
+    for (size_t i = 0; i < sizeof(pt); i++) {
+        pt[i] = (uint8_t)(i * 13 + 5);
+    }
+    memset(ivs[0], 0, sizeof(ivs[0]));
+    // Nonzero upper half, the lower half wraps after 3 blocks.
+    memset(ivs[1], 0xa5, 8);
+    memset(ivs[1] + 8, 0xff, 8);
+    ivs[1][15] = 0xfd;
+
+    ccctr_ctx_decl(ctr->size, ctx);
+
+    for (size_t k = 0; k < CC_ARRAY_LEN(keylens); k++) {
+        for (size_t v = 0; v < CC_ARRAY_LEN(ivs); v++) {
+            ok_or_fail(ccctr_one_shot(ref, keylens[k], key, ivs[v], sizeof(pt), pt, ct) == 0, "CTR stream reference");
+
+            ok_or_fail(ccctr_init(ctr, ctx, keylens[k], key, ivs[v]) == 0, "CTR stream init");
+            for (size_t off = 0, c = 0; off < sizeof(pt); c++) {
+                size_t n = CC_MIN(chunks[c % CC_ARRAY_LEN(chunks)], sizeof(pt) - off);
+                ccctr_update(ctr, ctx, n, pt + off, out + off);
+                off += n;
+            }
+            ok_memcmp_or_fail(out, ct, sizeof(out), "CTR stream, key %zu, iv %zu", keylens[k], v);
+
+            // In place.
+            memcpy(out, pt, sizeof(out));
+            ok_or_fail(ccctr_one_shot(ctr, keylens[k], key, ivs[v], sizeof(out), out, out) == 0, "CTR stream in place");
+            ok_memcmp_or_fail(out, ct, sizeof(out), "CTR stream in place, key %zu, iv %zu", keylens[k], v);
+        }
+    }
+
+    ccctr_ctx_clear(ctr->size, ctx);
+    return 1;
+}
@@ -331,6 +331,60 @@ static int gcm_test_counter_wrap(const struct ccmode_gcm *encrypt_ciphermode, co
     return 1;
 }
 
+// Feed the text in random chunks to check that bulk implementations resume
+// correctly from any offset, against the factory mode for the same cipher.
+static int gcm_test_chunked_update(const struct ccmode_gcm *encrypt_ciphermode, const struct ccmode_gcm *decrypt_ciphermode)
+{
+    struct ccmode_gcm ref_ciphermode;
+    ccmode_factory_gcm_encrypt(&ref_ciphermode, encrypt_ciphermode->custom);
+
+    uint8_t key[CCAES_KEY_SIZE_256], iv[CCGCM_IV_NBYTES];
+    uint8_t ptext[1024], ctext[sizeof(ptext)], dtext[sizeof(ptext)], ref_ctext[sizeof(ptext)];
+    uint8_t tag[CCGCM_BLOCK_NBYTES], ref_tag[CCGCM_BLOCK_NBYTES];
+    const size_t key_nbytes[] = { CCAES_KEY_SIZE_128, CCAES_KEY_SIZE_192, CCAES_KEY_SIZE_256 };
+
+    ccgcm_ctx_decl(ccgcm_context_size(encrypt_ciphermode), encrypt_ctx);
+    ccgcm_ctx_decl(ccgcm_context_size(decrypt_ciphermode), decrypt_ctx);
+
+    for (size_t i = 0; i < 16; i++) {
+        size_t nbytes = cc_rand(sizeof(ptext) + 1);
+        size_t keylen = key_nbytes[i % CC_ARRAY_LEN(key_nbytes)];
+        int rc = 0;
+
+        rc |= ccrng_generate(global_test_rng, sizeof(key), key);
+        rc |= ccrng_generate(global_test_rng, sizeof(iv), iv);
+        rc |= ccrng_generate(global_test_rng, nbytes, ptext);
+
+        rc |= ccgcm_one_shot(&ref_ciphermode, keylen, key, sizeof(iv), iv, 0, NULL, nbytes, ptext, ref_ctext, sizeof(ref_tag), ref_tag);
+
+        rc |= ccgcm_init_with_iv(encrypt_ciphermode, encrypt_ctx, keylen, key, iv);
+        for (size_t off = 0, n; off < nbytes; off += n) {
+            n = CC_MIN(nbytes - off, cc_rand(300) + 1);
+            rc |= ccgcm_update(encrypt_ciphermode, encrypt_ctx, n, ptext + off, ctext + off);
+        }
+        rc |= ccgcm_finalize(encrypt_ciphermode, encrypt_ctx, sizeof(tag), tag);
+
+        // Decrypt in place.
+        rc |= ccgcm_init_with_iv(decrypt_ciphermode, decrypt_ctx, keylen, key, iv);
+        cc_memcpy(dtext, ctext, nbytes);
+        for (size_t off = 0, n; off < nbytes; off += n) {
+            n = CC_MIN(nbytes - off, cc_rand(300) + 1);
+            rc |= ccgcm_update(decrypt_ciphermode, decrypt_ctx, n, dtext + off, dtext + off);
+        }
+        rc |= ccgcm_finalize(decrypt_ciphermode, decrypt_ctx, sizeof(ref_tag), ref_tag);
+
+        ok_or_fail(rc == 0, "gcm chunked update failed");
+        ok_memcmp_or_fail(ref_ctext, ctext, nbytes, "gcm chunked encrypt ctext mismatch");
+        ok_memcmp_or_fail(ref_tag, tag, sizeof(tag), "gcm chunked encrypt tag mismatch");
+        ok_memcmp_or_fail(ptext, dtext, nbytes, "gcm chunked decrypt ptext mismatch");
+    }
+
+    ccgcm_ctx_clear(ccgcm_context_size(encrypt_ciphermode), encrypt_ctx);
+    ccgcm_ctx_clear(ccgcm_context_size(decrypt_ciphermode), decrypt_ctx);
+
+    return 1;
+}
+
 static void gcm_test_gf_mult(const struct ccmode_gcm *ciphermode)
 {
     uint8_t key[CCAES_KEY_SIZE_128];
@@ -416,6 +470,7 @@ int test_gcm(const struct ccmode_gcm *encrypt_ciphermode, const struct ccmode_gc
     gcm_test_zerolen_iv(encrypt_ciphermode, decrypt_ciphermode);
     gcm_test_init_with_iv(encrypt_ciphermode, decrypt_ciphermode);
     gcm_test_counter_wrap(encrypt_ciphermode, decrypt_ciphermode);
+    gcm_test_chunked_update(encrypt_ciphermode, decrypt_ciphermode);
     gcm_test_gf_mult(encrypt_ciphermode);
     gcm_test_gf_mult_edge_case();
 
@@ -39,6 +39,9 @@ int test_hmac_mode(ciphermode_t encrypt_ciphermode, ciphermode_t decrypt_cipherm
 int test_gcm(const struct ccmode_gcm *encrypt_ciphermode, const struct ccmode_gcm *decrypt_ciphermode);
 int test_ccm(const struct ccmode_ccm *encrypt_ciphermode, const struct ccmode_ccm *decrypt_ciphermode);
 int test_xts(const struct ccmode_xts *encrypt_ciphermode, const struct ccmode_xts *decrypt_ciphermode);
+int test_xts_sectors(const struct ccmode_xts *encrypt_ciphermode, const struct ccmode_xts *decrypt_ciphermode,
+                     const struct ccmode_xts *ref_ciphermode);
+int test_cbc_sectors(const struct ccmode_cbc *encrypt_ciphermode, const struct ccmode_cbc *decrypt_ciphermode);
 int test_siv_hmac_corner_cases(duplex_cryptor cryptor);
 int ccmode_siv_hmac_state_tests(cc_ciphermode_descriptor cm, cc_symmetric_context_p ctx);
 int ccmode_aes_siv_encrypt_decrypt_in_place_tests(cc_ciphermode_descriptor cm, cc_symmetric_context_p ctx, cc_ciphermode_descriptor dcm, cc_symmetric_context_p dctx);
@@ -49,4 +52,8 @@ int test_aes_siv_corner_cases(duplex_cryptor cryptor);
 int test_ctr(const char *name, const struct ccmode_ctr *encrypt_ciphermode, const struct ccmode_ctr *decrypt_ciphermode,
              const ccsymmetric_test_vector *sym_vectors);
 
+/* Compare a CTR implementation against a reference one on chunked and in
+ place input. */
+int test_ctr_stream(const struct ccmode_ctr *ctr, const struct ccmode_ctr *ref);
+
 #endif /* _CORECRYPTO_CRYPTO_TEST_MODES_H_ */
@@ -0,0 +1,167 @@
+/* Copyright (c) (2023) Apple Inc. All rights reserved.
+ *
+ * corecrypto is licensed under Apple Inc.’s Internal Use License Agreement (which
+ * is contained in the License.txt file distributed with corecrypto) and only to
+ * people who accept that license. IMPORTANT:  Any license rights granted to you by
+ * Apple Inc. (if any) are limited to internal use within your organization only on
+ * devices and computers you own or control, for the sole purpose of verifying the
+ * security characteristics and correct functioning of the Apple Software.  You may
+ * not, directly or indirectly, redistribute the Apple Software or any portions thereof.
+ */
+
+#include <corecrypto/ccmode.h>
+
+#include "testmore.h"
+#include "crypto_test_modes.h"
+
+// Cover the 8-block bulk loops, their tails and sectors shorter than a group.
+static const size_t test_sectors_nblocks[] = { 1, 7, 8, 9, 16, 32, 33 };
+
+#define TEST_SECTORS_N CC_ARRAY_LEN(test_sectors_nblocks)
+#define TEST_SECTORS_NBLOCKS (1 + 7 + 8 + 9 + 16 + 32 + 33)
+#define TEST_SECTORS_NBYTES (16 * TEST_SECTORS_NBLOCKS)
+
+static const size_t test_sectors_nshards[] = { 1, 3, TEST_SECTORS_N, CCMODE_SECTORS_MAX_NSHARDS };
+
+// Runs the shards in reverse order, one after the other.
+static void test_sectors_apply(const struct cc_executor *executor, size_t n,
+                               void *work_ctx, void (*work)(void *work_ctx, size_t i))
+{
+    size_t *ncalls = executor->ctx;
+
+    while (n--) {
+        work(work_ctx, n);
+        (*ncalls)++;
+    }
+}
+
+static void test_sectors_setup(uint8_t key[32], uint8_t tweak_key[32], uint8_t pt[TEST_SECTORS_NBYTES],
+                               uint8_t ivs[TEST_SECTORS_N][16])
+{
+    for (size_t i = 0; i < 32; i++) {
+        key[i] = (uint8_t)i;
+        tweak_key[i] = (uint8_t)(0x80 + i);
+    }
+
+    for (size_t i = 0; i < TEST_SECTORS_NBYTES; i++) {
+        pt[i] = (uint8_t)(7 * i + 3);
+    }
+
+    // Little-endian sector numbers.
+    memset(ivs, 0, TEST_SECTORS_N * 16);
+    for (size_t s = 0; s < TEST_SECTORS_N; s++) {
+        ivs[s][0] = (uint8_t)(s * 17);
+        ivs[s][1] = (uint8_t)s;
+    }
+}
+
+static void test_sectors_init(struct ccmode_sector sectors[TEST_SECTORS_N], uint8_t ivs[TEST_SECTORS_N][16],
+                              const uint8_t *in, uint8_t *out)
+{
+    size_t offset = 0;
+
+    for (size_t s = 0; s < TEST_SECTORS_N; s++) {
+        sectors[s].iv = ivs[s];
+        sectors[s].nblocks = test_sectors_nblocks[s];
+        sectors[s].in = in + offset;
+        sectors[s].out = out + offset;
+        offset += 16 * test_sectors_nblocks[s];
+    }
+}
+
+int test_xts_sectors(const struct ccmode_xts *encrypt_ciphermode, const struct ccmode_xts *decrypt_ciphermode,
+                     const struct ccmode_xts *ref_ciphermode)
+{
+    uint8_t key[32], tweak_key[32];
+    uint8_t pt[TEST_SECTORS_NBYTES], ct[TEST_SECTORS_NBYTES], ref[TEST_SECTORS_NBYTES];
+    uint8_t ivs[TEST_SECTORS_N][16];
+    struct ccmode_sector sectors[TEST_SECTORS_N];
+    size_t ncalls = 0;
+    struct cc_executor executor = { .apply = test_sectors_apply, .ctx = &ncalls };
+    int rc = CCERR_OK;
+
+    test_sectors_setup(key, tweak_key, pt, ivs);
+
+    test_sectors_init(sectors, ivs, pt, ref);
+    for (size_t s = 0; s < TEST_SECTORS_N; s++) {
+        rc |= ccxts_one_shot(ref_ciphermode, sizeof(key), key, tweak_key, ivs[s],
+                             sectors[s].nblocks, sectors[s].in, sectors[s].out);
+    }
+    ok_or_fail(rc == CCERR_OK, "XTS sectors reference");
+
+    ccxts_ctx_decl(encrypt_ciphermode->size, ctx);
+    ccxts_ctx_decl(decrypt_ciphermode->size, dctx);
+    ok_or_fail(ccxts_init(encrypt_ciphermode, ctx, sizeof(key), key, tweak_key) == CCERR_OK, "XTS sectors encrypt init");
+    ok_or_fail(ccxts_init(decrypt_ciphermode, dctx, sizeof(key), key, tweak_key) == CCERR_OK, "XTS sectors decrypt init");
+
+    test_sectors_init(sectors, ivs, pt, ct);
+    ok_or_fail(ccxts_update_sectors(encrypt_ciphermode, ctx, TEST_SECTORS_N, sectors) == CCERR_OK, "XTS sectors encrypt");
+    ok_memcmp_or_fail(ct, ref, sizeof(ct), "XTS sectors match one-shot");
+
+    for (size_t i = 0; i < CC_ARRAY_LEN(test_sectors_nshards); i++) {
+        memset(ct, 0, sizeof(ct));
+        ok_or_fail(ccxts_update_sectors_executor(&executor, test_sectors_nshards[i], encrypt_ciphermode, ctx, TEST_SECTORS_N, sectors) == CCERR_OK,
+                   "XTS sectors encrypt, %zu shards", test_sectors_nshards[i]);
+        ok_memcmp_or_fail(ct, ref, sizeof(ct), "XTS sectors match one-shot, %zu shards", test_sectors_nshards[i]);
+    }
+
+    // In place.
+    test_sectors_init(sectors, ivs, ct, ct);
+    ok_or_fail(ccxts_update_sectors_executor(NULL, 2, decrypt_ciphermode, dctx, TEST_SECTORS_N, sectors) == CCERR_OK,
+               "XTS sectors decrypt");
+    ok_memcmp_or_fail(ct, pt, sizeof(ct), "XTS sectors decrypt in place");
+
+    is(ccxts_update_sectors_executor(&executor, 0, encrypt_ciphermode, ctx, TEST_SECTORS_N, sectors), CCERR_PARAMETER, "XTS sectors, no shard");
+    is(ccxts_update_sectors_executor(&executor, CCMODE_SECTORS_MAX_NSHARDS + 1, encrypt_ciphermode, ctx, TEST_SECTORS_N, sectors),
+       CCERR_PARAMETER, "XTS sectors, too many shards");
+
+    ccxts_ctx_clear(encrypt_ciphermode->size, ctx);
+    ccxts_ctx_clear(decrypt_ciphermode->size, dctx);
+    return 1;
+}
+
+int test_cbc_sectors(const struct ccmode_cbc *encrypt_ciphermode, const struct ccmode_cbc *decrypt_ciphermode)
+{
+    uint8_t key[32], unused[32];
+    uint8_t pt[TEST_SECTORS_NBYTES], ct[TEST_SECTORS_NBYTES], out[TEST_SECTORS_NBYTES];
+    uint8_t ivs[TEST_SECTORS_N][16];
+    struct ccmode_sector sectors[TEST_SECTORS_N];
+    size_t ncalls = 0;
+    struct cc_executor executor = { .apply = test_sectors_apply, .ctx = &ncalls };
+    int rc = CCERR_OK;
+
+    test_sectors_setup(key, unused, pt, ivs);
+
+    test_sectors_init(sectors, ivs, pt, ct);
+    for (size_t s = 0; s < TEST_SECTORS_N; s++) {
+        rc |= cccbc_one_shot(encrypt_ciphermode, sizeof(key), key, ivs[s], sectors[s].nblocks, sectors[s].in, sectors[s].out);
+    }
+    ok_or_fail(rc == CCERR_OK, "CBC sectors encrypt");
+
+    cccbc_ctx_decl(decrypt_ciphermode->size, ctx);
+    ok_or_fail(cccbc_init(decrypt_ciphermode, ctx, sizeof(key), key) == CCERR_OK, "CBC sectors decrypt init");
+
+    test_sectors_init(sectors, ivs, ct, out);
+    ok_or_fail(cccbc_update_sectors(decrypt_ciphermode, ctx, TEST_SECTORS_N, sectors) == CCERR_OK, "CBC sectors decrypt");
+    ok_memcmp_or_fail(out, pt, sizeof(out), "CBC sectors decrypt match");
+
+    for (size_t i = 0; i < CC_ARRAY_LEN(test_sectors_nshards); i++) {
+        memset(out, 0, sizeof(out));
+        ok_or_fail(cccbc_update_sectors_executor(&executor, test_sectors_nshards[i], decrypt_ciphermode, ctx, TEST_SECTORS_N, sectors) == CCERR_OK,
+                   "CBC sectors decrypt, %zu shards", test_sectors_nshards[i]);
+        ok_memcmp_or_fail(out, pt, sizeof(out), "CBC sectors decrypt match, %zu shards", test_sectors_nshards[i]);
+    }
+
+    // In place.
+    test_sectors_init(sectors, ivs, ct, ct);
+    ok_or_fail(cccbc_update_sectors_executor(NULL, 2, decrypt_ciphermode, ctx, TEST_SECTORS_N, sectors) == CCERR_OK,
+               "CBC sectors decrypt in place");
+    ok_memcmp_or_fail(ct, pt, sizeof(ct), "CBC sectors decrypt in place match");
+
+    is(cccbc_update_sectors_executor(&executor, 0, decrypt_ciphermode, ctx, TEST_SECTORS_N, sectors), CCERR_PARAMETER, "CBC sectors, no shard");
+    is(cccbc_update_sectors_executor(&executor, CCMODE_SECTORS_MAX_NSHARDS + 1, decrypt_ciphermode, ctx, TEST_SECTORS_N, sectors),
+       CCERR_PARAMETER, "CBC sectors, too many shards");
+
+    cccbc_ctx_clear(decrypt_ciphermode->size, ctx);
+    return 1;
+}
@@ -0,0 +1,164 @@
+/* Copyright (c) (2023) Apple Inc. All rights reserved.
+ *
+ * corecrypto is licensed under Apple Inc.’s Internal Use License Agreement (which
+ * is contained in the License.txt file distributed with corecrypto) and only to
+ * people who accept that license. IMPORTANT:  Any license rights granted to you by
+ * Apple Inc. (if any) are limited to internal use within your organization only on
+ * devices and computers you own or control, for the sole purpose of verifying the
+ * security characteristics and correct functioning of the Apple Software.  You may
+ * not, directly or indirectly, redistribute the Apple Software or any portions thereof.
+ */
+
+#include "cc_internal.h"
+#include "cc_macros.h"
+#include <corecrypto/ccmode.h>
+
+/* Batches of independent sectors. The per-sector work is done by the mode
+ descriptor, whose xts/cbc function interleaves blocks when the cipher
+ supports it (cf. ccaes_aesni_modes.h). */
+
+static int ccxts_update_sectors_internal(const struct ccmode_xts *mode,
+                                         const ccxts_ctx *ctx,
+                                         size_t nsectors,
+                                         const struct ccmode_sector *sectors)
+{
+    int rc = CCERR_OK;
+    ccxts_tweak_decl(mode->tweak_size, tweak);
+
+    for (size_t i = 0; i < nsectors; i++) {
+        const struct ccmode_sector *s = &sectors[i];
+
+        cc_require((rc = mode->set_tweak(ctx, tweak, s->iv)) == CCERR_OK, cleanup);
+        cc_require_action(mode->xts(ctx, tweak, s->nblocks, s->in, s->out) != NULL, cleanup, rc = CCERR_PARAMETER);
+    }
+
+cleanup:
+    ccxts_tweak_clear(mode->tweak_size, tweak);
+    return rc;
+}
+
+static int cccbc_update_sectors_internal(const struct ccmode_cbc *mode,
+                                         const cccbc_ctx *ctx,
+                                         size_t nsectors,
+                                         const struct ccmode_sector *sectors)
+{
+    int rc = CCERR_OK;
+    cccbc_iv_decl(mode->block_size, iv);
+
+    for (size_t i = 0; i < nsectors; i++) {
+        const struct ccmode_sector *s = &sectors[i];
+
+        cc_require((rc = cccbc_set_iv(mode, iv, s->iv)) == CCERR_OK, cleanup);
+        cc_require((rc = mode->cbc(ctx, iv, s->nblocks, s->in, s->out)) == CCERR_OK, cleanup);
+    }
+
+cleanup:
+    cccbc_iv_clear(mode->block_size, iv);
+    return rc;
+}
+
+int ccxts_update_sectors(const struct ccmode_xts *mode,
+                         const ccxts_ctx *ctx,
+                         size_t nsectors,
+                         const struct ccmode_sector *sectors)
+{
+    CC_ENSURE_DIT_ENABLED
+
+    return ccxts_update_sectors_internal(mode, ctx, nsectors, sectors);
+}
+
+int cccbc_update_sectors(const struct ccmode_cbc *mode,
+                         const cccbc_ctx *ctx,
+                         size_t nsectors,
+                         const struct ccmode_sector *sectors)
+{
+    CC_ENSURE_DIT_ENABLED
+
+    return cccbc_update_sectors_internal(mode, ctx, nsectors, sectors);
+}
+
+/* Sharding */
+
+struct ccmode_sectors_work {
+    const void *mode;
+    const void *ctx;
+    int (*update)(const void *mode, const void *ctx, size_t nsectors, const struct ccmode_sector *sectors);
+    const struct ccmode_sector *sectors;
+    size_t nsectors;
+    size_t nshards;
+    int rc[CCMODE_SECTORS_MAX_NSHARDS];
+};
+
+// Shard i processes sectors [i * n / nshards, (i + 1) * n / nshards).
+static void ccmode_sectors_shard(void *work_ctx, size_t i)
+{
+    struct ccmode_sectors_work *work = work_ctx;
+    size_t start = i * work->nsectors / work->nshards;
+    size_t end = (i + 1) * work->nsectors / work->nshards;
+
+    work->rc[i] = work->update(work->mode, work->ctx, end - start, work->sectors + start);
+}
+
+static int ccmode_sectors_run(const struct cc_executor *executor, size_t nshards, struct ccmode_sectors_work *work)
+{
+    CC_ENSURE_DIT_ENABLED
+
+    cc_require_or_return(nshards > 0 && nshards <= CCMODE_SECTORS_MAX_NSHARDS, CCERR_PARAMETER);
+
+    work->nshards = CC_MIN(nshards, CC_MAX(work->nsectors, 1));
+
+    // A single shard runs on the calling thread.
+    cc_executor_apply(work->nshards > 1 ? executor : NULL, work->nshards, work, ccmode_sectors_shard);
+
+    for (size_t i = 0; i < work->nshards; i++) {
+        cc_require_or_return(work->rc[i] == CCERR_OK, work->rc[i]);
+    }
+
+    return CCERR_OK;
+}
+
+static int ccxts_update_sectors_shard(const void *mode, const void *ctx, size_t nsectors, const struct ccmode_sector *sectors)
+{
+    return ccxts_update_sectors_internal(mode, ctx, nsectors, sectors);
+}
+
+static int cccbc_update_sectors_shard(const void *mode, const void *ctx, size_t nsectors, const struct ccmode_sector *sectors)
+{
+    return cccbc_update_sectors_internal(mode, ctx, nsectors, sectors);
+}
+
+int ccxts_update_sectors_executor(const struct cc_executor *executor,
+                                  size_t nshards,
+                                  const struct ccmode_xts *mode,
+                                  const ccxts_ctx *ctx,
+                                  size_t nsectors,
+                                  const struct ccmode_sector *sectors)
+{
+    struct ccmode_sectors_work work = {
+        .mode = mode,
+        .ctx = ctx,
+        .update = ccxts_update_sectors_shard,
+        .sectors = sectors,
+        .nsectors = nsectors,
+    };
+
+    return ccmode_sectors_run(executor, nshards, &work);
+}
+
+int cccbc_update_sectors_executor(const struct cc_executor *executor,
+                                  size_t nshards,
+                                  const struct ccmode_cbc *mode,
+                                  const cccbc_ctx *ctx,
+                                  size_t nsectors,
+                                  const struct ccmode_sector *sectors)
+{
+    struct ccmode_sectors_work work = {
+        .mode = mode,
+        .ctx = ctx,
+        .update = cccbc_update_sectors_shard,
+        .sectors = sectors,
+        .nsectors = nsectors,
+    };
+
+    return ccmode_sectors_run(executor, nshards, &work);
+}
@@ -342,15 +342,30 @@ CC_WARN_RESULT
 CC_NONNULL((2, 3))
 cc_unit ccn_addmul1(cc_size n, cc_unit *cc_counted_by(n) r, const cc_unit *cc_counted_by(n) s, const cc_unit v);
 
+/* Operands of at least that many units are multiplied (squared) by
+ ccn_mul_ws() (ccn_sqr_ws()) using Karatsuba. The recursion depends
+ on the operand size only, and is thus constant-time. Thresholds were
+ picked with the ccn_mul_ws/ccn_sqr_ws perf sweeps. */
+#if CC_SMALL_CODE
+#define CCN_MUL_KARATSUBA 0
+#else
+#define CCN_MUL_KARATSUBA 1
+#define CCN_MUL_KARATSUBA_THRESHOLD 32
+#define CCN_SQR_KARATSUBA_THRESHOLD 48
+#endif
+
 /* s * t -> r_2n                   r_2n must not overlap with s nor t
  { n bit, n bit -> 2 * n bit } n = count * sizeof(cc_unit) * 8
  { N bit, N bit -> 2N bit } N = ccn_bitsof(n)
- Provide a workspace for potential speedup */
+ Uses Karatsuba for large operands, see CCN_MUL_KARATSUBA_THRESHOLD, if
+ the workspace has CCN_MUL_KARATSUBA_WORKSPACE_N(count) units left. */
 CC_NONNULL_ALL
 void ccn_mul_ws(cc_ws_t ws, cc_size count, cc_unit *cc_unsafe_indexable r, const cc_unit *cc_counted_by(count) s, const cc_unit *cc_counted_by(count) t);
 
-/* s^2 -> r
- { n bit -> 2 * n bit } */
+/* s^2 -> r                        r must not overlap with s
+ { n bit -> 2 * n bit }
+ Uses Karatsuba for large operands, see CCN_SQR_KARATSUBA_THRESHOLD.
+ Use CCN_SQR_WORKSPACE_N(n) for the workspace. */
 CC_NONNULL_ALL
 void ccn_sqr_ws(cc_ws_t ws, cc_size n, cc_unit *cc_unsafe_indexable r, const cc_unit *cc_counted_by(n) s);
 
@@ -41,6 +41,52 @@ static void test_ccn_sqr(void)
     free(input);
 }
 
+static void test_ccn_mul_karatsuba(void)
+{
+    // Sizes around and above the Karatsuba thresholds, odd and even.
+    const cc_size sizes[] = { 16, 31, 32, 33, 47, 48, 49, 64, 65, 97, 128, 129 };
+
+    cc_unit s[129], t[129];
+    cc_unit r[2 * 129], expected[2 * 129];
+
+    CC_DECL_WORKSPACE_TEST(ws);
+    CC_DECL_WORKSPACE_NULL(ws_null);
+
+    for (size_t i = 0; i < CC_ARRAY_LEN(sizes); i++) {
+        cc_size n = sizes[i];
+
+        for (int j = 0; j < 3; j++) {
+            ccn_random(n, s, global_test_rng);
+            ccn_random(n, t, global_test_rng);
+
+            // Maximize carries and borrows.
+            if (j == 1) {
+                ccn_clear(n, s);
+                ccn_sub1(n, s, s, 1);
+            }
+            if (j == 2) {
+                ccn_clear(n, t);
+                ccn_sub1(n, t, t, 1);
+            }
+
+            ccn_muln(n, expected, s, n, t);
+            ccn_mul_ws(ws, n, r, s, t);
+            ok_ccn_cmp(2 * n, r, expected, "ccn_mul_ws() failed, n=%zu", n);
+
+            // Without room for Karatsuba, fall back to schoolbook.
+            ccn_mul_ws(ws_null, n, r, s, t);
+            ok_ccn_cmp(2 * n, r, expected, "ccn_mul_ws() fallback failed, n=%zu", n);
+
+            ccn_muln(n, expected, s, n, s);
+            ccn_sqr_ws(ws, n, r, s);
+            ok_ccn_cmp(2 * n, r, expected, "ccn_sqr_ws() failed, n=%zu", n);
+        }
+    }
+
+    CC_FREE_WORKSPACE(ws_null);
+    CC_FREE_WORKSPACE(ws);
+}
+
 #define CCN_READ_WRITE_TEST_N 3
 #define CCN_READ_WRITE_TEST_BYTES ccn_sizeof_n(CCN_READ_WRITE_TEST_N)
 static void test_ccn_write_test(size_t size)
@@ -751,6 +797,7 @@ int ccn_tests(TM_UNUSED int argc, TM_UNUSED char *const *argv)
     num_tests += 8;                            // ccn_addn
     num_tests += 9;                            // ccn_sub1
     num_tests += 1;                            // ccn_sqr
+    num_tests += 12 * 3 * 3;                   // ccn_mul_karatsuba
     num_tests += 6;                            // ccn_bitlen
     num_tests += 6;                            // ccn_abs
     num_tests += 20;                           // ccn_cmpn
@@ -771,6 +818,7 @@ int ccn_tests(TM_UNUSED int argc, TM_UNUSED char *const *argv)
     test_ccn_addn();
     test_ccn_sub1();
     test_ccn_sqr();
+    test_ccn_mul_karatsuba();
     test_ccn_bitlen();
     test_ccn_abs();
     test_ccn_cmpn();
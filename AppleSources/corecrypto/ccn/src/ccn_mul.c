@@ -11,11 +11,92 @@
 
 #include "ccn_internal.h"
 
+CC_PURE cc_size CCN_MUL_KARATSUBA_WORKSPACE_N(cc_size n)
+{
+    cc_size rv = 0;
+
+#if CCN_MUL_KARATSUBA
+    // Each level needs 2 * ceil(n/2) units, plus the workspace for
+    // the (larger) upper half at the next level.
+    while (n >= CCN_MUL_KARATSUBA_THRESHOLD) {
+        n -= n / 2;
+        rv += 2 * n;
+    }
+#else
+    (void)n;
+#endif
+
+    return rv;
+}
+
+#if CCN_MUL_KARATSUBA
+
+/*
+ Karatsuba multiplication, with s = s1 * B^h + s0 and t = t1 * B^h + t0:
+
+   s * t = s1 * t1 * B^2h + (s0 * t1 + s1 * t0) * B^h + s0 * t0
+
+ with
+
+   s0 * t1 + s1 * t0 = s0 * t0 + s1 * t1 - (s1 - s0) * (t1 - t0)
+
+ The signs of the differences are handled with conditional adds and
+ subtracts, so that only the size n determines the control flow.
+
+ CCN_MUL_WORKSPACE_N(n) is zero, so callers opt in by reserving
+ CCN_MUL_KARATSUBA_WORKSPACE_N(n) more units. Without them, this falls
+ back to schoolbook multiplication. The choice depends only on sizes.
+ */
+void ccn_mul_ws(cc_ws_t ws, cc_size n, cc_unit *r, const cc_unit *s, const cc_unit *t)
+{
+    if (n < CCN_MUL_KARATSUBA_THRESHOLD || cc_ws_available(ws) < CCN_MUL_KARATSUBA_WORKSPACE_N(n)) {
+        ccn_mul(n, r, s, t);
+        return;
+    }
+
+    // The lower halves have h units, the upper halves hh >= h units.
+    cc_size h = n / 2;
+    cc_size hh = n - h;
+
+    CC_DECL_BP_WS(ws, bp);
+    cc_unit *m = CC_ALLOC_WS(ws, 2 * hh);
+
+    // r = |s1 - s0| || |t1 - t0|
+    ccn_setn(hh, m, h, s);
+    cc_unit neg = ccn_abs(hh, r, &s[h], m);
+    ccn_setn(hh, m, h, t);
+    neg ^= ccn_abs(hh, &r[hh], &t[h], m);
+
+    // m = |s1 - s0| * |t1 - t0|
+    ccn_mul_ws(ws, hh, m, r, &r[hh]);
+
+    // r = s1 * t1 * B^2h + s0 * t0
+    ccn_mul_ws(ws, h, r, s, t);
+    ccn_mul_ws(ws, hh, &r[2 * h], &s[h], &t[h]);
+
+    // (c, m) = s1 * t1 - (s1 - s0) * (t1 - t0)
+    cc_unit c = ccn_cond_add(2 * hh, neg, m, m, &r[2 * h]);
+    c -= ccn_cond_rsub(2 * hh, neg ^ 1, m, m, &r[2 * h]);
+
+    // (c, m) = s0 * t1 + s1 * t0
+    c += ccn_addn(2 * hh, m, m, 2 * h, r);
+
+    // r += (c, m) * B^h
+    c += ccn_add(2 * hh, &r[h], &r[h], m);
+    (void)ccn_add1(h, &r[h + 2 * hh], &r[h + 2 * hh], c);
+
+    CC_FREE_BP_WS(ws, bp);
+}
+
+#else
+
 void ccn_mul_ws(CC_UNUSED cc_ws_t ws, cc_size n, cc_unit *r, const cc_unit *s, const cc_unit *t)
 {
     ccn_mul(n, r, s, t);
 }
 
+#endif // CCN_MUL_KARATSUBA
+
 #if !CCN_MUL_ASM
 
 #if CCN_MUL1_ASM && CCN_ADDMUL1_ASM
@@ -13,47 +13,89 @@
 
 CC_PURE cc_size CCN_SQR_WORKSPACE_N(cc_size n)
 {
+    // Karatsuba squaring takes 2 * ceil(n/2) units per level, which
+    // adds up to at most 2 * n units.
     return CC_MAX_EVAL(2 * n, CCN_MUL_WORKSPACE_N(n));
 }
 
 /* Do r = s^2, r is 2 * n cc_units in size, s is n * cc_units in size. */
-void ccn_sqr_ws(cc_ws_t ws, cc_size n, cc_unit *r, const cc_unit *s)
+static void ccn_sqr_schoolbook_ws(cc_ws_t ws, cc_size n, cc_unit *r, const cc_unit *s)
 {
 #if CC_DUNIT_SUPPORTED && !CC_SMALL_CODE
-    cc_dunit prod, sum;
-    cc_unit cadd;
+    (void)ws;
 
-    CC_DECL_BP_WS(ws, bp);
-    cc_unit *t = CC_ALLOC_WS(ws, 2 * n);
-
-    // Set of s0*sj
-    t[n] = ccn_mul1(n - 1, &t[1], &s[1], s[0]);
-
-    // Set of s0^2
-    prod = (cc_dunit)s[0] * s[0];
-    r[0] = (cc_unit)prod;
-    sum = ((cc_dunit)t[1] << 1) + (prod >> CCN_UNIT_BITS);
-    r[1] = (cc_unit)sum;
-    cadd = (sum >> CCN_UNIT_BITS);
-
-    // Main loop
-    for (cc_size i = 1; i < n; i++) {
-        // Set of si*sj
-        t[i + n] = ccn_addmul1(n - (i + 1), &t[2*i + 1], &s[i + 1], s[i]);
-
-        // 2t + r
-        prod = (cc_dunit)s[i] * s[i] + cadd;
-        sum = ((cc_dunit)t[2*i] << 1) + (prod & CCN_UNIT_MASK);
+    // Set of si*sj, i < j
+    r[0] = 0;
+    r[n] = ccn_mul1(n - 1, &r[1], &s[1], s[0]);
+
+    for (cc_size i = 1; i < n - 1; i++) {
+        r[i + n] = ccn_addmul1(n - (i + 1), &r[2*i + 1], &s[i + 1], s[i]);
+    }
+
+    r[2*n - 1] = 0;
+
+    // 2r + set of si^2
+    cc_dunit prod, sum = 0;
+    cc_unit msb = 0;
+
+    for (cc_size i = 0; i < n; i++) {
+        prod = (cc_dunit)s[i] * s[i];
+
+        sum += ((cc_dunit)r[2*i] << 1) + (prod & CCN_UNIT_MASK) + msb;
+        msb = r[2*i + 1] >> (CCN_UNIT_BITS - 1);
         r[2*i] = (cc_unit)sum;
-        sum = ((cc_dunit)t[2*i + 1] << 1)
-                + (prod >> CCN_UNIT_BITS)
-                + (sum >> CCN_UNIT_BITS);
+        sum >>= CCN_UNIT_BITS;
+
+        sum += ((cc_dunit)(r[2*i + 1] << 1)) + (prod >> CCN_UNIT_BITS);
         r[2*i + 1] = (cc_unit)sum;
-        cadd = (sum >> CCN_UNIT_BITS);
+        sum >>= CCN_UNIT_BITS;
     }
-
-    CC_FREE_BP_WS(ws, bp);
 #else
     ccn_mul_ws(ws, n, r, s, s);
 #endif // CC_DUNIT_SUPPORTED && !CC_SMALL_CODE
 }
+
+/*
+ Karatsuba squaring, with s = s1 * B^h + s0:
+
+   s^2 = s1^2 * B^2h + (s0^2 + s1^2 - (s1 - s0)^2) * B^h + s0^2
+ */
+void ccn_sqr_ws(cc_ws_t ws, cc_size n, cc_unit *r, const cc_unit *s)
+{
+#if CCN_MUL_KARATSUBA
+    if (n < CCN_SQR_KARATSUBA_THRESHOLD) {
+        ccn_sqr_schoolbook_ws(ws, n, r, s);
+        return;
+    }
+
+    // The lower half has h units, the upper half hh >= h units.
+    cc_size h = n / 2;
+    cc_size hh = n - h;
+
+    CC_DECL_BP_WS(ws, bp);
+    cc_unit *m = CC_ALLOC_WS(ws, 2 * hh);
+
+    // r = |s1 - s0|, the sign does not matter once squared.
+    ccn_setn(hh, m, h, s);
+    CC_UNUSED cc_unit neg = ccn_abs(hh, r, &s[h], m);
+
+    // m = (s1 - s0)^2
+    ccn_sqr_ws(ws, hh, m, r);
+
+    // r = s1^2 * B^2h + s0^2
+    ccn_sqr_ws(ws, h, r, s);
+    ccn_sqr_ws(ws, hh, &r[2 * h], &s[h]);
+
+    // (c, m) = s0^2 + s1^2 - (s1 - s0)^2 = 2 * s0 * s1
+    cc_unit c = 0 - ccn_sub(2 * hh, m, &r[2 * h], m);
+    c += ccn_addn(2 * hh, m, m, 2 * h, r);
+
+    // r += (c, m) * B^h
+    c += ccn_add(2 * hh, &r[h], &r[h], m);
+    (void)ccn_add1(h, &r[h + 2 * hh], &r[h + 2 * hh], c);
+
+    CC_FREE_BP_WS(ws, bp);
+#else
+    ccn_sqr_schoolbook_ws(ws, n, r, s);
+#endif // CCN_MUL_KARATSUBA
+}
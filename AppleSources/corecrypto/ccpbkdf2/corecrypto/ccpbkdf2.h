@@ -40,4 +40,28 @@ int ccpbkdf2_hmac(const struct ccdigest_info *di,
                    size_t iterations,
                    size_t dkLen, void *dk);
 
+/*! @function ccpbkdf2_hmac_mb
+    @abstract perform n independent pbkdf2 with the same digest, iteration count and output length
+    @discussion The output blocks of all passwords are iterated together. With SHA-2, they are
+spread over the lanes of the multi-buffer compression kernels, e.g. 8 SHA-256 lanes with AVX2.
+Each password and its output blocks are otherwise processed exactly as by ccpbkdf2_hmac.
+    @param di           digest info defining the digest type to use in the PRF.
+    @param n            number of passwords
+    @param passwordLens length of each password
+    @param passwords    passwords to be fed into the PBKDF
+    @param saltLens     length of each salt
+    @param salts        salt of each password
+    @param iterations   itrations to go
+    @param dkLen        length of each result
+    @param dks          buffers for the results, each must be dkLen big
+
+    @return CCERR_OK on success, CCERR_PARAMETER if dkLen is too large.
+ */
+int ccpbkdf2_hmac_mb(const struct ccdigest_info *di,
+                     size_t n,
+                     const size_t *passwordLens, const void *const *passwords,
+                     const size_t *saltLens, const void *const *salts,
+                     size_t iterations,
+                     size_t dkLen, void *const *dks);
+
 #endif /* _CORECRYPTO_CCPBKDF2_H_ */
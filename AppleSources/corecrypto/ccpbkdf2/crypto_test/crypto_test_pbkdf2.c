@@ -29,8 +29,9 @@ entryPoint(ccpbkdf2_tests,"ccpbkdf2 test")
 #include <corecrypto/ccsha1.h>
 #include <corecrypto/ccsha2.h>
 #include <corecrypto/ccripemd.h>
+#include <corecrypto/cchmac.h>
 
-static const int kTestTestCount = 180;
+static const int kTestTestCount = 204;
 
 
 /* Currently, ccpbkdf2 and friends won't work when length == 0 and the
@@ -176,6 +177,74 @@ static int test_pbkdf2(const struct ccdigest_info *di) {
     return 1;
 }
 
+// Straightforward PBKDF2 with one HMAC per iteration.
+static void pbkdf2_reference(const struct ccdigest_info *di, size_t passwordLen, const void *password,
+                             size_t saltLen, const void *salt, size_t iterations, size_t dkLen, uint8_t *dk)
+{
+    size_t hLen = di->output_size;
+    uint8_t u[MAX_DIGEST_OUTPUT_SIZE], t[MAX_DIGEST_OUTPUT_SIZE];
+    cchmac_di_decl(di, hc);
+
+    for (uint32_t i = 1; (size_t)(i - 1) * hLen < dkLen; i++) {
+        uint8_t bn[4] = { (uint8_t)(i >> 24), (uint8_t)(i >> 16), (uint8_t)(i >> 8), (uint8_t)i };
+
+        cchmac_init(di, hc, passwordLen, password);
+        cchmac_update(di, hc, saltLen, salt);
+        cchmac_update(di, hc, sizeof(bn), bn);
+        cchmac_final(di, hc, u);
+        memcpy(t, u, hLen);
+
+        for (size_t j = 2; j <= iterations; j++) {
+            cchmac(di, passwordLen, password, hLen, u, u);
+            cc_xor(hLen, t, t, u);
+        }
+
+        memcpy(dk + (i - 1) * hLen, t, CC_MIN(hLen, dkLen - (i - 1) * hLen));
+    }
+    cchmac_di_clear(di, hc);
+}
+
+// More passwords than lanes, some longer than a block, each with several output blocks.
+#define MB_NPASSWORDS 19
+#define MB_DKLEN 150
+
+static int test_pbkdf2_mb(const struct ccdigest_info *di) {
+    uint8_t passwords[MB_NPASSWORDS][200];
+    uint8_t salts[MB_NPASSWORDS][24];
+    uint8_t dks[MB_NPASSWORDS][MB_DKLEN];
+    uint8_t ref[MB_DKLEN];
+    size_t passwordLens[MB_NPASSWORDS], saltLens[MB_NPASSWORDS];
+    const void *passwordPtrs[MB_NPASSWORDS], *saltPtrs[MB_NPASSWORDS];
+    void *dkPtrs[MB_NPASSWORDS];
+    size_t iterations = 7;
+    bool match = true;
+
+    for (size_t i = 0; i < MB_NPASSWORDS; i++) {
+        passwordLens[i] = (i * 37) % sizeof(passwords[i]);
+        saltLens[i] = 8 + i % 16;
+        for (size_t j = 0; j < sizeof(passwords[i]); j++) {
+            passwords[i][j] = (uint8_t)(i + 3 * j);
+        }
+        for (size_t j = 0; j < sizeof(salts[i]); j++) {
+            salts[i][j] = (uint8_t)(0x55 ^ (i * j));
+        }
+        passwordPtrs[i] = passwords[i];
+        saltPtrs[i] = salts[i];
+        dkPtrs[i] = dks[i];
+    }
+
+    is(ccpbkdf2_hmac_mb(di, MB_NPASSWORDS, passwordLens, passwordPtrs, saltLens, saltPtrs, iterations, MB_DKLEN, dkPtrs),
+       CCERR_OK, "ccpbkdf2_hmac_mb");
+
+    for (size_t i = 0; i < MB_NPASSWORDS; i++) {
+        pbkdf2_reference(di, passwordLens[i], passwords[i], saltLens[i], salts[i], iterations, MB_DKLEN, ref);
+        match &= memcmp(ref, dks[i], MB_DKLEN) == 0;
+    }
+    ok(match, "ccpbkdf2_hmac_mb matches reference");
+
+    return 1;
+}
+
 int ccpbkdf2_tests(TM_UNUSED int argc, TM_UNUSED char *const *argv)
 {
 	plan_tests(kTestTestCount);
@@ -201,6 +270,16 @@ int ccpbkdf2_tests(TM_UNUSED int argc, TM_UNUSED char *const *argv)
     ok(test_pbkdf2(ccsha384_di()), "Default ccsha384_di");
     ok(test_pbkdf2(ccsha512_di()), "Default ccsha512_di");
 
+    // Multi-buffer
+    ok(test_pbkdf2_mb(&ccmd5_ltc_di), "ccpbkdf2_hmac_mb ccmd5_ltc_di");
+    ok(test_pbkdf2_mb(&ccsha1_ltc_di), "ccpbkdf2_hmac_mb ccsha1_ltc_di");
+    ok(test_pbkdf2_mb(&ccsha256_ltc_di), "ccpbkdf2_hmac_mb ccsha256_ltc_di");
+    ok(test_pbkdf2_mb(&ccsha512_ltc_di), "ccpbkdf2_hmac_mb ccsha512_ltc_di");
+    ok(test_pbkdf2_mb(ccsha224_di()), "ccpbkdf2_hmac_mb Default ccsha224_di");
+    ok(test_pbkdf2_mb(ccsha256_di()), "ccpbkdf2_hmac_mb Default ccsha256_di");
+    ok(test_pbkdf2_mb(ccsha384_di()), "ccpbkdf2_hmac_mb Default ccsha384_di");
+    ok(test_pbkdf2_mb(ccsha512_di()), "ccpbkdf2_hmac_mb Default ccsha512_di");
+
     return 0;
 }
 #endif
@@ -16,6 +16,10 @@
 #include <corecrypto/cchmac.h>
 #include <corecrypto/cc.h>
 #include <corecrypto/cc_priv.h>
+#include <corecrypto/ccsha1.h>
+#include <corecrypto/ccsha2.h>
+#include "ccdigest_internal.h"
+#include "ccsha2_internal.h"
 
 /* Will write hLen bytes into dataPtr according to PKCS #5 2.0 spec.
    See: ../docs/pkcs5v2_1.pdf for details (cached copy of RSA's PKCS5v2)
@@ -63,6 +67,191 @@ F (const struct ccdigest_info *di,
 }
 
 
+/*
+ Lanes
+
+ Once U_1 = HMAC(P, S || INT(i)) is known, every further iteration hashes a
+ single hLen-byte message with the cached inner and outer states: exactly one
+ compression each, of a block whose padding never changes. For SHA-1 and SHA-2
+ that block is built once per output block and hashed in place, and the
+ output blocks (and passwords, cf. ccpbkdf2_hmac_mb) are iterated together so
+ that the multi-buffer SHA-2 kernels can process them in parallel.
+ */
+
+#define CCPBKDF2_MAX_LANES 16
+
+struct ccpbkdf2_engine {
+    const struct ccdigest_info *di;
+    size_t word_nbytes;
+    // NULL when there is no multi-buffer kernel, lanes are then compressed one by one.
+    void (*mb_compress)(size_t nlanes, ccdigest_state_t *states, size_t nblocks, const uint8_t *const *in);
+};
+
+struct ccpbkdf2_lane {
+    // Cached compress(K ^ ipad) and compress(K ^ opad).
+    uint64_t istate[CCSHA512_STATE_SIZE / sizeof(uint64_t)];
+    uint64_t ostate[CCSHA512_STATE_SIZE / sizeof(uint64_t)];
+    uint64_t state[CCSHA512_STATE_SIZE / sizeof(uint64_t)];
+    // U_i followed by the padding of a block_size + hLen byte message.
+    uint8_t block[CCSHA512_BLOCK_SIZE];
+    uint8_t acc[MAX_DIGEST_OUTPUT_SIZE];
+    uint8_t *out;
+    size_t out_nbytes;
+};
+
+static bool ccpbkdf2_engine(const struct ccdigest_info *di, struct ccpbkdf2_engine *engine)
+{
+    struct ccsha2_mb_engine mb;
+
+    engine->di = di;
+    engine->mb_compress = NULL;
+
+    if (ccsha2_mb_engine(di, &mb)) {
+        engine->word_nbytes = mb.word_nbytes;
+        if (mb.lanes > 1) {
+            engine->mb_compress = mb.compress;
+        }
+        return true;
+    }
+
+    if (ccdigest_oid_equal(di, CC_DIGEST_OID_SHA1)) {
+        engine->word_nbytes = sizeof(uint32_t);
+        return di->block_size == CCSHA1_BLOCK_SIZE && di->state_size == CCSHA1_STATE_SIZE;
+    }
+
+    return false;
+}
+
+static void ccpbkdf2_compress(const struct ccpbkdf2_engine *engine, size_t nlanes,
+                              ccdigest_state_t *states, const uint8_t *const *blocks)
+{
+    // A single lane goes through di so that the caller's implementation is used.
+    if (engine->mb_compress && nlanes > 1) {
+        engine->mb_compress(nlanes, states, 1, blocks);
+        return;
+    }
+
+    for (size_t l = 0; l < nlanes; l++) {
+        engine->di->compress(states[l], 1, blocks[l]);
+    }
+}
+
+// Write the digest held in state to the first hLen bytes of out, big-endian.
+static void ccpbkdf2_store(const struct ccpbkdf2_engine *engine, const uint64_t *state, uint8_t *out)
+{
+    size_t nwords = engine->di->output_size / engine->word_nbytes;
+    const uint32_t *state32 = (const uint32_t *)state;
+
+    for (size_t i = 0; i < nwords; i++) {
+        if (engine->word_nbytes == sizeof(uint32_t)) {
+            cc_store32_be(state32[i], out + 4 * i);
+        } else {
+            cc_store64_be(state[i], out + 8 * i);
+        }
+    }
+}
+
+// U_1, using the cached states of the lane.
+static void ccpbkdf2_lane_first(const struct ccdigest_info *di,
+                                cchmac_ctx_t hc,
+                                struct ccpbkdf2_lane *lane,
+                                size_t saltLen, const void *salt,
+                                uint32_t blockNumber)
+{
+    uint8_t bn[4];
+
+    ccdigest_copy_state(di, cchmac_istate32(di, hc), lane->istate);
+    ccdigest_copy_state(di, cchmac_ostate32(di, hc), lane->ostate);
+    cchmac_nbits(di, hc) = di->block_size * 8;
+    cchmac_num(di, hc) = 0;
+    ccdigest_update(di, cchmac_digest_ctx(di, hc), saltLen, salt);
+
+    cc_store32_be(blockNumber, bn);
+    ccdigest_update(di, cchmac_digest_ctx(di, hc), sizeof(bn), bn);
+
+    cchmac_final(di, hc, lane->block);
+}
+
+// Job j computes output block (j % nblocks) + 1 of password j / nblocks.
+static void ccpbkdf2_hmac_lanes(const struct ccpbkdf2_engine *engine,
+                                cchmac_ctx_t hc,
+                                size_t n,
+                                const size_t *passwordLens, const void *const *passwords,
+                                const size_t *saltLens, const void *const *salts,
+                                size_t iterations,
+                                size_t dkLen, void *const *dks)
+{
+    const struct ccdigest_info *di = engine->di;
+    const size_t hLen = di->output_size;
+    const size_t bs = di->block_size;
+    const size_t nblocks = cc_ceiling(dkLen, hLen);
+    const size_t njobs = n * nblocks;
+
+    struct ccpbkdf2_lane lanes[CCPBKDF2_MAX_LANES];
+    ccdigest_state_t states[CCPBKDF2_MAX_LANES];
+    const uint8_t *blocks[CCPBKDF2_MAX_LANES];
+    uint64_t istate[CCSHA512_STATE_SIZE / sizeof(uint64_t)];
+    uint64_t ostate[CCSHA512_STATE_SIZE / sizeof(uint64_t)];
+    size_t password = SIZE_MAX;
+
+    for (size_t job = 0; job < njobs; job += CCPBKDF2_MAX_LANES) {
+        size_t m = CC_MIN(njobs - job, CCPBKDF2_MAX_LANES);
+
+        for (size_t l = 0; l < m; l++) {
+            struct ccpbkdf2_lane *lane = &lanes[l];
+            size_t p = (job + l) / nblocks;
+            size_t b = (job + l) % nblocks;
+
+            // The HMAC key schedule is computed once per password.
+            if (p != password) {
+                cchmac_init(di, hc, passwordLens[p], passwords[p]);
+                ccdigest_copy_state(di, istate, cchmac_istate32(di, hc));
+                ccdigest_copy_state(di, ostate, cchmac_ostate32(di, hc));
+                password = p;
+            }
+            ccdigest_copy_state(di, lane->istate, istate);
+            ccdigest_copy_state(di, lane->ostate, ostate);
+
+            lane->out = (uint8_t *)dks[p] + b * hLen;
+            lane->out_nbytes = CC_MIN(hLen, dkLen - b * hLen);
+
+            ccpbkdf2_lane_first(di, hc, lane, saltLens[p], salts[p], (uint32_t)(b + 1));
+            cc_memcpy(lane->acc, lane->block, hLen);
+
+            cc_clear(bs - hLen, lane->block + hLen);
+            lane->block[hLen] = 0x80;
+            cc_store64_be((uint64_t)(bs + hLen) << 3, lane->block + bs - sizeof(uint64_t));
+
+            states[l] = (ccdigest_state_t)lane->state;
+            blocks[l] = lane->block;
+        }
+
+        for (size_t iteration = 2; iteration <= iterations; iteration++) {
+            for (size_t l = 0; l < m; l++) {
+                ccdigest_copy_state(di, lanes[l].state, lanes[l].istate);
+            }
+            ccpbkdf2_compress(engine, m, states, blocks);
+            for (size_t l = 0; l < m; l++) {
+                ccpbkdf2_store(engine, lanes[l].state, lanes[l].block);
+                ccdigest_copy_state(di, lanes[l].state, lanes[l].ostate);
+            }
+            ccpbkdf2_compress(engine, m, states, blocks);
+            for (size_t l = 0; l < m; l++) {
+                ccpbkdf2_store(engine, lanes[l].state, lanes[l].block);
+                cc_xor(hLen, lanes[l].acc, lanes[l].acc, lanes[l].block);
+            }
+        }
+
+        for (size_t l = 0; l < m; l++) {
+            cc_memcpy(lanes[l].out, lanes[l].acc, lanes[l].out_nbytes);
+        }
+    }
+
+    cc_clear(sizeof(lanes), lanes);
+    cc_clear(sizeof(istate), istate);
+    cc_clear(sizeof(ostate), ostate);
+}
+
 int ccpbkdf2_hmac(const struct ccdigest_info *di,
                    size_t passwordLen, const void *password,
                    size_t saltLen, const void *salt,
@@ -81,6 +270,14 @@ int ccpbkdf2_hmac(const struct ccdigest_info *di,
 	}
 	
     cchmac_di_decl(di, hc);
+
+    struct ccpbkdf2_engine engine;
+    if (ccpbkdf2_engine(di, &engine)) {
+        ccpbkdf2_hmac_lanes(&engine, hc, 1, &passwordLen, &password, &saltLen, &salt, iterations, dkLen, &dk);
+        cchmac_di_clear(di, hc);
+        return 0;
+    }
+
     cc_unit istate[ccn_nof_size(MAX_DIGEST_STATE_SIZE)];
     cchmac_init(di, hc, passwordLen, password);
     ccdigest_copy_state(di, istate, cchmac_istate32(di, hc));
@@ -112,3 +309,29 @@ int ccpbkdf2_hmac(const struct ccdigest_info *di,
 	ccn_clear(ccn_nof_size(di->state_size), istate);
 	return 0;
 }
+
+int ccpbkdf2_hmac_mb(const struct ccdigest_info *di,
+                     size_t n,
+                     const size_t *passwordLens, const void *const *passwords,
+                     const size_t *saltLens, const void *const *salts,
+                     size_t iterations,
+                     size_t dkLen, void *const *dks)
+{
+    CC_ENSURE_DIT_ENABLED
+
+    cc_require_or_return((dkLen / di->output_size) <= UINT32_MAX, CCERR_PARAMETER);
+
+    struct ccpbkdf2_engine engine;
+    if (!ccpbkdf2_engine(di, &engine)) {
+        for (size_t i = 0; i < n; i++) {
+            cc_require_or_return(ccpbkdf2_hmac(di, passwordLens[i], passwords[i], saltLens[i], salts[i],
+                                               iterations, dkLen, dks[i]) == 0, CCERR_PARAMETER);
+        }
+        return CCERR_OK;
+    }
+
+    cchmac_di_decl(di, hc);
+    ccpbkdf2_hmac_lanes(&engine, hc, n, passwordLens, passwords, saltLens, salts, iterations, dkLen, dks);
+    cchmac_di_clear(di, hc);
+    return CCERR_OK;
+}
@@ -14,7 +14,9 @@
 
 #include <corecrypto/cc_config.h>
 #include <corecrypto/ccn.h>
+#include <corecrypto/cc_executor.h>
 #include "cc_memory.h"
+#include "cc_runtime_config.h"
 #include "cc_workspaces.h"
 #include "cczp_internal.h"
 #include "ccpolyzp_po2cyc_scalar.h"
@@ -52,6 +54,8 @@ struct ccpolyzp_po2cyc_ctx {
     /// 3) mul_modulus for root of unity powers (ccpolyzp_po2cyc_fwd_ntt_mul_modulus_rou_npowers(N) * ccrns_mul_modulus)
     /// 4) inverse root of unity powers (cc_unit[N * CCPOLYZP_PO2CYC_NUNITS_PER_COEFF] )
     /// 5) mul_modulus for inverse root of unity powers (ccpolyzp_po2cyc_fwd_ntt_mul_modulus_rou_npowers(N) * ccrns_mul_modulus)
+    /// 6) If ccpolyzp_po2cyc_ctx_has_shoup52(), 52-bit Shoup factors for the root of unity powers and the inverse root of unity
+    /// powers (2 * cc_unit[N * CCPOLYZP_PO2CYC_NUNITS_PER_COEFF])
     cc_unit data[];
 } CC_ALIGNED(CCN_UNIT_SIZE);
 typedef struct ccpolyzp_po2cyc_dims *ccpolyzp_po2cyc_dims_t;
@@ -72,6 +76,27 @@ typedef const struct ccpolyzp_po2cyc_ctx *ccpolyzp_po2cyc_ctx_const_t;
 cc_static_assert(CCPOLYZP_PO2CYC_DEGREE_MAX *CCPOLYZP_PO2CYC_NMODULI_MAX < (1 << 30),
                  "ccpolyzp_po2cyc context dimensions (degree, number of moduli) may exceed 2^30");
 
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) && !CC_KERNEL
+#define CCPOLYZP_PO2CYC_NTT_AVX512IFMA 1
+#else
+#define CCPOLYZP_PO2CYC_NTT_AVX512IFMA 0
+#endif
+
+/// @brief Exclusive upper bound on the moduli supported by the AVX-512 IFMA NTT
+/// @details Lazy intermediate values up to 4p must fit into the 52-bit IFMA multiplier inputs
+#define CCPOLYZP_PO2CYC_NTT_AVX512IFMA_MAX_MODULUS (UINT64_C(1) << 50)
+
+/// @brief Returns whether or not contexts store the 52-bit Shoup factors used by the AVX-512 IFMA NTT
+/// @details The factors take 2 * N cc_units per modulus, so they are only reserved on CPUs which can run the IFMA NTT
+CC_INLINE bool ccpolyzp_po2cyc_ctx_has_shoup52(void)
+{
+#if CCPOLYZP_PO2CYC_NTT_AVX512IFMA
+    return CC_HAS_AVX512F() && CC_HAS_AVX512IFMA();
+#else
+    return false;
+#endif
+}
+
 /// @brief Returns the number of forward NTT root of unity mul_modulus factors to pre-compute
 /// @param degree Polynomial degree
 /// @details Pre-computing a larger number of factors speeds up the FwdNTT, at the cost of more memory usage.
@@ -286,6 +311,10 @@ CC_INLINE cc_size ccpolyzp_po2cyc_ctx_nof_n(uint32_t degree)
     rv += degree * CCPOLYZP_PO2CYC_NUNITS_PER_COEFF; // inverse root of unity powers for q_L
     // mul_modulus inverse root of unity powers for q_L
     rv += ccpolyzp_po2cyc_inv_ntt_mul_modulus_rou_npowers(degree) * ccrns_mul_modulus_nof_n();
+    if (ccpolyzp_po2cyc_ctx_has_shoup52()) {
+        // 52-bit Shoup factors for the (inverse) root of unity powers for q_L
+        rv += 2 * degree * CCPOLYZP_PO2CYC_NUNITS_PER_COEFF;
+    }
     return rv;
 }
 
@@ -569,6 +598,22 @@ CC_NONNULL_ALL CC_WARN_RESULT int ccpolyzp_po2cyc_fwd_ntt(ccpolyzp_po2cyc_coeff_
 /// Note, the output x can be cast to ccpolyzp_po2cyc_coeff_t
 CC_NONNULL_ALL CC_WARN_RESULT int ccpolyzp_po2cyc_inv_ntt(ccpolyzp_po2cyc_eval_t x);
 
+/// @brief Computes the in-place forward NTT on x, transforming the RNS components concurrently. Constant-time.
+/// @param x The input/output polynomial
+/// @param executor Executor running one work item per modulus, or NULL to transform them one after the other
+/// @return CCERR_OK if successful
+/// @details The result is the same as the one of ccpolyzp_po2cyc_fwd_ntt
+CC_NONNULL((1)) CC_WARN_RESULT int ccpolyzp_po2cyc_fwd_ntt_executor(ccpolyzp_po2cyc_coeff_t x,
+                                                                    const struct cc_executor *executor);
+
+/// @brief Computes the in-place inverse NTT on x, transforming the RNS components concurrently. Constant-time.
+/// @param x The input/output polynomial
+/// @param executor Executor running one work item per modulus, or NULL to transform them one after the other
+/// @return CCERR_OK if successful
+/// @details The result is the same as the one of ccpolyzp_po2cyc_inv_ntt
+CC_NONNULL((1)) CC_WARN_RESULT int ccpolyzp_po2cyc_inv_ntt_executor(ccpolyzp_po2cyc_eval_t x,
+                                                                    const struct cc_executor *executor);
+
 /// @brief Divides and rounds each coefficient by the last modulus in the chain, q_{L-1}, then drops the last modulus.
 /// Constant-time, apart from leaking context of x, which is public
 /// @param ws Workspace
@@ -149,4 +149,67 @@ ccpolyzp_po2cyc_ctx_inv_rou_powers_mul_modulus_const(ccpolyzp_po2cyc_ctx_const_t
     return (ccrns_mul_modulus_const_t)units;
 }
 
+#if CCPOLYZP_PO2CYC_NTT_AVX512IFMA
+
+/// @brief Returns floor(w * 2^52 / p), the factor for Shoup multiplication by w with 52-bit limbs
+/// @param w The multiplicand; must be less than p
+/// @param p The modulus; must be less than CCPOLYZP_PO2CYC_NTT_AVX512IFMA_MAX_MODULUS
+CC_INLINE CC_WARN_RESULT ccrns_int ccpolyzp_po2cyc_shoup52_factor(ccrns_int w, ccrns_int p)
+{
+    cc_assert(w < p && p < CCPOLYZP_PO2CYC_NTT_AVX512IFMA_MAX_MODULUS);
+    return (ccrns_int)(((cc_dunit)w << 52) / p);
+}
+
+/// @brief Returns the 52-bit Shoup factors for the root of unity powers for a given modulus
+/// @param ctx The polynomial context
+/// @param idx The RNS index; must be less than ctx->dims.nmoduli
+/// @details out[i] will store ccpolyzp_po2cyc_shoup52_factor(w_i, q) for the i'th root of unity power w_i, if the modulus q is
+/// less than CCPOLYZP_PO2CYC_NTT_AVX512IFMA_MAX_MODULUS. The factors are only stored if ccpolyzp_po2cyc_ctx_has_shoup52().
+CC_NONNULL_ALL CC_INLINE cc_unit *ccpolyzp_po2cyc_ctx_rou_powers_shoup52(ccpolyzp_po2cyc_ctx_t ctx, uint32_t idx)
+{
+    cc_assert(idx < ctx->dims.nmoduli && ccpolyzp_po2cyc_ctx_has_shoup52());
+    cc_unit *units = (cc_unit *)ccpolyzp_po2cyc_ctx_inv_rou_powers_mul_modulus(ctx, idx);
+    units += ccpolyzp_po2cyc_inv_ntt_mul_modulus_rou_npowers(ctx->dims.degree) * ccrns_mul_modulus_nof_n();
+    return units;
+}
+
+/// @brief Returns the 52-bit Shoup factors for the root of unity powers for a given modulus
+/// @param ctx The polynomial context
+/// @param idx The RNS index; must be less than ctx->dims.nmoduli
+/// @details out[i] will store ccpolyzp_po2cyc_shoup52_factor(w_i, q) for the i'th root of unity power w_i, if the modulus q is
+/// less than CCPOLYZP_PO2CYC_NTT_AVX512IFMA_MAX_MODULUS
+CC_NONNULL_ALL CC_INLINE const cc_unit *ccpolyzp_po2cyc_ctx_rou_powers_shoup52_const(ccpolyzp_po2cyc_ctx_const_t ctx,
+                                                                                   uint32_t idx)
+{
+    cc_assert(idx < ctx->dims.nmoduli && ccpolyzp_po2cyc_ctx_has_shoup52());
+    const cc_unit *units = (const cc_unit *)ccpolyzp_po2cyc_ctx_inv_rou_powers_mul_modulus_const(ctx, idx);
+    units += ccpolyzp_po2cyc_inv_ntt_mul_modulus_rou_npowers(ctx->dims.degree) * ccrns_mul_modulus_nof_n();
+    return units;
+}
+
+/// @brief Returns the 52-bit Shoup factors for the inverse root of unity powers for a given modulus
+/// @param ctx The polynomial context
+/// @param idx The RNS index; must be less than ctx->dims.nmoduli
+/// @details out[i] will store ccpolyzp_po2cyc_shoup52_factor(w_i, q) for the i'th inverse root of unity power w_i, if the
+/// modulus q is less than CCPOLYZP_PO2CYC_NTT_AVX512IFMA_MAX_MODULUS
+CC_NONNULL_ALL CC_INLINE cc_unit *ccpolyzp_po2cyc_ctx_inv_rou_powers_shoup52(ccpolyzp_po2cyc_ctx_t ctx, uint32_t idx)
+{
+    cc_assert(idx < ctx->dims.nmoduli);
+    return ccpolyzp_po2cyc_ctx_rou_powers_shoup52(ctx, idx) + ctx->dims.degree * CCPOLYZP_PO2CYC_NUNITS_PER_COEFF;
+}
+
+/// @brief Returns the 52-bit Shoup factors for the inverse root of unity powers for a given modulus
+/// @param ctx The polynomial context
+/// @param idx The RNS index; must be less than ctx->dims.nmoduli
+/// @details out[i] will store ccpolyzp_po2cyc_shoup52_factor(w_i, q) for the i'th inverse root of unity power w_i, if the
+/// modulus q is less than CCPOLYZP_PO2CYC_NTT_AVX512IFMA_MAX_MODULUS
+CC_NONNULL_ALL CC_INLINE const cc_unit *ccpolyzp_po2cyc_ctx_inv_rou_powers_shoup52_const(ccpolyzp_po2cyc_ctx_const_t ctx,
+                                                                                       uint32_t idx)
+{
+    cc_assert(idx < ctx->dims.nmoduli);
+    return ccpolyzp_po2cyc_ctx_rou_powers_shoup52_const(ctx, idx) + ctx->dims.degree * CCPOLYZP_PO2CYC_NUNITS_PER_COEFF;
+}
+
+#endif // CCPOLYZP_PO2CYC_NTT_AVX512IFMA
+
 #endif /* _CORECRYPTO_CCPOLYZP_PO2CYC_NTT_H_ */
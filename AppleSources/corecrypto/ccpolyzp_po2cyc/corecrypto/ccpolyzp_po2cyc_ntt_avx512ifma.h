@@ -0,0 +1,64 @@
+/* Copyright (c) (2023) Apple Inc. All rights reserved.
+ *
+ * corecrypto is licensed under Apple Inc.’s Internal Use License Agreement (which
+ * is contained in the License.txt file distributed with corecrypto) and only to
+ * people who accept that license. IMPORTANT:  Any license rights granted to you by
+ * Apple Inc. (if any) are limited to internal use within your organization only on
+ * devices and computers you own or control, for the sole purpose of verifying the
+ * security characteristics and correct functioning of the Apple Software.  You may
+ * not, directly or indirectly, redistribute the Apple Software or any portions thereof.
+ */
+
+#ifndef _CORECRYPTO_CCPOLYZP_PO2CYC_NTT_AVX512IFMA_H_
+#define _CORECRYPTO_CCPOLYZP_PO2CYC_NTT_AVX512IFMA_H_
+
+#include <corecrypto/cc_config.h>
+#include "cc_runtime_config.h"
+#include "ccpolyzp_po2cyc_internal.h"
+#include "ccpolyzp_po2cyc_scalar.h"
+
+#if CCPOLYZP_PO2CYC_NTT_AVX512IFMA
+
+/// @brief Returns whether or not the AVX-512 IFMA NTT can be used for the given degree and modulus
+/// @param degree The polynomial degree
+/// @param modulus The modulus
+CC_INLINE bool ccpolyzp_po2cyc_ntt_use_avx512ifma(uint32_t degree, ccrns_int modulus)
+{
+    return degree >= 16 && modulus < CCPOLYZP_PO2CYC_NTT_AVX512IFMA_MAX_MODULUS && ccpolyzp_po2cyc_ctx_has_shoup52();
+}
+
+/// @brief AVX-512 IFMA variant of the forward NTT on a single RNS component
+/// @param degree The polynomial degree N; must be at least 16
+/// @param x The input/output coefficients; in [0, p - 1]
+/// @param p The modulus; must be less than CCPOLYZP_PO2CYC_NTT_AVX512IFMA_MAX_MODULUS
+/// @param rou_powers The root of unity powers, as returned by ccpolyzp_po2cyc_ctx_rou_powers
+/// @param rou_powers_shoup52 The 52-bit Shoup factors for rou_powers
+/// @details Callers must check ccpolyzp_po2cyc_ntt_use_avx512ifma() first. The output is the same as the portable NTT's.
+CC_NONNULL_ALL
+void ccpolyzp_po2cyc_fwd_ntt_avx512ifma(uint32_t degree,
+                                        ccrns_int *x,
+                                        ccrns_int p,
+                                        const ccrns_int *rou_powers,
+                                        const ccrns_int *rou_powers_shoup52);
+
+/// @brief AVX-512 IFMA variant of the inverse NTT on a single RNS component
+/// @param degree The polynomial degree N; must be at least 16
+/// @param x The input/output coefficients; in [0, p - 1]
+/// @param p The modulus; must be less than CCPOLYZP_PO2CYC_NTT_AVX512IFMA_MAX_MODULUS
+/// @param inv_rou_powers The inverse root of unity powers, as returned by ccpolyzp_po2cyc_ctx_inv_rou_powers
+/// @param inv_rou_powers_shoup52 The 52-bit Shoup factors for inv_rou_powers
+/// @param n_inv Multiplication by N^{-1} mod p
+/// @param n_inv_w_n2 Multiplication by N^{-1} * w^{-N/2} mod p
+/// @details Callers must check ccpolyzp_po2cyc_ntt_use_avx512ifma() first. The output is the same as the portable NTT's.
+CC_NONNULL_ALL
+void ccpolyzp_po2cyc_inv_ntt_avx512ifma(uint32_t degree,
+                                        ccrns_int *x,
+                                        ccrns_int p,
+                                        const ccrns_int *inv_rou_powers,
+                                        const ccrns_int *inv_rou_powers_shoup52,
+                                        ccrns_mul_modulus_const_t n_inv,
+                                        ccrns_mul_modulus_const_t n_inv_w_n2);
+
+#endif // CCPOLYZP_PO2CYC_NTT_AVX512IFMA
+
+#endif /* _CORECRYPTO_CCPOLYZP_PO2CYC_NTT_AVX512IFMA_H_ */
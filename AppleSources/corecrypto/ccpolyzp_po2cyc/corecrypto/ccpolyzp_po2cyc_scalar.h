@@ -217,6 +217,20 @@ CC_INLINE void ccpolyzp_po2cyc_scalar_mul(ccrns_int *r, ccrns_int x, ccrns_int y
 #endif
 }
 
+/// @brief Computes r += x * y
+/// @param r Stores the accumulator as 2 * CCRNS_INT_NBITS, with r[0] storing the low CCRNS_INT_NBITS bits.
+/// @param x Multiplicand
+/// @param y Multiplicand
+/// @return Whether or not the accumulator overflowed
+CC_INLINE CC_WARN_RESULT bool ccpolyzp_po2cyc_scalar_mul_add(ccrns_int *r, ccrns_int x, ccrns_int y)
+{
+    ccrns_int prod[2];
+    ccpolyzp_po2cyc_scalar_mul(prod, x, y);
+    // The high word of the product is at most 2^CCRNS_INT_NBITS - 2, so adding the carry can't overflow
+    prod[1] += (ccrns_int)cc_add_overflow(r[0], prod[0], &r[0]);
+    return cc_add_overflow(r[1], prod[1], &r[1]);
+}
+
 /// @brief Returns x % p
 /// @param x Value to reduce
 /// @param p Modulus; must be in [2, 2^63 - 1]
@@ -19,6 +19,7 @@
 #include "testccnBuffer.h"
 #include "crypto_test_ccpolyzp_po2cyc.h"
 #include "cc.h"
+#include "cctest_executor.h"
 
 /// Returns a uniform random number in [0, max - 1].
 ccrns_int rns_int_uniform(ccrns_int max)
@@ -1058,9 +1059,10 @@ static void test_ccpolyzp_po2cyc_ntt(void)
     }
     // Random round-trip
     {
-        ccrns_int moduli[] = { 40961, (1ULL << 60) - (1ULL << 18) + 1 };
+        ccrns_int moduli[] = { 40961, (1ULL << 60) - (1ULL << 18) + 1, (1ULL << 50) - (23ULL << 17) + 1 };
         uint32_t nmoduli = CC_ARRAY_LEN(moduli);
         for (uint32_t degree = 4; degree <= 1024; degree <<= 1) {
+            CC_DECL_BP_WS(ws, bp);
             struct ccpolyzp_po2cyc_dims dims = { .degree = degree, .nmoduli = nmoduli };
             ccrns_int data_coeff[nmoduli * dims.degree];
             for (uint32_t rns_idx = 0, data_idx = 0; rns_idx < dims.nmoduli; ++rns_idx) {
@@ -1075,12 +1077,15 @@ static void test_ccpolyzp_po2cyc_ntt(void)
             is(ccpolyzp_po2cyc_fwd_ntt(poly_coeff), CCERR_OK, "test_fwd_ntt error");
             is(ccpolyzp_po2cyc_inv_ntt((ccpolyzp_po2cyc_eval_t)poly_coeff), CCERR_OK, "test_inv_ntt error");
             is(ccpolyzp_po2cyc_coeff_eq(poly_coeff, poly_orig_coeff), true, "test_ntt roundtrip");
+            CC_FREE_BP_WS(ws, bp);
         }
     }
     // NTT can be used for polynomial multiplication
     {
-        ccrns_int moduli[] = { (1ULL << 60) - (1ULL << 18) + 1 };
+        // The 50-bit modulus uses the AVX-512 IFMA NTT, where available
+        ccrns_int moduli[] = { (1ULL << 60) - (1ULL << 18) + 1, (1ULL << 50) - (23ULL << 17) + 1 };
         for (uint32_t degree = 4; degree <= 1024; degree <<= 1) {
+            CC_DECL_BP_WS(ws, bp);
             struct ccpolyzp_po2cyc_dims dims = { .degree = degree, .nmoduli = CC_ARRAY_LEN(moduli) };
             ccrns_int data_x_coeff[dims.nmoduli * dims.degree];
             ccrns_int data_y_coeff[dims.nmoduli * dims.degree];
@@ -1134,7 +1139,41 @@ static void test_ccpolyzp_po2cyc_ntt(void)
             is(ccpolyzp_po2cyc_coeff_eq((ccpolyzp_po2cyc_coeff_const_t)ntt_out_eval, naive_out_coeff),
                true,
                "test_ntt multiplication matches schoolbook");
+            CC_FREE_BP_WS(ws, bp);
+        }
+    }
+    CC_FREE_WORKSPACE(ws);
+}
+
+static void test_ccpolyzp_po2cyc_ntt_executor(void)
+{
+    CC_DECL_WORKSPACE_TEST(ws);
+
+    ccrns_int moduli[] = { 40961, (1ULL << 60) - (1ULL << 18) + 1, (1ULL << 50) - (23ULL << 17) + 1 };
+    uint32_t nmoduli = CC_ARRAY_LEN(moduli);
+    for (uint32_t degree = 4; degree <= 1024; degree <<= 2) {
+        CC_DECL_BP_WS(ws, bp);
+        struct ccpolyzp_po2cyc_dims dims = { .degree = degree, .nmoduli = nmoduli };
+        ccrns_int data_coeff[nmoduli * dims.degree];
+        for (uint32_t rns_idx = 0, data_idx = 0; rns_idx < dims.nmoduli; ++rns_idx) {
+            for (uint32_t coeff_idx = 0; coeff_idx < dims.degree; ++coeff_idx) {
+                data_coeff[data_idx++] = rns_int_uniform(moduli[rns_idx]);
+            }
         }
+
+        ccpolyzp_po2cyc_coeff_t poly_coeff = ccpolyzp_po2cyc_coeff_init_helper(ws, &dims, moduli, data_coeff);
+        ccpolyzp_po2cyc_coeff_t poly_executor_coeff = ccpolyzp_po2cyc_coeff_init_helper(ws, &dims, moduli, data_coeff);
+
+        is(ccpolyzp_po2cyc_fwd_ntt(poly_coeff), CCERR_OK, "test_fwd_ntt error");
+        is(ccpolyzp_po2cyc_fwd_ntt_executor(poly_executor_coeff, &cctest_executor), CCERR_OK, "test_fwd_ntt_executor error");
+        is(ccpolyzp_po2cyc_coeff_eq(poly_executor_coeff, poly_coeff), true, "test_fwd_ntt_executor matches fwd_ntt");
+
+        is(ccpolyzp_po2cyc_inv_ntt((ccpolyzp_po2cyc_eval_t)poly_coeff), CCERR_OK, "test_inv_ntt error");
+        is(ccpolyzp_po2cyc_inv_ntt_executor((ccpolyzp_po2cyc_eval_t)poly_executor_coeff, &cctest_executor),
+           CCERR_OK,
+           "test_inv_ntt_executor error");
+        is(ccpolyzp_po2cyc_coeff_eq(poly_executor_coeff, poly_coeff), true, "test_inv_ntt_executor matches inv_ntt");
+        CC_FREE_BP_WS(ws, bp);
     }
     CC_FREE_WORKSPACE(ws);
 }
@@ -1254,7 +1293,7 @@ static void test_ccpolyzp_po2cyc_divide_and_round_q_last(void)
 
 int ccpolyzp_po2cyc_tests(TM_UNUSED int argc, TM_UNUSED char *const *argv)
 {
-    int ntests = 6576;
+    int ntests = 6626;
 #if CORECRYPTO_DEBUG
     ntests += 1;
 #endif
@@ -1278,6 +1317,7 @@ int ccpolyzp_po2cyc_tests(TM_UNUSED int argc, TM_UNUSED char *const *argv)
     test_ccpolyzp_po2cyc_mul();
     test_ccpolyzp_po2cyc_coeff_scalar_mul();
     test_ccpolyzp_po2cyc_ntt();
+    test_ccpolyzp_po2cyc_ntt_executor();
     test_ccpolyzp_po2cyc_divide_and_round_q_last();
     test_ccpolyzp_po2cyc_random();
     test_ccpolyzp_po2cyc_serialization();
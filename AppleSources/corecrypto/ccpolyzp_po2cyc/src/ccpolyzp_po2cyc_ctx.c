@@ -311,6 +311,22 @@ static int ccpolyzp_po2cyc_ctx_init_ntt_ws(cc_ws_t ws, ccpolyzp_po2cyc_ctx_t con
         }
     }
 
+#if CCPOLYZP_PO2CYC_NTT_AVX512IFMA
+    // Shoup factors for all (inverse) root of unity powers, used by the AVX-512 IFMA NTT
+    if (ccpolyzp_po2cyc_ctx_has_shoup52()) {
+        cc_unit *rou_powers_shoup52 = ccpolyzp_po2cyc_ctx_rou_powers_shoup52(context, rns_idx);
+        cc_unit *inv_rou_powers_shoup52 = ccpolyzp_po2cyc_ctx_inv_rou_powers_shoup52(context, rns_idx);
+        if (rns_modulus->value < CCPOLYZP_PO2CYC_NTT_AVX512IFMA_MAX_MODULUS) {
+            for (uint32_t i = 0; i < dims->degree; ++i) {
+                rou_powers_shoup52[i] = ccpolyzp_po2cyc_shoup52_factor(rou_powers[i], rns_modulus->value);
+                inv_rou_powers_shoup52[i] = ccpolyzp_po2cyc_shoup52_factor(inv_rou_powers[i], rns_modulus->value);
+            }
+        } else {
+            ccn_clear(2 * dims->degree, rou_powers_shoup52);
+        }
+    }
+#endif
+
     // Pre-computation for final layer of inverse NTT: modular multiplication with N^{-1} % q_i, and N^{-1} * w^{-N/2} % q_i
     ccrns_int n_mod_qi = ccpolyzp_po2cyc_scalar_mod1(dims->degree, rns_modulus);
     cc_unit n_mod_qi_units[CCPOLYZP_PO2CYC_NUNITS_PER_COEFF];
@@ -12,6 +12,7 @@
 #include "ccpolyzp_po2cyc_ntt.h"
 #include "ccpolyzp_po2cyc_scalar.h"
 #include "ccpolyzp_po2cyc_debug.h"
+#include "ccpolyzp_po2cyc_ntt_avx512ifma.h"
 
 /// @brief Computes the lazy radix-2 butterfly
 /// @param x Butterfly input/output; in [0, 4p - 1]
@@ -56,57 +57,88 @@ CC_NONNULL_ALL static void fwd_butterfly_radix2_shoup(cc_unit *x, cc_unit *y, cc
     ccpolyzp_po2cyc_rns_int_to_units(y, y_int);
 }
 
-int ccpolyzp_po2cyc_fwd_ntt(ccpolyzp_po2cyc_coeff_t poly)
+/// @brief Computes the forward NTT on the rns_idx'th RNS component of poly
+/// @param poly The input/output polynomial
+/// @param rns_idx The RNS index; the modulus must be less than 2^62
+CC_NONNULL_ALL static void ccpolyzp_po2cyc_fwd_ntt_rns(ccpolyzp_po2cyc_coeff_t poly, uint32_t rns_idx)
 {
     ccpolyzp_po2cyc_ctx_const_t ctx = poly->context;
     uint32_t n = ctx->dims.degree;
-    cc_require_or_return(ctx->ntt_friendly && n > 2, CCERR_PARAMETER);
+    ccrns_modulus_const_t modulus = ccpolyzp_po2cyc_ctx_ccrns_modulus(ctx, rns_idx);
+    cc_unit *x = CCPOLYZP_PO2CYC_DATA(poly, rns_idx, 0);
 
-    for (uint32_t rns_idx = 0; rns_idx < ctx->dims.nmoduli; ++rns_idx) {
-        ccrns_modulus_const_t modulus = ccpolyzp_po2cyc_ctx_ccrns_modulus(ctx, rns_idx);
-        ccrns_modulus_const_t rns_modulus = ccpolyzp_po2cyc_ctx_ccrns_modulus(ctx, rns_idx);
-        // Intermediate value from lazy NTT may overflow to 4 * modulus
-        cc_require_or_return(rns_modulus->value < (1ULL << 62), CCERR_PARAMETER);
-
-        const cc_unit *rou_powers = ccpolyzp_po2cyc_ctx_rou_powers_const(ctx, rns_idx);
-        ccrns_mul_modulus_const_t rou_powers_mul_modulus = ccpolyzp_po2cyc_ctx_rou_powers_mul_modulus_const(ctx, rns_idx);
-
-        cc_unit *x = CCPOLYZP_PO2CYC_DATA(poly, rns_idx, 0);
-        for (uint32_t m = 1, t = n >> 1; m < n; m <<= 1, t >>= 1) {
-            for (uint32_t i = 0; i < m; ++i) {
-                uint32_t rou_idx = (m + i) * CCPOLYZP_PO2CYC_NUNITS_PER_COEFF;
-                uint32_t j1 = 2 * i * t;
-                if (rou_idx < ccpolyzp_po2cyc_fwd_ntt_mul_modulus_rou_npowers(n)) {
-                    ccrns_mul_modulus_const_t rou_mul_modulus = &rou_powers_mul_modulus[rou_idx];
-                    for (uint32_t j = j1; j < j1 + t; ++j) {
-                        cc_unit *x_butterfly = x + j * CCPOLYZP_PO2CYC_NUNITS_PER_COEFF;
-                        cc_unit *y_butterfly = x + (j + t) * CCPOLYZP_PO2CYC_NUNITS_PER_COEFF;
-                        fwd_butterfly_radix2_shoup(x_butterfly, y_butterfly, rou_mul_modulus);
-                    }
-                } else {
-                    const cc_unit *rou = &rou_powers[rou_idx];
-                    for (uint32_t j = j1; j < j1 + t; ++j) {
-                        cc_unit *x_butterfly = x + j * CCPOLYZP_PO2CYC_NUNITS_PER_COEFF;
-                        cc_unit *y_butterfly = x + (j + t) * CCPOLYZP_PO2CYC_NUNITS_PER_COEFF;
-                        fwd_butterfly_radix2(x_butterfly, y_butterfly, rou, modulus);
-                    }
+#if CCPOLYZP_PO2CYC_NTT_AVX512IFMA
+    if (ccpolyzp_po2cyc_ntt_use_avx512ifma(n, modulus->value)) {
+        ccpolyzp_po2cyc_fwd_ntt_avx512ifma(n,
+                                           x,
+                                           modulus->value,
+                                           ccpolyzp_po2cyc_ctx_rou_powers_const(ctx, rns_idx),
+                                           ccpolyzp_po2cyc_ctx_rou_powers_shoup52_const(ctx, rns_idx));
+        return;
+    }
+#endif
+
+    const cc_unit *rou_powers = ccpolyzp_po2cyc_ctx_rou_powers_const(ctx, rns_idx);
+    ccrns_mul_modulus_const_t rou_powers_mul_modulus = ccpolyzp_po2cyc_ctx_rou_powers_mul_modulus_const(ctx, rns_idx);
+
+    for (uint32_t m = 1, t = n >> 1; m < n; m <<= 1, t >>= 1) {
+        for (uint32_t i = 0; i < m; ++i) {
+            uint32_t rou_idx = (m + i) * CCPOLYZP_PO2CYC_NUNITS_PER_COEFF;
+            uint32_t j1 = 2 * i * t;
+            if (rou_idx < ccpolyzp_po2cyc_fwd_ntt_mul_modulus_rou_npowers(n)) {
+                ccrns_mul_modulus_const_t rou_mul_modulus = &rou_powers_mul_modulus[rou_idx];
+                for (uint32_t j = j1; j < j1 + t; ++j) {
+                    cc_unit *x_butterfly = x + j * CCPOLYZP_PO2CYC_NUNITS_PER_COEFF;
+                    cc_unit *y_butterfly = x + (j + t) * CCPOLYZP_PO2CYC_NUNITS_PER_COEFF;
+                    fwd_butterfly_radix2_shoup(x_butterfly, y_butterfly, rou_mul_modulus);
+                }
+            } else {
+                const cc_unit *rou = &rou_powers[rou_idx];
+                for (uint32_t j = j1; j < j1 + t; ++j) {
+                    cc_unit *x_butterfly = x + j * CCPOLYZP_PO2CYC_NUNITS_PER_COEFF;
+                    cc_unit *y_butterfly = x + (j + t) * CCPOLYZP_PO2CYC_NUNITS_PER_COEFF;
+                    fwd_butterfly_radix2(x_butterfly, y_butterfly, rou, modulus);
                 }
             }
         }
-        // Reduce from [0, 4p - 1] to [0, p - 1]
-        for (uint32_t i = 0; i < n; ++i) {
-            ccrns_int x_int = ccpolyzp_po2cyc_units_to_rns_int(x);
-            cc_assert(x_int < rns_modulus->value << 2);
-            x_int = ccpolyzp_po2cyc_scalar_cond_sub(x_int, rns_modulus->value << 1);
-            x_int = ccpolyzp_po2cyc_scalar_cond_sub(x_int, rns_modulus->value);
-            cc_assert(x_int < rns_modulus->value);
-            ccpolyzp_po2cyc_rns_int_to_units(x, x_int);
-            x += CCPOLYZP_PO2CYC_NUNITS_PER_COEFF;
-        }
     }
+    // Reduce from [0, 4p - 1] to [0, p - 1]
+    for (uint32_t i = 0; i < n; ++i) {
+        ccrns_int x_int = ccpolyzp_po2cyc_units_to_rns_int(x);
+        cc_assert(x_int < modulus->value << 2);
+        x_int = ccpolyzp_po2cyc_scalar_cond_sub(x_int, modulus->value << 1);
+        x_int = ccpolyzp_po2cyc_scalar_cond_sub(x_int, modulus->value);
+        cc_assert(x_int < modulus->value);
+        ccpolyzp_po2cyc_rns_int_to_units(x, x_int);
+        x += CCPOLYZP_PO2CYC_NUNITS_PER_COEFF;
+    }
+}
+
+static void ccpolyzp_po2cyc_fwd_ntt_work(void *work_ctx, size_t i)
+{
+    ccpolyzp_po2cyc_fwd_ntt_rns((ccpolyzp_po2cyc_coeff_t)work_ctx, (uint32_t)i);
+}
+
+int ccpolyzp_po2cyc_fwd_ntt_executor(ccpolyzp_po2cyc_coeff_t poly, const struct cc_executor *executor)
+{
+    ccpolyzp_po2cyc_ctx_const_t ctx = poly->context;
+    cc_require_or_return(ctx->ntt_friendly && ctx->dims.degree > 2, CCERR_PARAMETER);
+
+    for (uint32_t rns_idx = 0; rns_idx < ctx->dims.nmoduli; ++rns_idx) {
+        ccrns_modulus_const_t modulus = ccpolyzp_po2cyc_ctx_ccrns_modulus(ctx, rns_idx);
+        // Intermediate value from lazy NTT may overflow to 4 * modulus
+        cc_require_or_return(modulus->value < (1ULL << 62), CCERR_PARAMETER);
+    }
+
+    cc_executor_apply(executor, ctx->dims.nmoduli, poly, ccpolyzp_po2cyc_fwd_ntt_work);
     return CCERR_OK;
 }
 
+int ccpolyzp_po2cyc_fwd_ntt(ccpolyzp_po2cyc_coeff_t poly)
+{
+    return ccpolyzp_po2cyc_fwd_ntt_executor(poly, NULL);
+}
+
 /// @brief Computes the lazy radix-2 butterfly
 /// @param x Butterfly input/output; in [0, 2p - 1]
 /// @param y Butterfly input/output; in [0, 2p - 1]
@@ -149,64 +181,98 @@ CC_NONNULL_ALL static void inv_butterfly_radix2_shoup(cc_unit *x, cc_unit *y, cc
     ccpolyzp_po2cyc_rns_int_to_units(y, y_int);
 }
 
-int ccpolyzp_po2cyc_inv_ntt(ccpolyzp_po2cyc_eval_t poly)
+/// @brief Computes the inverse NTT on the rns_idx'th RNS component of poly
+/// @param poly The input/output polynomial
+/// @param rns_idx The RNS index; the modulus must be less than 2^63
+CC_NONNULL_ALL static void ccpolyzp_po2cyc_inv_ntt_rns(ccpolyzp_po2cyc_eval_t poly, uint32_t rns_idx)
 {
     ccpolyzp_po2cyc_ctx_const_t ctx = poly->context;
     uint32_t n = ctx->dims.degree;
-    cc_require_or_return(ctx->ntt_friendly && n > 2, CCERR_PARAMETER);
+    ccrns_modulus_const_t modulus = ccpolyzp_po2cyc_ctx_ccrns_modulus(ctx, rns_idx);
+    ccrns_mul_modulus_const_t n_inv_w_n2 = ccpolyzp_po2cyc_ctx_inv_rou_power_n2_const(ctx, rns_idx);
+    ccrns_mul_modulus_const_t n_inv = ccpolyzp_po2cyc_ctx_inv_degree_const(ctx, rns_idx);
+    cc_unit *x = CCPOLYZP_PO2CYC_DATA(poly, rns_idx, 0);
 
-    for (uint32_t rns_idx = 0; rns_idx < ctx->dims.nmoduli; ++rns_idx) {
-        ccrns_modulus_const_t modulus = ccpolyzp_po2cyc_ctx_ccrns_modulus(ctx, rns_idx);
-        // Intermediate value from lazy NTT may overflow to 2 * modulus
-        cc_require_or_return(modulus->value < (1ULL << 63), CCERR_PARAMETER);
+#if CCPOLYZP_PO2CYC_NTT_AVX512IFMA
+    if (ccpolyzp_po2cyc_ntt_use_avx512ifma(n, modulus->value)) {
+        ccpolyzp_po2cyc_inv_ntt_avx512ifma(n,
+                                           x,
+                                           modulus->value,
+                                           ccpolyzp_po2cyc_ctx_inv_rou_powers_const(ctx, rns_idx),
+                                           ccpolyzp_po2cyc_ctx_inv_rou_powers_shoup52_const(ctx, rns_idx),
+                                           n_inv,
+                                           n_inv_w_n2);
+        return;
+    }
+#endif
 
-        const cc_unit *inv_rou_powers = ccpolyzp_po2cyc_ctx_inv_rou_powers_const(ctx, rns_idx);
-        ccrns_mul_modulus_const_t inv_rou_powers_mul_modulus = ccpolyzp_po2cyc_ctx_inv_rou_powers_mul_modulus_const(ctx, rns_idx);
-        uint32_t root_idx = 1;
-
-        cc_unit *x = CCPOLYZP_PO2CYC_DATA(poly, rns_idx, 0);
-        for (uint32_t m = n >> 1, t = 1; m > 1; m >>= 1, t <<= 1) {
-            for (uint32_t i = 0; i < m; ++i, root_idx++) {
-                uint32_t j1 = 2 * i * t;
-                if (root_idx >= n - ccpolyzp_po2cyc_inv_ntt_mul_modulus_rou_npowers(n)) {
-                    ccrns_mul_modulus_const_t inv_rou_mul_modulus = &inv_rou_powers_mul_modulus[n - root_idx - 1];
-                    for (uint32_t j = j1; j < j1 + t; ++j) {
-                        cc_unit *x_butterfly = x + j * CCPOLYZP_PO2CYC_NUNITS_PER_COEFF;
-                        cc_unit *y_butterfly = x + (j + t) * CCPOLYZP_PO2CYC_NUNITS_PER_COEFF;
-                        inv_butterfly_radix2_shoup(x_butterfly, y_butterfly, inv_rou_mul_modulus);
-                    }
-                } else {
-                    const cc_unit *inv_rou_pow = &inv_rou_powers[root_idx * CCPOLYZP_PO2CYC_NUNITS_PER_COEFF];
-                    for (uint32_t j = j1; j < j1 + t; ++j) {
-                        cc_unit *x_butterfly = x + j * CCPOLYZP_PO2CYC_NUNITS_PER_COEFF;
-                        cc_unit *y_butterfly = x + (j + t) * CCPOLYZP_PO2CYC_NUNITS_PER_COEFF;
-                        inv_butterfly_radix2(x_butterfly, y_butterfly, inv_rou_pow, modulus);
-                    }
+    const cc_unit *inv_rou_powers = ccpolyzp_po2cyc_ctx_inv_rou_powers_const(ctx, rns_idx);
+    ccrns_mul_modulus_const_t inv_rou_powers_mul_modulus = ccpolyzp_po2cyc_ctx_inv_rou_powers_mul_modulus_const(ctx, rns_idx);
+    uint32_t root_idx = 1;
+
+    for (uint32_t m = n >> 1, t = 1; m > 1; m >>= 1, t <<= 1) {
+        for (uint32_t i = 0; i < m; ++i, root_idx++) {
+            uint32_t j1 = 2 * i * t;
+            if (root_idx >= n - ccpolyzp_po2cyc_inv_ntt_mul_modulus_rou_npowers(n)) {
+                ccrns_mul_modulus_const_t inv_rou_mul_modulus = &inv_rou_powers_mul_modulus[n - root_idx - 1];
+                for (uint32_t j = j1; j < j1 + t; ++j) {
+                    cc_unit *x_butterfly = x + j * CCPOLYZP_PO2CYC_NUNITS_PER_COEFF;
+                    cc_unit *y_butterfly = x + (j + t) * CCPOLYZP_PO2CYC_NUNITS_PER_COEFF;
+                    inv_butterfly_radix2_shoup(x_butterfly, y_butterfly, inv_rou_mul_modulus);
+                }
+            } else {
+                const cc_unit *inv_rou_pow = &inv_rou_powers[root_idx * CCPOLYZP_PO2CYC_NUNITS_PER_COEFF];
+                for (uint32_t j = j1; j < j1 + t; ++j) {
+                    cc_unit *x_butterfly = x + j * CCPOLYZP_PO2CYC_NUNITS_PER_COEFF;
+                    cc_unit *y_butterfly = x + (j + t) * CCPOLYZP_PO2CYC_NUNITS_PER_COEFF;
+                    inv_butterfly_radix2(x_butterfly, y_butterfly, inv_rou_pow, modulus);
                 }
             }
         }
+    }
 
-        // Fuse multiplication by n^{-1} with last iteration
-        cc_unit *y = CCPOLYZP_PO2CYC_DATA(poly, rns_idx, n >> 1);
-        ccrns_mul_modulus_const_t n_inv_w_n2 = ccpolyzp_po2cyc_ctx_inv_rou_power_n2_const(ctx, rns_idx);
-        ccrns_mul_modulus_const_t n_inv = ccpolyzp_po2cyc_ctx_inv_degree_const(ctx, rns_idx);
-        for (uint32_t j = 0; j < n / 2; ++j) {
-            // x_out <- n^{-1} (x_in + y_in) mod modulus
-            // y_out <- n^{-1} * w (x_in - y_in) mod modulus
-            ccrns_int x_int = ccpolyzp_po2cyc_units_to_rns_int(x);
-            ccrns_int y_int = ccpolyzp_po2cyc_units_to_rns_int(y);
-
-            ccrns_int tx = ccpolyzp_po2cyc_scalar_add_mod(x_int, y_int, modulus->value << 1);
-            ccrns_int ty = x_int + (modulus->value << 1) - y_int;
-
-            x_int = ccpolyzp_po2cyc_scalar_shoup_mul_mod(tx, n_inv);
-            y_int = ccpolyzp_po2cyc_scalar_shoup_mul_mod(ty, n_inv_w_n2);
-            ccpolyzp_po2cyc_rns_int_to_units(x, x_int);
-            ccpolyzp_po2cyc_rns_int_to_units(y, y_int);
-
-            x += CCPOLYZP_PO2CYC_NUNITS_PER_COEFF;
-            y += CCPOLYZP_PO2CYC_NUNITS_PER_COEFF;
-        }
+    // Fuse multiplication by n^{-1} with last iteration
+    cc_unit *y = CCPOLYZP_PO2CYC_DATA(poly, rns_idx, n >> 1);
+    for (uint32_t j = 0; j < n / 2; ++j) {
+        // x_out <- n^{-1} (x_in + y_in) mod modulus
+        // y_out <- n^{-1} * w (x_in - y_in) mod modulus
+        ccrns_int x_int = ccpolyzp_po2cyc_units_to_rns_int(x);
+        ccrns_int y_int = ccpolyzp_po2cyc_units_to_rns_int(y);
+
+        ccrns_int tx = ccpolyzp_po2cyc_scalar_add_mod(x_int, y_int, modulus->value << 1);
+        ccrns_int ty = x_int + (modulus->value << 1) - y_int;
+
+        x_int = ccpolyzp_po2cyc_scalar_shoup_mul_mod(tx, n_inv);
+        y_int = ccpolyzp_po2cyc_scalar_shoup_mul_mod(ty, n_inv_w_n2);
+        ccpolyzp_po2cyc_rns_int_to_units(x, x_int);
+        ccpolyzp_po2cyc_rns_int_to_units(y, y_int);
+
+        x += CCPOLYZP_PO2CYC_NUNITS_PER_COEFF;
+        y += CCPOLYZP_PO2CYC_NUNITS_PER_COEFF;
     }
+}
+
+static void ccpolyzp_po2cyc_inv_ntt_work(void *work_ctx, size_t i)
+{
+    ccpolyzp_po2cyc_inv_ntt_rns((ccpolyzp_po2cyc_eval_t)work_ctx, (uint32_t)i);
+}
+
+int ccpolyzp_po2cyc_inv_ntt_executor(ccpolyzp_po2cyc_eval_t poly, const struct cc_executor *executor)
+{
+    ccpolyzp_po2cyc_ctx_const_t ctx = poly->context;
+    cc_require_or_return(ctx->ntt_friendly && ctx->dims.degree > 2, CCERR_PARAMETER);
+
+    for (uint32_t rns_idx = 0; rns_idx < ctx->dims.nmoduli; ++rns_idx) {
+        ccrns_modulus_const_t modulus = ccpolyzp_po2cyc_ctx_ccrns_modulus(ctx, rns_idx);
+        // Intermediate value from lazy NTT may overflow to 2 * modulus
+        cc_require_or_return(modulus->value < (1ULL << 63), CCERR_PARAMETER);
+    }
+
+    cc_executor_apply(executor, ctx->dims.nmoduli, poly, ccpolyzp_po2cyc_inv_ntt_work);
     return CCERR_OK;
 }
+
+int ccpolyzp_po2cyc_inv_ntt(ccpolyzp_po2cyc_eval_t poly)
+{
+    return ccpolyzp_po2cyc_inv_ntt_executor(poly, NULL);
+}
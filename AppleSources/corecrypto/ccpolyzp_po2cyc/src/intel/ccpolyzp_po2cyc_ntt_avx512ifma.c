@@ -0,0 +1,250 @@
+/* Copyright (c) (2023) Apple Inc. All rights reserved.
+ *
+ * corecrypto is licensed under Apple Inc.’s Internal Use License Agreement (which
+ * is contained in the License.txt file distributed with corecrypto) and only to
+ * people who accept that license. IMPORTANT:  Any license rights granted to you by
+ * Apple Inc. (if any) are limited to internal use within your organization only on
+ * devices and computers you own or control, for the sole purpose of verifying the
+ * security characteristics and correct functioning of the Apple Software.  You may
+ * not, directly or indirectly, redistribute the Apple Software or any portions thereof.
+ */
+
+#include "cc_internal.h"
+#include "ccpolyzp_po2cyc_ntt_avx512ifma.h"
+
+#if CCPOLYZP_PO2CYC_NTT_AVX512IFMA
+
+#include <immintrin.h>
+
+#define CCPOLYZP_PO2CYC_AVX512IFMA_TARGET __attribute__((target("avx512f,avx512ifma")))
+
+/// Number of coefficients per vector
+#define NLANES 8
+
+/// Moduli and masks shared by all butterflies of an NTT
+struct ntt_consts {
+    __m512i p;
+    __m512i two_p;
+    __m512i neg_p;  // 2^52 - p
+    __m512i mask52; // 2^52 - 1
+};
+
+CCPOLYZP_PO2CYC_AVX512IFMA_TARGET
+static inline struct ntt_consts ntt_consts_init(ccrns_int p)
+{
+    struct ntt_consts c = {
+        .p = _mm512_set1_epi64((long long)p),
+        .two_p = _mm512_set1_epi64((long long)(p << 1)),
+        .neg_p = _mm512_set1_epi64((long long)((UINT64_C(1) << 52) - p)),
+        .mask52 = _mm512_set1_epi64((long long)((UINT64_C(1) << 52) - 1)),
+    };
+    return c;
+}
+
+/// Returns x mod p for x in [0, 2p - 1]
+CCPOLYZP_PO2CYC_AVX512IFMA_TARGET
+static inline __m512i cond_sub(__m512i x, __m512i p)
+{
+    // x - p wraps around to a large value iff x < p
+    return _mm512_min_epu64(x, _mm512_sub_epi64(x, p));
+}
+
+/// Returns r in [0, 2p - 1] with r mod p = w * y mod p, for y < 2^52 and w_shoup = floor(w * 2^52 / p)
+/// @details Same as ccpolyzp_po2cyc_scalar_shoup_mul_mod_lazy, with 2^52 in place of 2^64. w * y - q * p is known
+/// to be less than 2p < 2^52, so computing it modulo 2^52 suffices.
+CCPOLYZP_PO2CYC_AVX512IFMA_TARGET
+static inline __m512i mul_mod_lazy(__m512i y, __m512i w, __m512i w_shoup, const struct ntt_consts *c)
+{
+    __m512i zero = _mm512_setzero_si512();
+    __m512i q = _mm512_madd52hi_epu64(zero, w_shoup, y);
+    __m512i r = _mm512_madd52lo_epu64(zero, w, y);
+    r = _mm512_madd52lo_epu64(r, q, c->neg_p);
+    return _mm512_and_si512(r, c->mask52);
+}
+
+/// Computes x_out <- (x_in + w * y_in) mod p, y_out <- (x_in - w * y_in) mod p, with all values in [0, 4p - 1]
+CCPOLYZP_PO2CYC_AVX512IFMA_TARGET
+static inline void fwd_butterfly(__m512i *x, __m512i *y, __m512i w, __m512i w_shoup, const struct ntt_consts *c)
+{
+    __m512i x0 = cond_sub(*x, c->two_p);
+    __m512i t = mul_mod_lazy(*y, w, w_shoup, c);
+    *y = _mm512_sub_epi64(_mm512_add_epi64(x0, c->two_p), t);
+    *x = _mm512_add_epi64(x0, t);
+}
+
+/// Computes x_out <- (x_in + y_in) mod p, y_out <- w * (x_in - y_in) mod p, with all values in [0, 2p - 1]
+CCPOLYZP_PO2CYC_AVX512IFMA_TARGET
+static inline void inv_butterfly(__m512i *x, __m512i *y, __m512i w, __m512i w_shoup, const struct ntt_consts *c)
+{
+    __m512i t = _mm512_sub_epi64(_mm512_add_epi64(*x, c->two_p), *y);
+    *x = cond_sub(_mm512_add_epi64(*x, *y), c->two_p);
+    *y = mul_mod_lazy(t, w, w_shoup, c);
+}
+
+/*
+ The last three layers of the forward NTT (first three of the inverse NTT)
+ have butterflies with distance t = 4, 2, 1 and are done on blocks of 16
+ coefficients held in two vectors v0, v1. The permutations below gather the
+ x and y inputs of the 8 butterflies of a layer, and scatter them back.
+ A block covers 16 / (2t) consecutive roots of unity, each repeated t times.
+ */
+struct ntt_small_layer {
+    uint32_t t;
+    int64_t x_idx[NLANES];
+    int64_t y_idx[NLANES];
+    int64_t v0_idx[NLANES];
+    int64_t v1_idx[NLANES];
+    int64_t w_idx[NLANES];
+};
+
+static const struct ntt_small_layer ntt_small_layers[] = {
+    { 4, { 0, 1, 2, 3, 8, 9, 10, 11 }, { 4, 5, 6, 7, 12, 13, 14, 15 },
+         { 0, 1, 2, 3, 8, 9, 10, 11 }, { 4, 5, 6, 7, 12, 13, 14, 15 }, { 0, 0, 0, 0, 1, 1, 1, 1 } },
+    { 2, { 0, 1, 4, 5, 8, 9, 12, 13 }, { 2, 3, 6, 7, 10, 11, 14, 15 },
+         { 0, 1, 8, 9, 2, 3, 10, 11 }, { 4, 5, 12, 13, 6, 7, 14, 15 }, { 0, 0, 1, 1, 2, 2, 3, 3 } },
+    { 1, { 0, 2, 4, 6, 8, 10, 12, 14 }, { 1, 3, 5, 7, 9, 11, 13, 15 },
+         { 0, 8, 1, 9, 2, 10, 3, 11 }, { 4, 12, 5, 13, 6, 14, 7, 15 }, { 0, 1, 2, 3, 4, 5, 6, 7 } },
+};
+
+/// Loads the 16 / (2t) roots of unity starting at w and repeats each of them t times
+CCPOLYZP_PO2CYC_AVX512IFMA_TARGET
+static inline __m512i load_small_layer_roots(const struct ntt_small_layer *layer, const ccrns_int *w)
+{
+    __mmask8 mask = (__mmask8)((1u << (NLANES / layer->t)) - 1);
+    __m512i idx = _mm512_loadu_si512((const void *)layer->w_idx);
+    return _mm512_permutexvar_epi64(idx, _mm512_maskz_loadu_epi64(mask, w));
+}
+
+CCPOLYZP_PO2CYC_AVX512IFMA_TARGET
+void ccpolyzp_po2cyc_fwd_ntt_avx512ifma(uint32_t degree,
+                                        ccrns_int *x,
+                                        ccrns_int p,
+                                        const ccrns_int *rou_powers,
+                                        const ccrns_int *rou_powers_shoup52)
+{
+    cc_assert(degree >= 16 && p < CCPOLYZP_PO2CYC_NTT_AVX512IFMA_MAX_MODULUS);
+    const struct ntt_consts c = ntt_consts_init(p);
+
+    // Layers with t >= 8 use a single root of unity per vector
+    uint32_t m = 1, t = degree >> 1;
+    for (; t >= NLANES; m <<= 1, t >>= 1) {
+        for (uint32_t i = 0; i < m; ++i) {
+            __m512i w = _mm512_set1_epi64((long long)rou_powers[m + i]);
+            __m512i w_shoup = _mm512_set1_epi64((long long)rou_powers_shoup52[m + i]);
+            ccrns_int *x_butterfly = &x[2 * i * t];
+            ccrns_int *y_butterfly = x_butterfly + t;
+            for (uint32_t j = 0; j < t; j += NLANES) {
+                __m512i xv = _mm512_loadu_si512((const void *)&x_butterfly[j]);
+                __m512i yv = _mm512_loadu_si512((const void *)&y_butterfly[j]);
+                fwd_butterfly(&xv, &yv, w, w_shoup, &c);
+                _mm512_storeu_si512((void *)&x_butterfly[j], xv);
+                _mm512_storeu_si512((void *)&y_butterfly[j], yv);
+            }
+        }
+    }
+
+    // Layers with t = 4, 2, 1, followed by the final reduction from [0, 4p - 1] to [0, p - 1]
+    for (uint32_t block = 0; block < degree / (2 * NLANES); ++block) {
+        ccrns_int *xb = &x[2 * NLANES * block];
+        __m512i v0 = _mm512_loadu_si512((const void *)&xb[0]);
+        __m512i v1 = _mm512_loadu_si512((const void *)&xb[NLANES]);
+
+        for (size_t l = 0; l < CC_ARRAY_LEN(ntt_small_layers); ++l) {
+            const struct ntt_small_layer *layer = &ntt_small_layers[l];
+            // The first root of unity of the block, with m = N / (2t) roots in the layer
+            uint32_t rou_idx = degree / (2 * layer->t) + block * NLANES / layer->t;
+
+            __m512i w = load_small_layer_roots(layer, &rou_powers[rou_idx]);
+            __m512i w_shoup = load_small_layer_roots(layer, &rou_powers_shoup52[rou_idx]);
+            __m512i xv = _mm512_permutex2var_epi64(v0, _mm512_loadu_si512((const void *)layer->x_idx), v1);
+            __m512i yv = _mm512_permutex2var_epi64(v0, _mm512_loadu_si512((const void *)layer->y_idx), v1);
+            fwd_butterfly(&xv, &yv, w, w_shoup, &c);
+            v0 = _mm512_permutex2var_epi64(xv, _mm512_loadu_si512((const void *)layer->v0_idx), yv);
+            v1 = _mm512_permutex2var_epi64(xv, _mm512_loadu_si512((const void *)layer->v1_idx), yv);
+        }
+
+        v0 = cond_sub(cond_sub(v0, c.two_p), c.p);
+        v1 = cond_sub(cond_sub(v1, c.two_p), c.p);
+        _mm512_storeu_si512((void *)&xb[0], v0);
+        _mm512_storeu_si512((void *)&xb[NLANES], v1);
+    }
+}
+
+CCPOLYZP_PO2CYC_AVX512IFMA_TARGET
+void ccpolyzp_po2cyc_inv_ntt_avx512ifma(uint32_t degree,
+                                        ccrns_int *x,
+                                        ccrns_int p,
+                                        const ccrns_int *inv_rou_powers,
+                                        const ccrns_int *inv_rou_powers_shoup52,
+                                        ccrns_mul_modulus_const_t n_inv,
+                                        ccrns_mul_modulus_const_t n_inv_w_n2)
+{
+    cc_assert(degree >= 16 && p < CCPOLYZP_PO2CYC_NTT_AVX512IFMA_MAX_MODULUS);
+    const struct ntt_consts c = ntt_consts_init(p);
+
+    // Layers with t = 1, 2, 4. The inverse roots of unity are stored in the order they are used,
+    // starting at index 1, with m = N / (2t) roots per layer.
+    for (uint32_t block = 0; block < degree / (2 * NLANES); ++block) {
+        ccrns_int *xb = &x[2 * NLANES * block];
+        __m512i v0 = _mm512_loadu_si512((const void *)&xb[0]);
+        __m512i v1 = _mm512_loadu_si512((const void *)&xb[NLANES]);
+
+        uint32_t root_idx = 1;
+        for (size_t l = CC_ARRAY_LEN(ntt_small_layers); l > 0; --l) {
+            const struct ntt_small_layer *layer = &ntt_small_layers[l - 1];
+            uint32_t block_root_idx = root_idx + block * NLANES / layer->t;
+
+            __m512i w = load_small_layer_roots(layer, &inv_rou_powers[block_root_idx]);
+            __m512i w_shoup = load_small_layer_roots(layer, &inv_rou_powers_shoup52[block_root_idx]);
+            __m512i xv = _mm512_permutex2var_epi64(v0, _mm512_loadu_si512((const void *)layer->x_idx), v1);
+            __m512i yv = _mm512_permutex2var_epi64(v0, _mm512_loadu_si512((const void *)layer->y_idx), v1);
+            inv_butterfly(&xv, &yv, w, w_shoup, &c);
+            v0 = _mm512_permutex2var_epi64(xv, _mm512_loadu_si512((const void *)layer->v0_idx), yv);
+            v1 = _mm512_permutex2var_epi64(xv, _mm512_loadu_si512((const void *)layer->v1_idx), yv);
+
+            root_idx += degree / (2 * layer->t);
+        }
+
+        _mm512_storeu_si512((void *)&xb[0], v0);
+        _mm512_storeu_si512((void *)&xb[NLANES], v1);
+    }
+
+    // Layers with t >= 8 use a single inverse root of unity per vector
+    uint32_t root_idx = degree / 2 + degree / 4 + degree / 8 + 1;
+    for (uint32_t m = degree / (2 * NLANES), t = NLANES; m > 1; m >>= 1, t <<= 1) {
+        for (uint32_t i = 0; i < m; ++i, ++root_idx) {
+            __m512i w = _mm512_set1_epi64((long long)inv_rou_powers[root_idx]);
+            __m512i w_shoup = _mm512_set1_epi64((long long)inv_rou_powers_shoup52[root_idx]);
+            ccrns_int *x_butterfly = &x[2 * i * t];
+            ccrns_int *y_butterfly = x_butterfly + t;
+            for (uint32_t j = 0; j < t; j += NLANES) {
+                __m512i xv = _mm512_loadu_si512((const void *)&x_butterfly[j]);
+                __m512i yv = _mm512_loadu_si512((const void *)&y_butterfly[j]);
+                inv_butterfly(&xv, &yv, w, w_shoup, &c);
+                _mm512_storeu_si512((void *)&x_butterfly[j], xv);
+                _mm512_storeu_si512((void *)&y_butterfly[j], yv);
+            }
+        }
+    }
+
+    // Fuse multiplication by n^{-1} with the last layer:
+    // x_out <- n^{-1} (x_in + y_in) mod p, y_out <- n^{-1} * w (x_in - y_in) mod p
+    // floor(floor(w * 2^64 / p) / 2^12) = floor(w * 2^52 / p)
+    __m512i n_inv_w = _mm512_set1_epi64((long long)n_inv->multiplicand);
+    __m512i n_inv_shoup = _mm512_set1_epi64((long long)(n_inv->mod_factor >> 12));
+    __m512i n_inv_w_n2_w = _mm512_set1_epi64((long long)n_inv_w_n2->multiplicand);
+    __m512i n_inv_w_n2_shoup = _mm512_set1_epi64((long long)(n_inv_w_n2->mod_factor >> 12));
+    ccrns_int *y = &x[degree / 2];
+    for (uint32_t j = 0; j < degree / 2; j += NLANES) {
+        __m512i xv = _mm512_loadu_si512((const void *)&x[j]);
+        __m512i yv = _mm512_loadu_si512((const void *)&y[j]);
+        __m512i tx = cond_sub(_mm512_add_epi64(xv, yv), c.two_p);
+        __m512i ty = _mm512_sub_epi64(_mm512_add_epi64(xv, c.two_p), yv);
+        xv = cond_sub(mul_mod_lazy(tx, n_inv_w, n_inv_shoup, &c), c.p);
+        yv = cond_sub(mul_mod_lazy(ty, n_inv_w_n2_w, n_inv_w_n2_shoup, &c), c.p);
+        _mm512_storeu_si512((void *)&x[j], xv);
+        _mm512_storeu_si512((void *)&y[j], yv);
+    }
+}
+
+#endif // CCPOLYZP_PO2CYC_NTT_AVX512IFMA
@@ -93,4 +93,51 @@ int ccprime_rabin_miller(cc_size n, const cc_unit *p, size_t mr_depth, struct cc
 CC_NONNULL_ALL
 int ccprime_rabin_miller_ws(cc_ws_t ws, cc_size n, const cc_unit *p, size_t mr_depth, struct ccrng_state *rng);
 
+// Number of odd primes below 2^16.
+#define CCPRIME_SIEVE_NPRIMES 6541
+
+// An incremental sieve over prime candidates p, p+2, p+4, ...
+// storing the residues of the current candidate modulo all odd primes below 2^16.
+struct ccprime_sieve {
+    // Number of steps left before a new base candidate is needed.
+    size_t nsteps;
+    uint16_t residues[CCPRIME_SIEVE_NPRIMES];
+};
+
+#define ccprime_sieve_nof_n() ccn_nof_size(sizeof(struct ccprime_sieve))
+
+/*! @function ccprime_sieve_init
+ @abstract Initializes a sieve with base candidate p.
+
+ @discussion Computes the residues of p modulo all sieving primes, in constant time.
+
+ @param sieve   Sieve to initialize.
+ @param nsteps  Number of times ccprime_sieve_next() may step over a candidate.
+ @param n       Length of p in units.
+ @param p       Odd base candidate p.
+ */
+CC_NONNULL_ALL
+void ccprime_sieve_init(struct ccprime_sieve *sieve, size_t nsteps, cc_size n, const cc_unit *p);
+
+/*! @function ccprime_sieve_next
+ @abstract Advances p to the next candidate p+2k, k >= 1, without small prime factors.
+
+ @discussion Every step updates all residues and checks them in constant time.
+             Only whether a given step yields a candidate without small prime
+             factors -- i.e. the number of steps taken -- is revealed.
+
+             p must be larger than 2^16, as primes below that are sieved out
+             as well. The caller must check that p did not overflow n units
+             or its expected bit length.
+
+ @param sieve   Sieve, initialized with p.
+ @param n       Length of p in units.
+ @param p       Current candidate p, updated in place.
+
+ @return true if p was advanced to a candidate without small prime factors,
+         false if the sieve ran out of steps. p is unspecified in that case.
+ */
+CC_NONNULL_ALL CC_WARN_RESULT
+bool ccprime_sieve_next(struct ccprime_sieve *sieve, cc_size n, cc_unit *p);
+
 #endif // _CORECRYPTO_CCPRIME_INTERNAL_H_
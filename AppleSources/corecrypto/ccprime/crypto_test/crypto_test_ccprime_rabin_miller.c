@@ -301,14 +301,59 @@ static void test_ccprime_rabin_miller_vectors(void)
     }
 }
 
+// Whether p has an odd factor < 2^16, and thus an odd prime factor < 2^16.
+static bool test_ccprime_has_small_factor(cc_size n, const cc_unit *p)
+{
+    for (cc_unit q = 3; q < 0x10000; q += 2) {
+        if (ccn_divides1(n, p, q)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+#define TEST_SIEVE_NBASES 2
+#define TEST_SIEVE_NCANDIDATES 8
+
+static void test_ccprime_sieve(void)
+{
+    cc_size n = ccn_nof(512);
+    cc_unit p[n], q[n];
+    struct ccprime_sieve sieve;
+
+    for (size_t i = 0; i < TEST_SIEVE_NBASES; i++) {
+        is(ccn_random_bits(511, p, global_test_rng), CCERR_OK, "ccn_random_bits failed");
+        p[0] |= 1;
+        ccn_set(n, q, p);
+
+        ccprime_sieve_init(&sieve, SIZE_MAX, n, p);
+
+        // The sieve must land on the same candidates as trial division.
+        for (size_t j = 0; j < TEST_SIEVE_NCANDIDATES; j++) {
+            do {
+                (void)ccn_add1(n, q, q, 2);
+            } while (test_ccprime_has_small_factor(n, q));
+
+            is(ccprime_sieve_next(&sieve, n, p), true, "ccprime_sieve_next failed");
+            ok_ccn_cmp(n, p, q, "ccprime_sieve_next skipped a candidate");
+        }
+    }
+
+    // No steps left.
+    ccprime_sieve_init(&sieve, 0, n, p);
+    is(ccprime_sieve_next(&sieve, n, p), false, "ccprime_sieve_next should fail");
+}
+
 int ccprime_rabin_miller_tests(TM_UNUSED int argc, TM_UNUSED char *const *argv)
 {
-    plan_tests(14 + vectors_n * 2);
+    plan_tests(14 + vectors_n * 2 + TEST_SIEVE_NBASES * (1 + TEST_SIEVE_NCANDIDATES * 2) + 1);
 
     test_ccprime_rabin_miller_small();
     test_ccprime_rabin_miller_zero_rounds();
     test_ccprime_rabin_miller_known_primes();
     test_ccprime_rabin_miller_vectors();
+    test_ccprime_sieve();
 
     return 0;
 }
@@ -0,0 +1,72 @@
+/* Copyright (c) (2023) Apple Inc. All rights reserved.
+ *
+ * corecrypto is licensed under Apple Inc.’s Internal Use License Agreement (which
+ * is contained in the License.txt file distributed with corecrypto) and only to
+ * people who accept that license. IMPORTANT:  Any license rights granted to you by
+ * Apple Inc. (if any) are limited to internal use within your organization only on
+ * devices and computers you own or control, for the sole purpose of verifying the
+ * security characteristics and correct functioning of the Apple Software.  You may
+ * not, directly or indirectly, redistribute the Apple Software or any portions thereof.
+ */
+
+#include "ccprime_internal.h"
+#include "cc_workspaces.h"
+#include "ccprime_sieve_primes.inc"
+
+// Residues are computed 16 bits at a time.
+cc_static_assert(CCN_UNIT_BITS % 16 == 0, "cc_unit is processed in 16-bit chunks");
+
+// Returns r - q if r >= q, r otherwise. Requires r < 2q.
+CC_INLINE uint32_t ccprime_sieve_reduce(uint32_t r, uint32_t q)
+{
+    uint32_t t = r - q;
+    return t + (q & (0 - (t >> 31)));
+}
+
+void ccprime_sieve_init(struct ccprime_sieve *sieve, size_t nsteps, cc_size n, const cc_unit *p)
+{
+    for (size_t i = 0; i < CCPRIME_SIEVE_NPRIMES; i++) {
+        uint32_t q = ccprime_sieve_primes[i];
+
+        // Barrett reduction, q is public. With m = floor(2^32/q) and
+        // a = r*2^16 + 16 bits < 2^32, the estimated quotient is off by at most one.
+        uint32_t m = (uint32_t)((UINT64_C(1) << 32) / q);
+        uint32_t r = 0;
+
+        for (cc_size j = n; j > 0; j--) {
+            for (size_t k = CCN_UNIT_BITS; k > 0; k -= 16) {
+                uint32_t a = (r << 16) | (uint32_t)((p[j - 1] >> (k - 16)) & 0xffff);
+                uint32_t e = (uint32_t)(((uint64_t)a * m) >> 32);
+                r = ccprime_sieve_reduce(a - e * q, q);
+            }
+        }
+
+        sieve->residues[i] = (uint16_t)r;
+    }
+
+    sieve->nsteps = nsteps;
+}
+
+bool ccprime_sieve_next(struct ccprime_sieve *sieve, cc_size n, cc_unit *p)
+{
+    while (sieve->nsteps > 0) {
+        sieve->nsteps--;
+
+        // p += 2, cannot overflow for any p the caller accepts.
+        (void)ccn_add1(n, p, p, 2);
+
+        // Check all residues, to not leak which small prime divides p.
+        uint32_t has_factor = 0;
+        for (size_t i = 0; i < CCPRIME_SIEVE_NPRIMES; i++) {
+            uint32_t r = ccprime_sieve_reduce((uint32_t)sieve->residues[i] + 2, ccprime_sieve_primes[i]);
+            sieve->residues[i] = (uint16_t)r;
+            has_factor |= (r - 1) >> 31;
+        }
+
+        if (has_factor == 0) {
+            return true;
+        }
+    }
+
+    return false;
+}
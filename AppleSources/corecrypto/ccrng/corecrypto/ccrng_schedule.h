@@ -88,6 +88,19 @@ void ccrng_schedule_timer_init(ccrng_schedule_timer_ctx_t *ctx,
                                uint64_t (*get_time)(void),
                                uint64_t reseed_interval);
 
+// This is a concrete schedule implementation that returns "must
+// reseed" after a given number of reads, i.e. it bounds the number
+// of requests an RNG serves between two reseeds. The read count is
+// atomic, so the schedule does not rely on the RNG's lock.
+typedef struct ccrng_schedule_counter_ctx {
+    ccrng_schedule_ctx_t schedule_ctx;
+    uint64_t reseed_interval;
+    _Atomic uint64_t nreads;
+} ccrng_schedule_counter_ctx_t;
+
+void ccrng_schedule_counter_init(ccrng_schedule_counter_ctx_t *ctx,
+                                 uint64_t reseed_interval);
+
 // This is a concrete schedule implementation that combines the
 // results of two constituent sub-schedules. Specifically, it returns
 // the more "urgent" recommendation between the two.
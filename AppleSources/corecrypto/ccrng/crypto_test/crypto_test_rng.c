@@ -230,7 +230,7 @@ int ccrng_tests(TM_UNUSED int argc, TM_UNUSED char *const *argv)
     int status;
 
     plan_tests(266116 +
-               28 +             // ccrng_schedule
+               34 +             // ccrng_schedule
 #if CC_GETENTROPY_SUPPORTED
                284 +            // ccrng_getentropy
 #endif
@@ -89,6 +89,37 @@ schedule_timer_test(void)
     is(action, CCRNG_SCHEDULE_MUST_RESEED, "ccrng_schedule_timer (greater than interval time)");
 }
 
+static void
+schedule_counter_test(void)
+{
+    ccrng_schedule_counter_ctx_t ctx;
+    ccrng_schedule_action_t action;
+
+    // Initialize the schedule with a reseed interval of 2
+    ccrng_schedule_counter_init(&ctx, 2);
+
+    // The first two reads are served without a reseed
+    action = ccrng_schedule_read(&ctx.schedule_ctx);
+    is(action, CCRNG_SCHEDULE_CONTINUE, "ccrng_schedule_counter (first read)");
+    action = ccrng_schedule_read(&ctx.schedule_ctx);
+    is(action, CCRNG_SCHEDULE_CONTINUE, "ccrng_schedule_counter (second read)");
+
+    // The next one requires a reseed
+    action = ccrng_schedule_read(&ctx.schedule_ctx);
+    is(action, CCRNG_SCHEDULE_MUST_RESEED, "ccrng_schedule_counter (interval reads)");
+
+    // Simulate reseed
+    ccrng_schedule_notify_reseed(&ctx.schedule_ctx);
+
+    // The count starts over
+    action = ccrng_schedule_read(&ctx.schedule_ctx);
+    is(action, CCRNG_SCHEDULE_CONTINUE, "ccrng_schedule_counter (first read again)");
+    action = ccrng_schedule_read(&ctx.schedule_ctx);
+    is(action, CCRNG_SCHEDULE_CONTINUE, "ccrng_schedule_counter (second read again)");
+    action = ccrng_schedule_read(&ctx.schedule_ctx);
+    is(action, CCRNG_SCHEDULE_MUST_RESEED, "ccrng_schedule_counter (interval reads again)");
+}
+
 typedef struct {
     ccrng_schedule_ctx_t schedule_ctx;
     uint64_t nreseeds;
@@ -317,6 +348,8 @@ schedule_test(void)
 
     schedule_timer_test();
 
+    schedule_counter_test();
+
     schedule_tree_test();
 
     schedule_drbg_test();
@@ -141,6 +141,44 @@ void ccrng_schedule_timer_init(ccrng_schedule_timer_ctx_t *ctx,
     ctx->last_reseed_time = get_time();
 }
 
+static ccrng_schedule_action_t
+ccrng_schedule_counter_read(ccrng_schedule_ctx_t *schedule_ctx)
+{
+    ccrng_schedule_counter_ctx_t *ctx = (ccrng_schedule_counter_ctx_t *)schedule_ctx;
+    uint64_t nreads = atomic_load_explicit(&ctx->nreads, memory_order_relaxed);
+
+    // Count the read only if it is served without a reseed.
+    do {
+        if (nreads >= ctx->reseed_interval) {
+            return CCRNG_SCHEDULE_MUST_RESEED;
+        }
+    } while (!atomic_compare_exchange_weak_explicit(&ctx->nreads, &nreads, nreads + 1,
+                                                    memory_order_relaxed, memory_order_relaxed));
+
+    return CCRNG_SCHEDULE_CONTINUE;
+}
+
+static void
+ccrng_schedule_counter_notify_reseed(ccrng_schedule_ctx_t *schedule_ctx)
+{
+    ccrng_schedule_counter_ctx_t *ctx = (ccrng_schedule_counter_ctx_t *)schedule_ctx;
+    atomic_store_explicit(&ctx->nreads, 0, memory_order_relaxed);
+}
+
+static const ccrng_schedule_info_t
+ccrng_schedule_counter_info = {
+    .read = ccrng_schedule_counter_read,
+    .notify_reseed = ccrng_schedule_counter_notify_reseed,
+};
+
+void ccrng_schedule_counter_init(ccrng_schedule_counter_ctx_t *ctx,
+                                 uint64_t reseed_interval)
+{
+    ccrng_schedule_init(&ccrng_schedule_counter_info, &ctx->schedule_ctx);
+    ctx->reseed_interval = reseed_interval;
+    atomic_store_explicit(&ctx->nreads, 0, memory_order_relaxed);
+}
+
 static ccrng_schedule_action_t
 ccrng_schedule_tree_read(ccrng_schedule_ctx_t *schedule_ctx)
 {
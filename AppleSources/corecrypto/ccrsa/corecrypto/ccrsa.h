@@ -13,6 +13,7 @@
 #define _CORECRYPTO_CCRSA_H_
 
 #include <corecrypto/cc.h>
+#include <corecrypto/cc_executor.h>
 #include <corecrypto/ccdigest.h>
 #include <corecrypto/ccrng.h>
 #include <corecrypto/cczp.h>
@@ -259,6 +260,29 @@ CC_NONNULL_ALL
 int ccrsa_generate_key(size_t nbits, ccrsa_full_ctx_t fk,
                        size_t e_nbytes, const void *cc_sized_by(e_nbytes) e_bytes, struct ccrng_state *rng) CC_WARN_RESULT;
 
+/*!
+@function   ccrsa_generate_key_executor
+@abstract   Generate a nbit RSA key pair, searching for p and q concurrently.
+
+@param      executor   Executor running the prime search workers.
+@param      nworkers   Number of prime search workers, at least 1.
+@param      nbits      Bit size requested for the key
+@param      fk         Allocated context where the generated key will be stored
+@param      e_nbytes   Byte size of the input public exponent
+@param      e_bytes    Input public exponent in big endian. Recommend value is {0x01, 0x00, 0x01}
+@param      rng        Random Number generator used.
+@result     CCERR_OK if no error
+
+@discussion
+    Same as ccrsa_generate_key(). Workers start on either p or q and move on to
+    the other prime once a worker found the first one. rng is shared by all
+    workers and must be safe to use from multiple threads.
+*/
+CC_NONNULL_ALL
+int ccrsa_generate_key_executor(const struct cc_executor *executor, size_t nworkers,
+                                size_t nbits, ccrsa_full_ctx_t fk,
+                                size_t e_nbytes, const void *cc_sized_by(e_nbytes) e_bytes, struct ccrng_state *rng) CC_WARN_RESULT;
+
 /*!
 @function   ccrsa_generate_key_deterministic
 @abstract   Generate a deterministic nbit RSA key pair.
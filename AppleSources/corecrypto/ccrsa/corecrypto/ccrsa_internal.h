@@ -62,6 +62,35 @@ int ccrsa_generate_key_internal_ws(cc_ws_t ws,
                                    struct ccrng_state *rng,
                                    struct ccrng_state *rng_mr);
 
+/*!
+@function   ccrsa_generate_key_legacy_ws
+@abstract   Same as ccrsa_generate_key_internal_ws(), with primes generated by
+            ccrsa_generate_prime_legacy_ws().
+*/
+CC_NONNULL_ALL CC_WARN_RESULT
+int ccrsa_generate_key_legacy_ws(cc_ws_t ws,
+                                 size_t nbits,
+                                 ccrsa_full_ctx_t fk,
+                                 size_t e_nbytes,
+                                 const uint8_t *e,
+                                 struct ccrng_state *rng,
+                                 struct ccrng_state *rng_mr);
+
+/*!
+@function   ccrsa_generate_key_executor_internal
+@abstract   Same as ccrsa_generate_key_internal(), searching for p and q with
+            nworkers workers run by executor. See ccrsa_generate_primes_executor().
+*/
+CC_NONNULL_ALL CC_WARN_RESULT
+int ccrsa_generate_key_executor_internal(const struct cc_executor *executor,
+                                         size_t nworkers,
+                                         size_t nbits,
+                                         ccrsa_full_ctx_t fk,
+                                         size_t e_nbytes,
+                                         const uint8_t *e,
+                                         struct ccrng_state *rng,
+                                         struct ccrng_state *rng_mr);
+
 /*!
 @function   ccrsa_verify_pkcs1v15_internal
 @abstract   Perform RSA PKCS1v15 verification.
@@ -289,7 +318,7 @@ int ccrsa_sign_pss_blinded(
            solely for MR primality testing. The public exponent e MUST
            be >= 3 and odd.
 
- @param ws       Workspace.
+ @param ws       Workspace of size CCRSA_GENERATE_PRIME_SIEVE_WORKSPACE_N(ccn_nof(nbits)).
  @param nbits    Size of generated prime p in bits.
  @param p        Generated prime p, where gcd(p-1, e) = 1.
  @param e        Public exponent e. (MUST be >= 3 and odd)
@@ -306,6 +335,78 @@ int ccrsa_generate_prime_ws(cc_ws_t ws,
                             struct ccrng_state *rng,
                             struct ccrng_state *rng_mr);
 
+/*! @function ccrsa_generate_prime_legacy_ws
+ @abstract Same as ccrsa_generate_prime_ws(), but draws every prime candidate
+           independently from rng. Used for deterministic key generation, where
+           the generated primes must not change for a given rng output.
+ */
+CC_NONNULL_ALL CC_WARN_RESULT
+int ccrsa_generate_prime_legacy_ws(cc_ws_t ws,
+                                   cc_size nbits,
+                                   cc_unit *p,
+                                   const cc_unit *e,
+                                   struct ccrng_state *rng,
+                                   struct ccrng_state *rng_mr);
+
+struct ccprime_sieve;
+
+/*! @function ccrsa_generate_prime_candidate_ws
+ @abstract Moves on to the next random nbits-sized prime candidate p and checks
+           whether it is a valid RSA prime, see ccrsa_generate_prime_ws().
+
+ @discussion Candidates are stepped through with an incremental sieve, so that
+             only candidates without small prime factors reach the primality
+             test. A new random base is drawn whenever the sieve runs out of
+             steps. p and sieve hold the search state between calls, set
+             sieve->nsteps = 0 before the first call for a given nbits.
+
+ @param ws       Workspace of size CCRSA_IS_VALID_PRIME_WORKSPACE_N(ccn_nof(nbits)).
+ @param nbits    Size of prime candidate p in bits.
+ @param p        Prime candidate p.
+ @param sieve    Sieve state for p.
+ @param e        Public exponent e. (MUST be >= 3 and odd)
+ @param rng      RNG for generation of prime candidate p.
+ @param rng_mr   RNG for Miller-Rabin primality testing.
+
+ @return 1 if p is valid RSA prime, 0 if it is not. A negative error code otherwise.
+ */
+CC_NONNULL_ALL CC_WARN_RESULT
+int ccrsa_generate_prime_candidate_ws(cc_ws_t ws,
+                                      cc_size nbits,
+                                      cc_unit *p,
+                                      struct ccprime_sieve *sieve,
+                                      const cc_unit *e,
+                                      struct ccrng_state *rng,
+                                      struct ccrng_state *rng_mr);
+
+/*! @function ccrsa_generate_primes_executor
+ @abstract Generates random primes p and q as ccrsa_generate_prime_ws() does,
+           with nworkers workers searching concurrently. Each worker allocates
+           its own workspace and stops as soon as both primes have been found.
+
+ @param executor Executor running the workers.
+ @param nworkers Number of workers, at least 1.
+ @param pbits    Size of generated prime p in bits.
+ @param p        Generated prime p, where gcd(p-1, e) = 1.
+ @param qbits    Size of generated prime q in bits.
+ @param q        Generated prime q, where gcd(q-1, e) = 1.
+ @param e        Public exponent e. (MUST be >= 3 and odd)
+ @param rng      RNG for generation of primes, shared by all workers.
+ @param rng_mr   RNG for Miller-Rabin primality testing, shared by all workers.
+
+ @return   CCERR_OK on success, non-zero on failure. See cc_error.h for details.
+ */
+CC_NONNULL_ALL CC_WARN_RESULT
+int ccrsa_generate_primes_executor(const struct cc_executor *executor,
+                                   size_t nworkers,
+                                   cc_size pbits,
+                                   cc_unit *p,
+                                   cc_size qbits,
+                                   cc_unit *q,
+                                   const cc_unit *e,
+                                   struct ccrng_state *rng,
+                                   struct ccrng_state *rng_mr);
+
 /*! @function ccrsa_is_valid_prime_ws
  @abstract Checks whether a given prime candidate is a valid RSA prime.
 
@@ -433,6 +534,23 @@ int ccrsa_priv_crypt_blinded_ws(cc_ws_t ws,
                                 cc_unit *cc_unsafe_indexable out,
                                 const cc_unit *cc_unsafe_indexable in);
 
+/*!
+ @function   ccrsa_priv_crypt_blinded_executor_ws
+ @abstract   Same as ccrsa_priv_crypt_blinded_ws(), with an optional executor.
+
+ @discussion ws must have CCRSA_PRIV_CRYPT_BLINDED_EXECUTOR_WORKSPACE_N(ccrsa_ctx_n(key))
+             units. When executor is not NULL, the exponentiations mod p and
+             mod q run as two concurrent work items. Each of them allocates its
+             own workspace of CCRSA_CRT_POWER_HALF_WORKSPACE_N(ccrsa_ctx_n(key)) units.
+ */
+CC_NONNULL((1, 3, 4, 5, 6)) CC_WARN_RESULT
+int ccrsa_priv_crypt_blinded_executor_ws(cc_ws_t ws,
+                                         const struct cc_executor *executor,
+                                         struct ccrng_state *blinding_rng,
+                                         ccrsa_full_ctx_t key,
+                                         cc_unit *cc_unsafe_indexable out,
+                                         const cc_unit *cc_unsafe_indexable in);
+
 CC_NONNULL_ALL CC_WARN_RESULT
 int ccrsa_pub_crypt_ws(cc_ws_t ws, ccrsa_pub_ctx_t ctx, cc_unit *r, const cc_unit *s);
 
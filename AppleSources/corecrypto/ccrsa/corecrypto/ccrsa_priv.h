@@ -331,6 +331,21 @@ int ccrsa_decrypt_oaep(ccrsa_full_ctx_t key,
 CC_NONNULL((1, 2, 3))
 int ccrsa_priv_crypt(ccrsa_full_ctx_t key, cc_unit *cc_unsafe_indexable out, const cc_unit *cc_unsafe_indexable in);
 
+/*!
+ @function   ccrsa_priv_crypt_executor
+ @abstract   Perform RSA operation with a private key, computing both CRT halves concurrently
+
+ @param      executor   Executor running the two exponentiations mod p and mod q.
+ @param      key        A handle an RSA private key.
+ @param      out        Output buffer, of size ccrsa_ctx_n(key).
+ @param      in         Input buffer, of size ccrsa_ctx_n(key).
+
+ @return     0 on success, non-zero on failure. See cc_error.h for more details.
+ */
+CC_NONNULL((1, 2, 3, 4))
+int ccrsa_priv_crypt_executor(const struct cc_executor *executor, ccrsa_full_ctx_t key,
+                              cc_unit *cc_unsafe_indexable out, const cc_unit *cc_unsafe_indexable in);
+
 cc_size ccrsa_n_from_size(size_t size);
 
 size_t ccrsa_sizeof_n_from_size(size_t size);
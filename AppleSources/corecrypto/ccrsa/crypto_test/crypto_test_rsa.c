@@ -27,6 +27,7 @@ entryPoint(ccrsa_tests,"ccrsa")
 #include "crypto_test_rsa.h"
 #include "crypto_test_rsapss.h"
 #include "crypto_test_rsapkcs1v15.h"
+#include "cctest_executor.h"
 
 #define RSA_KNOWN_KEY_STRESS 10
 
@@ -2353,6 +2354,37 @@ static void test_generate_prime(void)
 #endif
 }
 
+static void test_rsa_executor(void)
+{
+#if !CC_DISABLE_RSAKEYGEN
+    const uint8_t e[] = { 0x1, 0x00, 0x01 };
+    size_t key_nbits = 2048;
+
+    // The prime search workers share the rng, use the thread-safe one.
+    struct ccrng_state *rng = ccrng(NULL);
+
+    ccrsa_full_ctx_decl_nbits(key_nbits, fk);
+    cc_size n = ccn_nof(key_nbits);
+    cc_unit in[n], out[n], expected[n];
+
+    is(ccrsa_generate_key_executor(&cctest_executor, 0, key_nbits, fk, sizeof(e), e, rng),
+       CCERR_PARAMETER, "ccrsa_generate_key_executor needs a worker");
+    is(ccrsa_generate_key_executor(&cctest_executor, 1, key_nbits, fk, sizeof(e), e, rng),
+       CCERR_OK, "ccrsa_generate_key_executor with one worker");
+    is(ccrsa_generate_key_executor(&cctest_executor, 4, key_nbits, fk, sizeof(e), e, rng),
+       CCERR_OK, "ccrsa_generate_key_executor with four workers");
+
+    for (size_t i = 0; i < 4; i++) {
+        is(ccn_random_bits(key_nbits - 1, in, rng), CCERR_OK, "ccn_random_bits");
+        is(ccrsa_priv_crypt(fk, expected, in), CCERR_OK, "ccrsa_priv_crypt");
+        is(ccrsa_priv_crypt_executor(&cctest_executor, fk, out, in), CCERR_OK, "ccrsa_priv_crypt_executor");
+        ok_ccn_cmp(n, out, expected, "ccrsa_priv_crypt_executor matches ccrsa_priv_crypt");
+    }
+
+    ccrsa_full_ctx_clear_nbits(key_nbits, fk);
+#endif
+}
+
 static int test_emsa_pkcs1v15_encode_invalid_args(size_t emlen, size_t dgstlen, const uint8_t *oid)
 {
     uint8_t em[emlen];
@@ -2409,7 +2441,7 @@ int ccrsa_tests(TM_UNUSED int argc, TM_UNUSED char *const *argv)
     int fipsmake_kat = 1;
 #endif
 
-    plan_tests(90771);
+    plan_tests(90790);
 
     if(verbose) diag("Import DER keys");
     ok(test_import_der_pub_key(), "Import RSA DER public key");
@@ -2460,6 +2492,9 @@ int ccrsa_tests(TM_UNUSED int argc, TM_UNUSED char *const *argv)
     if(verbose) diag("Test ccrsa_generate_prime\n");
     test_generate_prime();
 
+    if(verbose) diag("Test ccrsa executor\n");
+    test_rsa_executor();
+
     if(stdgen) {
 #if CORECRYPTO_HACK_FOR_WINDOWS_DEVELOPMENT
         diag("*skipping tests on Windows");
@@ -19,3 +19,12 @@ int ccrsa_generate_key(size_t nbits, ccrsa_full_ctx_t fk, size_t e_nbytes,
 
     return ccrsa_generate_key_internal(nbits, fk, e_nbytes, e_bytes, rng, rng);
 }
+
+int ccrsa_generate_key_executor(const struct cc_executor *executor, size_t nworkers,
+                                size_t nbits, ccrsa_full_ctx_t fk, size_t e_nbytes,
+                                const void *e_bytes, struct ccrng_state *rng)
+{
+    CC_ENSURE_DIT_ENABLED
+
+    return ccrsa_generate_key_executor_internal(executor, nworkers, nbits, fk, e_nbytes, e_bytes, rng, rng);
+}
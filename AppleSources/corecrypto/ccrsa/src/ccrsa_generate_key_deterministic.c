@@ -69,7 +69,7 @@ int ccrsa_generate_key_deterministic(size_t nbits,
     cc_require(rv == CCERR_OK, errOut);
 
     struct ccrng_state *det_rng = (struct ccrng_state *)&drbg_ctx;
-    rv = ccrsa_generate_key_internal_ws(ws, nbits, fk, e_nbytes, e, det_rng, rng);
+    rv = ccrsa_generate_key_legacy_ws(ws, nbits, fk, e_nbytes, e, det_rng, rng);
     cc_require(rv == CCERR_OK, errOut);
 
     ccdrbg_done(&info, drbg_state);
@@ -12,16 +12,34 @@
 #include "ccrsa_internal.h"
 #include "cc_macros.h"
 
-int ccrsa_generate_key_internal_ws(cc_ws_t ws,
-                                   size_t nbits,
-                                   ccrsa_full_ctx_t fk,
-                                   size_t e_nbytes,
-                                   const uint8_t *e,
-                                   struct ccrng_state *rng,
-                                   struct ccrng_state *rng_mr)
+CC_PURE cc_size CCRSA_GENERATE_KEY_EXECUTOR_WORKSPACE_N(cc_size n)
+{
+    return CC_MAX_EVAL(CCRSA_PAIRWISE_CONSISTENCY_CHECK_WORKSPACE_N(n), CCRSA_GENERATE_PRIME_SIEVE_WORKSPACE_N(n));
+}
+
+typedef int (*ccrsa_generate_prime_ws_t)(cc_ws_t ws,
+                                         cc_size nbits,
+                                         cc_unit *p,
+                                         const cc_unit *e,
+                                         struct ccrng_state *rng,
+                                         struct ccrng_state *rng_mr);
+
+// Primes are generated by generate_prime_ws, or by nworkers workers run by
+// executor if one is given.
+static int ccrsa_generate_key_executor_ws(cc_ws_t ws,
+                                          ccrsa_generate_prime_ws_t generate_prime_ws,
+                                          const struct cc_executor *executor,
+                                          size_t nworkers,
+                                          size_t nbits,
+                                          ccrsa_full_ctx_t fk,
+                                          size_t e_nbytes,
+                                          const uint8_t *e,
+                                          struct ccrng_state *rng,
+                                          struct ccrng_state *rng_mr)
 {
 #if CC_DISABLE_RSAKEYGEN
-    (void)ws;
+    (void)ws;       (void)generate_prime_ws;
+    (void)executor; (void)nworkers;
     (void)nbits;    (void)fk;
     (void)e_nbytes; (void)e;
     (void)rng;      (void)rng_mr;
@@ -63,15 +81,23 @@ int ccrsa_generate_key_internal_ws(cc_ws_t ws,
     cczp_t zq = ccrsa_ctx_private_zq(fk);
 
     /* Generate random n bit primes p and q. */
-    rv = ccrsa_generate_prime_ws(ws, pbits, CCZP_PRIME(zp), ccrsa_ctx_e(pubk), rng, rng_mr);
-    cc_require(rv == CCERR_OK, errOut);
+    if (executor) {
+        rv = ccrsa_generate_primes_executor(executor, nworkers,
+                                            pbits, CCZP_PRIME(zp),
+                                            qbits, CCZP_PRIME(zq),
+                                            ccrsa_ctx_e(pubk), rng, rng_mr);
+        cc_require(rv == CCERR_OK, errOut);
+    } else {
+        rv = generate_prime_ws(ws, pbits, CCZP_PRIME(zp), ccrsa_ctx_e(pubk), rng, rng_mr);
+        cc_require(rv == CCERR_OK, errOut);
+
+        rv = generate_prime_ws(ws, qbits, CCZP_PRIME(zq), ccrsa_ctx_e(pubk), rng, rng_mr);
+        cc_require(rv == CCERR_OK, errOut);
+    }
 
     rv = cczp_init_ws(ws, zp);
     cc_require(rv == CCERR_OK, errOut);
 
-    rv = ccrsa_generate_prime_ws(ws, qbits, CCZP_PRIME(zq), ccrsa_ctx_e(pubk), rng, rng_mr);
-    cc_require(rv == CCERR_OK, errOut);
-
     rv = cczp_init_ws(ws, zq);
     cc_require(rv == CCERR_OK, errOut);
 
@@ -90,14 +116,52 @@ errOut:
 #endif
 }
 
+int ccrsa_generate_key_internal_ws(cc_ws_t ws,
+                                   size_t nbits,
+                                   ccrsa_full_ctx_t fk,
+                                   size_t e_nbytes,
+                                   const uint8_t *e,
+                                   struct ccrng_state *rng,
+                                   struct ccrng_state *rng_mr)
+{
+    return ccrsa_generate_key_executor_ws(ws, ccrsa_generate_prime_ws, NULL, 1, nbits, fk, e_nbytes, e, rng, rng_mr);
+}
+
+int ccrsa_generate_key_legacy_ws(cc_ws_t ws,
+                                 size_t nbits,
+                                 ccrsa_full_ctx_t fk,
+                                 size_t e_nbytes,
+                                 const uint8_t *e,
+                                 struct ccrng_state *rng,
+                                 struct ccrng_state *rng_mr)
+{
+    return ccrsa_generate_key_executor_ws(ws, ccrsa_generate_prime_legacy_ws, NULL, 1, nbits, fk, e_nbytes, e, rng, rng_mr);
+}
+
 int ccrsa_generate_key_internal(size_t nbits, ccrsa_full_ctx_t fk,
                                 size_t e_nbytes, const uint8_t *e,
                                 struct ccrng_state *rng,
                                 struct ccrng_state *rng_mr)
 {
     cc_size n = ccn_nof(nbits);
-    CC_DECL_WORKSPACE_OR_FAIL(ws, CCRSA_GENERATE_KEY_INTERNAL_WORKSPACE_N(n));
+    CC_DECL_WORKSPACE_OR_FAIL(ws, CCRSA_GENERATE_KEY_EXECUTOR_WORKSPACE_N(n));
     int rv = ccrsa_generate_key_internal_ws(ws, nbits, fk, e_nbytes, e, rng, rng_mr);
     CC_FREE_WORKSPACE(ws);
     return rv;
 }
+
+int ccrsa_generate_key_executor_internal(const struct cc_executor *executor,
+                                         size_t nworkers,
+                                         size_t nbits,
+                                         ccrsa_full_ctx_t fk,
+                                         size_t e_nbytes,
+                                         const uint8_t *e,
+                                         struct ccrng_state *rng,
+                                         struct ccrng_state *rng_mr)
+{
+    cc_size n = ccn_nof(nbits);
+    CC_DECL_WORKSPACE_OR_FAIL(ws, CCRSA_GENERATE_KEY_EXECUTOR_WORKSPACE_N(n));
+    int rv = ccrsa_generate_key_executor_ws(ws, ccrsa_generate_prime_ws, executor, nworkers, nbits, fk, e_nbytes, e, rng, rng_mr);
+    CC_FREE_WORKSPACE(ws);
+    return rv;
+}
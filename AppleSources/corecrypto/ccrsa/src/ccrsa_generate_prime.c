@@ -10,7 +10,73 @@
  */
 
 #include "ccrsa_internal.h"
+#include "ccprime_internal.h"
 #include <corecrypto/ccrng.h>
+#include <stdatomic.h>
+
+// Odd candidates p, p+2, ... looked at before drawing a new random base.
+#define CCRSA_GENERATE_PRIME_SIEVE_NSTEPS 1024
+
+// Candidates need to be larger than all small primes used for sieving.
+#define CCRSA_GENERATE_PRIME_SIEVE_MIN_NBITS 17
+
+CC_PURE cc_size CCRSA_GENERATE_PRIME_SIEVE_WORKSPACE_N(cc_size n)
+{
+    return ccprime_sieve_nof_n() + CCRSA_IS_VALID_PRIME_WORKSPACE_N(n);
+}
+
+// Draw a random candidate with the two top bits and the low bit set.
+static int ccrsa_generate_prime_random_base(cc_size nbits, cc_unit *p, struct ccrng_state *rng)
+{
+    /* Generate nbit wide random ccn. */
+    int rv = ccn_random_bits(nbits, p, rng);
+    if (rv) {
+        return rv;
+    }
+
+    ccn_set_bit(p, nbits - 1, 1); /* Set high bit. */
+    ccn_set_bit(p, nbits - 2, 1); /* Set second highest bit per X9.31. */
+    ccn_set_bit(p, 0, 1);         /* Set low bit. */
+
+    return CCERR_OK;
+}
+
+int ccrsa_generate_prime_candidate_ws(cc_ws_t ws,
+                                      cc_size nbits,
+                                      cc_unit *p,
+                                      struct ccprime_sieve *sieve,
+                                      const cc_unit *e,
+                                      struct ccrng_state *rng,
+                                      struct ccrng_state *rng_mr)
+{
+    cc_size n = ccn_nof(nbits);
+    int rv;
+
+    if (nbits < CCRSA_GENERATE_PRIME_SIEVE_MIN_NBITS) {
+        rv = ccrsa_generate_prime_random_base(nbits, p, rng);
+        if (rv) {
+            return rv;
+        }
+    } else {
+        // Step to the next candidate without small prime factors. Start over
+        // from a new random base once the sieve ran out of steps or p grew
+        // beyond nbits.
+        while (!ccprime_sieve_next(sieve, n, p) || ccn_bitlen(n, p) != nbits) {
+            rv = ccrsa_generate_prime_random_base(nbits, p, rng);
+            if (rv) {
+                return rv;
+            }
+
+            // Sieve from p-2, the first step brings us back to p.
+            (void)ccn_sub1(n, p, p, 2);
+            ccprime_sieve_init(sieve, CCRSA_GENERATE_PRIME_SIEVE_NSTEPS, n, p);
+        }
+    }
+
+    /* Check that p is a prime and gcd(p-1,e) == 1. */
+    size_t mr_depth = ccrsa_num_mr_iterations(nbits);
+    return ccrsa_is_valid_prime_ws(ws, n, p, ccn_n(n, e), e, mr_depth, rng_mr);
+}
 
 int ccrsa_generate_prime_ws(cc_ws_t ws,
                             cc_size nbits,
@@ -28,21 +94,51 @@ int ccrsa_generate_prime_ws(cc_ws_t ws,
     // Public exponent must be >= 3 and odd.
     cc_assert(ccn_bitlen(n, e) > 1 && (e[0] & 1) == 1);
 
+    int rv;
+    CC_DECL_BP_WS(ws, bp);
+
+    struct ccprime_sieve *sieve = (struct ccprime_sieve *)CC_ALLOC_WS(ws, ccprime_sieve_nof_n());
+    sieve->nsteps = 0;
+
+    do {
+        rv = ccrsa_generate_prime_candidate_ws(ws, nbits, p, sieve, e, rng, rng_mr);
+    } while (rv == 0);
+
+    /* We found a prime. */
+    if (rv == 1) {
+        rv = CCERR_OK;
+    }
+
+    CC_FREE_BP_WS(ws, bp);
+    return rv;
+}
+
+int ccrsa_generate_prime_legacy_ws(cc_ws_t ws,
+                                   cc_size nbits,
+                                   cc_unit *p,
+                                   const cc_unit *e,
+                                   struct ccrng_state *rng,
+                                   struct ccrng_state *rng_mr)
+{
+    cc_size n = ccn_nof(nbits);
+
+    if (n == 0) {
+        return CCERR_PARAMETER;
+    }
+
+    // Public exponent must be >= 3 and odd.
+    cc_assert(ccn_bitlen(n, e) > 1 && (e[0] & 1) == 1);
+
     int rv = CCERR_OK;
     cc_size ne = ccn_n(n, e);
     CC_DECL_BP_WS(ws, bp);
 
     while (1) {
-        /* Generate nbit wide random ccn. */
-        rv = ccn_random_bits(nbits, p, rng);
+        rv = ccrsa_generate_prime_random_base(nbits, p, rng);
         if (rv) {
             break;
         }
 
-        ccn_set_bit(p, nbits - 1, 1); /* Set high bit. */
-        ccn_set_bit(p, nbits - 2, 1); /* Set second highest bit per X9.31. */
-        ccn_set_bit(p, 0, 1);         /* Set low bit. */
-
         /* Check that p is a prime and gcd(p-1,e) == 1. */
         size_t mr_depth = ccrsa_num_mr_iterations(nbits);
         rv = ccrsa_is_valid_prime_ws(ws, n, p, ne, e, mr_depth, rng_mr);
@@ -62,3 +158,92 @@ int ccrsa_generate_prime_ws(cc_ws_t ws,
     CC_FREE_BP_WS(ws, bp);
     return rv;
 }
+
+struct ccrsa_generate_primes_ctx {
+    struct {
+        cc_size nbits;
+        cc_unit *p;
+        // 0 while searching, 1 once p was found, a negative error code otherwise.
+        atomic_int state;
+    } primes[2];
+    const cc_unit *e;
+    struct ccrng_state *rng;
+    struct ccrng_state *rng_mr;
+};
+
+static void ccrsa_generate_primes_work(void *work_ctx, size_t i)
+{
+    struct ccrsa_generate_primes_ctx *ctx = work_ctx;
+    cc_size n = CC_MAX_EVAL(ccn_nof(ctx->primes[0].nbits), ccn_nof(ctx->primes[1].nbits));
+
+    int rv;
+    CC_DECL_WORKSPACE_RV(ws, n + CCRSA_GENERATE_PRIME_SIEVE_WORKSPACE_N(n), rv);
+    if (rv) {
+        // Let the caller know, another worker might not be there to pick up the search.
+        for (size_t k = 0; k < 2; k++) {
+            int expected = 0;
+            atomic_compare_exchange_strong(&ctx->primes[k].state, &expected, rv);
+        }
+        return;
+    }
+
+    cc_unit *p = CC_ALLOC_WS(ws, n);
+    struct ccprime_sieve *sieve = (struct ccprime_sieve *)CC_ALLOC_WS(ws, ccprime_sieve_nof_n());
+
+    // Start with one of the two primes, help with the other one once it's done.
+    for (size_t k = 0; k < 2; k++) {
+        size_t j = (i + k) & 1;
+        sieve->nsteps = 0;
+
+        while (atomic_load(&ctx->primes[j].state) == 0) {
+            rv = ccrsa_generate_prime_candidate_ws(ws, ctx->primes[j].nbits, p, sieve, ctx->e, ctx->rng, ctx->rng_mr);
+            if (rv == 0) {
+                continue;
+            }
+
+            // The first worker to find a prime, or to fail, stops the others.
+            int expected = 0;
+            if (atomic_compare_exchange_strong(&ctx->primes[j].state, &expected, rv) && rv == 1) {
+                ccn_set(ccn_nof(ctx->primes[j].nbits), ctx->primes[j].p, p);
+            }
+        }
+    }
+
+    CC_FREE_WORKSPACE(ws);
+}
+
+int ccrsa_generate_primes_executor(const struct cc_executor *executor,
+                                   size_t nworkers,
+                                   cc_size pbits,
+                                   cc_unit *p,
+                                   cc_size qbits,
+                                   cc_unit *q,
+                                   const cc_unit *e,
+                                   struct ccrng_state *rng,
+                                   struct ccrng_state *rng_mr)
+{
+    if (nworkers == 0 || ccn_nof(pbits) == 0 || ccn_nof(qbits) == 0) {
+        return CCERR_PARAMETER;
+    }
+
+    struct ccrsa_generate_primes_ctx ctx = {
+        .primes = { { .nbits = pbits, .p = p }, { .nbits = qbits, .p = q } },
+        .e = e,
+        .rng = rng,
+        .rng_mr = rng_mr,
+    };
+
+    atomic_init(&ctx.primes[0].state, 0);
+    atomic_init(&ctx.primes[1].state, 0);
+
+    cc_executor_apply(executor, nworkers, &ctx, ccrsa_generate_primes_work);
+
+    for (size_t k = 0; k < 2; k++) {
+        int state = atomic_load(&ctx.primes[k].state);
+        if (state != 1) {
+            return state ? state : CCERR_INTERNAL;
+        }
+    }
+
+    return CCERR_OK;
+}
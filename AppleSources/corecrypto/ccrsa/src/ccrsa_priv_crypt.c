@@ -31,3 +31,18 @@ int ccrsa_priv_crypt(ccrsa_full_ctx_t key, cc_unit *out, const cc_unit *in)
     CC_FREE_WORKSPACE(ws);
     return rv;
 }
+
+int ccrsa_priv_crypt_executor(const struct cc_executor *executor, ccrsa_full_ctx_t key, cc_unit *out, const cc_unit *in)
+{
+    CC_ENSURE_DIT_ENABLED
+
+    struct ccrng_state *rng = ccrng(NULL);
+    if (!rng) {
+        return CCERR_INTERNAL;
+    }
+
+    CC_DECL_WORKSPACE_OR_FAIL(ws, CCRSA_PRIV_CRYPT_BLINDED_EXECUTOR_WORKSPACE_N(ccrsa_ctx_n(key)));
+    int rv = ccrsa_priv_crypt_blinded_executor_ws(ws, executor, rng, key, out, in);
+    CC_FREE_WORKSPACE(ws);
+    return rv;
+}
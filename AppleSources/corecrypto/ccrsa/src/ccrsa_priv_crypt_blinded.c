@@ -35,23 +35,115 @@
 
 cc_static_assert(SCA_MASK_N == 1, "we use ccn_mul1() for masks");
 
-CC_PURE cc_size CCRSA_CRT_POWER_BLINDED_WORKSPACE_N(cc_size n)
+CC_PURE cc_size CCRSA_CRT_POWER_HALF_WORKSPACE_N(cc_size n)
 {
     // cczp_n(p) + SCA_MASK_N
     cc_size nu = (n / 2 + 1) + SCA_MASK_N;
 
-    return 5 * nu + NB_MASK + cczp_nof_n(nu) +
+    return (n + 1) + nu +
        CC_MAX_EVAL(CCZP_INIT_WORKSPACE_N(nu),
          CC_MAX_EVAL(CCZP_MM_POWER_WORKSPACE_N(nu),
-           CC_MAX_EVAL(CCZP_MODN_WORKSPACE_N(nu),
-             CC_MAX_EVAL(CCZP_MODN_WORKSPACE_N(n),
-                         CCZP_MUL_WORKSPACE_N(nu))
+                     CCZP_MODN_WORKSPACE_N(nu))
+       );
+}
+
+CC_PURE cc_size CCRSA_CRT_POWER_BLINDED_WORKSPACE_N(cc_size n)
+{
+    // cczp_n(p) + SCA_MASK_N
+    cc_size nu = (n / 2 + 1) + SCA_MASK_N;
+
+    return 2 * nu + NB_MASK + 2 * cczp_nof_n(nu) +
+       CC_MAX_EVAL(CCRSA_CRT_POWER_HALF_WORKSPACE_N(n),
+         3 * nu +
+         CC_MAX_EVAL(CCZP_MODN_WORKSPACE_N(nu),
+           CC_MAX_EVAL(CCZP_MODN_WORKSPACE_N(n),
+             CC_MAX_EVAL(CCZP_MUL_WORKSPACE_N(nu),
+                         CCN_MUL_KARATSUBA_WORKSPACE_N(nu))
            )
          )
        );
 }
 
+CC_PURE cc_size CCRSA_PRIV_CRYPT_BLINDED_EXECUTOR_WORKSPACE_N(cc_size n)
+{
+    return 2 * n + CC_MAX_EVAL(CCZP_MM_POWER_FAST_WORKSPACE_N(n), CCRSA_CRT_POWER_BLINDED_WORKSPACE_N(n));
+}
+
+/*
+    Modulus blinding:   x_star = rnd[0]*x
+    Exponent blinding: dx_star = dx + rnd[1]*(x-1)
+    Base blinding:     mx_star = (m + rnd[2]*x) Mod x_star
+
+    sx = mx_star ^ dx_star Mod x_star, where x is either p or q.
+ */
+static int ccrsa_crt_power_half_ws(cc_ws_t ws,
+                                   cczp_const_t zm,
+                                   cczp_const_t zx,
+                                   const cc_unit *dx,
+                                   const cc_unit *rnd,
+                                   cczp_t zx_star,
+                                   cc_unit *sx,
+                                   const cc_unit *m)
+{
+    cc_size n = cczp_n(zm);
+    cc_size nx = cczp_n(zx);
+    int status;
+
+    CC_DECL_BP_WS(ws, bp);
+    cc_unit *tmp =  CC_ALLOC_WS(ws, n + 1);
+    cc_unit *tmp2 = CC_ALLOC_WS(ws, nx + SCA_MASK_N);
+
+    /* x_star:=x*cstx; */
+    CCZP_N(zx_star)=nx+SCA_MASK_N;
+    *(CCZP_PRIME(zx_star)+nx)=ccn_mul1(nx,CCZP_PRIME(zx_star),cczp_prime(zx),SCA_MASK_MASK & (rnd[0] | 1)); /* x_star:=x*cstx; */
+    cc_require((status=cczp_init_ws(ws, zx_star)) == CCERR_OK, errOut);
+
+    /* mx = m + k.x mod x_star */
+    ccn_setn(n+1,tmp,nx,cczp_prime(zx)); // x
+    ccn_set_bit(tmp,0,0);  // x - 1
+    ccn_set(nx,tmp2,dx);   // dx
+    tmp2[nx]=ccn_addmul1(nx,tmp2,tmp,SCA_MASK_MASK & rnd[1]);       /* tmp2 = dx + rnd*(x-1) */
+    tmp[nx]=ccn_mul1(nx,tmp,cczp_prime(zx),SCA_MASK_MASK & rnd[2]); /* tmp = mask*x */
+    ccn_addn(n+1,tmp,tmp,n,m);                                      /* tmp = m + mask*x */
+    cczp_modn_ws(ws, zx_star, tmp, n+1, tmp);                       /* tmp = m + mask*x mod x_star */
+    /* Ignoring error code; arguments guaranteed to be valid. */
+    status=cczp_mm_power_ws(ws, zx_star, sx, tmp, cczp_bitlen(zx) + SCA_MASK_BITSIZE, tmp2); /* sx = (tmp ^ dx) mod x_star */
+    cc_assert(status==0);(void) status; // Public key validation will follow, we don't want to early abort here.
+    status=CCERR_OK;
+
+errOut:
+    CC_FREE_BP_WS(ws, bp);
+    return status;
+}
+
+struct ccrsa_crt_power_half {
+    cczp_const_t zm;
+    cczp_const_t zx;
+    const cc_unit *dx;
+    const cc_unit *rnd;
+    cczp_t zx_star;
+    cc_unit *sx;
+    const cc_unit *m;
+    int status;
+};
+
+static void ccrsa_crt_power_half_work(void *work_ctx, size_t i)
+{
+    struct ccrsa_crt_power_half *half = (struct ccrsa_crt_power_half *)work_ctx + i;
+
+    int rv;
+    CC_DECL_WORKSPACE_RV(ws, CCRSA_CRT_POWER_HALF_WORKSPACE_N(cczp_n(half->zm)), rv);
+    if (rv) {
+        half->status = rv;
+        return;
+    }
+
+    half->status = ccrsa_crt_power_half_ws(ws, half->zm, half->zx, half->dx, half->rnd, half->zx_star, half->sx, half->m);
+    CC_FREE_WORKSPACE(ws);
+}
+
 static int ccrsa_crt_power_blinded_ws(cc_ws_t ws,
+                                      const struct cc_executor *executor,
                                       struct ccrng_state *blinding_rng,
                                       ccrsa_full_ctx_t fk,
                                       cc_unit *r,
@@ -69,14 +161,14 @@ static int ccrsa_crt_power_blinded_ws(cc_ws_t ws,
     cc_size nu=np+SCA_MASK_N; // np >=nq, checked below
     int status=CCRSA_PRIVATE_OP_ERROR;
     CC_DECL_BP_WS(ws, bp);
-    cc_unit *tmp =  CC_ALLOC_WS(ws, 2*nu);
-    cc_unit *tmp2 = CC_ALLOC_WS(ws, nu);
     cc_unit *sp =   CC_ALLOC_WS(ws, nu);
     cc_unit *sq =   CC_ALLOC_WS(ws, nu);
     cc_unit *rnd =  CC_ALLOC_WS(ws, NB_MASK);
+    cc_unit *tmp, *tmp2;
 
-    // Allocate a ZP which will be used to extend p and q for randomization
-    cczp_t zu_masked = (cczp_t)CC_ALLOC_WS(ws, cczp_nof_n(nu));
+    // Allocate ZPs which will be used to extend p and q for randomization
+    cczp_t zp_masked = (cczp_t)CC_ALLOC_WS(ws, cczp_nof_n(nu));
+    cczp_t zq_masked = (cczp_t)CC_ALLOC_WS(ws, cczp_nof_n(nu));
 
     // Sanity check on supported key length
     cc_require_action((cczp_bitlen(zp) >= cczp_bitlen(zq)) && (np>=nq),
@@ -92,50 +184,28 @@ static int ccrsa_crt_power_blinded_ws(cc_ws_t ws,
 
     /*------------ Step 1 ------------------*/
     /*
-        Modulus blinding:   q_star = rnd[0]*q
-        Exponent blinding: dq_star = dq + rnd[1]*(q-1)
-        Base blinding:     mq_star = (x + rnd[2]*q) Mod q_star
+        sq = (x + rnd[2]*q)^(dq + rnd[1]*(q-1)) mod rnd[0]*q
+        sp = (x + rnd[5]*p)^(dp + rnd[4]*(p-1)) mod rnd[3]*p
      */
+    struct ccrsa_crt_power_half halves[2] = {
+        { .zm = zm, .zx = zq, .dx = dq, .rnd = &rnd[0], .zx_star = zq_masked, .sx = sq, .m = x },
+        { .zm = zm, .zx = zp, .dx = dp, .rnd = &rnd[3], .zx_star = zp_masked, .sx = sp, .m = x },
+    };
+
+    if (executor) {
+        cc_executor_apply(executor, 2, halves, ccrsa_crt_power_half_work);
+    } else {
+        for (size_t i = 0; i < 2; i++) {
+            halves[i].status = ccrsa_crt_power_half_ws(ws, zm, halves[i].zx, halves[i].dx, halves[i].rnd,
+                                                       halves[i].zx_star, halves[i].sx, x);
+        }
+    }
 
-    /* q_star:=q*cstq; */
-    CCZP_N(zu_masked)=nq+SCA_MASK_N;
-    *(CCZP_PRIME(zu_masked)+nq)=ccn_mul1(nq,CCZP_PRIME(zu_masked),cczp_prime(zq),SCA_MASK_MASK & (rnd[0] | 1)); /* q_star:=q*cstq; */
-    cc_require((status=cczp_init_ws(ws, zu_masked)) == CCERR_OK, errOut);
-
-    /* mq = m + k2.q mod q_star */
-    ccn_setn(cczp_n(zm)+1,tmp,nq,cczp_prime(zq)); // q
-    ccn_set_bit(tmp,0,0);  // q - 1
-    ccn_set(nq,tmp2,dq);   // dq
-    tmp2[nq]=ccn_addmul1(nq,tmp2,tmp,SCA_MASK_MASK & rnd[1]);       /* tmp2 = dq + rnd*(q-1) */
-    tmp[nq]=ccn_mul1(nq,tmp,cczp_prime(zq),SCA_MASK_MASK & rnd[2]); /* tmp = mask0*q */
-    ccn_addn(cczp_n(zm)+1,tmp,tmp,cczp_n(zm),x);                    /* tmp = x + mask*q */
-    cczp_modn_ws(ws, zu_masked, tmp, cczp_n(zm)+1, tmp);            /* tmp = x + mask*q mod q_star */
-    /* Ignoring error code; arguments guaranteed to be valid. */
-    status=cczp_mm_power_ws(ws, zu_masked, sq, tmp, cczp_bitlen(zq) + SCA_MASK_BITSIZE, tmp2); /* sq = (tmp ^ dq) mod q_star */
-    cc_assert(status==0);(void) status; // Public key validation will follow, we don't want to early abort here.
-
-    /*
-        Modulus blinding:   p_star = rnd[3]*p
-        Exponent blinding: dp_star = dp + rnd[4]*(p-1)
-        Base blinding:     mp_star = (x + rnd[5]*p) Mod p_star
-    */
+    cc_require((status=halves[0].status) == CCERR_OK, errOut);
+    cc_require((status=halves[1].status) == CCERR_OK, errOut);
 
-    /* p_star:=p*cstp; */
-    CCZP_N(zu_masked)=np+SCA_MASK_N;
-    *(CCZP_PRIME(zu_masked)+np)=ccn_mul1(np,CCZP_PRIME(zu_masked),cczp_prime(zp),SCA_MASK_MASK & (rnd[3] | 1)); /* p_star:=p*cstp; */
-    cc_require((status=cczp_init_ws(ws, zu_masked)) == CCERR_OK, errOut);
-
-    /* mp = m + k1.p mod p_star */
-    ccn_setn(cczp_n(zm)+1,tmp,np,cczp_prime(zp)); // p
-    ccn_set_bit(tmp,0,0);  // p - 1
-    ccn_set(np,tmp2,dp);   // dp
-    tmp2[np]=ccn_addmul1(np,tmp2,tmp,SCA_MASK_MASK & rnd[4]);          /* tmp2 = dp + rnd*(p-1) */
-    tmp[np]=ccn_mul1(np, tmp, cczp_prime(zp), SCA_MASK_MASK & rnd[5]); /* tmp = mask*p */
-    ccn_addn(cczp_n(zm)+1,tmp, tmp,cczp_n(zm), x);                     /* tmp = x + mask*p */
-    cczp_modn_ws(ws, zu_masked, tmp, cczp_n(zm)+1, tmp);               /* tmp = x + mask*p mod p_star */
-    /* Ignoring error code; arguments guaranteed to be valid. */
-    status=cczp_mm_power_ws(ws, zu_masked, sp, tmp, cczp_bitlen(zp) + SCA_MASK_BITSIZE, tmp2); /* sp = (tmp ^ dp) mod p_star */
-    cc_assert(status==0);(void) status; // Public key validation will follow, we don't want to early abort here.
+    tmp =  CC_ALLOC_WS(ws, 2*nu);
+    tmp2 = CC_ALLOC_WS(ws, nu);
 
     /*------------ Step 2 ------------------\n
      Garner recombination (requires 2*p>q, which is verified if |p|==|q|)
@@ -149,14 +219,14 @@ static int ccrsa_crt_power_blinded_ws(cc_ws_t ws,
         tmp = tmp + sq
         r = tmp mod n     Finally removes the randomization
     */
-    ccn_setn(nu+2, tmp, nu, cczp_prime(zu_masked));
+    ccn_setn(nu+2, tmp, nu, cczp_prime(zp_masked));
     ccn_shift_left_multi(nu+2, tmp, tmp, SCA_MASK_BITSIZE+1);   // 2*SCA_MASK_MASK*cstp*p
     ccn_addn(nu+2,tmp,tmp,nu,sp);                               // 2*SCA_MASK_MASK*cstp*p + sp
     cc_unit c = ccn_subn(nu+2, tmp, tmp, nq+SCA_MASK_N, sq);    // tmp: t = (sp + (2*SCA_MASK_MASK)*p_star) - sq
     cc_assert(c==0);(void)c;                    // Sanity check that there is no borrow
-    cczp_modn_ws(ws, zu_masked, sp, nu+2, tmp); // sp: = t mod p_star
+    cczp_modn_ws(ws, zp_masked, sp, nu+2, tmp); // sp: = t mod p_star
     ccn_setn(nu, tmp, np, qinv);                // handle nq < np
-    cczp_mul_ws(ws, zu_masked, sp, sp, tmp);    // sp: t = (sp * qinv) mod p_star
+    cczp_mul_ws(ws, zp_masked, sp, sp, tmp);    // sp: t = (sp * qinv) mod p_star
     ccn_setn(nu, tmp2, nq, cczp_prime(zq));     // tmp2: q
 
     ccn_mul_ws(ws,nu, tmp, tmp2, sp);             // tmp: t = t * q
@@ -170,11 +240,12 @@ errOut:
     return status;
 }
 
-int ccrsa_priv_crypt_blinded_ws(cc_ws_t ws,
-                                struct ccrng_state *blinding_rng,
-                                ccrsa_full_ctx_t fk,
-                                cc_unit *out,
-                                const cc_unit *in)
+int ccrsa_priv_crypt_blinded_executor_ws(cc_ws_t ws,
+                                         const struct cc_executor *executor,
+                                         struct ccrng_state *blinding_rng,
+                                         ccrsa_full_ctx_t fk,
+                                         cc_unit *out,
+                                         const cc_unit *in)
 {
     int cond;
 
@@ -201,7 +272,7 @@ int ccrsa_priv_crypt_blinded_ws(cc_ws_t ws,
     ccn_set(n, tmp_in, in);
 
     // Compute out := in^d (mod m).
-    int status = ccrsa_crt_power_blinded_ws(ws, blinding_rng, fk, out, in);
+    int status = ccrsa_crt_power_blinded_ws(ws, executor, blinding_rng, fk, out, in);
 
     // Verify that the computation is correct.
     (void)cczp_mm_power_fast_ws(ws, ccrsa_ctx_zm(fk), tmp, out, ccrsa_ctx_e(fk));
@@ -223,3 +294,12 @@ int ccrsa_priv_crypt_blinded_ws(cc_ws_t ws,
     CC_FREE_BP_WS(ws, bp);
     return status;
 }
+
+int ccrsa_priv_crypt_blinded_ws(cc_ws_t ws,
+                                struct ccrng_state *blinding_rng,
+                                ccrsa_full_ctx_t fk,
+                                cc_unit *out,
+                                const cc_unit *in)
+{
+    return ccrsa_priv_crypt_blinded_executor_ws(ws, NULL, blinding_rng, fk, out, in);
+}
@@ -71,7 +71,7 @@ int ccrsa_verify_pkcs1v15_digest(ccrsa_pub_ctx_t key,
 {
     CC_ENSURE_DIT_ENABLED
 
-    CC_DECL_WORKSPACE_OR_FAIL(ws, CCRSA_VERIFY_PKCS1V15_DIGEST_WORKSPACE_N(ccrsa_ctx_n(key)));
+    CC_DECL_WORKSPACE_ARENA_OR_FAIL(ws, CCRSA_VERIFY_PKCS1V15_DIGEST_WORKSPACE_N(ccrsa_ctx_n(key)));
     int rv = ccrsa_verify_pkcs1v15_digest_ws(ws, key, oid, digest_len, digest, sig_len, sig, fault_canary_out);
     CC_FREE_WORKSPACE(ws);
     return rv;
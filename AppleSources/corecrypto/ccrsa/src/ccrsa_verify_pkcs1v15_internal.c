@@ -92,7 +92,7 @@ int ccrsa_verify_pkcs1v15_internal(const ccrsa_pub_ctx_t key,
                                    int sig_len_validation,
                                    cc_fault_canary_t fault_canary_out)
 {
-    CC_DECL_WORKSPACE_OR_FAIL(ws, CCRSA_VERIFY_PKCS1V15_INTERNAL_WORKSPACE_N(ccrsa_ctx_n(key)));
+    CC_DECL_WORKSPACE_ARENA_OR_FAIL(ws, CCRSA_VERIFY_PKCS1V15_INTERNAL_WORKSPACE_N(ccrsa_ctx_n(key)));
     int rv = ccrsa_verify_pkcs1v15_internal_ws(ws, key, oid, digest_len, digest, sig_len, sig, sig_len_validation, fault_canary_out);
     CC_FREE_WORKSPACE(ws);
     return rv;
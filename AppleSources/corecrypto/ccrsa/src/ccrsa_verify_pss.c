@@ -97,7 +97,7 @@ int ccrsa_verify_pss_digest(ccrsa_pub_ctx_t key,
 {
     CC_ENSURE_DIT_ENABLED
 
-    CC_DECL_WORKSPACE_OR_FAIL(ws, CCRSA_VERIFY_PSS_DIGEST_WORKSPACE_N(ccrsa_ctx_n(key)));
+    CC_DECL_WORKSPACE_ARENA_OR_FAIL(ws, CCRSA_VERIFY_PSS_DIGEST_WORKSPACE_N(ccrsa_ctx_n(key)));
     int rv = ccrsa_verify_pss_digest_ws(ws, key, di, mgfdi, digestSize, digest, sigSize, sig, saltSize, fault_canary_out);
     CC_FREE_WORKSPACE(ws);
     return rv;
@@ -131,7 +131,7 @@ int ccrsa_verify_pss_msg(ccrsa_pub_ctx_t key,
 {
     CC_ENSURE_DIT_ENABLED
 
-    CC_DECL_WORKSPACE_OR_FAIL(ws, CCRSA_VERIFY_PSS_MSG_WORKSPACE_N(ccrsa_ctx_n(key)));
+    CC_DECL_WORKSPACE_ARENA_OR_FAIL(ws, CCRSA_VERIFY_PSS_MSG_WORKSPACE_N(ccrsa_ctx_n(key)));
     int rv = ccrsa_verify_pss_msg_ws(ws, key, di, mgfdi, msg_nbytes, msg, sig_nbytes, sig, salt_nbytes, fault_canary_out);
     CC_FREE_WORKSPACE(ws);
     return rv;
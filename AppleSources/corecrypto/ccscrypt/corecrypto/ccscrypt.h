@@ -13,6 +13,7 @@
 #define _CORECRYPTO_CCSCRYPT_H_
 
 #include <corecrypto/cc.h>
+#include <corecrypto/cc_executor.h>
 
 /*! @function ccscrypt
  @abstract perform scrypt using parameters N, r, and p.
@@ -59,4 +60,46 @@ ccscrypt(size_t password_len, const uint8_t *password, size_t salt_len,
 int64_t
 ccscrypt_storage_size(uint64_t N, uint32_t r, uint32_t p);
 
+/*! @function ccscrypt_parallel
+ @abstract Perform scrypt using parameters N, r, and p, running up to |nworkers| of the p lanes concurrently.
+ @discussion |storage| MUST be allocated space of size at least equal to
+  ccscrypt_parallel_storage_size(N, r, p, nworkers). This memory is cleared upon completion of the computation.
+
+  Each worker needs its own 128 * r * N bytes table, so memory use grows linearly with |nworkers|.
+  The result is the same as the one of ccscrypt().
+
+ @param executor     Executor used to run the workers, or NULL to run them one after the other
+ @param nworkers     Maximum number of lanes processed at the same time, at least 1
+ @param password_len Length of the password
+ @param password     Password to hash
+ @param salt_len     Length of per-invocation salt
+ @param salt         Per-invocation salt
+ @param storage      Temporary storage to be used by the scrypt computation
+ @param N            CPU/memory cost parameter
+ @param r            Scrypt block size parameter
+ @param p            Parallelization parameter
+ @param dk_len       Length of the derived key
+ @param dk           Output buffer for the derived key
+
+ @return 0 on success, non-zero on failure. See cc_error.h for more details.
+ */
+int
+ccscrypt_parallel(const struct cc_executor *executor, size_t nworkers,
+                  size_t password_len, const uint8_t *password, size_t salt_len,
+                  const uint8_t *salt, uint8_t *storage, uint64_t N, uint32_t r,
+                  uint32_t p, size_t dk_len, uint8_t *dk);
+
+/*! @function ccscrypt_parallel_storage_size
+ @abstract Compute the amount of temporary memory needed by ccscrypt_parallel(N, r, p) with |nworkers| workers.
+
+ @param N            CPU/memory cost parameter
+ @param r            Scrypt block size parameter
+ @param p            Parallelization parameter
+ @param nworkers     Maximum number of lanes processed at the same time, at least 1
+
+ @return The storage size if the parameters are valid, negative on failure.
+ */
+int64_t
+ccscrypt_parallel_storage_size(uint64_t N, uint32_t r, uint32_t p, size_t nworkers);
+
 #endif /* _CORECRYPTO_CCSCRYPT_H_ */
@@ -12,6 +12,17 @@
 #ifndef ccscrypt_internal_h
 #define ccscrypt_internal_h
 
+#include <corecrypto/cc_config.h>
+
+// The Salsa20/8 core is written with GCC/clang vector extensions, which load
+// words in host byte order.
+#if (defined(__GNUC__) || defined(__clang__)) && !CC_KERNEL && \
+    defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#define CCSCRYPT_SALSA_VECTOR 1
+#else
+#define CCSCRYPT_SALSA_VECTOR 0
+#endif
+
 /*! @function ccscrypt_valid_parameters
  @abstract Determine if scrypt parameters (N, r, p) are valid.
 
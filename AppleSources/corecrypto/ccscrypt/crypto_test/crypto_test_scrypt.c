@@ -19,6 +19,7 @@ entryPoint(ccscrypt_tests, "ccscrypt test")
 #include <corecrypto/ccscrypt.h>
 #include "ccscrypt_internal.h"
 #include "cc_priv.h"
+#include "cctest_executor.h"
 
 static void
 test_ccscrypt_salsa20_8(void)
@@ -157,6 +158,46 @@ test_ccscrypt(void)
     }
 }
 
+static void
+test_ccscrypt_parallel(void)
+{
+    const size_t nworkers[] = { 1, 3, 16, 64 };
+
+    // The p = 16 vector, with more or fewer workers than lanes.
+    const test_ccscrypt_vector test = test_ccscrypt_vectors[1];
+    byteBuffer expected = hexStringToBytes((char *)test.dk);
+    uint8_t actual[test.dk_len];
+
+    for (size_t i = 0; i < CC_ARRAY_LEN(nworkers); i++) {
+        int64_t buffer_size = ccscrypt_parallel_storage_size(test.N, test.r, test.p, nworkers[i]);
+        uint8_t *buffer = (uint8_t *)malloc((size_t)buffer_size);
+        if (buffer == NULL) {
+            diag("warning: allocation failed");
+            continue;
+        }
+
+        int rv = ccscrypt_parallel(&cctest_executor, nworkers[i], strlen((char *)test.password), test.password,
+                                   strlen((char *)test.salt), test.salt, buffer, test.N, test.r, test.p, test.dk_len, actual);
+        is(rv, CCERR_OK, "ccscrypt_parallel failed");
+        is(cc_cmp_safe(test.dk_len, actual, expected->bytes), 0, "ccscrypt_parallel with %zu workers failed", nworkers[i]);
+
+        rv = ccscrypt_parallel(NULL, nworkers[i], strlen((char *)test.password), test.password,
+                               strlen((char *)test.salt), test.salt, buffer, test.N, test.r, test.p, test.dk_len, actual);
+        is(rv, CCERR_OK, "ccscrypt_parallel failed");
+        is(cc_cmp_safe(test.dk_len, actual, expected->bytes), 0, "serial ccscrypt_parallel with %zu workers failed", nworkers[i]);
+
+        free(buffer);
+    }
+
+    is(ccscrypt_parallel_storage_size(test.N, test.r, test.p, 0), CCERR_PARAMETER, "ccscrypt_parallel_storage_size accepted zero workers");
+    is(ccscrypt_parallel_storage_size(test.N, test.r, test.p, 1), ccscrypt_storage_size(test.N, test.r, test.p),
+       "ccscrypt_parallel_storage_size with one worker differs from ccscrypt_storage_size");
+    is(ccscrypt_parallel_storage_size(test.N, test.r, test.p, 64), ccscrypt_parallel_storage_size(test.N, test.r, test.p, test.p),
+       "ccscrypt_parallel_storage_size did not cap the workers at p");
+
+    free(expected);
+}
+
 static void
 test_ccscrypt_valid_parameters(void)
 {
@@ -180,12 +221,13 @@ test_ccscrypt_valid_parameters(void)
 
 int ccscrypt_tests(TM_UNUSED int argc, TM_UNUSED char *const *argv)
 {
-    plan_tests(7 + test_ccscrypt_vectors_len);
+    plan_tests(7 + test_ccscrypt_vectors_len + 4 * 4 + 3);
 
     test_ccscrypt_salsa20_8();
     test_ccscrypt_blockmix_salsa8();
     test_ccscrypt_romix();
     test_ccscrypt();
+    test_ccscrypt_parallel();
     test_ccscrypt_valid_parameters();
 
     return 0;
@@ -17,34 +17,158 @@
 
 #include "ccscrypt_internal.h"
 
+/*
+ The Salsa20/8 core and scryptBlockMix run on blocks whose 32-bit words are
+ permuted into "diagonal" order: word i of a stored block is word 5i mod 16 of
+ the RFC 7914 block. Each row of four words is then one diagonal of the Salsa20
+ state matrix, so that the column and row rounds are four-wide vector
+ operations separated by lane rotations. ROMix converts its input once, keeps
+ X, Y and the table T in this layout, and converts back at the end.
+ */
+
+#define CCSCRYPT_BLOCK_NBYTES 64
+#define CCSCRYPT_DIAGONAL(i) ((5 * (i)) & 15)
+
 static void
-ccscrypt_block_xor(uint8_t *Z, uint8_t *X, uint8_t *Y, size_t length)
+ccscrypt_block_shuffle(uint8_t *out, const uint8_t *in, size_t nblocks)
 {
-    for (size_t i = 0; i < length; i++) {
-        Z[i] = X[i] ^ Y[i];
+    uint8_t tmp[CCSCRYPT_BLOCK_NBYTES];
+
+    for (size_t k = 0; k < nblocks; k++) {
+        for (size_t i = 0; i < 16; i++) {
+            cc_memcpy(&tmp[4 * i], &in[k * CCSCRYPT_BLOCK_NBYTES + 4 * CCSCRYPT_DIAGONAL(i)], 4);
+        }
+        cc_memcpy(&out[k * CCSCRYPT_BLOCK_NBYTES], tmp, CCSCRYPT_BLOCK_NBYTES);
     }
+
+    cc_clear(sizeof(tmp), tmp);
 }
 
-static uint64_t
-ccscrypt_integerify(uint8_t *B, size_t r, size_t N)
+static void
+ccscrypt_block_unshuffle(uint8_t *out, const uint8_t *in, size_t nblocks)
 {
-    size_t index = (2 * r - 1) * 64;
-    uint8_t *X = &B[index];
-    uint64_t j = (uint64_t)X[0] << 0 | (uint64_t)X[1] << 8 | (uint64_t)X[2] << 16 | (uint64_t)X[3] << 24
-        | (uint64_t)X[4] << 32 | (uint64_t)X[5] << 40 | (uint64_t)X[6] << 48 | (uint64_t)X[7] << 56;
-    return j & (N - 1);
+    uint8_t tmp[CCSCRYPT_BLOCK_NBYTES];
+
+    for (size_t k = 0; k < nblocks; k++) {
+        for (size_t i = 0; i < 16; i++) {
+            cc_memcpy(&tmp[4 * CCSCRYPT_DIAGONAL(i)], &in[k * CCSCRYPT_BLOCK_NBYTES + 4 * i], 4);
+        }
+        cc_memcpy(&out[k * CCSCRYPT_BLOCK_NBYTES], tmp, CCSCRYPT_BLOCK_NBYTES);
+    }
+
+    cc_clear(sizeof(tmp), tmp);
 }
 
-void
-ccscrypt_salsa20_8(uint8_t *in_buffer, uint8_t *out_buffer)
+#if CCSCRYPT_SALSA_VECTOR
+
+typedef uint32_t ccscrypt_v4 __attribute__((vector_size(16)));
+
+// Lane i of the result is lane (i + n) mod 4 of v.
+#if defined(__clang__)
+#define CCSCRYPT_ROTATE_LANES(v, n) __builtin_shufflevector(v, v, (n) & 3, ((n) + 1) & 3, ((n) + 2) & 3, ((n) + 3) & 3)
+#else
+#define CCSCRYPT_ROTATE_LANES(v, n) __builtin_shuffle(v, (ccscrypt_v4){ (n) & 3, ((n) + 1) & 3, ((n) + 2) & 3, ((n) + 3) & 3 })
+#endif
+
+#define CCSCRYPT_ROTL(v, c) (((v) << (c)) | ((v) >> (32 - (c))))
+
+typedef struct {
+    ccscrypt_v4 v[4];
+} ccscrypt_block_t;
+
+CC_INLINE void
+ccscrypt_block_load(ccscrypt_block_t *X, const uint8_t *in)
+{
+    cc_memcpy(X->v, in, CCSCRYPT_BLOCK_NBYTES);
+}
+
+CC_INLINE void
+ccscrypt_block_xor_load(ccscrypt_block_t *X, const uint8_t *in)
+{
+    ccscrypt_block_t t;
+    cc_memcpy(t.v, in, CCSCRYPT_BLOCK_NBYTES);
+
+    for (size_t i = 0; i < 4; i++) {
+        X->v[i] ^= t.v[i];
+    }
+}
+
+CC_INLINE void
+ccscrypt_block_store(uint8_t *out, const ccscrypt_block_t *X)
+{
+    cc_memcpy(out, X->v, CCSCRYPT_BLOCK_NBYTES);
+}
+
+CC_INLINE void
+ccscrypt_block_salsa20_8(ccscrypt_block_t *X)
+{
+    ccscrypt_v4 x0 = X->v[0], x1 = X->v[1], x2 = X->v[2], x3 = X->v[3];
+
+    for (size_t i = 0; i < 8; i += 2) {
+        // Columns.
+        x1 ^= CCSCRYPT_ROTL(x0 + x3, 7);
+        x2 ^= CCSCRYPT_ROTL(x1 + x0, 9);
+        x3 ^= CCSCRYPT_ROTL(x2 + x1, 13);
+        x0 ^= CCSCRYPT_ROTL(x3 + x2, 18);
+
+        x1 = CCSCRYPT_ROTATE_LANES(x1, 3);
+        x2 = CCSCRYPT_ROTATE_LANES(x2, 2);
+        x3 = CCSCRYPT_ROTATE_LANES(x3, 1);
+
+        // Rows.
+        x3 ^= CCSCRYPT_ROTL(x0 + x1, 7);
+        x2 ^= CCSCRYPT_ROTL(x3 + x0, 9);
+        x1 ^= CCSCRYPT_ROTL(x2 + x3, 13);
+        x0 ^= CCSCRYPT_ROTL(x1 + x2, 18);
+
+        x1 = CCSCRYPT_ROTATE_LANES(x1, 1);
+        x2 = CCSCRYPT_ROTATE_LANES(x2, 2);
+        x3 = CCSCRYPT_ROTATE_LANES(x3, 3);
+    }
+
+    X->v[0] += x0;
+    X->v[1] += x1;
+    X->v[2] += x2;
+    X->v[3] += x3;
+}
+
+#else
+
+typedef struct {
+    uint32_t w[16];
+} ccscrypt_block_t;
+
+CC_INLINE void
+ccscrypt_block_load(ccscrypt_block_t *X, const uint8_t *in)
+{
+    for (size_t i = 0; i < 16; i++) {
+        X->w[i] = cc_load32_le(&in[4 * i]);
+    }
+}
+
+CC_INLINE void
+ccscrypt_block_xor_load(ccscrypt_block_t *X, const uint8_t *in)
+{
+    for (size_t i = 0; i < 16; i++) {
+        X->w[i] ^= cc_load32_le(&in[4 * i]);
+    }
+}
+
+CC_INLINE void
+ccscrypt_block_store(uint8_t *out, const ccscrypt_block_t *X)
+{
+    for (size_t i = 0; i < 16; i++) {
+        cc_store32_le(X->w[i], &out[4 * i]);
+    }
+}
+
+static void
+ccscrypt_block_salsa20_8(ccscrypt_block_t *X)
 {
     uint32_t x[16];
 
-    for (int i = 0; i < 16; i++) {
-        x[i] = ((uint32_t)in_buffer[(i * 4) + 0] <<  0 |
-                (uint32_t)in_buffer[(i * 4) + 1] <<  8 |
-                (uint32_t)in_buffer[(i * 4) + 2] << 16 |
-                (uint32_t)in_buffer[(i * 4) + 3] << 24);
+    for (size_t i = 0; i < 16; i++) {
+        x[CCSCRYPT_DIAGONAL(i)] = X->w[i];
     }
 
     // This implementation is taken from:
@@ -71,56 +195,105 @@ ccscrypt_salsa20_8(uint8_t *in_buffer, uint8_t *out_buffer)
     }
 
     for (size_t i = 0; i < 16; i++) {
-        uint32_t input_value = ((uint32_t)in_buffer[(i * 4) + 0] <<  0 |
-                                (uint32_t)in_buffer[(i * 4) + 1] <<  8 |
-                                (uint32_t)in_buffer[(i * 4) + 2] << 16 |
-                                (uint32_t)in_buffer[(i * 4) + 3] << 24);
-        uint32_t result = x[i] + input_value;
-        out_buffer[(i * 4) + 0] = (uint8_t)(result >> 0);
-        out_buffer[(i * 4) + 1] = (uint8_t)(result >> 8);
-        out_buffer[(i * 4) + 2] = (uint8_t)(result >> 16);
-        out_buffer[(i * 4) + 3] = (uint8_t)(result >> 24);
+        X->w[i] += x[CCSCRYPT_DIAGONAL(i)];
     }
+
+    cc_clear(sizeof(x), x);
 }
 
-void
-ccscrypt_blockmix_salsa8(uint8_t *B, uint8_t *Y, size_t r)
+#endif // CCSCRYPT_SALSA_VECTOR
+
+// scryptBlockMix of (B ^ V), or of B if V is NULL, written to out. Output
+// blocks are stored in their final order: even ones first, then odd ones.
+static void
+ccscrypt_blockmix_diagonal(const uint8_t *B, const uint8_t *V, uint8_t *out, size_t r)
 {
-    uint8_t X[64];
+    ccscrypt_block_t X;
 
-    cc_memcpy(X, &B[(2 * r - 1) * 64], 64);
+    ccscrypt_block_load(&X, &B[(2 * r - 1) * CCSCRYPT_BLOCK_NBYTES]);
+    if (V) {
+        ccscrypt_block_xor_load(&X, &V[(2 * r - 1) * CCSCRYPT_BLOCK_NBYTES]);
+    }
 
     for (size_t i = 0; i < 2 * r; i++) {
-        ccscrypt_block_xor(X, X, &B[i * 64], 64);
-        ccscrypt_salsa20_8(X, X);
-        cc_memcpy(&Y[i * 64], X, 64);
+        ccscrypt_block_xor_load(&X, &B[i * CCSCRYPT_BLOCK_NBYTES]);
+        if (V) {
+            ccscrypt_block_xor_load(&X, &V[i * CCSCRYPT_BLOCK_NBYTES]);
+        }
+        ccscrypt_block_salsa20_8(&X);
+        ccscrypt_block_store(&out[((i / 2) + (i & 1) * r) * CCSCRYPT_BLOCK_NBYTES], &X);
     }
 
-    for (size_t i = 0; i < r; i++) {
-        cc_memcpy(&B[i * 64], &Y[(i * 2) * 64], 64);
+    cc_clear(sizeof(X), &X);
+}
+
+static uint64_t
+ccscrypt_integerify_diagonal(const uint8_t *B, size_t r, size_t N)
+{
+    // Words 0 and 1 of the last block live at diagonal positions 0 and 13.
+    const uint8_t *X = &B[(2 * r - 1) * CCSCRYPT_BLOCK_NBYTES];
+    uint64_t j = (uint64_t)cc_load32_le(&X[4 * 0]) | (uint64_t)cc_load32_le(&X[4 * 13]) << 32;
+    return j & (N - 1);
+}
+
+// ROMix on a block X in diagonal layout; Y is scratch of the same size.
+static void
+ccscrypt_romix_diagonal(size_t r, uint8_t *X, size_t N, uint8_t *T, uint8_t *Y)
+{
+    const size_t len = 128 * r;
+
+    // T[0] = X, T[i + 1] = BlockMix(T[i]), X = BlockMix(T[N - 1])
+    cc_memcpy(T, X, len);
+    for (size_t i = 0; i + 1 < N; i++) {
+        ccscrypt_blockmix_diagonal(&T[i * len], NULL, &T[(i + 1) * len], r);
     }
-    for (size_t i = 0; i < r; i++) {
-        cc_memcpy(&B[(i + r) * 64], &Y[(i * 2 + 1) * 64], 64);
+    ccscrypt_blockmix_diagonal(&T[(N - 1) * len], NULL, X, r);
+
+    // An even number of steps, the result ends up in X.
+    for (size_t i = 0; i < N; i += 2) {
+        uint64_t j = ccscrypt_integerify_diagonal(X, r, N);
+        ccscrypt_blockmix_diagonal(X, &T[j * len], Y, r);
+
+        if (i + 1 == N) {
+            cc_memcpy(X, Y, len);
+            break;
+        }
+
+        j = ccscrypt_integerify_diagonal(Y, r, N);
+        ccscrypt_blockmix_diagonal(Y, &T[j * len], X, r);
     }
 }
 
 void
-ccscrypt_romix(size_t r, uint8_t *B, size_t N, uint8_t *T, uint8_t *X, uint8_t *Y)
+ccscrypt_salsa20_8(uint8_t *in_buffer, uint8_t *out_buffer)
 {
-    cc_memcpy(X, B, 128 * r);
+    uint8_t tmp[CCSCRYPT_BLOCK_NBYTES];
+    ccscrypt_block_t X;
 
-    for (size_t i = 0; i < N; i++) {
-        cc_memcpy(&T[i * (128 * r)], X, 128 * r);
-        ccscrypt_blockmix_salsa8(X, Y, r);
-    }
+    ccscrypt_block_shuffle(tmp, in_buffer, 1);
+    ccscrypt_block_load(&X, tmp);
+    ccscrypt_block_salsa20_8(&X);
+    ccscrypt_block_store(tmp, &X);
+    ccscrypt_block_unshuffle(out_buffer, tmp, 1);
 
-    for (size_t i = 0; i < N; i++) {
-        uint64_t j = ccscrypt_integerify(X, r, N);
-        ccscrypt_block_xor(X, X, &T[j * (128 * r)], 128 * r);
-        ccscrypt_blockmix_salsa8(X, Y, r);
-    }
+    cc_clear(sizeof(tmp), tmp);
+    cc_clear(sizeof(X), &X);
+}
 
-    cc_memcpy(B, X, 128 * r);
+void
+ccscrypt_blockmix_salsa8(uint8_t *B, uint8_t *Y, size_t r)
+{
+    ccscrypt_block_shuffle(B, B, 2 * r);
+    ccscrypt_blockmix_diagonal(B, NULL, Y, r);
+    ccscrypt_block_unshuffle(B, Y, 2 * r);
+}
+
+void
+ccscrypt_romix(size_t r, uint8_t *B, size_t N, uint8_t *T, uint8_t *X, uint8_t *Y)
+{
+    ccscrypt_block_shuffle(X, B, 2 * r);
+    ccscrypt_romix_diagonal(r, X, N, T, Y);
+    ccscrypt_block_unshuffle(B, X, 2 * r);
 }
 
 int
@@ -147,8 +320,15 @@ ccscrypt_valid_parameters(uint64_t N, uint32_t r, uint32_t p)
     return CCERR_OK;
 }
 
+// Lanes running at the same time, each needs its own X, Y and T.
+static size_t
+ccscrypt_nworkers(uint32_t p, size_t nworkers)
+{
+    return CC_MIN(nworkers, CC_MAX((size_t)p, 1));
+}
+
 int64_t
-ccscrypt_storage_size(uint64_t N, uint32_t r, uint32_t p)
+ccscrypt_parallel_storage_size(uint64_t N, uint32_t r, uint32_t p, size_t nworkers)
 {
     CC_ENSURE_DIT_ENABLED
 
@@ -157,6 +337,11 @@ ccscrypt_storage_size(uint64_t N, uint32_t r, uint32_t p)
         return valid;
     }
 
+    if (nworkers == 0) {
+        return CCERR_PARAMETER;
+    }
+    nworkers = ccscrypt_nworkers(p, nworkers);
+
     int64_t x, y, z, result;
     bool overflow = false;
 
@@ -165,8 +350,9 @@ ccscrypt_storage_size(uint64_t N, uint32_t r, uint32_t p)
     overflow |= cc_mul_overflow(256, r, &y);
     overflow |= cc_mul_overflow(128, r, &z);
     overflow |= cc_mul_overflow(N, z, &z);
-    overflow |= cc_add_overflow(x, y, &result);
-    overflow |= cc_add_overflow(z, result, &result);
+    overflow |= cc_add_overflow(y, z, &result);
+    overflow |= cc_mul_overflow(nworkers, result, &result);
+    overflow |= cc_add_overflow(x, result, &result);
 
     if (overflow) {
         return CCERR_OVERFLOW;
@@ -175,15 +361,47 @@ ccscrypt_storage_size(uint64_t N, uint32_t r, uint32_t p)
     return result;
 }
 
+int64_t
+ccscrypt_storage_size(uint64_t N, uint32_t r, uint32_t p)
+{
+    return ccscrypt_parallel_storage_size(N, r, p, 1);
+}
+
+struct ccscrypt_lanes {
+    size_t N;
+    size_t r;
+    size_t p;
+    size_t nworkers;
+    uint8_t *B;
+    uint8_t *scratch;
+};
+
+// Worker w runs ROMix on lanes w, w + nworkers, ... with its own scratch.
+static void
+ccscrypt_romix_worker(void *ctx, size_t w)
+{
+    const struct ccscrypt_lanes *lanes = ctx;
+    const size_t len = 128 * lanes->r;
+
+    uint8_t *X = &lanes->scratch[w * (2 + lanes->N) * len];
+    uint8_t *Y = &X[len];
+    uint8_t *T = &Y[len];
+
+    for (size_t i = w; i < lanes->p; i += lanes->nworkers) {
+        ccscrypt_romix(lanes->r, &lanes->B[i * len], lanes->N, T, X, Y);
+    }
+}
+
 int
-ccscrypt(size_t password_len, const uint8_t *password, size_t salt_len, const uint8_t *salt,
-         uint8_t *storage, uint64_t N_in, uint32_t r_in, uint32_t p_in, size_t dk_len, uint8_t *dk)
+ccscrypt_parallel(const struct cc_executor *executor, size_t nworkers,
+                  size_t password_len, const uint8_t *password, size_t salt_len, const uint8_t *salt,
+                  uint8_t *storage, uint64_t N_in, uint32_t r_in, uint32_t p_in, size_t dk_len, uint8_t *dk)
 {
     CC_ENSURE_DIT_ENABLED
 
     cc_assert(storage);
 
-    int64_t total_size = ccscrypt_storage_size(N_in, r_in, p_in);
+    int64_t total_size = ccscrypt_parallel_storage_size(N_in, r_in, p_in, nworkers);
     if (total_size < 0) {
         // This will either be CCERR_PARAMETER or CCERR_OVERFLOW.
         return (int)total_size;
@@ -197,23 +415,23 @@ ccscrypt(size_t password_len, const uint8_t *password, size_t salt_len, const ui
     size_t r = (size_t)r_in;
     size_t p = (size_t)p_in;
     size_t B_len = 128 * r * p;
-    size_t X_len = 128 * r;
-    size_t Y_len = 128 * r;
 
-    uint8_t *B = storage;
-    uint8_t *X = &storage[B_len];
-    uint8_t *Y = &storage[B_len + X_len];
-    uint8_t *T = &storage[B_len + X_len + Y_len];
+    struct ccscrypt_lanes lanes = {
+        .N = N,
+        .r = r,
+        .p = p,
+        .nworkers = ccscrypt_nworkers(p_in, nworkers),
+        .B = storage,
+        .scratch = &storage[B_len],
+    };
 
-    if (0 != ccpbkdf2_hmac(ccsha256_di(), password_len, password, salt_len, salt, 1, B_len, B)) {
+    if (0 != ccpbkdf2_hmac(ccsha256_di(), password_len, password, salt_len, salt, 1, B_len, lanes.B)) {
         return CCERR_INTERNAL;
     }
 
-    for (size_t i = 0; i < p; i++) {
-        ccscrypt_romix(r, &B[i * 128 * r], N, T, X, Y);
-    }
+    cc_executor_apply(executor, lanes.nworkers, &lanes, ccscrypt_romix_worker);
 
-    if (0 != ccpbkdf2_hmac(ccsha256_di(), password_len, password, B_len, B, 1, dk_len, dk)) {
+    if (0 != ccpbkdf2_hmac(ccsha256_di(), password_len, password, B_len, lanes.B, 1, dk_len, dk)) {
         return CCERR_INTERNAL;
     }
 
@@ -221,3 +439,10 @@ ccscrypt(size_t password_len, const uint8_t *password, size_t salt_len, const ui
 
     return 0;
 }
+
+int
+ccscrypt(size_t password_len, const uint8_t *password, size_t salt_len, const uint8_t *salt,
+         uint8_t *storage, uint64_t N, uint32_t r, uint32_t p, size_t dk_len, uint8_t *dk)
+{
+    return ccscrypt_parallel(NULL, 1, password_len, password, salt_len, salt, storage, N, r, p, dk_len, dk);
+}
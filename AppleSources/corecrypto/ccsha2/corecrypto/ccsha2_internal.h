@@ -28,6 +28,97 @@ void ccsha256_v6m_compress(ccdigest_state_t c, size_t num, const void *p) __asm_
 void ccsha256_ltc_compress(ccdigest_state_t state, size_t nblocks, const void *buf);
 void ccsha512_ltc_compress(ccdigest_state_t state, size_t nblocks, const void *in);
 
+// Lane-interleaved (multi-buffer) kernels are written with GCC/clang vector
+// extensions; other toolchains fall back to one compression call per lane.
+#if (defined(__GNUC__) || defined(__clang__)) && !CC_KERNEL
+#define CCSHA2_MB_VECTOR 1
+#else
+#define CCSHA2_MB_VECTOR 0
+#endif
+
+#define CCSHA256_MB_MAX_LANES 16
+#define CCSHA512_MB_MAX_LANES 8
+
+/*! @function ccsha256_mb_lanes
+ @abstract Number of SHA-256 states the widest available kernel processes at once.
+
+ @discussion 16 with AVX-512, 8 with AVX2, 4 with 128-bit vectors and 1 when
+ no vector kernel is available.
+ */
+size_t ccsha256_mb_lanes(void);
+
+/*! @function ccsha256_mb_compress
+ @abstract Compress `nblocks` blocks into each of `nlanes` independent states.
+
+ @param nlanes  Number of lanes, at most CCSHA256_MB_MAX_LANES.
+ @param states  States of SHA-224 or SHA-256, one per lane.
+ @param nblocks Number of blocks to compress in every lane.
+ @param in      Input of each lane, `nblocks * CCSHA256_BLOCK_SIZE` bytes.
+ */
+void ccsha256_mb_compress(size_t nlanes, ccdigest_state_t *states, size_t nblocks, const uint8_t *const *in);
+
+/*! @function ccsha512_mb_lanes
+ @abstract Number of SHA-512 states the widest available kernel processes at once.
+
+ @discussion 8 with AVX-512, 4 with AVX2, 2 with 128-bit vectors and 1 when
+ no vector kernel is available.
+ */
+size_t ccsha512_mb_lanes(void);
+
+/*! @function ccsha512_mb_compress
+ @abstract Compress `nblocks` blocks into each of `nlanes` independent states.
+
+ @param nlanes  Number of lanes, at most CCSHA512_MB_MAX_LANES.
+ @param states  States of SHA-384, SHA-512 or SHA-512/256, one per lane.
+ @param nblocks Number of blocks to compress in every lane.
+ @param in      Input of each lane, `nblocks * CCSHA512_BLOCK_SIZE` bytes.
+ */
+void ccsha512_mb_compress(size_t nlanes, ccdigest_state_t *states, size_t nblocks, const uint8_t *const *in);
+
+/*! @struct ccsha2_mb_engine
+ @abstract Multi-buffer compression function matching a SHA-2 digest.
+
+ @field lanes       Number of states the widest available kernel processes at once.
+ @field word_nbytes Size of a state word, 4 for SHA-224/256 and 8 for SHA-384/512.
+ @field compress    ccsha256_mb_compress() or ccsha512_mb_compress().
+ */
+struct ccsha2_mb_engine {
+    size_t lanes;
+    size_t word_nbytes;
+    void (*compress)(size_t nlanes, ccdigest_state_t *states, size_t nblocks, const uint8_t *const *in);
+};
+
+/*! @function ccsha2_mb_engine
+ @abstract Look up the multi-buffer engine for `di`.
+
+ @return true if `di` is a SHA-2 digest whose state is compatible with the
+ multi-buffer kernels, false otherwise.
+ */
+CC_NONNULL_ALL
+bool ccsha2_mb_engine(const struct ccdigest_info *di, struct ccsha2_mb_engine *engine);
+
+/*! @function ccsha2_mb
+ @abstract Compute the digests of `n` independent messages.
+
+ @discussion Messages are scheduled onto the lanes of the multi-buffer
+ kernels; a lane is refilled with the next message as soon as its current
+ message is done, so messages of different lengths can be mixed freely.
+
+ @param di      SHA-224, SHA-256, SHA-384, SHA-512 or SHA-512/256 digest info.
+ @param n       Number of messages.
+ @param lens    Length of each message.
+ @param data    Pointer to each message.
+ @param digests Output buffer of `di->output_size` bytes for each message.
+
+ @return CCERR_OK on success, CCERR_PARAMETER if `di` is not a SHA-2 digest.
+ */
+CC_NONNULL((1)) CC_WARN_RESULT
+int ccsha2_mb(const struct ccdigest_info *di,
+              size_t n,
+              const size_t *lens,
+              const void *const *data,
+              void *const *digests);
+
 #if CCSHA2_VNG_INTEL && defined(__x86_64__)
 extern const struct ccdigest_info ccsha224_vng_intel_AVX2_di;
 extern const struct ccdigest_info ccsha224_vng_intel_AVX1_di;
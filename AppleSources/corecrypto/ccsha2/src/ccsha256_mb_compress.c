@@ -0,0 +1,118 @@
+/* Copyright (c) (2023) Apple Inc. All rights reserved.
+ *
+ * corecrypto is licensed under Apple Inc.’s Internal Use License Agreement (which
+ * is contained in the License.txt file distributed with corecrypto) and only to
+ * people who accept that license. IMPORTANT:  Any license rights granted to you by
+ * Apple Inc. (if any) are limited to internal use within your organization only on
+ * devices and computers you own or control, for the sole purpose of verifying the
+ * security characteristics and correct functioning of the Apple Software.  You may
+ * not, directly or indirectly, redistribute the Apple Software or any portions thereof.
+ */
+
+#include <corecrypto/ccsha2.h>
+#include "cc_internal.h"
+#include "cc_runtime_config.h"
+#include "ccsha2_internal.h"
+
+typedef void (*ccsha256_mb_kernel_t)(ccdigest_state_t *states, size_t nblocks, const uint8_t *const *in);
+
+#if CCSHA2_MB_VECTOR
+
+typedef uint32_t ccsha256_mb_x4_t __attribute__((vector_size(16)));
+
+#define CCSHA256_MB_FN ccsha256_mb_compress_x4
+#define CCSHA256_MB_VEC ccsha256_mb_x4_t
+#define CCSHA256_MB_LANES 4
+#define CCSHA256_MB_TARGET
+#include "ccsha256_mb_compress.inc"
+
+#if defined(__x86_64__)
+
+typedef uint32_t ccsha256_mb_x8_t __attribute__((vector_size(32)));
+
+#define CCSHA256_MB_FN ccsha256_mb_compress_x8
+#define CCSHA256_MB_VEC ccsha256_mb_x8_t
+#define CCSHA256_MB_LANES 8
+#define CCSHA256_MB_TARGET __attribute__((target("avx2")))
+#include "ccsha256_mb_compress.inc"
+
+typedef uint32_t ccsha256_mb_x16_t __attribute__((vector_size(64)));
+
+#define CCSHA256_MB_FN ccsha256_mb_compress_x16
+#define CCSHA256_MB_VEC ccsha256_mb_x16_t
+#define CCSHA256_MB_LANES 16
+#define CCSHA256_MB_TARGET __attribute__((target("avx512f")))
+#include "ccsha256_mb_compress.inc"
+
+#endif // defined(__x86_64__)
+
+#endif // CCSHA2_MB_VECTOR
+
+static size_t ccsha256_mb_kernel(ccsha256_mb_kernel_t *kernel)
+{
+#if CCSHA2_MB_VECTOR
+#if defined(__x86_64__)
+    if (CC_HAS_AVX512F()) {
+        *kernel = ccsha256_mb_compress_x16;
+        return 16;
+    }
+
+    if (CC_HAS_AVX2()) {
+        *kernel = ccsha256_mb_compress_x8;
+        return 8;
+    }
+#endif
+
+    *kernel = ccsha256_mb_compress_x4;
+    return 4;
+#else
+    *kernel = NULL;
+    return 1;
+#endif
+}
+
+size_t ccsha256_mb_lanes(void)
+{
+    ccsha256_mb_kernel_t kernel;
+    return ccsha256_mb_kernel(&kernel);
+}
+
+void ccsha256_mb_compress(size_t nlanes, ccdigest_state_t *states, size_t nblocks, const uint8_t *const *in)
+{
+    ccsha256_mb_kernel_t kernel;
+    size_t width = ccsha256_mb_kernel(&kernel);
+
+    while (nlanes > 0) {
+        size_t m = CC_MIN(nlanes, width);
+
+        if (m == 1) {
+            ccsha256_di()->compress(states[0], nblocks, in[0]);
+        } else if (m == width) {
+            kernel(states, nblocks, in);
+        } else {
+            // Fill the unused lanes of a partial group with scratch states
+            // that re-read the input of the first lane.
+            uint64_t scratch[CCSHA256_MB_MAX_LANES][CCSHA256_STATE_SIZE / sizeof(uint64_t)];
+            ccdigest_state_t st[CCSHA256_MB_MAX_LANES];
+            const uint8_t *p[CCSHA256_MB_MAX_LANES];
+
+            for (size_t l = 0; l < width; l++) {
+                if (l < m) {
+                    st[l] = states[l];
+                    p[l] = in[l];
+                } else {
+                    st[l] = (ccdigest_state_t)scratch[l];
+                    cc_memcpy(scratch[l], states[0], CCSHA256_STATE_SIZE);
+                    p[l] = in[0];
+                }
+            }
+
+            kernel(st, nblocks, p);
+            cc_clear(sizeof(scratch), scratch);
+        }
+
+        states += m;
+        in += m;
+        nlanes -= m;
+    }
+}
@@ -0,0 +1,168 @@
+/* Copyright (c) (2023) Apple Inc. All rights reserved.
+ *
+ * corecrypto is licensed under Apple Inc.’s Internal Use License Agreement (which
+ * is contained in the License.txt file distributed with corecrypto) and only to
+ * people who accept that license. IMPORTANT:  Any license rights granted to you by
+ * Apple Inc. (if any) are limited to internal use within your organization only on
+ * devices and computers you own or control, for the sole purpose of verifying the
+ * security characteristics and correct functioning of the Apple Software.  You may
+ * not, directly or indirectly, redistribute the Apple Software or any portions thereof.
+ */
+
+#include <corecrypto/ccsha2.h>
+#include "cc_internal.h"
+#include "ccdigest_internal.h"
+#include "ccsha2_internal.h"
+
+#define CCSHA2_MB_MAX_LANES CC_MAX_EVAL(CCSHA256_MB_MAX_LANES, CCSHA512_MB_MAX_LANES)
+
+struct ccsha2_mb_lane {
+    size_t job;
+    const uint8_t *ptr;
+    // Blocks left in the current segment (message body, then padded tail).
+    size_t nblocks;
+    // Number of padded tail blocks, zero once the lane is in its tail.
+    size_t ntail;
+    uint8_t tail[2 * CCSHA512_BLOCK_SIZE];
+};
+
+bool ccsha2_mb_engine(const struct ccdigest_info *di, struct ccsha2_mb_engine *engine)
+{
+    if (ccdigest_oid_equal(di, CC_DIGEST_OID_SHA224) || ccdigest_oid_equal(di, CC_DIGEST_OID_SHA256)) {
+        engine->lanes = ccsha256_mb_lanes();
+        engine->word_nbytes = sizeof(uint32_t);
+        engine->compress = ccsha256_mb_compress;
+        return di->block_size == CCSHA256_BLOCK_SIZE && di->state_size == CCSHA256_STATE_SIZE;
+    }
+
+    if (ccdigest_oid_equal(di, CC_DIGEST_OID_SHA384) || ccdigest_oid_equal(di, CC_DIGEST_OID_SHA512) ||
+        ccdigest_oid_equal(di, CC_DIGEST_OID_SHA512_256)) {
+        engine->lanes = ccsha512_mb_lanes();
+        engine->word_nbytes = sizeof(uint64_t);
+        engine->compress = ccsha512_mb_compress;
+        return di->block_size == CCSHA512_BLOCK_SIZE && di->state_size == CCSHA512_STATE_SIZE;
+    }
+
+    return false;
+}
+
+// Build the padded final block(s) of a message and return how many there are.
+static size_t ccsha2_mb_pad(const struct ccdigest_info *di, size_t len, const uint8_t *data, uint8_t *tail)
+{
+    size_t bs = di->block_size;
+    // SHA-256 encodes the bit length on 64 bits, SHA-512 on 128 bits.
+    size_t len_nbytes = bs / 8;
+    size_t rem = len % bs;
+    size_t ntail = (rem + 1 + len_nbytes > bs) ? 2 : 1;
+
+    cc_clear(ntail * bs, tail);
+    if (rem) {
+        cc_memcpy(tail, data + len - rem, rem);
+    }
+    tail[rem] = 0x80;
+
+    cc_store64_be((uint64_t)len << 3, tail + ntail * bs - sizeof(uint64_t));
+    if (len_nbytes > sizeof(uint64_t)) {
+        cc_store64_be((uint64_t)len >> 61, tail + ntail * bs - 2 * sizeof(uint64_t));
+    }
+
+    return ntail;
+}
+
+static void ccsha2_mb_output(const struct ccdigest_info *di,
+                             const struct ccsha2_mb_engine *engine,
+                             ccdigest_state_t state,
+                             uint8_t *digest)
+{
+    for (size_t i = 0; i < di->output_size / engine->word_nbytes; i++) {
+        if (engine->word_nbytes == sizeof(uint32_t)) {
+            cc_store32_be(ccdigest_u32(state)[i], digest + 4 * i);
+        } else {
+            cc_store64_be(ccdigest_u64(state)[i], digest + 8 * i);
+        }
+    }
+}
+
+int ccsha2_mb(const struct ccdigest_info *di, size_t n, const size_t *lens, const void *const *data, void *const *digests)
+{
+    struct ccsha2_mb_engine engine;
+    if (!ccsha2_mb_engine(di, &engine)) {
+        return CCERR_PARAMETER;
+    }
+
+    struct ccsha2_mb_lane lanes[CCSHA2_MB_MAX_LANES];
+    uint64_t state_buf[CCSHA2_MB_MAX_LANES][CCSHA512_STATE_SIZE / sizeof(uint64_t)];
+    bool active[CCSHA2_MB_MAX_LANES] = { false };
+
+    ccdigest_state_t states[CCSHA2_MB_MAX_LANES];
+    const uint8_t *ptrs[CCSHA2_MB_MAX_LANES];
+    size_t idx[CCSHA2_MB_MAX_LANES];
+
+    size_t next = 0;
+
+    for (;;) {
+        // Refill idle lanes with the next messages.
+        for (size_t l = 0; l < engine.lanes && next < n; l++) {
+            if (active[l]) {
+                continue;
+            }
+
+            struct ccsha2_mb_lane *lane = &lanes[l];
+            lane->job = next++;
+            lane->ptr = data[lane->job];
+            lane->nblocks = lens[lane->job] / di->block_size;
+            lane->ntail = ccsha2_mb_pad(di, lens[lane->job], lane->ptr, lane->tail);
+
+            if (lane->nblocks == 0) {
+                lane->ptr = lane->tail;
+                lane->nblocks = lane->ntail;
+                lane->ntail = 0;
+            }
+
+            cc_memcpy(state_buf[l], di->initial_state, di->state_size);
+            active[l] = true;
+        }
+
+        // Gather the active lanes and the number of blocks they all have left.
+        size_t nactive = 0;
+        size_t nblocks = SIZE_MAX;
+        for (size_t l = 0; l < engine.lanes; l++) {
+            if (active[l]) {
+                idx[nactive] = l;
+                states[nactive] = (ccdigest_state_t)state_buf[l];
+                ptrs[nactive] = lanes[l].ptr;
+                nblocks = CC_MIN(nblocks, lanes[l].nblocks);
+                nactive++;
+            }
+        }
+
+        if (nactive == 0) {
+            break;
+        }
+
+        engine.compress(nactive, states, nblocks, ptrs);
+
+        for (size_t i = 0; i < nactive; i++) {
+            struct ccsha2_mb_lane *lane = &lanes[idx[i]];
+            lane->ptr += nblocks * di->block_size;
+            lane->nblocks -= nblocks;
+
+            if (lane->nblocks > 0) {
+                continue;
+            }
+
+            if (lane->ntail > 0) {
+                lane->ptr = lane->tail;
+                lane->nblocks = lane->ntail;
+                lane->ntail = 0;
+            } else {
+                ccsha2_mb_output(di, &engine, states[i], digests[lane->job]);
+                active[idx[i]] = false;
+            }
+        }
+    }
+
+    cc_clear(sizeof(lanes), lanes);
+    cc_clear(sizeof(state_buf), state_buf);
+    return CCERR_OK;
+}
@@ -0,0 +1,118 @@
+/* Copyright (c) (2023) Apple Inc. All rights reserved.
+ *
+ * corecrypto is licensed under Apple Inc.’s Internal Use License Agreement (which
+ * is contained in the License.txt file distributed with corecrypto) and only to
+ * people who accept that license. IMPORTANT:  Any license rights granted to you by
+ * Apple Inc. (if any) are limited to internal use within your organization only on
+ * devices and computers you own or control, for the sole purpose of verifying the
+ * security characteristics and correct functioning of the Apple Software.  You may
+ * not, directly or indirectly, redistribute the Apple Software or any portions thereof.
+ */
+
+#include <corecrypto/ccsha2.h>
+#include "cc_internal.h"
+#include "cc_runtime_config.h"
+#include "ccsha2_internal.h"
+
+typedef void (*ccsha512_mb_kernel_t)(ccdigest_state_t *states, size_t nblocks, const uint8_t *const *in);
+
+#if CCSHA2_MB_VECTOR
+
+typedef uint64_t ccsha512_mb_x2_t __attribute__((vector_size(16)));
+
+#define CCSHA512_MB_FN ccsha512_mb_compress_x2
+#define CCSHA512_MB_VEC ccsha512_mb_x2_t
+#define CCSHA512_MB_LANES 2
+#define CCSHA512_MB_TARGET
+#include "ccsha512_mb_compress.inc"
+
+#if defined(__x86_64__)
+
+typedef uint64_t ccsha512_mb_x4_t __attribute__((vector_size(32)));
+
+#define CCSHA512_MB_FN ccsha512_mb_compress_x4
+#define CCSHA512_MB_VEC ccsha512_mb_x4_t
+#define CCSHA512_MB_LANES 4
+#define CCSHA512_MB_TARGET __attribute__((target("avx2")))
+#include "ccsha512_mb_compress.inc"
+
+typedef uint64_t ccsha512_mb_x8_t __attribute__((vector_size(64)));
+
+#define CCSHA512_MB_FN ccsha512_mb_compress_x8
+#define CCSHA512_MB_VEC ccsha512_mb_x8_t
+#define CCSHA512_MB_LANES 8
+#define CCSHA512_MB_TARGET __attribute__((target("avx512f")))
+#include "ccsha512_mb_compress.inc"
+
+#endif // defined(__x86_64__)
+
+#endif // CCSHA2_MB_VECTOR
+
+static size_t ccsha512_mb_kernel(ccsha512_mb_kernel_t *kernel)
+{
+#if CCSHA2_MB_VECTOR
+#if defined(__x86_64__)
+    if (CC_HAS_AVX512F()) {
+        *kernel = ccsha512_mb_compress_x8;
+        return 8;
+    }
+
+    if (CC_HAS_AVX2()) {
+        *kernel = ccsha512_mb_compress_x4;
+        return 4;
+    }
+#endif
+
+    *kernel = ccsha512_mb_compress_x2;
+    return 2;
+#else
+    *kernel = NULL;
+    return 1;
+#endif
+}
+
+size_t ccsha512_mb_lanes(void)
+{
+    ccsha512_mb_kernel_t kernel;
+    return ccsha512_mb_kernel(&kernel);
+}
+
+void ccsha512_mb_compress(size_t nlanes, ccdigest_state_t *states, size_t nblocks, const uint8_t *const *in)
+{
+    ccsha512_mb_kernel_t kernel;
+    size_t width = ccsha512_mb_kernel(&kernel);
+
+    while (nlanes > 0) {
+        size_t m = CC_MIN(nlanes, width);
+
+        if (m == 1) {
+            ccsha512_di()->compress(states[0], nblocks, in[0]);
+        } else if (m == width) {
+            kernel(states, nblocks, in);
+        } else {
+            // Fill the unused lanes of a partial group with scratch states
+            // that re-read the input of the first lane.
+            uint64_t scratch[CCSHA512_MB_MAX_LANES][CCSHA512_STATE_SIZE / sizeof(uint64_t)];
+            ccdigest_state_t st[CCSHA512_MB_MAX_LANES];
+            const uint8_t *p[CCSHA512_MB_MAX_LANES];
+
+            for (size_t l = 0; l < width; l++) {
+                if (l < m) {
+                    st[l] = states[l];
+                    p[l] = in[l];
+                } else {
+                    st[l] = (ccdigest_state_t)scratch[l];
+                    cc_memcpy(scratch[l], states[0], CCSHA512_STATE_SIZE);
+                    p[l] = in[0];
+                }
+            }
+
+            kernel(st, nblocks, p);
+            cc_clear(sizeof(scratch), scratch);
+        }
+
+        states += m;
+        in += m;
+        nlanes -= m;
+    }
+}
@@ -274,6 +274,29 @@ int cczp_power_blinded_ws(cc_ws_t ws, cczp_const_t zp, cc_unit *r, const cc_unit
 
 int cczp_inv_ws(cc_ws_t ws, cczp_const_t zp, cc_unit *r, const cc_unit *x);
 
+/*! @function cczp_inv_batch_ws
+ @abstract Computes r[i] := x[i]^-1 (mod p) for 0 <= i < k.
+
+ @param ws  Workspace of size CCZP_INV_BATCH_WORKSPACE_N(cczp_n(zp), k)
+ @param zp  Multiplicative group Z/(p).
+ @param k   Number of elements to invert.
+ @param r   k resulting modular inverses, of cczp_n(zp) units each.
+ @param x   k elements to invert, of cczp_n(zp) units each.
+
+ @discussion Uses Montgomery's trick: one call to cczp_inv_ws() and 3(k-1)
+             modular multiplications. r and x may be the same.
+
+             If any x[i] is not invertible, neither is their product and the
+             function fails.
+
+ @return 0 on success, non-zero on failure. See cc_error.h for more details.
+ */
+CC_NONNULL_ALL CC_WARN_RESULT
+int cczp_inv_batch_ws(cc_ws_t ws, cczp_const_t zp, cc_size k, cc_unit *r, const cc_unit *x);
+
+CC_NONNULL_ALL CC_WARN_RESULT
+int cczp_inv_batch(cczp_const_t zp, cc_size k, cc_unit *r, const cc_unit *x);
+
 /*
  * Montgomery representation support
  */
@@ -432,6 +432,43 @@ static void test_cczp_inv(void)
     isnt(res, 0, "cczp_inv should have failed");
 }
 
+static void test_cczp_inv_batch(void)
+{
+    cczp_decl_n(n, zp);
+    CCZP_N(zp) = n;
+    ccn_set(n, CCZP_PRIME(zp), p);
+    is(cczp_init(zp), CCERR_OK, "cczp_init() failed");
+
+    const cc_size k = 8;
+    cc_unit x[k * n];
+    cc_unit r[k * n];
+    cc_unit e[k * n];
+
+    // x = { 2, 3, ..., 8, p - 1 }
+    for (cc_size i = 0; i < k - 1; i++) {
+        ccn_seti(n, &x[i * n], (cc_unit)(i + 2));
+    }
+    ccn_sub1(n, &x[(k - 1) * n], p, 1);
+
+    for (cc_size i = 0; i < k; i++) {
+        is(cczp_inv(zp, &e[i * n], &x[i * n]), CCERR_OK, "cczp_inv failure");
+    }
+
+    is(cczp_inv_batch(zp, 1, r, x), CCERR_OK, "cczp_inv_batch failure");
+    ok_ccn_cmp(n, r, e, "cczp_inv_batch wrong result");
+
+    is(cczp_inv_batch(zp, k, r, x), CCERR_OK, "cczp_inv_batch failure");
+    ok_ccn_cmp(k * n, r, e, "cczp_inv_batch wrong result");
+
+    // In place.
+    is(cczp_inv_batch(zp, k, x, x), CCERR_OK, "cczp_inv_batch failure");
+    ok_ccn_cmp(k * n, x, e, "cczp_inv_batch wrong result in place");
+
+    // A single zero element makes the batch fail.
+    ccn_clear(n, &x[3 * n]);
+    isnt(cczp_inv_batch(zp, k, r, x), CCERR_OK, "cczp_inv_batch should have failed");
+}
+
 static void test_cczp_quadratic_residue(void)
 {
     CC_DECL_WORKSPACE_TEST(ws);
@@ -478,6 +515,7 @@ int cczp_tests(TM_UNUSED int argc, TM_UNUSED char *const *argv)
     num_tests += 3 * 4;                           // test_cczp_modn
     num_tests += 4;                               // test_cczp_mod
     num_tests += 11;                              // test_cczp_inv
+    num_tests += 16;                              // test_cczp_inv_batch
     num_tests += 4;                               // test_cczp_quadratic_residue
 
     plan_tests(num_tests);
@@ -509,6 +547,7 @@ int cczp_tests(TM_UNUSED int argc, TM_UNUSED char *const *argv)
     test_cczp_mod();
 
     test_cczp_inv();
+    test_cczp_inv_batch();
     test_cczp_quadratic_residue();
 
     return 0;
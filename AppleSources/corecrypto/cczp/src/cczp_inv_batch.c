@@ -0,0 +1,72 @@
+/* Copyright (c) (2023) Apple Inc. All rights reserved.
+ *
+ * corecrypto is licensed under Apple Inc.’s Internal Use License Agreement (which
+ * is contained in the License.txt file distributed with corecrypto) and only to
+ * people who accept that license. IMPORTANT:  Any license rights granted to you by
+ * Apple Inc. (if any) are limited to internal use within your organization only on
+ * devices and computers you own or control, for the sole purpose of verifying the
+ * security characteristics and correct functioning of the Apple Software.  You may
+ * not, directly or indirectly, redistribute the Apple Software or any portions thereof.
+ */
+
+#include "cc_internal.h"
+#include "cczp_internal.h"
+#include "cc_workspaces.h"
+#include "cc_macros.h"
+
+CC_PURE cc_size CCZP_INV_BATCH_WORKSPACE_N(cc_size n, cc_size k)
+{
+    return k * n + n + n +
+           CC_MAX_EVAL(CCZP_MUL_WORKSPACE_N(n), CCZP_INV_WORKSPACE_N(n));
+}
+
+int cczp_inv_batch_ws(cc_ws_t ws, cczp_const_t zp, cc_size k, cc_unit *r, const cc_unit *x)
+{
+    cc_size n = cczp_n(zp);
+    int rv = CCERR_PARAMETER;
+
+    cc_require_or_return(k > 0, rv);
+
+    CC_DECL_BP_WS(ws, bp);
+    cc_unit *prod = CC_ALLOC_WS(ws, k * n);
+    cc_unit *q = CC_ALLOC_WS(ws, n);
+    cc_unit *t = CC_ALLOC_WS(ws, n);
+
+    // prod[i] = x[0] * x[1] * ... * x[i]
+    ccn_set(n, prod, x);
+    for (cc_size i = 1; i < k; i++) {
+        cczp_mul_ws(ws, zp, &prod[i * n], &prod[(i - 1) * n], &x[i * n]);
+    }
+
+    // q = 1 / (x[0] * x[1] * ... * x[k-1])
+    rv = cczp_inv_ws(ws, zp, q, &prod[(k - 1) * n]);
+    cc_require(rv == CCERR_OK, errOut);
+
+    for (cc_size i = k - 1; i > 0; i--) {
+        // Save x[i], r and x may overlap.
+        ccn_set(n, t, &x[i * n]);
+
+        // r[i] = q * prod[i-1] = 1 / x[i]
+        cczp_mul_ws(ws, zp, &r[i * n], q, &prod[(i - 1) * n]);
+
+        // q = q * x[i] = 1 / (x[0] * ... * x[i-1])
+        cczp_mul_ws(ws, zp, q, q, t);
+    }
+
+    // q = 1 / x[0]
+    ccn_set(n, r, q);
+
+errOut:
+    CC_FREE_BP_WS(ws, bp);
+    return rv;
+}
+
+int cczp_inv_batch(cczp_const_t zp, cc_size k, cc_unit *r, const cc_unit *x)
+{
+    CC_ENSURE_DIT_ENABLED
+
+    CC_DECL_WORKSPACE_OR_FAIL(ws, CCZP_INV_BATCH_WORKSPACE_N(cczp_n(zp), k));
+    int rv = cczp_inv_batch_ws(ws, zp, k, r, x);
+    CC_FREE_WORKSPACE(ws);
+    return rv;
+}
@@ -17,6 +17,7 @@
 #include "cctime.h"
 #include "ccstats.h"
 #include <stdlib.h>
+#include <stdio.h>
 #include "cc_priv.h"
 
 /** RNG instance used for perf tests */
@@ -30,6 +31,16 @@ struct ccperf_test {
 
 /** perf family **/
 
+/** Statistics over the timed runs of one test, as returned by func (i.e. for all loops) */
+struct ccperf_stats {
+    double min;
+    double median;
+    double mad;    // Median absolute deviation from the median
+    double p90;
+    double p99;
+    double cycles; // Median cycle count, 0 when no cycle counter is available
+};
+
 enum ccperf_size_kind {
     ccperf_size_bytes = 0,
     ccperf_size_bits,
@@ -49,6 +60,7 @@ struct ccperf_family {
     enum ccperf_size_kind size_kind;
     size_t nruns;
     double run_time;
+    struct ccperf_stats stats;
     /// Pointer to function to teardown
     void (*teardown)(void);
 };
@@ -56,6 +68,34 @@ struct ccperf_family {
 // Stop iterating after reaching timeout
 #define RUN_TIMEOUT 10.0
 
+/** Measurement options, set from the command line */
+struct ccperf_options {
+    size_t nwarmup;    // Untimed runs before measuring
+    size_t nruns_max;  // Maximum number of timed runs
+};
+
+extern struct ccperf_options ccperf_options;
+
+/*
+ Perf functions are timed with perf_start()/perf_seconds(). In corecrypto_perf
+ these also read the CPU cycle counter (perf_event_open on Linux, otherwise
+ rdtsc on x86_64), the count for the last timed region is ccperf_cycles().
+ */
+uint64_t ccperf_start(void);
+double ccperf_seconds(uint64_t start);
+uint64_t ccperf_cycles(void);
+const char *ccperf_cycles_source(void);
+
+struct cc_executor;
+
+/** Executor running every work item on its own thread, for perf tests of parallel APIs */
+extern const struct cc_executor ccperf_executor;
+
+#undef perf_start
+#undef perf_seconds
+#define perf_start() uint64_t _perf_time = ccperf_start()
+#define perf_seconds() ccperf_seconds(_perf_time)
+
 /* Some macros used by family factories */
 
 #define F_ARGS(_f) _f##_perf_tests
@@ -149,6 +189,7 @@ struct ccperf_family *ccperf_family_ccxts_init(int argc, char *argv[]);
 struct ccperf_family *ccperf_family_ccxts_set_tweak(int argc, char *argv[]);
 struct ccperf_family *ccperf_family_ccxts_update(int argc, char *argv[]);
 struct ccperf_family *ccperf_family_ccxts_one_shot(int argc, char *argv[]);
+struct ccperf_family *ccperf_family_ccxts_sectors(int argc, char *argv[]);
 struct ccperf_family *ccperf_family_ccchacha_init(int argc, char *argv[]);
 struct ccperf_family *ccperf_family_ccchacha_update(int argc, char *argv[]);
 struct ccperf_family *ccperf_family_ccchacha_one_shot(int argc, char *argv[]);
@@ -161,16 +202,20 @@ struct ccperf_family *ccperf_family_ccsiv_init(int argc, char *argv[]);
 struct ccperf_family *ccperf_family_ccsiv_aad_or_nonce(int argc, char *argv[]);
 struct ccperf_family *ccperf_family_ccsiv_one_shot(int argc, char *argv[]);
 struct ccperf_family *ccperf_family_ccdigest(int argc, char *argv[]);
+struct ccperf_family *ccperf_family_ccdigest_mb(int argc, char *argv[]);
 struct ccperf_family *ccperf_family_cchmac(int argc, char *argv[]);
 struct ccperf_family *ccperf_family_ccn(int argc, char *argv[]);
 struct ccperf_family *ccperf_family_cczp(int argc, char *argv[]);
 struct ccperf_family *ccperf_family_ccec(int argc, char *argv[]);
+struct ccperf_family *ccperf_family_ccec_multi_mult(int argc, char *argv[]);
 struct ccperf_family *ccperf_family_ccec25519(int argc, char *argv[]);
+struct ccperf_family *ccperf_family_ccec25519_batch(int argc, char *argv[]);
 struct ccperf_family *ccperf_family_ccec448(int argc, char *argv[]);
 struct ccperf_family *ccperf_family_ccrsa(int argc, char *argv[]);
 struct ccperf_family *ccperf_family_ccrsabssa(int argc, char *argv[]);
 struct ccperf_family *ccperf_family_ccrsa_keygen(int argc, char *argv[]);
 struct ccperf_family *ccperf_family_ccpbkdf2(int argc, char *argv[]);
+struct ccperf_family *ccperf_family_ccpbkdf2_mb(int argc, char *argv[]);
 struct ccperf_family *ccperf_family_ccsrp(int argc, char *argv[]);
 struct ccperf_family *ccperf_family_ccansikdf(int argc, char *argv[]);
 struct ccperf_family *ccperf_family_cccmac(int argc, char *argv[]);
@@ -180,10 +225,14 @@ struct ccperf_family *ccperf_family_cckprng_init(int argc, char *argv[]);
 struct ccperf_family *ccperf_family_cckprng_generate(int argc, char *argv[]);
 struct ccperf_family *ccperf_family_cckprng_reseed(int argc, char *argv[]);
 struct ccperf_family *ccperf_family_cckprng_refresh(int argc, char *argv[]);
+struct ccperf_family *ccperf_family_cckprng_threads(int argc, char *argv[]);
 struct ccperf_family *ccperf_family_ccdh_generate_key(int argc, char *argv[]);
 struct ccperf_family *ccperf_family_ccdh_compute_shared_secret(int argc, char *argv[]);
 struct ccperf_family *ccperf_family_cczp_inv(int argc, char *argv[]);
+struct ccperf_family *ccperf_family_cczp_inv_batch(int argc, char *argv[]);
 struct ccperf_family *ccperf_family_ccscrypt(int argc, char *argv[]);
+struct ccperf_family *ccperf_family_ccscrypt_parallel(int argc, char *argv[]);
+struct ccperf_family *ccperf_family_ccder(int argc, char *argv[]);
 struct ccperf_family *ccperf_family_ccspake(int argc, char *argv[]);
 struct ccperf_family *ccperf_family_ccsae(int argc, char *argv[]);
 struct ccperf_family *ccperf_family_ccvrf(int argc, char *argv[]);
@@ -191,10 +240,12 @@ struct ccperf_family *ccperf_family_ccpolyzp_po2cyc(int argc, char *argv[]);
 struct ccperf_family *ccperf_family_cche_bfv(int argc, char *argv[]);
 struct ccperf_family *ccperf_family_cche_bgv(int argc, char *argv[]);
 struct ccperf_family *ccperf_family_ccprime(int argc, char *argv[]);
+struct ccperf_family *ccperf_family_ccprime_candidates(int argc, char *argv[]);
 struct ccperf_family *ccperf_family_cchpke(int argc, char *argv[]);
 struct ccperf_family *ccperf_family_cch2c(int argc, char *argv[]);
 struct ccperf_family *ccperf_family_cckeccak(int argc, char *argv[]);
 struct ccperf_family *ccperf_family_cckem(int argc, char *argv[]);
+struct ccperf_family *ccperf_family_cckyber_poly(int argc, char *argv[]);
 
 /* utility functions */
 
@@ -202,6 +253,27 @@ double histogram_sieve(struct ccperf_family *f, size_t *size, const void *arg);
 void ccperf_family_select(struct ccperf_family *f, size_t ntests, void *tests, size_t testsz, int argc, char **argv);
 int ccperf_main(int argc, char **argv);
 
+/* machine readable results */
+
+enum ccperf_report_format {
+    ccperf_report_json = 0,
+    ccperf_report_csv,
+};
+
+struct ccperf_report {
+    FILE *out;
+    enum ccperf_report_format format;
+    size_t nresults;
+};
+
+void ccperf_report_begin(struct ccperf_report *report);
+void ccperf_report_result(struct ccperf_report *report, const struct ccperf_family *f, size_t size,
+                          const struct ccperf_test *test, double noop_time, double noop_cycles);
+void ccperf_report_end(struct ccperf_report *report);
+
+/** Compares two result files (JSON or CSV), returns the number of regressions or -1 on error. */
+int ccperf_compare(const char *old_path, const char *new_path, double threshold_percent);
+
 /* in place so we can compare algorithms */
 /* Max is greater than 16KB to trigger HW AES when available */
 static const size_t symmetric_crypto_data_nbytes[]={16,256,8*1024,24*1024};
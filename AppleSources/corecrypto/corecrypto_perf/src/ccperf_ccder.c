@@ -0,0 +1,271 @@
+/* Copyright (c) (2023) Apple Inc. All rights reserved.
+ *
+ * corecrypto is licensed under Apple Inc.’s Internal Use License Agreement (which
+ * is contained in the License.txt file distributed with corecrypto) and only to
+ * people who accept that license. IMPORTANT:  Any license rights granted to you by
+ * Apple Inc. (if any) are limited to internal use within your organization only on
+ * devices and computers you own or control, for the sole purpose of verifying the
+ * security characteristics and correct functioning of the Apple Software.  You may
+ * not, directly or indirectly, redistribute the Apple Software or any portions thereof.
+ */
+
+#include "ccperf.h"
+#include <corecrypto/ccder.h>
+#include <corecrypto/ccder_cursor.h>
+#include "testbyteBuffer.h"
+
+/* Corpus: root certificates (RSA 4096, RSA 2048 and ECDSA P-384) from the
+ Mozilla trust store, concatenated. Each test parses the whole corpus once. */
+static const char *ccder_perf_corpus_hex[] = {
+// ISRG_Root_X1
+    "3082056b30820353a0030201020211008210cfb0d240e3594463e0bb63828b00300d06092a864886f70d01010b0500304f310b300906035504061302"
+    "555331293027060355040a1320496e7465726e65742053656375726974792052657365617263682047726f7570311530130603550403130c49535247"
+    "20526f6f74205831301e170d3135303630343131303433385a170d3335303630343131303433385a304f310b30090603550406130255533129302706"
+    "0355040a1320496e7465726e65742053656375726974792052657365617263682047726f7570311530130603550403130c4953524720526f6f742058"
+    "3130820222300d06092a864886f70d01010105000382020f003082020a0282020100ade82473f41437f39b9e2b57281c87bedcb7df38908c6e3ce657"
+    "a078f775c2a2fef56a6ef6004f28dbde68866c4493b6b163fd14126bbf1fd2ea319b217ed1333cba48f5dd79dfb3b8ff12f1219a4bc18a8671694a66"
+    "666c8f7e3c70bfad292206f3e4c0e680aee24b8fb7997e94039fd347977c99482353e838ae4f0a6f832ed149578c8074b6da2fd0388d7b0370211b75"
+    "f2303cfa8faeddda63abeb164fc28e114b7ecf0be8ffb5772ef4b27b4ae04c12250c708d0329a0e15324ec13d9ee19bf10b34a8c3f89a36151deac87"
+    "0794f46371ec2ee26f5b9881e1895c34796c76ef3b906279e6dba49a2f26c5d010e10eded9108e16fbb7f7a8f7c7e50207988f360895e7e237960d36"
+    "759efb0e72b11d9bbc03f94905d881dd05b42ad641e9ac0176950a0fd8dfd5bd121f352f28176cd298c1a80964776e4737baceac595e689d7f72d689"
+    "c50641293e593edd26f524c911a75aa34c401f46a199b5a73a516e863b9e7d72a712057859ed3e5178150b038f8dd02f05b23e7b4a1c4b730512fcc6"
+    "eae050137c439374b3ca74e78e1f0108d030d45b7136b407bac130305c48b7823b98a67d608aa2a32982ccbabd83041ba2830341a1d605f11bc2b6f0"
+    "a87c863b46a8482a88dc769a76bf1f6aa53d198feb38f364dec82b0d0a28fff7dbe21542d422d0275de179fe18e77088ad4ee6d98b3ac6dd27516eff"
+    "bc64f533434f0203010001a3423040300e0603551d0f0101ff040403020106300f0603551d130101ff040530030101ff301d0603551d0e0416041479"
+    "b459e67bb6e5e40173800888c81a58f6e99b6e300d06092a864886f70d01010b05000382020100551f58a9bcb2a850d00cb1d81a6920272908ac6175"
+    "5c8a6ef882e5692fd5f6564bb9b8731059d321977ee74c71fbb2d260ad39a80bea17215685f1500e59ebcee059e9bac915ef869d8f8480f6e4e99190"
+    "dc179b621b45f06695d27c6fc2ea3bef1fcfcbd6ae27f1a9b0c8aefd7d7e9afa2204ebffd97fea912b22b1170e8ff28a345b58d8fc01c954b9b826cc"
+    "8a8833894c2d843c82dfee965705ba2cbbf7c4b7c74e3b82be31c822737392d1c280a43939103323824c3c9f86b255981dbe29868c229b9ee26b3b57"
+    "3a82704ddc09c789cb0a074d6ce85d8ec9efceabc7bbb52b4e45d64ad026cce572ca086aa595e315a1f7a4edc92c5fa5fbffac28022ebed77bbbe371"
+    "7b9016d3075e46537c3707428cd3c4969cd599b52ae0951a8048ae4c3907cecc47a452952bbab8fbadd233537de51d4d6dd5a1b1c7426fe64027355c"
+    "a328b7078de78d3390e7239ffb509c796c46d5b415b3966e7e9b0c963ab8522d3fd65be1fb08c284fe24a8a389daac6ae1182ab1a843615bd31fdc3b"
+    "8d76f22de88d75df17336c3d53fb7bcb415fffdca2d06138e196b8ac5d8b37d775d533c09911ae9d41c1727584be0241425f67244894d19b27be073f"
+    "b9b84f817451e17ab7ed9d23e2bee0d52804133c31039edd7a6c8fc60718c67fde478e3f289e0406cfa5543477bdec899be91743df5bdb5ffe8e1e57"
+    "a2cd409d7e6222dade1827"    ,
+// ISRG_Root_X2
+    "3082021b308201a1a003020102021041d29dd172eaeea780c12c6ce92f8752300a06082a8648ce3d040303304f310b30090603550406130255533129"
+    "3027060355040a1320496e7465726e65742053656375726974792052657365617263682047726f7570311530130603550403130c4953524720526f6f"
+    "74205832301e170d3230303930343030303030305a170d3430303931373136303030305a304f310b300906035504061302555331293027060355040a"
+    "1320496e7465726e65742053656375726974792052657365617263682047726f7570311530130603550403130c4953524720526f6f74205832307630"
+    "1006072a8648ce3d020106052b8104002203620004cd9bd59f80830aec094af3164a3e5ccf77acde67050d1d07b6dc16fb5a8b14dbe27160c4ba4595"
+    "11898eea06dff72a161ca4b9c5c532e003e01e8218388bd745d80a6a6ee60077fb02517d22d80a6e9a5b77dff0fa41ec39dc75ca68070c1feaa34230"
+    "40300e0603551d0f0101ff040403020106300f0603551d130101ff040530030101ff301d0603551d0e041604147c4296aede4b483bfa92f89e8ccf6d"
+    "8ba9723795300a06082a8648ce3d040303036800306502307b794e465084c24487461b4570ff5899def4fda4d255a6202d74d634bc41a3505f012756"
+    "b4be277506af122e75988dfc0231008bf5776cd4c865aae00b2cee149d2737a4f953a551e42983d7f890315b429f0af5feae0068e78c490fb66f5b5b"
+    "15f2e7"    ,
+// DigiCert_Global_Root_G2
+    "3082038e30820276a0030201020210033af1e6a711a9a0bb2864b11d09fae5300d06092a864886f70d01010b05003061310b30090603550406130255"
+    "5331153013060355040a130c446967694365727420496e6331193017060355040b13107777772e64696769636572742e636f6d3120301e0603550403"
+    "1317446967694365727420476c6f62616c20526f6f74204732301e170d3133303830313132303030305a170d3338303131353132303030305a306131"
+    "0b300906035504061302555331153013060355040a130c446967694365727420496e6331193017060355040b13107777772e64696769636572742e63"
+    "6f6d3120301e06035504031317446967694365727420476c6f62616c20526f6f7420473230820122300d06092a864886f70d01010105000382010f00"
+    "3082010a0282010100bb37cd34dc7b6bc9b26890ad4a75ff46ba210a088df51954c9fb88dbf3aef23a89913c7ae6ab061a6bcfac2de85e092444ba62"
+    "9a7ed6a3a87ee054752005ac50b79c631a6c30dcda1f19b1d71edefdd7e0cb948337aeec1f434edd7b2cd2bd2ea52fe4a9b8ad3ad499a4b625e99b6b"
+    "00609260ff4f214918f76790ab61069c8ff2bae9b4e992326bb5f357e85d1bcd8c1dab95049549f3352d96e3496ddd77e3fb494bb4ac5507a98f95b3"
+    "b423bb4c6d45f0f6a9b29530b4fd4c558c274a57147c829dcd7392d3164a060c8c50d18f1e09be17a1e621cafd83e510bc83a50ac46728f67314143d"
+    "4676c387148921344daf0f450ca649a1babb9cc5b1338329850203010001a3423040300f0603551d130101ff040530030101ff300e0603551d0f0101"
+    "ff040403020186301d0603551d0e041604144e2254201895e6e36ee60ffafab912ed06178f39300d06092a864886f70d01010b050003820101006067"
+    "28946f0e4863eb31ddea6718d5897d3cc58b4a7fe9bedb2b17dfb05f73772a3213398167428423f2456735ec88bff88fb0610c34a4ae204c84c6dbf8"
+    "35e176d9dfa642bbc74408867f3674245ada6c0d145935bdf249ddb61fc9b30d472a3d992fbb5cbbb5d420e1995f534615db689bf0f330d53e31e28d"
+    "849ee38adada963e3513a55ff0f970507047411157194ec08fae06c49513172f1b259f75f2b18e99a16f13b14171fe882ac84f102055d7f31445e5e0"
+    "44f4ea879532930efe5346fa2c9dff8b22b94bd90945a4dea4b89a58dd1b7d529f8e59438881a49e26d56faddd0dc6377ded03921be5775f76ee3c8d"
+    "c45d565ba2d9666eb33537e532b6"    ,
+// Amazon_Root_CA_1
+    "3082034130820229a0030201020213066c9fcf99bf8c0a39e2f0788a43e696365bca300d06092a864886f70d01010b05003039310b30090603550406"
+    "13025553310f300d060355040a1306416d617a6f6e3119301706035504031310416d617a6f6e20526f6f742043412031301e170d3135303532363030"
+    "303030305a170d3338303131373030303030305a3039310b3009060355040613025553310f300d060355040a1306416d617a6f6e3119301706035504"
+    "031310416d617a6f6e20526f6f74204341203130820122300d06092a864886f70d01010105000382010f003082010a0282010100b2788071ca78d5e3"
+    "71af478050747d6ed8d78876f49968f7582160f97484012fac022d86d3a0437a4eb2a4d036ba01be8ddb48c80717364cf4ee8823c73eeb37f5b519f8"
+    "4968b0ded7b976381d619ea4fe8236a5e54a56e445e1f9fdb416fa74da9c9b35392ffab02050066c7ad080b2a6f9afec47198f503807dca2873958f8"
+    "bad5a9f948673096ee94785e6f89a351c0308666a14566ba54eba3c391f948dcffd1e8302d7d2d747035d78824f79ec4596ebb738717f2324628b843"
+    "fab71daacab4f29f240e2d4bf7715c5e69ffea9502cb388aae50386fdbfb2d621bc5c71e54e177e067c80f9c8723d63f40207f2080c4804c3e3b2426"
+    "8e04ae6c9ac8aa0d0203010001a3423040300f0603551d130101ff040530030101ff300e0603551d0f0101ff040403020186301d0603551d0e041604"
+    "148418cc8534ecbc0c94942e08599cc7b2104e0a08300d06092a864886f70d01010b0500038201010098f2375a4190a11ac57651282036230eaee628"
+    "bbaaf894ae48a4307f1bfc248d4bb4c8a197f6b6f17a70c85393cc0828e39825cf23a4f9de21d37c8509ad4e9a753ac20b6a897876444718656c8d41"
+    "8e3b7f9acbf4b5a750d7052c37e8034bade961a0026ef5f2f0c5b2ed5bb7dcfa945c779e13a57f52ad95f2f8933bde8b5c5bca5a525b60af14f74bef"
+    "a3fb9f40956d3154fc42d3c7461f23add90f48709ad9757871d1724334756e5759c2025c266029cf2319168e8843a5d4e4cb08fb231143e843297262"
+    "a1a95d5e08d490aeb8d8ce14c2d055f286f6c49343776661c0b9e841d7977860036e4a72aea5d17dba109e866c1b8ab95933f8ebc490bef1b9"    ,
+// GTS_Root_R4
+    "308202093082018ea003020102020d0203e5c068ef631a9c72905052300a06082a8648ce3d0403033047310b30090603550406130255533122302006"
+    "0355040a1319476f6f676c65205472757374205365727669636573204c4c43311430120603550403130b47545320526f6f74205234301e170d313630"
+    "3632323030303030305a170d3336303632323030303030305a3047310b300906035504061302555331223020060355040a1319476f6f676c65205472"
+    "757374205365727669636573204c4c43311430120603550403130b47545320526f6f742052343076301006072a8648ce3d020106052b810400220362"
+    "0004f37473a7688b60ae43b835c581307b4b499dfbc161cee6de46bd6bd5611835ae40dd73f78991305aeb3cee857ca240763ba9c6b847d82ae79291"
+    "6a73e9b172399f299fa298d35f5e5886650fa1846506d1dc8bc9c773c88c6a2fe5c4abd11d8aa3423040300e0603551d0f0101ff040403020186300f"
+    "0603551d130101ff040530030101ff301d0603551d0e04160414804cd6eb74ff4936a3d5d8fcb53ec56af0941d8c300a06082a8648ce3d0403030369"
+    "003066023100e840ff83de03f49fae1d7aa72eb9af4ff6831d0e2d85011dd1d96aec0fc2afc75e565e5cd51c5822280bf730b62fb17c023100f0613c"
+    "a7f4a082e321d5841d73869c2dafca349bf19fb92336e2bc60039d80b39a56c8e1e2bb1479cacd21d494b54943"
+};
+
+static uint8_t *ccder_perf_corpus;
+static size_t ccder_perf_corpus_size;
+
+#define CCDER_PERF_MAX_ELEMENTS 1024
+
+static ccder_index_entry ccder_perf_entries[CCDER_PERF_MAX_ELEMENTS];
+
+// Eager walk with ccder_blob_decode_tag/len, descending into every constructed element.
+static size_t ccder_perf_blob_walk(ccder_read_blob blob)
+{
+    size_t n = 0;
+
+    while (blob.der < blob.der_end) {
+        ccder_tag tag;
+        size_t len;
+
+        if (!ccder_blob_decode_tag(&blob, &tag) || !ccder_blob_decode_len(&blob, &len)) {
+            abort();
+        }
+        if (tag & CCDER_CONSTRUCTED) {
+            n += ccder_perf_blob_walk((ccder_read_blob){ blob.der, blob.der + len });
+        }
+        blob.der += len;
+        n++;
+    }
+
+    return n;
+}
+
+// Certificate serial number, validity, subject and public key, with the range decoders.
+static size_t ccder_perf_blob_fields(ccder_read_blob blob)
+{
+    size_t n = 0;
+
+    while (blob.der < blob.der_end) {
+        ccder_read_blob cert, tbs, field;
+
+        if (!ccder_blob_decode_sequence_tl(&blob, &cert) ||
+            !ccder_blob_decode_sequence_tl(&cert, &tbs) ||
+            !ccder_blob_decode_range(&tbs, CCDER_CONSTRUCTED | CCDER_CONTEXT_SPECIFIC | 0, &field) ||
+            !ccder_blob_decode_range(&tbs, CCDER_INTEGER, &field) ||
+            !ccder_blob_decode_sequence_tl(&tbs, &field) ||  // signature
+            !ccder_blob_decode_sequence_tl(&tbs, &field) ||  // issuer
+            !ccder_blob_decode_sequence_tl(&tbs, &field) ||  // validity
+            !ccder_blob_decode_sequence_tl(&tbs, &field) ||  // subject
+            !ccder_blob_decode_sequence_tl(&tbs, &field)) {  // subjectPublicKeyInfo
+            abort();
+        }
+        n++;
+    }
+
+    return n;
+}
+
+// Same fields with the cursor, skipping subtrees without decoding them.
+static size_t ccder_perf_cursor_fields(size_t size, const uint8_t *der)
+{
+    ccder_cursor cursor;
+    ccder_read_blob field;
+    size_t n = 0;
+
+    ccder_cursor_init(&cursor, size, der, true);
+    while (ccder_cursor_next(&cursor, NULL) == CCDER_CURSOR_OK) {
+        if (ccder_cursor_enter(&cursor) != CCDER_CURSOR_OK ||
+            ccder_cursor_next(&cursor, NULL) != CCDER_CURSOR_OK ||  // tbsCertificate
+            ccder_cursor_enter(&cursor) != CCDER_CURSOR_OK ||
+            ccder_cursor_next(&cursor, NULL) != CCDER_CURSOR_OK ||  // version
+            ccder_cursor_next(&cursor, NULL) != CCDER_CURSOR_OK ||  // serialNumber
+            ccder_cursor_body(&cursor, &field) != CCDER_CURSOR_OK ||
+            ccder_cursor_next(&cursor, NULL) != CCDER_CURSOR_OK ||  // signature
+            ccder_cursor_next(&cursor, NULL) != CCDER_CURSOR_OK ||  // issuer
+            ccder_cursor_next(&cursor, NULL) != CCDER_CURSOR_OK ||  // validity
+            ccder_cursor_body(&cursor, &field) != CCDER_CURSOR_OK ||
+            ccder_cursor_next(&cursor, NULL) != CCDER_CURSOR_OK ||  // subject
+            ccder_cursor_body(&cursor, &field) != CCDER_CURSOR_OK ||
+            ccder_cursor_next(&cursor, NULL) != CCDER_CURSOR_OK ||  // subjectPublicKeyInfo
+            ccder_cursor_element(&cursor, &field) != CCDER_CURSOR_OK ||
+            ccder_cursor_leave(&cursor) != CCDER_CURSOR_OK ||
+            ccder_cursor_leave(&cursor) != CCDER_CURSOR_OK) {
+            abort();
+        }
+        n++;
+    }
+
+    return n;
+}
+
+static double perf_ccder_blob_walk(size_t loops)
+{
+    ccder_read_blob blob = { ccder_perf_corpus, ccder_perf_corpus + ccder_perf_corpus_size };
+
+    perf_start();
+    do {
+        if (ccder_perf_blob_walk(blob) == 0) {
+            abort();
+        }
+    } while (--loops != 0);
+    return perf_seconds();
+}
+
+static double perf_ccder_index(size_t loops)
+{
+    perf_start();
+    do {
+        size_t n = CCDER_PERF_MAX_ELEMENTS;
+        if (ccder_index(ccder_perf_corpus_size, ccder_perf_corpus, &n, ccder_perf_entries)) {
+            abort();
+        }
+    } while (--loops != 0);
+    return perf_seconds();
+}
+
+static double perf_ccder_blob_fields(size_t loops)
+{
+    ccder_read_blob blob = { ccder_perf_corpus, ccder_perf_corpus + ccder_perf_corpus_size };
+
+    perf_start();
+    do {
+        if (ccder_perf_blob_fields(blob) != CC_ARRAY_LEN(ccder_perf_corpus_hex)) {
+            abort();
+        }
+    } while (--loops != 0);
+    return perf_seconds();
+}
+
+static double perf_ccder_cursor_fields(size_t loops)
+{
+    perf_start();
+    do {
+        if (ccder_perf_cursor_fields(ccder_perf_corpus_size, ccder_perf_corpus) != CC_ARRAY_LEN(ccder_perf_corpus_hex)) {
+            abort();
+        }
+    } while (--loops != 0);
+    return perf_seconds();
+}
+
+#define _TEST(_x) { .name = #_x, .func = perf_ ## _x}
+static struct ccder_perf_test {
+    const char *name;
+    double(*func)(size_t loops);
+} ccder_perf_tests[] = {
+    _TEST(ccder_blob_walk),
+    _TEST(ccder_index),
+    _TEST(ccder_blob_fields),
+    _TEST(ccder_cursor_fields),
+};
+
+static double perf_ccder(size_t loops, size_t *psize CC_UNUSED, const void *arg)
+{
+    const struct ccder_perf_test *test=arg;
+    return test->func(loops);
+}
+
+static struct ccperf_family family;
+
+struct ccperf_family *ccperf_family_ccder(int argc, char *argv[])
+{
+    if (ccder_perf_corpus == NULL) {
+        for (size_t i = 0; i < CC_ARRAY_LEN(ccder_perf_corpus_hex); i++) {
+            byteBuffer der = hexStringToBytes(ccder_perf_corpus_hex[i]);
+            ccder_perf_corpus = realloc(ccder_perf_corpus, ccder_perf_corpus_size + der->len);
+            memcpy(ccder_perf_corpus + ccder_perf_corpus_size, der->bytes, der->len);
+            ccder_perf_corpus_size += der->len;
+            free(der);
+        }
+    }
+
+    F_GET_ALL(family, ccder);
+    F_SIZE(family, ccder_perf_corpus_size);
+    family.size_kind=ccperf_size_bytes;
+    return &family;
+}
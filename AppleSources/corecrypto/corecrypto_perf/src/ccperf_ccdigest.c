@@ -16,6 +16,7 @@
 #include <corecrypto/ccmd2.h>
 #include <corecrypto/ccmd4.h>
 #include <corecrypto/ccmd5.h>
+#include "ccsha2_internal.h"
 #include "ccsha3_internal.h"
 
 #define CCDIGEST_TEST(_di) { .name=#_di, .di=&_di }
@@ -99,3 +100,84 @@ struct ccperf_family *ccperf_family_ccdigest(int argc, char *argv[])
     family.size_kind=ccperf_size_bytes;
     return &family;
 }
+
+#define CCDIGEST_MB_serial false
+#define CCDIGEST_MB_mb true
+#define CCDIGEST_MB_TEST(_hash, _n, _mode) { .name=#_hash "_x" #_n "_" #_mode, .di=_hash##_di, .nmessages=_n, .mb=CCDIGEST_MB_##_mode }
+
+static struct ccdigest_mb_perf_test {
+    const char *name;
+    const struct ccdigest_info *(*di)(void);
+    size_t nmessages;
+    bool mb;
+} ccdigest_mb_perf_tests[] = {
+    CCDIGEST_MB_TEST(ccsha256, 1, serial),
+    CCDIGEST_MB_TEST(ccsha256, 4, mb),
+    CCDIGEST_MB_TEST(ccsha256, 16, serial),
+    CCDIGEST_MB_TEST(ccsha256, 16, mb),
+    CCDIGEST_MB_TEST(ccsha256, 64, mb),
+    CCDIGEST_MB_TEST(ccsha256, 256, serial),
+    CCDIGEST_MB_TEST(ccsha256, 256, mb),
+    CCDIGEST_MB_TEST(ccsha512, 1, serial),
+    CCDIGEST_MB_TEST(ccsha512, 4, mb),
+    CCDIGEST_MB_TEST(ccsha512, 16, serial),
+    CCDIGEST_MB_TEST(ccsha512, 16, mb),
+    CCDIGEST_MB_TEST(ccsha512, 64, mb),
+    CCDIGEST_MB_TEST(ccsha512, 256, serial),
+    CCDIGEST_MB_TEST(ccsha512, 256, mb),
+};
+
+// Report the time per message so that throughput is aggregated over all lanes.
+static double perf_ccdigest_mb(size_t loops, size_t *psize, const void *arg)
+{
+    const struct ccdigest_mb_perf_test *test = arg;
+    const struct ccdigest_info *di = test->di();
+    size_t n = test->nmessages;
+
+    uint8_t *data = malloc(n * *psize);
+    uint8_t *digests = malloc(n * di->output_size);
+    size_t *lens = malloc(n * sizeof(lens[0]));
+    const void **ptrs = malloc(n * sizeof(ptrs[0]));
+    void **outs = malloc(n * sizeof(outs[0]));
+
+    ccrng_generate(rng, n * *psize, data);
+    for (size_t i = 0; i < n; i++) {
+        lens[i] = *psize;
+        ptrs[i] = data + i * *psize;
+        outs[i] = digests + i * di->output_size;
+    }
+
+    perf_start();
+    do {
+        if (test->mb) {
+            int rv = ccsha2_mb(di, n, lens, ptrs, outs);
+            if (rv) {
+                abort();
+            }
+        } else {
+            for (size_t i = 0; i < n; i++) {
+                ccdigest(di, lens[i], ptrs[i], outs[i]);
+            }
+        }
+    } while (--loops != 0);
+
+    double seconds = perf_seconds();
+    free(outs);
+    free(ptrs);
+    free(lens);
+    free(digests);
+    free(data);
+    return seconds / (double)n;
+}
+
+static struct ccperf_family ccdigest_mb_family;
+
+static const size_t ccdigest_mb_sizes[] = { 16, 64, 256, 1024, 8 * 1024 };
+
+struct ccperf_family *ccperf_family_ccdigest_mb(int argc, char *argv[])
+{
+    F_GET_ALL(ccdigest_mb_family, ccdigest_mb);
+    F_SIZES_FROM_ARRAY(ccdigest_mb_family, ccdigest_mb_sizes);
+    ccdigest_mb_family.size_kind = ccperf_size_bytes;
+    return &ccdigest_mb_family;
+}
@@ -356,6 +356,46 @@ static double perf_ccec_full_add(size_t loops, ccec_const_cp_t cp)
     return perf_seconds();
 }
 
+static double perf_ccec_mult_base_all(size_t loops, ccec_const_cp_t cp, bool tables)
+{
+    cc_size n = ccec_cp_n(cp);
+    int status;
+
+    CC_DECL_WORKSPACE_TEST(ws);
+    cc_unit *d = CC_ALLOC_WS(ws, n);
+    ccec_projective_point *G = CCEC_ALLOC_POINT_WS(ws, n);
+    ccec_projective_point *r = CCEC_ALLOC_POINT_WS(ws, n);
+
+    status = ccec_generate_scalar_fips_retry_ws(ws, cp, rng, d);
+    if (status) cc_abort("Failure in ccec_generate_scalar_fips_retry");
+
+    perf_start();
+    while (loops--) {
+        status = ccec_projectify_ws(ws, cp, G, ccec_cp_g(cp), rng);
+        if (tables) {
+            status |= ccec_mult_base_ws(ws, cp, r, d, G, rng);
+        } else {
+            // What ccec_mult_base_ws() replaced.
+            status |= ccec_mult_blinded_ws(ws, cp, r, d, G, rng);
+        }
+        if (status) cc_abort("Failure in ccec_mult_base");
+    }
+    double total_time = perf_seconds();
+
+    CC_FREE_WORKSPACE(ws);
+    return total_time;
+}
+
+static double perf_ccec_mult_base(size_t loops, ccec_const_cp_t cp)
+{
+    return perf_ccec_mult_base_all(loops, cp, true);
+}
+
+static double perf_ccec_mult_blinded_base(size_t loops, ccec_const_cp_t cp)
+{
+    return perf_ccec_mult_base_all(loops, cp, false);
+}
+
 #define _TEST(_x) { .name = #_x, .func = perf_ ## _x}
 static struct ccec_perf_test {
     const char *name;
@@ -378,6 +418,8 @@ static struct ccec_perf_test {
     _TEST(ccec_affinify),
     _TEST(ccec_affinify_100_points),
     _TEST(ccec_full_add),
+    _TEST(ccec_mult_base),
+    _TEST(ccec_mult_blinded_base),
 };
 
 static double perf_ccec(size_t loops, size_t *pnbits, const void *arg)
@@ -398,3 +440,82 @@ struct ccperf_family *ccperf_family_ccec(int argc, char *argv[])
     family.size_kind=ccperf_size_bits;
     return &family;
 }
+
+/* Multi-scalar multiplication: the size is the number of points */
+
+static double perf_ccec_multi_mult_all(size_t loops, size_t npoints, ccec_const_cp_t cp, bool multi)
+{
+    cc_size n = ccec_cp_n(cp);
+    ccec_projective_point_t *points = malloc(npoints * sizeof(ccec_projective_point_t));
+    cc_unit *d = malloc(ccn_sizeof_n(npoints * n));
+
+    if (!points || !d) {
+        cc_abort("Allocation failure");
+    }
+
+    CC_DECL_WORKSPACE_TEST(ws);
+    ccec_full_ctx_t key = CCEC_ALLOC_FULL_WS(ws, n);
+    ccec_projective_point *r = CCEC_ALLOC_POINT_WS(ws, n);
+    ccec_projective_point *t = CCEC_ALLOC_POINT_WS(ws, n);
+
+    int status = CCERR_OK;
+    for (size_t i = 0; i < npoints; i++) {
+        points[i] = CCEC_ALLOC_POINT_WS(ws, n);
+        status |= ccec_generate_key_internal_fips_ws(ws, cp, rng, key);
+        status |= ccec_projectify_ws(ws, cp, points[i], (ccec_const_affine_point_t)ccec_ctx_point(key), rng);
+        status |= ccec_generate_scalar_fips_retry_ws(ws, cp, rng, &d[i * n]);
+    }
+    if (status) cc_abort("Failure in ccec_generate_key_internal_fips or ccec_projectify");
+    ccn_set(3 * n, ccec_point_x(r, cp), ccec_point_x(points[0], cp));
+
+    perf_start();
+    do {
+        if (multi) {
+            status = ccec_multi_mult_ws(ws, cp, r, npoints, d, points);
+            if (status) cc_abort("Failure in ccec_multi_mult");
+        } else {
+            for (size_t i = 0; i < npoints; i++) {
+                status = ccec_mult_ws(ws, cp, t, &d[i * n], ccec_cp_order_bitlen(cp), points[i]);
+                if (status) cc_abort("Failure in ccec_mult");
+                ccec_full_add_ws(ws, cp, r, r, t);
+            }
+        }
+    } while (--loops != 0);
+    double time = perf_seconds();
+
+    CC_FREE_WORKSPACE(ws);
+    free(points);
+    free(d);
+    return time;
+}
+
+#define _MMTEST(_x, _cp, _multi) { .name = #_x, .cp = _cp, .multi = _multi }
+static struct ccec_multi_mult_perf_test {
+    const char *name;
+    ccec_const_cp_t (*cp)(void);
+    bool multi;
+} ccec_multi_mult_perf_tests[] = {
+    _MMTEST(ccec_multi_mult_p256, ccec_cp_256, true),
+    _MMTEST(ccec_mult_each_p256, ccec_cp_256, false),
+    _MMTEST(ccec_multi_mult_p384, ccec_cp_384, true),
+    _MMTEST(ccec_mult_each_p384, ccec_cp_384, false),
+    _MMTEST(ccec_multi_mult_p521, ccec_cp_521, true),
+    _MMTEST(ccec_mult_each_p521, ccec_cp_521, false),
+};
+
+static double perf_ccec_multi_mult(size_t loops, size_t *psize, const void *arg)
+{
+    const struct ccec_multi_mult_perf_test *test = arg;
+    return perf_ccec_multi_mult_all(loops, *psize, test->cp(), test->multi);
+}
+
+static struct ccperf_family multi_mult_family;
+
+struct ccperf_family *ccperf_family_ccec_multi_mult(int argc, char *argv[])
+{
+    F_GET_ALL(multi_mult_family, ccec_multi_mult);
+    static const size_t sizes[] = { 2, 4, 8, 16, 32, 64, 128, 256, 512, 1024, 2048, 4096 };
+    F_SIZES_FROM_ARRAY(multi_mult_family, sizes);
+    multi_mult_family.size_kind = ccperf_size_units;
+    return &multi_mult_family;
+}
@@ -127,3 +127,84 @@ struct ccperf_family *ccperf_family_ccec25519(int argc, char *argv[])
     family.size_kind=ccperf_size_bits;
     return &family;
 }
+
+/* Batch verification: the size is the number of signatures per batch */
+
+static double perf_cced25519_verify_batch_all(size_t loops, size_t nsigs, const struct ccdigest_info *di, bool batch)
+{
+    ccec25519secretkey sk;
+    ccec25519pubkey *pks = malloc(nsigs * sizeof(ccec25519pubkey));
+    ccec25519signature *sigs = malloc(nsigs * sizeof(ccec25519signature));
+    uint8_t *msgs = malloc(nsigs * 32);
+    const void **msg_ptrs = malloc(nsigs * sizeof(void *));
+    size_t *msg_nbytes = malloc(nsigs * sizeof(size_t));
+    int *results = malloc(nsigs * sizeof(int));
+
+    if (!pks || !sigs || !msgs || !msg_ptrs || !msg_nbytes || !results) {
+        cc_abort("Allocation failure");
+    }
+
+    for (size_t i = 0; i < nsigs; i++) {
+        cced25519_make_key_pair(di, rng, pks[i], sk);
+        ccrng_generate(rng, 32, &msgs[32 * i]);
+        msg_ptrs[i] = &msgs[32 * i];
+        msg_nbytes[i] = 32;
+
+        int status = cced25519_sign(di, sigs[i], msg_nbytes[i], msg_ptrs[i], pks[i], sk);
+        if (status) cc_abort("Failure in cced25519_sign");
+    }
+
+    perf_start();
+    do {
+        if (batch) {
+            int status = cced25519_verify_batch(di, rng, nsigs, msg_nbytes, msg_ptrs, sigs, pks, results);
+            if (status) cc_abort("Failure in cced25519_verify_batch");
+        } else {
+            for (size_t i = 0; i < nsigs; i++) {
+                int status = cced25519_verify(di, msg_nbytes[i], msg_ptrs[i], sigs[i], pks[i]);
+                if (status) cc_abort("Failure in cced25519_verify");
+            }
+        }
+    } while (--loops != 0);
+    double t = perf_seconds();
+
+    free(pks);
+    free(sigs);
+    free(msgs);
+    free(msg_ptrs);
+    free(msg_nbytes);
+    free(results);
+    return t;
+}
+
+static double perf_cced25519_verify_batch(size_t loops, size_t *psize, const struct ccdigest_info *di)
+{
+    return perf_cced25519_verify_batch_all(loops, *psize, di, true);
+}
+
+static double perf_cced25519_verify_each(size_t loops, size_t *psize, const struct ccdigest_info *di)
+{
+    return perf_cced25519_verify_batch_all(loops, *psize, di, false);
+}
+
+static struct ccec25519_perf_test ccec25519_batch_perf_tests[] = {
+    _TEST(cced25519_verify_batch,ccsha512_ltc_di),
+    _TEST(cced25519_verify_each,ccsha512_ltc_di),
+};
+
+static double perf_ccec25519_batch(size_t loops, size_t *psize, const void *arg)
+{
+    const struct ccec25519_perf_test *test=arg;
+    return test->func(loops, psize, test->di);
+}
+
+static struct ccperf_family batch_family;
+
+struct ccperf_family *ccperf_family_ccec25519_batch(int argc, char *argv[])
+{
+    F_GET_ALL(batch_family, ccec25519_batch);
+    static const size_t batch_sizes[] = { 1, 2, 4, 8, 16, 32, 64, 128, 256, 512, 1024 };
+    F_SIZES_FROM_ARRAY(batch_family, batch_sizes);
+    batch_family.size_kind = ccperf_size_units;
+    return &batch_family;
+}
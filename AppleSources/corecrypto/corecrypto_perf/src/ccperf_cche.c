@@ -554,6 +554,30 @@ static double perf_cche_ciphertext_coeff_dcrt_plaintext_mul(size_t loops, uint32
     return perf_res;
 }
 
+static double perf_cche_ciphertext_apply_galois(size_t loops, uint32_t degree, cche_scheme_t he_scheme)
+{
+    cche_predefined_encryption_params_t encrypt_params = perf_get_params(degree);
+    cche_perf_common_t perf_setup = perf_get_common_setup(degree, he_scheme);
+    if (perf_cche_common_setup(perf_setup, encrypt_params, he_scheme) != CCERR_OK) {
+        cc_abort("Error during perf_cche_common_setup");
+    }
+    cche_ciphertext_coeff_t ciphertext = perf_setup->ciphertext;
+    cche_param_ctx_t param_ctx = perf_setup->param_ctx;
+    const uint32_t nmoduli = cche_param_ctx_ciphertext_ctx_nmoduli(param_ctx);
+    cche_ciphertext_coeff_t result =
+        (cche_ciphertext_coeff_t)malloc(cche_ciphertext_sizeof(param_ctx, nmoduli, cche_ciphertext_fresh_npolys()));
+
+    perf_start();
+    do {
+        if (cche_ciphertext_apply_galois(result, ciphertext, perf_setup->galois_elts[0], perf_setup->galois_key) != CCERR_OK) {
+            abort();
+        }
+    } while (--loops != 0);
+    double perf_res = perf_seconds();
+    free(result);
+    return perf_res;
+}
+
 #define TEST(_x)                       \
     {                                  \
         .name = #_x, .func = perf_##_x \
@@ -583,6 +607,7 @@ static struct cche_perf_test {
     TEST(cche_ciphertext_plaintext_add),
     TEST(cche_ciphertext_coeff_plaintext_mul),
     TEST(cche_ciphertext_coeff_dcrt_plaintext_mul),
+    TEST(cche_ciphertext_apply_galois),
 };
 
 static struct cche_perf_test cche_bgv_perf_tests[] = {
@@ -604,6 +629,7 @@ static struct cche_perf_test cche_bgv_perf_tests[] = {
     TEST(cche_ciphertext_plaintext_add),
     TEST(cche_ciphertext_coeff_plaintext_mul),
     TEST(cche_ciphertext_coeff_dcrt_plaintext_mul),
+    TEST(cche_ciphertext_apply_galois),
 };
 
 static double perf_cche_bfv(size_t loops, size_t *psize, const void *arg)
@@ -81,14 +81,55 @@ static double perf_cckeccak_absorb_squeeze(size_t loops, cc_size n, cckeccak_per
     return seconds;
 }
 
+#if CCKECCAK_AVX2
+static void cckeccak_f1600_x4_avx2_wrapper(cckeccak_state_x4_t state)
+{
+    if (CC_HAS_AVX2()) {
+        cckeccak_f1600_x4_avx2(state);
+    } else {
+        cckeccak_f1600_x4_c(state);
+    }
+}
+#endif
+
+// Absorbs and squeezes n bytes per state, i.e. 4n bytes in total.
+static double perf_cckeccak_absorb_squeeze_x4(size_t loops, cc_size n, cckeccak_permutation_x4 permutation)
+{
+    unsigned char *in = malloc(CCKECCAK_X4_NSTATES * n);
+    unsigned char *out = malloc(CCKECCAK_X4_NSTATES * n);
+    ccrng_generate(rng, CCKECCAK_X4_NSTATES * n, in);
+
+    const uint8_t *const ins[CCKECCAK_X4_NSTATES] = { in, in + n, in + 2 * n, in + 3 * n };
+    uint8_t *const outs[CCKECCAK_X4_NSTATES] = { out, out + n, out + 2 * n, out + 3 * n };
+
+    perf_start();
+    while (loops--) {
+        struct cckeccak_state_x4 state;
+        cckeccak_init_state_x4(&state);
+        cckeccak_absorb_and_pad_x4(&state, 136, n, ins, 0x06, permutation);
+        cckeccak_squeeze_x4(&state, 136, n, outs, permutation);
+    }
+
+    double seconds = perf_seconds();
+    free(in);
+    free(out);
+    return seconds;
+}
+
 #define _TEST(_x, _y)                                        \
     {                                                        \
         .name = #_x#_y, .func = perf_##_x, .permutation = &_y\
     }
+#define _TEST_X4(_x, _y)                                              \
+    {                                                                 \
+        .name = #_x#_y, .func_x4 = perf_##_x, .permutation_x4 = &_y   \
+    }
 static struct cckeccak_perf_test {
     const char *name;
     const cckeccak_permutation permutation;
     double (*func)(size_t loops, cc_size n, cckeccak_permutation permutation);
+    const cckeccak_permutation_x4 permutation_x4;
+    double (*func_x4)(size_t loops, cc_size n, cckeccak_permutation_x4 permutation);
 } cckeccak_perf_tests[] = {
     _TEST(cckeccak_absorb, cckeccak_f1600_c),
     _TEST(cckeccak_absorb_squeeze, cckeccak_f1600_c),
@@ -100,12 +141,19 @@ static struct cckeccak_perf_test {
 #elif defined(__x86_64__) && CCSHA3_VNG_INTEL
     _TEST(cckeccak_absorb, cckeccak_f1600_vng),
     _TEST(cckeccak_absorb_squeeze, cckeccak_f1600_vng),
+#endif
+    _TEST_X4(cckeccak_absorb_squeeze_x4, cckeccak_f1600_x4_c),
+#if CCKECCAK_AVX2
+    _TEST_X4(cckeccak_absorb_squeeze_x4, cckeccak_f1600_x4_avx2_wrapper),
 #endif
 };
 
 static double perf_cckeccak(size_t loops, size_t *psize, const void *arg)
 {
     const struct cckeccak_perf_test *test = arg;
+    if (test->func_x4) {
+        return test->func_x4(loops, *psize, *test->permutation_x4);
+    }
     return test->func(loops, *psize, *test->permutation);;
 }
 
@@ -12,6 +12,8 @@
 #include "ccperf.h"
 #include <corecrypto/cckyber.h>
 #include "cckem_internal.h"
+#include "cckyber_internal.h"
+#include "cckyber_avx2.h"
 
 static double perf_cckem_generate_key(size_t loops, const struct cckem_info *info)
 {
@@ -108,3 +110,209 @@ struct ccperf_family *ccperf_family_cckem(int argc, char *argv[])
 
     return &family;
 }
+
+/* cckyber_poly: the polynomial arithmetic dispatched to AVX2, against the
+   portable code. The size is the number of polynomials per operation. */
+
+#if CCKYBER_AVX2
+static void cckyber_ntt_forward_avx2_wrapper(int16_t coeffs[256])
+{
+    if (CC_HAS_AVX2()) {
+        cckyber_ntt_forward_avx2(coeffs);
+    } else {
+        cckyber_ntt_forward_c(coeffs);
+    }
+}
+
+static void cckyber_ntt_inverse_avx2_wrapper(int16_t coeffs[256])
+{
+    if (CC_HAS_AVX2()) {
+        cckyber_ntt_inverse_avx2(coeffs);
+    } else {
+        cckyber_ntt_inverse_c(coeffs);
+    }
+}
+
+static void cckyber_ntt_basemul_avx2_wrapper(int16_t coeffs[256], const int16_t a[256], const int16_t b[256])
+{
+    if (CC_HAS_AVX2()) {
+        cckyber_ntt_basemul_avx2(coeffs, a, b);
+    } else {
+        cckyber_ntt_basemul_c(coeffs, a, b);
+    }
+}
+
+static void cckyber_compress_avx2_wrapper(int16_t u[256], const int16_t coeffs[256], unsigned d)
+{
+    if (CC_HAS_AVX2()) {
+        cckyber_compress_avx2(u, coeffs, d);
+    } else {
+        cckyber_compress_c(u, coeffs, d);
+    }
+}
+#endif
+
+// Fills coeffs with random values in [0, q).
+static void cckyber_poly_random(size_t npolys, int16_t *coeffs)
+{
+    ccrng_generate(rng, npolys * CCKYBER_N * sizeof(int16_t), coeffs);
+    for (size_t i = 0; i < npolys * CCKYBER_N; i++) {
+        coeffs[i] = (int16_t)((uint16_t)coeffs[i] % CCKYBER_Q);
+    }
+}
+
+static double perf_cckyber_ntt_forward(size_t loops, size_t npolys, void (*ntt)(int16_t coeffs[256]))
+{
+    int16_t *coeffs = malloc(npolys * CCKYBER_N * sizeof(int16_t));
+    cckyber_poly_random(npolys, coeffs);
+
+    perf_start();
+    while (loops--) {
+        for (size_t i = 0; i < npolys; i++) {
+            ntt(&coeffs[i * CCKYBER_N]);
+        }
+    }
+
+    double seconds = perf_seconds();
+    free(coeffs);
+    return seconds;
+}
+
+static double perf_cckyber_ntt_inverse(size_t loops, size_t npolys, void (*invntt)(int16_t coeffs[256]))
+{
+    int16_t *coeffs = malloc(npolys * CCKYBER_N * sizeof(int16_t));
+    cckyber_poly_random(npolys, coeffs);
+
+    perf_start();
+    while (loops--) {
+        for (size_t i = 0; i < npolys; i++) {
+            invntt(&coeffs[i * CCKYBER_N]);
+        }
+    }
+
+    double seconds = perf_seconds();
+    free(coeffs);
+    return seconds;
+}
+
+static double perf_cckyber_ntt_basemul(size_t loops,
+                                       size_t npolys,
+                                       void (*basemul)(int16_t coeffs[256], const int16_t a[256], const int16_t b[256]))
+{
+    int16_t *coeffs = malloc(npolys * CCKYBER_N * sizeof(int16_t));
+    int16_t *a = malloc(npolys * CCKYBER_N * sizeof(int16_t));
+    int16_t *b = malloc(npolys * CCKYBER_N * sizeof(int16_t));
+    cckyber_poly_random(npolys, a);
+    cckyber_poly_random(npolys, b);
+
+    perf_start();
+    while (loops--) {
+        for (size_t i = 0; i < npolys; i++) {
+            basemul(&coeffs[i * CCKYBER_N], &a[i * CCKYBER_N], &b[i * CCKYBER_N]);
+        }
+    }
+
+    double seconds = perf_seconds();
+    free(coeffs);
+    free(a);
+    free(b);
+    return seconds;
+}
+
+// Compresses with d = 10, as for the ciphertext's polynomial vector.
+static double perf_cckyber_compress(size_t loops,
+                                    size_t npolys,
+                                    void (*compress)(int16_t u[256], const int16_t coeffs[256], unsigned d))
+{
+    int16_t *u = malloc(npolys * CCKYBER_N * sizeof(int16_t));
+    int16_t *coeffs = malloc(npolys * CCKYBER_N * sizeof(int16_t));
+    cckyber_poly_random(npolys, coeffs);
+
+    perf_start();
+    while (loops--) {
+        for (size_t i = 0; i < npolys; i++) {
+            compress(&u[i * CCKYBER_N], &coeffs[i * CCKYBER_N], 10);
+        }
+    }
+
+    double seconds = perf_seconds();
+    free(u);
+    free(coeffs);
+    return seconds;
+}
+
+static double perf_cckyber_ntt_forward_c(size_t loops, size_t npolys)
+{
+    return perf_cckyber_ntt_forward(loops, npolys, cckyber_ntt_forward_c);
+}
+
+static double perf_cckyber_ntt_inverse_c(size_t loops, size_t npolys)
+{
+    return perf_cckyber_ntt_inverse(loops, npolys, cckyber_ntt_inverse_c);
+}
+
+static double perf_cckyber_ntt_basemul_c(size_t loops, size_t npolys)
+{
+    return perf_cckyber_ntt_basemul(loops, npolys, cckyber_ntt_basemul_c);
+}
+
+static double perf_cckyber_compress_c(size_t loops, size_t npolys)
+{
+    return perf_cckyber_compress(loops, npolys, cckyber_compress_c);
+}
+
+#if CCKYBER_AVX2
+static double perf_cckyber_ntt_forward_avx2(size_t loops, size_t npolys)
+{
+    return perf_cckyber_ntt_forward(loops, npolys, cckyber_ntt_forward_avx2_wrapper);
+}
+
+static double perf_cckyber_ntt_inverse_avx2(size_t loops, size_t npolys)
+{
+    return perf_cckyber_ntt_inverse(loops, npolys, cckyber_ntt_inverse_avx2_wrapper);
+}
+
+static double perf_cckyber_ntt_basemul_avx2(size_t loops, size_t npolys)
+{
+    return perf_cckyber_ntt_basemul(loops, npolys, cckyber_ntt_basemul_avx2_wrapper);
+}
+
+static double perf_cckyber_compress_avx2(size_t loops, size_t npolys)
+{
+    return perf_cckyber_compress(loops, npolys, cckyber_compress_avx2_wrapper);
+}
+#endif
+
+static struct cckyber_poly_perf_test {
+    const char *name;
+    double (*func)(size_t loops, size_t npolys);
+} cckyber_poly_perf_tests[] = {
+    _TEST(cckyber_ntt_forward_c),
+    _TEST(cckyber_ntt_inverse_c),
+    _TEST(cckyber_ntt_basemul_c),
+    _TEST(cckyber_compress_c),
+#if CCKYBER_AVX2
+    _TEST(cckyber_ntt_forward_avx2),
+    _TEST(cckyber_ntt_inverse_avx2),
+    _TEST(cckyber_ntt_basemul_avx2),
+    _TEST(cckyber_compress_avx2),
+#endif
+};
+
+static double perf_cckyber_poly(size_t loops, size_t *psize, const void *arg)
+{
+    const struct cckyber_poly_perf_test *test = arg;
+    return test->func(loops, *psize);
+}
+
+static struct ccperf_family poly_family;
+
+struct ccperf_family *ccperf_family_cckyber_poly(int argc, char *argv[])
+{
+    F_GET_ALL(poly_family, cckyber_poly);
+    // Kyber768 and Kyber1024 polynomial vectors
+    static const size_t group_npolys[] = { 1, 3, 4 };
+    F_SIZES_FROM_ARRAY(poly_family, group_npolys);
+    poly_family.size_kind = ccperf_size_units;
+    return &poly_family;
+}
@@ -12,6 +12,8 @@
 #include "ccperf.h"
 #include <corecrypto/ccaes.h>
 #include "ccmode_internal.h"
+#include "ccaes_aesni_gcm.h"
+#include "cc_runtime_config.h"
 
 /* mode created with the GCM factory */
 
@@ -29,6 +31,11 @@ static struct ccmode_gcm ccaes_generic_intel_gcm_encrypt_mode;
 static struct ccmode_gcm ccaes_generic_intel_gcm_decrypt_mode;
 #endif
 
+#if CCMODE_GCM_AESNI_SPEEDUP
+static struct ccmode_gcm ccaes_aesni_gcm_encrypt_mode;
+static struct ccmode_gcm ccaes_aesni_gcm_decrypt_mode;
+#endif
+
 #define CCMODE_GCM_TEST(_mode, _keylen) { .name=#_mode"_"#_keylen, .gcm=&_mode, .keylen=_keylen }
 
 static struct ccgcm_perf_test {
@@ -59,6 +66,15 @@ static struct ccgcm_perf_test {
     CCMODE_GCM_TEST(ccaes_generic_intel_gcm_decrypt_mode, 32),
 #endif
 
+#if CCMODE_GCM_AESNI_SPEEDUP
+    CCMODE_GCM_TEST(ccaes_aesni_gcm_encrypt_mode, 16),
+    CCMODE_GCM_TEST(ccaes_aesni_gcm_decrypt_mode, 16),
+    CCMODE_GCM_TEST(ccaes_aesni_gcm_encrypt_mode, 24),
+    CCMODE_GCM_TEST(ccaes_aesni_gcm_decrypt_mode, 24),
+    CCMODE_GCM_TEST(ccaes_aesni_gcm_encrypt_mode, 32),
+    CCMODE_GCM_TEST(ccaes_aesni_gcm_decrypt_mode, 32),
+#endif
+
     CCMODE_GCM_TEST(ccaes_default_gcm_encrypt_mode, 16),
     CCMODE_GCM_TEST(ccaes_default_gcm_decrypt_mode, 16),
     CCMODE_GCM_TEST(ccaes_default_gcm_encrypt_mode, 24),
@@ -229,6 +245,16 @@ static void ccperf_family_ccgcm_once(int argc CC_UNUSED, char *argv[] CC_UNUSED)
     ccmode_factory_gcm_encrypt(&ccaes_generic_intel_gcm_encrypt_mode, &ccaes_intel_ecb_encrypt_opt_mode);
     ccmode_factory_gcm_decrypt(&ccaes_generic_intel_gcm_decrypt_mode, &ccaes_intel_ecb_encrypt_opt_mode);
 #endif
+#if CCMODE_GCM_AESNI_SPEEDUP
+    // Without CPU support, time the generic mode rather than fault.
+    if (CC_HAS_AESNI() && CC_HAS_PCLMULQDQ() && CC_HAS_SupplementalSSE3()) {
+        ccaes_aesni_factory_gcm_encrypt(&ccaes_aesni_gcm_encrypt_mode);
+        ccaes_aesni_factory_gcm_decrypt(&ccaes_aesni_gcm_decrypt_mode);
+    } else {
+        ccmode_factory_gcm_encrypt(&ccaes_aesni_gcm_encrypt_mode, ccaes_ecb_encrypt_mode());
+        ccmode_factory_gcm_decrypt(&ccaes_aesni_gcm_decrypt_mode, ccaes_ecb_encrypt_mode());
+    }
+#endif
 
     ccaes_default_gcm_encrypt_mode=*ccaes_gcm_encrypt_mode();
     ccaes_default_gcm_decrypt_mode=*ccaes_gcm_decrypt_mode();
@@ -166,6 +166,87 @@ static void ccperf_family_ccxts_once(int argc CC_UNUSED, char *argv[] CC_UNUSED)
     ccaes_default_xts_decrypt_mode=*ccaes_xts_decrypt_mode();
 }
 
+/* ccxts_update_sectors: the size is the total number of bytes, in 4096-byte sectors */
+
+#define CCXTS_PERF_SECTOR_NBYTES 4096
+
+#define CCMODE_XTS_SECTORS_TEST(_mode, _keylen, _nshards) \
+    { .name=#_mode"_"#_keylen"_x"#_nshards, .xts=&_mode, .keylen=_keylen, .nshards=_nshards }
+
+static struct ccxts_sectors_perf_test {
+    const char *name;
+    const struct ccmode_xts *xts;
+    size_t keylen;
+    size_t nshards;
+} ccxts_sectors_perf_tests[] = {
+    CCMODE_XTS_SECTORS_TEST(ccaes_generic_ltc_xts_encrypt_mode, 16, 1),
+    CCMODE_XTS_SECTORS_TEST(ccaes_default_xts_encrypt_mode, 16, 1),
+    CCMODE_XTS_SECTORS_TEST(ccaes_default_xts_decrypt_mode, 16, 1),
+    CCMODE_XTS_SECTORS_TEST(ccaes_default_xts_encrypt_mode, 32, 1),
+    CCMODE_XTS_SECTORS_TEST(ccaes_default_xts_decrypt_mode, 32, 1),
+    CCMODE_XTS_SECTORS_TEST(ccaes_default_xts_encrypt_mode, 16, 4),
+    CCMODE_XTS_SECTORS_TEST(ccaes_default_xts_decrypt_mode, 16, 4),
+};
+
+static double perf_ccxts_sectors(size_t loops, size_t *psize, const void *arg)
+{
+    const struct ccxts_sectors_perf_test *test=arg;
+    const struct ccmode_xts *xts=test->xts;
+    size_t keylen=test->keylen;
+    size_t nsectors=CC_MAX(*psize/CCXTS_PERF_SECTOR_NBYTES, (size_t)1);
+
+    unsigned char keyd[keylen];
+    unsigned char tweakkeyd[keylen];
+    unsigned char *temp = malloc(nsectors*CCXTS_PERF_SECTOR_NBYTES);
+    uint64_t *ivs = calloc(nsectors, 2*sizeof(uint64_t));
+    struct ccmode_sector *sectors = malloc(nsectors*sizeof(*sectors));
+
+    cc_clear(keylen,keyd);
+    cc_clear(keylen,tweakkeyd);
+    // keyd and tweakkeyd must be different, or ccxts_init fails with CCERR_XTS_KEYS_EQUAL.
+    keyd[0] = 0x42;
+
+    // Consecutive sectors, the IV is the little-endian sector number.
+    for (size_t i = 0; i < nsectors; i++) {
+        ivs[2*i] = i;
+        sectors[i].iv = &ivs[2*i];
+        sectors[i].nblocks = CCXTS_PERF_SECTOR_NBYTES/xts->block_size;
+        sectors[i].in = temp + i*CCXTS_PERF_SECTOR_NBYTES;
+        sectors[i].out = temp + i*CCXTS_PERF_SECTOR_NBYTES;
+    }
+
+    ccxts_ctx_decl(xts->size, key);
+    if (ccxts_init(xts, key, keylen, keyd, tweakkeyd)) {
+        cc_abort("Failure in ccxts_init");
+    }
+
+    perf_start();
+    while(loops--) {
+        int status=ccxts_update_sectors_executor(&ccperf_executor, test->nshards, xts, key, nsectors, sectors);
+        if (status) cc_abort("Failure in ccxts_update_sectors_executor");
+    }
+
+    double seconds = perf_seconds();
+    free(sectors);
+    free(ivs);
+    free(temp);
+    return seconds;
+}
+
+static struct ccperf_family sectors_family;
+
+struct ccperf_family *ccperf_family_ccxts_sectors(int argc, char *argv[])
+{
+    ccperf_family_ccxts_once(argc, argv);
+    F_GET_ALL(sectors_family, ccxts_sectors);
+    // 1, 8, 64 and 512 sectors.
+    static const size_t sectors_nbytes[] = { 1 * CCXTS_PERF_SECTOR_NBYTES, 8 * CCXTS_PERF_SECTOR_NBYTES,
+                                             64 * CCXTS_PERF_SECTOR_NBYTES, 512 * CCXTS_PERF_SECTOR_NBYTES };
+    F_SIZES_FROM_ARRAY(sectors_family, sectors_nbytes);
+    sectors_family.size_kind = ccperf_size_bytes;
+    return &sectors_family;
+}
+
 static const size_t tweak_sizes[]={16};
 
 F_DEFINE(ccxts, init, ccperf_size_iterations, 1)
@@ -274,7 +274,7 @@ struct ccperf_family *ccperf_family_ccn(int argc, char *argv[])
 {
     F_GET_ALL(family, ccn);
     family.loops = 100;
-    const size_t number_nbits[] = { 256, 512, 1024, 1280, 2048, 4096 };
+    const size_t number_nbits[] = { 256, 512, 1024, 1280, 2048, 3072, 4096, 6144, 8192 };
     F_SIZES_FROM_ARRAY(family, number_nbits);
     family.size_kind = ccperf_size_bits;
     return &family;
@@ -66,6 +66,63 @@ static double perf_ccpbkdf2(size_t loops, size_t *psize, const void *arg)
     return perf_seconds();
 }
 
+/* ccpbkdf2_hmac_mb: the time is divided by the number of passwords, so that
+ the rate is the number of iterations per second on one core. */
+
+#define CCPBKDF2_MB_TEST(_di, _n) { .name="ccpbkdf2_mb_"#_di"_x"#_n, .di=&_di, .n=_n }
+
+static struct ccpbkdf2_mb_perf_test {
+    const char *name;
+    const struct ccdigest_info *di;
+    size_t n;
+} ccpbkdf2_mb_perf_tests[] = {
+    CCPBKDF2_MB_TEST(ccsha1_di_default, 1),
+    CCPBKDF2_MB_TEST(ccsha1_di_default, 4),
+
+    CCPBKDF2_MB_TEST(ccsha256_di_default, 1),
+    CCPBKDF2_MB_TEST(ccsha256_di_default, 4),
+    CCPBKDF2_MB_TEST(ccsha256_di_default, 8),
+    CCPBKDF2_MB_TEST(ccsha256_di_default, 16),
+
+    CCPBKDF2_MB_TEST(ccsha512_di_default, 1),
+    CCPBKDF2_MB_TEST(ccsha512_di_default, 4),
+    CCPBKDF2_MB_TEST(ccsha512_di_default, 8),
+};
+
+static double perf_ccpbkdf2_mb(size_t loops, size_t *psize, const void *arg)
+{
+    const struct ccpbkdf2_mb_perf_test *test=arg;
+    size_t n=test->n;
+    size_t pwdLen=16;
+    unsigned char pwd[n][pwdLen];
+    size_t saltLen=16;
+    unsigned char salt[n][saltLen];
+    size_t dkLen=16;
+    unsigned char dk[n][dkLen];
+    size_t iterations=*psize;
+    size_t pwdLens[n], saltLens[n];
+    const void *pwds[n], *salts[n];
+    void *dks[n];
+
+    for (size_t i = 0; i < n; i++) {
+        ccrng_generate(rng, pwdLen, pwd[i]);
+        ccrng_generate(rng, saltLen, salt[i]);
+        pwdLens[i] = pwdLen;
+        saltLens[i] = saltLen;
+        pwds[i] = pwd[i];
+        salts[i] = salt[i];
+        dks[i] = dk[i];
+    }
+
+    perf_start();
+    do {
+        if (ccpbkdf2_hmac_mb(test->di, n, pwdLens, pwds, saltLens, salts, iterations, dkLen, dks)) {
+            abort();
+        }
+    } while (--loops != 0);
+    return perf_seconds() / (double)n;
+}
+
 static struct ccperf_family family;
 
 struct ccperf_family *ccperf_family_ccpbkdf2(int argc, char *argv[])
@@ -82,3 +139,16 @@ struct ccperf_family *ccperf_family_ccpbkdf2(int argc, char *argv[])
     family.size_kind=ccperf_size_iterations;
     return &family;
 }
+
+static struct ccperf_family mb_family;
+
+struct ccperf_family *ccperf_family_ccpbkdf2_mb(int argc, char *argv[])
+{
+    ccperf_family_ccpbkdf2(argc, argv);
+
+    F_GET_ALL(mb_family, ccpbkdf2_mb);
+    static const size_t iteration_numbers[]={1,100,10000};
+    F_SIZES_FROM_ARRAY(mb_family,iteration_numbers);
+    mb_family.size_kind=ccperf_size_iterations;
+    return &mb_family;
+}
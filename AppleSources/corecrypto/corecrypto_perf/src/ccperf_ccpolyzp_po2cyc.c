@@ -16,8 +16,10 @@
 #include "ccpolyzp_po2cyc_ctx_chain.h"
 
 #define MODULUS_60_BIT 1152921504606584833
+#define MODULUS_50_BIT 1125899903827969
 
-const ccrns_int perf_moduli[] = { MODULUS_60_BIT };
+/// The modulus of the running benchmark
+static ccrns_int perf_moduli[1];
 
 /// Returns a uniform random number in [0, max - 1].
 static ccrns_int rns_int_uniform(ccrns_int max)
@@ -269,14 +271,15 @@ static double perf_ccpolyzp_po2cyc_random_ternary_ws(size_t loops, uint32_t degr
     return perf_res;
 }
 
-#define _TEST(_x, _q)                          \
-    {                                          \
-        .name = #_x "_" #_q, .func = perf_##_x \
+#define _TEST(_x, _q)                                         \
+    {                                                         \
+        .name = #_x "_" #_q, .func = perf_##_x, .modulus = _q \
     }
 
 static struct ccpolyzp_po2cyc_perf_test {
     const char *name;
     double (*func)(size_t loops, uint32_t degree);
+    ccrns_int modulus;
 } ccpolyzp_po2cyc_perf_tests[] = { _TEST(ccpolyzp_po2cyc_init, MODULUS_60_BIT),
                                    _TEST(ccpolyzp_po2cyc_ctx_init_ws, MODULUS_60_BIT),
                                    _TEST(ccpolyzp_po2cyc_eval_negate, MODULUS_60_BIT),
@@ -286,6 +289,8 @@ static struct ccpolyzp_po2cyc_perf_test {
                                    _TEST(ccpolyzp_po2cyc_eval_scalar_mul_ws, MODULUS_60_BIT),
                                    _TEST(ccpolyzp_po2cyc_fwd_ntt, MODULUS_60_BIT),
                                    _TEST(ccpolyzp_po2cyc_inv_ntt, MODULUS_60_BIT),
+                                   _TEST(ccpolyzp_po2cyc_fwd_ntt, MODULUS_50_BIT),
+                                   _TEST(ccpolyzp_po2cyc_inv_ntt, MODULUS_50_BIT),
                                    _TEST(ccpolyzp_po2cyc_divide_and_round_q_last_ws, MODULUS_60_BIT),
                                    _TEST(ccpolyzp_po2cyc_random_uniform, MODULUS_60_BIT),
                                    _TEST(ccpolyzp_po2cyc_random_cbd_ws, MODULUS_60_BIT),
@@ -294,6 +299,7 @@ static struct ccpolyzp_po2cyc_perf_test {
 static double perf_ccpolyzp_po2cyc(size_t loops, size_t *psize, const void *arg)
 {
     const struct ccpolyzp_po2cyc_perf_test *test = arg;
+    perf_moduli[0] = test->modulus;
     return test->func(loops, (uint32_t)*psize);
 }
 
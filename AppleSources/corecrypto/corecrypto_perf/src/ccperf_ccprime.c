@@ -12,6 +12,7 @@
 #include "ccperf.h"
 #include "cczp.h"
 #include "ccprime_internal.h"
+#include "ccrsa_internal.h"
 
 // A 2048-bit prime.
 const uint8_t PRIME[] = {
@@ -93,3 +94,108 @@ struct ccperf_family *ccperf_family_ccprime(int argc, char *argv[])
     family.size_kind = ccperf_size_bits;
     return &family;
 }
+
+// Prime candidates looked at per second, when searching for RSA primes with
+// e = 65537. Every candidate is checked for small prime factors, survivors go
+// through the full RSA prime check. The size is the number of candidates per run.
+
+static void perf_ccprime_random_candidate(size_t nbits, cc_unit *p)
+{
+    if (ccn_random_bits(nbits, p, rng)) {
+        abort();
+    }
+
+    ccn_set_bit(p, nbits - 1, 1);
+    ccn_set_bit(p, nbits - 2, 1);
+    ccn_set_bit(p, 0, 1);
+}
+
+static double perf_ccprime_candidates_trial_division(size_t loops, size_t nbits, size_t ncandidates)
+{
+    cc_size n = ccn_nof(nbits);
+    cc_unit p[n], e[n];
+    ccn_seti(n, e, 65537);
+    size_t mr_depth = ccrsa_num_mr_iterations(nbits);
+
+    CC_DECL_WORKSPACE_TEST(ws);
+    perf_start();
+
+    do {
+        for (size_t i = 0; i < ncandidates; i++) {
+            perf_ccprime_random_candidate(nbits, p);
+            if (ccrsa_is_valid_prime_ws(ws, n, p, 1, e, mr_depth, rng) < 0) {
+                abort();
+            }
+        }
+    } while (--loops != 0);
+
+    double seconds = perf_seconds();
+    CC_FREE_WORKSPACE(ws);
+    return seconds;
+}
+
+static double perf_ccprime_candidates_sieve(size_t loops, size_t nbits, size_t ncandidates)
+{
+    cc_size n = ccn_nof(nbits);
+    cc_unit p[n], e[n];
+    ccn_seti(n, e, 65537);
+    size_t mr_depth = ccrsa_num_mr_iterations(nbits);
+    struct ccprime_sieve sieve;
+
+    CC_DECL_WORKSPACE_TEST(ws);
+    perf_start();
+
+    do {
+        // Every sieve step is a candidate, stop after exactly ncandidates of them.
+        for (size_t i = 0; i < ncandidates;) {
+            size_t nsteps = CC_MIN(ncandidates - i, 1024);
+            perf_ccprime_random_candidate(nbits, p);
+            ccprime_sieve_init(&sieve, nsteps, n, p);
+
+            while (ccprime_sieve_next(&sieve, n, p)) {
+                if (ccrsa_is_valid_prime_ws(ws, n, p, 1, e, mr_depth, rng) < 0) {
+                    abort();
+                }
+            }
+
+            i += nsteps;
+        }
+    } while (--loops != 0);
+
+    double seconds = perf_seconds();
+    CC_FREE_WORKSPACE(ws);
+    return seconds;
+}
+
+#define _TEST_CANDIDATES(_x, _nbits)                                      \
+    {                                                                     \
+        .name = #_x "_" #_nbits, .func = perf_##_x, .nbits = _nbits       \
+    }
+static struct ccprime_candidates_perf_test {
+    const char *name;
+    double (*func)(size_t loops, size_t nbits, size_t ncandidates);
+    size_t nbits;
+} ccprime_candidates_perf_tests[] = {
+    _TEST_CANDIDATES(ccprime_candidates_trial_division, 1024),
+    _TEST_CANDIDATES(ccprime_candidates_sieve, 1024),
+    _TEST_CANDIDATES(ccprime_candidates_trial_division, 1536),
+    _TEST_CANDIDATES(ccprime_candidates_sieve, 1536),
+    _TEST_CANDIDATES(ccprime_candidates_trial_division, 2048),
+    _TEST_CANDIDATES(ccprime_candidates_sieve, 2048),
+};
+
+static double perf_ccprime_candidates(size_t loops, size_t *psize, const void *arg)
+{
+    const struct ccprime_candidates_perf_test *test = arg;
+    return test->func(loops, test->nbits, *psize);
+}
+
+static struct ccperf_family candidates_family;
+
+struct ccperf_family *ccperf_family_ccprime_candidates(int argc, char *argv[])
+{
+    F_GET_ALL(candidates_family, ccprime_candidates);
+    F_SIZE(candidates_family, 1024);
+    candidates_family.size_kind = ccperf_size_iterations;
+    return &candidates_family;
+}
@@ -327,7 +327,7 @@ static struct ccperf_family family;
 struct ccperf_family *ccperf_family_ccrsa(int argc, char *argv[])
 {
     F_GET_ALL(family, ccrsa);
-    static const size_t key_nbits[]={1024,1280,2048,4096};
+    static const size_t key_nbits[]={1024,1280,2048,3072,4096};
     F_SIZES_FROM_ARRAY(family,key_nbits);
 
     family.size_kind=ccperf_size_bits;
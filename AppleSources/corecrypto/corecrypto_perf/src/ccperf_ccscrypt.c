@@ -87,3 +87,68 @@ struct ccperf_family *ccperf_family_ccscrypt(int argc, char *argv[])
     family.size_kind = ccperf_size_bits;
     return &family;
 }
+
+/* ccscrypt_parallel: the size is the number of workers */
+
+#define _PTEST(_N, _r, _p) { .name = "ccscrypt_N" #_N "_r" #_r "_p" #_p, .N = _N, .r = _r, .p = _p }
+static struct ccscrypt_parallel_perf_test {
+    const char *name;
+    uint64_t N;
+    uint32_t r;
+    uint32_t p;
+} ccscrypt_parallel_perf_tests[] = {
+    _PTEST(16384, 8, 1),
+    _PTEST(1024, 8, 16),
+    _PTEST(16384, 1, 16),
+    _PTEST(16384, 8, 4),
+    _PTEST(16384, 8, 16),
+    _PTEST(65536, 8, 4),
+};
+
+static double perf_ccscrypt_parallel(size_t loops, size_t *psize, const void *arg)
+{
+    const struct ccscrypt_parallel_perf_test *test = arg;
+    size_t nworkers = *psize;
+    double t;
+
+    uint8_t pwd[] = "pleaseletmein";
+
+    uint8_t salt[16];
+    ccrng_generate(rng, sizeof(salt), salt);
+
+    int64_t storage_size = ccscrypt_parallel_storage_size(test->N, test->r, test->p, nworkers);
+    if (storage_size <= 0) {
+        abort();
+    }
+
+    uint8_t *buffer = (uint8_t *)malloc((size_t)storage_size);
+    if (!buffer) {
+        abort();
+    }
+
+    memset(buffer, 0, (size_t)storage_size);
+    uint8_t out[64];
+
+    perf_start();
+    do {
+        if (ccscrypt_parallel(&ccperf_executor, nworkers, sizeof(pwd), pwd, sizeof(salt), salt,
+                              buffer, test->N, test->r, test->p, sizeof(out), out)) {
+            abort();
+        }
+    } while (--loops != 0);
+
+    t = perf_seconds();
+    free(buffer);
+    return t;
+}
+
+static struct ccperf_family parallel_family;
+
+struct ccperf_family *ccperf_family_ccscrypt_parallel(int argc, char *argv[])
+{
+    F_GET_ALL(parallel_family, ccscrypt_parallel);
+    static const size_t group_nworkers[] = { 1, 2, 4, 8, 16 };
+    F_SIZES_FROM_ARRAY(parallel_family, group_nworkers);
+    parallel_family.size_kind = ccperf_size_units;
+    return &parallel_family;
+}
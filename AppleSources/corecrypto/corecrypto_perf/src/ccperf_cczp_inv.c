@@ -11,6 +11,7 @@
 
 #include "ccperf.h"
 #include "cczp_internal.h"
+#include "ccec_internal.h"
 
 typedef int (*cczp_cczp_inv_t)(cczp_const_t zp, cc_unit *r, const cc_unit *x);
 
@@ -63,3 +64,75 @@ struct ccperf_family *ccperf_family_cczp_inv(int argc, char *argv[])
     family.size_kind=ccperf_size_bits;
     return &family;
 }
+
+/* Batch inversion: the size is the number of elements per batch */
+
+static double perf_cczp_inv_batch_all(size_t loops, size_t k, bool batch)
+{
+    int st;
+    cc_size n = ccn_nof(256);
+    cc_unit *a = malloc(ccn_sizeof_n(k * n));
+    cc_unit *ai = malloc(ccn_sizeof_n(k * n));
+    if (!a || !ai) abort();
+
+    // Batch inversion needs every element to be invertible, use a prime field.
+    cczp_const_t zp = ccec_cp_zp(ccec_cp_256());
+
+    for (size_t i = 0; i < k; i++) {
+        st=ccn_random(n, &a[i * n], rng); if(st!=0) abort();
+        cczp_modn(zp, &a[i * n], n, &a[i * n]);
+    }
+
+    perf_start();
+    do {
+        if (batch) {
+            st=cczp_inv_batch(zp, k, ai, a); if(st!=0) abort();
+        } else {
+            for (size_t i = 0; i < k; i++) {
+                (void)cczp_inv(zp, &ai[i * n], &a[i * n]);
+            }
+        }
+    } while (--loops != 0);
+    double t = perf_seconds();
+
+    free(a);
+    free(ai);
+    return t;
+}
+
+static double perf_cczp_inv_batch_ws(size_t loops, size_t k)
+{
+    return perf_cczp_inv_batch_all(loops, k, true);
+}
+
+static double perf_cczp_inv_ws_each(size_t loops, size_t k)
+{
+    return perf_cczp_inv_batch_all(loops, k, false);
+}
+
+static struct cczp_inv_batch_perf_test {
+    const char *name;
+    double(*func)(size_t loops, size_t k);
+} cczp_inv_batch_perf_tests[] = {
+    _TEST(cczp_inv_batch_ws),
+    _TEST(cczp_inv_ws_each),
+};
+
+static double perf_cczp_inv_batch(size_t loops, size_t *psize, const void *arg)
+{
+    const struct cczp_inv_batch_perf_test *test=arg;
+    return test->func(loops, *psize);
+}
+
+static struct ccperf_family batch_family;
+
+struct ccperf_family *ccperf_family_cczp_inv_batch(int argc, char *argv[])
+{
+    F_GET_ALL(batch_family, cczp_inv_batch);
+
+    const size_t sizes[] = { 1, 2, 4, 8, 16, 32, 64, 128, 256 };
+    F_SIZES_FROM_ARRAY(batch_family, sizes);
+
+    batch_family.size_kind=ccperf_size_units;
+    return &batch_family;
+}
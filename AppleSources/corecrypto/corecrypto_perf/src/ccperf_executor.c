@@ -0,0 +1,48 @@
+/* Copyright (c) (2023) Apple Inc. All rights reserved.
+ *
+ * corecrypto is licensed under Apple Inc.’s Internal Use License Agreement (which
+ * is contained in the License.txt file distributed with corecrypto) and only to
+ * people who accept that license. IMPORTANT:  Any license rights granted to you by
+ * Apple Inc. (if any) are limited to internal use within your organization only on
+ * devices and computers you own or control, for the sole purpose of verifying the
+ * security characteristics and correct functioning of the Apple Software.  You may
+ * not, directly or indirectly, redistribute the Apple Software or any portions thereof.
+ */
+
+#include "ccperf.h"
+#include <corecrypto/cc_executor.h>
+#include <pthread.h>
+
+struct ccperf_executor_job {
+    void *work_ctx;
+    void (*work)(void *work_ctx, size_t i);
+    size_t i;
+};
+
+static void *ccperf_executor_thread(void *arg)
+{
+    struct ccperf_executor_job *job = arg;
+    job->work(job->work_ctx, job->i);
+    return NULL;
+}
+
+// One thread per work item, the first one runs on the calling thread.
+static void ccperf_executor_apply(const struct cc_executor *executor CC_UNUSED, size_t n,
+                                  void *work_ctx, void (*work)(void *work_ctx, size_t i))
+{
+    pthread_t threads[n];
+    struct ccperf_executor_job jobs[n];
+
+    for (size_t i = 1; i < n; i++) {
+        jobs[i] = (struct ccperf_executor_job){ .work_ctx = work_ctx, .work = work, .i = i };
+        if (pthread_create(&threads[i], NULL, ccperf_executor_thread, &jobs[i])) {
+            abort();
+        }
+    }
+    work(work_ctx, 0);
+    for (size_t i = 1; i < n; i++) {
+        pthread_join(threads[i], NULL);
+    }
+}
+
+const struct cc_executor ccperf_executor = { .apply = ccperf_executor_apply };
@@ -14,6 +14,8 @@
 #include "cckprng_internal.h"
 #include "ccperf.h"
 
+#include <pthread.h>
+
 /*
 void cckprng_init(struct cckprng_ctx *ctx,
 size_t seed_nbytes,
@@ -106,6 +108,94 @@ static double perf_cckprng_refresh(size_t loops, size_t *nbytes, CC_UNUSED const
     return perf_seconds();
 }
 
+#define CCKPRNG_THREADS_TEST(_kind, _sharded, _nthreads) \
+    { .name="cckprng_"#_kind"_x"#_nthreads, .sharded=_sharded, .nthreads=_nthreads }
+
+// Concurrent requests, either on the central generator or on one
+// output generator per thread.
+static struct cckprng_threads_perf_test {
+    const char *name;
+    bool sharded;
+    unsigned nthreads;
+} cckprng_threads_perf_tests[] = {
+    CCKPRNG_THREADS_TEST(central, false, 1),
+    CCKPRNG_THREADS_TEST(central, false, 2),
+    CCKPRNG_THREADS_TEST(central, false, 4),
+    CCKPRNG_THREADS_TEST(central, false, 8),
+    CCKPRNG_THREADS_TEST(sharded, true, 1),
+    CCKPRNG_THREADS_TEST(sharded, true, 2),
+    CCKPRNG_THREADS_TEST(sharded, true, 4),
+    CCKPRNG_THREADS_TEST(sharded, true, 8),
+};
+
+struct cckprng_threads_perf_job {
+    struct cckprng_ctx *ctx;
+    unsigned gen_idx;
+    size_t loops;
+    size_t nbytes;
+};
+
+static void *cckprng_threads_perf_thread(void *arg)
+{
+    const struct cckprng_threads_perf_job *job = arg;
+    uint8_t rand[CCKPRNG_GENERATE_MAX_NBYTES];
+
+    for (size_t i = 0; i < job->loops; i++) {
+        cckprng_generate(job->ctx, job->gen_idx, job->nbytes, rand);
+    }
+    return NULL;
+}
+
+static double perf_cckprng_threads(size_t loops, size_t *nbytes, const void *arg)
+{
+    const struct cckprng_threads_perf_test *test = arg;
+    uint8_t seed[32] = {0};
+    uint8_t nonce[32] = {0};
+    struct cckprng_ctx *ctx = malloc(sizeof(*ctx));
+    pthread_t threads[test->nthreads];
+    struct cckprng_threads_perf_job jobs[test->nthreads];
+
+    cckprng_init_with_getentropy(ctx, test->nthreads, sizeof(seed), seed, sizeof(nonce), nonce, perf_getentropy, NULL);
+    cckprng_refresh(ctx);
+
+    for (unsigned i = 0; i < test->nthreads; i++) {
+        if (test->sharded) {
+            cckprng_initgen(ctx, i);
+        }
+        jobs[i] = (struct cckprng_threads_perf_job){
+            .ctx = ctx, .gen_idx = test->sharded ? i : 0, .loops = loops, .nbytes = *nbytes
+        };
+    }
+
+    perf_start();
+
+    for (unsigned i = 0; i < test->nthreads; i++) {
+        if (pthread_create(&threads[i], NULL, cckprng_threads_perf_thread, &jobs[i])) {
+            abort();
+        }
+    }
+    for (unsigned i = 0; i < test->nthreads; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    // Each thread generates loops * nbytes, scale the time so that
+    // throughput is reported for all threads together.
+    double seconds = perf_seconds() / test->nthreads;
+    free(ctx);
+    return seconds;
+}
+
+static struct ccperf_family cckprng_threads_family;
+
+struct ccperf_family *ccperf_family_cckprng_threads(int argc, char *argv[])
+{
+    static const size_t threads_sizes[] = { 32, 64, CCKPRNG_GENERATE_MAX_NBYTES };
+    F_GET_ALL(cckprng_threads_family, cckprng_threads);
+    F_SIZES_FROM_ARRAY(cckprng_threads_family, threads_sizes);
+    cckprng_threads_family.size_kind = ccperf_size_bytes;
+    return &cckprng_threads_family;
+}
+
 static struct ccperf_test cckprng_perf_tests[1] = { { .name = "cckprng_default" } };
 
 static const size_t sizes[] = { 16, 32, 64, 128, 256 };
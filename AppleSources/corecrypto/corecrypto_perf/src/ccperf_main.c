@@ -9,6 +9,11 @@
  * not, directly or indirectly, redistribute the Apple Software or any portions thereof.
  */
 
+#if defined(__linux__)
+#define _GNU_SOURCE // For sched_setaffinity()
+#include <sched.h>
+#endif
+
 #include "ccperf.h"
 #include <math.h>
 
@@ -30,7 +35,9 @@ typedef enum{
     PERF_DISPLAY_SHORT=0,             /* Default */
     PERF_DISPLAY_DETAIL,              /* Detailled */
     PERF_DISPLAY_KEYVAL,              /* Parser friendly */
-    PERF_DISPLAY_MAX=PERF_DISPLAY_KEYVAL
+    PERF_DISPLAY_JSON,                /* Statistics, one JSON object per test */
+    PERF_DISPLAY_CSV,                 /* Statistics, one CSV line per test */
+    PERF_DISPLAY_MAX=PERF_DISPLAY_CSV
 } ccperf_display_mode_e;
 
 static struct ccrng_test_state test_rng;
@@ -66,9 +73,23 @@ static double perf_noop(size_t loops)
     return perf_seconds();
 }
 
-static void perf_test_family(struct ccperf_family *f, ccperf_display_mode_e display_mode)
+static int perf_pin_cpu(int cpu)
+{
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return sched_setaffinity(0, sizeof(set), &set);
+#else
+    (void)cpu;
+    return -1;
+#endif
+}
+
+static void perf_test_family(struct ccperf_family *f, ccperf_display_mode_e display_mode, struct ccperf_report *report)
 {
     double noop_time = perf_noop(f->loops);
+    double noop_cycles = (double)ccperf_cycles();
 
     if(f->ntests==0) return;
 
@@ -89,6 +110,10 @@ static void perf_test_family(struct ccperf_family *f, ccperf_display_mode_e disp
                 duration -= noop_time;
             }
 
+            if (report) {
+                ccperf_report_result(report, f, f->sizes[j], f->tests[i], noop_time, noop_cycles);
+            }
+
             struct units ud = dur2units(duration / (double)f->loops);
             struct units udb = dur2units(duration / (double)(f->loops * f->sizes[j]));
             struct units uop = dur2units((double)f->loops / duration);
@@ -189,6 +214,7 @@ struct ccperf_family *(*ccperf_families[])(int argc, char *argv[]) = {
     ccperf_family_ccxts_set_tweak,
     ccperf_family_ccxts_update,
     ccperf_family_ccxts_one_shot,
+    ccperf_family_ccxts_sectors,
     ccperf_family_ccchacha_init,
     ccperf_family_ccchacha_update,
     ccperf_family_ccchacha_one_shot,
@@ -201,12 +227,15 @@ struct ccperf_family *(*ccperf_families[])(int argc, char *argv[]) = {
     ccperf_family_ccsiv_aad_or_nonce,
     ccperf_family_ccsiv_one_shot,
     ccperf_family_ccdigest,
+    ccperf_family_ccdigest_mb,
     ccperf_family_cchmac,
     ccperf_family_cccmac,
     ccperf_family_ccn,
     ccperf_family_cczp,
     ccperf_family_ccec,
+    ccperf_family_ccec_multi_mult,
     ccperf_family_ccec25519,
+    ccperf_family_ccec25519_batch,
     ccperf_family_ccec448,
     ccperf_family_ccpolyzp_po2cyc,
     ccperf_family_cche_bfv,
@@ -215,28 +244,35 @@ struct ccperf_family *(*ccperf_families[])(int argc, char *argv[]) = {
     ccperf_family_ccrsabssa,
     ccperf_family_ccrsa_keygen,
     ccperf_family_cczp_inv,
+    ccperf_family_cczp_inv_batch,
     ccperf_family_ccpbkdf2,
+    ccperf_family_ccpbkdf2_mb,
     ccperf_family_ccansikdf,
     ccperf_family_ccsrp,
     ccperf_family_ccdh_generate_key,
     ccperf_family_ccdh_compute_shared_secret,
-#if !CC_LINUX && !defined(_MSC_VER)
+#ifndef _MSC_VER
     ccperf_family_cckprng_init,
     ccperf_family_cckprng_generate,
     ccperf_family_cckprng_reseed,
     ccperf_family_cckprng_refresh,
+    ccperf_family_cckprng_threads,
 #endif
 #ifndef _MSC_VER
     ccperf_family_ccscrypt,
+    ccperf_family_ccscrypt_parallel,
+    ccperf_family_ccder,
     ccperf_family_ccspake,
     ccperf_family_ccsae,
     ccperf_family_ccvrf,
 #endif
     ccperf_family_ccprime,
+    ccperf_family_ccprime_candidates,
     ccperf_family_cchpke,
     ccperf_family_cch2c,
     ccperf_family_cckeccak,
     ccperf_family_cckem,
+    ccperf_family_cckyber_poly,
 };
 
 #define PIFLAG(L) printf(" " #L "=%d", L)
@@ -300,10 +336,16 @@ static CC_NORETURN void usage(char **argv)
 {
 	printf("usage: %s [options]\n", argv[0]);
 	printf("\tOptions:\n");
-	printf("\t-d display: override default display type (0:short ; 1:full ; 2:key/value)\n");
+	printf("\t-d display: override default display type (0:short ; 1:full ; 2:key/value ; 3:json ; 4:csv)\n");
+    printf("\t-o file   : write json/csv results to file (default: stdout, other output moves to stderr)\n");
     printf("\t-f family : test only the given family\n");
 	printf("\t-n loops  : override default loops number\n");
     printf("\t-s size   : override default sizes\n");
+    printf("\t-w runs   : number of untimed warm-up runs (default %zu)\n", ccperf_options.nwarmup);
+    printf("\t-r runs   : maximum number of timed runs (default %zu)\n", ccperf_options.nruns_max);
+    printf("\t-c cpu    : pin to the given cpu\n");
+    printf("\t-x        : compare two json/csv result files: -x [-T threshold] old new\n");
+    printf("\t-T thres  : regression threshold in percent of the median (default 5)\n");
     printf("\t-S seed   : use a specific seed (ex. 8686b151ec2aa17c4ec41a59e496d2ff)\n");
     printf("\t-l        : don\'t run the test, just print a list\n");
 	printf("\t-h        : help\n");
@@ -340,12 +382,16 @@ int ccperf_main(int argc CC_UNUSED, char **argv CC_UNUSED)
     int loops = -1;
     size_t sizes = 0;
     const char *seed = NULL;
+    const char *output = NULL;
+    int cpu = -1;
+    int compare = 0;
+    double threshold = 5.0;
 #if defined(_WIN32) // command-line excluded from windows
     printf("command-line options are not supported under Windows");
 #else
     int r = 0;
     do {
-        r = getopt(argc, argv, "hlf:n:s:d:S:");
+        r = getopt(argc, argv, "hlxf:n:s:d:S:o:w:r:c:T:");
         bool err = false;
         switch (r){
             case 'h':
@@ -376,6 +422,30 @@ int ccperf_main(int argc CC_UNUSED, char **argv CC_UNUSED)
                     err = true;
                 }
                 break;
+            case 'o':
+                output = optarg;
+                break;
+            case 'w':
+                ccperf_options.nwarmup = (size_t)atol(optarg);
+                break;
+            case 'r':
+                ccperf_options.nruns_max = (size_t)atol(optarg);
+                if (ccperf_options.nruns_max == 0) {
+                    err = true;
+                }
+                break;
+            case 'c':
+                cpu = atoi(optarg);
+                break;
+            case 'x':
+                compare = 1;
+                break;
+            case 'T':
+                threshold = atof(optarg);
+                if (threshold < 0) {
+                    err = true;
+                }
+                break;
             case -1:
                 break;
             case '?':
@@ -388,14 +458,62 @@ int ccperf_main(int argc CC_UNUSED, char **argv CC_UNUSED)
             usage(argv);
         }
     } while (r != -1);
+
+    if (compare) {
+        if (argc - optind != 2) {
+            printf("Compare mode expects two result files\n");
+            usage(argv);
+        }
+        int nregressions = ccperf_compare(argv[optind], argv[optind + 1], threshold);
+        return nregressions == 0 ? 0 : 1;
+    }
 #endif
 
+    if (cpu >= 0) {
+        if (perf_pin_cpu(cpu)) {
+            printf("***WARNING: could not pin to cpu %d\n", cpu);
+        } else {
+            printf("Pinned to cpu %d\n", cpu);
+        }
+    }
+
+    struct ccperf_report report = { .out = stdout };
+    struct ccperf_report *preport = NULL;
+    if (display_mode == PERF_DISPLAY_JSON || display_mode == PERF_DISPLAY_CSV) {
+        report.format = display_mode == PERF_DISPLAY_JSON ? ccperf_report_json : ccperf_report_csv;
+        if (output) {
+            report.out = fopen(output, "w");
+            if (report.out == NULL) {
+                perror("Could not open output file");
+                exit(-1);
+            }
+        }
+#if !defined(_WIN32)
+        else {
+            // Keep the results alone on stdout, everything else goes to stderr.
+            int fd = dup(STDOUT_FILENO);
+            fflush(stdout);
+            report.out = fd < 0 ? NULL : fdopen(fd, "w");
+            if (report.out == NULL || dup2(STDERR_FILENO, STDOUT_FILENO) < 0) {
+                perror("Could not redirect stdout");
+                exit(-1);
+            }
+        }
+#endif
+        preport = &report;
+    }
+
     if (tests_rng(seed) != CCERR_OK) {
         perror("Could not initialize RNG\n");
         exit(-1);
     }
 
     perf_banner("perf", argc, argv);
+    printf("Cycle counter: %s\n", ccperf_cycles_source());
+
+    if (preport) {
+        ccperf_report_begin(preport);
+    }
 
     perf_start();
     for (i = 0; i < CC_ARRAY_LEN(ccperf_families); i++) {
@@ -417,7 +535,7 @@ int ccperf_main(int argc CC_UNUSED, char **argv CC_UNUSED)
             if (norun) {
                 test_list(f);
             } else {
-                perf_test_family(f, display_mode);
+                perf_test_family(f, display_mode, preport);
             }
         }
         free(f->sizes);
@@ -425,6 +543,12 @@ int ccperf_main(int argc CC_UNUSED, char **argv CC_UNUSED)
     }
 
     printf("\n\nTotal execution time %f seconds\n", perf_seconds());
+    if (preport) {
+        ccperf_report_end(preport);
+        if (preport->out != stdout) {
+            fclose(preport->out);
+        }
+    }
     ccrng_test_done(&test_rng);
     free(family_names);
     return 0;
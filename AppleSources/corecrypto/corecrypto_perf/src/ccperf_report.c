@@ -0,0 +1,370 @@
+/* Copyright (c) (2023) Apple Inc. All rights reserved.
+ *
+ * corecrypto is licensed under Apple Inc.’s Internal Use License Agreement (which
+ * is contained in the License.txt file distributed with corecrypto) and only to
+ * people who accept that license. IMPORTANT:  Any license rights granted to you by
+ * Apple Inc. (if any) are limited to internal use within your organization only on
+ * devices and computers you own or control, for the sole purpose of verifying the
+ * security characteristics and correct functioning of the Apple Software.  You may
+ * not, directly or indirectly, redistribute the Apple Software or any portions thereof.
+ */
+
+#include "ccperf.h"
+#include <math.h>
+
+/*
+ Results are written one record per line so that ccperf_compare() can read
+ them back without a full JSON parser. All durations are in seconds per
+ operation (i.e. divided by the number of loops), cycles are per operation.
+ */
+
+#define CCPERF_REPORT_CSV_HEADER "family,test,size,unit,loops,nruns,min,median,mad,p90,p99,cycles,cycles_source\n"
+
+// Family and test names are written first, quoted and escaped, followed by these fields.
+#define CCPERF_REPORT_JSON_FMT                                                                                  \
+    ", \"size\": %zu, \"unit\": \"%s\", \"loops\": %zu, \"nruns\": %zu, "                                    \
+    "\"min\": %.6e, \"median\": %.6e, \"mad\": %.6e, \"p90\": %.6e, \"p99\": %.6e, \"cycles\": %.1f, "          \
+    "\"cycles_source\": \"%s\"}"
+
+#define CCPERF_REPORT_CSV_FMT ",%zu,%s,%zu,%zu,%.6e,%.6e,%.6e,%.6e,%.6e,%.1f,%s\n"
+
+static const char *size_unit(enum ccperf_size_kind kind)
+{
+    switch (kind) {
+    case ccperf_size_bytes: return "byte";
+    case ccperf_size_bits: return "bit";
+    case ccperf_size_iterations: return "itn";
+    case ccperf_size_units: return "unit";
+    }
+    return "unit";
+}
+
+static void json_write_string(FILE *out, const char *str)
+{
+    fputc('"', out);
+    for (; *str; str++) {
+        unsigned char c = (unsigned char)*str;
+        if (c == '"' || c == '\\') {
+            fprintf(out, "\\%c", c);
+        } else if (c < 0x20) {
+            fprintf(out, "\\u%04x", c);
+        } else {
+            fputc(c, out);
+        }
+    }
+    fputc('"', out);
+}
+
+// Quotes every field, RFC 4180 style, doubling embedded quotes.
+static void csv_write_string(FILE *out, const char *str)
+{
+    fputc('"', out);
+    for (; *str; str++) {
+        if (*str == '"') {
+            fputc('"', out);
+        }
+        fputc(*str, out);
+    }
+    fputc('"', out);
+}
+
+void ccperf_report_begin(struct ccperf_report *report)
+{
+    report->nresults = 0;
+
+    if (report->format == ccperf_report_json) {
+        fprintf(report->out, "[\n");
+    } else {
+        fprintf(report->out, CCPERF_REPORT_CSV_HEADER);
+    }
+}
+
+void ccperf_report_result(struct ccperf_report *report, const struct ccperf_family *f, size_t size,
+                          const struct ccperf_test *test, double noop_time, double noop_cycles)
+{
+    const struct ccperf_stats *s = &f->stats;
+    double loops = (double)f->loops;
+
+    // Subtract the loop overhead from every order statistic, like the human readable output does.
+    double min = s->min >= noop_time ? s->min - noop_time : s->min;
+    double median = s->median >= noop_time ? s->median - noop_time : s->median;
+    double p90 = s->p90 >= noop_time ? s->p90 - noop_time : s->p90;
+    double p99 = s->p99 >= noop_time ? s->p99 - noop_time : s->p99;
+    double cycles = s->cycles >= noop_cycles ? s->cycles - noop_cycles : s->cycles;
+
+    if (report->format == ccperf_report_json) {
+        fprintf(report->out, "%s  {\"family\": ", report->nresults ? ",\n" : "");
+        json_write_string(report->out, f->name);
+        fprintf(report->out, ", \"test\": ");
+        json_write_string(report->out, test->name);
+        fprintf(report->out, CCPERF_REPORT_JSON_FMT, size, size_unit(f->size_kind), f->loops, f->nruns,
+                min / loops, median / loops, s->mad / loops, p90 / loops, p99 / loops, cycles / loops,
+                ccperf_cycles_source());
+    } else {
+        csv_write_string(report->out, f->name);
+        fputc(',', report->out);
+        csv_write_string(report->out, test->name);
+        fprintf(report->out, CCPERF_REPORT_CSV_FMT, size, size_unit(f->size_kind), f->loops, f->nruns,
+                min / loops, median / loops, s->mad / loops, p90 / loops, p99 / loops, cycles / loops,
+                ccperf_cycles_source());
+    }
+
+    report->nresults++;
+    fflush(report->out);
+}
+
+void ccperf_report_end(struct ccperf_report *report)
+{
+    if (report->format == ccperf_report_json) {
+        fprintf(report->out, "%s]\n", report->nresults ? "\n" : "");
+    }
+    fflush(report->out);
+}
+
+/* Compare mode */
+
+struct ccperf_record {
+    char family[64];
+    char test[128];
+    size_t size;
+    double median;
+    double mad;
+    double cycles;
+    bool matched;
+};
+
+struct ccperf_records {
+    struct ccperf_record *records;
+    size_t n;
+};
+
+/* Skips prefix at the start of *line, returns false when it is not there. */
+static bool parse_prefix(const char **line, const char *prefix)
+{
+    size_t len = strlen(prefix);
+    if (strncmp(*line, prefix, len)) {
+        return false;
+    }
+    *line += len;
+    return true;
+}
+
+/* Reads a string written by json_write_string(), returns false if malformed or too long. */
+static bool json_parse_string(const char **line, char *str, size_t size)
+{
+    const char *p = *line;
+    size_t n = 0;
+
+    if (*p++ != '"') {
+        return false;
+    }
+
+    for (; *p != '"'; p++) {
+        unsigned c;
+        if (*p == '\0' || n + 1 == size) {
+            return false;
+        }
+        if (*p != '\\') {
+            str[n++] = *p;
+            continue;
+        }
+        p++;
+        if (*p == 'u') {
+            if (sscanf(p + 1, "%4x", &c) != 1 || c > 0x7f) {
+                return false;
+            }
+            str[n++] = (char)c;
+            p += 4;
+        } else if (*p == '"' || *p == '\\') {
+            str[n++] = *p;
+        } else {
+            return false;
+        }
+    }
+
+    str[n] = '\0';
+    *line = p + 1;
+    return true;
+}
+
+/* Reads a CSV field, quoted or not, returns false if malformed or too long. */
+static bool csv_parse_string(const char **line, char *str, size_t size)
+{
+    const char *p = *line;
+    size_t n = 0;
+
+    if (*p != '"') {
+        for (; *p != ',' && *p != '\0'; p++) {
+            if (n + 1 == size) {
+                return false;
+            }
+            str[n++] = *p;
+        }
+    } else {
+        for (p++; *p != '"' || p[1] == '"'; p++) {
+            if (*p == '\0' || n + 1 == size) {
+                return false;
+            }
+            if (*p == '"') {
+                p++; // Doubled quote
+            }
+            str[n++] = *p;
+        }
+        p++;
+    }
+
+    str[n] = '\0';
+    *line = p;
+    return true;
+}
+
+/* Parses one line of JSON or CSV output, returns false for any other line (headers, brackets, logs). */
+static bool ccperf_parse_record(const char *line, struct ccperf_record *r)
+{
+    char unit[16];
+    size_t loops, nruns;
+    double min, p90, p99;
+
+    while (*line == ' ' || *line == '\t' || *line == ',') {
+        line++;
+    }
+
+    memset(r, 0, sizeof(*r));
+
+    if (*line == '{') {
+        return parse_prefix(&line, "{\"family\": ") &&
+               json_parse_string(&line, r->family, sizeof(r->family)) &&
+               parse_prefix(&line, ", \"test\": ") &&
+               json_parse_string(&line, r->test, sizeof(r->test)) &&
+               sscanf(line,
+                      ", \"size\": %zu, \"unit\": \"%15[^\"]\", "
+                      "\"loops\": %zu, \"nruns\": %zu, \"min\": %lf, \"median\": %lf, \"mad\": %lf, "
+                      "\"p90\": %lf, \"p99\": %lf, \"cycles\": %lf",
+                      &r->size, unit, &loops, &nruns,
+                      &min, &r->median, &r->mad, &p90, &p99, &r->cycles) == 10;
+    }
+
+    return csv_parse_string(&line, r->family, sizeof(r->family)) &&
+           parse_prefix(&line, ",") &&
+           csv_parse_string(&line, r->test, sizeof(r->test)) &&
+           sscanf(line, ",%zu,%15[^,],%zu,%zu,%lf,%lf,%lf,%lf,%lf,%lf",
+                  &r->size, unit, &loops, &nruns,
+                  &min, &r->median, &r->mad, &p90, &p99, &r->cycles) == 10;
+}
+
+static int ccperf_load_records(const char *path, struct ccperf_records *rs)
+{
+    char line[1024];
+    size_t cap = 0;
+
+    rs->records = NULL;
+    rs->n = 0;
+
+    FILE *fp = fopen(path, "r");
+    if (fp == NULL) {
+        fprintf(stderr, "Could not open %s\n", path);
+        return -1;
+    }
+
+    while (fgets(line, sizeof(line), fp)) {
+        struct ccperf_record r;
+        if (!ccperf_parse_record(line, &r)) {
+            continue;
+        }
+
+        if (rs->n == cap) {
+            cap = cap ? 2 * cap : 64;
+            struct ccperf_record *records = realloc(rs->records, cap * sizeof(*records));
+            if (records == NULL) {
+                fclose(fp);
+                return -1;
+            }
+            rs->records = records;
+        }
+        rs->records[rs->n++] = r;
+    }
+
+    fclose(fp);
+    return 0;
+}
+
+static struct ccperf_record *ccperf_find_record(struct ccperf_records *rs, const struct ccperf_record *key)
+{
+    for (size_t i = 0; i < rs->n; i++) {
+        struct ccperf_record *r = &rs->records[i];
+        if (!r->matched && r->size == key->size &&
+            strcmp(r->family, key->family) == 0 && strcmp(r->test, key->test) == 0) {
+            return r;
+        }
+    }
+    return NULL;
+}
+
+/*
+ A test regressed when its median grew by more than threshold_percent, and
+ by more than the sum of both MADs so that noisy tests are not flagged.
+ */
+int ccperf_compare(const char *old_path, const char *new_path, double threshold_percent)
+{
+    struct ccperf_records old_rs, new_rs;
+    int nregressions = 0;
+    size_t nimprovements = 0, nmissing = 0;
+
+    if (ccperf_load_records(old_path, &old_rs)) {
+        free(old_rs.records);
+        return -1;
+    }
+    if (ccperf_load_records(new_path, &new_rs)) {
+        free(old_rs.records);
+        free(new_rs.records);
+        return -1;
+    }
+
+    printf("Comparing %s (%zu results) to %s (%zu results), threshold %.2f%%\n\n",
+           old_path, old_rs.n, new_path, new_rs.n, threshold_percent);
+    printf("%-56s %10s %10s %8s\n", "test", "old", "new", "change");
+
+    for (size_t i = 0; i < new_rs.n; i++) {
+        struct ccperf_record *n = &new_rs.records[i];
+        struct ccperf_record *o = ccperf_find_record(&old_rs, n);
+        char name[sizeof(n->family) + sizeof(n->test) + 24];
+
+        snprintf(name, sizeof(name), "%s/%s[%zu]", n->family, n->test, n->size);
+
+        if (o == NULL) {
+            printf("%-56s %10s %8.3gs %8s   new\n", name, "-", n->median, "-");
+            continue;
+        }
+        o->matched = true;
+
+        double delta = n->median - o->median;
+        double change = o->median > 0 ? 100.0 * delta / o->median : 0.0;
+        const char *status = "";
+
+        if (fabs(change) > threshold_percent && fabs(delta) > o->mad + n->mad) {
+            if (delta > 0) {
+                status = "REGRESSION";
+                nregressions++;
+            } else {
+                status = "improved";
+                nimprovements++;
+            }
+        }
+
+        printf("%-56s %9.3gs %9.3gs %+7.2f%%   %s\n", name, o->median, n->median, change, status);
+    }
+
+    for (size_t i = 0; i < old_rs.n; i++) {
+        struct ccperf_record *o = &old_rs.records[i];
+        if (!o->matched) {
+            printf("%s/%s[%zu] missing from %s\n", o->family, o->test, o->size, new_path);
+            nmissing++;
+        }
+    }
+
+    printf("\n%d regression(s), %zu improvement(s), %zu missing\n", nregressions, nimprovements, nmissing);
+
+    free(old_rs.records);
+    free(new_rs.records);
+    return nregressions;
+}
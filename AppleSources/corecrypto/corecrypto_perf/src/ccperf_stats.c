@@ -12,25 +12,171 @@
 #include "ccperf.h"
 #include <math.h>
 
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <x86intrin.h>
+#define CCPERF_HAS_RDTSC 1
+#else
+#define CCPERF_HAS_RDTSC 0
+#endif
+
+struct ccperf_options ccperf_options = {
+    .nwarmup = 1,
+    .nruns_max = 500,
+};
+
+/* Cycle counter */
+
+enum ccperf_counter {
+    ccperf_counter_uninitialized = 0,
+    ccperf_counter_none,
+    ccperf_counter_perf_event,
+    ccperf_counter_rdtsc,
+};
+
+static enum ccperf_counter counter;
+static int counter_fd = -1;
+static uint64_t counter_start;
+static uint64_t counter_cycles;
+
+static void ccperf_counter_init(void)
+{
+    counter = ccperf_counter_none;
+
+#if defined(__linux__)
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_CPU_CYCLES;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+
+    counter_fd = (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+    if (counter_fd >= 0) {
+        counter = ccperf_counter_perf_event;
+        return;
+    }
+#endif
+
+#if CCPERF_HAS_RDTSC
+    counter = ccperf_counter_rdtsc;
+#endif
+}
+
+static uint64_t ccperf_counter_read(void)
+{
+    switch (counter) {
+#if defined(__linux__)
+    case ccperf_counter_perf_event: {
+        uint64_t v;
+        if (read(counter_fd, &v, sizeof(v)) != sizeof(v)) {
+            return 0;
+        }
+        return v;
+    }
+#endif
+#if CCPERF_HAS_RDTSC
+    case ccperf_counter_rdtsc:
+        return __rdtsc();
+#endif
+    default:
+        return 0;
+    }
+}
+
+const char *ccperf_cycles_source(void)
+{
+    if (counter == ccperf_counter_uninitialized) {
+        ccperf_counter_init();
+    }
+
+    switch (counter) {
+    case ccperf_counter_perf_event: return "perf_event";
+    case ccperf_counter_rdtsc: return "rdtsc";
+    default: return "none";
+    }
+}
+
+uint64_t ccperf_start(void)
+{
+    if (counter == ccperf_counter_uninitialized) {
+        ccperf_counter_init();
+    }
+
+    counter_start = ccperf_counter_read();
+    return cc_absolute_time();
+}
+
+double ccperf_seconds(uint64_t start)
+{
+    uint64_t t = cc_absolute_time();
+    counter_cycles = ccperf_counter_read() - counter_start;
+    return cc_absolute_time_to_sec((double)(t - start));
+}
+
+uint64_t ccperf_cycles(void)
+{
+    return counter_cycles;
+}
+
 
 static int compare_doubles(const void *a, const void *b) {
     const double x = *(const double *)a, y = *(const double *)b;
     return x < y ? -1 : x == y ? 0 : 1;
 }
 
+/* Nearest-rank percentile of sorted values. */
+static double percentile(const double *sorted, unsigned int n, unsigned int p)
+{
+    unsigned int rank = (p * n + 99) / 100;
+    return sorted[rank ? rank - 1 : 0];
+}
+
+static void ccperf_compute_stats(struct ccperf_stats *stats, const double *runs, double *cycles, unsigned int nruns)
+{
+    double *dev = calloc(nruns, sizeof(double));
+
+    stats->min = runs[0];
+    stats->median = runs[nruns / 2];
+    stats->p90 = percentile(runs, nruns, 90);
+    stats->p99 = percentile(runs, nruns, 99);
+
+    for (unsigned int run = 0; run < nruns; ++run) {
+        dev[run] = fabs(runs[run] - stats->median);
+    }
+    qsort(dev, nruns, sizeof(double), compare_doubles);
+    stats->mad = dev[nruns / 2];
+
+    qsort(cycles, nruns, sizeof(double), compare_doubles);
+    stats->cycles = cycles[nruns / 2];
+
+    free(dev);
+}
+
 double histogram_sieve(struct ccperf_family *f, size_t *psize, const void *arg)
 {
     const unsigned int nruns_min = 10;
-    const unsigned int nruns_max = 500;
+    const unsigned int nruns_max = (unsigned int)ccperf_options.nruns_max;
     unsigned int nruns=nruns_max;
     double *runs = calloc(nruns_max, sizeof(double));
+    double *cycles = calloc(nruns_max, sizeof(double));
     /* Run the function nruns times. */
     struct standard_deviation sd;
     double tt=0;
 
+    for (size_t run = 0; run < ccperf_options.nwarmup; ++run) {
+        (void)f->func(f->loops, psize, arg);
+    }
+
     for (unsigned int run = 0; run < nruns_max; ++run) {
         double t = f->func(f->loops, psize, arg);
         runs[run] = t;
+        cycles[run] = (double)ccperf_cycles();
 
         if (run) {
             standard_deviation_add(&sd, t);
@@ -50,6 +196,7 @@ double histogram_sieve(struct ccperf_family *f, size_t *psize, const void *arg)
 
     /* Sort the run times. */
     qsort(runs, nruns, sizeof(double), compare_doubles);
+    ccperf_compute_stats(&f->stats, runs, cycles, nruns);
     /* Now find the longest series in nruns that has close to the same value. */
     /* Perhaps we'd like to define close in terms of sigma. */
     // double sigma = standard_deviation_sigma(&sd);
@@ -130,6 +277,7 @@ double histogram_sieve(struct ccperf_family *f, size_t *psize, const void *arg)
     // Consider averaging runs[best] - runs[best + best_len]
     double result = runs[best];
     free(runs);
+    free(cycles);
 
     return result;
 #if 0
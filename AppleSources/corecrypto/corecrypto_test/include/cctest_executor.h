@@ -0,0 +1,21 @@
+/* Copyright (c) (2023) Apple Inc. All rights reserved.
+ *
+ * corecrypto is licensed under Apple Inc.’s Internal Use License Agreement (which
+ * is contained in the License.txt file distributed with corecrypto) and only to
+ * people who accept that license. IMPORTANT:  Any license rights granted to you by
+ * Apple Inc. (if any) are limited to internal use within your organization only on
+ * devices and computers you own or control, for the sole purpose of verifying the
+ * security characteristics and correct functioning of the Apple Software.  You may
+ * not, directly or indirectly, redistribute the Apple Software or any portions thereof.
+ */
+
+#ifndef _CORECRYPTO_CCTEST_EXECUTOR_H_
+#define _CORECRYPTO_CCTEST_EXECUTOR_H_
+
+#include <corecrypto/cc_executor.h>
+
+// Executor running every work item on its own thread. Work items
+// for which no thread could be created run on the calling thread.
+extern const struct cc_executor cctest_executor;
+
+#endif /* _CORECRYPTO_CCTEST_EXECUTOR_H_ */
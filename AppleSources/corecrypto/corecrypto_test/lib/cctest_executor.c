@@ -0,0 +1,57 @@
+/* Copyright (c) (2023) Apple Inc. All rights reserved.
+ *
+ * corecrypto is licensed under Apple Inc.’s Internal Use License Agreement (which
+ * is contained in the License.txt file distributed with corecrypto) and only to
+ * people who accept that license. IMPORTANT:  Any license rights granted to you by
+ * Apple Inc. (if any) are limited to internal use within your organization only on
+ * devices and computers you own or control, for the sole purpose of verifying the
+ * security characteristics and correct functioning of the Apple Software.  You may
+ * not, directly or indirectly, redistribute the Apple Software or any portions thereof.
+ */
+
+#include "cc_internal.h"
+#include "cctest_executor.h"
+#include <pthread.h>
+
+struct cctest_executor_job {
+    void *work_ctx;
+    void (*work)(void *work_ctx, size_t i);
+    size_t i;
+};
+
+static void *cctest_executor_thread(void *arg)
+{
+    struct cctest_executor_job *job = arg;
+    job->work(job->work_ctx, job->i);
+    return NULL;
+}
+
+static void cctest_executor_apply(const struct cc_executor *executor CC_UNUSED,
+                                  size_t n,
+                                  void *work_ctx,
+                                  void (*work)(void *work_ctx, size_t i))
+{
+    if (n == 0) {
+        return;
+    }
+
+    pthread_t threads[n];
+    struct cctest_executor_job jobs[n];
+    bool started[n];
+
+    for (size_t i = 0; i < n; i++) {
+        jobs[i] = (struct cctest_executor_job){ .work_ctx = work_ctx, .work = work, .i = i };
+        started[i] = pthread_create(&threads[i], NULL, cctest_executor_thread, &jobs[i]) == 0;
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        if (!started[i]) {
+            work(work_ctx, i);
+        } else if (pthread_join(threads[i], NULL)) {
+            // The work item might still be running, we can't go on.
+            cc_try_abort("pthread_join failed");
+        }
+    }
+}
+
+const struct cc_executor cctest_executor = { .apply = cctest_executor_apply };
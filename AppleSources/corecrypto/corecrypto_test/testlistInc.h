@@ -114,7 +114,7 @@ ONE_TEST(ccprime_rabin_miller)
 #if CC_DARWIN || CC_USE_L4
     ONE_TEST(ccfips_trace)
 #endif
-#if !CC_LINUX && !defined(_MSC_VER)
+#if !defined(_MSC_VER)
 ONE_TEST(cckprng)
 #endif
 ONE_TEST(cch2c)
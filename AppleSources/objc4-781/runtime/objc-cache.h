@@ -12,6 +12,8 @@ extern IMP cache_getImp(Class cls, SEL sel);
 
 extern void cache_fill(Class cls, SEL sel, IMP imp, id receiver);
 
+extern IMP cache_getVictimImp(Class cls, SEL sel);
+
 extern void cache_erase_nolock(Class cls);
 
 extern void cache_delete(Class cls);
@@ -635,6 +635,112 @@ void cache_t::bad_cache(id receiver, SEL sel, Class isa)
          "invalid object, or a memory error somewhere else.");
 }
 
+/***********************************************************************
+* Per-class cache statistics for OBJC_DEBUG_CACHE_STATISTICS.
+* Hits in the method cache itself are not counted: objc_msgSend's
+* fast path is left alone.
+* Locking: runtimeLock must be held.
+**********************************************************************/
+static objc::DenseMap<Class, objc_cache_statistics> *cacheStatistics;
+
+static objc_cache_statistics *statisticsForClass(Class cls)
+{
+    runtimeLock.assertLocked();
+
+    if (!cacheStatistics) {
+        cacheStatistics = new objc::DenseMap<Class, objc_cache_statistics>();
+    }
+    return &(*cacheStatistics)[cls];
+}
+
+
+/***********************************************************************
+* Victim cache.
+* cache_t::insert throws a cache's contents away when it grows. The 
+* entries dropped are kept here, in a direct-mapped table shared by all 
+* classes, and lookUpImpOrForward checks it before searching method 
+* lists, so a polymorphic call site refills its caches without repeating 
+* every method list search.
+*
+* Entries are only valid for the victim_cache_epoch they were added in. 
+* Erasing or deleting any cache advances the epoch: methods or classes 
+* changed somewhere, and nothing here may outlive that.
+* Forwarding entries are not kept, so a miss still reaches the resolver.
+*
+* Locking: runtimeLock must be held.
+**********************************************************************/
+enum {
+    VICTIM_CACHE_SIZE_LOG2 = 10,
+    VICTIM_CACHE_SIZE      = (1 << VICTIM_CACHE_SIZE_LOG2),
+};
+
+struct victim_entry_t {
+    Class cls;
+    uintptr_t epoch;
+    bucket_t bucket;
+};
+
+static victim_entry_t *victim_cache;
+static uintptr_t victim_cache_epoch = 1;  // calloc'd entries are invalid
+
+static inline victim_entry_t *victim_entry(Class cls, SEL sel)
+{
+    uintptr_t index = ptr_hash((uintptr_t)cls ^ (uintptr_t)sel);
+    return &victim_cache[index & (VICTIM_CACHE_SIZE - 1)];
+}
+
+static void victim_cache_invalidate()
+{
+    victim_cache_epoch++;
+}
+
+// Keep the live entries of cls's buckets, which are about to be discarded.
+static void victim_cache_add_buckets(Class cls, bucket_t *b, mask_t capacity)
+{
+    runtimeLock.assertLocked();
+
+    if (DisableVictimCache) return;
+
+    if (!victim_cache) {
+        victim_cache = (victim_entry_t *)
+            calloc(VICTIM_CACHE_SIZE, sizeof(victim_entry_t));
+    }
+
+    for (mask_t i = 0; i < capacity; i++) {
+        SEL sel = b[i].sel();
+        if (sel == 0) continue;
+#if CACHE_END_MARKER
+        if (sel == (SEL)(uintptr_t)1) continue;
+#endif
+        IMP imp = b[i].imp(cls);
+        if (imp == (IMP)_objc_msgForward_impcache) continue;
+
+        victim_entry_t *entry = victim_entry(cls, sel);
+        bzero(&entry->bucket, sizeof(entry->bucket));
+        entry->bucket.set<NotAtomic, Encoded>(sel, imp, cls);
+        entry->cls = cls;
+        entry->epoch = victim_cache_epoch;
+    }
+}
+
+IMP cache_getVictimImp(Class cls, SEL sel)
+{
+    runtimeLock.assertLocked();
+
+    if (!victim_cache) return nil;
+
+    victim_entry_t *entry = victim_entry(cls, sel);
+    if (entry->cls != cls  ||  entry->epoch != victim_cache_epoch  ||
+        entry->bucket.sel() != sel)
+    {
+        return nil;
+    }
+
+    if (DebugCacheStatistics) statisticsForClass(cls)->victimHits++;
+    return entry->bucket.imp(cls);
+}
+
+
 ALWAYS_INLINE
 void cache_t::insert(Class cls, SEL sel, IMP imp, id receiver)
 {
@@ -662,6 +768,12 @@ void cache_t::insert(Class cls, SEL sel, IMP imp, id receiver)
         if (capacity > MAX_CACHE_SIZE) {
             capacity = MAX_CACHE_SIZE;
         }
+        if (DebugCacheStatistics) {
+            objc_cache_statistics *stats = statisticsForClass(cls);
+            stats->resizes++;
+            stats->evictions += occupied();
+        }
+        victim_cache_add_buckets(cls, buckets(), oldCapacity);
         reallocate(oldCapacity, capacity, true);
     }
 
@@ -700,6 +812,7 @@ void cache_fill(Class cls, SEL sel, IMP imp, id receiver)
 #if CONFIG_USE_CACHE_LOCK
         mutex_locker_t lock(cacheUpdateLock);
 #endif
+        if (DebugCacheStatistics) statisticsForClass(cls)->misses++;
         cache->insert(cls, sel, imp, receiver);
     }
 #else
@@ -720,8 +833,11 @@ void cache_erase_nolock(Class cls)
 
     cache_t *cache = getCache(cls);
 
+    victim_cache_invalidate();
+
     mask_t capacity = cache->capacity();
     if (capacity > 0  &&  cache->occupied() > 0) {
+        if (DebugCacheStatistics) statisticsForClass(cls)->flushes++;
         auto oldBuckets = cache->buckets();
         auto buckets = emptyBucketsForCapacity(capacity);
         cache->setBucketsAndMask(buckets, capacity - 1); // also clears occupied
@@ -738,6 +854,9 @@ void cache_delete(Class cls)
 #else
     runtimeLock.assertLocked();
 #endif
+    victim_cache_invalidate();
+    if (cacheStatistics) cacheStatistics->erase(cls);
+
     if (cls->cache.canBeFreed()) {
         if (PrintCaches) recordDeadCache(cls->cache.capacity());
         free(cls->cache.buckets());
@@ -745,6 +864,57 @@ void cache_delete(Class cls)
 }
 
 
+/***********************************************************************
+* _objc_getCacheStatistics
+* _objc_printCacheStatistics
+* Debugging SPI for OBJC_DEBUG_CACHE_STATISTICS.
+* Locking: acquires runtimeLock
+**********************************************************************/
+bool _objc_getCacheStatistics(Class cls, struct objc_cache_statistics *outStats)
+{
+    mutex_locker_t lock(runtimeLock);
+
+    if (!cls  ||  !cacheStatistics) return false;
+
+    auto it = cacheStatistics->find(cls);
+    if (it == cacheStatistics->end()) return false;
+
+    *outStats = it->second;
+    return true;
+}
+
+void _objc_printCacheStatistics(unsigned limit)
+{
+    mutex_locker_t lock(runtimeLock);
+
+    if (!cacheStatistics) {
+        _objc_inform("CACHES: no statistics (set OBJC_DEBUG_CACHE_STATISTICS)");
+        return;
+    }
+
+    // Worst offenders first.
+    typedef std::pair<Class, objc_cache_statistics> Entry;
+    std::vector<Entry> entries(cacheStatistics->begin(), cacheStatistics->end());
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b){
+        return a.second.misses > b.second.misses;
+    });
+    if (limit == 0  ||  limit > entries.size()) limit = (unsigned)entries.size();
+
+    for (unsigned i = 0; i < limit; i++) {
+        Class cls = entries[i].first;
+        const objc_cache_statistics& stats = entries[i].second;
+        _objc_inform("CACHES: %s%s: %llu misses, %llu victim hits, "
+                     "%llu evictions, %llu resizes, %llu flushes",
+                     cls->isMetaClass() ? "+" : "-", cls->nameForLogging(),
+                     (unsigned long long)stats.misses,
+                     (unsigned long long)stats.victimHits,
+                     (unsigned long long)stats.evictions,
+                     (unsigned long long)stats.resizes,
+                     (unsigned long long)stats.flushes);
+    }
+}
+
+
 /***********************************************************************
 * cache collection.
 **********************************************************************/
@@ -36,10 +36,13 @@ OPTION( DebugMissingPools,        OBJC_DEBUG_MISSING_POOLS,        "warn about a
 OPTION( DebugPoolAllocation,      OBJC_DEBUG_POOL_ALLOCATION,      "halt when autorelease pools are popped out of order, and allow heap debuggers to track autorelease pools")
 OPTION( DebugDuplicateClasses,    OBJC_DEBUG_DUPLICATE_CLASSES,    "halt when multiple classes with the same name are present")
 OPTION( DebugDontCrash,           OBJC_DEBUG_DONT_CRASH,           "halt the process by exiting instead of crashing")
+OPTION( DebugCacheStatistics,     OBJC_DEBUG_CACHE_STATISTICS,     "record per-class method cache misses, evictions, resizes and flushes for _objc_printCacheStatistics()")
 
 OPTION( DisableVtables,           OBJC_DISABLE_VTABLES,            "disable vtable dispatch")
 OPTION( DisablePreopt,            OBJC_DISABLE_PREOPTIMIZATION,    "disable preoptimization courtesy of dyld shared cache")
 OPTION( DisableTaggedPointers,    OBJC_DISABLE_TAGGED_POINTERS,    "disable tagged pointer optimization of NSNumber et al.") 
 OPTION( DisableTaggedPointerObfuscation, OBJC_DISABLE_TAG_OBFUSCATION,    "disable obfuscation of tagged pointers")
 OPTION( DisableNonpointerIsa,     OBJC_DISABLE_NONPOINTER_ISA,     "disable non-pointer isa fields")
+OPTION( DisableThinSync,          OBJC_DISABLE_THIN_SYNC,          "disable the thin-lock fast path of @synchronized")
+OPTION( DisableVictimCache,       OBJC_DISABLE_VICTIM_CACHE,       "disable the second-level cache of method cache entries dropped when a cache grows")
 OPTION( DisableInitializeForkSafety, OBJC_DISABLE_INITIALIZE_FORK_SAFETY, "disable safety checks for +initialize after fork")
@@ -876,6 +876,40 @@ typedef void (*_objc_func_willInitializeClass)(void * _Nullable context, Class _
 OBJC_EXPORT void _objc_addWillInitializeClassFunc(_objc_func_willInitializeClass _Nonnull func, void * _Nullable context)
     OBJC_AVAILABLE(10.15, 13.0, 13.0, 6.0, 4.0);
 
+/**
+ * Per-class method cache statistics, recorded when the
+ * OBJC_DEBUG_CACHE_STATISTICS environment variable is set.
+ * Hits in the method cache itself are not counted.
+ */
+struct objc_cache_statistics {
+    uint64_t misses;      // lookups that missed the method cache and filled it
+    uint64_t victimHits;  // of those, answered by the second-level victim cache
+    uint64_t evictions;   // entries discarded when the method cache grew
+    uint64_t resizes;     // times the method cache grew
+    uint64_t flushes;     // times a non-empty method cache was flushed
+};
+
+/**
+ * Copy the cache statistics of a class.
+ *
+ * @param cls The class (or metaclass).
+ * @param outStats Receives the statistics.
+ * @return false if nothing was recorded for cls.
+ */
+OBJC_EXPORT bool
+_objc_getCacheStatistics(Class _Nonnull cls,
+                         struct objc_cache_statistics * _Nonnull outStats)
+    OBJC_AVAILABLE(10.16, 14.0, 14.0, 7.0, 6.0);
+
+/**
+ * Log the cache statistics of the classes with the most misses.
+ *
+ * @param limit The number of classes to log, or 0 for all of them.
+ */
+OBJC_EXPORT void
+_objc_printCacheStatistics(unsigned limit)
+    OBJC_AVAILABLE(10.16, 14.0, 14.0, 7.0, 6.0);
+
 // API to only be called by classes that provide their own reference count storage
 
 OBJC_EXPORT void
@@ -41,7 +41,7 @@ enum {
     OBJC_ASSOCIATION_GETTER_AUTORELEASE = (2 << 8)
 };
 
-spinlock_t AssociationsManagerLock;
+StripedMap<spinlock_t> AssociationsManagerLocks;
 
 namespace objc {
 
@@ -96,32 +96,272 @@ public:
         }
         return _value;
     }
+
+    // Nonatomic getters return the value without retaining it, 
+    // so they don't need the lock to keep it alive.
+    inline bool isNonatomic() const {
+        return !(_policy & (OBJC_ASSOCIATION_GETTER_RETAIN | 
+                            OBJC_ASSOCIATION_GETTER_AUTORELEASE));
+    }
 };
 
 typedef DenseMap<const void *, ObjcAssociation> ObjectAssociationMap;
 typedef DenseMap<DisguisedPtr<objc_object>, ObjectAssociationMap> AssociationsHashMap;
 
-// class AssociationsManager manages a lock / hash table singleton pair.
-// Allocating an instance acquires the lock
+// The association of an object that has only one. 
+// Written with the stripe lock held, read without it.
+// The object is disguised like DisguisedPtr, so zero means the slot is free.
+struct InlineAssociation {
+    std::atomic<uintptr_t> object;
+    std::atomic<const void *> key;
+    std::atomic<uintptr_t> policy;
+    std::atomic<id> value;
+
+    static uintptr_t disguise(objc_object *obj) {
+        return -(uintptr_t)obj;
+    }
+
+    ObjcAssociation association() const {
+        return ObjcAssociation{policy.load(std::memory_order_relaxed),
+                               value.load(std::memory_order_relaxed)};
+    }
+
+    void setAssociation(const ObjcAssociation &association) {
+        policy.store(association.policy(), std::memory_order_relaxed);
+        value.store(association.value(), std::memory_order_relaxed);
+    }
+
+    void set(uintptr_t newObject, const void *newKey, 
+             const ObjcAssociation &association) {
+        object.store(newObject, std::memory_order_relaxed);
+        key.store(newKey, std::memory_order_relaxed);
+        setAssociation(association);
+    }
+
+    void clear() {
+        set(0, nil, ObjcAssociation{});
+    }
+};
+
+// The associations of the objects in one stripe of AssociationsManagerLocks.
+//
+// Objects with a single association keep it in an inline slot; objects 
+// with more, or whose slots are all taken, keep them in the map. An 
+// object is never in both. Every change happens with the stripe lock 
+// held, between beginWrite() and endWrite(), which make _sequence odd 
+// and then even again. Getters read the inline slots and _mapCount 
+// without the lock and retry with the lock if _sequence changed.
+
+class AssociationsShard {
+    enum { InlineCount = 16, InlineProbe = 4 };
+
+    std::atomic<uint32_t> _sequence;
+    std::atomic<uint32_t> _mapCount;
+    InlineAssociation _inline[InlineCount];
+    AssociationsHashMap _map;
+
+    void beginWrite() {
+        _sequence.store(_sequence.load(std::memory_order_relaxed) + 1,
+                        std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+
+    void endWrite() {
+        _mapCount.store(_map.size(), std::memory_order_relaxed);
+        _sequence.store(_sequence.load(std::memory_order_relaxed) + 1,
+                        std::memory_order_release);
+    }
+
+    InlineAssociation *findInline(uintptr_t object) {
+        unsigned index = ptr_hash(object);
+        for (unsigned i = 0; i < InlineProbe; i++) {
+            InlineAssociation &slot = _inline[(index + i) % InlineCount];
+            if (slot.object.load(std::memory_order_relaxed) == object) {
+                return &slot;
+            }
+        }
+        return nil;
+    }
+
+public:
+    AssociationsShard() : _sequence(0), _mapCount(0), _inline{}, _map() { }
+
+    // Look up key without the lock. Returns false if the caller 
+    // must take the lock and call get() instead.
+    bool tryGetWithoutLock(objc_object *object, const void *key, 
+                           ObjcAssociation &result)
+    {
+        uint32_t sequence = _sequence.load(std::memory_order_acquire);
+        if (sequence & 1) return false;
+
+        ObjcAssociation association{};
+        if (InlineAssociation *slot = findInline(InlineAssociation::disguise(object))) {
+            if (slot->key.load(std::memory_order_relaxed) == key) {
+                association = slot->association();
+            }
+        } else if (_mapCount.load(std::memory_order_relaxed) != 0) {
+            return false;
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (_sequence.load(std::memory_order_relaxed) != sequence) return false;
+        if (!association.isNonatomic()) return false;
+
+        result = association;
+        return true;
+    }
+
+    ObjcAssociation get(objc_object *object, const void *key) {
+        if (InlineAssociation *slot = findInline(InlineAssociation::disguise(object))) {
+            if (slot->key.load(std::memory_order_relaxed) == key) {
+                return slot->association();
+            }
+            return ObjcAssociation{};
+        }
+
+        AssociationsHashMap::iterator i = _map.find(object);
+        if (i != _map.end()) {
+            ObjectAssociationMap &refs = i->second;
+            ObjectAssociationMap::iterator j = refs.find(key);
+            if (j != refs.end()) {
+                return j->second;
+            }
+        }
+        return ObjcAssociation{};
+    }
+
+    // Establish or replace the association for key. On return 
+    // association holds the replaced one, if any.
+    // Returns true if this is the object's first association.
+    bool set(objc_object *object, const void *key, ObjcAssociation &association) {
+        uintptr_t disguised = InlineAssociation::disguise(object);
+        bool first = false;
+
+        beginWrite();
+
+        if (InlineAssociation *slot = findInline(disguised)) {
+            if (slot->key.load(std::memory_order_relaxed) == key) {
+                ObjcAssociation old = slot->association();
+                slot->setAssociation(association);
+                association = old;
+            } else {
+                // A second key. Move the object to the map.
+                auto &refs = _map.try_emplace(object, ObjectAssociationMap{}).first->second;
+                refs.try_emplace(slot->key.load(std::memory_order_relaxed), 
+                                 slot->association());
+                refs.try_emplace(key, std::move(association));
+                slot->clear();
+            }
+        } else {
+            auto refs_it = _map.find(object);
+            if (refs_it == _map.end()) {
+                first = true;
+                unsigned index = ptr_hash(disguised);
+                for (unsigned i = 0; i < InlineProbe; i++) {
+                    InlineAssociation &slot = _inline[(index + i) % InlineCount];
+                    if (slot.object.load(std::memory_order_relaxed) == 0) {
+                        slot.set(disguised, key, association);
+                        association = ObjcAssociation{};
+                        endWrite();
+                        return first;
+                    }
+                }
+                refs_it = _map.try_emplace(object, ObjectAssociationMap{}).first;
+            }
+
+            auto result = refs_it->second.try_emplace(key, std::move(association));
+            if (!result.second) {
+                association.swap(result.first->second);
+            }
+        }
+
+        endWrite();
+        return first;
+    }
+
+    // Remove the association for key, if any. On return 
+    // association holds the removed one.
+    void remove(objc_object *object, const void *key, ObjcAssociation &association) {
+        beginWrite();
+
+        if (InlineAssociation *slot = findInline(InlineAssociation::disguise(object))) {
+            if (slot->key.load(std::memory_order_relaxed) == key) {
+                association = slot->association();
+                slot->clear();
+            }
+        } else {
+            auto refs_it = _map.find(object);
+            if (refs_it != _map.end()) {
+                auto &refs = refs_it->second;
+                auto it = refs.find(key);
+                if (it != refs.end()) {
+                    association.swap(it->second);
+                    refs.erase(it);
+                    if (refs.size() == 0) {
+                        _map.erase(refs_it);
+                    }
+                }
+            }
+        }
+
+        endWrite();
+    }
+
+    // Remove all of the object's associations. On return they are in 
+    // either inlineAssociation or refs.
+    void removeAll(objc_object *object, ObjcAssociation &inlineAssociation,
+                   ObjectAssociationMap &refs) {
+        beginWrite();
+
+        if (InlineAssociation *slot = findInline(InlineAssociation::disguise(object))) {
+            inlineAssociation = slot->association();
+            slot->clear();
+        } else {
+            AssociationsHashMap::iterator i = _map.find(object);
+            if (i != _map.end()) {
+                refs.swap(i->second);
+                _map.erase(i);
+            }
+        }
+
+        endWrite();
+    }
+};
+
+// class AssociationsManager manages the striped lock / table pairs.
+// Allocating an instance acquires the lock for the object's stripe.
 
 class AssociationsManager {
-    using Storage = ExplicitInitDenseMap<DisguisedPtr<objc_object>, ObjectAssociationMap>;
-    static Storage _mapStorage;
+    using Storage = ExplicitInit<StripedMap<AssociationsShard>>;
+    static Storage _shardStorage;
+
+    spinlock_t &_lock;
+    AssociationsShard &_shard;
 
 public:
-    AssociationsManager()   { AssociationsManagerLock.lock(); }
-    ~AssociationsManager()  { AssociationsManagerLock.unlock(); }
+    AssociationsManager(const void *object)
+        : _lock(AssociationsManagerLocks[object]), 
+          _shard(_shardStorage.get()[object])
+    {
+        _lock.lock();
+    }
+    ~AssociationsManager()  { _lock.unlock(); }
 
-    AssociationsHashMap &get() {
-        return _mapStorage.get();
+    AssociationsShard &get() {
+        return _shard;
+    }
+
+    // The object's table, for reading without the lock.
+    static AssociationsShard &getWithoutLock(const void *object) {
+        return _shardStorage.get()[object];
     }
 
     static void init() {
-        _mapStorage.init();
+        _shardStorage.init();
     }
 };
 
-AssociationsManager::Storage AssociationsManager::_mapStorage;
+AssociationsManager::Storage AssociationsManager::_shardStorage;
 
 } // namespace objc
 
@@ -136,20 +376,18 @@ _objc_associations_init()
 id
 _object_get_associative_reference(id object, const void *key)
 {
+    if (!object) return nil;
+
     ObjcAssociation association{};
 
+    if (AssociationsManager::getWithoutLock(object).tryGetWithoutLock(object, key, association)) {
+        return association.value();
+    }
+
     {
-        AssociationsManager manager;
-        AssociationsHashMap &associations(manager.get());
-        AssociationsHashMap::iterator i = associations.find((objc_object *)object);
-        if (i != associations.end()) {
-            ObjectAssociationMap &refs = i->second;
-            ObjectAssociationMap::iterator j = refs.find(key);
-            if (j != refs.end()) {
-                association = j->second;
-                association.retainReturnedValue();
-            }
-        }
+        AssociationsManager manager{object};
+        association = manager.get().get(object, key);
+        association.retainReturnedValue();
     }
 
     return association.autoreleaseReturnedValue();
@@ -166,43 +404,21 @@ _object_set_associative_reference(id object, const void *key, id value, uintptr_
     if (object->getIsa()->forbidsAssociatedObjects())
         _objc_fatal("objc_setAssociatedObject called on instance (%p) of class %s which does not allow associated objects", object, object_getClassName(object));
 
-    DisguisedPtr<objc_object> disguised{(objc_object *)object};
     ObjcAssociation association{policy, value};
 
     // retain the new value (if any) outside the lock.
     association.acquireValue();
 
     {
-        AssociationsManager manager;
-        AssociationsHashMap &associations(manager.get());
+        AssociationsManager manager{object};
 
         if (value) {
-            auto refs_result = associations.try_emplace(disguised, ObjectAssociationMap{});
-            if (refs_result.second) {
+            if (manager.get().set(object, key, association)) {
                 /* it's the first association we make */
                 object->setHasAssociatedObjects();
             }
-
-            /* establish or replace the association */
-            auto &refs = refs_result.first->second;
-            auto result = refs.try_emplace(key, std::move(association));
-            if (!result.second) {
-                association.swap(result.first->second);
-            }
         } else {
-            auto refs_it = associations.find(disguised);
-            if (refs_it != associations.end()) {
-                auto &refs = refs_it->second;
-                auto it = refs.find(key);
-                if (it != refs.end()) {
-                    association.swap(it->second);
-                    refs.erase(it);
-                    if (refs.size() == 0) {
-                        associations.erase(refs_it);
-
-                    }
-                }
-            }
+            manager.get().remove(object, key, association);
         }
     }
 
@@ -217,19 +433,16 @@ _object_set_associative_reference(id object, const void *key, id value, uintptr_
 void
 _object_remove_assocations(id object)
 {
+    ObjcAssociation association{};
     ObjectAssociationMap refs{};
 
     {
-        AssociationsManager manager;
-        AssociationsHashMap &associations(manager.get());
-        AssociationsHashMap::iterator i = associations.find((objc_object *)object);
-        if (i != associations.end()) {
-            refs.swap(i->second);
-            associations.erase(i);
-        }
+        AssociationsManager manager{object};
+        manager.get().removeAll(object, association, refs);
     }
 
     // release everything (outside of the lock).
+    association.releaseHeldValue();
     for (auto &i: refs) {
         i.second.releaseHeldValue();
     }
@@ -6151,6 +6151,16 @@ IMP lookUpImpOrForward(id inst, SEL sel, Class cls, int behavior)
     // The only codepath calling into this without having performed some
     // kind of cache lookup is class_getInstanceMethod().
 
+    // Entries recently dropped from cls's cache when it grew.
+#if SUPPORT_MESSAGE_LOGGING
+    // (The logger wants the implementer, which the victim cache doesn't know.)
+    if (fastpath(!objcMsgLogEnabled))
+#endif
+    {
+        imp = cache_getVictimImp(cls, sel);
+        if (imp) goto done;
+    }
+
     for (unsigned attempts = unreasonableClassCount();;) {
         // curClass method list.
         Method meth = getMethodNoSuper_nolock(curClass, sel);
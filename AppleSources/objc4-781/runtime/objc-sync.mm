@@ -56,11 +56,36 @@ typedef struct SyncCache {
   SYNC_COUNT_DIRECT_KEY == SyncCacheItem.lockCount
  */
 
+/*
+  Thin locks: each SyncList also has room for one object locked without 
+  a SyncData. thinObject is the object, thinOwner the thread holding it 
+  and thinCount its recursion depth. Only the owner writes thinOwner 
+  and thinCount, and it clears thinOwner before releasing thinObject, 
+  so another thread can never mistake the slot for one it owns.
+
+  A thread that can't take the thin lock (another thread holds it, or 
+  the slot is in use for a different object) inflates: it registers in 
+  fatUsers, takes the SyncData mutex as before, and then waits for any 
+  thin owner of the same object to leave. Only that one thread spins; 
+  other contenders park on the mutex. New thin locks aren't taken in a 
+  list while it has fatUsers. A thin locker publishes thinObject and 
+  then checks fatUsers, and an inflating thread publishes fatUsers and 
+  then checks thinObject (all seq_cst), so at least one of them sees 
+  the other.
+ */
+
 struct SyncList {
     SyncData *data;
     spinlock_t lock;
 
-    constexpr SyncList() : data(nil), lock(fork_unsafe_lock) { }
+    std::atomic<uintptr_t> thinObject;
+    std::atomic<pthread_t> thinOwner;
+    uintptr_t thinCount;
+    std::atomic<uint32_t> fatUsers;
+
+    constexpr SyncList()
+        : data(nil), lock(fork_unsafe_lock),
+          thinObject(0), thinOwner(nil), thinCount(0), fatUsers(0) { }
 };
 
 // Use multiple parallel lists to decrease contention among unrelated objects.
@@ -144,6 +169,7 @@ static SyncData* id2data(id object, enum usage why)
                     tls_set_direct(SYNC_DATA_DIRECT_KEY, NULL);
                     // atomic because may collide with concurrent ACQUIRE
                     OSAtomicDecrement32Barrier(&result->threadCount);
+                    sDataLists[object].fatUsers--;
                 }
                 break;
             case CHECK:
@@ -181,6 +207,7 @@ static SyncData* id2data(id object, enum usage why)
                     cache->list[i] = cache->list[--cache->used];
                     // atomic because may collide with concurrent ACQUIRE
                     OSAtomicDecrement32Barrier(&result->threadCount);
+                    sDataLists[object].fatUsers--;
                 }
                 break;
             case CHECK:
@@ -253,6 +280,9 @@ static SyncData* id2data(id object, enum usage why)
         if (why != ACQUIRE) _objc_fatal("id2data is buggy");
         if (result->object != object) _objc_fatal("id2data is buggy");
 
+        // Keeps new thin locks out of this list until the last release.
+        sDataLists[object].fatUsers++;
+
 #if SUPPORT_DIRECT_THREAD_KEYS
         if (!fastCacheOccupied) {
             // Save in fast thread cache
@@ -278,6 +308,76 @@ BREAKPOINT_FUNCTION(
 );
 
 
+// Take the thin lock for obj if this thread already holds it or the
+// slot is free. Returns false if obj must use its SyncData.
+static ALWAYS_INLINE bool thin_enter(SyncList& list, id obj)
+{
+    uintptr_t object = (uintptr_t)obj;
+    pthread_t self = objc_thread_self();
+
+    if (list.thinObject.load(std::memory_order_relaxed) == object  &&
+        list.thinOwner.load(std::memory_order_relaxed) == self)
+    {
+        list.thinCount++;
+        return true;
+    }
+
+    if (DisableThinSync  ||  list.fatUsers.load() != 0) return false;
+
+    uintptr_t expected = 0;
+    if (!list.thinObject.compare_exchange_strong(expected, object)) {
+        return false;
+    }
+    if (list.fatUsers.load() != 0) {
+        // Raced with a thread inflating. Let it have the list.
+        list.thinObject.store(0, std::memory_order_release);
+        return false;
+    }
+
+    list.thinOwner.store(self, std::memory_order_relaxed);
+    list.thinCount = 1;
+    return true;
+}
+
+// Release the thin lock for obj if this thread holds it.
+// Returns false if obj isn't thin-locked by this thread.
+static ALWAYS_INLINE bool thin_exit(SyncList& list, id obj)
+{
+    if (list.thinObject.load(std::memory_order_relaxed) != (uintptr_t)obj  ||
+        list.thinOwner.load(std::memory_order_relaxed) != objc_thread_self())
+    {
+        return false;
+    }
+
+    if (--list.thinCount == 0) {
+        list.thinOwner.store(nil, std::memory_order_relaxed);
+        list.thinObject.store(0, std::memory_order_release);
+    }
+    return true;
+}
+
+// Called with obj's SyncData mutex held. Wait for a thread that took
+// the thin lock for obj before we inflated to leave.
+static void thin_wait_for_owner(SyncList& list, id obj)
+{
+    // Critical sections are usually short: spin, then yield, then
+    // sleep with exponential backoff for long ones.
+    useconds_t delay = 1;
+    for (unsigned spins = 0; 
+         list.thinObject.load() == (uintptr_t)obj;
+         spins++)
+    {
+        if (spins < 100) continue;
+        if (spins < 1000) {
+            sched_yield();
+        } else {
+            usleep(delay);
+            if (delay < 1024) delay *= 2;
+        }
+    }
+}
+
+
 // Begin synchronizing on 'obj'. 
 // Allocates recursive mutex associated with 'obj' if needed.
 // Returns OBJC_SYNC_SUCCESS once lock is acquired.  
@@ -286,9 +386,13 @@ int objc_sync_enter(id obj)
     int result = OBJC_SYNC_SUCCESS;
 
     if (obj) {
+        SyncList& list = sDataLists[obj];
+        if (thin_enter(list, obj)) return result;
+
         SyncData* data = id2data(obj, ACQUIRE);
         ASSERT(data);
         data->mutex.lock();
+        thin_wait_for_owner(list, obj);
     } else {
         // @synchronized(nil) does nothing
         if (DebugNilSync) {
@@ -305,9 +409,21 @@ BOOL objc_sync_try_enter(id obj)
     BOOL result = YES;
 
     if (obj) {
+        SyncList& list = sDataLists[obj];
+        if (thin_enter(list, obj)) return YES;
+
         SyncData* data = id2data(obj, ACQUIRE);
         ASSERT(data);
         result = data->mutex.tryLock();
+        if (result  &&  list.thinObject.load() == (uintptr_t)obj) {
+            // Another thread holds it thin.
+            data->mutex.unlock();
+            result = NO;
+        }
+        if (!result) {
+            // Undo id2data's bookkeeping; there will be no objc_sync_exit.
+            id2data(obj, RELEASE);
+        }
     } else {
         // @synchronized(nil) does nothing
         if (DebugNilSync) {
@@ -327,6 +443,8 @@ int objc_sync_exit(id obj)
     int result = OBJC_SYNC_SUCCESS;
     
     if (obj) {
+        if (thin_exit(sDataLists[obj], obj)) return result;
+
         SyncData* data = id2data(obj, RELEASE); 
         if (!data) {
             result = OBJC_SYNC_NOT_OWNING_THREAD_ERROR;
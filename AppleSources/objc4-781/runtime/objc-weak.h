@@ -24,13 +24,16 @@
 #ifndef _OBJC_WEAK_H_
 #define _OBJC_WEAK_H_
 
+#if !OBJC_WEAK_TABLE_HARNESS
 #include <objc/objc.h>
 #include "objc-config.h"
+#endif
 
 __BEGIN_DECLS
 
 /*
-The weak table is a hash table governed by a single spin lock.
+The weak table is a hash table governed by a single spin lock
+(the SideTable lock, which also guards the object's retain count).
 An allocated blob of memory, most often an object, but under GC any such 
 allocation, may have its address stored in a __weak marked storage location 
 through use of compiler generated write-barriers or hand coded uses of the 
@@ -115,12 +118,25 @@ struct weak_entry_t {
 /**
  * The global weak references table. Stores object ids as keys,
  * and weak_entry_t structs as their values.
+ *
+ * Each entries array is followed by one tag byte per entry (see
+ * weak_tags() in objc-weak.mm), so probing scans bytes instead of
+ * whole entries.
+ *
+ * Resizing is incremental: the previous array stays in old_entries and
+ * every mutation moves a few of its buckets into weak_entries, so no
+ * single operation rehashes the whole table while holding the lock.
+ * Lookups check both arrays. num_entries counts the entries of both.
  */
 struct weak_table_t {
     weak_entry_t *weak_entries;
     size_t    num_entries;
     uintptr_t mask;
     uintptr_t max_hash_displacement;
+    weak_entry_t *old_entries;
+    uintptr_t old_mask;
+    uintptr_t old_max_hash_displacement;
+    size_t    old_migrated;
 };
 
 /// Adds an (object, weak pointer) pair to the weak table.
@@ -21,6 +21,7 @@
  * @APPLE_LICENSE_HEADER_END@
  */
 
+#if !OBJC_WEAK_TABLE_HARNESS
 #include "objc-private.h"
 
 #include "objc-weak.h"
@@ -29,9 +30,16 @@
 #include <stdbool.h>
 #include <sys/types.h>
 #include <libkern/OSAtomic.h>
+#endif
 
 #define TABLE_SIZE(entry) (entry->mask ? entry->mask + 1 : 0)
 
+// Number of buckets of the previous table moved per table mutation
+// while an incremental resize is in progress.
+#ifndef WEAK_MIGRATE_BATCH
+#define WEAK_MIGRATE_BATCH 16
+#endif
+
 static void append_referrer(weak_entry_t *entry, objc_object **new_referrer);
 
 BREAKPOINT_FUNCTION(
@@ -204,56 +212,117 @@ static void remove_referrer(weak_entry_t *entry, objc_object **old_referrer)
     entry->num_refs--;
 }
 
+/**
+ * The tag bytes that follow an entries array of mask + 1 entries.
+ * 0 marks an empty slot, otherwise the tag is weak_tag() of the
+ * slot's referent.
+ */
+static inline uint8_t *weak_tags(weak_entry_t *entries, uintptr_t mask)
+{
+    return (uint8_t *)(entries + mask + 1);
+}
+
+static inline uint8_t weak_tag(uintptr_t hash)
+{
+    // ptr_hash is 32 bits wide; the index uses the low bits.
+    return (uint8_t)(0x80 | ((uint32_t)hash >> 25));
+}
+
+static weak_entry_t *weak_entries_alloc(size_t size)
+{
+    return (weak_entry_t *)calloc(size, sizeof(weak_entry_t) + sizeof(uint8_t));
+}
+
 /** 
- * Add new_entry to the object's table of weak references.
- * Does not check whether the referent is already in the table.
+ * Add new_entry to an entries array. 
+ * Does not check whether the referent is already in the array.
  */
-static void weak_entry_insert(weak_table_t *weak_table, weak_entry_t *new_entry)
+static void weak_entry_place(weak_entry_t *weak_entries, uintptr_t mask,
+                             uintptr_t *max_hash_displacement,
+                             weak_entry_t *new_entry)
 {
-    weak_entry_t *weak_entries = weak_table->weak_entries;
     ASSERT(weak_entries != nil);
 
-    size_t begin = hash_pointer(new_entry->referent) & (weak_table->mask);
+    uint8_t *tags = weak_tags(weak_entries, mask);
+    uintptr_t hash = hash_pointer(new_entry->referent);
+    size_t begin = hash & mask;
     size_t index = begin;
     size_t hash_displacement = 0;
-    while (weak_entries[index].referent != nil) {
-        index = (index+1) & weak_table->mask;
+    while (tags[index] != 0) {
+        index = (index+1) & mask;
         if (index == begin) bad_weak_table(weak_entries);
         hash_displacement++;
     }
 
     weak_entries[index] = *new_entry;
-    weak_table->num_entries++;
+    tags[index] = weak_tag(hash);
 
-    if (hash_displacement > weak_table->max_hash_displacement) {
-        weak_table->max_hash_displacement = hash_displacement;
+    if (hash_displacement > *max_hash_displacement) {
+        *max_hash_displacement = hash_displacement;
     }
 }
 
+/** 
+ * Add new_entry to the object's table of weak references.
+ * Does not check whether the referent is already in the table.
+ */
+static void weak_entry_insert(weak_table_t *weak_table, weak_entry_t *new_entry)
+{
+    weak_entry_place(weak_table->weak_entries, weak_table->mask,
+                     &weak_table->max_hash_displacement, new_entry);
+    weak_table->num_entries++;
+}
+
+/**
+ * Move up to count buckets of the table being resized away from into
+ * the current table, and free it once all of them have been moved.
+ */
+static void weak_migrate(weak_table_t *weak_table, size_t count)
+{
+    weak_entry_t *old_entries = weak_table->old_entries;
+    if (!old_entries) return;
+
+    uint8_t *old_tags = weak_tags(old_entries, weak_table->old_mask);
+    size_t old_size = weak_table->old_mask + 1;
+    size_t index = weak_table->old_migrated;
+    size_t end = (count < old_size - index) ? index + count : old_size;
+
+    for (; index < end; index++) {
+        if (old_tags[index]) {
+            weak_entry_place(weak_table->weak_entries, weak_table->mask,
+                             &weak_table->max_hash_displacement,
+                             &old_entries[index]);
+            old_tags[index] = 0;
+        }
+    }
+    weak_table->old_migrated = index;
+
+    if (index == old_size) {
+        free(old_entries);
+        weak_table->old_entries = nil;
+        weak_table->old_mask = 0;
+        weak_table->old_max_hash_displacement = 0;
+        weak_table->old_migrated = 0;
+    }
+}
 
+/**
+ * Start moving the table's entries to a new array of new_size entries.
+ * The entries are moved by later calls to weak_migrate().
+ */
 static void weak_resize(weak_table_t *weak_table, size_t new_size)
 {
-    size_t old_size = TABLE_SIZE(weak_table);
+    // One resize at a time: finish the previous one first.
+    weak_migrate(weak_table, SIZE_MAX);
 
-    weak_entry_t *old_entries = weak_table->weak_entries;
-    weak_entry_t *new_entries = (weak_entry_t *)
-        calloc(new_size, sizeof(weak_entry_t));
+    weak_table->old_entries = weak_table->weak_entries;
+    weak_table->old_mask = weak_table->mask;
+    weak_table->old_max_hash_displacement = weak_table->max_hash_displacement;
+    weak_table->old_migrated = 0;
 
+    weak_table->weak_entries = weak_entries_alloc(new_size);
     weak_table->mask = new_size - 1;
-    weak_table->weak_entries = new_entries;
     weak_table->max_hash_displacement = 0;
-    weak_table->num_entries = 0;  // restored by weak_entry_insert below
-    
-    if (old_entries) {
-        weak_entry_t *entry;
-        weak_entry_t *end = old_entries + old_size;
-        for (entry = old_entries; entry < end; entry++) {
-            if (entry->referent) {
-                weak_entry_insert(weak_table, entry);
-            }
-        }
-        free(old_entries);
-    }
 }
 
 // Grow the given zone's table of weak references if it is full.
@@ -261,7 +330,8 @@ static void weak_grow_maybe(weak_table_t *weak_table)
 {
     size_t old_size = TABLE_SIZE(weak_table);
 
-    // Grow if at least 3/4 full.
+    // Grow if at least 3/4 full. num_entries includes the entries not
+    // yet migrated, so the current table can always take all of them.
     if (weak_table->num_entries >= old_size * 3 / 4) {
         weak_resize(weak_table, old_size ? old_size*2 : 64);
     }
@@ -272,6 +342,9 @@ static void weak_compact_maybe(weak_table_t *weak_table)
 {
     size_t old_size = TABLE_SIZE(weak_table);
 
+    // Don't start a shrink while the previous resize is still in flight.
+    if (weak_table->old_entries) return;
+
     // Shrink if larger than 1024 buckets and at most 1/16 full.
     if (old_size >= 1024  && old_size / 16 >= weak_table->num_entries) {
         weak_resize(weak_table, old_size / 8);
@@ -285,9 +358,21 @@ static void weak_compact_maybe(weak_table_t *weak_table)
  */
 static void weak_entry_remove(weak_table_t *weak_table, weak_entry_t *entry)
 {
+    weak_entry_t *weak_entries = weak_table->weak_entries;
+    uint8_t *tag;
+    if (entry >= weak_entries  &&  entry <= weak_entries + weak_table->mask) {
+        tag = &weak_tags(weak_entries, weak_table->mask)[entry - weak_entries];
+    } else {
+        weak_entry_t *old_entries = weak_table->old_entries;
+        ASSERT(old_entries  &&  entry >= old_entries  &&
+               entry <= old_entries + weak_table->old_mask);
+        tag = &weak_tags(old_entries, weak_table->old_mask)[entry - old_entries];
+    }
+
     // remove entry
     if (entry->out_of_line()) free(entry->referrers);
     bzero(entry, sizeof(*entry));
+    *tag = 0;
 
     weak_table->num_entries--;
 
@@ -295,6 +380,31 @@ static void weak_entry_remove(weak_table_t *weak_table, weak_entry_t *entry)
 }
 
 
+/**
+ * Look referent up in one entries array. Only entries whose tag
+ * matches are read.
+ */
+static weak_entry_t *
+weak_entry_probe(weak_entry_t *weak_entries, uintptr_t mask,
+                 uintptr_t max_hash_displacement,
+                 objc_object *referent, uintptr_t hash)
+{
+    if (!weak_entries) return nil;
+    if (max_hash_displacement > mask) bad_weak_table(weak_entries);
+
+    uint8_t *tags = weak_tags(weak_entries, mask);
+    uint8_t tag = weak_tag(hash);
+    size_t index = hash & mask;
+    for (size_t i = 0; i <= max_hash_displacement; i++) {
+        if (tags[index] == tag  &&  weak_entries[index].referent == referent) {
+            return &weak_entries[index];
+        }
+        index = (index+1) & mask;
+    }
+
+    return nil;
+}
+
 /** 
  * Return the weak reference table entry for the given referent. 
  * If there is no entry for referent, return NULL. 
@@ -310,23 +420,17 @@ weak_entry_for_referent(weak_table_t *weak_table, objc_object *referent)
 {
     ASSERT(referent);
 
-    weak_entry_t *weak_entries = weak_table->weak_entries;
-
-    if (!weak_entries) return nil;
-
-    size_t begin = hash_pointer(referent) & weak_table->mask;
-    size_t index = begin;
-    size_t hash_displacement = 0;
-    while (weak_table->weak_entries[index].referent != referent) {
-        index = (index+1) & weak_table->mask;
-        if (index == begin) bad_weak_table(weak_table->weak_entries);
-        hash_displacement++;
-        if (hash_displacement > weak_table->max_hash_displacement) {
-            return nil;
-        }
+    uintptr_t hash = hash_pointer(referent);
+    weak_entry_t *entry =
+        weak_entry_probe(weak_table->weak_entries, weak_table->mask,
+                         weak_table->max_hash_displacement, referent, hash);
+    if (!entry  &&  weak_table->old_entries) {
+        entry = weak_entry_probe(weak_table->old_entries, weak_table->old_mask,
+                                 weak_table->old_max_hash_displacement,
+                                 referent, hash);
     }
-    
-    return &weak_table->weak_entries[index];
+
+    return entry;
 }
 
 /** 
@@ -355,11 +459,14 @@ weak_unregister_no_lock(weak_table_t *weak_table, id referent_id,
 
     if (!referent) return;
 
+    weak_migrate(weak_table, WEAK_MIGRATE_BATCH);
+
     if ((entry = weak_entry_for_referent(weak_table, referent))) {
         remove_referrer(entry, referrer);
         bool empty = true;
-        if (entry->out_of_line()  &&  entry->num_refs != 0) {
-            empty = false;
+        if (entry->out_of_line()) {
+            // inline_referrers overlaps the out-of-line fields here.
+            empty = (entry->num_refs == 0);
         }
         else {
             for (size_t i = 0; i < WEAK_INLINE_COUNT; i++) {
@@ -398,6 +505,10 @@ weak_register_no_lock(weak_table_t *weak_table, id referent_id,
 
     // ensure that the referenced object is viable
     bool deallocating;
+#if OBJC_WEAK_TABLE_HARNESS
+    // The harness's referents have no isa and are never deallocating.
+    deallocating = false;
+#else
     if (!referent->ISA()->hasCustomRR()) {
         deallocating = referent->rootIsDeallocating();
     }
@@ -412,6 +523,7 @@ weak_register_no_lock(weak_table_t *weak_table, id referent_id,
         deallocating =
             ! (*allowsWeakReference)(referent, @selector(allowsWeakReference));
     }
+#endif
 
     if (deallocating) {
         if (crashIfDeallocating) {
@@ -424,6 +536,8 @@ weak_register_no_lock(weak_table_t *weak_table, id referent_id,
         }
     }
 
+    weak_migrate(weak_table, WEAK_MIGRATE_BATCH);
+
     // now remember it and where it is being stored
     weak_entry_t *entry;
     if ((entry = weak_entry_for_referent(weak_table, referent))) {
@@ -463,6 +577,8 @@ weak_clear_no_lock(weak_table_t *weak_table, id referent_id)
 {
     objc_object *referent = (objc_object *)referent_id;
 
+    weak_migrate(weak_table, WEAK_MIGRATE_BATCH);
+
     weak_entry_t *entry = weak_entry_for_referent(weak_table, referent);
     if (entry == nil) {
         /// XXX shouldn't happen, but does with mismatched CF/objc
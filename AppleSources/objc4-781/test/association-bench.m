@@ -0,0 +1,132 @@
+// TEST_CONFIG
+
+#include "test.h"
+
+#include <stdlib.h>
+#include <pthread.h>
+#include <mach/mach_time.h>
+#include <objc/runtime.h>
+#include <Foundation/NSObject.h>
+
+// Associated object micro-benchmark.
+// Get: every thread reads one nonatomic association of its own objects.
+// Get atomic: the same with OBJC_ASSOCIATION_RETAIN, which takes the lock.
+// Get shared: every thread reads one association of the same object.
+// Get multi: every thread reads the last of three associations.
+// Set: every thread replaces one association of its own objects.
+// Each pattern also checks that it reads back the values it expects.
+// Run with VERBOSE=1 to see the timings.
+
+#define MAX_THREADS 8
+#define OBJECTS 64
+#define COUNT 100000
+
+enum pattern { GET, GET_ATOMIC, GET_SHARED, GET_MULTI, SET };
+static const char * const patternNames[] = {
+    "get", "get atomic", "get shared", "get multi", "set"
+};
+
+static const char keys[3] = { 0 };
+static id sharedObject;
+static id sharedValue;
+
+struct worker {
+    pthread_t thread;
+    enum pattern pattern;
+    id objects[OBJECTS];
+    id values[2];
+};
+
+static void *threadfn(void *arg)
+{
+    struct worker *w = (struct worker *)arg;
+    const void *key = &keys[w->pattern == GET_MULTI ? 2 : 0];
+
+    for (int n = 0; n < COUNT; n++) {
+        int i = n % OBJECTS;
+        if (w->pattern == SET) {
+            objc_setAssociatedObject(w->objects[i], key, w->values[n & 1],
+                                     OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+        } else if (w->pattern == GET_SHARED) {
+            testassert(objc_getAssociatedObject(sharedObject, key) == sharedValue);
+        } else {
+            testassert(objc_getAssociatedObject(w->objects[i], key) == w->values[0]);
+        }
+    }
+
+    return NULL;
+}
+
+static void bench(enum pattern pattern, int nthreads)
+{
+    struct worker workers[MAX_THREADS];
+
+    for (int t = 0; t < nthreads; t++) {
+        workers[t].pattern = pattern;
+        workers[t].values[0] = [NSObject new];
+        workers[t].values[1] = [NSObject new];
+        for (int i = 0; i < OBJECTS; i++) {
+            id obj = [NSObject new];
+            workers[t].objects[i] = obj;
+            if (pattern == GET_MULTI) {
+                objc_setAssociatedObject(obj, &keys[0], workers[t].values[1],
+                                         OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+                objc_setAssociatedObject(obj, &keys[1], workers[t].values[1],
+                                         OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+                objc_setAssociatedObject(obj, &keys[2], workers[t].values[0],
+                                         OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+            } else {
+                objc_setAssociatedObject(obj, &keys[0], workers[t].values[0],
+                                         pattern == GET_ATOMIC
+                                         ? OBJC_ASSOCIATION_RETAIN
+                                         : OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+            }
+        }
+    }
+
+    uint64_t start = mach_absolute_time();
+    for (int t = 0; t < nthreads; t++) {
+        pthread_create(&workers[t].thread, NULL, &threadfn, &workers[t]);
+    }
+    for (int t = 0; t < nthreads; t++) {
+        pthread_join(workers[t].thread, NULL);
+    }
+    uint64_t elapsed = mach_absolute_time() - start;
+
+    for (int t = 0; t < nthreads; t++) {
+        for (int i = 0; i < OBJECTS; i++) {
+            if (pattern == SET) {
+                // Each object ends up holding one of the two values.
+                id value = objc_getAssociatedObject(workers[t].objects[i], &keys[0]);
+                testassert(value == workers[t].values[0]  ||
+                           value == workers[t].values[1]);
+            }
+            RELEASE_VAR(workers[t].objects[i]);
+        }
+        RELEASE_VAR(workers[t].values[0]);
+        RELEASE_VAR(workers[t].values[1]);
+    }
+
+    mach_timebase_info_data_t timebase;
+    mach_timebase_info(&timebase);
+    double ns = (double)elapsed * timebase.numer / timebase.denom;
+    testprintf("%-12s %d thread%s: %6.1f ns per call\n",
+               patternNames[pattern], nthreads, nthreads == 1 ? " " : "s",
+               ns / ((double)nthreads * COUNT));
+}
+
+int main()
+{
+    sharedObject = [NSObject new];
+    sharedValue = [NSObject new];
+    objc_setAssociatedObject(sharedObject, &keys[0], sharedValue,
+                             OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+
+    for (int p = GET; p <= SET; p++) {
+        for (int nthreads = 1; nthreads <= MAX_THREADS; nthreads *= 2) {
+            bench((enum pattern)p, nthreads);
+        }
+    }
+
+    succeed(__FILE__);
+}
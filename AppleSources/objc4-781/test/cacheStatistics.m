@@ -0,0 +1,73 @@
+/*
+TEST_ENV OBJC_DEBUG_CACHE_STATISTICS=YES
+TEST_RUN_OUTPUT
+(objc\[\d+\]: CACHES: .*\n){1,3}OK: cacheStatistics.m
+END
+*/
+
+#include "test.h"
+#include "testroot.i"
+#include <objc/runtime.h>
+#include <objc/message.h>
+#include <objc/objc-internal.h>
+
+#define COUNT 64
+
+@interface Poly : TestRoot @end
+@implementation Poly @end
+
+static int fn(id self __unused, SEL _cmd __unused) { return 42; }
+static int fn2(id self __unused, SEL _cmd __unused) { return 7; }
+
+static SEL sels[COUNT];
+
+static void callAll(id obj, int expected)
+{
+    for (int i = 0; i < COUNT; i++) {
+        testassert(expected == ((int(*)(id, SEL))objc_msgSend)(obj, sels[i]));
+    }
+}
+
+int main()
+{
+    for (int i = 0; i < COUNT; i++) {
+        char name[32];
+        snprintf(name, sizeof(name), "polyMethod%d", i);
+        sels[i] = sel_registerName(name);
+        testassert(class_addMethod([Poly class], sels[i], (IMP)fn, "i@:"));
+    }
+
+    id obj = [Poly new];
+    struct objc_cache_statistics stats;
+
+    // Filling the cache grows it and throws its contents away each time.
+    callAll(obj, 42);
+    testassert(_objc_getCacheStatistics([Poly class], &stats));
+    testassert(stats.misses >= COUNT);
+    testassert(stats.resizes > 0);
+    testassert(stats.evictions > 0);
+    testassert(stats.flushes == 0);
+
+    // The entries dropped when the cache grew refill from the victim cache.
+    uint64_t misses = stats.misses;
+    callAll(obj, 42);
+    testassert(_objc_getCacheStatistics([Poly class], &stats));
+    testassert(stats.misses > misses);
+    testassert(stats.victimHits > 0);
+
+    // Replacing methods flushes caches. Nothing stale may come back
+    // from the victim cache.
+    for (int i = 0; i < COUNT; i++) {
+        class_replaceMethod([Poly class], sels[i], (IMP)fn2, "i@:");
+    }
+    testassert(_objc_getCacheStatistics([Poly class], &stats));
+    testassert(stats.flushes > 0);
+    uint64_t victimHits = stats.victimHits;
+    callAll(obj, 7);
+    testassert(_objc_getCacheStatistics([Poly class], &stats));
+    testassert(stats.victimHits == victimHits);
+
+    _objc_printCacheStatistics(3);
+
+    succeed(__FILE__);
+}
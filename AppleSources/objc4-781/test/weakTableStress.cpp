@@ -0,0 +1,355 @@
+/*
+ * Stress test and benchmark for the weak table in runtime/objc-weak.mm,
+ * built outside the runtime so it runs on any POSIX system (Linux
+ * included). Not run by test.pl.
+ *
+ *   c++ -std=c++11 -O2 -pthread weakTableStress.cpp -o weakTableStress
+ *   ./weakTableStress [ops-per-thread]
+ *
+ * Add -DWEAK_MIGRATE_BATCH=SIZE_MAX to resize in one go (no incremental
+ * migration) for comparison, or -fsanitize=address to also check for
+ * leaks of the tables' storage.
+ *
+ * 1. A single-threaded model check: random weak stores and deallocations
+ *    against a shadow model, with phases that grow the table and then
+ *    shrink it again so resizes are in flight for much of the run.
+ * 2. A multi-threaded benchmark: the tables are striped by referent
+ *    address behind spin locks like the runtime's SideTables. Reports
+ *    throughput and the worst single operation, which is where a full
+ *    rehash under the lock shows up.
+ */
+
+#include <assert.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/cdefs.h>
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <random>
+#include <set>
+#include <thread>
+#include <vector>
+
+// Just enough of objc-private.h for objc-weak.mm.
+
+#define OBJC_WEAK_TABLE_HARNESS 1
+#define DEBUG 1
+#define ASSERT(x) assert(x)
+#define nil nullptr
+#define BREAKPOINT_FUNCTION(prototype) \
+    __attribute__((noinline, used)) prototype { asm(""); }
+
+struct objc_object {
+    uintptr_t isa;
+    bool isTaggedPointer() { return false; }
+};
+typedef objc_object *id;
+
+template <typename T>
+class DisguisedPtr {
+    uintptr_t value;
+
+    static uintptr_t disguise(T* ptr) { return -(uintptr_t)ptr; }
+    static T* undisguise(uintptr_t val) { return (T*)-val; }
+
+ public:
+    DisguisedPtr() { }
+    DisguisedPtr(T* ptr) : value(disguise(ptr)) { }
+    DisguisedPtr(const DisguisedPtr<T>& ptr) : value(ptr.value) { }
+
+    DisguisedPtr<T>& operator = (T* rhs) {
+        value = disguise(rhs);
+        return *this;
+    }
+    DisguisedPtr<T>& operator = (const DisguisedPtr<T>& rhs) {
+        value = rhs.value;
+        return *this;
+    }
+
+    operator T* () const { return undisguise(value); }
+    T* operator -> () const { return undisguise(value); }
+};
+
+#if __LP64__
+static inline uint32_t ptr_hash(uint64_t key)
+{
+    key ^= key >> 4;
+    key *= 0x8a970be7488fda55;
+    key ^= __builtin_bswap64(key);
+    return (uint32_t)key;
+}
+#else
+static inline uint32_t ptr_hash(uint32_t key)
+{
+    key ^= key >> 4;
+    key *= 0x5052acdb;
+    key ^= __builtin_bswap32(key);
+    return key;
+}
+#endif
+
+__attribute__((noreturn, format(printf, 1, 2)))
+static void _objc_fatal(const char *fmt, ...)
+{
+    va_list ap;
+    va_start(ap, fmt);
+    vfprintf(stderr, fmt, ap);
+    va_end(ap);
+    fputc('\n', stderr);
+    abort();
+}
+
+__attribute__((format(printf, 1, 2)))
+static void _objc_inform(const char *fmt, ...)
+{
+    va_list ap;
+    va_start(ap, fmt);
+    vfprintf(stderr, fmt, ap);
+    va_end(ap);
+}
+
+static const char *object_getClassName(id)
+{
+    return "HarnessObject";
+}
+
+#include "../runtime/objc-weak.h"
+#include "../runtime/objc-weak.mm"
+
+
+#define fail(...) _objc_fatal("FAIL: " __VA_ARGS__)
+
+// The equivalent of objc_storeWeak() on a single table.
+static void store_weak(weak_table_t *table, id *location, id newObj)
+{
+    weak_unregister_no_lock(table, *location, location);
+    *location = weak_register_no_lock(table, newObj, location, true);
+}
+
+// The equivalent of an object's dealloc.
+static void dealloc_object(weak_table_t *table, id obj)
+{
+    weak_clear_no_lock(table, obj);
+}
+
+// Release an empty table's storage. The runtime's tables are never
+// destroyed, so objc-weak.mm has nothing for this.
+static void destroy_table(weak_table_t *table)
+{
+    if (table->num_entries != 0) fail("destroying a table with %zu entries", table->num_entries);
+    free(table->weak_entries);
+    free(table->old_entries);
+    memset(table, 0, sizeof(*table));
+}
+
+
+static void model_check(size_t nops)
+{
+    enum { NOBJECTS = 4096, NSLOTS = 16384 };
+    static objc_object objects[NOBJECTS];
+    static id slots[NSLOTS];
+
+    weak_table_t table;
+    memset(&table, 0, sizeof(table));
+
+    // referent -> slots currently holding it
+    std::map<id, std::set<size_t>> model;
+    std::mt19937_64 rng(1);
+
+    size_t resizes = 0, ops_during_migration = 0;
+    weak_entry_t *last_entries = nil;
+
+    for (size_t op = 0; op < nops; op++) {
+        // Alternate between a working set that spans all objects and one
+        // that only touches a few, so the table grows and compacts.
+        size_t phase = (op / (nops / 8 + 1)) % 2;
+        size_t nobjects = phase ? 16 : NOBJECTS;
+
+        size_t slot = rng() % NSLOTS;
+        id obj = &objects[rng() % nobjects];
+
+        if (rng() % 8 == 0) {
+            dealloc_object(&table, obj);
+            for (size_t s : model[obj]) {
+                if (slots[s] != nil) fail("slot %zu not cleared", s);
+            }
+            model.erase(obj);
+        } else {
+            id old = slots[slot];
+            if (rng() % 4 == 0) obj = nil;
+            store_weak(&table, &slots[slot], obj);
+            if (old) {
+                model[old].erase(slot);
+                if (model[old].empty()) model.erase(old);
+            }
+            if (obj) model[obj].insert(slot);
+            if (slots[slot] != obj) fail("store of %p returned %p", obj, slots[slot]);
+        }
+
+        if (table.weak_entries != last_entries) {
+            last_entries = table.weak_entries;
+            resizes++;
+        }
+        if (table.old_entries) ops_during_migration++;
+
+        if (table.num_entries != model.size()) {
+            fail("table has %zu entries, model has %zu",
+                 table.num_entries, model.size());
+        }
+        if (op % 1024 == 0) {
+            for (size_t i = 0; i < NOBJECTS; i++) {
+                id o = &objects[i];
+                bool registered = weak_is_registered_no_lock(&table, o);
+                if (registered != (model.count(o) != 0)) {
+                    fail("object %zu registered=%d", i, registered);
+                }
+            }
+        }
+    }
+
+    for (auto& m : model) dealloc_object(&table, m.first);
+    if (table.num_entries != 0) fail("%zu entries left", table.num_entries);
+    for (size_t i = 0; i < NSLOTS; i++) {
+        if (slots[i]) fail("slot %zu not cleared", i);
+    }
+    destroy_table(&table);
+
+    printf("model check: %zu ops, %zu resizes, %zu ops with a resize in flight\n",
+           nops, resizes, ops_during_migration);
+}
+
+
+// Striped tables, like the runtime's SideTables.
+#define NSTRIPES 8
+
+struct alignas(64) StripedTable {
+    std::atomic_flag slock = ATOMIC_FLAG_INIT;
+    weak_table_t weak_table;
+
+    StripedTable() { memset(&weak_table, 0, sizeof(weak_table)); }
+
+    void lock() {
+        // Yield so oversubscribed runs measure the table, not preemption
+        // of the lock holder.
+        while (slock.test_and_set(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+    }
+    void unlock() { slock.clear(std::memory_order_release); }
+};
+
+static StripedTable tables[NSTRIPES];
+
+static StripedTable& tableFor(id obj)
+{
+    uintptr_t addr = (uintptr_t)obj;
+    return tables[((addr >> 4) ^ (addr >> 9)) % NSTRIPES];
+}
+
+struct ThreadResult {
+    uint64_t worst_ns = 0;
+    uint64_t over_10us = 0;
+};
+
+static void bench_thread(size_t nops, unsigned seed, ThreadResult *result)
+{
+    // Every thread churns its own objects and variables, so contention
+    // is only on the stripe locks, as for unrelated objects in an app.
+    enum { NOBJECTS = 1 << 15, NSLOTS = 1 << 16 };
+    std::vector<objc_object> objects(NOBJECTS);
+    std::vector<id> slots(NSLOTS, nil);
+    std::mt19937 rng(seed);
+
+    for (size_t op = 0; op < nops; op++) {
+        // A slowly varying working set: grows, then shrinks.
+        size_t span = (op / 4096) % 64;
+        size_t nobjects = 64 + (NOBJECTS - 64) * (span < 32 ? span : 63 - span) / 31;
+
+        id *location = &slots[rng() % NSLOTS];
+        id obj = &objects[rng() % nobjects];
+        bool dealloc = rng() % 8 == 0;
+
+        auto start = std::chrono::steady_clock::now();
+        if (dealloc) {
+            StripedTable& table = tableFor(obj);
+            table.lock();
+            dealloc_object(&table.weak_table, obj);
+            table.unlock();
+        } else {
+            id old = *location;
+            StripedTable *oldTable = old ? &tableFor(old) : nil;
+            StripedTable *newTable = &tableFor(obj);
+            // Address-ordered locking, like SideTable::lockTwo().
+            StripedTable *first = oldTable && oldTable < newTable ? oldTable : newTable;
+            StripedTable *second = first == newTable ? oldTable : newTable;
+            if (second == first) second = nil;
+            first->lock();
+            if (second) second->lock();
+            if (oldTable) weak_unregister_no_lock(&oldTable->weak_table, old, location);
+            *location = weak_register_no_lock(&newTable->weak_table, obj, location, true);
+            if (second) second->unlock();
+            first->unlock();
+        }
+        uint64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>
+            (std::chrono::steady_clock::now() - start).count();
+        if (ns > result->worst_ns) result->worst_ns = ns;
+        if (ns > 10000) result->over_10us++;
+    }
+
+    // Leave the tables empty for the next run.
+    for (auto& obj : objects) {
+        StripedTable& table = tableFor(&obj);
+        table.lock();
+        dealloc_object(&table.weak_table, &obj);
+        table.unlock();
+    }
+}
+
+static void bench(unsigned nthreads, size_t nops)
+{
+    std::vector<std::thread> threads;
+    std::vector<ThreadResult> results(nthreads);
+
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < nthreads; i++) {
+        threads.emplace_back(bench_thread, nops, i + 1, &results[i]);
+    }
+    for (auto& t : threads) t.join();
+    double secs = std::chrono::duration<double>
+        (std::chrono::steady_clock::now() - start).count();
+
+    uint64_t worst = 0, over = 0;
+    for (auto& r : results) {
+        if (r.worst_ns > worst) worst = r.worst_ns;
+        over += r.over_10us;
+    }
+    for (auto& t : tables) {
+        if (t.weak_table.num_entries != 0) fail("stripe not empty after run");
+        destroy_table(&t.weak_table);
+    }
+
+    printf("%u thread%s: %8.2f Mops/s  worst op %8.1f us  ops over 10us %llu\n",
+           nthreads, nthreads == 1 ? " " : "s",
+           nthreads * nops / secs / 1e6, worst / 1e3,
+           (unsigned long long)over);
+}
+
+int main(int argc, char **argv)
+{
+    size_t nops = argc > 1 ? strtoull(argv[1], nil, 0) : 1000000;
+
+    model_check(200000);
+
+    printf("WEAK_MIGRATE_BATCH %zu\n", (size_t)WEAK_MIGRATE_BATCH);
+    for (unsigned nthreads = 1; nthreads <= 8; nthreads *= 2) {
+        bench(nthreads, nops);
+    }
+
+    return 0;
+}